@@ -94,6 +94,8 @@ pub extern "C" fn say_something(some_string: *const u8, some_len: usize) -> sgx_
 
     println!("\nsgx_backtrace sample code:");
     let _  = sgx_backtrace::set_enclave_path("enclave.signed.so");
+    // Build the unwind index up front, so the first fast capture is cheap.
+    let _ = sgx_backtrace::init_unwind_index();
     foo();
 
     println!("\nstd::backtrace sample code:");
@@ -130,9 +132,18 @@ fn bar() {
 #[inline(never)]
 fn baz() {
     println!("{:?}", Backtrace::new());
+    fast();
     raw()
 }
 
+#[inline(never)]
+fn fast() {
+    // Capturing is cheap; symbols are resolved only when needed.
+    let mut bt = Backtrace::new_fast();
+    bt.resolve();
+    println!("\nsgx_backtrace fast capture:\n{:?}", bt);
+}
+
 #[inline(never)]
 fn raw() {
     print()
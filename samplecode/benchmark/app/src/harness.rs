@@ -0,0 +1,535 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Collects timing samples, summarizes them and reports the results.
+//!
+//! A sample is the time of one operation, or the mean of a batch of them
+//! when a single one is too short to time or cannot be timed alone. Every
+//! benchmark takes samples until it has as many as asked for or has run
+//! out of its time budget, after a few warm-up rounds that are thrown
+//! away.
+//!
+//! Results are printed as a table and, with `--json`, written as JSON
+//! lines: one `meta` object describing the run, then one object per
+//! benchmark. `--baseline` compares the medians against such a file from
+//! an earlier run.
+
+use serde_json::{self, Value};
+use std::collections::HashMap;
+use std::env;
+use std::fs::File;
+use std::io::{self, BufRead, BufReader, Write};
+use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
+
+const WARMUP_ROUNDS: usize = 3;
+const MIN_SAMPLES: usize = 10;
+
+pub struct Options {
+    pub samples: usize,
+    pub max_time: Duration,
+    pub max_payload: usize,
+    pub workers: Vec<u32>,
+    pub threads: Vec<usize>,
+    pub filter: Option<String>,
+    pub json: Option<String>,
+    pub baseline: Option<String>,
+    pub threshold: f64,
+    pub label: String,
+}
+
+const USAGE: &'static str = "\
+usage: app [options]
+  --samples N        samples per benchmark (default 1000)
+  --max-time SECS    time budget per benchmark (default 2)
+  --max-payload SIZE largest payload, e.g. 65536, 64K or 16M (default 16M)
+  --workers N,N,..   switchless worker counts (default 1,2,4)
+  --threads N,N,..   thread counts for the lock benchmarks (default 1,2,4,8)
+  --filter TEXT      only run the benchmarks whose name contains TEXT
+  --json FILE        write the results as JSON lines to FILE, - for stdout
+  --baseline FILE    compare with the JSON lines of an earlier run
+  --threshold PCT    median slowdown that counts as a regression (default 10)
+  --label TEXT       recorded in the JSON output, e.g. the SDK version
+  --quick            100 samples, 0.2 s and 1M payloads at most";
+
+fn parse_size(s: &str) -> Option<usize> {
+    let (digits, unit) = match s.char_indices().find(|&(_, c)| !c.is_ascii_digit()) {
+        Some((i, _)) => (&s[..i], &s[i..]),
+        None => (s, ""),
+    };
+    let shift = match unit {
+        "" | "B" => 0,
+        "K" | "KiB" => 10,
+        "M" | "MiB" => 20,
+        _ => return None,
+    };
+    digits.parse::<usize>().ok().map(|n| n << shift)
+}
+
+fn parse_list<T: ::std::str::FromStr>(s: &str) -> Option<Vec<T>> {
+    s.split(',').map(|n| n.parse().ok()).collect()
+}
+
+impl Default for Options {
+    fn default() -> Options {
+        Options {
+            samples: 1000,
+            max_time: Duration::from_secs(2),
+            max_payload: 16 << 20,
+            workers: vec![1, 2, 4],
+            threads: vec![1, 2, 4, 8],
+            filter: None,
+            json: None,
+            baseline: None,
+            threshold: 10.0,
+            label: String::new(),
+        }
+    }
+}
+
+impl Options {
+    /// Parses the command line. Prints the usage and returns `None` on
+    /// anything it does not understand.
+    pub fn from_args() -> Option<Options> {
+        let mut opts = Options::default();
+        let mut args = env::args().skip(1);
+        while let Some(arg) = args.next() {
+            let ok = match arg.as_str() {
+                "--quick" => {
+                    opts.samples = 100;
+                    opts.max_time = Duration::from_millis(200);
+                    opts.max_payload = 1 << 20;
+                    true
+                }
+                "--samples" => args.next().and_then(|v| v.parse().ok()).map(|v| opts.samples = v).is_some(),
+                "--max-time" => {
+                    args.next()
+                        .and_then(|v| v.parse::<f64>().ok())
+                        .map(|v| opts.max_time = Duration::from_millis((v * 1000.0) as u64))
+                        .is_some()
+                }
+                "--max-payload" => args.next().and_then(|v| parse_size(&v)).map(|v| opts.max_payload = v).is_some(),
+                "--workers" => args.next().and_then(|v| parse_list(&v)).map(|v| opts.workers = v).is_some(),
+                "--threads" => args.next().and_then(|v| parse_list(&v)).map(|v| opts.threads = v).is_some(),
+                "--filter" => args.next().map(|v| opts.filter = Some(v)).is_some(),
+                "--json" => args.next().map(|v| opts.json = Some(v)).is_some(),
+                "--baseline" => args.next().map(|v| opts.baseline = Some(v)).is_some(),
+                "--threshold" => args.next().and_then(|v| v.parse().ok()).map(|v| opts.threshold = v).is_some(),
+                "--label" => args.next().map(|v| opts.label = v).is_some(),
+                _ => false,
+            };
+            if !ok {
+                println!("{}", USAGE);
+                return None;
+            }
+        }
+        Some(opts)
+    }
+}
+
+/// What a benchmark measures. The name, with the parameters that are set,
+/// identifies the benchmark across runs.
+#[derive(Clone)]
+pub struct Id {
+    pub group: &'static str,
+    pub name: String,
+    pub bytes: Option<usize>,
+    pub threads: usize,
+    pub workers: u32,
+}
+
+impl Id {
+    pub fn new(group: &'static str, name: &str) -> Id {
+        Id { group: group, name: name.to_string(), bytes: None, threads: 0, workers: 0 }
+    }
+
+    pub fn bytes(mut self, bytes: usize) -> Id {
+        self.bytes = Some(bytes);
+        self
+    }
+
+    pub fn threads(mut self, threads: usize) -> Id {
+        self.threads = threads;
+        self
+    }
+
+    pub fn workers(mut self, workers: u32) -> Id {
+        self.workers = workers;
+        self
+    }
+
+    pub fn key(&self) -> String {
+        let mut key = format!("{}/{}", self.group, self.name);
+        if let Some(bytes) = self.bytes {
+            key += &format!("/{}", format_size(bytes));
+        }
+        if self.threads > 0 {
+            key += &format!("/threads={}", self.threads);
+        }
+        if self.workers > 0 {
+            key += &format!("/workers={}", self.workers);
+        }
+        key
+    }
+}
+
+fn format_size(bytes: usize) -> String {
+    if bytes >= 1 << 20 && bytes % (1 << 20) == 0 {
+        format!("{}M", bytes >> 20)
+    } else if bytes >= 1 << 10 && bytes % (1 << 10) == 0 {
+        format!("{}K", bytes >> 10)
+    } else {
+        format!("{}B", bytes)
+    }
+}
+
+/// Summary of the samples of a benchmark, in nanoseconds per operation.
+pub struct Stats {
+    pub samples: usize,
+    pub min: f64,
+    pub mean: f64,
+    pub stddev: f64,
+    pub p50: f64,
+    pub p90: f64,
+    pub p99: f64,
+    pub p999: f64,
+    pub max: f64,
+}
+
+impl Stats {
+    fn new(mut ns: Vec<f64>) -> Stats {
+        ns.sort_by(|a, b| a.partial_cmp(b).unwrap());
+        let n = ns.len();
+        let mean = ns.iter().sum::<f64>() / n as f64;
+        let var = ns.iter().map(|x| (x - mean) * (x - mean)).sum::<f64>() / n as f64;
+        // Nearest rank.
+        let pct = |p: f64| ns[((p * n as f64).ceil() as usize).max(1) - 1];
+        Stats {
+            samples: n,
+            min: ns[0],
+            mean: mean,
+            stddev: var.sqrt(),
+            p50: pct(0.5),
+            p90: pct(0.9),
+            p99: pct(0.99),
+            p999: pct(0.999),
+            max: ns[n - 1],
+        }
+    }
+}
+
+fn nanos(d: Duration) -> f64 {
+    d.as_secs() as f64 * 1e9 + d.subsec_nanos() as f64
+}
+
+struct Record {
+    id: Id,
+    ops_per_sample: u64,
+    stats: Stats,
+}
+
+impl Record {
+    fn to_json(&self) -> Value {
+        let s = &self.stats;
+        let mut v = json!({
+            "name": self.id.key(),
+            "group": self.id.group,
+            "bench": self.id.name,
+            "bytes": self.id.bytes.unwrap_or(0),
+            "threads": self.id.threads,
+            "workers": self.id.workers,
+            "samples": s.samples,
+            "ops_per_sample": self.ops_per_sample,
+            "min_ns": s.min,
+            "mean_ns": s.mean,
+            "stddev_ns": s.stddev,
+            "p50_ns": s.p50,
+            "p90_ns": s.p90,
+            "p99_ns": s.p99,
+            "p999_ns": s.p999,
+            "max_ns": s.max,
+        });
+        if let Some(bytes) = self.id.bytes.filter(|&b| b > 0) {
+            v["mib_per_s"] = json!(mib_per_s(bytes, s.p50));
+        }
+        v
+    }
+}
+
+fn mib_per_s(bytes: usize, ns: f64) -> f64 {
+    bytes as f64 / (1 << 20) as f64 / (ns / 1e9)
+}
+
+pub struct Harness {
+    pub opts: Options,
+    records: Vec<Record>,
+}
+
+impl Harness {
+    pub fn new(opts: Options) -> Harness {
+        let h = Harness { opts: opts, records: Vec::new() };
+        h.show(&format!("{:<48} {:>8} {:>12} {:>12} {:>12} {:>12} {:>10}",
+                        "benchmark", "samples", "p50", "p90", "p99", "max", "MiB/s"));
+        h
+    }
+
+    /// Prints a line of the report, to stderr if stdout takes the JSON.
+    pub fn show(&self, line: &str) {
+        match self.opts.json {
+            Some(ref path) if path == "-" => eprintln!("{}", line),
+            _ => println!("{}", line),
+        }
+    }
+
+    pub fn enabled(&self, id: &Id) -> bool {
+        match self.opts.filter {
+            Some(ref filter) => id.key().contains(filter.as_str()),
+            None => true,
+        }
+    }
+
+    /// Benchmarks `f`, which runs `ops` operations and reports the time
+    /// they took. Stops at the first error.
+    pub fn run<F>(&mut self, id: Id, ops: u64, mut f: F)
+    where
+        F: FnMut() -> Result<Duration, String>,
+    {
+        self.run_many(id, ops, || f().map(|d| vec![d]))
+    }
+
+    /// Benchmarks `f`, which takes several samples of `ops` operations at
+    /// a time, such as one per thread.
+    pub fn run_many<F>(&mut self, id: Id, ops: u64, f: F)
+    where
+        F: FnMut() -> Result<Vec<Duration>, String>,
+    {
+        if !self.enabled(&id) {
+            return;
+        }
+        match self.sample(ops, f) {
+            Ok(samples) => self.record(id, ops, samples),
+            Err(e) => self.show(&format!("{:<48} failed: {}", id.key(), e)),
+        }
+    }
+
+    fn sample<F>(&self, ops: u64, mut f: F) -> Result<Vec<f64>, String>
+    where
+        F: FnMut() -> Result<Vec<Duration>, String>,
+    {
+        for _ in 0..WARMUP_ROUNDS {
+            f()?;
+        }
+        let mut samples = Vec::with_capacity(self.opts.samples);
+        let start = Instant::now();
+        while samples.is_empty()
+            || (samples.len() < self.opts.samples
+                && (samples.len() < MIN_SAMPLES || start.elapsed() < self.opts.max_time)) {
+            let batch = f()?;
+            if batch.is_empty() {
+                return Err("no samples taken".to_string());
+            }
+            samples.extend(batch.into_iter().map(|d| nanos(d) / ops as f64));
+        }
+        Ok(samples)
+    }
+
+    fn record(&mut self, id: Id, ops_per_sample: u64, ns: Vec<f64>) {
+        let record = Record { id: id, ops_per_sample: ops_per_sample, stats: Stats::new(ns) };
+        let s = &record.stats;
+        let rate = match record.id.bytes.filter(|&b| b > 0) {
+            Some(bytes) => format!("{:.1}", mib_per_s(bytes, s.p50)),
+            None => String::new(),
+        };
+        self.show(&format!("{:<48} {:>8} {:>12} {:>12} {:>12} {:>12} {:>10}",
+                           record.id.key(), s.samples,
+                           format_ns(s.p50), format_ns(s.p90), format_ns(s.p99), format_ns(s.max), rate));
+        self.records.push(record);
+    }
+
+    /// Writes the JSON output and compares with the baseline, as asked.
+    /// Returns whether no benchmark regressed.
+    pub fn finish(&self) -> io::Result<bool> {
+        if let Some(ref path) = self.opts.json {
+            if path == "-" {
+                self.write_json(&mut io::stdout())?;
+            } else {
+                self.write_json(&mut File::create(path)?)?;
+            }
+        }
+        match self.opts.baseline {
+            Some(ref path) => self.compare(path),
+            None => Ok(true),
+        }
+    }
+
+    fn write_json<W: Write>(&self, w: &mut W) -> io::Result<()> {
+        let time = SystemTime::now().duration_since(UNIX_EPOCH).map(|d| d.as_secs()).unwrap_or(0);
+        let meta = json!({
+            "meta": {
+                "label": self.opts.label,
+                "timestamp": time,
+                "sgx_mode": env::var("SGX_MODE").unwrap_or_else(|_| "HW".to_string()),
+                "cpu": cpu_model(),
+                "samples": self.opts.samples,
+                "max_time_ms": self.opts.max_time.as_secs() * 1000 + self.opts.max_time.subsec_millis() as u64,
+            }
+        });
+        writeln!(w, "{}", meta)?;
+        for record in &self.records {
+            writeln!(w, "{}", record.to_json())?;
+        }
+        Ok(())
+    }
+
+    fn compare(&self, path: &str) -> io::Result<bool> {
+        let mut baseline = HashMap::new();
+        for line in BufReader::new(File::open(path)?).lines() {
+            let v: Value = match serde_json::from_str(&line?) {
+                Ok(v) => v,
+                Err(e) => return Err(io::Error::new(io::ErrorKind::InvalidData, e)),
+            };
+            if let (Some(name), Some(p50)) = (v["name"].as_str(), v["p50_ns"].as_f64()) {
+                baseline.insert(name.to_string(), p50);
+            }
+        }
+
+        self.show(&format!("\nCompared with {} (regression above +{}% on p50):", path, self.opts.threshold));
+        let mut ok = true;
+        for record in &self.records {
+            let key = record.id.key();
+            if let Some(&base) = baseline.get(&key) {
+                let (change, regressed) = change(base, record.stats.p50, self.opts.threshold);
+                ok &= !regressed;
+                self.show(&format!("{:<48} {:>12} -> {:>12} {:>+8.1}%{}",
+                                   key, format_ns(base), format_ns(record.stats.p50), change,
+                                   if regressed { "  REGRESSION" } else { "" }));
+            }
+        }
+        Ok(ok)
+    }
+}
+
+// The change from `base` to `p50` in percent, and whether it is a
+// regression, i.e. a slowdown of more than `threshold` percent.
+fn change(base: f64, p50: f64, threshold: f64) -> (f64, bool) {
+    let change = (p50 / base - 1.0) * 100.0;
+    (change, change > threshold)
+}
+
+fn format_ns(ns: f64) -> String {
+    if ns >= 1e9 {
+        format!("{:.2} s", ns / 1e9)
+    } else if ns >= 1e6 {
+        format!("{:.2} ms", ns / 1e6)
+    } else if ns >= 1e3 {
+        format!("{:.2} us", ns / 1e3)
+    } else {
+        format!("{:.0} ns", ns)
+    }
+}
+
+fn cpu_model() -> String {
+    File::open("/proc/cpuinfo")
+        .ok()
+        .and_then(|f| {
+            BufReader::new(f)
+                .lines()
+                .filter_map(|l| l.ok())
+                .find(|l| l.starts_with("model name"))
+                .and_then(|l| l.splitn(2, ':').nth(1).map(|m| m.trim().to_string()))
+        })
+        .unwrap_or_default()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn nearest_rank_percentiles() {
+        let s = Stats::new((1..101).rev().map(|n| n as f64).collect());
+        assert_eq!(s.samples, 100);
+        assert_eq!((s.min, s.max), (1.0, 100.0));
+        assert_eq!(s.mean, 50.5);
+        assert_eq!((s.p50, s.p90, s.p99, s.p999), (50.0, 90.0, 99.0, 100.0));
+
+        let s = Stats::new(vec![5.0, 1.0, 4.0, 2.0, 3.0]);
+        assert_eq!((s.p50, s.p90, s.p99, s.p999), (3.0, 5.0, 5.0, 5.0));
+        assert_eq!(s.stddev, 2.0f64.sqrt());
+
+        let s = Stats::new(vec![7.0]);
+        assert_eq!((s.min, s.p50, s.p999, s.max, s.stddev), (7.0, 7.0, 7.0, 7.0, 0.0));
+    }
+
+    #[test]
+    fn regression_threshold() {
+        assert_eq!(change(100.0, 100.0, 10.0), (0.0, false));
+        assert!(!change(100.0, 50.0, 10.0).1);
+        assert!(!change(100.0, 109.9, 10.0).1);
+        assert!(change(100.0, 110.1, 10.0).1);
+        assert!(change(100.0, 101.0, 0.0).1);
+    }
+
+    fn harness(threshold: f64) -> Harness {
+        let mut opts = Options::default();
+        opts.threshold = threshold;
+        Harness::new(opts)
+    }
+
+    #[test]
+    fn compare_with_baseline() {
+        let path = env::temp_dir().join(format!("bench-baseline-{}.json", std::process::id()));
+        let mut f = File::create(&path).unwrap();
+        writeln!(f, "{}", json!({"meta": {"label": "old"}})).unwrap();
+        writeln!(f, "{}", json!({"name": "ecall/empty", "p50_ns": 1000.0})).unwrap();
+        writeln!(f, "{}", json!({"name": "ecall/in/0B", "p50_ns": 2000.0})).unwrap();
+        drop(f);
+        let path = path.to_str().unwrap();
+
+        let mut h = harness(10.0);
+        h.record(Id::new("ecall", "empty"), 1, vec![1050.0]);
+        h.record(Id::new("ecall", "in").bytes(0), 1, vec![1900.0]);
+        // Not in the baseline, so never a regression.
+        h.record(Id::new("ecall", "out").bytes(0), 1, vec![1e9]);
+        assert!(h.compare(path).unwrap());
+
+        h.record(Id::new("ecall", "empty").workers(1), 1, vec![1.0]);
+        h.record(Id::new("ecall", "in").bytes(0), 1, vec![2300.0]);
+        assert!(!h.compare(path).unwrap());
+        std::fs::remove_file(path).unwrap();
+    }
+
+    #[test]
+    fn sized_and_unsized_ids() {
+        assert_eq!(Id::new("ecall", "in").key(), "ecall/in");
+        assert_eq!(Id::new("ecall", "in").bytes(0).key(), "ecall/in/0B");
+        assert_eq!(Id::new("ecall", "in").bytes(64 << 10).workers(2).key(), "ecall/in/64K/workers=2");
+    }
+
+    #[test]
+    fn sample_fails_without_samples() {
+        let h = harness(10.0);
+        assert!(h.sample(1, || Ok(Vec::new())).is_err());
+        let mut calls = 0;
+        let samples = h.sample(2, || {
+            calls += 1;
+            Ok(vec![Duration::from_nanos(10)])
+        }).unwrap();
+        assert_eq!(samples.len(), h.opts.samples);
+        assert!(samples.iter().all(|&ns| ns == 5.0));
+        assert_eq!(calls, WARMUP_ROUNDS + h.opts.samples);
+    }
+}
@@ -0,0 +1,390 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+#![feature(link_args)]
+#![allow(unused_attributes)]
+#![link_args = "-Wl,--whole-archive -lsgx_uswitchless -Wl,--no-whole-archive"]
+
+extern crate sgx_types;
+extern crate sgx_urts;
+#[macro_use]
+extern crate lazy_static;
+#[macro_use]
+extern crate serde_json;
+
+use sgx_types::*;
+use sgx_urts::SgxEnclave;
+
+use std::process;
+use std::ptr;
+use std::sync::{Arc, Barrier, Mutex};
+use std::thread;
+use std::time::{Duration, Instant};
+
+mod harness;
+
+use harness::{Harness, Id, Options};
+
+static ENCLAVE_FILE: &'static str = "enclave.signed.so";
+
+// Must match the enclave.
+const KIND_EMPTY: u32 = 0;
+const KIND_IN: u32 = 1;
+const KIND_OUT: u32 = 2;
+const KIND_USER_CHECK: u32 = 3;
+
+const OP_SEAL: u32 = 0;
+const OP_UNSEAL: u32 = 1;
+const OP_AES_GCM_ENCRYPT: u32 = 2;
+const OP_AES_GCM_DECRYPT: u32 = 3;
+const OP_WRITE: u32 = 4;
+const OP_READ: u32 = 5;
+const OP_SEND_RECV: u32 = 6;
+
+// A sized buffer of 0 bytes still goes through the marshalling of the
+// bridges, unlike the argument-less empty calls.
+const PAYLOADS: &'static [usize] = &[0, 64, 4 << 10, 64 << 10, 1 << 20, 16 << 20];
+// OCALL payloads are copied onto the untrusted stack of the calling thread.
+const MAX_OCALL_PAYLOAD: usize = 1 << 20;
+// The enclave sends and receives a whole payload on one socket pair.
+const MAX_SEND_RECV_PAYLOAD: usize = 64 << 10;
+const MAX_IO_PAYLOAD: usize = 1 << 20;
+const CRYPTO_PAYLOADS: &'static [usize] = &[1 << 10, 64 << 10, 1 << 20, 16 << 20];
+
+// OCALLs per ECALL; the first one of every batch yields no sample.
+const OCALL_BATCH: u64 = 101;
+// In-enclave work is timed in batches of about this many bytes, or of
+// this many calls for small payloads, to hide the ECALL around them.
+const BATCH_BYTES: usize = 1 << 20;
+const MAX_BATCH: u64 = 1000;
+const MUTEX_OPS: u64 = 10000;
+const CONDVAR_ROUNDS: u64 = 1000;
+
+extern {
+    fn ecall_empty(eid: sgx_enclave_id_t) -> sgx_status_t;
+    fn ecall_empty_switchless(eid: sgx_enclave_id_t) -> sgx_status_t;
+    fn ecall_in(eid: sgx_enclave_id_t, buf: *const u8, len: usize) -> sgx_status_t;
+    fn ecall_in_switchless(eid: sgx_enclave_id_t, buf: *const u8, len: usize) -> sgx_status_t;
+    fn ecall_out(eid: sgx_enclave_id_t, buf: *mut u8, len: usize) -> sgx_status_t;
+    fn ecall_out_switchless(eid: sgx_enclave_id_t, buf: *mut u8, len: usize) -> sgx_status_t;
+    fn ecall_user_check(eid: sgx_enclave_id_t, buf: *mut u8, len: usize) -> sgx_status_t;
+    fn ecall_user_check_switchless(eid: sgx_enclave_id_t, buf: *mut u8, len: usize) -> sgx_status_t;
+
+    fn ecall_ocall_loop(eid: sgx_enclave_id_t, retval: *mut sgx_status_t,
+                        kind: u32, switchless: i32,
+                        buf: *mut u8, len: usize,
+                        count: u64) -> sgx_status_t;
+
+    fn ecall_mutex_loop(eid: sgx_enclave_id_t, count: u64) -> sgx_status_t;
+    fn ecall_condvar_ring(eid: sgx_enclave_id_t, id: u32, threads: u32, rounds: u64) -> sgx_status_t;
+
+    fn ecall_prepare(eid: sgx_enclave_id_t, retval: *mut sgx_status_t, op: u32, len: usize) -> sgx_status_t;
+    fn ecall_run(eid: sgx_enclave_id_t, retval: *mut sgx_status_t, op: u32, count: u64) -> sgx_status_t;
+}
+
+fn init_enclave(workers: u32) -> SgxResult<SgxEnclave> {
+    let mut launch_token: sgx_launch_token_t = [0; 1024];
+    let mut launch_token_updated: i32 = 0;
+    // call sgx_create_enclave to initialize an enclave instance
+    // Debug Support: set 2nd parameter to 1
+    let debug = 1;
+    let mut misc_attr = sgx_misc_attribute_t {secs_attr: sgx_attributes_t { flags:0, xfrm:0}, misc_select:0};
+    if workers == 0 {
+        SgxEnclave::create(ENCLAVE_FILE,
+                           debug,
+                           &mut launch_token,
+                           &mut launch_token_updated,
+                           &mut misc_attr)
+    } else {
+        SgxEnclave::create_with_workers(ENCLAVE_FILE,
+                                        debug,
+                                        &mut launch_token,
+                                        &mut launch_token_updated,
+                                        &mut misc_attr,
+                                        workers,
+                                        workers)
+    }
+}
+
+lazy_static! {
+    // Entry times of the OCALLs. The time between two entries is one round
+    // trip: the return into the enclave and the next exit.
+    static ref OCALL_STAMPS: Mutex<Vec<Instant>> = Mutex::new(Vec::new());
+}
+
+fn stamp() {
+    let now = Instant::now();
+    OCALL_STAMPS.lock().unwrap().push(now);
+}
+
+#[no_mangle]
+pub extern "C"
+fn ocall_empty() {
+    stamp();
+}
+
+#[no_mangle]
+pub extern "C"
+fn ocall_empty_switchless() {
+    stamp();
+}
+
+#[no_mangle]
+pub extern "C"
+fn ocall_in(_buf: *const u8, _len: usize) {
+    stamp();
+}
+
+#[no_mangle]
+pub extern "C"
+fn ocall_in_switchless(_buf: *const u8, _len: usize) {
+    stamp();
+}
+
+#[no_mangle]
+pub extern "C"
+fn ocall_out(_buf: *mut u8, _len: usize) {
+    stamp();
+}
+
+#[no_mangle]
+pub extern "C"
+fn ocall_out_switchless(_buf: *mut u8, _len: usize) {
+    stamp();
+}
+
+#[no_mangle]
+pub extern "C"
+fn ocall_user_check(_buf: *mut u8, _len: usize) {
+    stamp();
+}
+
+#[no_mangle]
+pub extern "C"
+fn ocall_user_check_switchless(_buf: *mut u8, _len: usize) {
+    stamp();
+}
+
+fn check(status: sgx_status_t) -> Result<(), String> {
+    match status {
+        sgx_status_t::SGX_SUCCESS => Ok(()),
+        e => Err(e.as_str().to_string()),
+    }
+}
+
+fn time<F: FnOnce() -> sgx_status_t>(f: F) -> Result<Duration, String> {
+    let start = Instant::now();
+    let status = f();
+    let elapsed = start.elapsed();
+    check(status).map(|_| elapsed)
+}
+
+fn payloads(h: &Harness, sizes: &[usize], max: usize) -> Vec<usize> {
+    sizes.iter().cloned().filter(|&len| len <= max && len <= h.opts.max_payload).collect()
+}
+
+fn suffix(workers: u32) -> &'static str {
+    if workers > 0 { "_switchless" } else { "" }
+}
+
+// With `workers`, the enclave has that many switchless workers on each
+// side and the switchless ECALLs are measured.
+fn bench_ecalls(h: &mut Harness, eid: sgx_enclave_id_t, workers: u32) {
+    let switchless = workers > 0;
+    let name = |kind: &str| format!("{}{}", kind, suffix(workers));
+
+    let f = if switchless { ecall_empty_switchless } else { ecall_empty };
+    h.run(Id::new("ecall", &name("empty")).workers(workers), 1, || time(|| unsafe { f(eid) }));
+
+    for len in payloads(h, PAYLOADS, usize::max_value()) {
+        let mut buf = vec![0u8; len];
+        let p = buf.as_mut_ptr();
+
+        let f = if switchless { ecall_in_switchless } else { ecall_in };
+        let id = Id::new("ecall", &name("in")).bytes(len).workers(workers);
+        h.run(id, 1, || time(|| unsafe { f(eid, p, len) }));
+
+        let f = if switchless { ecall_out_switchless } else { ecall_out };
+        let id = Id::new("ecall", &name("out")).bytes(len).workers(workers);
+        h.run(id, 1, || time(|| unsafe { f(eid, p, len) }));
+
+        let f = if switchless { ecall_user_check_switchless } else { ecall_user_check };
+        let id = Id::new("ecall", &name("user_check")).bytes(len).workers(workers);
+        h.run(id, 1, || time(|| unsafe { f(eid, p, len) }));
+    }
+}
+
+// Makes a batch of OCALLs and returns the time of every round trip after
+// the first. `buf` is only passed to the user_check OCALLs; the enclave
+// brings its own `len` bytes for the others.
+fn ocall_batch(eid: sgx_enclave_id_t, kind: u32, workers: u32, buf: *mut u8, len: usize)
+               -> Result<Vec<Duration>, String> {
+    OCALL_STAMPS.lock().unwrap().clear();
+    let mut retval = sgx_status_t::SGX_SUCCESS;
+    check(unsafe { ecall_ocall_loop(eid, &mut retval, kind, (workers > 0) as i32, buf, len, OCALL_BATCH) })?;
+    check(retval)?;
+    let stamps = OCALL_STAMPS.lock().unwrap();
+    Ok(stamps.windows(2).map(|w| w[1].duration_since(w[0])).collect())
+}
+
+fn bench_ocalls(h: &mut Harness, eid: sgx_enclave_id_t, workers: u32) {
+    let name = |kind: &str| format!("{}{}", kind, suffix(workers));
+
+    let id = Id::new("ocall", &name("empty")).workers(workers);
+    h.run_many(id, 1, || ocall_batch(eid, KIND_EMPTY, workers, ptr::null_mut(), 0));
+
+    for len in payloads(h, PAYLOADS, usize::max_value()) {
+        if len <= MAX_OCALL_PAYLOAD {
+            let id = Id::new("ocall", &name("in")).bytes(len).workers(workers);
+            h.run_many(id, 1, || ocall_batch(eid, KIND_IN, workers, ptr::null_mut(), len));
+            let id = Id::new("ocall", &name("out")).bytes(len).workers(workers);
+            h.run_many(id, 1, || ocall_batch(eid, KIND_OUT, workers, ptr::null_mut(), len));
+        }
+        let mut buf = vec![0u8; len];
+        let p = buf.as_mut_ptr();
+        let id = Id::new("ocall", &name("user_check")).bytes(len).workers(workers);
+        h.run_many(id, 1, || ocall_batch(eid, KIND_USER_CHECK, workers, p, len));
+    }
+}
+
+// Starts `threads` threads together, runs `f(i)` on thread `i` and returns
+// the time each took.
+fn on_threads<F>(threads: usize, f: F) -> Result<Vec<Duration>, String>
+where
+    F: Fn(usize) -> sgx_status_t + Send + Sync + 'static,
+{
+    let f = Arc::new(f);
+    let start = Arc::new(Barrier::new(threads));
+    let handles: Vec<_> = (0..threads)
+        .map(|i| {
+            let (f, start) = (f.clone(), start.clone());
+            thread::spawn(move || {
+                start.wait();
+                time(|| f(i))
+            })
+        })
+        .collect();
+    handles.into_iter()
+           .map(|h| h.join().unwrap_or_else(|_| Err("thread panicked".to_string())))
+           .collect()
+}
+
+fn bench_locks(h: &mut Harness, eid: sgx_enclave_id_t) {
+    for threads in h.opts.threads.clone() {
+        let id = Id::new("sync", "mutex").threads(threads);
+        h.run_many(id, MUTEX_OPS, || on_threads(threads, move |_| unsafe { ecall_mutex_loop(eid, MUTEX_OPS) }));
+
+        // A ring of one never waits.
+        if threads > 1 {
+            let id = Id::new("sync", "condvar_handoff").threads(threads);
+            let n = threads as u32;
+            h.run_many(id, CONDVAR_ROUNDS * threads as u64, || {
+                on_threads(threads, move |i| unsafe { ecall_condvar_ring(eid, i as u32, n, CONDVAR_ROUNDS) })
+            });
+        }
+    }
+}
+
+// Times batches of the in-enclave operation `op` on `len` bytes.
+fn bench_op(h: &mut Harness, eid: sgx_enclave_id_t, group: &'static str, name: &str, op: u32, len: usize) {
+    let id = Id::new(group, name).bytes(len);
+    if !h.enabled(&id) {
+        return;
+    }
+    let mut retval = sgx_status_t::SGX_SUCCESS;
+    let prepared = check(unsafe { ecall_prepare(eid, &mut retval, op, len) }).and_then(|_| check(retval));
+    if let Err(e) = prepared {
+        h.show(&format!("{:<48} failed: {}", id.key(), e));
+        return;
+    }
+    let batch = ((BATCH_BYTES / len.max(1)) as u64).max(1).min(MAX_BATCH);
+    h.run(id, batch, || {
+        let mut retval = sgx_status_t::SGX_SUCCESS;
+        let elapsed = time(|| unsafe { ecall_run(eid, &mut retval, op, batch) })?;
+        check(retval).map(|_| elapsed)
+    });
+}
+
+fn bench_libc(h: &mut Harness, eid: sgx_enclave_id_t) {
+    // An empty read or write says nothing about the libc path.
+    for len in payloads(h, PAYLOADS, MAX_IO_PAYLOAD).into_iter().filter(|&len| len > 0) {
+        bench_op(h, eid, "libc", "write", OP_WRITE, len);
+        bench_op(h, eid, "libc", "read", OP_READ, len);
+    }
+    for len in payloads(h, PAYLOADS, MAX_SEND_RECV_PAYLOAD).into_iter().filter(|&len| len > 0) {
+        bench_op(h, eid, "libc", "send_recv", OP_SEND_RECV, len);
+    }
+}
+
+fn bench_crypto(h: &mut Harness, eid: sgx_enclave_id_t) {
+    for len in payloads(h, CRYPTO_PAYLOADS, usize::max_value()) {
+        bench_op(h, eid, "crypto", "seal", OP_SEAL, len);
+        bench_op(h, eid, "crypto", "unseal", OP_UNSEAL, len);
+        bench_op(h, eid, "crypto", "aes_gcm_encrypt", OP_AES_GCM_ENCRYPT, len);
+        bench_op(h, eid, "crypto", "aes_gcm_decrypt", OP_AES_GCM_DECRYPT, len);
+    }
+}
+
+fn with_enclave<F: FnOnce(sgx_enclave_id_t)>(workers: u32, f: F) -> bool {
+    match init_enclave(workers) {
+        Ok(enclave) => {
+            f(enclave.geteid());
+            enclave.destroy();
+            true
+        },
+        Err(x) => {
+            println!("[-] Init Enclave Failed {}!", x.as_str());
+            false
+        },
+    }
+}
+
+fn main() {
+    let opts = match Options::from_args() {
+        Some(opts) => opts,
+        None => process::exit(2),
+    };
+    let mut h = Harness::new(opts);
+
+    let ok = with_enclave(0, |eid| {
+        bench_ecalls(&mut h, eid, 0);
+        bench_ocalls(&mut h, eid, 0);
+        bench_locks(&mut h, eid);
+        bench_libc(&mut h, eid);
+        bench_crypto(&mut h, eid);
+    });
+    if !ok {
+        process::exit(1);
+    }
+
+    // The workers are set when the enclave is created.
+    for workers in h.opts.workers.clone() {
+        with_enclave(workers, |eid| {
+            bench_ecalls(&mut h, eid, workers);
+            bench_ocalls(&mut h, eid, workers);
+        });
+    }
+
+    match h.finish() {
+        Ok(true) => {},
+        Ok(false) => process::exit(1),
+        Err(e) => {
+            println!("[-] Cannot write or compare the results: {}", e);
+            process::exit(1);
+        },
+    }
+}
@@ -0,0 +1,348 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! The trusted half of the benchmark suite.
+//!
+//! Nothing here reads a clock: SGX1 has no trusted one, and an OCALL to
+//! get the time would cost as much as some of the things measured. The
+//! app times every ECALL from the outside instead. Each ECALL either does
+//! one thing or repeats it `count` times.
+
+#![crate_name = "benchmarkenclave"]
+#![crate_type = "staticlib"]
+
+#![cfg_attr(not(target_env = "sgx"), no_std)]
+#![cfg_attr(target_env = "sgx", feature(rustc_private))]
+
+extern crate sgx_types;
+extern crate sgx_trts;
+extern crate sgx_libc;
+extern crate sgx_tcrypto;
+extern crate sgx_tseal;
+#[cfg(not(target_env = "sgx"))]
+#[macro_use]
+extern crate sgx_tstd as std;
+#[macro_use]
+extern crate lazy_static;
+
+use sgx_libc::{c_int, c_void};
+use sgx_trts::trts::rsgx_raw_is_outside_enclave;
+use sgx_tseal::SgxSealedData;
+use sgx_types::*;
+use std::sync::{SgxCondvar, SgxMutex};
+use std::vec::Vec;
+
+// Kinds of OCALL for `ecall_ocall_loop`.
+const KIND_EMPTY: u32 = 0;
+const KIND_IN: u32 = 1;
+const KIND_OUT: u32 = 2;
+const KIND_USER_CHECK: u32 = 3;
+
+// Operations for `ecall_prepare` and `ecall_run`.
+const OP_SEAL: u32 = 0;
+const OP_UNSEAL: u32 = 1;
+const OP_AES_GCM_ENCRYPT: u32 = 2;
+const OP_AES_GCM_DECRYPT: u32 = 3;
+const OP_WRITE: u32 = 4;
+const OP_READ: u32 = 5;
+const OP_SEND_RECV: u32 = 6;
+
+// Both ends of a socket pair must hold a whole payload, as one thread
+// sends it and then receives it.
+const MAX_SEND_RECV_LEN: usize = 64 * 1024;
+
+const GCM_KEY: sgx_aes_gcm_128bit_key_t = [0; SGX_AESGCM_KEY_SIZE];
+const GCM_IV: [u8; SGX_AESGCM_IV_SIZE] = [0; SGX_AESGCM_IV_SIZE];
+
+extern "C" {
+    fn ocall_empty() -> sgx_status_t;
+    fn ocall_empty_switchless() -> sgx_status_t;
+    fn ocall_in(buf: *const u8, len: usize) -> sgx_status_t;
+    fn ocall_in_switchless(buf: *const u8, len: usize) -> sgx_status_t;
+    fn ocall_out(buf: *mut u8, len: usize) -> sgx_status_t;
+    fn ocall_out_switchless(buf: *mut u8, len: usize) -> sgx_status_t;
+    fn ocall_user_check(buf: *mut u8, len: usize) -> sgx_status_t;
+    fn ocall_user_check_switchless(buf: *mut u8, len: usize) -> sgx_status_t;
+}
+
+// The input and output of an operation, set up by `ecall_prepare`.
+struct Prepared {
+    op: u32,
+    data: Vec<u8>,
+    out: Vec<u8>,
+    mac: sgx_aes_gcm_128bit_tag_t,
+    fds: [c_int; 2],
+}
+
+impl Drop for Prepared {
+    fn drop(&mut self) {
+        for &fd in self.fds.iter().filter(|&&fd| fd >= 0) {
+            unsafe { sgx_libc::ocall::close(fd); }
+        }
+    }
+}
+
+struct Ring {
+    turn: SgxMutex<u64>,
+    passed: SgxCondvar,
+}
+
+lazy_static! {
+    static ref PREPARED: SgxMutex<Option<Prepared>> = SgxMutex::new(None);
+    static ref CONTENDED: SgxMutex<u64> = SgxMutex::new(0);
+    static ref RING: Ring = Ring { turn: SgxMutex::new(0), passed: SgxCondvar::new() };
+}
+
+fn status(result: SgxError) -> sgx_status_t {
+    match result {
+        Ok(()) => sgx_status_t::SGX_SUCCESS,
+        Err(e) => e,
+    }
+}
+
+#[no_mangle]
+pub extern "C" fn ecall_empty() {}
+
+#[no_mangle]
+pub extern "C" fn ecall_empty_switchless() {}
+
+#[no_mangle]
+pub extern "C" fn ecall_in(_buf: *const u8, _len: usize) {}
+
+#[no_mangle]
+pub extern "C" fn ecall_in_switchless(_buf: *const u8, _len: usize) {}
+
+#[no_mangle]
+pub extern "C" fn ecall_out(_buf: *mut u8, _len: usize) {}
+
+#[no_mangle]
+pub extern "C" fn ecall_out_switchless(_buf: *mut u8, _len: usize) {}
+
+#[no_mangle]
+pub extern "C" fn ecall_user_check(_buf: *mut u8, _len: usize) {}
+
+#[no_mangle]
+pub extern "C" fn ecall_user_check_switchless(_buf: *mut u8, _len: usize) {}
+
+#[no_mangle]
+pub extern "C" fn ecall_ocall_loop(kind: u32, switchless: c_int,
+                                   buf: *mut u8, len: usize,
+                                   count: u64) -> sgx_status_t {
+    let mut payload = match kind {
+        // Never empty, so that a 0-byte payload still points into the
+        // enclave as the bridge checks.
+        KIND_IN | KIND_OUT => vec![0u8; len.max(1)],
+        KIND_EMPTY | KIND_USER_CHECK => Vec::new(),
+        _ => return sgx_status_t::SGX_ERROR_INVALID_PARAMETER,
+    };
+    if kind == KIND_USER_CHECK && (buf.is_null() || !rsgx_raw_is_outside_enclave(buf, len)) {
+        return sgx_status_t::SGX_ERROR_INVALID_PARAMETER;
+    }
+    let p = payload.as_mut_ptr();
+    let switchless = switchless != 0;
+    for _ in 0..count {
+        let ret = unsafe {
+            match (kind, switchless) {
+                (KIND_EMPTY, false) => ocall_empty(),
+                (KIND_EMPTY, true) => ocall_empty_switchless(),
+                (KIND_IN, false) => ocall_in(p, len),
+                (KIND_IN, true) => ocall_in_switchless(p, len),
+                (KIND_OUT, false) => ocall_out(p, len),
+                (KIND_OUT, true) => ocall_out_switchless(p, len),
+                (_, false) => ocall_user_check(buf, len),
+                (_, true) => ocall_user_check_switchless(buf, len),
+            }
+        };
+        if ret != sgx_status_t::SGX_SUCCESS {
+            return ret;
+        }
+    }
+    sgx_status_t::SGX_SUCCESS
+}
+
+#[no_mangle]
+pub extern "C" fn ecall_mutex_loop(count: u64) {
+    for _ in 0..count {
+        let mut n = CONTENDED.lock().unwrap();
+        *n += 1;
+    }
+}
+
+// The token is never reset: any `threads` consecutive turns still visit
+// every place in the ring once, whatever the previous run left behind.
+#[no_mangle]
+pub extern "C" fn ecall_condvar_ring(id: u32, threads: u32, rounds: u64) {
+    if threads == 0 || id >= threads {
+        return;
+    }
+    let mut turn = RING.turn.lock().unwrap();
+    for _ in 0..rounds {
+        while *turn % threads as u64 != id as u64 {
+            turn = RING.passed.wait(turn).unwrap();
+        }
+        *turn += 1;
+        RING.passed.broadcast();
+    }
+}
+
+fn open(path: &[u8], flags: c_int) -> SgxResult<c_int> {
+    let fd = unsafe { sgx_libc::ocall::open(path.as_ptr() as *const _, flags) };
+    if fd < 0 {
+        return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+    }
+    Ok(fd)
+}
+
+fn prepare(op: u32, len: usize) -> SgxResult<Prepared> {
+    let mut p = Prepared {
+        op: op,
+        data: (0..len).map(|i| i as u8).collect(),
+        out: Vec::new(),
+        mac: [0; SGX_AESGCM_MAC_SIZE],
+        fds: [-1, -1],
+    };
+    match op {
+        OP_SEAL | OP_UNSEAL => {
+            let size = SgxSealedData::<[u8]>::calc_raw_sealed_data_size(0, len as u32);
+            if size == u32::max_value() {
+                return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+            }
+            p.out = vec![0; size as usize];
+            if op == OP_UNSEAL {
+                seal(&mut p)?;
+            }
+        }
+        OP_AES_GCM_ENCRYPT | OP_AES_GCM_DECRYPT => {
+            p.out = vec![0; len];
+            if op == OP_AES_GCM_DECRYPT {
+                sgx_tcrypto::rsgx_rijndael128GCM_encrypt(&GCM_KEY, &p.data, &GCM_IV, &[], &mut p.out, &mut p.mac)?;
+            }
+        }
+        OP_WRITE => p.fds[0] = open(b"/dev/null\0", sgx_libc::O_WRONLY | sgx_libc::O_CLOEXEC)?,
+        OP_READ => p.fds[0] = open(b"/dev/zero\0", sgx_libc::O_RDONLY | sgx_libc::O_CLOEXEC)?,
+        OP_SEND_RECV => {
+            if len > MAX_SEND_RECV_LEN {
+                return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+            }
+            let ret = unsafe {
+                sgx_libc::ocall::socketpair(sgx_libc::AF_UNIX, sgx_libc::SOCK_STREAM | sgx_libc::SOCK_CLOEXEC,
+                                            0, p.fds.as_mut_ptr())
+            };
+            if ret != 0 {
+                return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+            }
+            p.out = vec![0; len];
+        }
+        _ => return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER),
+    }
+    Ok(p)
+}
+
+fn seal(p: &mut Prepared) -> SgxError {
+    let sealed = SgxSealedData::<[u8]>::seal_data(&[], &p.data)?;
+    let raw = p.out.as_mut_ptr() as *mut sgx_sealed_data_t;
+    unsafe { sealed.to_raw_sealed_data_t(raw, p.out.len() as u32) }
+        .map(|_| ())
+        .ok_or(sgx_status_t::SGX_ERROR_UNEXPECTED)
+}
+
+fn unseal(p: &mut Prepared) -> SgxError {
+    let raw = p.out.as_mut_ptr() as *mut sgx_sealed_data_t;
+    let sealed = unsafe { SgxSealedData::<[u8]>::from_raw_sealed_data_t(raw, p.out.len() as u32) }
+        .ok_or(sgx_status_t::SGX_ERROR_INVALID_PARAMETER)?;
+    sealed.unseal_data().map(|_| ())
+}
+
+// Repeats an I/O call until it has moved all of `len` bytes.
+fn transfer<F>(len: usize, mut io: F) -> SgxError
+where
+    F: FnMut(usize) -> isize,
+{
+    let mut done = 0;
+    while done < len {
+        let n = io(done);
+        if n <= 0 {
+            return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+        }
+        done += n as usize;
+    }
+    Ok(())
+}
+
+fn run(p: &mut Prepared, count: u64) -> SgxError {
+    let len = p.data.len();
+    for _ in 0..count {
+        match p.op {
+            OP_SEAL => seal(p)?,
+            OP_UNSEAL => unseal(p)?,
+            OP_AES_GCM_ENCRYPT => {
+                sgx_tcrypto::rsgx_rijndael128GCM_encrypt(&GCM_KEY, &p.data, &GCM_IV, &[], &mut p.out, &mut p.mac)?
+            }
+            OP_AES_GCM_DECRYPT => {
+                sgx_tcrypto::rsgx_rijndael128GCM_decrypt(&GCM_KEY, &p.out, &GCM_IV, &[], &p.mac, &mut p.data)?
+            }
+            OP_WRITE => {
+                let (fd, data) = (p.fds[0], &p.data);
+                transfer(len, |done| unsafe {
+                    sgx_libc::ocall::write(fd, data[done..].as_ptr() as *const c_void, len - done)
+                })?
+            }
+            OP_READ => {
+                let (fd, data) = (p.fds[0], &mut p.data);
+                transfer(len, |done| unsafe {
+                    sgx_libc::ocall::read(fd, data[done..].as_mut_ptr() as *mut c_void, len - done)
+                })?
+            }
+            _ => {
+                let (fds, data, out) = (p.fds, &p.data, &mut p.out);
+                transfer(len, |done| unsafe {
+                    sgx_libc::ocall::send(fds[0], data[done..].as_ptr() as *const c_void, len - done, 0)
+                })?;
+                transfer(len, |done| unsafe {
+                    sgx_libc::ocall::recv(fds[1], out[done..].as_mut_ptr() as *mut c_void, len - done, 0)
+                })?;
+            }
+        }
+    }
+    Ok(())
+}
+
+/// Sets up `op` on a payload of `len` bytes, replacing whatever was
+/// prepared before.
+#[no_mangle]
+pub extern "C" fn ecall_prepare(op: u32, len: usize) -> sgx_status_t {
+    let mut prepared = PREPARED.lock().unwrap();
+    // Release the old payload and descriptors first.
+    *prepared = None;
+    match prepare(op, len) {
+        Ok(p) => {
+            *prepared = Some(p);
+            sgx_status_t::SGX_SUCCESS
+        }
+        Err(e) => e,
+    }
+}
+
+/// Runs the prepared `op` `count` times.
+#[no_mangle]
+pub extern "C" fn ecall_run(op: u32, count: u64) -> sgx_status_t {
+    let mut prepared = PREPARED.lock().unwrap();
+    match *prepared {
+        Some(ref mut p) if p.op == op => status(run(p, count)),
+        _ => sgx_status_t::SGX_ERROR_INVALID_STATE,
+    }
+}
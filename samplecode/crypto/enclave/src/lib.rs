@@ -443,4 +443,76 @@ pub extern "C" fn rsa_key(text: * const u8, text_len: usize) -> sgx_status_t {
     }
 
     sgx_status_t::SGX_SUCCESS
-}
\ No newline at end of file
+}
+/// Encrypts and decrypts `count` messages of `size` bytes, either one
+/// `rsgx_rijndael128GCM_encrypt`/`decrypt` call per message or in batches
+/// through `rsgx_rijndael128GCM_batch`, for the untrusted side to time.
+#[no_mangle]
+pub extern "C" fn bench_aes_gcm(batched: u32, count: u32, size: u32) -> sgx_status_t {
+    let result = if batched != 0 {
+        bench_aes_gcm_batched(count as usize, size as usize)
+    } else {
+        bench_aes_gcm_single(count as usize, size as usize)
+    };
+    match result {
+        Ok(()) => sgx_status_t::SGX_SUCCESS,
+        Err(ret) => ret,
+    }
+}
+
+const BENCH_KEY: sgx_aes_gcm_128bit_key_t = [0x2b; SGX_AESGCM_KEY_SIZE];
+const BENCH_BATCH: usize = 64;
+
+fn bench_iv(index: usize) -> [u8; SGX_AESGCM_IV_SIZE] {
+    let mut iv = [0_u8; SGX_AESGCM_IV_SIZE];
+    iv[..8].copy_from_slice(&(index as u64).to_le_bytes());
+    iv
+}
+
+fn bench_aes_gcm_single(count: usize, size: usize) -> SgxError {
+    let aad: [u8; 0] = [0; 0];
+    let plaintext = vec![0x5a_u8; size];
+    let mut ciphertext = vec![0_u8; size];
+    let mut decrypted = vec![0_u8; size];
+    for index in 0..count {
+        let iv = bench_iv(index);
+        let mut mac = [0_u8; SGX_AESGCM_MAC_SIZE];
+        rsgx_rijndael128GCM_encrypt(&BENCH_KEY, &plaintext, &iv, &aad, &mut ciphertext, &mut mac)?;
+        rsgx_rijndael128GCM_decrypt(&BENCH_KEY, &ciphertext, &iv, &aad, &mac, &mut decrypted)?;
+        if decrypted != plaintext {
+            return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+        }
+    }
+    Ok(())
+}
+
+fn bench_aes_gcm_batched(count: usize, size: usize) -> SgxError {
+    let aad: [u8; 0] = [0; 0];
+    let plaintext = vec![0x5a_u8; size];
+    let mut bufs = vec![plaintext.clone(); BENCH_BATCH];
+    let mut macs = vec![[0_u8; SGX_AESGCM_MAC_SIZE]; BENCH_BATCH];
+    let mut first = 0;
+    while first < count {
+        let n = std::cmp::min(BENCH_BATCH, count - first);
+        let ivs: Vec<[u8; SGX_AESGCM_IV_SIZE]> = (first..first + n).map(bench_iv).collect();
+        {
+            let mut jobs = Vec::with_capacity(n);
+            for ((buf, mac), iv) in bufs.iter_mut().zip(macs.iter_mut()).zip(ivs.iter()) {
+                jobs.push(SgxAesGcmJob::encrypt_in_place(&BENCH_KEY, buf, iv, &aad, mac)?);
+            }
+            rsgx_rijndael128GCM_batch(&mut jobs)?;
+        }
+        {
+            let mut jobs = Vec::with_capacity(n);
+            for ((buf, mac), iv) in bufs.iter_mut().zip(macs.iter()).zip(ivs.iter()) {
+                jobs.push(SgxAesGcmJob::decrypt_in_place(&BENCH_KEY, buf, iv, &aad, mac)?);
+            }
+            rsgx_rijndael128GCM_batch(&mut jobs)?;
+        }
+        if bufs[..n].iter().any(|buf| *buf != plaintext) {
+            return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+        }
+        first += n;
+    }
+    Ok(())
+}
@@ -17,14 +17,43 @@
 
 extern crate sgx_types;
 extern crate sgx_urts;
+extern crate ring;
 use sgx_types::*;
 use sgx_urts::SgxEnclave;
 
+// The tree of the server, to stand in for it.
+#[path = "../../../db-server/src/verifytree/mod.rs"]
+#[allow(dead_code)]
+mod verifytree;
+
+use verifytree::RingSha256;
+use verifytree::mbtree::MerkleBTree;
+
 static ENCLAVE_FILE: &'static str = "enclave.signed.so";
 
+const PRESENT_TREE: u8 = 0;
+
 extern {
     fn say_something(eid: sgx_enclave_id_t, retval: *mut sgx_status_t,
                      some_string: *const u8, len: usize) -> sgx_status_t;
+
+    fn ecall_verify_get(eid: sgx_enclave_id_t, retval: *mut sgx_status_t,
+                        tree: u8,
+                        key: *const u8, key_len: usize,
+                        proof: *const u8, proof_len: usize,
+                        version: *mut u64,
+                        found: *mut u8) -> sgx_status_t;
+
+    fn ecall_apply_put(eid: sgx_enclave_id_t, retval: *mut sgx_status_t,
+                       tree: u8,
+                       key: *const u8, key_len: usize,
+                       version: u64,
+                       proof: *const u8, proof_len: usize) -> sgx_status_t;
+
+    fn ecall_apply_delete(eid: sgx_enclave_id_t, retval: *mut sgx_status_t,
+                          tree: u8,
+                          key: *const u8, key_len: usize,
+                          proof: *const u8, proof_len: usize) -> sgx_status_t;
 }
 
 fn init_enclave() -> SgxResult<SgxEnclave> {
@@ -42,6 +71,82 @@ fn init_enclave() -> SgxResult<SgxEnclave> {
                        &mut misc_attr)
 }
 
+// Fails with the status of the ECALL, or else with the one it returned.
+fn ecall_result(result: sgx_status_t, retval: sgx_status_t) -> SgxResult<()> {
+    match (result, retval) {
+        (sgx_status_t::SGX_SUCCESS, sgx_status_t::SGX_SUCCESS) => Ok(()),
+        (sgx_status_t::SGX_SUCCESS, e) | (e, _) => Err(e),
+    }
+}
+
+fn verify_get(eid: sgx_enclave_id_t, key: &[u8], proof: &[u8]) -> SgxResult<Option<u64>> {
+    let mut retval = sgx_status_t::SGX_SUCCESS;
+    let mut version = 0;
+    let mut found = 0;
+    let result = unsafe {
+        ecall_verify_get(eid, &mut retval, PRESENT_TREE,
+                         key.as_ptr(), key.len(),
+                         proof.as_ptr(), proof.len(),
+                         &mut version, &mut found)
+    };
+    ecall_result(result, retval)?;
+    Ok(if found != 0 { Some(version) } else { None })
+}
+
+fn apply_put(eid: sgx_enclave_id_t, key: &[u8], version: u64, proof: &[u8]) -> SgxResult<()> {
+    let mut retval = sgx_status_t::SGX_SUCCESS;
+    let result = unsafe {
+        ecall_apply_put(eid, &mut retval, PRESENT_TREE,
+                        key.as_ptr(), key.len(),
+                        version,
+                        proof.as_ptr(), proof.len())
+    };
+    ecall_result(result, retval)
+}
+
+fn apply_delete(eid: sgx_enclave_id_t, key: &[u8], proof: &[u8]) -> SgxResult<()> {
+    let mut retval = sgx_status_t::SGX_SUCCESS;
+    let result = unsafe {
+        ecall_apply_delete(eid, &mut retval, PRESENT_TREE,
+                           key.as_ptr(), key.len(),
+                           proof.as_ptr(), proof.len())
+    };
+    ecall_result(result, retval)
+}
+
+// Plays the server with a local tree. Every put and delete goes to the tree
+// and then, with the path the tree returns, to the trusted root in the
+// enclave, and the enclave checks every get against that root.
+fn merkle_tree_round_trip(eid: sgx_enclave_id_t) -> SgxResult<()> {
+    let mut tree = MerkleBTree::<RingSha256>::new();
+    let key = |i: u64| format!("key{:06}", i).into_bytes();
+
+    for i in 0..100 {
+        let proof = tree.put(&key(i), i);
+        apply_put(eid, &key(i), i, &proof)?;
+    }
+    for i in (0..100).step_by(2) {
+        let proof = tree.delete(&key(i));
+        apply_delete(eid, &key(i), &proof)?;
+    }
+    for i in 0..100 {
+        let (version, proof) = tree.get(&key(i));
+        let expected = if i % 2 == 0 { None } else { Some(i) };
+        if version != expected || verify_get(eid, &key(i), &proof)? != expected {
+            return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+        }
+    }
+
+    // A path from before an update no longer matches the trusted root.
+    let stale = tree.prove(&key(1));
+    let proof = tree.put(&key(1), 100);
+    apply_put(eid, &key(1), 100, &proof)?;
+    match verify_get(eid, &key(1), &stale) {
+        Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER) => Ok(()),
+        _ => Err(sgx_status_t::SGX_ERROR_UNEXPECTED),
+    }
+}
+
 fn main() {
 
     let enclave = match init_enclave() {
@@ -76,5 +181,13 @@ fn main() {
 
     println!("[+] say_something success...");
 
+    match merkle_tree_round_trip(enclave.geteid()) {
+        Ok(()) => println!("[+] Merkle tree round trip success..."),
+        Err(e) => {
+            println!("[-] Merkle tree round trip failed {}!", e.as_str());
+            return;
+        }
+    }
+
     enclave.destroy();
 }
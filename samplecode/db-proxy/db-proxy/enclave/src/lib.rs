@@ -22,15 +22,133 @@
 #![cfg_attr(target_env = "sgx", feature(rustc_private))]
 
 extern crate sgx_types;
+extern crate sgx_tcrypto;
 #[cfg(not(target_env = "sgx"))]
 #[macro_use]
 extern crate sgx_tstd as std;
+#[macro_use]
+extern crate lazy_static;
 
 use sgx_types::*;
 use std::string::String;
 use std::vec::Vec;
 use std::io::{self, Write};
+use std::enclave;
 use std::slice;
+use std::sync::SgxMutex;
+
+// The verifier, the tree and the cache are the ones the server uses.
+#[path = "../../../db-server/src/verifytree/proof.rs"]
+#[allow(dead_code)]
+mod proof;
+#[path = "../../../db-server/src/verifytree/mbtree.rs"]
+#[allow(dead_code)]
+mod mbtree;
+#[path = "../../../db-server/src/verifytree/cache.rs"]
+mod cache;
+
+use cache::VerifiedNodeCache;
+use mbtree::{MerkleBTree, TreeOp};
+use proof::{Digest, ProofError, VerifiedPath};
+
+struct TcryptoSha256;
+
+impl proof::Sha256 for TcryptoSha256 {
+    fn sha256(data: &[u8]) -> Digest {
+        sgx_tcrypto::rsgx_sha256_slice(data).expect("sha256 failed")
+    }
+}
+
+const PRESENT_TREE: u8 = 0;
+const DELETED_TREE: u8 = 1;
+
+const OP_GET: u8 = 0;
+const OP_PUT: u8 = 1;
+const OP_DELETE: u8 = 2;
+
+struct Trusted {
+    // Roots of the present and deleted trees.
+    roots: [Digest; 2],
+    // Shared by both trees, as a node is trusted by its digest alone.
+    cache: VerifiedNodeCache,
+}
+
+lazy_static! {
+    static ref TRUSTED: SgxMutex<Trusted> = {
+        let empty = proof::empty_root::<TcryptoSha256>();
+        SgxMutex::new(Trusted {
+            roots: [empty, empty],
+            // An eighth of the enclave heap.
+            cache: VerifiedNodeCache::new(enclave::get_heap_size() / 8),
+        })
+    };
+}
+
+fn tree_index(tree: u8) -> Option<usize> {
+    match tree {
+        PRESENT_TREE | DELETED_TREE => Some(tree as usize),
+        _ => None,
+    }
+}
+
+fn proof_status(e: ProofError) -> sgx_status_t {
+    println!("[-] Rejected Merkle tree proof: {:?}", e);
+    sgx_status_t::SGX_ERROR_INVALID_PARAMETER
+}
+
+// Verifies `proof` as the path of `key` in `tree` and, if `apply` returns a
+// new root, makes it the trusted one.
+fn with_verified_path<F>(tree: u8, key: &[u8], proof: &[u8], apply: F) -> sgx_status_t
+where
+    F: FnOnce(VerifiedPath, &mut VerifiedNodeCache) -> Option<Digest>,
+{
+    let i = match tree_index(tree) {
+        Some(i) => i,
+        None => return sgx_status_t::SGX_ERROR_INVALID_PARAMETER,
+    };
+    let mut guard = match TRUSTED.lock() {
+        Ok(guard) => guard,
+        Err(_) => return sgx_status_t::SGX_ERROR_UNEXPECTED,
+    };
+    let trusted = &mut *guard;
+    match proof::verify_cached::<TcryptoSha256, _>(&trusted.roots[i], key, proof, &mut trusted.cache) {
+        Ok(path) => {
+            if let Some(root) = apply(path, &mut trusted.cache) {
+                trusted.roots[i] = root;
+            }
+            sgx_status_t::SGX_SUCCESS
+        }
+        Err(e) => proof_status(e),
+    }
+}
+
+// A batch is
+//     count: u32, (op: u8, klen: u16, key, version: u64 for a put)*count
+// with integers in little endian.
+fn decode_ops(buf: &[u8]) -> Result<Vec<TreeOp>, ProofError> {
+    let mut r = proof::Reader { buf: buf };
+    let b = r.bytes(4)?;
+    let count = u32::from_le_bytes([b[0], b[1], b[2], b[3]]) as usize;
+    // Every operation takes at least three bytes.
+    if count > buf.len() / 3 {
+        return Err(ProofError::Malformed);
+    }
+    let mut ops = Vec::with_capacity(count);
+    for _ in 0..count {
+        let op = r.bytes(1)?[0];
+        let key = r.key()?;
+        ops.push(match op {
+            OP_GET => TreeOp::Get(key),
+            OP_PUT => TreeOp::Put(key, r.u64()?),
+            OP_DELETE => TreeOp::Delete(key),
+            _ => return Err(ProofError::Malformed),
+        });
+    }
+    if !r.buf.is_empty() {
+        return Err(ProofError::Malformed);
+    }
+    Ok(ops)
+}
 
 #[no_mangle]
 pub extern "C" fn say_something(some_string: *const u8, some_len: usize) -> sgx_status_t {
@@ -61,4 +179,126 @@ pub extern "C" fn say_something(some_string: *const u8, some_len: usize) -> sgx_
     println!("{}", &hello_string);
 
     sgx_status_t::SGX_SUCCESS
-}
\ No newline at end of file
+}
+
+/// Checks the path of `key` returned by a get and reports the version the
+/// tree holds for it.
+#[no_mangle]
+pub extern "C" fn ecall_verify_get(tree: u8,
+                                   key: *const u8, key_len: usize,
+                                   proof: *const u8, proof_len: usize,
+                                   version: *mut u64,
+                                   found: *mut u8) -> sgx_status_t {
+    let key = unsafe { slice::from_raw_parts(key, key_len) };
+    let proof = unsafe { slice::from_raw_parts(proof, proof_len) };
+    with_verified_path(tree, key, proof, |path, _| {
+        let v = path.version();
+        unsafe {
+            *version = v.unwrap_or(0);
+            *found = v.is_some() as u8;
+        }
+        None
+    })
+}
+
+/// Checks the path of `key` as it was before the server put `version` and
+/// advances the trusted root accordingly.
+#[no_mangle]
+pub extern "C" fn ecall_apply_put(tree: u8,
+                                  key: *const u8, key_len: usize,
+                                  version: u64,
+                                  proof: *const u8, proof_len: usize) -> sgx_status_t {
+    let key = unsafe { slice::from_raw_parts(key, key_len) };
+    let proof = unsafe { slice::from_raw_parts(proof, proof_len) };
+    with_verified_path(tree, key, proof, |path, cache| {
+        Some(path.put_cached::<TcryptoSha256, _>(version, cache))
+    })
+}
+
+/// Checks the path of `key` as it was before the server deleted it and
+/// advances the trusted root accordingly.
+#[no_mangle]
+pub extern "C" fn ecall_apply_delete(tree: u8,
+                                     key: *const u8, key_len: usize,
+                                     proof: *const u8, proof_len: usize) -> sgx_status_t {
+    let key = unsafe { slice::from_raw_parts(key, key_len) };
+    let proof = unsafe { slice::from_raw_parts(proof, proof_len) };
+    with_verified_path(tree, key, proof, |path, cache| {
+        Some(path.delete_cached::<TcryptoSha256, _>(cache))
+    })
+}
+
+/// Runs a batch of operations on `tree`, checked against one multiproof
+/// covering all their keys, and advances the trusted root. Reports, for
+/// every operation, the version its key had before it.
+#[no_mangle]
+pub extern "C" fn ecall_apply_batch(tree: u8,
+                                    ops: *const u8, ops_len: usize,
+                                    proof: *const u8, proof_len: usize,
+                                    versions: *mut u64,
+                                    found: *mut u8,
+                                    count: usize) -> sgx_status_t {
+    let i = match tree_index(tree) {
+        Some(i) => i,
+        None => return sgx_status_t::SGX_ERROR_INVALID_PARAMETER,
+    };
+    let ops = unsafe { slice::from_raw_parts(ops, ops_len) };
+    let proof = unsafe { slice::from_raw_parts(proof, proof_len) };
+    let versions = unsafe { slice::from_raw_parts_mut(versions, count) };
+    let found = unsafe { slice::from_raw_parts_mut(found, count) };
+
+    let ops = match decode_ops(ops) {
+        Ok(ref ops) if ops.len() != count => return sgx_status_t::SGX_ERROR_INVALID_PARAMETER,
+        Ok(ops) => ops,
+        Err(e) => return proof_status(e),
+    };
+    let mut guard = match TRUSTED.lock() {
+        Ok(guard) => guard,
+        Err(_) => return sgx_status_t::SGX_ERROR_UNEXPECTED,
+    };
+    let trusted = &mut *guard;
+    let mut partial = match MerkleBTree::<TcryptoSha256>::from_multiproof_cached(&trusted.roots[i], proof, &mut trusted.cache) {
+        Ok(partial) => partial,
+        Err(e) => return proof_status(e),
+    };
+    let before = match partial.apply_cached(&ops, &mut trusted.cache) {
+        Ok(before) => before,
+        Err(e) => return proof_status(e),
+    };
+    for (j, v) in before.iter().enumerate() {
+        versions[j] = v.unwrap_or(0);
+        found[j] = v.is_some() as u8;
+    }
+    trusted.roots[i] = partial.root();
+    sgx_status_t::SGX_SUCCESS
+}
+
+/// Sets the bytes of enclave memory the verified-node cache may take.
+#[no_mangle]
+pub extern "C" fn ecall_set_cache_budget(bytes: usize) -> sgx_status_t {
+    match TRUSTED.lock() {
+        Ok(mut trusted) => {
+            trusted.cache.set_budget(bytes);
+            sgx_status_t::SGX_SUCCESS
+        }
+        Err(_) => sgx_status_t::SGX_ERROR_UNEXPECTED,
+    }
+}
+
+#[no_mangle]
+pub extern "C" fn ecall_cache_stats(hits: *mut u64,
+                                    misses: *mut u64,
+                                    bytes: *mut usize) -> sgx_status_t {
+    match TRUSTED.lock() {
+        Ok(trusted) => {
+            let (h, m) = trusted.cache.stats();
+            unsafe {
+                *hits = h;
+                *misses = m;
+                *bytes = trusted.cache.bytes();
+            }
+            sgx_status_t::SGX_SUCCESS
+        }
+        Err(_) => sgx_status_t::SGX_ERROR_UNEXPECTED,
+    }
+}
@@ -20,6 +20,7 @@ pub struct response {
 pub fn client_test(server: &mut server) {
     insert_data(server);
     modify_data(server);
+    batch_get(server);
 }
 
 pub fn insert_data(server: &mut server) {
@@ -117,6 +118,15 @@ pub fn modify_data(server: &mut server) {
     println!("{:?}", rsp);
 }
 
+pub fn batch_get(server: &mut server) {
+    let keys: Vec<String> = vec!["db", "dba", "dbb", "dbc", "dbd"]
+        .into_iter()
+        .map(String::from)
+        .collect();
+    let values = server.veritasdb_get_many(&keys);
+    println!("batch get {:?}: {:?}", keys, values);
+}
+
 pub fn send_req(server: &mut server, req: request) -> response {
     server.handle_req(req)
 }
@@ -1,10 +1,6 @@
-extern crate hex;
-extern crate merklebtree;
 extern crate parking_lot;
 extern crate ring;
 extern crate rocksdb;
-extern crate serde;
-extern crate serde_json;
 
 mod client;
 mod server;
@@ -1,212 +1,144 @@
 use crate::client::*;
-use crate::verifytree::mbtree::*;
-use hex;
-use merklebtree::iterator::prev;
-use merklebtree::merklebtree::{MerkleBTree, Nodes};
-use merklebtree::node::Node;
-use merklebtree::sgxdb;
-use merklebtree::traits::CalculateHash;
+use crate::verifytree::mbtree::{MerkleBTree, TreeOp};
+use crate::verifytree::proof::{self, Digest};
+use crate::verifytree::RingSha256;
 use parking_lot::RwLock;
+use ring::hmac;
 use ring::hmac::Key;
-use ring::{digest, hmac, rand};
-use rocksdb::{DBVector, DB};
-use serde::{Deserialize, Serialize};
-use std::collections::HashMap;
+use rocksdb::DB;
+use std::convert::TryInto;
 use std::sync::Arc;
 
+const TAG_LEN: usize = 32;
+
 pub struct server {
     db_handler: Arc<RwLock<DB>>,
     sgx_counter: i32,
     hmac_key: Key,
-    present_mbtree: Merklebtree,
-    deleted_mbtree: Merklebtree,
-    sgx_present_root_node: Node<key_version>,
-    sgx_delete_root_node: Node<key_version>,
+    present_mbtree: MerkleBTree<RingSha256>,
+    deleted_mbtree: MerkleBTree<RingSha256>,
+    // The roots the enclave trusts. Every path the trees return is checked
+    // against them, and they are only advanced through verified paths.
+    sgx_present_root: Digest,
+    sgx_delete_root: Digest,
 }
 
-//hmacPayload is used to compute hmac
-#[derive(Clone, Deserialize, Serialize, Debug)]
-pub struct hmac_payload {
-    key: String,
-    value: String,
-    counter: i32,
+#[derive(Clone, Debug)]
+pub struct search_result {
+    pub version: u64,
+    pub existed: bool,
 }
 
-//storePayload is used to store value in the db
-#[derive(Clone, Deserialize, Serialize, Debug)]
-pub struct store_payload {
-    value: String,
-    tag: String,
-    ctr: i32,
+// The message authenticated for a value is
+//     key length: u32 || key || counter: u64 || value
+// and the value is stored as
+//     counter: u64 || tag || value
+// with integers in little endian.
+fn hmac_message(key: &[u8], ctr: u64, value: &[u8]) -> Vec<u8> {
+    let mut msg = Vec::with_capacity(4 + key.len() + 8 + value.len());
+    msg.extend_from_slice(&(key.len() as u32).to_le_bytes());
+    msg.extend_from_slice(key);
+    msg.extend_from_slice(&ctr.to_le_bytes());
+    msg.extend_from_slice(value);
+    msg
 }
 
-#[derive(Clone, Debug)]
-pub struct sgx_private_data {
-    hmac_key: Key,
-    sgx_counter: i32,
-    persisted_present_hash: String,
-    persisted_present_hmac: String,
-    persisted_deleted_hash: String,
-    persisted_deleted_hmac: String,
+fn store_payload(ctr: u64, tag: &[u8], value: &[u8]) -> Vec<u8> {
+    let mut payload = Vec::with_capacity(8 + TAG_LEN + value.len());
+    payload.extend_from_slice(&ctr.to_le_bytes());
+    payload.extend_from_slice(tag);
+    payload.extend_from_slice(value);
+    payload
 }
 
-#[derive(Clone, Deserialize, Serialize, Debug)]
-pub struct mbtree_payload {
-    root_hash: String,
-    sgx_counter: i32,
+fn parse_store_payload(payload: &[u8]) -> Option<(u64, &[u8], &[u8])> {
+    if payload.len() < 8 + TAG_LEN {
+        return None;
+    }
+    let ctr = u64::from_le_bytes(payload[..8].try_into().unwrap());
+    Some((ctr, &payload[8..8 + TAG_LEN], &payload[8 + TAG_LEN..]))
+}
+
+fn tree_search(tree: &mut MerkleBTree<RingSha256>, root: &Digest, key: &[u8]) -> search_result {
+    let (_, path) = tree.get(key);
+    let verified = proof::verify::<RingSha256>(root, key, &path).expect("verify failed");
+    match verified.version() {
+        Some(version) => search_result { version, existed: true },
+        None => search_result { version: 0, existed: false },
+    }
+}
+
+fn tree_put(tree: &mut MerkleBTree<RingSha256>, root: &mut Digest, key: &[u8], version: u64) {
+    let path = tree.put(key, version);
+    let verified = proof::verify::<RingSha256>(root, key, &path).expect("verify failed");
+    *root = verified.put::<RingSha256>(version);
+    assert_eq!(*root, tree.root());
+}
+
+fn tree_remove(tree: &mut MerkleBTree<RingSha256>, root: &mut Digest, key: &[u8]) {
+    let path = tree.delete(key);
+    let verified = proof::verify::<RingSha256>(root, key, &path).expect("verify failed");
+    *root = verified.delete::<RingSha256>();
+    assert_eq!(*root, tree.root());
+}
+
+// Runs `ops` with a single multiproof for all their keys, and returns the
+// version each key had before its operation.
+fn tree_batch(tree: &mut MerkleBTree<RingSha256>, root: &mut Digest, ops: &[TreeOp]) -> Vec<Option<u64>> {
+    let keys: Vec<&[u8]> = ops.iter().map(|op| op.key()).collect();
+    let multiproof = tree.multiproof(&keys);
+    let before = tree.apply(ops).unwrap();
+
+    let mut partial = MerkleBTree::<RingSha256>::from_multiproof(root, &multiproof).expect("verify failed");
+    let verified = partial.apply(ops).expect("verify failed");
+    assert_eq!(before, verified);
+    *root = partial.root();
+    assert_eq!(*root, tree.root());
+    verified
 }
 
 impl server {
-    fn db_put(&mut self, key: String, value: String) {
+    fn db_put(&mut self, key: &[u8], value: &[u8]) {
         let db = self.db_handler.clone();
-        db.write().put(key.as_bytes(), value.as_bytes()).unwrap();
+        db.write().put(key, value).unwrap();
     }
 
-    fn db_get(&mut self, key: String) -> String {
+    fn db_get(&mut self, key: &[u8]) -> Option<Vec<u8>> {
         let db = self.db_handler.clone();
-        let r = db.read().get(key.as_str());
+        let r = db.read().get(key);
         match r {
-            Err(t) => return String::new(),
-            Ok(t) => match t {
-                None => return String::new(),
-                Some(t) => return t.to_utf8().unwrap().to_string(),
-            },
+            Ok(Some(t)) => Some(t.to_vec()),
+            _ => None,
         }
     }
 
-    fn db_delete(&mut self, key: String) {
+    fn db_delete(&mut self, key: &[u8]) {
         let db = self.db_handler.clone();
-        db.write().delete(key.as_bytes()).unwrap();
+        db.write().delete(key).unwrap();
     }
 
-    fn present_search(&mut self, key: String) -> search_result {
-        let (get_result, mut present_subnodes) = self.present_mbtree.search(key);
-        if get_result.existed {
-            present_subnodes.nodes_map.remove(&0).unwrap();
-            present_subnodes
-                .nodes_map
-                .insert(0, self.sgx_present_root_node.clone());
-            sgxdb::verify_subnodes_hash(&present_subnodes);
-        }
-        get_result
+    fn present_search(&mut self, key: &[u8]) -> search_result {
+        tree_search(&mut self.present_mbtree, &self.sgx_present_root, key)
     }
 
-    fn delete_search(&mut self, key: String) -> search_result {
-        let (get_result, mut delete_subnodes) = self.deleted_mbtree.search(key);
-        if get_result.existed {
-            delete_subnodes.nodes_map.remove(&0).unwrap();
-            delete_subnodes
-                .nodes_map
-                .insert(0, self.sgx_delete_root_node.clone());
-            sgxdb::verify_subnodes_hash(&delete_subnodes);
-        }
-        get_result
+    fn delete_search(&mut self, key: &[u8]) -> search_result {
+        tree_search(&mut self.deleted_mbtree, &self.sgx_delete_root, key)
     }
 
-    fn present_remove(&mut self, key: String) {
-        let mut present_subnodes = self.present_mbtree.delete(key.clone());
-        if present_subnodes.nodes_map.len() == 0 {
-            return;
-        }
-
-        present_subnodes.nodes_map.remove(&0).unwrap();
-        present_subnodes
-            .nodes_map
-            .insert(0, self.sgx_present_root_node.clone());
-
-        sgxdb::verify_subnodes_hash(&present_subnodes);
-
-        let kv = key_version {
-            key: key.clone(),
-            version: 0,
-        };
-
-        self.present_mbtree
-            .mbtree
-            .remove(kv.clone(), &mut present_subnodes);
-
-        let node_hash = self.present_mbtree.nodes.merkleroot();
-        let subnode_hash = present_subnodes.merkleroot();
-        assert_eq!(node_hash, subnode_hash);
-
-        self.sgx_present_root_node = present_subnodes.nodes_map.remove(&0).unwrap();
+    fn present_remove(&mut self, key: &[u8]) {
+        tree_remove(&mut self.present_mbtree, &mut self.sgx_present_root, key);
     }
 
-    fn delete_remove(&mut self, key: String) {
-        let mut delete_subnodes = self.deleted_mbtree.delete(key.clone());
-        if delete_subnodes.nodes_map.len() == 0 {
-            return;
-        }
-
-        delete_subnodes.nodes_map.remove(&0).unwrap();
-        delete_subnodes
-            .nodes_map
-            .insert(0, self.sgx_delete_root_node.clone());
-
-        sgxdb::verify_subnodes_hash(&delete_subnodes);
-        let kv = key_version {
-            key: key.clone(),
-            version: 0,
-        };
-        self.deleted_mbtree
-            .mbtree
-            .remove(kv.clone(), &mut delete_subnodes);
-
-        let node_hash = self.deleted_mbtree.nodes.merkleroot();
-        let subnode_hash = delete_subnodes.merkleroot();
-        assert_eq!(node_hash, subnode_hash);
-
-        self.sgx_delete_root_node = delete_subnodes.nodes_map.remove(&0).unwrap();
+    fn delete_remove(&mut self, key: &[u8]) {
+        tree_remove(&mut self.deleted_mbtree, &mut self.sgx_delete_root, key);
     }
 
-    fn present_build_with_kv(&mut self, kv: key_version) {
-        if self.sgx_present_root_node.content.len() == 0 {
-            self.sgx_present_root_node = Node::new_node(kv.clone(), 0);
-            self.sgx_present_root_node.root_flag = true;
-            self.present_mbtree.build_with_key_value(kv.clone());
-            return;
-        }
-        let mut present_subnodes = self.present_mbtree.build_with_key_value(kv.clone());
-        present_subnodes.nodes_map.remove(&0).unwrap();
-        present_subnodes
-            .nodes_map
-            .insert(0, self.sgx_present_root_node.clone());
-
-        sgxdb::verify_subnodes_hash(&present_subnodes);
-        self.present_mbtree
-            .mbtree
-            .put(kv.clone(), &mut present_subnodes);
-
-        let node_hash = self.present_mbtree.nodes.merkleroot();
-        let subnode_hash = present_subnodes.merkleroot();
-        assert_eq!(node_hash, subnode_hash);
-
-        self.sgx_present_root_node = present_subnodes.nodes_map.remove(&0).unwrap();
+    fn present_build_with_kv(&mut self, key: &[u8], version: u64) {
+        tree_put(&mut self.present_mbtree, &mut self.sgx_present_root, key, version);
     }
 
-    fn delete_build_with_kv(&mut self, kv: key_version) {
-        if self.sgx_delete_root_node.content.len() == 0 {
-            self.sgx_delete_root_node = Node::new_node(kv.clone(), 0);
-            self.sgx_delete_root_node.root_flag = true;
-            self.deleted_mbtree.build_with_key_value(kv.clone());
-            return;
-        }
-        let mut delete_subnodes = self.deleted_mbtree.build_with_key_value(kv.clone());
-        delete_subnodes.nodes_map.remove(&0).unwrap();
-        delete_subnodes
-            .nodes_map
-            .insert(0, self.sgx_present_root_node.clone());
-
-        sgxdb::verify_subnodes_hash(&delete_subnodes);
-        self.deleted_mbtree
-            .mbtree
-            .put(kv.clone(), &mut delete_subnodes);
-
-        let node_hash = self.deleted_mbtree.nodes.merkleroot();
-        let subnode_hash = delete_subnodes.merkleroot();
-        assert_eq!(node_hash, subnode_hash);
-
-        self.sgx_delete_root_node = delete_subnodes.nodes_map.remove(&0).unwrap();
+    fn delete_build_with_kv(&mut self, key: &[u8], version: u64) {
+        tree_put(&mut self.deleted_mbtree, &mut self.sgx_delete_root, key, version);
     }
 }
 
@@ -222,10 +154,10 @@ pub fn new_server(key_value: Vec<u8>) -> server {
         db_handler,
         sgx_counter: 0,
         hmac_key: s_key,
-        present_mbtree: new_mbtree(),
-        deleted_mbtree: new_mbtree(),
-        sgx_present_root_node: Node::new_empty(0),
-        sgx_delete_root_node: Node::new_empty(0),
+        present_mbtree: MerkleBTree::new(),
+        deleted_mbtree: MerkleBTree::new(),
+        sgx_present_root: proof::empty_root::<RingSha256>(),
+        sgx_delete_root: proof::empty_root::<RingSha256>(),
     }
 }
 
@@ -253,54 +185,36 @@ impl server {
     }
 
     pub fn veritasdb_get(&mut self, req: request) -> String {
-        let data = self.db_get(req.key.clone());
-        if data == "".to_string() {
-            return String::new();
-        }
-
-        let sp: store_payload = serde_json::from_str(data.as_str()).unwrap();
-        let hmac_data = hmac_payload {
-            key: req.key.clone(),
-            value: sp.value.clone(),
-            counter: sp.ctr,
+        let key = req.key.as_bytes();
+        let data = match self.db_get(key) {
+            Some(data) => data,
+            None => return String::new(),
         };
-        let hmac_string = serde_json::to_string(&hmac_data).unwrap();
-        let verify_result = self.verify_hmac(hmac_string, sp.tag.clone());
 
-        let sr = self.present_search(req.key.clone());
-        if verify_result && sp.ctr == sr.version {
-            return sp.value;
+        let (ctr, tag, value) = parse_store_payload(&data).expect("verify failed");
+        let verify_result = self.verify_hmac(&hmac_message(key, ctr, value), tag);
+
+        let sr = self.present_search(key);
+        if verify_result && sr.existed && ctr == sr.version {
+            String::from_utf8_lossy(value).into_owned()
         } else {
             panic!("verify failed");
         }
-        String::new();
     }
 
     pub fn veritasdb_put(&mut self, req: request) {
-        let get_result = self.present_search(req.key.clone());
+        let key = req.key.as_bytes();
+        let value = req.value.as_bytes();
+        let get_result = self.present_search(key);
         if get_result.existed {
-            let hmac_data = hmac_payload {
-                key: req.key.clone(),
-                value: req.value.clone(),
-                counter: get_result.version + 1,
-            };
-            let hmac_string = serde_json::to_string(&hmac_data).unwrap();
-            let tag_string = self.compute_hmac(hmac_string);
+            let ctr = get_result.version + 1;
+            let tag = self.compute_hmac(&hmac_message(key, ctr, value));
 
             //try to put it into kvdb
-            let store_data = store_payload {
-                value: req.value.clone().to_string(),
-                tag: tag_string,
-                ctr: get_result.version + 1,
-            };
-            let store_string = serde_json::to_string(&store_data).unwrap();
-            self.db_put(req.key.clone(), store_string.clone());
+            self.db_put(key, &store_payload(ctr, tag.as_ref(), value));
 
             //update present if there is no error
-            self.present_build_with_kv(key_version {
-                key: req.key,
-                version: get_result.version + 1,
-            });
+            self.present_build_with_kv(key, ctr);
         } else {
             println!("key doesn't exist in present when called put");
             return;
@@ -308,70 +222,66 @@ impl server {
     }
 
     pub fn veritasdb_insert(&mut self, req: request) {
-        let sr = self.present_search(req.key.clone());
+        let key = req.key.as_bytes();
+        let value = req.value.as_bytes();
+        let sr = self.present_search(key);
         if sr.existed {
             println!("key existed in present when called insert");
             return;
         } else {
-            let mut ctr = 0;
-            let delete_sr = self.delete_search(req.key.clone());
-            if delete_sr.existed {
-                ctr = delete_sr.version + 1;
+            let delete_sr = self.delete_search(key);
+            let ctr = if delete_sr.existed {
+                delete_sr.version + 1
             } else {
-                ctr = 0;
-            }
-            let hmac_data = hmac_payload {
-                key: req.key.clone(),
-                value: req.value.clone(),
-                counter: ctr,
+                0
             };
-            let hmac_string = serde_json::to_string(&hmac_data).unwrap();
-            let tag_string = self.compute_hmac(hmac_string);
+            let tag = self.compute_hmac(&hmac_message(key, ctr, value));
+
+            self.db_put(key, &store_payload(ctr, tag.as_ref(), value));
+            self.present_build_with_kv(key, ctr);
+            self.delete_remove(key);
+        }
+    }
 
-            let store_data = store_payload {
-                value: req.value,
-                ctr: ctr,
-                tag: tag_string,
+    /// Gets many keys, checking their versions with one multiproof.
+    pub fn veritasdb_get_many(&mut self, keys: &[String]) -> Vec<String> {
+        let ops: Vec<TreeOp> = keys.iter().map(|key| TreeOp::Get(key.as_bytes())).collect();
+        let versions = tree_batch(&mut self.present_mbtree, &mut self.sgx_present_root, &ops);
+
+        let mut values = Vec::with_capacity(keys.len());
+        for (key, version) in keys.iter().zip(versions) {
+            let key = key.as_bytes();
+            let value = match (self.db_get(key), version) {
+                (None, None) => String::new(),
+                (Some(data), Some(version)) => {
+                    let (ctr, tag, value) = parse_store_payload(&data).expect("verify failed");
+                    if ctr != version || !self.verify_hmac(&hmac_message(key, ctr, value), tag) {
+                        panic!("verify failed");
+                    }
+                    String::from_utf8_lossy(value).into_owned()
+                }
+                _ => panic!("verify failed"),
             };
-            let store_string = serde_json::to_string(&store_data).unwrap();
-            self.db_put(req.key.clone(), store_string);
-            self.present_build_with_kv(key_version {
-                key: req.key.clone(),
-                version: ctr,
-            });
-            self.delete_remove(req.key.clone());
+            values.push(value);
         }
+        values
     }
 
     pub fn veritasdb_delete(&mut self, req: request) {
-        let get_result = self.db_get(req.key.clone());
-        if get_result == "".to_string() {
-        } else {
-            self.db_delete(req.key.clone());
-            let sr = self.present_search(req.key.clone());
-            self.delete_build_with_kv(key_version {
-                key: req.key.clone(),
-                version: sr.version,
-            });
-            self.present_remove(req.key.clone());
+        let key = req.key.as_bytes();
+        if self.db_get(key).is_some() {
+            self.db_delete(key);
+            let sr = self.present_search(key);
+            self.delete_build_with_kv(key, sr.version);
+            self.present_remove(key);
         }
     }
 
-    pub fn compute_hmac(&mut self, msg: String) -> String {
-        let tag = hmac::sign(&self.hmac_key, msg.as_str().as_bytes());
-        let tag_string = hex::encode(tag.as_ref());
-        tag_string
+    pub fn compute_hmac(&mut self, msg: &[u8]) -> hmac::Tag {
+        hmac::sign(&self.hmac_key, msg)
     }
 
-    pub fn verify_hmac(&mut self, msg: String, tag_string: String) -> bool {
-        let result = hmac::verify(
-            &self.hmac_key,
-            msg.as_bytes(),
-            hex::decode(tag_string).unwrap().as_ref(),
-        );
-        match result {
-            Ok(t) => return true,
-            Err(e) => return false,
-        }
+    pub fn verify_hmac(&mut self, msg: &[u8], tag: &[u8]) -> bool {
+        hmac::verify(&self.hmac_key, msg, tag).is_ok()
     }
 }
@@ -0,0 +1,197 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! A bounded cache of verified internal tree nodes, keyed by digest.
+//!
+//! The enclave keeps it in EPC, so it is bounded by the bytes its nodes take
+//! rather than by their number. Nodes are evicted in CLOCK order: the upper levels of the
+//! trees, which nearly every path goes through, keep being referenced and
+//! stay, while the nodes of paths replaced by updates age out.
+
+use super::proof::{Digest, NodeCache};
+use std::collections::HashMap;
+use std::mem;
+use std::vec::Vec;
+
+// What a node costs on top of its bytes: its slot and its index entry.
+const NODE_OVERHEAD: usize = 128;
+
+struct Slot {
+    digest: Digest,
+    node: Vec<u8>,
+    referenced: bool,
+}
+
+pub struct VerifiedNodeCache {
+    index: HashMap<Digest, usize>,
+    slots: Vec<Option<Slot>>,
+    vacant: Vec<usize>,
+    hand: usize,
+    bytes: usize,
+    budget: usize,
+    hits: u64,
+    misses: u64,
+}
+
+impl VerifiedNodeCache {
+    pub fn new(budget: usize) -> VerifiedNodeCache {
+        VerifiedNodeCache {
+            index: HashMap::new(),
+            slots: Vec::new(),
+            vacant: Vec::new(),
+            hand: 0,
+            bytes: 0,
+            budget,
+            hits: 0,
+            misses: 0,
+        }
+    }
+
+    /// Changes the bytes the cache may take, evicting nodes if needed.
+    pub fn set_budget(&mut self, budget: usize) {
+        self.budget = budget;
+        while self.bytes > self.budget {
+            self.evict();
+        }
+    }
+
+    pub fn bytes(&self) -> usize {
+        self.bytes
+    }
+
+    /// Lookups that found their node and lookups that did not.
+    pub fn stats(&self) -> (u64, u64) {
+        (self.hits, self.misses)
+    }
+
+    fn evict(&mut self) {
+        loop {
+            if self.hand >= self.slots.len() {
+                self.hand = 0;
+            }
+            let i = self.hand;
+            self.hand += 1;
+            let evict = match self.slots[i] {
+                Some(ref mut slot) => !mem::replace(&mut slot.referenced, false),
+                None => false,
+            };
+            if evict {
+                let slot = self.slots[i].take().unwrap();
+                self.index.remove(&slot.digest);
+                self.bytes -= slot.node.len() + NODE_OVERHEAD;
+                self.vacant.push(i);
+                return;
+            }
+        }
+    }
+}
+
+impl NodeCache for VerifiedNodeCache {
+    fn get(&mut self, digest: &Digest) -> Option<&[u8]> {
+        match self.index.get(digest) {
+            Some(&i) => {
+                self.hits += 1;
+                let slot = self.slots[i].as_mut().unwrap();
+                slot.referenced = true;
+                Some(&slot.node)
+            }
+            None => {
+                self.misses += 1;
+                None
+            }
+        }
+    }
+
+    fn insert(&mut self, digest: &Digest, node: &[u8]) {
+        let cost = node.len() + NODE_OVERHEAD;
+        if cost > self.budget || self.index.contains_key(digest) {
+            return;
+        }
+        while self.bytes + cost > self.budget {
+            self.evict();
+        }
+        let slot = Slot { digest: *digest, node: node.to_vec(), referenced: false };
+        let i = match self.vacant.pop() {
+            Some(i) => {
+                self.slots[i] = Some(slot);
+                i
+            }
+            None => {
+                self.slots.push(Some(slot));
+                self.slots.len() - 1
+            }
+        };
+        self.index.insert(*digest, i);
+        self.bytes += cost;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn digest(i: u8) -> Digest {
+        [i; 32]
+    }
+
+    #[test]
+    fn counts_hits_and_misses() {
+        let mut cache = VerifiedNodeCache::new(4096);
+        assert!(cache.get(&digest(1)).is_none());
+        cache.insert(&digest(1), b"one");
+        assert_eq!(cache.get(&digest(1)), Some(&b"one"[..]));
+        assert!(cache.get(&digest(2)).is_none());
+        assert_eq!(cache.stats(), (1, 2));
+        assert_eq!(cache.bytes(), 3 + NODE_OVERHEAD);
+
+        // A node is only ever cached once.
+        cache.insert(&digest(1), b"one");
+        assert_eq!(cache.bytes(), 3 + NODE_OVERHEAD);
+    }
+
+    #[test]
+    fn set_budget_evicts_unreferenced_nodes_first() {
+        let node = [0_u8; 64];
+        let cost = node.len() + NODE_OVERHEAD;
+        let mut cache = VerifiedNodeCache::new(4 * cost);
+        for i in 0..4 {
+            cache.insert(&digest(i), &node);
+        }
+        assert_eq!(cache.bytes(), 4 * cost);
+        cache.get(&digest(0));
+        cache.get(&digest(2));
+
+        cache.set_budget(2 * cost);
+        assert_eq!(cache.bytes(), 2 * cost);
+        assert!(cache.get(&digest(0)).is_some());
+        assert!(cache.get(&digest(1)).is_none());
+        assert!(cache.get(&digest(2)).is_some());
+        assert!(cache.get(&digest(3)).is_none());
+
+        // Inserting past the budget evicts, and a node that could never fit
+        // is not cached at all.
+        cache.insert(&digest(4), &node);
+        assert_eq!(cache.bytes(), 2 * cost);
+        assert!(cache.get(&digest(4)).is_some());
+        cache.insert(&digest(5), &[0_u8; 512]);
+        assert!(cache.get(&digest(5)).is_none());
+
+        cache.set_budget(0);
+        assert_eq!(cache.bytes(), 0);
+        assert!(cache.get(&digest(4)).is_none());
+    }
+}
@@ -1,132 +1,709 @@
-use merklebtree::merklebtree::{MerkleBTree, Nodes};
-use merklebtree::node::Node;
-use merklebtree::traits::CalculateHash;
-use ring::digest;
-use std::cmp::Ordering;
-use std::collections::HashMap;
-use std::fmt::Debug;
-
-#[derive(Clone, Debug)]
-pub struct search_result {
-    pub key: String,
-    pub version: i32,
-    pub existed: bool,
-}
+//! The Merkle B+-tree mapping keys to versions.
+//!
+//! Nodes live in one arena and refer to each other by index. An internal
+//! node keeps the digests of its children next to their indices, so
+//! rehashing a node after an update only reads that node. Updates only mark
+//! the nodes on their path as dirty, and the digests are brought up to date
+//! when the root or a proof is asked for, so that the nodes shared by a run
+//! of updates are hashed once.
+//!
+//! Every single-key operation returns the authentication path of its key as
+//! it was before the operation, which is all the enclave needs to check the
+//! result and to compute the new root itself. Nodes are split and removed
+//! exactly as `proof::VerifiedPath` does it, so both sides arrive at the
+//! same root.
+//!
+//! For a batch of operations the server sends one multiproof covering all
+//! their keys instead:
+//!
+//! ```text
+//! node:
+//!     0: u8, n: u16, (klen: u16, key, version: u64)*n
+//!     1: u8, n: u16, expanded: u32, (klen: u16, separator)*(n-1),
+//!        then for every child, a node if its bit is set in expanded,
+//!        its digest otherwise
+//! ```
+//!
+//! The enclave rebuilds the part of the tree the multiproof covers with
+//! [`MerkleBTree::from_multiproof_cached`], where the children left out are
+//! kept by digest only, and runs the batch on it with this same code. The
+//! internal nodes it finds in its `NodeCache` are compared with the cached
+//! ones instead of being hashed, and the nodes it hashes or computes are
+//! added to the cache.
+
+use super::proof::{self, Digest, NodeCache, ProofError, Sha256, MAX_CHILDREN, MAX_DEPTH, MAX_LEAF_ENTRIES};
+use std::boxed::Box;
+use std::marker::PhantomData;
+use std::vec::Vec;
 
-#[derive(Clone, Debug)]
-pub struct key_version {
-    pub key: String,
-    pub version: i32,
+struct Node {
+    leaf: bool,
+    // Only the digest of the node is known.
+    pruned: bool,
+    // Whether `digest`, and the digests of dirty children, are stale.
+    dirty: bool,
+    digest: Digest,
+    // Entry keys of a leaf, separators of an internal node.
+    keys: Vec<Box<[u8]>>,
+    versions: Vec<u64>,
+    children: Vec<u32>,
+    digests: Vec<Digest>,
 }
 
-impl PartialEq for key_version {
-    fn eq(&self, other: &Self) -> bool {
-        self.key == other.key
+impl Node {
+    fn empty_leaf() -> Node {
+        Node {
+            leaf: true,
+            pruned: false,
+            dirty: true,
+            digest: [0_u8; 32],
+            keys: Vec::new(),
+            versions: Vec::new(),
+            children: Vec::new(),
+            digests: Vec::new(),
+        }
     }
-}
-impl Eq for key_version {}
 
-impl Ord for key_version {
-    fn cmp(&self, other: &Self) -> Ordering {
-        (self.key).cmp(&(other.key))
+    fn internal() -> Node {
+        let mut node = Node::empty_leaf();
+        node.leaf = false;
+        node
     }
-}
 
-impl PartialOrd for key_version {
-    fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
-        Some(self.cmp(other))
+    fn pruned(digest: Digest) -> Node {
+        let mut node = Node::empty_leaf();
+        node.pruned = true;
+        node.dirty = false;
+        node.digest = digest;
+        node
     }
 }
-impl CalculateHash for key_version {
-    fn calculate(&self) -> String {
-        let mut s1 = String::new();
-        s1.push_str(self.key.as_str());
-        s1.push_str("-");
-        s1.push_str(self.version.to_string().as_str());
 
-        let hash = digest::digest(&digest::SHA256, s1.as_ref());
-        let hex = hex::encode(hash);
-        hex
+/// One operation of a batch.
+#[derive(Clone, Copy, Debug)]
+pub enum TreeOp<'a> {
+    Get(&'a [u8]),
+    Put(&'a [u8], u64),
+    Delete(&'a [u8]),
+}
+
+impl<'a> TreeOp<'a> {
+    pub fn key(&self) -> &'a [u8] {
+        match *self {
+            TreeOp::Get(key) | TreeOp::Put(key, _) | TreeOp::Delete(key) => key,
+        }
     }
 }
 
-pub struct Merklebtree {
-    pub mbtree: MerkleBTree,
-    pub nodes: Nodes<key_version>,
-    pub root_node: Node<key_version>,
+pub struct MerkleBTree<H> {
+    nodes: Vec<Node>,
+    free: Vec<u32>,
+    root: u32,
+    // Scratch space for hashing.
+    buf: Vec<u8>,
+    hasher: PhantomData<H>,
 }
 
-pub fn new_mbtree() -> Merklebtree {
-    let mut nodes = Nodes {
-        nodes_map: Default::default(),
-        size: 0,
-        root_id: 0,
-        content_size: 0,
-        next_id: 0,
-        m: 0,
-    };
+impl<H: Sha256> Default for MerkleBTree<H> {
+    fn default() -> MerkleBTree<H> {
+        MerkleBTree::new()
+    }
+}
 
-    let mut tree = MerkleBTree::new_empty(5, &mut nodes);
+impl<H: Sha256> MerkleBTree<H> {
+    pub fn new() -> MerkleBTree<H> {
+        MerkleBTree {
+            nodes: vec![Node::empty_leaf()],
+            free: Vec::new(),
+            root: 0,
+            buf: Vec::new(),
+            hasher: PhantomData,
+        }
+    }
 
-    nodes.m = tree.m;
+    pub fn root(&mut self) -> Digest {
+        let root = self.root;
+        self.rehash(root, &mut ())
+    }
 
-    Merklebtree {
-        mbtree: tree,
-        nodes,
-        root_node: Node::new_empty(0),
+    /// Returns the version of `key`, if any, and its path.
+    ///
+    /// This and the other operations returning a path panic if the tree was
+    /// built from a multiproof that does not cover `key`.
+    pub fn get(&mut self, key: &[u8]) -> (Option<u64>, Vec<u8>) {
+        let proof = self.prove(key);
+        (self.lookup(key).unwrap(), proof)
     }
-}
 
-impl Merklebtree {
-    pub fn search(&mut self, key: String) -> (search_result, Nodes<key_version>) {
-        let (value, found, subnodes) = self.mbtree.get_clone(
-            key_version {
-                key: key.clone(),
-                version: 0,
-            },
-            &mut self.nodes,
-        );
-        if found {
-            return (
-                search_result {
-                    existed: true,
-                    key: key,
-                    version: value.version,
-                },
-                subnodes,
-            );
+    /// Sets the version of `key`, inserting it if needed. Returns the path
+    /// of `key` before the update.
+    pub fn put(&mut self, key: &[u8], version: u64) -> Vec<u8> {
+        let proof = self.prove(key);
+        self.set(key, version).unwrap();
+        proof
+    }
+
+    /// Removes `key`. Returns the path of `key` before the removal.
+    pub fn delete(&mut self, key: &[u8]) -> Vec<u8> {
+        let proof = self.prove(key);
+        self.remove(key).unwrap();
+        proof
+    }
+
+    /// Returns the path of `key`.
+    pub fn prove(&mut self, key: &[u8]) -> Vec<u8> {
+        self.root();
+        let (path, leaf) = self.descend(key).unwrap();
+        let mut out = Vec::new();
+        proof::write_header(&mut out, path.len());
+        for &(id, taken) in path.iter() {
+            let node = &self.nodes[id as usize];
+            proof::write_internal(&mut out, &node.keys, &node.digests, taken);
+        }
+        let node = &self.nodes[leaf as usize];
+        proof::write_leaf(&mut out, &node.keys, &node.versions);
+        out
+    }
+
+    /// Returns the version of `key`, if any.
+    pub fn lookup(&self, key: &[u8]) -> Result<Option<u64>, ProofError> {
+        let (_, leaf) = self.descend(key)?;
+        let node = &self.nodes[leaf as usize];
+        Ok(match node.keys.binary_search_by(|k| (**k).cmp(key)) {
+            Ok(i) => Some(node.versions[i]),
+            Err(_) => None,
+        })
+    }
+
+    /// Sets the version of `key`, inserting it if needed.
+    pub fn set(&mut self, key: &[u8], version: u64) -> Result<(), ProofError> {
+        let (path, leaf) = self.descend(key)?;
+        for &(id, _) in path.iter() {
+            self.nodes[id as usize].dirty = true;
+        }
+
+        let node = &mut self.nodes[leaf as usize];
+        node.dirty = true;
+        match node.keys.binary_search_by(|k| (**k).cmp(key)) {
+            Ok(i) => node.versions[i] = version,
+            Err(i) => {
+                node.keys.insert(i, key.into());
+                node.versions.insert(i, version);
+            }
+        }
+        let mut split = if node.keys.len() > MAX_LEAF_ENTRIES {
+            let mid = node.keys.len() / 2;
+            let mut right = Node::empty_leaf();
+            right.keys = node.keys.split_off(mid);
+            right.versions = node.versions.split_off(mid);
+            let sep = right.keys[0].clone();
+            Some((sep, self.alloc(right)))
         } else {
-            return (
-                search_result {
-                    existed: false,
-                    key: key,
-                    version: -1,
-                },
-                subnodes,
-            );
-        }
-    }
-
-    pub fn delete(&mut self, key: String) -> Nodes<key_version> {
-        let subnodes = self.mbtree.remove_clone(
-            key_version {
-                key: key,
-                version: 0,
-            },
-            &mut self.nodes,
-        );
-        subnodes
-    }
-
-    pub fn build_with_key_value(&mut self, kv: key_version) -> Nodes<key_version> {
-        println!("kv:{:?}", kv);
-        let subnodes = self.mbtree.put_clone(
-            key_version {
-                key: kv.key,
-                version: kv.version,
-            },
-            &mut self.nodes,
-        );
-        subnodes
+            None
+        };
+
+        for &(id, taken) in path.iter().rev() {
+            let (sep, right) = match split.take() {
+                Some(split) => split,
+                None => break,
+            };
+            // The digest of the new child is filled in by `rehash`.
+            let node = &mut self.nodes[id as usize];
+            node.children.insert(taken + 1, right);
+            node.digests.insert(taken + 1, [0_u8; 32]);
+            node.keys.insert(taken, sep);
+            if node.children.len() > MAX_CHILDREN {
+                let mid = node.children.len() / 2;
+                let mut right = Node::internal();
+                right.keys = node.keys.split_off(mid);
+                right.children = node.children.split_off(mid);
+                right.digests = node.digests.split_off(mid);
+                let sep = node.keys.pop().unwrap();
+                split = Some((sep, self.alloc(right)));
+            }
+        }
+
+        if let Some((sep, right)) = split {
+            let mut root = Node::internal();
+            root.keys = vec![sep];
+            root.children = vec![self.root, right];
+            root.digests = vec![[0_u8; 32]; 2];
+            self.root = self.alloc(root);
+        }
+        Ok(())
+    }
+
+    /// Removes `key`, if the tree has it.
+    pub fn remove(&mut self, key: &[u8]) -> Result<(), ProofError> {
+        let (path, leaf) = self.descend(key)?;
+        let node = &mut self.nodes[leaf as usize];
+        let i = match node.keys.binary_search_by(|k| (**k).cmp(key)) {
+            Ok(i) => i,
+            Err(_) => return Ok(()),
+        };
+        node.dirty = true;
+        node.keys.remove(i);
+        node.versions.remove(i);
+        let mut removed = node.keys.is_empty() && !path.is_empty();
+        if removed {
+            self.release(leaf);
+        }
+
+        for (d, &(id, taken)) in path.iter().enumerate().rev() {
+            let node = &mut self.nodes[id as usize];
+            node.dirty = true;
+            if !removed {
+                continue;
+            }
+            node.children.remove(taken);
+            node.digests.remove(taken);
+            if !node.keys.is_empty() {
+                node.keys.remove(taken.saturating_sub(1));
+            }
+            removed = node.children.is_empty() && d > 0;
+            if removed {
+                self.release(id);
+                continue;
+            }
+            match node.children.len() {
+                0 => *node = Node::empty_leaf(),
+                // A root with a single child gives way to it.
+                1 if d == 0 => {
+                    self.root = node.children[0];
+                    self.release(id);
+                }
+                _ => (),
+            }
+        }
+        Ok(())
+    }
+
+    /// Runs `ops` in order and returns the version each key had before its
+    /// operation.
+    pub fn apply(&mut self, ops: &[TreeOp]) -> Result<Vec<Option<u64>>, ProofError> {
+        let mut before = Vec::with_capacity(ops.len());
+        for op in ops.iter() {
+            before.push(self.lookup(op.key())?);
+            match *op {
+                TreeOp::Get(_) => (),
+                TreeOp::Put(key, version) => self.set(key, version)?,
+                TreeOp::Delete(key) => self.remove(key)?,
+            }
+        }
+        Ok(before)
+    }
+
+    /// Like [`apply`](MerkleBTree::apply), then brings the digests up to
+    /// date, adding the internal nodes it hashes to `cache`.
+    pub fn apply_cached<C: NodeCache>(&mut self, ops: &[TreeOp], cache: &mut C) -> Result<Vec<Option<u64>>, ProofError> {
+        let before = self.apply(ops)?;
+        let root = self.root;
+        self.rehash(root, cache);
+        Ok(before)
+    }
+
+    /// Returns a multiproof covering the paths of all `keys`.
+    pub fn multiproof(&mut self, keys: &[&[u8]]) -> Vec<u8> {
+        self.root();
+        let mut keys = keys.to_vec();
+        keys.sort();
+        keys.dedup();
+        let mut out = Vec::new();
+        self.write_node(&mut out, self.root, &keys);
+        out
+    }
+
+    /// Rebuilds the part of a tree with root digest `root` that `proof`
+    /// covers, and checks that it hashes to `root`.
+    pub fn from_multiproof(root: &Digest, proof: &[u8]) -> Result<MerkleBTree<H>, ProofError> {
+        MerkleBTree::from_multiproof_cached::<()>(root, proof, &mut ())
+    }
+
+    /// Like [`from_multiproof`](MerkleBTree::from_multiproof), but only
+    /// compares the internal nodes found in `cache` with the proof, and adds
+    /// those it hashes to it once the proof checks out.
+    pub fn from_multiproof_cached<C: NodeCache>(root: &Digest, proof: &[u8], cache: &mut C) -> Result<MerkleBTree<H>, ProofError> {
+        let mut tree = MerkleBTree {
+            nodes: Vec::new(),
+            free: Vec::new(),
+            root: 0,
+            buf: Vec::new(),
+            hasher: PhantomData,
+        };
+        let mut r = proof::Reader { buf: proof };
+        let mut hashed = Vec::new();
+        let id = tree.read_node(&mut r, 0, Some(*root), cache, &mut hashed)?;
+        if !r.buf.is_empty() {
+            return Err(ProofError::Malformed);
+        }
+        if tree.nodes[id as usize].digest != *root {
+            return Err(ProofError::RootMismatch);
+        }
+        for &node in hashed.iter() {
+            let node = &tree.nodes[node as usize];
+            proof::encode_internal(&mut tree.buf, &node.keys, &node.digests);
+            cache.insert(&node.digest, &tree.buf);
+        }
+        tree.root = id;
+        Ok(tree)
+    }
+
+    // Returns the internal nodes from the root to the leaf of `key`, each
+    // with the child taken, and the leaf.
+    fn descend(&self, key: &[u8]) -> Result<(Vec<(u32, usize)>, u32), ProofError> {
+        let mut path = Vec::new();
+        let mut id = self.root;
+        loop {
+            let node = &self.nodes[id as usize];
+            if node.pruned {
+                return Err(ProofError::Incomplete);
+            }
+            if node.leaf {
+                return Ok((path, id));
+            }
+            let taken = proof::route(&node.keys, key);
+            path.push((id, taken));
+            id = node.children[taken];
+        }
+    }
+
+    // Brings the digests below `id` up to date, adding the internal nodes
+    // it hashes to `cache`.
+    fn rehash<C: NodeCache>(&mut self, id: u32, cache: &mut C) -> Digest {
+        if !self.nodes[id as usize].dirty {
+            return self.nodes[id as usize].digest;
+        }
+        for i in 0..self.nodes[id as usize].children.len() {
+            let child = self.nodes[id as usize].children[i];
+            if self.nodes[child as usize].dirty {
+                let digest = self.rehash(child, cache);
+                self.nodes[id as usize].digests[i] = digest;
+            }
+        }
+        let node = &mut self.nodes[id as usize];
+        node.digest = if node.leaf {
+            proof::hash_leaf::<H, _>(&mut self.buf, &node.keys, &node.versions)
+        } else {
+            let digest = proof::hash_internal::<H, _>(&mut self.buf, &node.keys, &node.digests);
+            cache.insert(&digest, &self.buf);
+            digest
+        };
+        node.dirty = false;
+        node.digest
+    }
+
+    // `keys` are sorted and all route to `id`.
+    fn write_node(&self, out: &mut Vec<u8>, id: u32, keys: &[&[u8]]) {
+        let node = &self.nodes[id as usize];
+        if node.leaf {
+            out.push(proof::LEAF_TAG);
+            proof::write_leaf(out, &node.keys, &node.versions);
+            return;
+        }
+
+        // The keys routing to each child are a run of `keys`.
+        let mut runs = Vec::with_capacity(node.children.len());
+        let mut start = 0;
+        let mut expanded = 0_u32;
+        for i in 0..node.children.len() {
+            let end = match node.keys.get(i) {
+                Some(sep) => start + keys[start..].iter().take_while(|k| ***k < **sep).count(),
+                None => keys.len(),
+            };
+            if end > start && !self.nodes[node.children[i] as usize].pruned {
+                expanded |= 1 << i;
+            }
+            runs.push((start, end));
+            start = end;
+        }
+
+        out.push(proof::INTERNAL_TAG);
+        proof::put_u16(out, node.children.len());
+        out.extend_from_slice(&expanded.to_le_bytes());
+        for sep in node.keys.iter() {
+            proof::put_key(out, sep);
+        }
+        for (i, &(start, end)) in runs.iter().enumerate() {
+            if expanded & (1 << i) != 0 {
+                self.write_node(out, node.children[i], &keys[start..end]);
+            } else {
+                out.extend_from_slice(&node.digests[i]);
+            }
+        }
+    }
+
+    // Reads a node whose digest is `expected`, if the parent is known to be
+    // trusted already, checking it as early as possible. Internal nodes that
+    // had to be hashed are added to `hashed`.
+    fn read_node<C: NodeCache>(
+        &mut self,
+        r: &mut proof::Reader,
+        depth: usize,
+        expected: Option<Digest>,
+        cache: &mut C,
+        hashed: &mut Vec<u32>,
+    ) -> Result<u32, ProofError> {
+        let mut node = Node::empty_leaf();
+        node.dirty = false;
+        let mut hash = false;
+        match r.bytes(1)?[0] {
+            proof::LEAF_TAG => {
+                let n = r.u16()?;
+                if n > MAX_LEAF_ENTRIES {
+                    return Err(ProofError::Malformed);
+                }
+                for _ in 0..n {
+                    let key = r.key()?;
+                    if node.keys.last().map_or(false, |last| **last >= *key) {
+                        return Err(ProofError::Malformed);
+                    }
+                    node.keys.push(key.into());
+                    node.versions.push(r.u64()?);
+                }
+                node.digest = proof::hash_leaf::<H, _>(&mut self.buf, &node.keys, &node.versions);
+            }
+            proof::INTERNAL_TAG if depth < MAX_DEPTH => {
+                node.leaf = false;
+                let n = r.u16()?;
+                let b = r.bytes(4)?;
+                let expanded = u32::from_le_bytes([b[0], b[1], b[2], b[3]]);
+                if n == 0 || n > MAX_CHILDREN || (n < 32 && expanded >> n != 0) {
+                    return Err(ProofError::Malformed);
+                }
+                for _ in 0..n - 1 {
+                    let sep = r.key()?;
+                    if node.keys.last().map_or(false, |last| **last >= *sep) {
+                        return Err(ProofError::Malformed);
+                    }
+                    node.keys.push(sep.into());
+                }
+                // A cached node gives the digests of its children, so they
+                // are known to be trusted as soon as they match.
+                let cached = match expected {
+                    Some(ref digest) => cache.get(digest).map(|node| node.to_vec()),
+                    None => None,
+                };
+                for i in 0..n {
+                    let child = if expanded & (1 << i) != 0 {
+                        let expected = cached.as_ref().and_then(|node| proof::encoded_child(node, i));
+                        self.read_node(r, depth + 1, expected, cache, hashed)?
+                    } else {
+                        let digest = r.digest()?;
+                        self.alloc(Node::pruned(digest))
+                    };
+                    node.children.push(child);
+                    node.digests.push(self.nodes[child as usize].digest);
+                }
+                match cached {
+                    Some(cached) => {
+                        proof::encode_internal(&mut self.buf, &node.keys, &node.digests);
+                        if self.buf != cached {
+                            return Err(ProofError::RootMismatch);
+                        }
+                        node.digest = expected.unwrap();
+                    }
+                    None => {
+                        node.digest = proof::hash_internal::<H, _>(&mut self.buf, &node.keys, &node.digests);
+                        hash = true;
+                    }
+                }
+            }
+            _ => return Err(ProofError::Malformed),
+        }
+        if expected.map_or(false, |digest| digest != node.digest) {
+            return Err(ProofError::RootMismatch);
+        }
+        let id = self.alloc(node);
+        if hash {
+            hashed.push(id);
+        }
+        Ok(id)
+    }
+
+    fn alloc(&mut self, node: Node) -> u32 {
+        match self.free.pop() {
+            Some(id) => {
+                self.nodes[id as usize] = node;
+                id
+            }
+            None => {
+                self.nodes.push(node);
+                (self.nodes.len() - 1) as u32
+            }
+        }
+    }
+
+    fn release(&mut self, id: u32) {
+        self.nodes[id as usize] = Node::empty_leaf();
+        self.free.push(id);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use super::super::cache::VerifiedNodeCache;
+    use super::super::RingSha256;
+    use std::collections::BTreeMap;
+
+    // xorshift64, so that a failure can be replayed.
+    struct Rng(u64);
+
+    impl Rng {
+        fn below(&mut self, n: u64) -> u64 {
+            self.0 ^= self.0 << 13;
+            self.0 ^= self.0 >> 7;
+            self.0 ^= self.0 << 17;
+            self.0 % n
+        }
+    }
+
+    fn key(i: u64) -> Vec<u8> {
+        format!("key{:06}", i).into_bytes()
+    }
+
+    // Checks `proof` against `root`, as the enclave does, and returns the
+    // path.
+    fn verify<'a>(root: &Digest, key: &'a [u8], proof: &'a [u8]) -> proof::VerifiedPath<'a> {
+        proof::verify::<RingSha256>(root, key, proof).unwrap()
+    }
+
+    #[test]
+    fn paths_compute_the_root_of_the_tree() {
+        let mut rng = Rng(0x9e37_79b9_7f4a_7c15);
+        let mut tree = MerkleBTree::<RingSha256>::new();
+        let mut model = BTreeMap::new();
+        let mut root = tree.root();
+        assert_eq!(root, proof::empty_root::<RingSha256>());
+
+        for step in 0..6000 {
+            let key = key(rng.below(3000));
+            match rng.below(4) {
+                0 => {
+                    let (version, proof) = tree.get(&key);
+                    assert_eq!(version, model.get(&key).cloned());
+                    assert_eq!(verify(&root, &key, &proof).version(), version);
+                }
+                1 => {
+                    let proof = tree.delete(&key);
+                    root = verify(&root, &key, &proof).delete::<RingSha256>();
+                    model.remove(&key);
+                }
+                _ => {
+                    let proof = tree.put(&key, step);
+                    root = verify(&root, &key, &proof).put::<RingSha256>(step);
+                    model.insert(key, step);
+                }
+            }
+            assert_eq!(tree.root(), root, "step {}", step);
+        }
+        // The depth of the tree, which splits have to have reached twice.
+        assert!(tree.prove(b"")[0] >= 2);
+
+        // Emptying the tree collapses it back to a leaf.
+        let keys: Vec<Vec<u8>> = model.keys().cloned().collect();
+        for key in keys.iter() {
+            let proof = tree.delete(key);
+            root = verify(&root, key, &proof).delete::<RingSha256>();
+            assert_eq!(tree.root(), root);
+        }
+        assert_eq!(root, proof::empty_root::<RingSha256>());
+    }
+
+    // A tree of 3000 even keys, and a batch touching a few of them and a few
+    // keys it lacks.
+    fn tree_and_batch() -> (MerkleBTree<RingSha256>, Vec<Vec<u8>>) {
+        let mut tree = MerkleBTree::<RingSha256>::new();
+        for i in 0..3000 {
+            tree.set(&key(2 * i), i).unwrap();
+        }
+        let keys = [10, 11, 1500, 4001, 5998].iter().map(|&i| key(i)).collect();
+        (tree, keys)
+    }
+
+    fn batch<'a>(keys: &'a [Vec<u8>]) -> Vec<TreeOp<'a>> {
+        keys.iter()
+            .enumerate()
+            .map(|(i, key)| match i % 3 {
+                0 => TreeOp::Get(&key[..]),
+                1 => TreeOp::Put(&key[..], 7000 + i as u64),
+                _ => TreeOp::Delete(&key[..]),
+            })
+            .collect()
+    }
+
+    fn multiproof(tree: &mut MerkleBTree<RingSha256>, keys: &[Vec<u8>]) -> Vec<u8> {
+        let keys: Vec<&[u8]> = keys.iter().map(|key| &key[..]).collect();
+        tree.multiproof(&keys)
+    }
+
+    #[test]
+    fn multiproofs_use_the_cache() {
+        let (mut tree, keys) = tree_and_batch();
+        let root = tree.root();
+        let proof = multiproof(&mut tree, &keys);
+        let ops = batch(&keys);
+        let mut cache = VerifiedNodeCache::new(1 << 20);
+
+        // A cold cache misses on the root and is filled once the proof
+        // checks out.
+        let mut partial = MerkleBTree::<RingSha256>::from_multiproof_cached(&root, &proof, &mut cache).unwrap();
+        assert_eq!(cache.stats(), (0, 1));
+        assert!(cache.bytes() > 0);
+        assert_eq!(partial.root(), root);
+
+        // A warm one only compares the internal nodes.
+        let mut partial = MerkleBTree::<RingSha256>::from_multiproof_cached(&root, &proof, &mut cache).unwrap();
+        let (hits, misses) = cache.stats();
+        assert!(hits >= 2);
+        assert_eq!(misses, 1);
+
+        // The nodes the batch computes are cached too, and give the same
+        // root as the whole tree and the uncached path do.
+        let before = partial.apply_cached(&ops, &mut cache).unwrap();
+        assert_eq!(before, tree.apply(&ops).unwrap());
+        let root = tree.root();
+        assert_eq!(partial.root(), root);
+        let mut uncached = MerkleBTree::<RingSha256>::from_multiproof(&root, &multiproof(&mut tree, &keys)).unwrap();
+        assert_eq!(uncached.root(), root);
+        assert!(cache.get(&root).is_some());
+    }
+
+    #[test]
+    fn multiproofs_survive_eviction() {
+        let (mut tree, keys) = tree_and_batch();
+        let root = tree.root();
+        let proof = multiproof(&mut tree, &keys);
+        let mut cache = VerifiedNodeCache::new(1 << 20);
+        MerkleBTree::<RingSha256>::from_multiproof_cached(&root, &proof, &mut cache).unwrap();
+        let full = cache.bytes();
+
+        // Room for part of the nodes only, then for none.
+        for &budget in [full / 2, 0].iter() {
+            cache.set_budget(budget);
+            assert!(cache.bytes() <= budget);
+            let mut partial = MerkleBTree::<RingSha256>::from_multiproof_cached(&root, &proof, &mut cache).unwrap();
+            assert!(cache.bytes() <= budget);
+            assert_eq!(partial.root(), root);
+        }
+    }
+
+    #[test]
+    fn tampered_multiproofs_are_rejected() {
+        let (mut tree, keys) = tree_and_batch();
+        let root = tree.root();
+        let proof = multiproof(&mut tree, &keys);
+        let mut cache = VerifiedNodeCache::new(1 << 20);
+        assert!(MerkleBTree::<RingSha256>::from_multiproof_cached(&root, &proof, &mut cache).is_ok());
+
+        // Every byte counts, whether its node is cached or not.
+        let mut tampered = proof.clone();
+        for i in 0..proof.len() {
+            tampered[i] ^= 1;
+            assert!(MerkleBTree::<RingSha256>::from_multiproof(&root, &tampered).is_err(), "byte {}", i);
+            assert!(MerkleBTree::<RingSha256>::from_multiproof_cached(&root, &tampered, &mut cache).is_err(), "byte {}", i);
+            tampered[i] ^= 1;
+        }
+        assert!(MerkleBTree::<RingSha256>::from_multiproof_cached(&root, &tampered, &mut cache).is_ok());
     }
 }
@@ -1 +1,17 @@
+// Only the enclave keeps verified nodes.
+#[allow(dead_code)]
+pub mod cache;
 pub mod mbtree;
+pub mod proof;
+
+use ring::digest;
+
+pub struct RingSha256;
+
+impl proof::Sha256 for RingSha256 {
+    fn sha256(data: &[u8]) -> proof::Digest {
+        let mut out = [0_u8; 32];
+        out.copy_from_slice(digest::digest(&digest::SHA256, data).as_ref());
+        out
+    }
+}
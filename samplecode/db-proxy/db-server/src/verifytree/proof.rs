@@ -0,0 +1,596 @@
+//! Authentication paths of the Merkle B+-tree and their verification.
+//!
+//! This file is shared by the server, which builds the paths, and the
+//! enclave, which checks them against the root digest it keeps, so it only
+//! uses what `sgx_tstd` provides as well.
+//!
+//! A leaf hashes as `0 || n || (klen || key || version)*n` and an internal
+//! node as `1 || n || digest*n || (klen || separator)*(n-1)`, with `n` and
+//! `klen` as little-endian u16 and versions as little-endian u64. Child `i`
+//! of an internal node holds the keys from separator `i-1` up to, but not
+//! including, separator `i`.
+//!
+//! A proof is the path from the root to the leaf a key routes to:
+//!
+//! ```text
+//! depth: u8
+//! depth times, root first:
+//!     n: u16, taken: u16, (klen: u16, separator)*(n-1), digest*(n-1)
+//! leaf:
+//!     n: u16, (klen: u16, key, version: u64)*n
+//! ```
+//!
+//! where the digests are those of every child but the one taken, which the
+//! verifier computes itself. A verified path is enough to apply a put or a
+//! delete and compute the new root, as the tree changes along the path
+//! only: full nodes are split in two, nodes that become empty are removed
+//! from their parent and a root left with a single child is replaced by it.
+//! Nodes that merely become small are not merged with their siblings.
+//!
+//! Since a node is trusted as soon as it is known to hash to a trusted
+//! digest, the enclave may remember internal nodes it has verified or
+//! computed in a [`NodeCache`]. A level whose digest is cached is then
+//! compared with the cached node instead of being hashed, so a path that
+//! shares its upper levels with recent requests only costs the hashing of
+//! the part below them. Multiproofs use the cache the same way.
+
+use std::vec::Vec;
+
+pub type Digest = [u8; 32];
+
+/// Entries a leaf holds before it is split.
+pub const MAX_LEAF_ENTRIES: usize = 32;
+/// Children an internal node holds before it is split.
+pub const MAX_CHILDREN: usize = 32;
+pub const MAX_KEY_LEN: usize = 0xffff;
+/// Levels of internal nodes a proof may have.
+pub const MAX_DEPTH: usize = 32;
+
+pub(crate) const LEAF_TAG: u8 = 0;
+pub(crate) const INTERNAL_TAG: u8 = 1;
+
+/// The SHA-256 implementation of the side using the proofs.
+pub trait Sha256 {
+    fn sha256(data: &[u8]) -> Digest;
+}
+
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum ProofError {
+    /// The proof cannot be parsed or breaks the ordering of the tree.
+    Malformed,
+    /// The path does not lead to the leaf of the key.
+    WrongPath,
+    /// The path does not hash to the trusted root.
+    RootMismatch,
+    /// The key is longer than `MAX_KEY_LEN`.
+    KeyTooLong,
+    /// A multiproof leaves out the node the key routes to.
+    Incomplete,
+}
+
+/// Internal nodes known to hash to their digest, kept as the bytes they
+/// hash from.
+pub trait NodeCache {
+    fn get(&mut self, digest: &Digest) -> Option<&[u8]>;
+    fn insert(&mut self, digest: &Digest, node: &[u8]);
+}
+
+/// No cache at all.
+impl NodeCache for () {
+    fn get(&mut self, _digest: &Digest) -> Option<&[u8]> {
+        None
+    }
+
+    fn insert(&mut self, _digest: &Digest, _node: &[u8]) {}
+}
+
+/// Digest of the empty tree, a leaf without entries.
+pub fn empty_root<H: Sha256>() -> Digest {
+    let mut buf = Vec::new();
+    hash_leaf::<H, &[u8]>(&mut buf, &[], &[])
+}
+
+/// Hashes a leaf, using `buf` as scratch space.
+pub fn hash_leaf<H: Sha256, K: AsRef<[u8]>>(buf: &mut Vec<u8>, keys: &[K], versions: &[u64]) -> Digest {
+    buf.clear();
+    buf.push(LEAF_TAG);
+    put_u16(buf, keys.len());
+    for (key, version) in keys.iter().zip(versions.iter()) {
+        put_key(buf, key.as_ref());
+        buf.extend_from_slice(&version.to_le_bytes());
+    }
+    H::sha256(buf)
+}
+
+/// Hashes an internal node, using `buf` as scratch space.
+pub fn hash_internal<H: Sha256, K: AsRef<[u8]>>(buf: &mut Vec<u8>, seps: &[K], digests: &[Digest]) -> Digest {
+    encode_internal(buf, seps, digests);
+    H::sha256(buf)
+}
+
+// Hashes an internal node computed by the caller and remembers it.
+fn hash_computed<H: Sha256, C: NodeCache>(buf: &mut Vec<u8>, seps: &[&[u8]], digests: &[Digest], cache: &mut C) -> Digest {
+    let digest = hash_internal::<H, _>(buf, seps, digests);
+    cache.insert(&digest, buf);
+    digest
+}
+
+pub(crate) fn encode_internal<K: AsRef<[u8]>>(buf: &mut Vec<u8>, seps: &[K], digests: &[Digest]) {
+    buf.clear();
+    buf.push(INTERNAL_TAG);
+    put_u16(buf, digests.len());
+    for digest in digests.iter() {
+        buf.extend_from_slice(digest);
+    }
+    for sep in seps.iter() {
+        put_key(buf, sep.as_ref());
+    }
+}
+
+// The digest of child `i` in an encoded internal node.
+pub(crate) fn encoded_child(node: &[u8], i: usize) -> Option<Digest> {
+    let start = 3 + 32 * i;
+    if node.len() < start + 32 {
+        return None;
+    }
+    let mut d = [0_u8; 32];
+    d.copy_from_slice(&node[start..start + 32]);
+    Some(d)
+}
+
+/// Index of the child of an internal node that `key` routes to.
+pub fn route<K: AsRef<[u8]>>(seps: &[K], key: &[u8]) -> usize {
+    match seps.binary_search_by(|sep| sep.as_ref().cmp(key)) {
+        Ok(i) => i + 1,
+        Err(i) => i,
+    }
+}
+
+/// Starts a proof with `depth` internal levels.
+pub fn write_header(out: &mut Vec<u8>, depth: usize) {
+    out.push(depth as u8);
+}
+
+/// Appends an internal level, taking child `taken`.
+pub fn write_internal<K: AsRef<[u8]>>(out: &mut Vec<u8>, seps: &[K], digests: &[Digest], taken: usize) {
+    put_u16(out, digests.len());
+    put_u16(out, taken);
+    for sep in seps.iter() {
+        put_key(out, sep.as_ref());
+    }
+    for (i, digest) in digests.iter().enumerate() {
+        if i != taken {
+            out.extend_from_slice(digest);
+        }
+    }
+}
+
+/// Appends the leaf that ends the path.
+pub fn write_leaf<K: AsRef<[u8]>>(out: &mut Vec<u8>, keys: &[K], versions: &[u64]) {
+    put_u16(out, keys.len());
+    for (key, version) in keys.iter().zip(versions.iter()) {
+        put_key(out, key.as_ref());
+        out.extend_from_slice(&version.to_le_bytes());
+    }
+}
+
+pub(crate) fn put_u16(out: &mut Vec<u8>, v: usize) {
+    out.extend_from_slice(&(v as u16).to_le_bytes());
+}
+
+pub(crate) fn put_key(out: &mut Vec<u8>, key: &[u8]) {
+    put_u16(out, key.len());
+    out.extend_from_slice(key);
+}
+
+pub(crate) struct Reader<'a> {
+    pub(crate) buf: &'a [u8],
+}
+
+impl<'a> Reader<'a> {
+    pub(crate) fn bytes(&mut self, n: usize) -> Result<&'a [u8], ProofError> {
+        if self.buf.len() < n {
+            return Err(ProofError::Malformed);
+        }
+        let (head, tail) = self.buf.split_at(n);
+        self.buf = tail;
+        Ok(head)
+    }
+
+    pub(crate) fn u16(&mut self) -> Result<usize, ProofError> {
+        let b = self.bytes(2)?;
+        Ok(u16::from_le_bytes([b[0], b[1]]) as usize)
+    }
+
+    pub(crate) fn u64(&mut self) -> Result<u64, ProofError> {
+        let mut v = [0_u8; 8];
+        v.copy_from_slice(self.bytes(8)?);
+        Ok(u64::from_le_bytes(v))
+    }
+
+    pub(crate) fn key(&mut self) -> Result<&'a [u8], ProofError> {
+        let len = self.u16()?;
+        self.bytes(len)
+    }
+
+    pub(crate) fn digest(&mut self) -> Result<Digest, ProofError> {
+        let mut d = [0_u8; 32];
+        d.copy_from_slice(self.bytes(32)?);
+        Ok(d)
+    }
+}
+
+struct Level<'a> {
+    seps: Vec<&'a [u8]>,
+    // The digest at `taken` is filled in from below.
+    digests: Vec<Digest>,
+    taken: usize,
+}
+
+/// A path that has been checked against a root. Keys and separators borrow
+/// from the proof.
+pub struct VerifiedPath<'a> {
+    key: &'a [u8],
+    levels: Vec<Level<'a>>,
+    keys: Vec<&'a [u8]>,
+    versions: Vec<u64>,
+    // Position of the key in the leaf, or where it would go.
+    pos: Result<usize, usize>,
+    root: Digest,
+}
+
+fn strictly_sorted(keys: &[&[u8]]) -> bool {
+    keys.windows(2).all(|w| w[0] < w[1])
+}
+
+/// Parses `proof` as the path of `key` and checks that it routes `key`
+/// correctly and hashes to `root`.
+pub fn verify<'a, H: Sha256>(root: &Digest, key: &'a [u8], proof: &'a [u8]) -> Result<VerifiedPath<'a>, ProofError> {
+    verify_cached::<H, ()>(root, key, proof, &mut ())
+}
+
+/// Like [`verify`], but only hashes the levels below those found in
+/// `cache`, and adds the levels it hashes to it.
+pub fn verify_cached<'a, H: Sha256, C: NodeCache>(
+    root: &Digest,
+    key: &'a [u8],
+    proof: &'a [u8],
+    cache: &mut C,
+) -> Result<VerifiedPath<'a>, ProofError> {
+    if key.len() > MAX_KEY_LEN {
+        return Err(ProofError::KeyTooLong);
+    }
+    let mut r = Reader { buf: proof };
+    let depth = r.bytes(1)?[0] as usize;
+    if depth > MAX_DEPTH {
+        return Err(ProofError::Malformed);
+    }
+
+    let mut levels = Vec::with_capacity(depth);
+    for _ in 0..depth {
+        let n = r.u16()?;
+        let taken = r.u16()?;
+        if n == 0 || n > MAX_CHILDREN || taken >= n {
+            return Err(ProofError::Malformed);
+        }
+        let mut seps = Vec::with_capacity(n - 1);
+        for _ in 0..n - 1 {
+            seps.push(r.key()?);
+        }
+        if !strictly_sorted(&seps) {
+            return Err(ProofError::Malformed);
+        }
+        if route(&seps, key) != taken {
+            return Err(ProofError::WrongPath);
+        }
+        let mut digests = Vec::with_capacity(n);
+        for i in 0..n {
+            digests.push(if i == taken { [0_u8; 32] } else { r.digest()? });
+        }
+        levels.push(Level { seps, digests, taken });
+    }
+
+    let n = r.u16()?;
+    if n > MAX_LEAF_ENTRIES {
+        return Err(ProofError::Malformed);
+    }
+    let mut keys = Vec::with_capacity(n + 1);
+    let mut versions = Vec::with_capacity(n + 1);
+    for _ in 0..n {
+        keys.push(r.key()?);
+        versions.push(r.u64()?);
+    }
+    if !r.buf.is_empty() || !strictly_sorted(&keys) {
+        return Err(ProofError::Malformed);
+    }
+
+    let mut buf = Vec::new();
+    let mut expected = *root;
+    let mut known = 0;
+    while known < levels.len() {
+        let level = &mut levels[known];
+        let node = match cache.get(&expected) {
+            Some(node) => node,
+            None => break,
+        };
+        let child = encoded_child(node, level.taken).ok_or(ProofError::RootMismatch)?;
+        level.digests[level.taken] = child;
+        encode_internal(&mut buf, &level.seps, &level.digests);
+        if buf[..] != node[..] {
+            return Err(ProofError::RootMismatch);
+        }
+        expected = child;
+        known += 1;
+    }
+
+    // The levels hashed here are only trusted, and cached, once they are
+    // found to hash to the expected digest.
+    let mut hashed = Vec::new();
+    let mut hashed_at = Vec::with_capacity(levels.len() - known);
+    let mut digest = hash_leaf::<H, _>(&mut buf, &keys, &versions);
+    for level in levels[known..].iter_mut().rev() {
+        level.digests[level.taken] = digest;
+        digest = hash_internal::<H, _>(&mut buf, &level.seps, &level.digests);
+        hashed.extend_from_slice(&buf);
+        hashed_at.push((digest, hashed.len()));
+    }
+    if digest != expected {
+        return Err(ProofError::RootMismatch);
+    }
+    let mut start = 0;
+    for (digest, end) in hashed_at {
+        cache.insert(&digest, &hashed[start..end]);
+        start = end;
+    }
+
+    let pos = keys.binary_search(&key);
+    Ok(VerifiedPath { key, levels, keys, versions, pos, root: *root })
+}
+
+// What a level passes to its parent after an update.
+enum Up<'a> {
+    Node(Digest),
+    Split(Digest, &'a [u8], Digest),
+    Removed,
+}
+
+impl<'a> VerifiedPath<'a> {
+    /// Version stored for the key, if the tree has it.
+    pub fn version(&self) -> Option<u64> {
+        match self.pos {
+            Ok(i) => Some(self.versions[i]),
+            Err(_) => None,
+        }
+    }
+
+    pub fn root(&self) -> Digest {
+        self.root
+    }
+
+    /// Sets the version of the key, inserting it if needed, and returns the
+    /// new root.
+    pub fn put<H: Sha256>(self, version: u64) -> Digest {
+        self.put_cached::<H, ()>(version, &mut ())
+    }
+
+    /// Like [`put`](VerifiedPath::put), adding the internal nodes of the
+    /// new path to `cache`.
+    pub fn put_cached<H: Sha256, C: NodeCache>(mut self, version: u64, cache: &mut C) -> Digest {
+        match self.pos {
+            Ok(i) => self.versions[i] = version,
+            Err(i) => {
+                self.keys.insert(i, self.key);
+                self.versions.insert(i, version);
+            }
+        }
+
+        let mut buf = Vec::new();
+        let mut up = if self.keys.len() > MAX_LEAF_ENTRIES {
+            let mid = self.keys.len() / 2;
+            let left = hash_leaf::<H, _>(&mut buf, &self.keys[..mid], &self.versions[..mid]);
+            let right = hash_leaf::<H, _>(&mut buf, &self.keys[mid..], &self.versions[mid..]);
+            Up::Split(left, self.keys[mid], right)
+        } else {
+            Up::Node(hash_leaf::<H, _>(&mut buf, &self.keys, &self.versions))
+        };
+
+        for level in self.levels.iter_mut().rev() {
+            up = match up {
+                Up::Node(digest) => {
+                    level.digests[level.taken] = digest;
+                    Up::Node(hash_computed::<H, C>(&mut buf, &level.seps, &level.digests, cache))
+                }
+                Up::Split(left, sep, right) => {
+                    level.digests[level.taken] = left;
+                    level.digests.insert(level.taken + 1, right);
+                    level.seps.insert(level.taken, sep);
+                    if level.digests.len() > MAX_CHILDREN {
+                        let mid = level.digests.len() / 2;
+                        let left = hash_computed::<H, C>(&mut buf, &level.seps[..mid - 1], &level.digests[..mid], cache);
+                        let right = hash_computed::<H, C>(&mut buf, &level.seps[mid..], &level.digests[mid..], cache);
+                        Up::Split(left, level.seps[mid - 1], right)
+                    } else {
+                        Up::Node(hash_computed::<H, C>(&mut buf, &level.seps, &level.digests, cache))
+                    }
+                }
+                Up::Removed => unreachable!(),
+            };
+        }
+
+        match up {
+            Up::Node(digest) => digest,
+            Up::Split(left, sep, right) => hash_computed::<H, C>(&mut buf, &[sep], &[left, right], cache),
+            Up::Removed => unreachable!(),
+        }
+    }
+
+    /// Removes the key and returns the new root, which is the old one if
+    /// the tree does not have the key.
+    pub fn delete<H: Sha256>(self) -> Digest {
+        self.delete_cached::<H, ()>(&mut ())
+    }
+
+    /// Like [`delete`](VerifiedPath::delete), adding the internal nodes of
+    /// the new path to `cache`.
+    pub fn delete_cached<H: Sha256, C: NodeCache>(mut self, cache: &mut C) -> Digest {
+        let i = match self.pos {
+            Ok(i) => i,
+            Err(_) => return self.root,
+        };
+        self.keys.remove(i);
+        self.versions.remove(i);
+
+        let mut buf = Vec::new();
+        let mut up = if self.keys.is_empty() && !self.levels.is_empty() {
+            Up::Removed
+        } else {
+            Up::Node(hash_leaf::<H, _>(&mut buf, &self.keys, &self.versions))
+        };
+
+        for (d, level) in self.levels.iter_mut().enumerate().rev() {
+            match up {
+                Up::Node(digest) => level.digests[level.taken] = digest,
+                Up::Removed => {
+                    level.digests.remove(level.taken);
+                    if !level.seps.is_empty() {
+                        level.seps.remove(level.taken.saturating_sub(1));
+                    }
+                    if level.digests.is_empty() && d > 0 {
+                        continue;
+                    }
+                }
+                Up::Split(..) => unreachable!(),
+            }
+            up = Up::Node(match level.digests.len() {
+                0 => empty_root::<H>(),
+                // A root with a single child gives way to it.
+                1 if d == 0 => level.digests[0],
+                _ => hash_computed::<H, C>(&mut buf, &level.seps, &level.digests, cache),
+            });
+        }
+
+        match up {
+            Up::Node(digest) => digest,
+            _ => unreachable!(),
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use super::super::mbtree::MerkleBTree;
+    use super::super::RingSha256;
+
+    fn key(i: usize) -> Vec<u8> {
+        format!("key{:06}", i).into_bytes()
+    }
+
+    // A tree of 2000 even keys, two internal levels deep, and the path of
+    // one of them.
+    fn tree_and_path() -> (Digest, Vec<u8>, Vec<u8>) {
+        let mut tree = MerkleBTree::<RingSha256>::new();
+        for i in 0..2000 {
+            tree.set(&key(2 * i), i as u64).unwrap();
+        }
+        let key = key(1000);
+        let proof = tree.prove(&key);
+        (tree.root(), key, proof)
+    }
+
+    // Offsets in a path of the first sibling digest and the first separator
+    // length of every level, and of the leaf.
+    struct Layout {
+        digests: Vec<usize>,
+        seps: Vec<usize>,
+        leaf: usize,
+    }
+
+    fn layout(proof: &[u8]) -> Layout {
+        let mut r = Reader { buf: proof };
+        let at = |r: &Reader| proof.len() - r.buf.len();
+        let depth = r.bytes(1).unwrap()[0];
+        let mut layout = Layout { digests: Vec::new(), seps: Vec::new(), leaf: 0 };
+        for _ in 0..depth {
+            let n = r.u16().unwrap();
+            r.u16().unwrap();
+            layout.seps.push(at(&r));
+            for _ in 0..n - 1 {
+                r.key().unwrap();
+            }
+            layout.digests.push(at(&r));
+            r.bytes(32 * (n - 1)).unwrap();
+        }
+        layout.leaf = at(&r);
+        layout
+    }
+
+    fn verify_flipped(root: &Digest, key: &[u8], proof: &[u8], pos: usize, bit: u8) -> Result<Option<u64>, ProofError> {
+        let mut proof = proof.to_vec();
+        proof[pos] ^= bit;
+        verify::<RingSha256>(root, key, &proof).map(|path| path.version())
+    }
+
+    #[test]
+    fn accepts_an_intact_path() {
+        let (root, key, proof) = tree_and_path();
+        assert_eq!(layout(&proof).digests.len(), 2);
+        let path = verify::<RingSha256>(&root, &key, &proof).unwrap();
+        assert_eq!(path.version(), Some(500));
+        assert_eq!(verify::<RingSha256>(&root, b"key001001", &proof).unwrap().version(), None);
+    }
+
+    #[test]
+    fn rejects_a_flipped_sibling_digest() {
+        let (root, key, proof) = tree_and_path();
+        for &pos in layout(&proof).digests.iter() {
+            for &offset in &[0, 31] {
+                assert_eq!(verify_flipped(&root, &key, &proof, pos + offset, 1), Err(ProofError::RootMismatch));
+            }
+        }
+    }
+
+    #[test]
+    fn rejects_a_flipped_key() {
+        let (root, key, proof) = tree_and_path();
+        // "key101000" routes past every separator.
+        let mut other = key.clone();
+        other[3] ^= 1;
+        assert_eq!(verify::<RingSha256>(&root, &other, &proof).err(), Some(ProofError::WrongPath));
+
+        // The last digit of the first key of the leaf, made odd, which keeps
+        // the leaf in order.
+        let pos = layout(&proof).leaf + 2 + 2 + key.len() - 1;
+        assert_eq!(verify_flipped(&root, &key, &proof, pos, 1), Err(ProofError::RootMismatch));
+    }
+
+    #[test]
+    fn rejects_a_flipped_version() {
+        let (root, key, proof) = tree_and_path();
+        // The version of the first key of the leaf.
+        let pos = layout(&proof).leaf + 2 + 2 + key.len();
+        for &offset in &[0, 7] {
+            assert_eq!(verify_flipped(&root, &key, &proof, pos + offset, 1), Err(ProofError::RootMismatch));
+        }
+    }
+
+    #[test]
+    fn rejects_a_flipped_length_prefix() {
+        let (root, key, proof) = tree_and_path();
+        let layout = layout(&proof);
+        // A separator running past the end of the proof.
+        assert_eq!(verify_flipped(&root, &key, &proof, layout.seps[0] + 1, 0x80), Err(ProofError::Malformed));
+        // More leaf entries than a leaf holds.
+        assert_eq!(verify_flipped(&root, &key, &proof, layout.leaf + 1, 0x80), Err(ProofError::Malformed));
+        // One byte more or less for the first leaf key.
+        for &bit in &[1, 2] {
+            assert_eq!(verify_flipped(&root, &key, &proof, layout.leaf + 2, bit), Err(ProofError::Malformed));
+        }
+        // More levels than the proof has.
+        assert_eq!(verify_flipped(&root, &key, &proof, 0, 0x80), Err(ProofError::Malformed));
+
+        let mut longer = proof.clone();
+        longer.push(0);
+        assert_eq!(verify::<RingSha256>(&root, &key, &longer).err(), Some(ProofError::Malformed));
+    }
+}
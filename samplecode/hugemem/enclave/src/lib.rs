@@ -31,6 +31,7 @@ use std::string::String;
 use std::vec::Vec;
 use std::slice;
 use std::io::{self, Write};
+use std::alloc::System;
 /// A function simply invokes ocall print to print the incoming string
 ///
 /// # Parameters
@@ -74,6 +75,10 @@ pub extern "C" fn say_something(some_string: *const u8, some_len: usize) -> sgx_
     // Ocall to normal world for output
     println!("{}", &hello_string);
 
+    // Serve the big blocks from the reserved memory area, so the heap
+    // itself can stay small.
+    System::set_rsrv_threshold(Some(1024 * 1024));
+
     let mut sum:u64 = 0;
     let mut vv:Vec<Vec<u8>> = Vec::new();
     let mut onev:Vec<u8>; // 1Mbyte
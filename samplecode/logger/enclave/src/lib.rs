@@ -30,15 +30,34 @@ use sgx_types::*;
 use std::string::String;
 use std::vec::Vec;
 //use std::io::{self, Write};
+use std::io::AsyncLog;
 use std::slice;
+use std::sync::Arc;
 
 #[macro_use] extern crate log;
 extern crate env_logger;
+#[macro_use]
+extern crate lazy_static;
+
+lazy_static! {
+    // One log ring for the life of the enclave. Everything env_logger
+    // writes to stderr goes through it, so logging does not leave the
+    // enclave on every line.
+    static ref LOG: Option<Arc<AsyncLog>> = AsyncLog::new().ok().map(|log| {
+        let log = Arc::new(log);
+        log.clone().capture_stdio();
+        env_logger::init();
+        log
+    });
+}
 
 #[no_mangle]
 pub extern "C" fn say_something(some_string: *const u8, some_len: usize) -> sgx_status_t {
 
-    env_logger::init();
+    let log = match *LOG {
+        Some(ref log) => log,
+        None => return sgx_status_t::SGX_ERROR_UNEXPECTED,
+    };
 
     let str_slice = unsafe { slice::from_raw_parts(some_string, some_len) };
     //let _ = io::stdout().write(str_slice);
@@ -67,5 +86,8 @@ pub extern "C" fn say_something(some_string: *const u8, some_len: usize) -> sgx_
     //println!("{}", &hello_string);
     trace!("{}", hello_string);
 
+    // Let the drainer catch up before returning to the app.
+    let _ = log.flush();
+
     sgx_status_t::SGX_SUCCESS
 }
@@ -36,7 +36,7 @@ extern crate sgx_rand as rand;
 extern crate serde;
 extern crate serde_json;
 
-use rusty_machine::linalg::{Matrix, BaseMatrix};
+use rusty_machine::linalg::{Matrix, BaseMatrix, Vector};
 use rusty_machine::learning::k_means::{KMeansClassifier, KPlusPlus};
 use rusty_machine::learning::UnSupModel;
 
@@ -52,6 +52,10 @@ use rusty_machine::learning::optim::grad_desc::StochasticGD;
 
 use rusty_machine::learning::SupModel;
 
+use std::thread::pool::{ThreadPool, ThreadPoolBuilder};
+
+mod linalg;
+
 fn generate_data(centroids: &Matrix<f64>,
                  points_per_centroid: usize,
                  noise: f64)
@@ -90,6 +94,7 @@ fn sample_main() -> sgx_status_t {
     kmeans_sample();
     nn_sample();
     iris_sample();
+    gemm_sample();
 
     sgx_status_t::SGX_SUCCESS
 }
@@ -410,3 +415,144 @@ fn kmeans_sample() {
     println!("Samples closest to first centroid: {}", first.len());
     println!("Samples closest to second centroid: {}", second.len());
 }
+
+// Multiplies two matrices with the kernels of `linalg` instead of the
+// generic ones of rusty_machine.
+fn matmul<T: linalg::Scalar>(pool: Option<&ThreadPool>, a: &Matrix<T>, b: &Matrix<T>) -> Matrix<T> {
+    assert_eq!(a.cols(), b.rows(), "Matrix dimensions do not agree.");
+    let (m, n, k) = (a.rows(), b.cols(), a.cols());
+    let mut c = vec![T::ZERO; m * n];
+    linalg::gemm(pool, m, n, k, T::ONE, a.data(), b.data(), T::ZERO, &mut c);
+    Matrix::new(m, n, c)
+}
+
+fn max_abs_diff(a: &[f64], b: &[f64]) -> f64 {
+    a.iter().zip(b).fold(0f64, |d, (x, y)| d.max((x - y).abs()))
+}
+
+fn assert_close(what: &str, got: &[f64], expected: &[f64], tol: f64) {
+    assert_eq!(got.len(), expected.len());
+    let err = max_abs_diff(got, expected);
+    assert!(err <= tol, "{}: max error {:e} above {:e}", what, err, tol);
+}
+
+// Checks every kernel of `linalg` for `T` against rusty_machine in f64, on
+// sizes that leave partial tiles and chunks. `eps` is the machine epsilon
+// of `T`; the inputs are below 1, so sums of `k` products are off by about
+// `k * k * eps` at most.
+fn check_linalg<T>(pool: Option<&ThreadPool>, eps: f64)
+where
+    T: linalg::Scalar + From<f32> + Into<f64>,
+{
+    let inputs = |len: usize| (0..len).map(|_| random::<f32>()).collect::<Vec<f32>>();
+    let cast = |x: &[f32]| x.iter().map(|&x| T::from(x)).collect::<Vec<T>>();
+    let wide = |x: &[f32]| x.iter().map(|&x| x as f64).collect::<Vec<f64>>();
+    let back = |x: &[T]| x.iter().map(|&x| x.into()).collect::<Vec<f64>>();
+
+    let (m, n, k) = (67, 131, 45);
+    let (a, b, c) = (inputs(m * k), inputs(k * n), inputs(m * n));
+    let product = &Matrix::new(m, k, wide(&a)) * &Matrix::new(k, n, wide(&b));
+    let expected = product.data().iter().zip(wide(&c)).map(|(p, c)| 0.5 * p + 2.0 * c).collect::<Vec<f64>>();
+    let mut got = cast(&c);
+    linalg::gemm(pool, m, n, k, T::from(0.5), &cast(&a), &cast(&b), T::from(2.0), &mut got);
+    assert_close("gemm", &back(&got), &expected, 4.0 * eps * (k * k) as f64);
+
+    let (m, n) = (1000, 301);
+    let (a, x, y) = (inputs(m * n), inputs(n), inputs(m));
+    let product = &Matrix::new(m, n, wide(&a)) * &Vector::new(wide(&x));
+    let expected = product.data().iter().zip(wide(&y)).map(|(p, y)| 0.5 * p + 2.0 * y).collect::<Vec<f64>>();
+    let mut got = cast(&y);
+    linalg::gemv(pool, m, n, T::from(0.5), &cast(&a), &cast(&x), T::from(2.0), &mut got);
+    assert_close("gemv", &back(&got), &expected, 4.0 * eps * (n * n) as f64);
+
+    let len = 100_003;
+    let (x, y) = (inputs(len), inputs(len));
+    let expected = wide(&x).iter().zip(wide(&y)).map(|(x, y)| 0.5 * x + y).collect::<Vec<f64>>();
+    let mut got = cast(&y);
+    linalg::axpy(pool, T::from(0.5), &cast(&x), &mut got);
+    assert_close("axpy", &back(&got), &expected, 4.0 * eps);
+
+    let expected = wide(&x).iter().zip(wide(&y)).map(|(x, y)| x * y).collect::<Vec<f64>>();
+    let mut got = cast(&y);
+    linalg::hadamard(pool, &cast(&x), &mut got);
+    assert_close("hadamard", &back(&got), &expected, 4.0 * eps);
+
+    let expected = wide(&x).iter().map(|x| x * x + 1.0).collect::<Vec<f64>>();
+    let mut got = cast(&x);
+    linalg::map_inplace(pool, &mut got, |x| x * x + T::ONE);
+    assert_close("map_inplace", &back(&got), &expected, 4.0 * eps);
+}
+
+fn gemm_sample() {
+    println!("Matrix multiplication benchmark:");
+    let pool = match ThreadPoolBuilder::new().build() {
+        Ok(pool) => {
+            println!("Using {} worker threads", pool.current_num_threads());
+            Some(pool)
+        }
+        Err(e) => {
+            println!("Cannot start a thread pool, running single-threaded: {}", e);
+            None
+        }
+    };
+
+    // The baseline kernels first, then the AVX2 and FMA ones if the CPU
+    // has both, which are left on for the benchmark.
+    let mut variants = vec![(false, "baseline")];
+    if linalg::set_avx2_fma(true) {
+        variants.push((true, "AVX2 and FMA"));
+    }
+    for &(avx2_fma, name) in &variants {
+        linalg::set_avx2_fma(avx2_fma);
+        check_linalg::<f64>(None, std::f64::EPSILON);
+        check_linalg::<f32>(None, std::f32::EPSILON as f64);
+        if let Some(ref pool) = pool {
+            check_linalg::<f64>(Some(pool), std::f64::EPSILON);
+            check_linalg::<f32>(Some(pool), std::f32::EPSILON as f64);
+        }
+        println!("linalg kernels agree with rusty_machine ({})", name);
+    }
+    linalg::set_avx2_fma(true);
+
+    let f32_label = if pool.is_some() { "linalg, parallel:" } else { "linalg:" };
+    for &size in &[128usize, 256, 512] {
+        let a = Matrix::new(size, size, (0..size * size).map(|_| random::<f64>()).collect::<Vec<f64>>());
+        let b = Matrix::new(size, size, (0..size * size).map(|_| random::<f64>()).collect::<Vec<f64>>());
+        let flops = 2.0 * (size * size * size) as f64;
+        let gflops = |d: Duration| flops / (d.as_secs() as f64 * 1e9 + d.subsec_nanos() as f64);
+
+        let now = SystemTime::now();
+        let expected = &a * &b;
+        let elapsed = now.elapsed().unwrap();
+        println!("{0}x{0} f64, rusty_machine:    {1:?} ({2:.2} GFLOP/s)", size, elapsed, gflops(elapsed));
+
+        let now = SystemTime::now();
+        let c = matmul(None, &a, &b);
+        let elapsed = now.elapsed().unwrap();
+        println!("{0}x{0} f64, linalg:           {1:?} ({2:.2} GFLOP/s), max error {3:e}",
+                 size, elapsed, gflops(elapsed), max_abs_diff(c.data(), expected.data()));
+
+        if let Some(ref pool) = pool {
+            let now = SystemTime::now();
+            let c = matmul(Some(pool), &a, &b);
+            let elapsed = now.elapsed().unwrap();
+            println!("{0}x{0} f64, linalg, parallel: {1:?} ({2:.2} GFLOP/s), max error {3:e}",
+                     size, elapsed, gflops(elapsed), max_abs_diff(c.data(), expected.data()));
+        }
+
+        let a = Matrix::new(size, size, a.data().iter().map(|&x| x as f32).collect::<Vec<f32>>());
+        let b = Matrix::new(size, size, b.data().iter().map(|&x| x as f32).collect::<Vec<f32>>());
+
+        let now = SystemTime::now();
+        let _ = &a * &b;
+        let elapsed = now.elapsed().unwrap();
+        println!("{0}x{0} f32, rusty_machine:    {1:?} ({2:.2} GFLOP/s)", size, elapsed, gflops(elapsed));
+
+        let now = SystemTime::now();
+        let c = matmul(pool.as_ref(), &a, &b);
+        let elapsed = now.elapsed().unwrap();
+        let c = c.data().iter().map(|&x| x as f64).collect::<Vec<f64>>();
+        println!("{0}x{0} f32, {1:<18}{2:?} ({3:.2} GFLOP/s), max error {4:e}",
+                 size, f32_label, elapsed, gflops(elapsed), max_abs_diff(&c, expected.data()));
+    }
+}
@@ -0,0 +1,396 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Dense linear algebra kernels on row-major `f32` and `f64` slices: a
+//! cache-blocked GEMM, GEMV and a few elementwise operations. They run
+//! entirely in the enclave, with no untrusted BLAS involved.
+//!
+//! GEMM packs B, KC rows by NC columns at a time, into NR-wide panels
+//! shared by every thread. Each thread packs MC rows of A into MR-tall
+//! panels, which stay in L2, and runs an MR by NR micro-kernel whose
+//! accumulators stay in registers while it streams one B panel from L1.
+//!
+//! Every kernel is compiled twice, for baseline x86-64 (SSE2) and with
+//! AVX2 and FMA. The variant is picked at run time from the CPU features
+//! the enclave reports, unless `set_avx2_fma` turned the AVX2 one off.
+//! Given a pool, the rows of the output are spread over its workers.
+
+use std::cmp;
+use std::ops::{Add, Mul};
+use std::sync::SgxMutex;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::thread::pool::{self, ThreadPool};
+use std::vec::Vec;
+
+const KC: usize = 256;
+const MC: usize = 64;
+const NC: usize = 4096;
+
+// Below this many multiply-adds the work is not split between threads.
+const PAR_MIN_WORK: usize = 1 << 16;
+
+pub trait Scalar: Copy + Send + Sync + PartialEq + Add<Output = Self> + Mul<Output = Self> + 'static {
+    const ZERO: Self;
+    const ONE: Self;
+    /// Height of the micro-kernel tile.
+    const MR: usize;
+    /// Width of the micro-kernel tile.
+    const NR: usize;
+
+    // Multiplies the packed `mc` by `kc` block of A with the packed `kc` by
+    // `nc` block of B and adds the product to `c`, whose rows are `ldc`
+    // apart.
+    #[doc(hidden)]
+    fn block(mc: usize, nc: usize, kc: usize, pa: &[Self], pb: &[Self], c: &mut [Self], ldc: usize);
+
+    #[doc(hidden)]
+    fn dot(x: &[Self], y: &[Self]) -> Self;
+
+    #[doc(hidden)]
+    fn axpy(alpha: Self, x: &[Self], y: &mut [Self]);
+}
+
+static AVX2_FMA: AtomicBool = AtomicBool::new(true);
+
+/// Allows or forbids the AVX2 and FMA variant of the kernels, which is
+/// allowed by default. Returns whether it is used from now on, which also
+/// takes a CPU with both features.
+pub fn set_avx2_fma(enable: bool) -> bool {
+    AVX2_FMA.store(enable, Ordering::Relaxed);
+    has_avx2_fma()
+}
+
+fn has_avx2_fma() -> bool {
+    AVX2_FMA.load(Ordering::Relaxed)
+        && std::is_x86_feature_detected!("avx2")
+        && std::is_x86_feature_detected!("fma")
+}
+
+macro_rules! scalar_impl {
+    ($t:ident, $mr:expr, $nr:expr) => {
+        impl Scalar for $t {
+            const ZERO: $t = 0.0;
+            const ONE: $t = 1.0;
+            const MR: usize = $mr;
+            const NR: usize = $nr;
+
+            fn block(mc: usize, nc: usize, kc: usize, pa: &[$t], pb: &[$t], c: &mut [$t], ldc: usize) {
+                #[inline(always)]
+                fn block<F: Fn($t, $t, $t) -> $t>(mc: usize, nc: usize, kc: usize,
+                                                  pa: &[$t], pb: &[$t],
+                                                  c: &mut [$t], ldc: usize,
+                                                  madd: F) {
+                    const MR: usize = $mr;
+                    const NR: usize = $nr;
+                    for (jp, bp) in pb.chunks_exact(kc * NR).enumerate() {
+                        let j0 = jp * NR;
+                        let nr = cmp::min(NR, nc - j0);
+                        for (ip, ap) in pa.chunks_exact(kc * MR).enumerate() {
+                            let i0 = ip * MR;
+                            let mr = cmp::min(MR, mc - i0);
+                            let mut acc = [[0.0; NR]; MR];
+                            for (a, b) in ap.chunks_exact(MR).zip(bp.chunks_exact(NR)) {
+                                for i in 0..MR {
+                                    for j in 0..NR {
+                                        acc[i][j] = madd(a[i], b[j], acc[i][j]);
+                                    }
+                                }
+                            }
+                            for i in 0..mr {
+                                let row = &mut c[(i0 + i) * ldc + j0..][..nr];
+                                for j in 0..nr {
+                                    row[j] = row[j] + acc[i][j];
+                                }
+                            }
+                        }
+                    }
+                }
+
+                #[target_feature(enable = "avx2,fma")]
+                unsafe fn block_fma(mc: usize, nc: usize, kc: usize, pa: &[$t], pb: &[$t], c: &mut [$t], ldc: usize) {
+                    block(mc, nc, kc, pa, pb, c, ldc, |a, b, acc| a.mul_add(b, acc))
+                }
+
+                if has_avx2_fma() {
+                    unsafe { block_fma(mc, nc, kc, pa, pb, c, ldc) }
+                } else {
+                    block(mc, nc, kc, pa, pb, c, ldc, |a, b, acc| acc + a * b)
+                }
+            }
+
+            fn dot(x: &[$t], y: &[$t]) -> $t {
+                #[inline(always)]
+                fn dot<F: Fn($t, $t, $t) -> $t>(x: &[$t], y: &[$t], madd: F) -> $t {
+                    // Independent sums, so the additions pipeline.
+                    const LANES: usize = 2 * $nr;
+                    let mut acc = [0.0; LANES];
+                    let xs = x.chunks_exact(LANES);
+                    let ys = y.chunks_exact(LANES);
+                    let mut sum = 0.0;
+                    for (&a, &b) in xs.remainder().iter().zip(ys.remainder()) {
+                        sum = madd(a, b, sum);
+                    }
+                    for (a, b) in xs.zip(ys) {
+                        for l in 0..LANES {
+                            acc[l] = madd(a[l], b[l], acc[l]);
+                        }
+                    }
+                    acc.iter().fold(sum, |s, &a| s + a)
+                }
+
+                #[target_feature(enable = "avx2,fma")]
+                unsafe fn dot_fma(x: &[$t], y: &[$t]) -> $t {
+                    dot(x, y, |a, b, acc| a.mul_add(b, acc))
+                }
+
+                if has_avx2_fma() {
+                    unsafe { dot_fma(x, y) }
+                } else {
+                    dot(x, y, |a, b, acc| acc + a * b)
+                }
+            }
+
+            fn axpy(alpha: $t, x: &[$t], y: &mut [$t]) {
+                #[inline(always)]
+                fn axpy<F: Fn($t, $t, $t) -> $t>(alpha: $t, x: &[$t], y: &mut [$t], madd: F) {
+                    for (y, &x) in y.iter_mut().zip(x) {
+                        *y = madd(alpha, x, *y);
+                    }
+                }
+
+                #[target_feature(enable = "avx2,fma")]
+                unsafe fn axpy_fma(alpha: $t, x: &[$t], y: &mut [$t]) {
+                    axpy(alpha, x, y, |a, b, acc| a.mul_add(b, acc))
+                }
+
+                if has_avx2_fma() {
+                    unsafe { axpy_fma(alpha, x, y) }
+                } else {
+                    axpy(alpha, x, y, |a, b, acc| acc + a * b)
+                }
+            }
+        }
+    };
+}
+
+// A 4 by 8 f64 tile takes 8 of the 16 AVX2 registers, as does a 4 by 16
+// f32 tile.
+scalar_impl!(f64, 4, 8);
+scalar_impl!(f32, 4, 16);
+
+fn round_up(n: usize, to: usize) -> usize {
+    (n + to - 1) / to * to
+}
+
+// Runs `f` on chunks of `rows_per_chunk` rows of `data`, on `pool` if the
+// work is worth splitting.
+fn for_rows<T, F>(pool: Option<&ThreadPool>, data: &mut [T], row_len: usize,
+                  rows_per_chunk: usize, work: usize, f: F)
+where
+    T: Send,
+    F: Fn(usize, &mut [T]) + Sync,
+{
+    let chunk = cmp::max(rows_per_chunk * row_len, 1);
+    match pool {
+        Some(pool) if work >= PAR_MIN_WORK && data.len() > chunk => {
+            pool.par_chunks_mut(data, chunk).for_each(|i, rows| f(i * rows_per_chunk, rows))
+        }
+        _ => {
+            for (i, rows) in data.chunks_mut(chunk).enumerate() {
+                f(i * rows_per_chunk, rows);
+            }
+        }
+    }
+}
+
+// Packs rows `i0..i0 + mc`, columns `p0..p0 + kc` of A, scaled by `alpha`,
+// into MR-tall panels, padding the last one with zeros.
+fn pack_a<T: Scalar>(alpha: T, a: &[T], lda: usize, i0: usize, mc: usize,
+                     p0: usize, kc: usize, pa: &mut [T]) {
+    for (ip, panel) in pa.chunks_exact_mut(kc * T::MR).enumerate() {
+        for i in 0..T::MR {
+            let r = ip * T::MR + i;
+            if r < mc {
+                let row = &a[(i0 + r) * lda + p0..][..kc];
+                for (p, &x) in row.iter().enumerate() {
+                    panel[p * T::MR + i] = alpha * x;
+                }
+            } else {
+                for p in 0..kc {
+                    panel[p * T::MR + i] = T::ZERO;
+                }
+            }
+        }
+    }
+}
+
+// Packs rows `p0..p0 + kc`, columns `j0..j0 + nc` of B into NR-wide panels,
+// padding the last one with zeros.
+fn pack_b<T: Scalar>(b: &[T], ldb: usize, p0: usize, kc: usize,
+                     j0: usize, nc: usize, pb: &mut [T]) {
+    for (jp, panel) in pb.chunks_exact_mut(kc * T::NR).enumerate() {
+        let j = j0 + jp * T::NR;
+        let nr = cmp::min(T::NR, j0 + nc - j);
+        for p in 0..kc {
+            let src = &b[(p0 + p) * ldb + j..][..nr];
+            let dst = &mut panel[p * T::NR..][..T::NR];
+            dst[..nr].copy_from_slice(src);
+            for x in &mut dst[nr..] {
+                *x = T::ZERO;
+            }
+        }
+    }
+}
+
+fn scale<T: Scalar>(beta: T, y: &mut [T]) {
+    if beta == T::ZERO {
+        // Also clears NaNs, as BLAS does.
+        for y in y.iter_mut() {
+            *y = T::ZERO;
+        }
+    } else if beta != T::ONE {
+        for y in y.iter_mut() {
+            *y = beta * *y;
+        }
+    }
+}
+
+/// Computes `c = alpha * a * b + beta * c`, where `a` is `m` by `k`, `b` is
+/// `k` by `n` and `c` is `m` by `n`, all row-major and contiguous.
+///
+/// # Panics
+///
+/// Panics if a slice does not have the length its dimensions imply.
+pub fn gemm<T: Scalar>(pool: Option<&ThreadPool>,
+                       m: usize, n: usize, k: usize,
+                       alpha: T, a: &[T], b: &[T],
+                       beta: T, c: &mut [T]) {
+    assert_eq!(a.len(), m * k, "a is not m by k");
+    assert_eq!(b.len(), k * n, "b is not k by n");
+    assert_eq!(c.len(), m * n, "c is not m by n");
+    if m == 0 || n == 0 {
+        return;
+    }
+    if k == 0 || alpha == T::ZERO {
+        for_rows(pool, c, n, MC, m * n, |_, rows| scale(beta, rows));
+        return;
+    }
+
+    // One buffer for packing A per thread, the caller's first, reused for
+    // every block. The lock is never contended.
+    let threads = pool.map_or(0, |pool| pool.current_num_threads());
+    let pas: Vec<SgxMutex<Vec<T>>> = (0..=threads)
+        .map(|_| SgxMutex::new(Vec::with_capacity(round_up(cmp::min(MC, m), T::MR) * cmp::min(KC, k))))
+        .collect();
+
+    let mut pb = Vec::new();
+    for j0 in (0..n).step_by(NC) {
+        let nc = cmp::min(NC, n - j0);
+        for p0 in (0..k).step_by(KC) {
+            let kc = cmp::min(KC, k - p0);
+            let panel = kc * T::NR;
+            pb.clear();
+            pb.resize(round_up(nc, T::NR) * kc, T::ZERO);
+            for_rows(pool, &mut pb, panel, 1, kc * nc, |jp, dst| {
+                let j = j0 + jp * T::NR;
+                pack_b(b, n, p0, kc, j, cmp::min(T::NR, j0 + nc - j), dst);
+            });
+
+            let pb = &pb[..];
+            for_rows(pool, c, n, MC, m * nc * kc, |i0, rows| {
+                let mc = rows.len() / n;
+                if p0 == 0 && j0 == 0 {
+                    scale(beta, rows);
+                }
+                let slot = pool::current_thread_index().map_or(0, |i| i + 1) % pas.len();
+                let mut pa = pas[slot].lock().unwrap();
+                let len = round_up(mc, T::MR) * kc;
+                pa.resize(len, T::ZERO);
+                pack_a(alpha, a, k, i0, mc, p0, kc, &mut pa[..len]);
+                T::block(mc, nc, kc, &pa[..len], pb, &mut rows[j0..], n);
+            });
+        }
+    }
+}
+
+/// Computes `y = alpha * a * x + beta * y`, where `a` is `m` by `n`,
+/// row-major and contiguous.
+///
+/// # Panics
+///
+/// Panics if a slice does not have the length its dimensions imply.
+pub fn gemv<T: Scalar>(pool: Option<&ThreadPool>,
+                       m: usize, n: usize,
+                       alpha: T, a: &[T], x: &[T],
+                       beta: T, y: &mut [T]) {
+    assert_eq!(a.len(), m * n, "a is not m by n");
+    assert_eq!(x.len(), n, "x does not have n elements");
+    assert_eq!(y.len(), m, "y does not have m elements");
+    // Rows of about 64 KiB of a per chunk.
+    let rows_per_chunk = cmp::max((1 << 16) / cmp::max(n * std::mem::size_of::<T>(), 1), 1);
+    for_rows(pool, y, 1, rows_per_chunk, m * n, |i0, ys| {
+        for (i, y) in ys.iter_mut().enumerate() {
+            let row = &a[(i0 + i) * n..][..n];
+            let ax = alpha * T::dot(row, x);
+            *y = if beta == T::ZERO { ax } else { ax + beta * *y };
+        }
+    });
+}
+
+// Elements per chunk of the elementwise operations.
+const ELEMENTWISE_CHUNK: usize = 1 << 14;
+
+/// Computes `y = alpha * x + y`.
+///
+/// # Panics
+///
+/// Panics if `x` and `y` differ in length.
+pub fn axpy<T: Scalar>(pool: Option<&ThreadPool>, alpha: T, x: &[T], y: &mut [T]) {
+    assert_eq!(x.len(), y.len(), "x and y differ in length");
+    for_rows(pool, y, 1, ELEMENTWISE_CHUNK, x.len(), |i0, ys| {
+        T::axpy(alpha, &x[i0..][..ys.len()], ys)
+    });
+}
+
+/// Multiplies `y` by `x` elementwise.
+///
+/// # Panics
+///
+/// Panics if `x` and `y` differ in length.
+pub fn hadamard<T: Scalar>(pool: Option<&ThreadPool>, x: &[T], y: &mut [T]) {
+    assert_eq!(x.len(), y.len(), "x and y differ in length");
+    for_rows(pool, y, 1, ELEMENTWISE_CHUNK, x.len(), |i0, ys| {
+        for (y, &x) in ys.iter_mut().zip(&x[i0..]) {
+            *y = *y * x;
+        }
+    });
+}
+
+/// Replaces every element `x` of `data` with `f(x)`, as for an activation
+/// function.
+pub fn map_inplace<T, F>(pool: Option<&ThreadPool>, data: &mut [T], f: F)
+where
+    T: Scalar,
+    F: Fn(T) -> T + Sync,
+{
+    let len = data.len();
+    for_rows(pool, data, 1, ELEMENTWISE_CHUNK, len, |_, xs| {
+        for x in xs.iter_mut() {
+            *x = f(*x);
+        }
+    });
+}
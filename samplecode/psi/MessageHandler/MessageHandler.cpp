@@ -454,33 +454,25 @@ string MessageHandler::handlePsiHashData(Messages::MessagePsiHashData msg) {
     uint8_t mac[SGX_MAC_SIZE] = {0};
     sgx_ra_context_t context = msg.context();
     uint32_t id = msg.id();
-    int data_size = msg.data_size();
-    uint8_t* data = (uint8_t*)malloc(data_size);
+    const string &data = msg.data();
 
     for (int i = 0; i < SGX_MAC_SIZE; i++) {
         mac[i] = (uint8_t)msg.mac(i);
     }
 
-    for (int i = 0; i < data_size; i++) {
-        data[i] = (uint8_t)msg.data(i);
-    }
-
     sgx_status_t status;
     sgx_status_t ret = add_hash_data(this->enclave->getID(),
                                     &status,
                                     id,
                                     context,
-                                    data,
-                                    data_size,
+                                    (uint8_t*)data.data(),
+                                    data.size(),
                                     mac);
     if (SGX_SUCCESS != ret || SGX_SUCCESS != status) {
         Log("[PSI] add_hash_data failed, %d, %d!", ret, status);
-        SafeFree(data);
         return "";
     }
 
-    SafeFree(data);
-
     Messages::MessagePsiResult result;
     result.set_type(RA_PSI_RESULT);
     result.set_size(0);
@@ -15,6 +15,10 @@
 // specific language governing permissions and limitations
 // under the License..
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include "Worker.h"
 #include "sample_libcrypto.h"
 #include "../GeneralSettings.h"
@@ -33,7 +37,9 @@ static const sample_ec256_private_t g_sp_priv_key = {
 
 PSIWorker::PSIWorker(WebService *ws) : ws(ws) {}
 
-PSIWorker::~PSIWorker() {}
+PSIWorker::~PSIWorker() {
+    this->sp_psi_unload_data();
+}
 
 
 int PSIWorker::sp_ra_proc_msg0_req(const uint32_t id) {
@@ -619,98 +625,206 @@ int PSIWorker::set_hash_salt(Messages::MessagePsiSalt msg) {
 }
 
 bool PSIWorker::sp_psi_is_finish_get_data() {
-    return this->hash_vector_cursor >= this->hash_vector.size();
+    return this->hash_keys_cursor >= this->hash_keys.size();
 }
 
-int PSIWorker::sp_psi_get_data_hash(Messages::MessagePsiHashData *data) {
-    int ret = 0;
+// Keys are bucketed by their first two bytes before each bucket is sorted.
+#define PSI_RADIX_BITS 16
+#define PSI_RADIX_BUCKETS (1 << PSI_RADIX_BITS)
 
-    if (this->hash_vector.size() <= 0) {
-        //read file
-        uint8_t * file_data = NULL;
-        int file_size = 0;
-
-        //No duplicate data by default
-        file_size = ReadFileToBuffer(this->hash_path, &file_data);
-        if (file_size <= 0) {
-            return -1;
-        }
+static inline uint32_t psi_radix(const psi_key_t &key) {
+    return ((uint32_t)key.hash[0] << 8) | key.hash[1];
+}
 
-        char * p = (char*)file_data;
-        const char * s = p;
-        char* n = (char*)p;
-        for( ; p - s < file_size; p = n + 1) {
-            n = strchr(p, '\n');
-            if (n == NULL) {
-                //only one line or last line
-                n = p + strlen(p);
-            } else {
-                n[0] = '\0';
-            }
-            if (strlen(p) <= 0) {//ignore null line
-                continue;
-            }
+static bool psi_key_less(const psi_key_t &a, const psi_key_t &b) {
+    return memcmp(a.hash, b.hash, sizeof(sample_sha256_hash_t)) < 0;
+}
 
-            sample_sha256_hash_t report_data = {0};
+// Hashes the non-empty lines in [begin, end) of the input, each followed by
+// the salt, and counts the keys per radix bucket.
+static int psi_hash_lines(const char *file, size_t begin, size_t end, const string &salt,
+                          std::vector<psi_key_t> *keys, std::vector<size_t> *counts) {
+    size_t pos = begin;
+    while (pos < end) {
+        const char *line = file + pos;
+        const char *nl = (const char*)memchr(line, '\n', end - pos);
+        size_t len = nl ? nl - line : end - pos;
+
+        if (len > 0) {
+            psi_key_t key;
             Sha256 sha256;
-            sha256.update((uint8_t*)p, strlen(p));
-            sha256.update((uint8_t*)this->psi_salt.c_str(), this->psi_salt.size());
-            sha256.hash((sample_sha256_hash_t * )&report_data);
+            if (sha256.update((uint8_t*)line, len) != 0 ||
+                sha256.update((uint8_t*)salt.c_str(), salt.size()) != 0 ||
+                sha256.hash(&key.hash) != 0) {
+                return -1;
+            }
+            key.line = pos;
+            keys->push_back(key);
+            (*counts)[psi_radix(key)]++;
+        }
+        pos += len + 1;
+    }
+    return 0;
+}
 
-            string hash = ByteArrayToString(report_data, sizeof(sample_sha256_hash_t));
+void PSIWorker::sp_psi_unload_data() {
+    if (this->hash_file != NULL) {
+        munmap((void*)this->hash_file, this->hash_file_size);
+        this->hash_file = NULL;
+        this->hash_file_size = 0;
+    }
+    std::vector<psi_key_t>().swap(this->hash_keys);
+    this->hash_keys_cursor = 0;
+}
 
-            this->hash_vector.push_back(hash);
-            this->data_map[hash] = p;
+// Maps the input file, hashes its lines on all cores and sorts the keys:
+// every thread scatters its keys into their radix bucket, then the buckets
+// are sorted in parallel.
+int PSIWorker::sp_psi_load_data() {
+    this->sp_psi_unload_data();
 
-            Log("[PSI] Init data: %s, hash: %s", p, ByteArrayToString((const uint8_t*)&report_data, sizeof(sample_sha256_hash_t)));
-        }
+    int fd = open(this->hash_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        Log("[PSI] Open %s failed", this->hash_path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+    size_t file_size = st.st_size;
+    void *file = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED) {
+        Log("[PSI] Map %s failed", this->hash_path);
+        return -1;
+    }
+    madvise(file, file_size, MADV_SEQUENTIAL);
+    this->hash_file = (const char*)file;
+    this->hash_file_size = file_size;
 
-        Log("[PSI] Init all data, size: %d", this->hash_vector.size());
+    unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+    if (file_size < 1024 * 1024) {
+        threads = 1;
+    }
 
-        std::sort(this->hash_vector.begin(), this->hash_vector.end());
-        this->hash_vector_cursor = 0;
+    // Split the input at the line starts nearest to equal shares.
+    std::vector<size_t> starts(threads + 1, file_size);
+    starts[0] = 0;
+    for (unsigned int t = 1; t < threads; t++) {
+        size_t pos = std::max(file_size / threads * t, starts[t - 1]);
+        const char *nl = (const char*)memchr(this->hash_file + pos, '\n', file_size - pos);
+        starts[t] = nl ? nl - this->hash_file + 1 : file_size;
     }
 
-    if (this->hash_vector_cursor >= this->hash_vector.size()) {
-        return -1;
+    std::vector<std::vector<psi_key_t>> parts(threads);
+    std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(PSI_RADIX_BUCKETS, 0));
+    std::vector<int> results(threads, 0);
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; t++) {
+        workers.push_back(std::thread([&, t]() {
+            parts[t].reserve((starts[t + 1] - starts[t]) / SAMPLE_SHA256_HASH_SIZE);
+            results[t] = psi_hash_lines(this->hash_file, starts[t], starts[t + 1], this->psi_salt,
+                                        &parts[t], &counts[t]);
+        }));
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    for (unsigned int t = 0; t < threads; t++) {
+        if (results[t] != 0) {
+            this->sp_psi_unload_data();
+            return -1;
+        }
     }
 
-    int count = PSI_HASH_DATA_COUNT;
+    // Turn the counts into the offset of every thread's share of a bucket.
+    std::vector<size_t> bucket_starts(PSI_RADIX_BUCKETS + 1, 0);
+    size_t total = 0;
+    for (uint32_t b = 0; b < PSI_RADIX_BUCKETS; b++) {
+        bucket_starts[b] = total;
+        for (unsigned int t = 0; t < threads; t++) {
+            size_t count = counts[t][b];
+            counts[t][b] = total;
+            total += count;
+        }
+    }
+    bucket_starts[PSI_RADIX_BUCKETS] = total;
+
+    this->hash_keys.resize(total);
+    psi_key_t *keys = this->hash_keys.data();
+    for (unsigned int t = 0; t < threads; t++) {
+        workers.push_back(std::thread([&, t]() {
+            for (const psi_key_t &key : parts[t]) {
+                keys[counts[t][psi_radix(key)]++] = key;
+            }
+            std::vector<psi_key_t>().swap(parts[t]);
+        }));
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    workers.clear();
 
-    if (this->hash_vector_cursor + PSI_HASH_DATA_COUNT > this->hash_vector.size()) {
-        count = this->hash_vector.size() - this->hash_vector_cursor;
+    for (unsigned int t = 0; t < threads; t++) {
+        workers.push_back(std::thread([&, t]() {
+            for (uint32_t b = t; b < PSI_RADIX_BUCKETS; b += threads) {
+                std::sort(keys + bucket_starts[b], keys + bucket_starts[b + 1], psi_key_less);
+            }
+        }));
     }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    this->hash_keys_cursor = 0;
+    Log("[PSI] Init all data, size: %d", this->hash_keys.size());
+
+    return 0;
+}
 
-    int payload_size = count * SAMPLE_SHA256_HASH_SIZE;
-    uint8_t payload[payload_size] = {0};
-    uint8_t enc_data[payload_size] = {0};
+int PSIWorker::sp_psi_get_data_hash(Messages::MessagePsiHashData *data) {
+    int ret = 0;
 
-    for (int i = 0; i < count; i++) {
-        uint8_t * arr = NULL;
-        int size = HexStringToByteArray(this->hash_vector[this->hash_vector_cursor + i], &arr);
-        if (size != sizeof(sample_sha256_hash_t)) {
-            Log("[PSI] Get hash vector , something error: %d, %d, %s", size, sizeof(sample_sha256_hash_t), this->hash_vector[this->hash_vector_cursor + i]);
+    if (this->hash_file == NULL) {
+        if (this->sp_psi_load_data() != 0) {
             return -1;
         }
-        memcpy(payload + i*sizeof(sample_sha256_hash_t), arr, size);
     }
 
-    this->hash_vector_cursor += count;
+    if (this->hash_keys_cursor >= this->hash_keys.size()) {
+        return -1;
+    }
+
+    size_t count = std::min((size_t)PSI_HASH_DATA_COUNT, this->hash_keys.size() - this->hash_keys_cursor);
+    size_t payload_size = count * SAMPLE_SHA256_HASH_SIZE;
+    std::vector<uint8_t> payload(payload_size);
+
+    const psi_key_t *keys = &this->hash_keys[this->hash_keys_cursor];
+    for (size_t i = 0; i < count; i++) {
+        memcpy(&payload[i * SAMPLE_SHA256_HASH_SIZE], keys[i].hash, SAMPLE_SHA256_HASH_SIZE);
+    }
+
+    this->hash_keys_cursor += count;
 
     uint8_t aes_gcm_iv[SAMPLE_SP_IV_SIZE] = {0};
     sample_aes_gcm_128bit_tag_t out_mac = {0};
+    string *enc_data = data->mutable_data();
+    enc_data->resize(payload_size);
 
     ret = sample_rijndael128GCM_encrypt(&g_sp_db.sk_key,
-                                        payload,
+                                        payload.data(),
                                         payload_size,
-                                        enc_data,
+                                        (uint8_t*)&(*enc_data)[0],
                                         &aes_gcm_iv[0],
                                         SAMPLE_SP_IV_SIZE,
                                         NULL,
                                         0,
                                         &out_mac);
 
-    if (ret == -1) {
+    if (ret != SAMPLE_SUCCESS) {
         Log("sample_rijndael128GCM_encrypt failed");
         return -1;
     }
@@ -721,10 +835,6 @@ int PSIWorker::sp_psi_get_data_hash(Messages::MessagePsiHashData *data) {
         data->add_mac(out_mac[i]);
     }
 
-    for (int i = 0; i < payload_size; i++) {
-        data->add_data((uint32_t)enc_data[i]);
-    }
-
     return 0;
 }
 
@@ -771,11 +881,13 @@ int PSIWorker::sp_psi_intersect(Messages::MessagePsiIntersect msg) {
     // }
 
     int hash_cnt = 0;
-    for (int i = 0; i < data_size && i < this->hash_vector.size(); i++) {
+    for (int i = 0; i < data_size && i < this->hash_keys.size(); i++) {
         if (dec_data[i]) {
             hash_cnt++;
-            string hash_str = this->hash_vector[i];
-            Log("[PSI] Intersect result: %s", this->data_map[hash_str]);
+            const char *line = this->hash_file + this->hash_keys[i].line;
+            const char *end = (const char*)memchr(line, '\n', this->hash_file + this->hash_file_size - line);
+            size_t len = end ? end - line : this->hash_file + this->hash_file_size - line;
+            Log("[PSI] Intersect result: %s", string(line, len));
         }
     }
 
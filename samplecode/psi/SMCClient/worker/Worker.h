@@ -30,6 +30,7 @@
 #include <map>
 #include <vector>
 #include <algorithm>    // std::sort
+#include <thread>
 
 #include "Messages.pb.h"
 #include "UtilityFunctions.h"
@@ -70,6 +71,12 @@ typedef struct _sp_db_item_t {
     sgx_ps_sec_prop_desc_t   ps_sec_prop;
 } sp_db_item_t;
 
+// A salted hash of an input line and where the line starts in the input.
+typedef struct _psi_key_t {
+    sample_sha256_hash_t        hash;
+    uint64_t                    line;
+} psi_key_t;
+
 class PSIWorker {
 
 public:
@@ -89,6 +96,9 @@ public:
     int sp_psi_intersect(Messages::MessagePsiIntersect msg);
 
 private:
+    int sp_psi_load_data();
+    void sp_psi_unload_data();
+
     WebService *ws = NULL;
     bool g_is_sp_registered = false;
     uint32_t extended_epid_group_id;
@@ -99,9 +109,10 @@ private:
     string psi_salt;
     string hash_path;
 
-    std::vector<string> hash_vector;
-    std::map<string, string> data_map;
-    uint32_t hash_vector_cursor;
+    const char *hash_file = NULL;
+    size_t hash_file_size = 0;
+    std::vector<psi_key_t> hash_keys;
+    size_t hash_keys_cursor = 0;
 };
 
 #endif
@@ -0,0 +1,167 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Fixed-size chunks of records kept encrypted in untrusted memory.
+//!
+//! Every chunk is encrypted with AES-GCM under a key that never leaves the
+//! enclave and a fresh IV on every store. The IV and MAC of the latest
+//! version of each chunk stay inside the enclave, so the host can neither
+//! read a chunk nor replay an old or foreign one.
+
+use sgx_types::*;
+use sgx_tcrypto::{rsgx_rijndael128GCM_decrypt_in_place, rsgx_rijndael128GCM_encrypt_in_place};
+use sgx_trts::libc::ocall;
+use sgx_trts::trts::{rsgx_raw_is_outside_enclave, rsgx_read_rand};
+use std::prelude::v1::*;
+use std::mem;
+use std::ptr;
+use std::slice;
+
+use osort::Record;
+
+// A buffer from the untrusted heap, freed when dropped.
+struct UntrustedBuf(*mut u8);
+
+impl UntrustedBuf {
+    fn alloc(size: usize) -> SgxResult<UntrustedBuf> {
+        let data = unsafe { ocall::malloc(size) } as *mut u8;
+        if data.is_null() {
+            return Err(sgx_status_t::SGX_ERROR_OUT_OF_MEMORY);
+        }
+        let buf = UntrustedBuf(data);
+        if !rsgx_raw_is_outside_enclave(data, size) {
+            return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+        }
+        Ok(buf)
+    }
+}
+
+impl Drop for UntrustedBuf {
+    fn drop(&mut self) {
+        unsafe { ocall::free(self.0 as *mut c_void) };
+    }
+}
+
+struct Chunk {
+    data: UntrustedBuf,
+    iv: [u8; SGX_AESGCM_IV_SIZE],
+    mac: sgx_aes_gcm_128bit_tag_t,
+}
+
+pub struct SealedChunks {
+    key: sgx_aes_gcm_128bit_key_t,
+    chunk_records: usize,
+    chunks: Vec<Chunk>,
+    stores: u64,
+}
+
+// The untrusted buffers are owned by the store and only touched through
+// `&mut self` or copied from under `&self`.
+unsafe impl Send for SealedChunks {}
+
+impl SealedChunks {
+    /// Creates an empty store of chunks holding `chunk_records` records each.
+    pub fn new(chunk_records: usize) -> SgxResult<SealedChunks> {
+        let bytes = chunk_records.checked_mul(mem::size_of::<Record>());
+        match bytes {
+            Some(n) if chunk_records > 0 && n <= u32::max_value() as usize => {}
+            _ => return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER),
+        }
+
+        let mut key = sgx_aes_gcm_128bit_key_t::default();
+        rsgx_read_rand(&mut key)?;
+        Ok(SealedChunks {
+            key,
+            chunk_records,
+            chunks: Vec::new(),
+            stores: 0,
+        })
+    }
+
+    pub fn len(&self) -> usize {
+        self.chunks.len()
+    }
+
+    pub fn chunk_records(&self) -> usize {
+        self.chunk_records
+    }
+
+    /// Appends `records` as a new chunk. Leaves `records` encrypted.
+    pub fn push(&mut self, records: &mut [Record]) -> SgxError {
+        let data = UntrustedBuf::alloc(self.chunk_size())?;
+        self.chunks.push(Chunk {
+            data,
+            iv: [0; SGX_AESGCM_IV_SIZE],
+            mac: sgx_aes_gcm_128bit_tag_t::default(),
+        });
+        let index = self.chunks.len() - 1;
+        self.store(index, records)
+    }
+
+    /// Replaces chunk `index` with `records`. Leaves `records` encrypted.
+    pub fn store(&mut self, index: usize, records: &mut [Record]) -> SgxError {
+        if index >= self.chunks.len() || records.len() != self.chunk_records {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+
+        let mut iv = [0_u8; SGX_AESGCM_IV_SIZE];
+        iv[..8].copy_from_slice(&self.stores.to_le_bytes());
+        self.stores += 1;
+
+        let bytes = as_bytes_mut(records);
+        let chunk = &mut self.chunks[index];
+        rsgx_rijndael128GCM_encrypt_in_place(&self.key, bytes, &iv, &[], &mut chunk.mac)?;
+        unsafe { ptr::copy_nonoverlapping(bytes.as_ptr(), chunk.data.0, bytes.len()) };
+        chunk.iv = iv;
+        Ok(())
+    }
+
+    /// Decrypts chunk `index` into `records`.
+    pub fn load(&self, index: usize, records: &mut [Record]) -> SgxError {
+        if index >= self.chunks.len() || records.len() != self.chunk_records {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+
+        // The chunk is copied in first, so the host cannot change it while
+        // it is authenticated and decrypted.
+        let bytes = as_bytes_mut(records);
+        let chunk = &self.chunks[index];
+        unsafe { ptr::copy_nonoverlapping(chunk.data.0, bytes.as_mut_ptr(), bytes.len()) };
+        rsgx_rijndael128GCM_decrypt_in_place(&self.key, bytes, &chunk.iv, &[], &chunk.mac)
+    }
+
+    fn chunk_size(&self) -> usize {
+        self.chunk_records * mem::size_of::<Record>()
+    }
+}
+
+impl Drop for SealedChunks {
+    fn drop(&mut self) {
+        for b in self.key.iter_mut() {
+            unsafe { ptr::write_volatile(b, 0) };
+        }
+    }
+}
+
+fn as_bytes_mut(records: &mut [Record]) -> &mut [u8] {
+    unsafe {
+        slice::from_raw_parts_mut(
+            records.as_mut_ptr() as *mut u8,
+            records.len() * mem::size_of::<Record>(),
+        )
+    }
+}
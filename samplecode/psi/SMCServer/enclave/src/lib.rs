@@ -20,7 +20,6 @@
 
 #![cfg_attr(not(target_env = "sgx"), no_std)]
 #![cfg_attr(target_env = "sgx", feature(rustc_private))]
-#![feature(asm)]
 #![allow(dead_code)]
 #![allow(unused_variables)]
 
@@ -34,6 +33,10 @@ extern crate sgx_tcrypto;
 extern crate sgx_tkey_exchange;
 extern crate sgx_rand;
 
+mod chunks;
+mod osort;
+mod psi;
+
 use sgx_types::*;
 use sgx_trts::memeq::ConsttimeMemEq;
 use sgx_tcrypto::*;
@@ -41,9 +44,13 @@ use sgx_tkey_exchange::*;
 use sgx_rand::{Rng, StdRng};
 use std::slice;
 use std::vec::Vec;
-use std::cell::RefCell;
+use std::sync::{SgxMutex, SgxMutexGuard};
 use std::sync::atomic::{AtomicPtr, Ordering};
 use std::boxed::Box;
+use std::mem;
+use std::thread::pool::{ThreadPool, ThreadPoolBuilder};
+
+use psi::PsiEngine;
 
 const G_SP_PUB_KEY: sgx_ec256_public_t = sgx_ec256_public_t {
     gx : [0x72, 0x12, 0x8a, 0x7a, 0x17, 0x52, 0x6e, 0xbf,
@@ -61,16 +68,18 @@ const CLIENT_MAX_NUMBER: usize = 2;
 const HASH_DATA_FINISH: u32 = 1;
 const RESULT_FINISH: u32 = 2;
 
-#[derive(Clone, Default)]
+#[derive(Default)]
 struct SetIntersection {
     salt: [u8; SGX_SALT_SIZE],
     data: [HashDataBuffer; CLIENT_MAX_NUMBER],
     number: u32,
+    engine: PsiEngine,
+    pool: Option<ThreadPool>,
+    bench: [Vec<u8>; CLIENT_MAX_NUMBER],
 }
 
 #[derive(Clone, Default)]
 struct HashDataBuffer {
-    hashdata: Vec<[u8; SGX_HASH_SIZE]>,
     result: Vec<u8>,
     state: u32,
 }
@@ -83,14 +92,16 @@ impl SetIntersection {
 
 static GLOBAL_HASH_BUFFER: AtomicPtr<()> = AtomicPtr::new(0 as * mut ());
 
-fn get_ref_hash_buffer() -> Option<&'static RefCell<SetIntersection>>
+// The host may call into the enclave from several threads at once, so
+// every ECALL takes the lock for as long as it uses the state.
+fn lock_hash_buffer() -> SgxResult<SgxMutexGuard<'static, SetIntersection>>
 {
-    let ptr = GLOBAL_HASH_BUFFER.load(Ordering::SeqCst) as * mut RefCell<SetIntersection>;
+    let ptr = GLOBAL_HASH_BUFFER.load(Ordering::SeqCst) as * mut SgxMutex<SetIntersection>;
     if ptr.is_null() {
-        None
-    } else {
-        Some(unsafe { &* ptr })
+        return Err(sgx_status_t::SGX_ERROR_INVALID_STATE);
     }
+    let mutex: &'static SgxMutex<SetIntersection> = unsafe { &* ptr };
+    mutex.lock().map_err(|_| sgx_status_t::SGX_ERROR_UNEXPECTED)
 }
 
 
@@ -104,8 +115,10 @@ fn initialize() -> sgx_status_t {
         Err(_) => { return sgx_status_t::SGX_ERROR_UNEXPECTED; },
     };
     rand.fill_bytes(&mut data.salt);
+    // Without a pool the intersection runs on the calling thread.
+    data.pool = ThreadPoolBuilder::new().build().ok();
 
-    let data_box = Box::new(RefCell::<SetIntersection>::new(data));
+    let data_box = Box::new(SgxMutex::<SetIntersection>::new(data));
     let ptr = Box::into_raw(data_box);
     GLOBAL_HASH_BUFFER.store(ptr as *mut (), Ordering::SeqCst);
 
@@ -116,7 +129,7 @@ fn initialize() -> sgx_status_t {
 pub extern "C"
 fn uninitialize() {
 
-    let ptr = GLOBAL_HASH_BUFFER.swap(0 as * mut (), Ordering::SeqCst) as * mut RefCell<SetIntersection>;
+    let ptr = GLOBAL_HASH_BUFFER.swap(0 as * mut (), Ordering::SeqCst) as * mut SgxMutex<SetIntersection>;
     if ptr.is_null() {
        return;
     }
@@ -196,7 +209,10 @@ fn verify_secret_data(context: sgx_ra_context_t,
                       salt_mac: &mut [u8; SGX_MAC_SIZE],
                       id: &mut u32) -> sgx_status_t {
 
-    let mut data = get_ref_hash_buffer().unwrap().borrow_mut();
+    let mut data = match lock_hash_buffer() {
+        Ok(data) => data,
+        Err(x) => return x,
+    };
     if data.number < CLIENT_MAX_NUMBER as u32 {
         data.number +=1;
     } else {
@@ -296,16 +312,15 @@ fn add_hash_data(id: u32,
         Err(x) => return x,
     };
 
-    let mut intersection = get_ref_hash_buffer().unwrap().borrow_mut();
-    let buffer = &mut intersection.data[id as usize - 1].hashdata;
-
-    for i in 0_usize..(hash_size/SGX_HASH_SIZE) {
-        let mut hash = [0_u8; SGX_HASH_SIZE];
-        hash.copy_from_slice(&decrypted[i*SGX_HASH_SIZE..(i + 1)*SGX_HASH_SIZE]);
-        buffer.push(hash);
+    let mut intersection = match lock_hash_buffer() {
+        Ok(intersection) => intersection,
+        Err(x) => return x,
+    };
+    let len = hash_size / SGX_HASH_SIZE * SGX_HASH_SIZE;
+    match intersection.engine.add(id as usize - 1, &decrypted[..len]) {
+        Ok(()) => sgx_status_t::SGX_SUCCESS,
+        Err(x) => x,
     }
-
-    sgx_status_t::SGX_SUCCESS
 }
 
 #[no_mangle]
@@ -323,7 +338,10 @@ fn get_result_size(id: u32, len: &mut usize) -> sgx_status_t {
         0
     };
 
-    let mut intersection = get_ref_hash_buffer().unwrap().borrow_mut();
+    let mut intersection = match lock_hash_buffer() {
+        Ok(intersection) => intersection,
+        Err(x) => return x,
+    };
 
     if intersection.data[cid].state == 0 {
         intersection.data[cid].state = HASH_DATA_FINISH;
@@ -336,16 +354,14 @@ fn get_result_size(id: u32, len: &mut usize) -> sgx_status_t {
         return sgx_status_t::SGX_ERROR_INVALID_STATE;
     } else if (state1 == HASH_DATA_FINISH) && (state2 == HASH_DATA_FINISH) {
 
-        let mut v_cid: Vec<u8> = vec![0; intersection.data[cid].hashdata.len()];
-        let mut v_other: Vec<u8> = vec![0; intersection.data[other].hashdata.len()];
-
-        oget_intersection(&intersection.data[cid].hashdata,
-                          &intersection.data[other].hashdata,
-                          &mut v_cid,
-                          &mut v_other);
+        let engine = mem::replace(&mut intersection.engine, PsiEngine::new());
+        let [v_first, v_second] = match run_intersection(&intersection.pool, engine) {
+            Ok(results) => results,
+            Err(x) => return x,
+        };
 
-        intersection.data[cid].result = v_cid;
-        intersection.data[other].result = v_other;
+        intersection.data[0].result = v_first;
+        intersection.data[1].result = v_second;
         intersection.data[cid].state = RESULT_FINISH;
         intersection.data[other].state = RESULT_FINISH;
         intersection.data[cid].result.len()
@@ -383,7 +399,10 @@ fn get_result(id: u32,
         Err(x) => return x,
     };
 
-    let mut intersection = get_ref_hash_buffer().unwrap().borrow_mut();
+    let mut intersection = match lock_hash_buffer() {
+        Ok(intersection) => intersection,
+        Err(x) => return x,
+    };
 
     let state1 = intersection.data[cid].state;
     let state2 = intersection.data[other].state;
@@ -418,7 +437,6 @@ fn get_result(id: u32,
     intersection.number -= 1;
     if intersection.number == 0 {
         for i in 0..CLIENT_MAX_NUMBER {
-            intersection.data[i].hashdata = Vec::new();
             intersection.data[i].result = Vec::new();
             intersection.data[i].state = 0;
         }
@@ -427,164 +445,72 @@ fn get_result(id: u32,
     sgx_status_t::SGX_SUCCESS
 }
 
-fn oget_intersection(a: &Vec<[u8; SGX_HASH_SIZE]>, b: &Vec<[u8; SGX_HASH_SIZE]>, v1: &mut Vec<u8>, v2: &mut Vec<u8>) {
-
-    let n = a.len();
-    for i in 0..n {
-        let ret = obinary_search(b, &a[i], v2);
-        let miss = oequal(usize::max_value(), ret as usize);
-        v1[i] = omov(miss as isize, 0, 1) as u8;
-    }
-}
-
-fn obinary_search(b: &Vec<[u8; SGX_HASH_SIZE]>, target: &[u8; SGX_HASH_SIZE], v2: &mut Vec<u8>) -> isize {
-
-    let mut lo: isize = 0;
-    let mut hi: isize = b.len() as isize - 1;
-    let mut ret: isize = -1;
-
-    while lo <= hi {
-        let mid = lo + (hi - lo) / 2;
-        let hit = eq(&b[mid as usize], target);
-        ret = omov(hit, mid, ret);
-        v2[mid as usize] = omov(hit, 1, v2[mid as usize] as isize) as u8;
-        let be = le(&b[mid as usize], target);
-        lo = omov(be, mid + 1, lo);
-        hi = omov(be, hi, mid - 1);
-    }
-    ret
-}
-
-fn eq(a: &[u8; SGX_HASH_SIZE], b: &[u8; SGX_HASH_SIZE]) -> isize {
-
-    let mut ret: isize = 1;
-    for i in 0..SGX_HASH_SIZE {
-        let hit = oequal(a[i] as usize, b[i] as usize);
-        ret = omov(hit as isize, ret, 0);
-    }
-    ret
-}
-
-fn le(a: &[u8; SGX_HASH_SIZE], b: &[u8; SGX_HASH_SIZE]) -> isize {
-
-    let mut ret: isize = 0;
-    for i in 0..SGX_HASH_SIZE {
-
-        let hit = oequal(a[i] as usize, b[i] as usize);
-        let be = ob(a[i] as usize, b[i] as usize);
-        let cmp = omov(hit as isize, 0, omov(be as isize, -1, 1));
-        ret = omov(ret, ret, cmp)
+fn run_intersection(pool: &Option<ThreadPool>, engine: PsiEngine) -> SgxResult<[Vec<u8>; CLIENT_MAX_NUMBER]> {
+    match *pool {
+        Some(ref pool) => pool.install(move || engine.intersect()),
+        None => engine.intersect(),
     }
-    (ret <= 0) as isize
 }
 
-fn ge(a: &[u8; SGX_HASH_SIZE], b: &[u8; SGX_HASH_SIZE]) -> isize {
-
-    let mut ret: isize = 0;
-    for i in 0..SGX_HASH_SIZE {
-
-        let hit = oequal(a[i] as usize, b[i] as usize);
-        let ae = oa(a[i] as usize, b[i] as usize);
-        let cmp = omov(hit as isize, 0, omov(ae as isize, 1, -1));
-        ret = omov(ret, ret, cmp)
-    }
-    (ret >= 0) as isize
-}
+/// Generates `count` random hashes per client, half of them shared, for
+/// `bench_intersection`. Returns the number of pool threads.
+#[no_mangle]
+pub extern "C"
+fn bench_prepare(count: u64, threads: &mut u32) -> sgx_status_t {
 
-fn oequal(x: usize, y: usize) -> bool {
-
-    let ret: bool;
-    unsafe {
-        asm!(
-            "cmp %rcx, %rdx \n\t
-             sete %al \n\t"
-            : "={al}"(ret)
-            : "{rcx}"(x), "{rdx}" (y)
-            : "rcx", "rdx"
-            : "volatile"
-        );
-    }
-    ret
-}
+    let mut rand = match StdRng::new() {
+        Ok(rng) => rng,
+        Err(_) => { return sgx_status_t::SGX_ERROR_UNEXPECTED; },
+    };
 
-fn obe(x: usize, y: usize) -> bool {
-
-    let ret: bool;
-    unsafe {
-        asm!(
-            "cmp %rdx, %rcx \n\t
-             setbe %al \n\t"
-            : "={al}"(ret)
-            : "{rcx}"(x), "{rdx}" (y)
-            : "rcx", "rdx"
-            : "volatile"
-        );
+    let len = count as usize * SGX_HASH_SIZE;
+    let mut first = vec![0_u8; len];
+    let mut second = vec![0_u8; len];
+    rand.fill_bytes(&mut first);
+    rand.fill_bytes(&mut second);
+    for (to, from) in second.chunks_mut(SGX_HASH_SIZE).zip(first.chunks(2 * SGX_HASH_SIZE)) {
+        to.copy_from_slice(&from[..SGX_HASH_SIZE]);
     }
-    ret
-}
 
-fn ob(x: usize, y: usize) -> bool {
-
-    let ret: bool;
-    unsafe {
-        asm!(
-            "cmp %rdx, %rcx \n\t
-             setb %al \n\t"
-            : "={al}"(ret)
-            : "{rcx}"(x), "{rdx}" (y)
-            : "rcx", "rdx"
-            : "volatile"
-        );
-    }
-    ret
+    let mut intersection = match lock_hash_buffer() {
+        Ok(intersection) => intersection,
+        Err(x) => return x,
+    };
+    intersection.bench = [first, second];
+    *threads = match intersection.pool {
+        Some(ref pool) => pool.current_num_threads() as u32,
+        None => 1,
+    };
+    sgx_status_t::SGX_SUCCESS
 }
 
-fn oae(x: usize, y: usize) -> bool {
-
-    let ret: bool;
-    unsafe {
-        asm!(
-            "cmp %rdx, %rcx \n\t
-             setae %al \n\t"
-            : "={al}"(ret)
-            : "{rcx}"(x), "{rdx}" (y)
-            : "rcx", "rdx"
-            : "volatile"
-        );
-    }
-    ret
-}
+/// Intersects the hashes from `bench_prepare` keeping at most
+/// `resident_limit` bytes of records in the enclave, or the default limit
+/// if it is 0.
+#[no_mangle]
+pub extern "C"
+fn bench_intersection(resident_limit: usize, matches: &mut u64) -> sgx_status_t {
 
-fn oa(x: usize, y: usize) -> bool {
-
-    let ret: bool;
-    unsafe {
-        asm!(
-            "cmp %rdx, %rcx \n\t
-             seta %al \n\t"
-            : "={al}"(ret)
-            : "{rcx}"(x), "{rdx}" (y)
-            : "rcx", "rdx"
-            : "volatile"
-        );
+    let intersection = match lock_hash_buffer() {
+        Ok(intersection) => intersection,
+        Err(x) => return x,
+    };
+    let mut engine = if resident_limit == 0 {
+        PsiEngine::new()
+    } else {
+        PsiEngine::with_resident_limit(resident_limit)
+    };
+    for (client, hashes) in intersection.bench.iter().enumerate() {
+        if let Err(x) = engine.add(client, hashes) {
+            return x;
+        }
     }
-    ret
-}
 
-fn omov(flag: isize, x: isize, y: isize) -> isize {
-
-    let ret: isize;
-    unsafe {
-        asm!(
-            "xor %rcx, %rcx \n\t
-             mov $1, %rcx \n\t
-             test %rcx, %rcx \n\t
-             cmovz %rdx, %rax \n\t"
-            : "={rax}"(ret)
-            : "r"(flag), "{rax}" (x), "{rdx}" (y)
-            : "rax", "rcx", "rdx"
-            : "volatile"
-        );
+    match run_intersection(&intersection.pool, engine) {
+        Ok(results) => {
+            *matches = results[0].iter().map(|&flag| flag as u64).sum();
+            sgx_status_t::SGX_SUCCESS
+        },
+        Err(x) => x,
     }
-    ret
 }
@@ -0,0 +1,213 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Oblivious sorting of PSI records.
+//!
+//! The sort is a bitonic network for arbitrary lengths: which records are
+//! compared depends only on how many there are, and every compare-and-swap
+//! runs the same instructions whether it swaps or not. Hashes are compared
+//! 16 bytes at a time with SSE2 and records are swapped under a mask, so
+//! neither branches nor memory accesses depend on the data.
+//!
+//! The comparators of one merge step are independent, as are the two halves
+//! of every recursion, so large slices are split with `join` and spread over
+//! the thread pool the caller runs in.
+
+use core::arch::x86_64::*;
+use std::thread::pool::join;
+
+pub const HASH_SIZE: usize = 32;
+
+/// Records below this count are sorted without splitting off jobs.
+const PAR_MIN: usize = 1 << 12;
+
+/// A hash with the client and position it came from.
+#[derive(Clone, Copy)]
+#[repr(C, align(16))]
+pub struct Record {
+    pub hash: [u8; HASH_SIZE],
+    /// `client << POS_CLIENT_SHIFT | index`, or `u64::MAX` for padding.
+    pub pos: u64,
+    /// Bit `c` is set once client `c` is known to hold `hash`.
+    pub owners: u64,
+}
+
+pub const POS_CLIENT_SHIFT: u32 = 40;
+
+/// Padding, which sorts after every real record in both orders.
+pub const DUMMY: Record = Record {
+    hash: [0xff; HASH_SIZE],
+    pos: u64::max_value(),
+    owners: 0,
+};
+
+impl Record {
+    pub fn new(client: usize, index: u64, hash: &[u8]) -> Record {
+        let mut record = Record {
+            hash: [0; HASH_SIZE],
+            pos: (client as u64) << POS_CLIENT_SHIFT | index,
+            owners: 1 << client,
+        };
+        record.hash.copy_from_slice(hash);
+        record
+    }
+}
+
+/// A sort order evaluated without branching on the records.
+pub trait Order {
+    /// Returns 1 if `a` sorts before `b` and 0 otherwise.
+    fn less(a: &Record, b: &Record) -> u64;
+}
+
+/// Orders by hash, then position.
+pub struct ByHash;
+
+/// Orders by position, which puts every client's records back in the order
+/// they arrived, client by client, with the padding last.
+pub struct ByPos;
+
+impl Order for ByHash {
+    #[inline(always)]
+    fn less(a: &Record, b: &Record) -> u64 {
+        let (lt, eq) = cmp_hash(&a.hash, &b.hash);
+        lt | (eq & ct_lt(a.pos, b.pos))
+    }
+}
+
+impl Order for ByPos {
+    #[inline(always)]
+    fn less(a: &Record, b: &Record) -> u64 {
+        ct_lt(a.pos, b.pos)
+    }
+}
+
+/// Returns 1 if `x < y` and 0 otherwise.
+#[inline(always)]
+pub fn ct_lt(x: u64, y: u64) -> u64 {
+    let z = x.wrapping_sub(y);
+    (z ^ ((x ^ y) & (y ^ z))) >> 63
+}
+
+/// Compares two hashes as big-endian numbers. Returns `(a < b, a == b)` as
+/// 0 or 1 each.
+#[inline(always)]
+pub fn cmp_hash(a: &[u8; HASH_SIZE], b: &[u8; HASH_SIZE]) -> (u64, u64) {
+    unsafe {
+        // Flipping the top bit turns the signed byte compares into
+        // unsigned ones.
+        let flip = _mm_set1_epi8(-128);
+        let pa = a.as_ptr() as *const __m128i;
+        let pb = b.as_ptr() as *const __m128i;
+        let a0 = _mm_xor_si128(_mm_loadu_si128(pa), flip);
+        let a1 = _mm_xor_si128(_mm_loadu_si128(pa.add(1)), flip);
+        let b0 = _mm_xor_si128(_mm_loadu_si128(pb), flip);
+        let b1 = _mm_xor_si128(_mm_loadu_si128(pb.add(1)), flip);
+        let lt = (_mm_movemask_epi8(_mm_cmplt_epi8(a0, b0)) as u32 as u64)
+            | ((_mm_movemask_epi8(_mm_cmplt_epi8(a1, b1)) as u32 as u64) << 16);
+        let gt = (_mm_movemask_epi8(_mm_cmpgt_epi8(a0, b0)) as u32 as u64)
+            | ((_mm_movemask_epi8(_mm_cmpgt_epi8(a1, b1)) as u32 as u64) << 16);
+        // Bit i stands for byte i, so the lowest differing bit is the most
+        // significant differing byte.
+        let diff = lt | gt;
+        let first = diff & diff.wrapping_neg();
+        let less = (lt & first).wrapping_neg() >> 63;
+        let equal = diff.wrapping_sub(1) >> 63;
+        (less, equal)
+    }
+}
+
+/// Swaps `a` and `b` if `swap` is 1, and leaves them if it is 0.
+#[inline(always)]
+pub fn cswap(a: &mut Record, b: &mut Record, swap: u64) {
+    unsafe {
+        let mask = _mm_set1_epi64x(swap.wrapping_neg() as i64);
+        let pa = a as *mut Record as *mut __m128i;
+        let pb = b as *mut Record as *mut __m128i;
+        for i in 0..3 {
+            let x = _mm_load_si128(pa.add(i));
+            let y = _mm_load_si128(pb.add(i));
+            let d = _mm_and_si128(_mm_xor_si128(x, y), mask);
+            _mm_store_si128(pa.add(i), _mm_xor_si128(x, d));
+            _mm_store_si128(pb.add(i), _mm_xor_si128(y, d));
+        }
+    }
+}
+
+#[inline(always)]
+fn compare_exchange<O: Order>(a: &mut Record, b: &mut Record, up: bool) {
+    let swap = if up { O::less(b, a) } else { O::less(a, b) };
+    cswap(a, b, swap);
+}
+
+/// Sorts `records` in ascending order.
+pub fn sort<O: Order>(records: &mut [Record]) {
+    sort_dir::<O>(records, true);
+}
+
+/// Sorts a slice whose first half is sorted descending and whose second
+/// half is sorted ascending, as two sorted runs are merged.
+pub fn merge<O: Order>(records: &mut [Record]) {
+    merge_dir::<O>(records, true);
+}
+
+fn sort_dir<O: Order>(records: &mut [Record], up: bool) {
+    let n = records.len();
+    if n < 2 {
+        return;
+    }
+    let (lo, hi) = records.split_at_mut(n / 2);
+    if n > PAR_MIN {
+        join(|| sort_dir::<O>(lo, !up), || sort_dir::<O>(hi, up));
+    } else {
+        sort_dir::<O>(lo, !up);
+        sort_dir::<O>(hi, up);
+    }
+    merge_dir::<O>(records, up);
+}
+
+fn merge_dir<O: Order>(records: &mut [Record], up: bool) {
+    let n = records.len();
+    if n < 2 {
+        return;
+    }
+    // The largest power of two below n.
+    let m = 1 << (63 - (n as u64 - 1).leading_zeros());
+    let (lo, hi) = records.split_at_mut(m);
+    compare_range::<O>(&mut lo[..n - m], &mut hi[..n - m], up);
+    if n > PAR_MIN {
+        join(|| merge_dir::<O>(lo, up), || merge_dir::<O>(hi, up));
+    } else {
+        merge_dir::<O>(lo, up);
+        merge_dir::<O>(hi, up);
+    }
+}
+
+fn compare_range<O: Order>(lo: &mut [Record], hi: &mut [Record], up: bool) {
+    let n = lo.len();
+    if n > PAR_MIN {
+        let (lo_left, lo_right) = lo.split_at_mut(n / 2);
+        let (hi_left, hi_right) = hi.split_at_mut(n / 2);
+        join(
+            || compare_range::<O>(lo_left, hi_left, up),
+            || compare_range::<O>(lo_right, hi_right, up),
+        );
+        return;
+    }
+    for (a, b) in lo.iter_mut().zip(hi.iter_mut()) {
+        compare_exchange::<O>(a, b, up);
+    }
+}
@@ -0,0 +1,298 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Oblivious sort-and-scan private set intersection.
+//!
+//! The hashes of both clients are tagged with their owner and position and
+//! sorted by hash, which puts equal hashes next to each other. A forward
+//! and a backward scan spread the owners through every run of equal
+//! hashes, so each record learns whether both clients hold its hash. A
+//! second sort by position puts the records back in the order the clients
+//! sent them, and the flags are read off in that order.
+//!
+//! Sorts and scans touch memory in an order fixed by the number of records
+//! only. Inputs larger than the resident limit are spilled to sealed chunks
+//! in untrusted memory and sorted there: every chunk is sorted on its own,
+//! then a bitonic network over the chunks merges them pairwise, two chunks
+//! in enclave memory at a time.
+
+use sgx_types::*;
+use std::prelude::v1::*;
+use std::mem;
+
+use chunks::SealedChunks;
+use osort::{self, ByHash, ByPos, Order, Record, DUMMY, HASH_SIZE, POS_CLIENT_SHIFT};
+
+pub const CLIENTS: usize = 2;
+
+/// Enclave memory the records may take before they are spilled.
+pub const DEFAULT_RESIDENT_LIMIT: usize = 64 * 1024 * 1024;
+
+const MATCHED: u64 = (1 << CLIENTS) - 1;
+
+pub struct PsiEngine {
+    chunk_records: usize,
+    records: Vec<Record>,
+    chunks: Option<SealedChunks>,
+    counts: [u64; CLIENTS],
+}
+
+impl Default for PsiEngine {
+    fn default() -> PsiEngine {
+        PsiEngine::new()
+    }
+}
+
+impl PsiEngine {
+    pub fn new() -> PsiEngine {
+        PsiEngine::with_resident_limit(DEFAULT_RESIDENT_LIMIT)
+    }
+
+    /// Creates an engine keeping at most about `bytes` of records in
+    /// enclave memory. Spilled chunks take half of that each, as two of
+    /// them are merged at a time.
+    pub fn with_resident_limit(bytes: usize) -> PsiEngine {
+        let chunk_records = bytes / mem::size_of::<Record>() / 2;
+        PsiEngine {
+            chunk_records: if chunk_records > 0 { chunk_records } else { 1 },
+            records: Vec::new(),
+            chunks: None,
+            counts: [0; CLIENTS],
+        }
+    }
+
+    pub fn count(&self, client: usize) -> u64 {
+        self.counts[client]
+    }
+
+    /// Adds the concatenated 32-byte `hashes` of `client`.
+    pub fn add(&mut self, client: usize, hashes: &[u8]) -> SgxError {
+        if client >= CLIENTS || hashes.len() % HASH_SIZE != 0 {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let added = (hashes.len() / HASH_SIZE) as u64;
+        if self.counts[client] + added > 1 << POS_CLIENT_SHIFT {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+
+        for hash in hashes.chunks(HASH_SIZE) {
+            self.spill_full()?;
+            self.records.push(Record::new(client, self.counts[client], hash));
+            self.counts[client] += 1;
+        }
+        Ok(())
+    }
+
+    /// Computes the intersection. Returns one flag per hash and client, in
+    /// the order the hashes were added, set if the other client holds the
+    /// hash as well.
+    pub fn intersect(mut self) -> SgxResult<[Vec<u8>; CLIENTS]> {
+        let chunks = match self.chunks.take() {
+            Some(chunks) => chunks,
+            None => return Ok(self.intersect_resident()),
+        };
+        self.intersect_sealed(chunks)
+    }
+
+    // Spills the records once they fill the enclave memory they may take,
+    // and from then on whenever they fill a chunk.
+    fn spill_full(&mut self) -> SgxError {
+        let chunk_records = self.chunk_records;
+        match self.chunks {
+            None if self.records.len() == 2 * chunk_records => {
+                let mut chunks = SealedChunks::new(chunk_records)?;
+                let (first, second) = self.records.split_at_mut(chunk_records);
+                chunks.push(first)?;
+                chunks.push(second)?;
+                self.chunks = Some(chunks);
+                self.records.clear();
+            }
+            Some(ref mut chunks) if self.records.len() == chunk_records => {
+                chunks.push(&mut self.records)?;
+                self.records.clear();
+            }
+            _ => {}
+        }
+        Ok(())
+    }
+
+    fn intersect_resident(mut self) -> [Vec<u8>; CLIENTS] {
+        let mut results = self.empty_results();
+        let records = &mut self.records;
+        osort::sort::<ByHash>(records);
+        let (mut prev, mut next) = (DUMMY, DUMMY);
+        scan_forward(records, &mut prev);
+        scan_backward(records, &mut next);
+        osort::sort::<ByPos>(records);
+
+        for (i, record) in records.iter().enumerate() {
+            push_flag(&mut results, &self.counts, i as u64, record);
+        }
+        results
+    }
+
+    fn intersect_sealed(mut self, mut chunks: SealedChunks) -> SgxResult<[Vec<u8>; CLIENTS]> {
+        let chunk_records = self.chunk_records;
+        if !self.records.is_empty() {
+            self.records.resize(chunk_records, DUMMY);
+            chunks.push(&mut self.records)?;
+        }
+        let mut buf = mem::replace(&mut self.records, Vec::new());
+        buf.clear();
+        buf.resize(2 * chunk_records, DUMMY);
+
+        sort_sealed::<ByHash>(&mut chunks, &mut buf)?;
+
+        let records = &mut buf[..chunk_records];
+        let mut prev = DUMMY;
+        for index in 0..chunks.len() {
+            chunks.load(index, records)?;
+            scan_forward(records, &mut prev);
+            chunks.store(index, records)?;
+        }
+        let mut next = DUMMY;
+        for index in (0..chunks.len()).rev() {
+            chunks.load(index, records)?;
+            scan_backward(records, &mut next);
+            chunks.store(index, records)?;
+        }
+
+        sort_sealed::<ByPos>(&mut chunks, &mut buf)?;
+
+        let mut results = self.empty_results();
+        let records = &mut buf[..chunk_records];
+        let mut i = 0;
+        for index in 0..chunks.len() {
+            chunks.load(index, records)?;
+            for record in records.iter() {
+                push_flag(&mut results, &self.counts, i, record);
+                i += 1;
+            }
+        }
+        Ok(results)
+    }
+
+    fn empty_results(&self) -> [Vec<u8>; CLIENTS] {
+        [
+            Vec::with_capacity(self.counts[0] as usize),
+            Vec::with_capacity(self.counts[1] as usize),
+        ]
+    }
+}
+
+// Records sorted by position come client by client, padding last.
+fn push_flag(results: &mut [Vec<u8>; CLIENTS], counts: &[u64; CLIENTS], i: u64, record: &Record) {
+    if i < counts[0] {
+        results[0].push(record.owners as u8);
+    } else if i < counts[0] + counts[1] {
+        results[1].push(record.owners as u8);
+    }
+}
+
+/// Ors the owners of each record into the next one if it has the same
+/// hash. `prev` carries the last record over to the next call.
+fn scan_forward(records: &mut [Record], prev: &mut Record) {
+    for record in records.iter_mut() {
+        let (_, eq) = osort::cmp_hash(&record.hash, &prev.hash);
+        record.owners |= prev.owners & eq.wrapping_neg();
+        *prev = *record;
+    }
+}
+
+/// Ors the owners of each record into the previous one if it has the same
+/// hash, after which every record holds the owners of its whole run, and
+/// replaces them with 1 if that is every client and 0 otherwise. `next`
+/// carries the first record over to the next call.
+fn scan_backward(records: &mut [Record], next: &mut Record) {
+    for record in records.iter_mut().rev() {
+        let (_, eq) = osort::cmp_hash(&record.hash, &next.hash);
+        record.owners |= next.owners & eq.wrapping_neg();
+        *next = *record;
+        record.owners = (record.owners ^ MATCHED).wrapping_sub(1) >> 63;
+    }
+}
+
+/// Sorts the records of all chunks. `buf` holds two chunks.
+fn sort_sealed<O: Order>(chunks: &mut SealedChunks, buf: &mut [Record]) -> SgxError {
+    let chunk_records = chunks.chunk_records();
+    let records = &mut buf[..chunk_records];
+    for index in 0..chunks.len() {
+        chunks.load(index, records)?;
+        osort::sort::<O>(records);
+        chunks.store(index, records)?;
+    }
+    let n = chunks.len();
+    sort_chunks::<O>(chunks, buf, 0, n, true)
+}
+
+// The bitonic network of `osort`, over chunks, with merge-split in place of
+// compare-exchange.
+fn sort_chunks<O: Order>(
+    chunks: &mut SealedChunks,
+    buf: &mut [Record],
+    lo: usize,
+    n: usize,
+    up: bool,
+) -> SgxError {
+    if n < 2 {
+        return Ok(());
+    }
+    let m = n / 2;
+    sort_chunks::<O>(chunks, buf, lo, m, !up)?;
+    sort_chunks::<O>(chunks, buf, lo + m, n - m, up)?;
+    merge_chunks::<O>(chunks, buf, lo, n, up)
+}
+
+fn merge_chunks<O: Order>(
+    chunks: &mut SealedChunks,
+    buf: &mut [Record],
+    lo: usize,
+    n: usize,
+    up: bool,
+) -> SgxError {
+    if n < 2 {
+        return Ok(());
+    }
+    let m = 1 << (63 - (n as u64 - 1).leading_zeros());
+    for i in lo..lo + n - m {
+        merge_split::<O>(chunks, buf, i, i + m, up)?;
+    }
+    merge_chunks::<O>(chunks, buf, lo, m, up)?;
+    merge_chunks::<O>(chunks, buf, lo + m, n - m, up)
+}
+
+// Merges two sorted chunks and leaves the lower half in `a` and the upper
+// in `b`, or the other way round if `up` is false.
+fn merge_split<O: Order>(
+    chunks: &mut SealedChunks,
+    buf: &mut [Record],
+    a: usize,
+    b: usize,
+    up: bool,
+) -> SgxError {
+    let chunk_records = chunks.chunk_records();
+    let (low, high) = buf.split_at_mut(chunk_records);
+    chunks.load(a, low)?;
+    chunks.load(b, high)?;
+    low.reverse();
+    osort::merge::<O>(buf);
+
+    let (low, high) = buf.split_at_mut(chunk_records);
+    let (to_a, to_b) = if up { (low, high) } else { (high, low) };
+    chunks.store(a, to_a)?;
+    chunks.store(b, to_b)
+}
@@ -15,6 +15,9 @@
 // specific language governing permissions and limitations
 // under the License..
 
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <unistd.h>
 
@@ -23,9 +26,63 @@
 
 using namespace util;
 
+// Intersects 2^14 up to 2^max_log2 random hashes per client, once with the
+// records resident in the enclave and once streamed through sealed chunks.
+int Bench(int max_log2) {
+    const size_t limits[] = { 192 << 20, 8 << 20 };
+
+    Enclave *enclave = Enclave::getInstance();
+    sgx_status_t ret = enclave->createEnclave();
+    if (SGX_SUCCESS != ret) {
+        Log("Error, call createEnclave fail", log::error);
+        return -1;
+    }
+
+    sgx_status_t status;
+    ret = initialize(enclave->getID(), &status);
+    if ((SGX_SUCCESS != ret) || (SGX_SUCCESS != status)) {
+        Log("Error, call initialize fail", log::error);
+        delete enclave;
+        return -1;
+    }
+
+    printf("%12s %10s %8s %12s %12s %10s\n", "per client", "limit MiB", "threads", "matches", "ms", "Mrec/s");
+    for (int log2 = 14; log2 <= max_log2; log2++) {
+        uint64_t count = 1ULL << log2;
+        uint32_t threads = 0;
+        ret = bench_prepare(enclave->getID(), &status, count, &threads);
+        if ((SGX_SUCCESS != ret) || (SGX_SUCCESS != status)) {
+            Log("Error, call bench_prepare fail, %d, %d", ret, status);
+            break;
+        }
+
+        for (size_t limit : limits) {
+            uint64_t matches = 0;
+            auto start = std::chrono::steady_clock::now();
+            ret = bench_intersection(enclave->getID(), &status, limit, &matches);
+            std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+            if ((SGX_SUCCESS != ret) || (SGX_SUCCESS != status)) {
+                Log("Error, call bench_intersection fail, %d, %d", ret, status);
+                continue;
+            }
+            printf("%12llu %10zu %8u %12llu %12.1f %10.2f\n",
+                   (unsigned long long)count, limit >> 20, threads, (unsigned long long)matches,
+                   ms.count(), 2 * count / ms.count() / 1000.0);
+        }
+    }
+
+    uninitialize(enclave->getID());
+    delete enclave;
+    return 0;
+}
+
 int Main(int argc, char* argv[]) {
     LogBase::Inst();
 
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        return Bench(argc > 2 ? atoi(argv[2]) : 20);
+    }
+
     int ret = 0;
 
     MessageHandler msg;
@@ -32,9 +32,9 @@ extern crate sgx_rand;
 extern crate serde_derive;
 extern crate serde_cbor;
 
-use sgx_types::{sgx_status_t, sgx_sealed_data_t};
+use sgx_types::{sgx_status_t, sgx_sealed_data_t, SgxError};
 use sgx_types::marker::ContiguousMemory;
-use sgx_tseal::{SgxSealedData};
+use sgx_tseal::{SgxSealedData, SgxSealContext};
 use sgx_rand::{Rng, StdRng};
 use std::vec::Vec;
 
@@ -182,6 +182,53 @@ pub extern "C" fn verify_sealeddata_for_serializable(sealed_log: * mut u8, seale
     sgx_status_t::SGX_SUCCESS
 }
 
+#[no_mangle]
+pub extern "C" fn bench_seal_unseal(batched: u32, count: u32, size: u32) -> sgx_status_t {
+    let data = vec![0x5a_u8; size as usize];
+    let result = if batched != 0 {
+        bench_seal_context(&data, count as usize)
+    } else {
+        bench_sealed_data(&data, count as usize)
+    };
+    match result {
+        Ok(()) => sgx_status_t::SGX_SUCCESS,
+        Err(ret) => ret,
+    }
+}
+
+fn bench_sealed_data(data: &[u8], count: usize) -> SgxError {
+    let aad: [u8; 0] = [0_u8; 0];
+    let mut sealed = Vec::with_capacity(count);
+    for _ in 0..count {
+        sealed.push(SgxSealedData::<[u8]>::seal_data(&aad, data)?);
+    }
+    for sealed_data in sealed.iter() {
+        let unsealed_data = sealed_data.unseal_data()?;
+        if unsealed_data.get_decrypt_txt() != data {
+            return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+        }
+    }
+    Ok(())
+}
+
+fn bench_seal_context(data: &[u8], count: usize) -> SgxError {
+    let aad: [u8; 0] = [0_u8; 0];
+    let records = vec![(&aad[..], data); count];
+    let record_size = SgxSealContext::calc_sealed_size(0, data.len() as u32) as usize;
+
+    let mut ctx = SgxSealContext::new();
+    let mut sealed = vec![0_u8; record_size * count];
+    ctx.seal_many(&records, &mut sealed)?;
+
+    let mut plain = vec![0_u8; data.len() * count];
+    let mut lens = vec![0_usize; count];
+    ctx.unseal_many(&sealed, &mut plain, &mut lens)?;
+    if plain.chunks(data.len().max(1)).any(|chunk| chunk != data) {
+        return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+    }
+    Ok(())
+}
+
 fn to_sealed_log_for_fixed<T: Copy + ContiguousMemory>(sealed_data: &SgxSealedData<T>, sealed_log: * mut u8, sealed_log_size: u32) -> Option<* mut sgx_sealed_data_t> {
     unsafe {
         sealed_data.to_raw_sealed_data_t(sealed_log as * mut sgx_sealed_data_t, sealed_log_size)
@@ -35,6 +35,15 @@ extern {
 
     fn ecall_empty(eid: sgx_enclave_id_t) -> sgx_status_t;
     fn ecall_empty_switchless(eid: sgx_enclave_id_t) -> sgx_status_t;
+
+    fn ecall_profile_enable(eid: sgx_enclave_id_t,
+                            retval: *mut sgx_status_t,
+                            latency: i32) -> sgx_status_t;
+    fn ecall_profile_report(eid: sgx_enclave_id_t,
+                            retval: *mut sgx_status_t,
+                            buf: *mut u8,
+                            len: usize,
+                            needed: *mut usize) -> sgx_status_t;
 }
 
 fn init_enclave(num_uworker : u32, num_tworker : u32) -> SgxResult<SgxEnclave> {
@@ -106,6 +115,48 @@ fn benchmark_empty_ecall(eid : sgx_enclave_id_t,
     println!("Time elapsed {:?}", elapsed);
 }
 
+const PROFILED_REPEATS:u64 = 10000;
+
+// Repeats every call with the transition profile on, and prints what it
+// recorded. Latency is left out on processors without SGX2.
+fn profile_transitions(eid : sgx_enclave_id_t) {
+    let mut retval = sgx_status_t::SGX_SUCCESS;
+    let _ = unsafe { ecall_profile_enable(eid, &mut retval, 1) };
+    if retval != sgx_status_t::SGX_SUCCESS {
+        println!("No SGX2, profiling without latency");
+        let _ = unsafe { ecall_profile_enable(eid, &mut retval, 0) };
+    }
+
+    for is_switchless in 0..2 {
+        let _ = unsafe { ecall_repeat_ocalls(eid, PROFILED_REPEATS, is_switchless) };
+    }
+    for _ in 0..PROFILED_REPEATS {
+        let _ = unsafe { ecall_empty(eid) };
+        let _ = unsafe { ecall_empty_switchless(eid) };
+    }
+
+    let mut buf = vec![0u8; 4096];
+    let mut needed = 0usize;
+    loop {
+        let status = unsafe {
+            ecall_profile_report(eid, &mut retval, buf.as_mut_ptr(), buf.len(), &mut needed)
+        };
+        if status != sgx_status_t::SGX_SUCCESS {
+            println!("[-] ecall_profile_report failed {}!", status.as_str());
+            return;
+        }
+        if retval == sgx_status_t::SGX_SUCCESS {
+            break;
+        }
+        if needed <= buf.len() {
+            println!("[-] ecall_profile_report failed {}!", retval.as_str());
+            return;
+        }
+        buf.resize(needed, 0);
+    }
+    println!("{}", String::from_utf8_lossy(&buf[..needed]));
+}
+
 fn main() {
 
     let enclave = match init_enclave(2,2) {
@@ -123,6 +174,7 @@ fn main() {
     benchmark_empty_ocall(enclave.geteid(),1);
     benchmark_empty_ecall(enclave.geteid(),0);
     benchmark_empty_ecall(enclave.geteid(),1);
+    profile_transitions(enclave.geteid());
 
     println!("[+] say_something success...");
 
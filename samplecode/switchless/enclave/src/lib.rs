@@ -26,6 +26,12 @@ extern crate sgx_types;
 extern crate sgx_tstd as std;
 
 use sgx_types::*;
+use std::profile::{self, ProfileSite};
+use std::ptr;
+
+static ECALL_REPEAT_OCALLS: ProfileSite = ProfileSite::ecall("ecall_repeat_ocalls");
+static ECALL_EMPTY: ProfileSite = ProfileSite::ecall("ecall_empty");
+static ECALL_EMPTY_SWITCHLESS: ProfileSite = ProfileSite::ecall("ecall_empty_switchless");
 
 extern "C"{
     // OCALLS
@@ -36,23 +42,51 @@ extern "C"{
 #[no_mangle]
 pub extern "C"
 fn ecall_repeat_ocalls(nrepeats : u64, use_switchless : i32) {
+    let _profile = ECALL_REPEAT_OCALLS.enter(0);
 
     if use_switchless == 0 {
         for _ in 0..nrepeats {
-            unsafe {ocall_empty();}
+            unsafe {std::profile::ocall_profiled!(ocall_empty());}
         }
     }
     else {
         for _ in 0..nrepeats {
-            unsafe {ocall_empty_switchless();}
+            unsafe {std::profile::ocall_profiled!(ocall_empty_switchless());}
         }
     }
 }
 #[no_mangle]
 pub extern "C"
 fn ecall_empty(){
+    let _profile = ECALL_EMPTY.enter(0);
 }
 #[no_mangle]
 pub extern "C"
 fn ecall_empty_switchless() {
+    let _profile = ECALL_EMPTY_SWITCHLESS.enter(0);
+}
+
+/// Starts profiling the transitions, with their latency if `latency` is not
+/// zero. Latency needs SGX2.
+#[no_mangle]
+pub extern "C"
+fn ecall_profile_enable(latency: i32) -> sgx_status_t {
+    match profile::enable(latency != 0) {
+        Ok(()) => sgx_status_t::SGX_SUCCESS,
+        Err(_) => sgx_status_t::SGX_ERROR_FEATURE_NOT_SUPPORTED,
+    }
+}
+
+/// Copies the profile report into `buf`. `needed` is set to the length of
+/// the report even if it does not fit.
+#[no_mangle]
+pub extern "C"
+fn ecall_profile_report(buf: *mut u8, len: usize, needed: *mut usize) -> sgx_status_t {
+    let report = profile::report();
+    unsafe { *needed = report.len(); }
+    if report.len() > len {
+        return sgx_status_t::SGX_ERROR_INVALID_PARAMETER;
+    }
+    unsafe { ptr::copy_nonoverlapping(report.as_ptr(), buf, report.len()); }
+    sgx_status_t::SGX_SUCCESS
 }
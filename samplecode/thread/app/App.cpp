@@ -166,6 +166,10 @@ int SGX_CDECL main(int argc, char *argv[])
 
     ecall_thread_functions();
 
+    ecall_mutex_benchmarks();
+
+    ecall_rwlock_benchmarks();
+
     /* Destroy the enclave */
     sgx_destroy_enclave(global_eid);
 
@@ -43,6 +43,8 @@ extern "C" {
 #endif
 
 void ecall_thread_functions(void);
+void ecall_mutex_benchmarks(void);
+void ecall_rwlock_benchmarks(void);
 
 #if defined(__cplusplus)
 }
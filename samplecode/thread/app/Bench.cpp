@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <stdio.h>
+using namespace std;
+
+#include "App.h"
+#include "Enclave_u.h"
+
+#define BENCH_ITERATIONS 100000
+
+static const uint32_t bench_spin_rounds[] = { 0, 16 };
+static const size_t bench_threads[] = { 2, 4, 8, 16, 32 };
+static const size_t rwlock_bench_threads[] = { 1, 2, 4, 8, 16, 32 };
+
+static void mutex_bench_worker(uint64_t iterations)
+{
+    sgx_status_t ret = ecall_mutex_bench(global_eid, iterations);
+    if (ret != SGX_SUCCESS)
+        abort();
+}
+
+static double mutex_bench_run(uint32_t spin_rounds, size_t nthreads)
+{
+    sgx_status_t ret = SGX_ERROR_UNEXPECTED;
+    uint64_t total = 0;
+    vector<thread> workers;
+
+    ret = ecall_mutex_bench_init(global_eid, spin_rounds);
+    if (ret != SGX_SUCCESS)
+        abort();
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < nthreads; i++)
+        workers.push_back(thread(mutex_bench_worker, (uint64_t)BENCH_ITERATIONS));
+    for (auto &worker : workers)
+        worker.join();
+    auto end = chrono::steady_clock::now();
+
+    ret = ecall_mutex_bench_uninit(global_eid, &total);
+    if (ret != SGX_SUCCESS || total != nthreads * BENCH_ITERATIONS)
+        abort();
+
+    double secs = chrono::duration<double>(end - start).count();
+    return (double)total / secs;
+}
+
+/* ecall_mutex_benchmarks:
+ *   Measures contended SgxMutex throughput, parking vs adaptive spinning.
+ */
+void ecall_mutex_benchmarks(void)
+{
+    printf("Info: contended mutex throughput (lock/unlock per second)\n");
+    printf("%8s %16s %16s\n", "threads", "park", "adaptive(16)");
+    for (size_t i = 0; i < sizeof(bench_threads) / sizeof(bench_threads[0]); i++) {
+        double ops[2];
+        for (size_t j = 0; j < 2; j++)
+            ops[j] = mutex_bench_run(bench_spin_rounds[j], bench_threads[i]);
+        printf("%8zu %16.0f %16.0f\n", bench_threads[i], ops[0], ops[1]);
+    }
+}
+
+static void rwlock_bench_worker(uint64_t iterations, uint64_t *sum)
+{
+    sgx_status_t ret = ecall_rwlock_bench(global_eid, sum, iterations);
+    if (ret != SGX_SUCCESS)
+        abort();
+}
+
+static double rwlock_bench_run(uint32_t legacy, size_t nthreads)
+{
+    sgx_status_t ret = SGX_ERROR_UNEXPECTED;
+    vector<uint64_t> sums(nthreads, 0);
+    vector<thread> workers;
+
+    ret = ecall_rwlock_bench_init(global_eid, legacy);
+    if (ret != SGX_SUCCESS)
+        abort();
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < nthreads; i++)
+        workers.push_back(thread(rwlock_bench_worker, (uint64_t)BENCH_ITERATIONS, &sums[i]));
+    for (auto &worker : workers)
+        worker.join();
+    auto end = chrono::steady_clock::now();
+
+    ret = ecall_rwlock_bench_uninit(global_eid);
+    if (ret != SGX_SUCCESS)
+        abort();
+    /* The table holds 1..8 and is read round-robin. */
+    for (auto sum : sums)
+        if (sum != BENCH_ITERATIONS / 8 * 36)
+            abort();
+
+    double secs = chrono::duration<double>(end - start).count();
+    return (double)(nthreads * BENCH_ITERATIONS) / secs;
+}
+
+/* ecall_rwlock_benchmarks:
+ *   Measures read-only SgxRwLock throughput against the previous
+ *   spinlock-guarded SgxThreadRwLock, vendored in the enclave.
+ */
+void ecall_rwlock_benchmarks(void)
+{
+    printf("Info: read-only rwlock throughput (read/unlock per second)\n");
+    printf("%8s %16s %16s\n", "threads", "legacy", "sgxrwlock");
+    for (size_t i = 0; i < sizeof(rwlock_bench_threads) / sizeof(rwlock_bench_threads[0]); i++) {
+        double legacy = rwlock_bench_run(1, rwlock_bench_threads[i]);
+        double current = rwlock_bench_run(0, rwlock_bench_threads[i]);
+        printf("%8zu %16.0f %16.0f\n", rwlock_bench_threads[i], legacy, current);
+    }
+}
@@ -23,11 +23,17 @@
 
 #[cfg(not(target_env = "sgx"))]
 extern crate sgx_tstd as std;
+extern crate sgx_types;
+extern crate sgx_trts;
+extern crate sgx_libc;
 
-use std::sync::{SgxMutex, SgxCondvar};
+use std::sync::{SgxMutex, SgxCondvar, SgxMutexPolicy, SgxRwLock};
 use std::sync::atomic::{AtomicPtr, Ordering};
 use std::boxed::Box;
 
+mod legacy_rwlock;
+use legacy_rwlock::SgxThreadRwLock as LegacyRwLock;
+
 const BUFFER_SIZE: usize      = 50;
 const LOOPS_PER_THREAD: usize = 500;
 
@@ -126,3 +132,112 @@ pub extern "C" fn ecall_consumer() {
         let _ = less.signal();
     }
 }
+
+static GLOBAL_BENCH_MUTEX: AtomicPtr<()> = AtomicPtr::new(0 as * mut ());
+
+/*
+ * Contended mutex microbenchmark. `spin_rounds` selects the policy of the
+ * shared mutex: 0 parks right away, anything else spins that many backoff
+ * rounds inside the enclave before parking.
+ */
+#[no_mangle]
+pub extern "C" fn ecall_mutex_bench_init(spin_rounds: u32) {
+
+    let mutex = Box::new(SgxMutex::<u64>::new(0));
+    if spin_rounds == 0 {
+        mutex.set_policy(SgxMutexPolicy::Park);
+    } else {
+        mutex.set_policy(SgxMutexPolicy::Adaptive(spin_rounds));
+    }
+    let ptr = Box::into_raw(mutex);
+    GLOBAL_BENCH_MUTEX.store(ptr as *mut (), Ordering::SeqCst);
+}
+
+#[no_mangle]
+pub extern "C" fn ecall_mutex_bench(iterations: u64) {
+
+    let ptr = GLOBAL_BENCH_MUTEX.load(Ordering::SeqCst) as * mut SgxMutex<u64>;
+    if ptr.is_null() {
+        return;
+    }
+    let mutex = unsafe { &*ptr };
+
+    for _ in 0..iterations {
+        let mut guard = mutex.lock().unwrap();
+        *guard += 1;
+    }
+}
+
+#[no_mangle]
+pub extern "C" fn ecall_mutex_bench_uninit() -> u64 {
+
+    let ptr = GLOBAL_BENCH_MUTEX.swap(0 as * mut (), Ordering::SeqCst) as * mut SgxMutex<u64>;
+    if ptr.is_null() {
+       return 0;
+    }
+    let mutex = unsafe { Box::from_raw(ptr) };
+    mutex.into_inner().unwrap()
+}
+
+enum BenchRwLock {
+    Legacy(LegacyRwLock, [u64; 8]),
+    Current(SgxRwLock<[u64; 8]>),
+}
+
+static GLOBAL_BENCH_RWLOCK: AtomicPtr<()> = AtomicPtr::new(0 as * mut ());
+
+/*
+ * Read-only rwlock microbenchmark over a small shared table, standing in
+ * for a config or key cache. `legacy` selects the previous SgxThreadRwLock,
+ * vendored in legacy_rwlock.rs.
+ */
+#[no_mangle]
+pub extern "C" fn ecall_rwlock_bench_init(legacy: u32) {
+
+    let table = [1, 2, 3, 4, 5, 6, 7, 8];
+    let lock = if legacy != 0 {
+        Box::new(BenchRwLock::Legacy(
+            LegacyRwLock::new(),
+            table,
+        ))
+    } else {
+        Box::new(BenchRwLock::Current(SgxRwLock::new(table)))
+    };
+    let ptr = Box::into_raw(lock);
+    GLOBAL_BENCH_RWLOCK.store(ptr as *mut (), Ordering::SeqCst);
+}
+
+#[no_mangle]
+pub extern "C" fn ecall_rwlock_bench(iterations: u64) -> u64 {
+
+    let ptr = GLOBAL_BENCH_RWLOCK.load(Ordering::SeqCst) as * mut BenchRwLock;
+    if ptr.is_null() {
+        return 0;
+    }
+    let lock = unsafe { &*ptr };
+
+    let mut sum = 0;
+    for i in 0..iterations {
+        let idx = (i % 8) as usize;
+        match lock {
+            BenchRwLock::Legacy(lock, table) => unsafe {
+                lock.read().unwrap();
+                sum += table[idx];
+                lock.read_unlock().unwrap();
+            }
+            BenchRwLock::Current(lock) => {
+                sum += lock.read().unwrap()[idx];
+            }
+        }
+    }
+    sum
+}
+
+#[no_mangle]
+pub extern "C" fn ecall_rwlock_bench_uninit() {
+
+    let ptr = GLOBAL_BENCH_RWLOCK.swap(0 as * mut (), Ordering::SeqCst) as * mut BenchRwLock;
+    if !ptr.is_null() {
+        let _ = unsafe { Box::from_raw(ptr) };
+    }
+}
@@ -47,6 +47,7 @@ pub use sgx_serialize::*;
 extern crate sgx_serialize_derive;
 extern crate sgx_signal;
 extern crate sgx_libc;
+extern crate sgx_backtrace;
 
 pub use sgx_serialize::*;
 use sgx_types::*;
@@ -110,6 +111,12 @@ use test_signal::*;
 
 mod test_exception;
 use test_exception::*;
+
+mod test_task;
+use test_task::*;
+
+mod test_backtrace;
+use test_backtrace::*;
 #[no_mangle]
 pub extern "C"
 fn test_main_entrance() -> size_t {
@@ -117,6 +124,7 @@ fn test_main_entrance() -> size_t {
                     // tcrypto
                     test_rsgx_sha256_slice,
                     test_rsgx_sha256_handle,
+                    test_rsgx_aes_gcm_batch,
                     // assert
                     foo_panic,
                     foo_should,
@@ -152,6 +160,8 @@ fn test_main_entrance() -> size_t {
                     test_seal_unseal,
                     test_number_sealing,        // Thanks to @silvanegli
                     test_array_sealing,         // Thanks to @silvanegli
+                    test_seal_context,
+                    test_seal_stream,
                     test_mac_aadata_slice,
                     test_mac_aadata_number,
                     // rand
@@ -164,14 +174,22 @@ fn test_main_entrance() -> size_t {
                     test_serialize_base,
                     test_serialize_struct,
                     test_serialize_enum,
+                    test_serialize_leb128,
+                    test_serialize_borrowed,
+                    test_serialize_borrowed_derive,
                     // std::sgxfs
                     test_sgxfs,
                     // std::fs
                     test_fs,
+                    test_fs_large_io,
+                    test_fs_batch,
+                    test_async_log,
+                    test_ocall_profile,
                     // std::fs untrusted mode
                     test_fs_untrusted_fs_feature_enabled,
                     // std::time
                     test_std_time,
+                    test_std_time_tsc,
                     // rand
                     test_rand_cratesio,
                     // types
@@ -229,6 +247,12 @@ fn test_main_entrance() -> size_t {
                     test_thread_size_of_option_thread_id,
                     test_thread_id_equal,
                     test_thread_id_not_equal,
+                    test_thread_mutex_policy,
+                    test_thread_mutex_contended,
+                    test_thread_rwlock_recursive_read,
+                    test_thread_rwlock_contended,
+                    test_thread_pool_join_scope,
+                    test_thread_pool_par_chunks,
                     //test mpsc
                     test_mpsc_smoke,
                     test_mpsc_drop_full,
@@ -346,6 +370,13 @@ fn test_main_entrance() -> size_t {
                     test_signal_register_unregister1,
                     //test exception
                     test_exception_handler,
+                    //test task
+                    test_task_block_on_spawn,
+                    test_task_wake_from_thread,
+                    test_task_tcp_echo,
+                    //test backtrace
+                    test_backtrace_trace_fast,
+                    test_backtrace_trace_fast_bounds,
                     )
 }
 
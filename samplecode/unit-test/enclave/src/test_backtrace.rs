@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+
+use sgx_backtrace::{self, Backtrace};
+use sgx_trts::enclave::SgxThreadData;
+use sgx_trts::trts::rsgx_raw_is_within_enclave;
+use std::os::raw::c_void;
+use std::ptr;
+use std::vec::Vec;
+
+const MAX_FRAMES: usize = 128;
+
+// Both captures are taken from the same frame, so everything above their
+// own return addresses has to agree.
+#[inline(never)]
+fn capture_both() -> (Vec<*mut c_void>, Backtrace) {
+    let mut ips = [ptr::null_mut(); MAX_FRAMES];
+    let count = sgx_backtrace::trace_fast(&mut ips);
+    let bt = Backtrace::new_unresolved();
+    (ips[..count].to_vec(), bt)
+}
+
+#[inline(never)]
+fn recurse(depth: usize, ips: &mut [*mut c_void]) -> usize {
+    if depth == 0 {
+        return sgx_backtrace::trace_fast(ips);
+    }
+    let count = recurse(depth - 1, ips);
+    // Keeps the call out of tail position.
+    unsafe { ptr::read_volatile(&count) }
+}
+
+pub fn test_backtrace_trace_fast() {
+    assert!(sgx_backtrace::init_unwind_index());
+
+    let (ips, bt) = capture_both();
+    let frames = bt.frames();
+    assert!(ips.len() > 1);
+    assert!(ips.len() < MAX_FRAMES);
+
+    // The walk may stop before libunwind does, but never goes further or
+    // disagrees with it on the way.
+    assert!(ips.len() <= frames.len());
+    assert_eq!(sgx_backtrace::symbol_address_fast(ips[0]), frames[0].symbol_address());
+    for (ip, frame) in ips.iter().zip(frames.iter()).skip(1) {
+        assert_eq!(*ip, frame.ip());
+    }
+    for ip in ips.iter() {
+        assert!(rsgx_raw_is_within_enclave(*ip as *const u8, 1));
+    }
+}
+
+pub fn test_backtrace_trace_fast_bounds() {
+    assert!(sgx_backtrace::init_unwind_index());
+
+    let thread = SgxThreadData::current();
+    let local = 0usize;
+    let sp = &local as *const usize as usize;
+    assert!(sp >= thread.stack_limit() && sp < thread.stack_base());
+
+    // A short buffer is filled up and nothing past it is written.
+    let mut ips = [ptr::null_mut(); 8];
+    assert_eq!(recurse(16, &mut ips[..4]), 4);
+    assert!(ips[..4].iter().all(|ip| !ip.is_null()));
+    assert!(ips[4..].iter().all(|ip| ip.is_null()));
+
+    // A deep stack is walked through to the enclave entry and stops there,
+    // at the top of the thread's stack, well short of a large buffer.
+    let mut ips = [ptr::null_mut(); 4 * MAX_FRAMES];
+    let count = recurse(64, &mut ips);
+    assert!(count > 65);
+    assert!(count < ips.len());
+    let leaf = ips[0];
+    assert!(ips[1..65].iter().all(|&ip| ip == ips[1]));
+    assert!(leaf != ips[1]);
+    assert!(ips[count..].iter().all(|ip| ip.is_null()));
+}
@@ -17,6 +17,8 @@
 
 use utils::*;
 use std::string::String;
+use std::vec::Vec;
+use sgx_types::*;
 use sgx_tcrypto::*;
 
 static HASH_TEST_VEC: &'static [&'static str] = &[
@@ -53,3 +55,79 @@ pub fn test_rsgx_sha256_handle(){
     }
 }
 
+
+// Test Cases 2 and 4 of McGrew and Viega, "The Galois/Counter Mode of
+// Operation (GCM)": key, iv, aad, plaintext, ciphertext, tag.
+static GCM_TEST_VEC: &'static [[&'static str; 6]] = &[
+    [&"00000000000000000000000000000000",
+     &"000000000000000000000000",
+     &"",
+     &"00000000000000000000000000000000",
+     &"0388dace60b6a392f328c2b971b2fe78",
+     &"ab6e47d42cec13bdf53a67b21257bddf"],
+    [&"feffe9928665731c6d6a8f9467308308",
+     &"cafebabefacedbaddecaf888",
+     &"feedfacedeadbeeffeedfacedeadbeefabaddad2",
+     &"d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+     &"42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+     &"5bc94fbc3221a5db94fae95ae7121a47"],
+];
+
+pub fn test_rsgx_aes_gcm_batch() {
+    let vecs: Vec<Vec<Vec<u8>>> = GCM_TEST_VEC.iter()
+        .map(|v| v.iter().map(|s| hex_to_bytes(s)).collect())
+        .collect();
+    let keys: Vec<sgx_aes_gcm_128bit_key_t> = vecs.iter().map(|v| {
+        let mut key = [0_u8; SGX_AESGCM_KEY_SIZE];
+        key.copy_from_slice(&v[0]);
+        key
+    }).collect();
+
+    // Each vector twice, so two lanes share a key schedule.
+    let mut out = vec![vec![0_u8; 64]; 4];
+    let mut macs = vec![[0_u8; SGX_AESGCM_MAC_SIZE]; 4];
+    {
+        let mut jobs = Vec::new();
+        for (i, (dst, mac)) in out.iter_mut().zip(macs.iter_mut()).enumerate() {
+            let v = &vecs[i % 2];
+            jobs.push(SgxAesGcmJob::encrypt(&keys[i % 2], &v[3], &v[1], &v[2], dst, mac).unwrap());
+        }
+        rsgx_rijndael128GCM_batch(&mut jobs).unwrap();
+    }
+    for i in 0..4 {
+        let v = &vecs[i % 2];
+        assert_eq!(&out[i][..v[4].len()], &v[4][..]);
+        assert_eq!(&macs[i][..], &v[5][..]);
+    }
+
+    // In place, with one forged tag.
+    let mut bufs: Vec<Vec<u8>> = (0..4).map(|i| vecs[i % 2][4].clone()).collect();
+    macs[3][0] ^= 1;
+    {
+        let mut jobs = Vec::new();
+        for (i, (buf, mac)) in bufs.iter_mut().zip(macs.iter()).enumerate() {
+            let v = &vecs[i % 2];
+            jobs.push(SgxAesGcmJob::decrypt_in_place(&keys[i % 2], buf, &v[1], &v[2], mac).unwrap());
+        }
+        assert_eq!(rsgx_rijndael128GCM_batch(&mut jobs), Err(sgx_status_t::SGX_ERROR_MAC_MISMATCH));
+        assert_eq!(jobs[2].status(), sgx_status_t::SGX_SUCCESS);
+        assert_eq!(jobs[3].status(), sgx_status_t::SGX_ERROR_MAC_MISMATCH);
+    }
+    for i in 0..3 {
+        assert_eq!(bufs[i], vecs[i % 2][3]);
+    }
+    assert!(bufs[3].iter().all(|&b| b == 0));
+
+    // The single-message in-place functions match the C library.
+    let v = &vecs[1];
+    let mut buf = v[3].clone();
+    let mut mac = [0_u8; SGX_AESGCM_MAC_SIZE];
+    rsgx_rijndael128GCM_encrypt_in_place(&keys[1], &mut buf, &v[1], &v[2], &mut mac).unwrap();
+    let mut expected = vec![0_u8; buf.len()];
+    let mut expected_mac = [0_u8; SGX_AESGCM_MAC_SIZE];
+    rsgx_rijndael128GCM_encrypt(&keys[1], &v[3], &v[1], &v[2], &mut expected, &mut expected_mac).unwrap();
+    assert_eq!(buf, expected);
+    assert_eq!(mac, expected_mac);
+    rsgx_rijndael128GCM_decrypt_in_place(&keys[1], &mut buf, &v[1], &v[2], &mac).unwrap();
+    assert_eq!(buf, v[3]);
+}
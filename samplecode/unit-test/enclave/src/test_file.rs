@@ -19,8 +19,13 @@ use sgx_rand::{Rng, StdRng};
 use std::sgxfs::{self, SgxFile};
 use std::untrusted::fs::File;
 use std::untrusted::fs::remove_file;
-use std::io::{Read, Write};
+use std::io::{AsyncLogBuilder, IoBatch, LogLevel, LogOverflow, Read, Write};
+use std::os::unix::io::AsRawFd;
+use std::profile::{self, ProfileKind, ProfileSite};
+use std::sync::Arc;
 use std::string::*;
+use std::vec::Vec;
+use sgx_libc::ocall;
 
 pub fn test_sgxfs() {
 
@@ -128,3 +133,160 @@ pub fn test_fs_untrusted_fs_feature_enabled() {
         assert!(f.is_ok());
     }
 }
+
+pub fn test_fs_large_io() {
+    {
+        let data: Vec<u8> = (0..0x10000_usize).map(|i| i as u8).collect();
+
+        let f = File::create("large.bin");
+        assert!(f.is_ok());
+        let result = f.unwrap().write_all(&data);
+        assert!(result.is_ok());
+
+        let before = ocall::staging_stats();
+        for _ in 0..2 {
+            let mut f = File::open("large.bin").unwrap();
+            let mut buf = vec![0_u8; 0x20000];
+            let n = f.read(&mut buf).unwrap();
+            assert_eq!(n, data.len());
+            assert_eq!(&buf[..n], &data[..]);
+        }
+        let after = ocall::staging_stats();
+        assert!(after.hits + after.misses >= before.hits + before.misses + 2);
+        assert!(after.hits > before.hits);
+
+        let f = remove_file("large.bin");
+        assert!(f.is_ok());
+    }
+}
+
+pub fn test_fs_batch() {
+    {
+        let f = File::create("batch.bin");
+        assert!(f.is_ok());
+        let f = f.unwrap();
+
+        let mut batch = IoBatch::with_capacity(8, 0x1000).unwrap();
+        for i in 0..32_u64 {
+            let result = batch.write_at(&f, &[i as u8; 100], i * 100);
+            assert!(result.is_ok());
+        }
+        let done = batch.wait(32).unwrap();
+        assert_eq!(done.len(), 32);
+        assert!(done.iter().all(|c| c.result().unwrap() == 100));
+        assert_eq!(batch.pending(), 0);
+
+        let f = File::open("batch.bin").unwrap();
+        let tokens: Vec<_> = (0..32_u64).map(|i| batch.read_at(&f, 100, i * 100).unwrap()).collect();
+        let mut done = Vec::new();
+        while batch.pending() > 0 {
+            done.extend(batch.wait(1).unwrap());
+        }
+        assert_eq!(done.len(), 32);
+        for c in done {
+            let i = tokens.iter().position(|t| *t == c.token()).unwrap();
+            assert_eq!(c.result().unwrap(), 100);
+            assert_eq!(c.data(), &[i as u8; 100][..]);
+        }
+
+        let f = remove_file("batch.bin");
+        assert!(f.is_ok());
+    }
+}
+
+pub fn test_async_log() {
+    {
+        let f = File::create("log.txt");
+        assert!(f.is_ok());
+        let f = f.unwrap();
+
+        let log = AsyncLogBuilder::new()
+            .size(0x1000)
+            .fd(f.as_raw_fd())
+            .overflow(LogOverflow::Block)
+            .build();
+        assert!(log.is_ok());
+        let log = Arc::new(log.unwrap());
+
+        let threads: Vec<_> = (0..4)
+            .map(|t| {
+                let log = log.clone();
+                std::thread::spawn(move || {
+                    for i in 0..256 {
+                        log.log(LogLevel::Info, format_args!("thread {} record {}", t, i)).unwrap();
+                    }
+                })
+            })
+            .collect();
+        for t in threads {
+            t.join().unwrap();
+        }
+        log.log_str(LogLevel::Error, &"x".repeat(3000)).unwrap();
+        assert!((&*log).write_all(b"plain\n").is_ok());
+        assert!(log.flush().is_ok());
+
+        let stats = log.stats();
+        assert_eq!(stats.dropped, 0);
+        assert_eq!(stats.records, 4 * 256 + 2 + 1);
+
+        let mut contents = String::new();
+        let mut f = File::open("log.txt").unwrap();
+        assert!(f.read_to_string(&mut contents).is_ok());
+        let lines: Vec<&str> = contents.lines().collect();
+        assert_eq!(lines.len(), 4 * 256 + 2);
+        for t in 0..4 {
+            let mine: Vec<&str> = lines
+                .iter()
+                .cloned()
+                .filter(|l| l.starts_with(&format!("[INFO] thread {} ", t)))
+                .collect();
+            assert_eq!(mine.len(), 256);
+            for (i, l) in mine.iter().enumerate() {
+                assert_eq!(*l, format!("[INFO] thread {} record {}", t, i));
+            }
+        }
+        assert_eq!(lines[4 * 256], format!("[ERROR] {}", "x".repeat(3000)));
+        assert_eq!(lines[4 * 256 + 1], "plain");
+
+        drop(log);
+        let f = remove_file("log.txt");
+        assert!(f.is_ok());
+    }
+}
+
+pub fn test_ocall_profile() {
+    static SITE: ProfileSite = ProfileSite::ecall("ecall_test");
+
+    profile::reset();
+    assert!(profile::enable(false).is_ok());
+    {
+        let _profile = SITE.enter(16);
+        let mut f = File::create("profile.txt").unwrap();
+        for _ in 0..8 {
+            assert!(f.write_all(&[0_u8; 100]).is_ok());
+        }
+    }
+    profile::disable();
+    {
+        let mut f = File::open("profile.txt").unwrap();
+        let mut buf = Vec::new();
+        assert!(f.read_to_end(&mut buf).is_ok());
+    }
+
+    let profiles = profile::snapshot();
+    assert_eq!(profiles[0].name, "ecall_test");
+    assert_eq!(profiles[0].kind, ProfileKind::Ecall);
+    assert_eq!(profiles[0].calls, 1);
+    assert_eq!(profiles[0].bytes, 16);
+    let write = profiles.iter().find(|p| p.name == "u_write_ocall").unwrap();
+    assert_eq!(write.kind, ProfileKind::Ocall);
+    assert_eq!(write.calls, 8);
+    assert_eq!(write.bytes, 800);
+    assert_eq!(write.latency.count(), 0);
+    assert!(profiles.iter().all(|p| p.name != "u_read_ocall"));
+    assert!(profile::report().contains("u_write_ocall"));
+
+    profile::reset();
+    assert!(profile::snapshot().is_empty());
+    assert!(remove_file("profile.txt").is_ok());
+}
@@ -100,3 +100,83 @@ pub fn test_mac_aadata_slice() {
     let inner_slice = unsafe {slice::from_raw_parts(inner as *mut u8, 10)};
     assert_eq!(inner_slice, aad_data);
 }
+
+pub fn test_seal_context() {
+    let records: Vec<(Vec<u8>, Vec<u8>)> = (0..16_u8)
+        .map(|i| (vec![i; i as usize % 3], vec![i; i as usize * 7 + 1]))
+        .collect();
+    let refs: Vec<(&[u8], &[u8])> = records.iter().map(|(a, e)| (&a[..], &e[..])).collect();
+    let size: usize = refs
+        .iter()
+        .map(|(a, e)| SgxSealContext::calc_sealed_size(a.len() as u32, e.len() as u32) as usize)
+        .sum();
+
+    let mut ctx = SgxSealContext::new();
+    let mut sealed = vec![0_u8; size];
+    assert_eq!(ctx.seal_many(&refs, &mut sealed).unwrap(), size);
+    let first = SgxSealContext::get_sealed_size(&sealed).unwrap();
+    assert_eq!(SgxSealContext::get_additional_txt(&sealed[first..]).unwrap(), &records[1].0[..]);
+
+    let mut plain = vec![0_u8; size];
+    let mut lens = vec![0_usize; records.len()];
+    let mut other = SgxSealContext::new();
+    assert_eq!(other.unseal_many(&sealed, &mut plain, &mut lens).unwrap(), records.len());
+    let mut offset = 0;
+    for ((_, e), len) in records.iter().zip(lens.iter()) {
+        assert_eq!(&plain[offset..offset + len], &e[..]);
+        offset += len;
+    }
+
+    sealed[first + 560] ^= 1;
+    assert_eq!(other.unseal_many(&sealed, &mut plain, &mut lens),
+               Err(sgx_status_t::SGX_ERROR_MAC_MISMATCH));
+    assert!(plain[..records[0].1.len()].iter().all(|&b| b == 0));
+
+    // Blobs from seal_data unseal as well.
+    let data: [u8; 10] = [1, 2, 3, 4, 5, 6, 7, 8, 9, 10];
+    let aad: [u8; 0] = [0_u8; 0];
+    let sealed_data = SgxSealedData::<[u8]>::seal_data(&aad, &data).unwrap();
+    let mut sealed_log = vec![0_u8; SgxSealContext::calc_sealed_size(0, 10) as usize];
+    let opt = unsafe {
+        sealed_data.to_raw_sealed_data_t(sealed_log.as_mut_ptr() as * mut sgx_sealed_data_t,
+                                         sealed_log.len() as u32)
+    };
+    assert!(opt.is_some());
+    assert_eq!(ctx.unseal(&sealed_log, &mut plain).unwrap(), 10);
+    assert_eq!(&plain[..10], &data);
+}
+
+pub fn test_seal_stream() {
+    use std::io::{Cursor, Read, Seek, SeekFrom, Write};
+    use std::sgxseal::{SgxSealWriter, SgxUnsealReader};
+
+    let data: Vec<u8> = (0..1000_u32).map(|i| (i * 31 % 251) as u8).collect();
+    let mut writer = SgxSealWriter::with_chunk_size(64, Vec::new()).unwrap();
+    for piece in data.chunks(100) {
+        writer.write_all(piece).unwrap();
+    }
+    let sealed = writer.finish().unwrap();
+    assert_eq!(sealed.len(), SgxStreamSealer::HEADER_SIZE + 16 * 16 + data.len());
+
+    let mut reader = SgxUnsealReader::new(Cursor::new(sealed.clone())).unwrap();
+    assert_eq!(reader.len(), data.len() as u64);
+    let mut unsealed = Vec::new();
+    reader.read_to_end(&mut unsealed).unwrap();
+    assert_eq!(unsealed, data);
+
+    let mut buf = [0_u8; 10];
+    reader.seek(SeekFrom::Start(500)).unwrap();
+    reader.read_exact(&mut buf).unwrap();
+    assert_eq!(&buf, &data[500..510]);
+    assert_eq!(reader.read_chunk(3).unwrap(), &data[192..256]);
+
+    // Dropping the last chunk must not go unnoticed.
+    let truncated = sealed[..sealed.len() - (1000 - 15 * 64) - 16].to_vec();
+    assert!(SgxUnsealReader::new(Cursor::new(truncated)).is_err());
+
+    let mut corrupted = sealed;
+    corrupted[SgxStreamSealer::HEADER_SIZE + 80 + 1] ^= 1;
+    let mut reader = SgxUnsealReader::new(Cursor::new(corrupted)).unwrap();
+    assert!(reader.read_chunk(0).is_ok());
+    assert!(reader.read_chunk(1).is_err());
+}
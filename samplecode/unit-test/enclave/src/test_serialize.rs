@@ -2,6 +2,7 @@ use std::vec::Vec;
 use std::fmt::Debug;
 use std::string::{ToString, String};
 use sgx_serialize::{Serializable, DeSerializable, SerializeHelper, DeSerializeHelper};
+use sgx_serialize::{BorrowDecoder, DeSerializableBorrowed, BorrowDeSerializeHelper};
 
 fn test_serialize_internal<T: Serializable + DeSerializable>(target: &T) -> Option<T>{
     let helper = SerializeHelper::new();
@@ -340,4 +341,177 @@ pub fn test_serialize_base() {
     test_sequence();
     test_hash_map();
     test_tuples();
-}
\ No newline at end of file
+}
+
+pub fn test_serialize_leb128() {
+    fn check<T: Serializable + DeSerializable + PartialEq + Debug>(value: T) {
+        let helper = SerializeHelper::new();
+        let data = helper.encode(&value).unwrap();
+        assert_eq!(helper.encoded_size(&value), Some(data.len()));
+        assert_eq!(helper.get_size(), data.len());
+        for len in 0..data.len() {
+            let helper = DeSerializeHelper::<T>::new(data[..len].to_vec());
+            assert!(helper.decode().is_none());
+        }
+        let c = DeSerializeHelper::<T>::new(data).decode().unwrap();
+        assert_eq!(value, c);
+    }
+
+    // Every length of encoding, on both sides of the word-sized fast path.
+    for shift in 0..128 {
+        let v = 1u128 << shift;
+        check(v - 1);
+        check(v);
+        check(v as i128);
+        check((v as i128).wrapping_neg());
+        check((v as i128).wrapping_sub(1));
+        if shift < 64 {
+            check(v as u64);
+            check((v as i64).wrapping_neg());
+        }
+    }
+    check(::std::u128::MAX);
+    check(::std::i128::MIN);
+
+    let a: [u8; 3] = [0x80, 0x80, 0x80];
+    assert!(DeSerializeHelper::<u32>::new(a.to_vec()).decode().is_none());
+}
+
+pub fn test_serialize_borrowed() {
+    #[derive(PartialEq, Debug)]
+    struct Request<'a> {
+        id: u64,
+        name: &'a str,
+        body: &'a [u8],
+        tags: Vec<&'a str>,
+        reply: Option<&'a str>,
+    }
+
+    impl<'de> DeSerializableBorrowed<'de> for Request<'de> {
+        fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<Request<'de>, D::Error> {
+            Ok(Request {
+                id: DeSerializableBorrowed::decode_borrowed(d)?,
+                name: d.read_borrowed_str()?,
+                body: d.read_borrowed_bytes()?,
+                tags: DeSerializableBorrowed::decode_borrowed(d)?,
+                reply: DeSerializableBorrowed::decode_borrowed(d)?,
+            })
+        }
+    }
+
+    // Borrowed fields read what their owned counterparts write.
+    let owned = (2017u64,
+                 "request".to_string(),
+                 vec![0x5au8; 300],
+                 vec!["a".to_string(), "µ€".to_string()],
+                 Some("reply".to_string()));
+    let helper = SerializeHelper::new();
+    let data = helper.encode(&owned).unwrap();
+
+    let request = BorrowDeSerializeHelper::<Request>::new(&data).decode().unwrap();
+    assert_eq!(request, Request {
+        id: 2017,
+        name: "request",
+        body: &[0x5au8; 300][..],
+        tags: vec!["a", "µ€"],
+        reply: Some("reply"),
+    });
+    let range = data.as_ptr() as usize..data.as_ptr() as usize + data.len();
+    assert!(range.contains(&(request.name.as_ptr() as usize)));
+    assert!(range.contains(&(request.body.as_ptr() as usize)));
+
+    for len in 0..data.len() {
+        assert!(BorrowDeSerializeHelper::<Request>::new(&data[..len]).decode().is_none());
+    }
+
+    let mut data = helper.encode(&"ab".to_string()).unwrap();
+    data[1] = 0xff;
+    assert!(BorrowDeSerializeHelper::<&str>::new(&data).decode().is_none());
+}
+
+pub fn test_serialize_borrowed_derive() {
+    #[derive(Serializable)]
+    struct OwnedRequest {
+        id: u64,
+        name: String,
+        body: Vec<u8>,
+    }
+
+    #[derive(Serializable)]
+    enum OwnedMessage {
+        Ping,
+        Text(String),
+        Pair(String, u32),
+        Blob { id: u32, data: Vec<u8> },
+        Batch(Vec<OwnedRequest>),
+    }
+
+    #[derive(DeSerializableBorrowed, PartialEq, Debug)]
+    struct Request<'a> {
+        id: u64,
+        name: &'a str,
+        body: &'a [u8],
+    }
+
+    #[derive(DeSerializableBorrowed, PartialEq, Debug)]
+    enum Message<'a> {
+        Ping,
+        Text(&'a str),
+        Pair(&'a str, u32),
+        Blob { id: u32, data: &'a [u8] },
+        Batch(Vec<Request<'a>>),
+    }
+
+    #[derive(DeSerializableBorrowed, PartialEq, Debug)]
+    struct Name<'a>(&'a str);
+
+    #[derive(DeSerializableBorrowed, PartialEq, Debug)]
+    struct Header {
+        version: u16,
+        flags: Option<u8>,
+    }
+
+    fn check<'a, T>(data: &'a [u8], expected: T) -> T
+    where
+        T: DeSerializableBorrowed<'a> + PartialEq + Debug,
+    {
+        for len in 0..data.len() {
+            assert!(BorrowDeSerializeHelper::<T>::new(&data[..len]).decode().is_none());
+        }
+        let value = BorrowDeSerializeHelper::<T>::new(data).decode().unwrap();
+        assert_eq!(value, expected);
+        value
+    }
+
+    let helper = SerializeHelper::new();
+
+    let data = helper.encode(&OwnedRequest { id: 7, name: "req".to_string(), body: vec![1, 2, 3] }).unwrap();
+    let request = check(&data, Request { id: 7, name: "req", body: &[1, 2, 3] });
+    let range = data.as_ptr() as usize..data.as_ptr() as usize + data.len();
+    assert!(range.contains(&(request.name.as_ptr() as usize)));
+    assert!(range.contains(&(request.body.as_ptr() as usize)));
+
+    let data = helper.encode(&OwnedMessage::Ping).unwrap();
+    check(&data, Message::Ping);
+    let data = helper.encode(&OwnedMessage::Text("µ€".to_string())).unwrap();
+    check(&data, Message::Text("µ€"));
+    let data = helper.encode(&OwnedMessage::Pair("left".to_string(), 2017)).unwrap();
+    check(&data, Message::Pair("left", 2017));
+    let data = helper.encode(&OwnedMessage::Blob { id: 9, data: vec![0x5a; 300] }).unwrap();
+    check(&data, Message::Blob { id: 9, data: &[0x5a; 300][..] });
+    let batch = OwnedMessage::Batch(vec![
+        OwnedRequest { id: 1, name: "a".to_string(), body: Vec::new() },
+        OwnedRequest { id: 2, name: "b".to_string(), body: vec![0xff] },
+    ]);
+    let data = helper.encode(&batch).unwrap();
+    check(&data, Message::Batch(vec![
+        Request { id: 1, name: "a", body: &[] },
+        Request { id: 2, name: "b", body: &[0xff] },
+    ]));
+
+    let data = helper.encode(&"name".to_string()).unwrap();
+    check(&data, Name("name"));
+
+    let data = helper.encode(&(3u16, Some(1u8))).unwrap();
+    check(&data, Header { version: 3, flags: Some(1) });
+}
@@ -0,0 +1,236 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+use std::future::Future;
+use std::io;
+use std::mem;
+use std::net::{AsyncTcpListener, AsyncTcpStream};
+use std::pin::Pin;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::task::{self, Context, Executor, Poll};
+use std::thread;
+use std::time::Duration;
+use std::vec::Vec;
+
+// The crate is on the 2015 edition, so there is no `async` here: the tests
+// drive the executor with hand-written futures.
+struct PollFn<F>(F);
+
+impl<F> Unpin for PollFn<F> {}
+
+impl<T, F: FnMut(&mut Context) -> Poll<T>> Future for PollFn<F> {
+    type Output = T;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context) -> Poll<T> {
+        (self.get_mut().0)(cx)
+    }
+}
+
+fn poll_fn<T, F: FnMut(&mut Context) -> Poll<T>>(f: F) -> PollFn<F> {
+    PollFn(f)
+}
+
+// Pending once, waking itself, then ready with `value`.
+fn yield_once<T>(value: T) -> PollFn<impl FnMut(&mut Context) -> Poll<T>> {
+    let mut value = Some(value);
+    let mut yielded = false;
+    poll_fn(move |cx: &mut Context| {
+        if !yielded {
+            yielded = true;
+            cx.waker().wake_by_ref();
+            return Poll::Pending;
+        }
+        Poll::Ready(value.take().unwrap())
+    })
+}
+
+// Pending until another thread sets the flag and fires the waker.
+fn woken_from_thread() -> PollFn<impl FnMut(&mut Context) -> Poll<u32>> {
+    let done = Arc::new(AtomicBool::new(false));
+    let mut started = false;
+    poll_fn(move |cx: &mut Context| {
+        if done.load(Ordering::SeqCst) {
+            return Poll::Ready(42);
+        }
+        if !started {
+            started = true;
+            let done = done.clone();
+            let waker = cx.waker().clone();
+            thread::spawn(move || {
+                thread::sleep(Duration::from_millis(10));
+                done.store(true, Ordering::SeqCst);
+                waker.wake();
+            });
+        }
+        Poll::Pending
+    })
+}
+
+pub fn test_task_block_on_spawn() {
+    assert_eq!(task::block_on(yield_once(1)).unwrap(), 1);
+
+    let exec = Executor::new().unwrap();
+    let handle = exec.spawn(yield_once(2));
+    assert_eq!(exec.pending(), 1);
+    assert_eq!(exec.block_on(handle).unwrap(), 2);
+    assert_eq!(exec.pending(), 0);
+
+    // `task::spawn` from inside a running task, joined by that task.
+    let mut inner = None;
+    let outer = exec.spawn(poll_fn(move |cx: &mut Context| {
+        let handle = inner.get_or_insert_with(|| task::spawn(yield_once(3)));
+        Pin::new(handle).poll(cx).map(|n| n * 10)
+    }));
+    assert_eq!(exec.block_on(outer).unwrap(), 30);
+    assert_eq!(exec.pending(), 0);
+
+    // A detached task keeps running until the executor drives it.
+    let spawner = exec.spawner();
+    drop(spawner.spawn(yield_once(())));
+    assert_eq!(exec.pending(), 1);
+    exec.block_on(poll_fn(|cx: &mut Context| {
+        if exec.pending() == 0 {
+            return Poll::Ready(());
+        }
+        cx.waker().wake_by_ref();
+        Poll::Pending
+    })).unwrap();
+
+    // Nested `block_on` is refused.
+    let nested = exec.block_on(poll_fn(|_: &mut Context| Poll::Ready(task::block_on(yield_once(()))))).unwrap();
+    assert!(nested.is_err());
+}
+
+pub fn test_task_wake_from_thread() {
+    // The executor parks in epoll_wait and has to be woken through the
+    // reactor's notification socket.
+    assert_eq!(task::block_on(woken_from_thread()).unwrap(), 42);
+
+    let exec = Executor::new().unwrap();
+    let handles: Vec<_> = (0..4).map(|_| exec.spawn(woken_from_thread())).collect();
+    for handle in handles {
+        assert_eq!(exec.block_on(handle).unwrap(), 42);
+    }
+    assert_eq!(exec.pending(), 0);
+}
+
+pub fn test_task_tcp_echo() {
+    // Large enough to fill the socket buffers, so both sides have to wait
+    // for writability as well as for readability.
+    const LEN: usize = 1 << 20;
+
+    let exec = Executor::new().unwrap();
+    // Sockets register with the reactor of the executor they are created in.
+    let listener = exec.block_on(poll_fn(|_: &mut Context| {
+        Poll::Ready(AsyncTcpListener::bind("127.0.0.1:0"))
+    })).unwrap().unwrap();
+    let addr = listener.local_addr().unwrap();
+
+    let mut stream: Option<AsyncTcpStream> = None;
+    let mut buf = vec![0u8; 16 * 1024];
+    let (mut pos, mut filled, mut echoed) = (0, 0, 0);
+    let server = exec.spawn(poll_fn(move |cx: &mut Context| -> Poll<io::Result<usize>> {
+        if stream.is_none() {
+            match listener.poll_accept(cx) {
+                Poll::Ready(Ok((s, _))) => stream = Some(s),
+                Poll::Ready(Err(e)) => return Poll::Ready(Err(e)),
+                Poll::Pending => return Poll::Pending,
+            }
+        }
+        let s = stream.as_ref().unwrap();
+        loop {
+            if pos < filled {
+                match s.poll_write(cx, &buf[pos..filled]) {
+                    Poll::Ready(Ok(n)) => {
+                        pos += n;
+                        echoed += n;
+                        continue;
+                    }
+                    Poll::Ready(Err(e)) => return Poll::Ready(Err(e)),
+                    Poll::Pending => return Poll::Pending,
+                }
+            }
+            if echoed == LEN {
+                return Poll::Ready(Ok(echoed));
+            }
+            match s.poll_read(cx, &mut buf) {
+                Poll::Ready(Ok(0)) => return Poll::Ready(Err(io::ErrorKind::UnexpectedEof.into())),
+                Poll::Ready(Ok(n)) => {
+                    pos = 0;
+                    filled = n;
+                }
+                Poll::Ready(Err(e)) => return Poll::Ready(Err(e)),
+                Poll::Pending => return Poll::Pending,
+            }
+        }
+    }));
+
+    let msg: Vec<u8> = (0..LEN).map(|i| (i * 31 % 251) as u8).collect();
+    let mut connect = Some(AsyncTcpStream::connect(&addr));
+    let mut stream: Option<AsyncTcpStream> = None;
+    let mut back = vec![0u8; LEN];
+    let (mut sent, mut received) = (0, 0);
+    let client = poll_fn(|cx: &mut Context| -> Poll<io::Result<Vec<u8>>> {
+        if let Some(mut c) = connect.take() {
+            match Pin::new(&mut c).poll(cx) {
+                Poll::Ready(Ok(s)) => stream = Some(s),
+                Poll::Ready(Err(e)) => return Poll::Ready(Err(e)),
+                Poll::Pending => {
+                    connect = Some(c);
+                    return Poll::Pending;
+                }
+            }
+        }
+        let s = stream.as_ref().unwrap();
+        loop {
+            // Write and read in the same turn; writing everything first
+            // would deadlock once the echo fills our receive buffer.
+            let mut progress = false;
+            if sent < LEN {
+                match s.poll_write(cx, &msg[sent..]) {
+                    Poll::Ready(Ok(n)) => {
+                        sent += n;
+                        progress = true;
+                    }
+                    Poll::Ready(Err(e)) => return Poll::Ready(Err(e)),
+                    Poll::Pending => {}
+                }
+            }
+            match s.poll_read(cx, &mut back[received..]) {
+                Poll::Ready(Ok(0)) => return Poll::Ready(Err(io::ErrorKind::UnexpectedEof.into())),
+                Poll::Ready(Ok(n)) => {
+                    received += n;
+                    progress = true;
+                }
+                Poll::Ready(Err(e)) => return Poll::Ready(Err(e)),
+                Poll::Pending => {}
+            }
+            if received == LEN {
+                return Poll::Ready(Ok(mem::replace(&mut back, Vec::new())));
+            }
+            if !progress {
+                return Poll::Pending;
+            }
+        }
+    });
+
+    let back = exec.block_on(client).unwrap().unwrap();
+    assert!(back == msg);
+    assert_eq!(exec.block_on(server).unwrap().unwrap(), LEN);
+    assert_eq!(exec.pending(), 0);
+}
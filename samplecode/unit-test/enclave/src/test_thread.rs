@@ -12,6 +12,8 @@ use std::string::String;
 use std::string::ToString;
 use std::u32;
 use std::sync::mpsc::{channel, Sender};
+use std::sync::{Arc, SgxMutex, SgxMutexPolicy, SgxRwLock, SgxThreadMutex};
+use std::vec::Vec;
 
 pub fn test_thread_unnamed_thread() {
     thread::spawn(move|| {
@@ -226,4 +228,129 @@ pub fn test_thread_id_not_equal() {
     assert!(thread::current().id() != spawned_id);
 }
 
+pub fn test_thread_mutex_policy() {
+    let m = SgxMutex::new(0);
+    assert_eq!(m.policy(), SgxThreadMutex::default_policy());
+    m.set_policy(SgxMutexPolicy::Park);
+    assert_eq!(m.policy(), SgxMutexPolicy::Park);
+    m.set_policy(SgxMutexPolicy::Adaptive(0));
+    assert_eq!(m.policy(), SgxMutexPolicy::Park);
+    m.set_policy(SgxMutexPolicy::Adaptive(8));
+    assert_eq!(m.policy(), SgxMutexPolicy::Adaptive(8));
+}
+
+pub fn test_thread_mutex_contended() {
+    const THREADS: usize = 4;
+    const ITERATIONS: usize = 1000;
+
+    for &policy in &[SgxMutexPolicy::Park, SgxMutexPolicy::Adaptive(16)] {
+        let m = Arc::new(SgxMutex::new(0));
+        m.set_policy(policy);
+
+        let handles: Vec<_> = (0..THREADS).map(|_| {
+            let m = m.clone();
+            thread::spawn(move || {
+                for _ in 0..ITERATIONS {
+                    *m.lock().unwrap() += 1;
+                }
+            })
+        }).collect();
+        for h in handles {
+            h.join().unwrap();
+        }
+        assert_eq!(*m.lock().unwrap(), THREADS * ITERATIONS);
+    }
+}
+
+pub fn test_thread_pool_join_scope() {
+    use std::thread::pool::{self, ThreadPool};
+
+    fn fib(n: u64) -> u64 {
+        if n < 2 {
+            return n;
+        }
+        let (a, b) = pool::join(|| fib(n - 1), || fib(n - 2));
+        a + b
+    }
+
+    let pool = ThreadPool::new(3).unwrap();
+    assert_eq!(pool.install(|| fib(20)), 6765);
+
+    let mut counts = [0usize; 8];
+    pool.scope(|s| {
+        for (i, slot) in counts.iter_mut().enumerate() {
+            s.spawn(move |_| *slot = i * 2);
+        }
+    });
+    assert_eq!(counts, [0, 2, 4, 6, 8, 10, 12, 14]);
+
+    let r = panic::catch_unwind(panic::AssertUnwindSafe(|| {
+        pool.join(|| 1, || -> i32 { panic!("boom") })
+    }));
+    assert!(r.is_err());
+}
+
+pub fn test_thread_pool_par_chunks() {
+    use std::thread::pool::ThreadPool;
+
+    let pool = ThreadPool::new(3).unwrap();
+    let data: Vec<u64> = (0..10000).collect();
+
+    let squares = pool.par_map(&data, |x| x * x);
+    assert!(squares.iter().enumerate().all(|(i, &x)| x == (i * i) as u64));
+
+    let sum = pool.par_chunks(&data, 97).map_reduce(|c| c.iter().sum::<u64>(), |a, b| a + b);
+    assert_eq!(sum, Some(10000 * 9999 / 2));
+
+    let mut out = vec![0usize; 1000];
+    pool.par_chunks_mut(&mut out, 64).for_each(|idx, chunk| {
+        for x in chunk.iter_mut() {
+            *x = idx;
+        }
+    });
+    assert!(out.iter().enumerate().all(|(i, &x)| x == i / 64));
+}
+
+pub fn test_thread_rwlock_recursive_read() {
+    let lock = SgxRwLock::new(5);
+    let r1 = lock.read().unwrap();
+    let r2 = lock.read().unwrap();
+    assert_eq!(*r1 + *r2, 10);
+    assert!(lock.try_write().is_err());
+    drop(r1);
+    assert!(lock.try_write().is_err());
+    drop(r2);
+    *lock.try_write().unwrap() += 1;
+    assert!(lock.try_read().is_ok());
+    assert_eq!(*lock.read().unwrap(), 6);
+}
 
+pub fn test_thread_rwlock_contended() {
+    const THREADS: usize = 8;
+    const ITERATIONS: usize = 1000;
+
+    let lock = Arc::new(SgxRwLock::new([0usize; 4]));
+    let handles: Vec<_> = (0..THREADS).map(|t| {
+        let lock = lock.clone();
+        thread::spawn(move || {
+            for i in 0..ITERATIONS {
+                if (i + t) % 16 == 0 {
+                    let mut data = lock.write().unwrap();
+                    for x in data.iter_mut() {
+                        *x += 1;
+                    }
+                } else {
+                    let data = lock.read().unwrap();
+                    assert!(data.iter().all(|&x| x == data[0]));
+                }
+            }
+        })
+    }).collect();
+    for h in handles {
+        h.join().unwrap();
+    }
+    let writes = (0..THREADS)
+        .map(|t| (0..ITERATIONS).filter(|i| (i + t) % 16 == 0).count())
+        .sum::<usize>();
+    assert_eq!(*lock.read().unwrap(), [writes; 4]);
+}
@@ -1,6 +1,7 @@
 use std::time::*;
 use std::panic;
 use std::untrusted::time::{InstantEx, SystemTimeEx};
+use std::untrusted::time::{self, ClockSource, TscClockConfig, UntrustedTime};
 
 pub fn test_std_time() {
     macro_rules! assert_almost_eq {
@@ -111,3 +112,38 @@ pub fn test_std_time() {
     }
 }
 
+
+pub fn test_std_time_tsc() {
+    let start = UntrustedTime::<Instant>::now();
+    assert!(start.elapsed().assume_trusted() < Duration::new(1, 0));
+    let _ = UntrustedTime::<SystemTime>::now().assume_trusted();
+
+    assert_eq!(time::clock_source(), ClockSource::Ocall);
+    let config = TscClockConfig {
+        resync_interval: Duration::from_millis(20),
+        max_drift: Duration::from_micros(50),
+    };
+    if time::set_clock_source(ClockSource::Tsc(config)).is_err() {
+        // No SGX2, so no RDTSC in the enclave.
+        return;
+    }
+    assert_eq!(time::clock_source(), ClockSource::Tsc(config));
+
+    let first = Instant::now();
+    let mut last = first;
+    for _ in 0..100_000 {
+        let now = Instant::now();
+        assert!(now >= last);
+        last = now;
+    }
+    let sys = SystemTime::now();
+
+    assert!(time::set_clock_source(ClockSource::Ocall).is_ok());
+    let host = Instant::now();
+    assert!(host + Duration::from_millis(1) >= last);
+    let host_sys = SystemTime::now();
+    match host_sys.duration_since(sys) {
+        Ok(d) => assert!(d < Duration::new(1, 0)),
+        Err(e) => assert!(e.duration() < Duration::from_millis(1)),
+    }
+}
@@ -25,12 +25,18 @@ use sgx_types::*;
 use sgx_urts::SgxEnclave;
 
 mod wasm_def;
+// The encoding of actions and results, shared with the enclave.
+#[path = "../../enclave/sgxwasm/src/protocol.rs"]
+#[allow(dead_code)]
+mod protocol;
 
-use wasm_def::{RuntimeValue, Error as InterpreterError};
+use std::collections::HashMap;
+use wasm_def::{RuntimeValue, Error as InterpreterError, Trap, TrapKind};
+use protocol::{ActionResult, BoundaryError, BoundaryValue, ErrorKind, ModuleHash, ModuleSource,
+               SgxWasmAction, TrapCode};
 use wabt::script::{Action, Command, CommandKind, ScriptParser, Value};
 
 extern crate serde;
-extern crate serde_json;
 #[macro_use]
 extern crate serde_derive;
 
@@ -43,41 +49,12 @@ extern {
     fn sgxwasm_run_action(eid: sgx_enclave_id_t, retval: *mut sgx_status_t,
                           req_bin : *const u8, req_len: usize,
                           result_bin : *mut u8,
-                          result_max_len : usize ) -> sgx_status_t;
-}
-
-#[derive(Debug, Serialize, Deserialize)]
-pub enum SgxWasmAction {
-    Invoke {
-        module: Option<String>,
-        field: String,
-        args: Vec<BoundaryValue>
-    },
-    Get {
-        module: Option<String>,
-        field: String,
-    },
-    LoadModule {
-        name: Option<String>,
-        module: Vec<u8>,
-    },
-    TryLoad {
-        module: Vec<u8>,
-    },
-    Register {
-        name: Option<String>,
-        as_name: String,
-    },
+                          result_max_len : usize,
+                          result_len : *mut usize) -> sgx_status_t;
 }
 
-#[derive(Debug, Serialize, Deserialize)]
-pub enum BoundaryValue {
-    I32(i32),
-    I64(i64),
-    F32(u32),
-    F64(u64),
-    V128(u128),
-}
+// Hashes of the modules the enclave has loaded, by their binary.
+type LoadedModules = HashMap<Vec<u8>, ModuleHash>;
 
 fn wabt_runtime_value_to_boundary_value(wabt_rv : &wabt::script::Value) -> BoundaryValue {
     match wabt_rv {
@@ -110,13 +87,34 @@ fn boundary_value_to_runtime_value(rv: BoundaryValue) -> RuntimeValue {
     }
 }
 
-pub fn answer_convert(res : Result<Option<BoundaryValue>, InterpreterError>)
+fn boundary_error_to_interpreter_error(e: BoundaryError) -> InterpreterError {
+    let trap = |kind| InterpreterError::Trap(Trap::new(kind));
+    match e.kind {
+        ErrorKind::Validation => InterpreterError::Validation(e.message),
+        ErrorKind::Instantiation | ErrorKind::NotCached => InterpreterError::Instantiation(e.message),
+        ErrorKind::Function => InterpreterError::Function(e.message),
+        ErrorKind::Table => InterpreterError::Table(e.message),
+        ErrorKind::Memory => InterpreterError::Memory(e.message),
+        ErrorKind::Global => InterpreterError::Global(e.message),
+        ErrorKind::Value => InterpreterError::Value(e.message),
+        ErrorKind::Trap(TrapCode::Unreachable) => trap(TrapKind::Unreachable),
+        ErrorKind::Trap(TrapCode::MemoryAccessOutOfBounds) => trap(TrapKind::MemoryAccessOutOfBounds),
+        ErrorKind::Trap(TrapCode::TableAccessOutOfBounds) => trap(TrapKind::TableAccessOutOfBounds),
+        ErrorKind::Trap(TrapCode::ElemUninitialized) => trap(TrapKind::ElemUninitialized),
+        ErrorKind::Trap(TrapCode::DivisionByZero) => trap(TrapKind::DivisionByZero),
+        ErrorKind::Trap(TrapCode::InvalidConversionToInt) => trap(TrapKind::InvalidConversionToInt),
+        ErrorKind::Trap(TrapCode::StackOverflow) => trap(TrapKind::StackOverflow),
+        ErrorKind::Trap(TrapCode::UnexpectedSignature) => trap(TrapKind::UnexpectedSignature),
+    }
+}
+
+pub fn answer_convert(res : ActionResult)
                      ->  Result<Option<RuntimeValue>, InterpreterError>
 {
     match res {
-        Ok(None) => Ok(None),
-        Ok(Some(rv)) => Ok(Some(boundary_value_to_runtime_value(rv))),
-        Err(x) => Err(x),
+        ActionResult::Done | ActionResult::Loaded(_) => Ok(None),
+        ActionResult::Value(rv) => Ok(Some(boundary_value_to_runtime_value(rv))),
+        ActionResult::Error(x) => Err(boundary_error_to_interpreter_error(x)),
     }
 }
 
@@ -170,23 +168,24 @@ fn sgx_enclave_wasm_init(enclave : &SgxEnclave) -> Result<(),String> {
     Ok(())
 }
 
-fn sgx_enclave_wasm_invoke(req_str : String,
+fn sgx_enclave_wasm_invoke(req : &SgxWasmAction,
                            result_max_len : usize,
-                           enclave : &SgxEnclave) -> (Result<Option<BoundaryValue>, InterpreterError>, sgx_status_t) {
+                           enclave : &SgxEnclave) -> (ActionResult, sgx_status_t) {
     let enclave_id = enclave.geteid();
     let mut ret_val = sgx_status_t::SGX_SUCCESS;
-    let     req_bin = req_str.as_ptr() as * const u8;
-    let     req_len = req_str.len();
+    let mut req_bin = Vec::new();
+    req.encode(&mut req_bin);
 
     let mut result_vec:Vec<u8> = vec![0; result_max_len];
-    let     result_slice = &mut result_vec[..];
+    let mut result_len = 0;
 
     let sgx_ret = unsafe{sgxwasm_run_action(enclave_id,
                                      &mut ret_val,
-                                     req_bin,
-                                     req_len,
-                                     result_slice.as_mut_ptr(),
-                                     result_max_len)};
+                                     req_bin.as_ptr(),
+                                     req_bin.len(),
+                                     result_vec.as_mut_ptr(),
+                                     result_max_len,
+                                     &mut result_len)};
 
     match sgx_ret {
         // sgx_ret falls in range of Intel's Error code set
@@ -197,55 +196,63 @@ fn sgx_enclave_wasm_invoke(req_str : String,
         }
     }
 
-    // We need to trim all trailing '\0's before conver to string
-    let mut result_vec:Vec<u8> = result_slice.to_vec();
-    result_vec.retain(|x| *x != 0x00u8);
-
-    //let result_str : String;
-    let result:Result<Option<BoundaryValue>, InterpreterError>;
-    // Now result_vec only includes essential chars
-    if result_vec.len() == 0 {
-        result = Ok(None);
-    }
-    else{
-        let raw_result_str = String::from_utf8(result_vec).unwrap();
-        result = serde_json::from_str(&raw_result_str).unwrap();
-    }
-
     match ret_val {
         // ret_val falls in range of [SGX_SUCCESS + SGX_ERROR_WASM_*]
-        sgx_status_t::SGX_SUCCESS => {},
+        sgx_status_t::SGX_SUCCESS
+        | sgx_status_t::SGX_ERROR_WASM_INTERPRETER_ERROR
+        | sgx_status_t::SGX_ERROR_WASM_LOAD_MODULE_ERROR
+        | sgx_status_t::SGX_ERROR_WASM_TRY_LOAD_ERROR
+        | sgx_status_t::SGX_ERROR_WASM_REGISTER_ERROR => {},
         _ => {
-            // In this case, the returned buffer is useful
-            return (result, ret_val);
+            // In this case, the returned buffer is not filled
+            println!("[-] ECALL Enclave Function return fail: {}!", ret_val.as_str());
+            panic!("sgx_enclave_wasm_invoke's ECALL returned unknown error!");
         }
     }
 
-
-
-    // ret_val should be SGX_SUCCESS here
+    let result = ActionResult::decode(&result_vec[..result_len.min(result_max_len)])
+                     .expect("malformed result from the enclave");
     (result, ret_val)
 }
 
 fn sgx_enclave_wasm_load_module(module : Vec<u8>,
                                 name   : &Option<String>,
+                                loaded : &mut LoadedModules,
                                 enclave : &SgxEnclave)
                                 -> Result<(), String> {
 
-    // Init a SgxWasmAction::LoadModule struct and send it to enclave
-    let req = SgxWasmAction::LoadModule {
-                  name : name.as_ref().map(|x| x.clone()),
-                  module : module,
-              };
+    // Send the hash alone if the enclave has seen the module before
+    let mut result = None;
+    if let Some(hash) = loaded.get(&module) {
+        let req = SgxWasmAction::LoadModule {
+                      name : name.as_ref().map(|x| x.as_str()),
+                      module : ModuleSource::Cached(*hash),
+                  };
+        match sgx_enclave_wasm_invoke(&req, MAXOUTPUT, enclave) {
+            (ActionResult::Error(BoundaryError { kind: ErrorKind::NotCached, .. }), _) => {},
+            r => result = Some(r),
+        }
+    }
 
-    match sgx_enclave_wasm_invoke(serde_json::to_string(&req).unwrap(),
-                                  MAXOUTPUT,
-                                  enclave) {
-        (_, sgx_status_t::SGX_SUCCESS) => {
+    // Otherwise send the binary
+    let result = match result {
+        Some(r) => r,
+        None => {
+            let req = SgxWasmAction::LoadModule {
+                          name : name.as_ref().map(|x| x.as_str()),
+                          module : ModuleSource::Binary(&module),
+                      };
+            sgx_enclave_wasm_invoke(&req, MAXOUTPUT, enclave)
+        }
+    };
+
+    match result {
+        (ActionResult::Loaded(hash), sgx_status_t::SGX_SUCCESS) => {
+            loaded.insert(module, hash);
             Ok(())
         },
-        (Err(x), sgx_status_t::SGX_ERROR_WASM_LOAD_MODULE_ERROR) => {
-            Err(x.to_string())
+        (x, sgx_status_t::SGX_ERROR_WASM_LOAD_MODULE_ERROR) => {
+            Err(answer_convert(x).unwrap_err().to_string())
         },
         (_, _) => {
             println!("sgx_enclave_wasm_load_module should not arrive here!");
@@ -265,13 +272,13 @@ fn sgx_enclave_wasm_run_action(action : &Action, enclave : &SgxEnclave) -> Resul
             // Deal with Invoke
             // Make a SgxWasmAction::Invoke structure and send it to sgx_enclave_wasm_invoke
             let req = SgxWasmAction::Invoke {
-                          module : module.as_ref().map(|x| x.clone()),
-                          field  : field.clone(),
+                          module : module.as_ref().map(|x| x.as_str()),
+                          field  : field,
                           args   : args.into_iter()
                                        .map(wabt_runtime_value_to_boundary_value)
                                        .collect()
             };
-            let result = sgx_enclave_wasm_invoke(serde_json::to_string(&req).unwrap(),
+            let result = sgx_enclave_wasm_invoke(&req,
                                                  MAXOUTPUT,
                                                  enclave);
             match result {
@@ -297,10 +304,10 @@ fn sgx_enclave_wasm_run_action(action : &Action, enclave : &SgxEnclave) -> Resul
             // Deal with Get
             // Make a SgxWasmAction::Get structure and send it to sgx_enclave_wasm_invoke
             let req = SgxWasmAction::Get {
-                module : module.as_ref().map(|x| x.clone()),
-                field  : field.clone(),
+                module : module.as_ref().map(|x| x.as_str()),
+                field  : field,
             };
-            let result = sgx_enclave_wasm_invoke(serde_json::to_string(&req).unwrap(),
+            let result = sgx_enclave_wasm_invoke(&req,
                                                  MAXOUTPUT,
                                                  enclave);
 
@@ -325,18 +332,17 @@ fn sgx_enclave_wasm_run_action(action : &Action, enclave : &SgxEnclave) -> Resul
 fn sgx_enclave_wasm_try_load(module : &[u8], enclave : &SgxEnclave) -> Result<(), InterpreterError> {
     // Make a SgxWasmAction::TryLoad structure and send it to sgx_enclave_wasm_invoke
     let req = SgxWasmAction::TryLoad {
-        module : module.to_vec(),
+        module : ModuleSource::Binary(module),
     };
-
-    let result = sgx_enclave_wasm_invoke(serde_json::to_string(&req).unwrap(),
+    let result = sgx_enclave_wasm_invoke(&req,
                                          MAXOUTPUT,
                                          enclave);
     match result {
         (_, sgx_status_t::SGX_SUCCESS) => {
             Ok(())
         },
-        (Err(x), sgx_status_t::SGX_ERROR_WASM_TRY_LOAD_ERROR) => {
-            Err(InterpreterError::Global(x.to_string()))
+        (x, sgx_status_t::SGX_ERROR_WASM_TRY_LOAD_ERROR) => {
+            Err(InterpreterError::Global(answer_convert(x).unwrap_err().to_string()))
         },
         (_, _) => {
             println!("sgx_enclave_wasm_try_load returned unknown error!");
@@ -351,11 +357,11 @@ fn sgx_enclave_wasm_register(name : Option<String>,
                              enclave : &SgxEnclave) -> Result<(), InterpreterError> {
     // Make a SgxWasmAction::Register structure and send it to sgx_enclave_wasm_invoke
     let req = SgxWasmAction::Register{
-        name : name,
-        as_name : as_name,
+        name : name.as_ref().map(|x| x.as_str()),
+        as_name : &as_name,
     };
 
-    let result = sgx_enclave_wasm_invoke(serde_json::to_string(&req).unwrap(),
+    let result = sgx_enclave_wasm_invoke(&req,
                                          MAXOUTPUT,
                                          enclave);
 
@@ -363,8 +369,8 @@ fn sgx_enclave_wasm_register(name : Option<String>,
         (_, sgx_status_t::SGX_SUCCESS) => {
             Ok(())
         },
-        (Err(x), sgx_status_t::SGX_ERROR_WASM_REGISTER_ERROR) => {
-            Err(InterpreterError::Global(x.to_string()))
+        (x, sgx_status_t::SGX_ERROR_WASM_REGISTER_ERROR) => {
+            Err(InterpreterError::Global(answer_convert(x).unwrap_err().to_string()))
         },
         (_, _) => {
             println!("sgx_enclave_wasm_register returned unknown error!");
@@ -373,7 +379,7 @@ fn sgx_enclave_wasm_register(name : Option<String>,
     }
 }
 
-fn wasm_main_loop(wast_file : &str, enclave : &SgxEnclave) -> Result<(), String> {
+fn wasm_main_loop(wast_file : &str, loaded : &mut LoadedModules, enclave : &SgxEnclave) -> Result<(), String> {
 
     // ScriptParser interface has changed. Need to feed it with wast content.
     let wast_content : Vec<u8> = std::fs::read(wast_file).unwrap();
@@ -392,7 +398,7 @@ fn wasm_main_loop(wast_file : &str, enclave : &SgxEnclave) -> Result<(), String>
 
         match kind {
             CommandKind::Module { name, module, .. } => {
-                sgx_enclave_wasm_load_module (module.into_vec(), &name, enclave)?;
+                sgx_enclave_wasm_load_module (module.into_vec(), &name, loaded, enclave)?;
                 println!("load module - success at line {}", line)
             },
 
@@ -516,13 +522,14 @@ fn wasm_main_loop(wast_file : &str, enclave : &SgxEnclave) -> Result<(), String>
 }
 
 fn run_a_wast(enclave   : &SgxEnclave,
-              wast_file : &str) -> Result<(), String> {
+              wast_file : &str,
+              loaded    : &mut LoadedModules) -> Result<(), String> {
 
     // Step 1: Init the sgxwasm spec driver engine
     sgx_enclave_wasm_init(enclave)?;
 
     // Step 2: Load the wast file and run
-    wasm_main_loop(wast_file, enclave)?;
+    wasm_main_loop(wast_file, loaded, enclave)?;
 
     Ok(())
 }
@@ -615,9 +622,11 @@ fn main() {
         "../test_input/utf8-custom-section-id.wast",
         ];
 
+    // The enclave keeps the modules it validated across the wast files
+    let mut loaded = LoadedModules::new();
     for wfile in wast_list {
         println!("======================= testing {} =====================", wfile);
-        run_a_wast(&enclave, wfile).unwrap();
+        run_a_wast(&enclave, wfile, &mut loaded).unwrap();
     }
 
     enclave.destroy();
@@ -30,7 +30,9 @@ extern crate wabt;
 
 use std::{i32, i64, u32, u64, f32};
 use std::prelude::v1::*;
+use std::cell::Cell;
 use std::collections::HashMap;
+use std::sync::{Arc, SgxMutex};
 use wasmi::memory_units::Pages;
 
 pub use wasmi::Error as InterpreterError;
@@ -45,6 +47,7 @@ use wasmi::{ModuleInstance,
             MemoryRef,
             TableInstance,
             Trap,
+            TrapKind,
             Externals,
             RuntimeArgs,
             FuncRef,
@@ -62,42 +65,8 @@ use wasmi::{ModuleInstance,
 use wabt::script;
 use wabt::script::{Value};
 
-extern crate serde;
-#[macro_use]
-extern crate serde_derive;
-//use serde::{Serialize, Serializer, Deserialize, Deserializer};
-#[derive(Debug, Serialize, Deserialize)]
-pub enum SgxWasmAction {
-    Invoke {
-        module: Option<String>,
-        field: String,
-        args: Vec<BoundaryValue>
-    },
-    Get {
-        module: Option<String>,
-        field: String,
-    },
-    LoadModule {
-        name: Option<String>,
-        module: Vec<u8>,
-    },
-    TryLoad {
-        module: Vec<u8>,
-    },
-    Register {
-        name: Option<String>,
-        as_name: String,
-    },
-}
-
-#[derive(Debug, Serialize, Deserialize)]
-pub enum BoundaryValue {
-    I32(i32),
-    I64(i64),
-    F32(u32),
-    F64(u64),
-    V128(u128),
-}
+mod protocol;
+pub use protocol::*;
 
 pub fn runtime_value_to_boundary_value(rv: RuntimeValue) -> BoundaryValue {
     match rv {
@@ -129,6 +98,34 @@ pub fn result_covert(res : Result<Option<RuntimeValue>, InterpreterError>)
     }
 }
 
+pub fn interpreter_error_to_boundary_error(e: InterpreterError) -> BoundaryError {
+    let kind = match e {
+        InterpreterError::Validation(_) => ErrorKind::Validation,
+        InterpreterError::Instantiation(_) => ErrorKind::Instantiation,
+        InterpreterError::Function(_) => ErrorKind::Function,
+        InterpreterError::Table(_) => ErrorKind::Table,
+        InterpreterError::Memory(_) => ErrorKind::Memory,
+        InterpreterError::Global(_) => ErrorKind::Global,
+        InterpreterError::Value(_) => ErrorKind::Value,
+        InterpreterError::Trap(ref trap) => match *trap.kind() {
+            TrapKind::Unreachable => ErrorKind::Trap(TrapCode::Unreachable),
+            TrapKind::MemoryAccessOutOfBounds => ErrorKind::Trap(TrapCode::MemoryAccessOutOfBounds),
+            TrapKind::TableAccessOutOfBounds => ErrorKind::Trap(TrapCode::TableAccessOutOfBounds),
+            TrapKind::ElemUninitialized => ErrorKind::Trap(TrapCode::ElemUninitialized),
+            TrapKind::DivisionByZero => ErrorKind::Trap(TrapCode::DivisionByZero),
+            TrapKind::InvalidConversionToInt => ErrorKind::Trap(TrapCode::InvalidConversionToInt),
+            TrapKind::StackOverflow => ErrorKind::Trap(TrapCode::StackOverflow),
+            TrapKind::UnexpectedSignature => ErrorKind::Trap(TrapCode::UnexpectedSignature),
+            // Traps raised by host functions.
+            _ => ErrorKind::Function,
+        },
+        // Errors raised by host functions.
+        _ => ErrorKind::Function,
+    };
+    BoundaryError { kind, message: e.to_string() }
+}
+
+#[derive(Clone)]
 pub struct SpecModule {
     table: TableRef,
     memory: MemoryRef,
@@ -181,7 +178,11 @@ impl From<script::Error> for Error {
 
 const PRINT_FUNC_INDEX: usize = 0;
 
-impl Externals for SpecModule {
+/// The host functions of the `spectest` module. They keep no state, so
+/// every call gets its own.
+pub struct SpecExternals;
+
+impl Externals for SpecExternals {
     fn invoke_index(
         &mut self,
         index: usize,
@@ -197,6 +198,16 @@ impl Externals for SpecModule {
     }
 }
 
+impl Externals for SpecModule {
+    fn invoke_index(
+        &mut self,
+        index: usize,
+        args: RuntimeArgs,
+    ) -> Result<Option<RuntimeValue>, Trap> {
+        SpecExternals.invoke_index(index, args)
+    }
+}
+
 impl ModuleImportResolver for SpecModule {
     fn resolve_func(
         &self,
@@ -274,10 +285,51 @@ impl ModuleImportResolver for SpecModule {
     }
 }
 
+
+/// A module instance and the locks calls into it run under.
+///
+/// Calls into an instance are serialized by its own lock, so calls into
+/// independent instances run concurrently. Instances that share memories,
+/// tables, globals or functions with other instances also take the
+/// driver's shared lock, as code running in one of them may touch the
+/// state of the others.
+pub struct LoadedInstance {
+    instance: SgxMutex<ModuleRef>,
+    shared: SgxMutex<Option<Arc<SgxMutex<()>>>>,
+}
+
+impl LoadedInstance {
+    pub fn run<R, F>(&self, f: F) -> R
+    where
+        F: FnOnce(&ModuleRef) -> R,
+    {
+        loop {
+            let shared = self.shared.lock().unwrap().clone();
+            let _shared = shared.as_ref().map(|lock| lock.lock().unwrap());
+            let instance = self.instance.lock().unwrap();
+            // Another instance may have linked against this one meanwhile.
+            if shared.is_none() && self.shared.lock().unwrap().is_some() {
+                continue;
+            }
+            return f(&*instance);
+        }
+    }
+
+    fn share(&self, lock: &Arc<SgxMutex<()>>) {
+        // Waits for the calls that run without the shared lock.
+        let _instance = self.instance.lock().unwrap();
+        let mut shared = self.shared.lock().unwrap();
+        if shared.is_none() {
+            *shared = Some(lock.clone());
+        }
+    }
+}
+
 pub struct SpecDriver {
     spec_module: SpecModule,
-    instances: HashMap<String, ModuleRef>,
-    last_module: Option<ModuleRef>,
+    instances: HashMap<String, Arc<LoadedInstance>>,
+    last_module: Option<Arc<LoadedInstance>>,
+    shared: Arc<SgxMutex<()>>,
 }
 
 impl SpecDriver {
@@ -286,27 +338,35 @@ impl SpecDriver {
             spec_module: SpecModule::new(),
             instances: HashMap::new(),
             last_module: None,
+            shared: Arc::new(SgxMutex::new(())),
         }
     }
 
-    pub fn spec_module(&mut self) -> &mut SpecModule {
-        &mut self.spec_module
+    /// Takes a snapshot of what new instances link against: the `spectest`
+    /// module and the registered instances. Instantiating against it needs
+    /// no access to the driver.
+    pub fn imports(&self) -> Imports {
+        Imports {
+            spec_module: self.spec_module.clone(),
+            instances: self.instances.clone(),
+            shared: self.shared.clone(),
+        }
     }
 
-    pub fn add_module(&mut self, name: Option<String>, module: ModuleRef) {
+    pub fn add_module(&mut self, name: Option<String>, module: Arc<LoadedInstance>) {
         self.last_module = Some(module.clone());
         if let Some(name) = name {
             self.instances.insert(name, module);
         }
     }
 
-    pub fn module(&self, name: &str) -> Result<ModuleRef, InterpreterError> {
+    pub fn module(&self, name: &str) -> Result<Arc<LoadedInstance>, InterpreterError> {
         self.instances.get(name).cloned().ok_or_else(|| {
             InterpreterError::Instantiation(format!("Module not registered {}", name))
         })
     }
 
-    pub fn module_or_last(&self, name: Option<&str>) -> Result<ModuleRef, InterpreterError> {
+    pub fn module_or_last(&self, name: Option<&str>) -> Result<Arc<LoadedInstance>, InterpreterError> {
         match name {
             Some(name) => self.module(name),
             None => self.last_module
@@ -315,9 +375,9 @@ impl SpecDriver {
         }
     }
 
-    pub fn register(&mut self, name : &Option<String>,
+    pub fn register(&mut self, name : Option<&str>,
                     as_name : String) -> Result<(), InterpreterError> {
-        let module = match self.module_or_last(name.as_ref().map(|x| x.as_ref())) {
+        let module = match self.module_or_last(name) {
             Ok(module) => module,
             Err(_) => return Err(InterpreterError::Instantiation("No such modules registered".into())),
         };
@@ -326,7 +386,61 @@ impl SpecDriver {
     }
 }
 
-impl ImportResolver for SpecDriver {
+/// The imports of a `SpecDriver` at one point in time.
+pub struct Imports {
+    spec_module: SpecModule,
+    instances: HashMap<String, Arc<LoadedInstance>>,
+    shared: Arc<SgxMutex<()>>,
+}
+
+impl Imports {
+    /// Instantiates `module` against these imports and runs its start
+    /// function. The new instance is not registered.
+    pub fn instantiate(&self, module: &Module) -> Result<Arc<LoadedInstance>, InterpreterError> {
+        let lock = self.shared.clone();
+        let guard = lock.lock().unwrap();
+        let linker = Linker { imports: self, linked: Cell::new(false) };
+        let not_started = ModuleInstance::new(module, &linker)
+            .map_err(|e| InterpreterError::Instantiation(format!("ModuleInstance::new error on {:?}", e)))?;
+        let shared = if linker.linked.get() {
+            Some(lock.clone())
+        } else {
+            drop(guard);
+            None
+        };
+        let instance = not_started
+            .run_start(&mut SpecExternals)
+            .map_err(|trap| InterpreterError::Instantiation(format!("ModuleInstance::run_start error on {:?}", trap)))?;
+        Ok(Arc::new(LoadedInstance {
+            instance: SgxMutex::new(instance),
+            shared: SgxMutex::new(shared),
+        }))
+    }
+}
+
+// Resolves the imports of a module being instantiated, and notes whether
+// it shares state with other instances. Runs with the shared lock held.
+struct Linker<'a> {
+    imports: &'a Imports,
+    linked: Cell<bool>,
+}
+
+impl<'a> Linker<'a> {
+    fn export<R, F>(&self, module_name: &str, f: F) -> Result<R, InterpreterError>
+    where
+        F: FnOnce(&ModuleRef) -> Result<R, InterpreterError>,
+    {
+        self.linked.set(true);
+        let module = self.imports.instances.get(module_name).ok_or_else(|| {
+            InterpreterError::Instantiation(format!("Module not registered {}", module_name))
+        })?;
+        module.share(&self.imports.shared);
+        let instance = module.instance.lock().unwrap();
+        f(&*instance)
+    }
+}
+
+impl<'a> ImportResolver for Linker<'a> {
     fn resolve_func(
         &self,
         module_name: &str,
@@ -334,10 +448,10 @@ impl ImportResolver for SpecDriver {
         func_type: &Signature,
     ) -> Result<FuncRef, InterpreterError> {
         if module_name == "spectest" {
-            self.spec_module.resolve_func(field_name, func_type)
+            // A fresh host function, shared with no one.
+            self.imports.spec_module.resolve_func(field_name, func_type)
         } else {
-            self.module(module_name)?
-                .resolve_func(field_name, func_type)
+            self.export(module_name, |m| m.resolve_func(field_name, func_type))
         }
     }
 
@@ -348,10 +462,10 @@ impl ImportResolver for SpecDriver {
         global_type: &GlobalDescriptor,
     ) -> Result<GlobalRef, InterpreterError> {
         if module_name == "spectest" {
-            self.spec_module.resolve_global(field_name, global_type)
+            self.linked.set(true);
+            self.imports.spec_module.resolve_global(field_name, global_type)
         } else {
-            self.module(module_name)?
-                .resolve_global(field_name, global_type)
+            self.export(module_name, |m| m.resolve_global(field_name, global_type))
         }
     }
 
@@ -362,10 +476,10 @@ impl ImportResolver for SpecDriver {
         memory_type: &MemoryDescriptor,
     ) -> Result<MemoryRef, InterpreterError> {
         if module_name == "spectest" {
-            self.spec_module.resolve_memory(field_name, memory_type)
+            self.linked.set(true);
+            self.imports.spec_module.resolve_memory(field_name, memory_type)
         } else {
-            self.module(module_name)?
-                .resolve_memory(field_name, memory_type)
+            self.export(module_name, |m| m.resolve_memory(field_name, memory_type))
         }
     }
 
@@ -376,10 +490,10 @@ impl ImportResolver for SpecDriver {
         table_type: &TableDescriptor,
     ) -> Result<TableRef, InterpreterError> {
         if module_name == "spectest" {
-            self.spec_module.resolve_table(field_name, table_type)
+            self.linked.set(true);
+            self.imports.spec_module.resolve_table(field_name, table_type)
         } else {
-            self.module(module_name)?
-                .resolve_table(field_name, table_type)
+            self.export(module_name, |m| m.resolve_table(field_name, table_type))
         }
     }
 }
@@ -388,25 +502,21 @@ pub fn try_load_module(wasm: &[u8]) -> Result<Module, Error> {
     Module::from_buffer(wasm).map_err(|e| Error::Load(e.to_string()))
 }
 
-pub fn try_load(wasm: &[u8], spec_driver: &mut SpecDriver) -> Result<(), Error> {
+pub fn try_load(wasm: &[u8]) -> Result<(), Error> {
     let module = try_load_module(wasm)?;
     let instance = ModuleInstance::new(&module, &ImportsBuilder::default())?;
     instance
-        .run_start(spec_driver.spec_module())
+        .run_start(&mut SpecExternals)
         .map_err(|trap| Error::Start(trap))?;
     Ok(())
 }
 
-pub fn load_module(wasm: &[u8], name: &Option<String>, spec_driver: &mut SpecDriver) -> Result<ModuleRef, Error> {
+pub fn load_module(wasm: &[u8], name: &Option<String>, spec_driver: &mut SpecDriver) -> Result<Arc<LoadedInstance>, Error> {
     let module = try_load_module(wasm)?;
-    let instance = ModuleInstance::new(&module, spec_driver)
-        .map_err(|e| Error::Load(e.to_string()))?
-        .run_start(spec_driver.spec_module())
-        .map_err(|trap| Error::Start(trap))?;
+    let instance = spec_driver.imports().instantiate(&module)?;
 
     let module_name = name.clone();
     spec_driver.add_module(module_name, instance.clone());
 
     Ok(instance)
 }
-
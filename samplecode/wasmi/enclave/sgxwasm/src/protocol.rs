@@ -0,0 +1,415 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! The binary encoding of the actions the app runs in the enclave and of
+//! their results. The app includes this file as is, so it only uses `std`.
+//!
+//! Integers are little endian, strings and byte strings are prefixed by
+//! their length as a u32, and an optional string is a u8 flag followed by
+//! the string when the flag is 1. An action is
+//!
+//!     Invoke:     0, module: opt str, field: str, count: u16, value*count
+//!     Get:        1, module: opt str, field: str
+//!     LoadModule: 2, name: opt str, source
+//!     TryLoad:    3, source
+//!     Register:   4, name: opt str, as_name: str
+//!
+//! where a source is 0 followed by the module binary, or 1 followed by the
+//! SHA-256 of a module the enclave has loaded before, and a value is its
+//! type (0 to 4 for i32, i64, f32, f64 and v128) followed by its bits.
+//! A result is
+//!
+//!     Done:   0
+//!     Value:  1, value
+//!     Loaded: 2, hash: [u8; 32]
+//!     Error:  3, kind: u8, trap: u8, message: str
+
+use std::str;
+use std::string::String;
+use std::vec::Vec;
+
+pub type ModuleHash = [u8; 32];
+
+#[derive(Debug)]
+pub struct DecodeError;
+
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub enum BoundaryValue {
+    I32(i32),
+    I64(i64),
+    F32(u32),
+    F64(u64),
+    V128(u128),
+}
+
+#[derive(Debug)]
+pub enum ModuleSource<'a> {
+    Binary(&'a [u8]),
+    Cached(ModuleHash),
+}
+
+#[derive(Debug)]
+pub enum SgxWasmAction<'a> {
+    Invoke {
+        module: Option<&'a str>,
+        field: &'a str,
+        args: Vec<BoundaryValue>,
+    },
+    Get {
+        module: Option<&'a str>,
+        field: &'a str,
+    },
+    LoadModule {
+        name: Option<&'a str>,
+        module: ModuleSource<'a>,
+    },
+    TryLoad {
+        module: ModuleSource<'a>,
+    },
+    Register {
+        name: Option<&'a str>,
+        as_name: &'a str,
+    },
+}
+
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub enum TrapCode {
+    Unreachable,
+    MemoryAccessOutOfBounds,
+    TableAccessOutOfBounds,
+    ElemUninitialized,
+    DivisionByZero,
+    InvalidConversionToInt,
+    StackOverflow,
+    UnexpectedSignature,
+}
+
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub enum ErrorKind {
+    Validation,
+    Instantiation,
+    Function,
+    Table,
+    Memory,
+    Global,
+    Value,
+    Trap(TrapCode),
+    /// The enclave does not hold the module asked for by its hash; the app
+    /// sends the binary again.
+    NotCached,
+}
+
+#[derive(Debug)]
+pub struct BoundaryError {
+    pub kind: ErrorKind,
+    pub message: String,
+}
+
+#[derive(Debug)]
+pub enum ActionResult {
+    Done,
+    Value(BoundaryValue),
+    Loaded(ModuleHash),
+    Error(BoundaryError),
+}
+
+const TRAP_CODES: [TrapCode; 8] = [
+    TrapCode::Unreachable,
+    TrapCode::MemoryAccessOutOfBounds,
+    TrapCode::TableAccessOutOfBounds,
+    TrapCode::ElemUninitialized,
+    TrapCode::DivisionByZero,
+    TrapCode::InvalidConversionToInt,
+    TrapCode::StackOverflow,
+    TrapCode::UnexpectedSignature,
+];
+
+struct Reader<'a> {
+    buf: &'a [u8],
+}
+
+impl<'a> Reader<'a> {
+    fn bytes(&mut self, n: usize) -> Result<&'a [u8], DecodeError> {
+        if self.buf.len() < n {
+            return Err(DecodeError);
+        }
+        let (head, tail) = self.buf.split_at(n);
+        self.buf = tail;
+        Ok(head)
+    }
+
+    fn array<T: Default + AsMut<[u8]>>(&mut self) -> Result<T, DecodeError> {
+        let mut a = T::default();
+        let n = a.as_mut().len();
+        a.as_mut().copy_from_slice(self.bytes(n)?);
+        Ok(a)
+    }
+
+    fn u8(&mut self) -> Result<u8, DecodeError> {
+        Ok(self.bytes(1)?[0])
+    }
+
+    fn u16(&mut self) -> Result<u16, DecodeError> {
+        Ok(u16::from_le_bytes(self.array()?))
+    }
+
+    fn u32(&mut self) -> Result<u32, DecodeError> {
+        Ok(u32::from_le_bytes(self.array()?))
+    }
+
+    fn u64(&mut self) -> Result<u64, DecodeError> {
+        Ok(u64::from_le_bytes(self.array()?))
+    }
+
+    fn u128(&mut self) -> Result<u128, DecodeError> {
+        Ok(u128::from_le_bytes(self.array()?))
+    }
+
+    fn binary(&mut self) -> Result<&'a [u8], DecodeError> {
+        let n = self.u32()? as usize;
+        self.bytes(n)
+    }
+
+    fn str(&mut self) -> Result<&'a str, DecodeError> {
+        str::from_utf8(self.binary()?).map_err(|_| DecodeError)
+    }
+
+    fn opt_str(&mut self) -> Result<Option<&'a str>, DecodeError> {
+        match self.u8()? {
+            0 => Ok(None),
+            1 => Ok(Some(self.str()?)),
+            _ => Err(DecodeError),
+        }
+    }
+
+    fn value(&mut self) -> Result<BoundaryValue, DecodeError> {
+        Ok(match self.u8()? {
+            0 => BoundaryValue::I32(self.u32()? as i32),
+            1 => BoundaryValue::I64(self.u64()? as i64),
+            2 => BoundaryValue::F32(self.u32()?),
+            3 => BoundaryValue::F64(self.u64()?),
+            4 => BoundaryValue::V128(self.u128()?),
+            _ => return Err(DecodeError),
+        })
+    }
+
+    fn source(&mut self) -> Result<ModuleSource<'a>, DecodeError> {
+        match self.u8()? {
+            0 => Ok(ModuleSource::Binary(self.binary()?)),
+            1 => Ok(ModuleSource::Cached(self.array()?)),
+            _ => Err(DecodeError),
+        }
+    }
+
+    fn finish<T>(&self, t: T) -> Result<T, DecodeError> {
+        if self.buf.is_empty() {
+            Ok(t)
+        } else {
+            Err(DecodeError)
+        }
+    }
+}
+
+fn put_binary(out: &mut Vec<u8>, b: &[u8]) {
+    out.extend_from_slice(&(b.len() as u32).to_le_bytes());
+    out.extend_from_slice(b);
+}
+
+fn put_opt_str(out: &mut Vec<u8>, s: Option<&str>) {
+    match s {
+        None => out.push(0),
+        Some(s) => {
+            out.push(1);
+            put_binary(out, s.as_bytes());
+        }
+    }
+}
+
+fn put_value(out: &mut Vec<u8>, v: &BoundaryValue) {
+    match *v {
+        BoundaryValue::I32(v) => {
+            out.push(0);
+            out.extend_from_slice(&v.to_le_bytes());
+        }
+        BoundaryValue::I64(v) => {
+            out.push(1);
+            out.extend_from_slice(&v.to_le_bytes());
+        }
+        BoundaryValue::F32(v) => {
+            out.push(2);
+            out.extend_from_slice(&v.to_le_bytes());
+        }
+        BoundaryValue::F64(v) => {
+            out.push(3);
+            out.extend_from_slice(&v.to_le_bytes());
+        }
+        BoundaryValue::V128(v) => {
+            out.push(4);
+            out.extend_from_slice(&v.to_le_bytes());
+        }
+    }
+}
+
+fn put_source(out: &mut Vec<u8>, source: &ModuleSource) {
+    match *source {
+        ModuleSource::Binary(wasm) => {
+            out.push(0);
+            put_binary(out, wasm);
+        }
+        ModuleSource::Cached(ref hash) => {
+            out.push(1);
+            out.extend_from_slice(hash);
+        }
+    }
+}
+
+impl<'a> SgxWasmAction<'a> {
+    pub fn encode(&self, out: &mut Vec<u8>) {
+        match *self {
+            SgxWasmAction::Invoke { module, field, ref args } => {
+                out.push(0);
+                put_opt_str(out, module);
+                put_binary(out, field.as_bytes());
+                out.extend_from_slice(&(args.len() as u16).to_le_bytes());
+                for arg in args {
+                    put_value(out, arg);
+                }
+            }
+            SgxWasmAction::Get { module, field } => {
+                out.push(1);
+                put_opt_str(out, module);
+                put_binary(out, field.as_bytes());
+            }
+            SgxWasmAction::LoadModule { name, ref module } => {
+                out.push(2);
+                put_opt_str(out, name);
+                put_source(out, module);
+            }
+            SgxWasmAction::TryLoad { ref module } => {
+                out.push(3);
+                put_source(out, module);
+            }
+            SgxWasmAction::Register { name, as_name } => {
+                out.push(4);
+                put_opt_str(out, name);
+                put_binary(out, as_name.as_bytes());
+            }
+        }
+    }
+
+    /// Decodes an action, borrowing its strings and module binary from
+    /// `buf`.
+    pub fn decode(buf: &'a [u8]) -> Result<SgxWasmAction<'a>, DecodeError> {
+        let mut r = Reader { buf: buf };
+        let action = match r.u8()? {
+            0 => {
+                let module = r.opt_str()?;
+                let field = r.str()?;
+                let count = r.u16()? as usize;
+                // Every value takes at least five bytes.
+                if count > r.buf.len() / 5 {
+                    return Err(DecodeError);
+                }
+                let mut args = Vec::with_capacity(count);
+                for _ in 0..count {
+                    args.push(r.value()?);
+                }
+                SgxWasmAction::Invoke { module, field, args }
+            }
+            1 => {
+                let module = r.opt_str()?;
+                let field = r.str()?;
+                SgxWasmAction::Get { module, field }
+            }
+            2 => {
+                let name = r.opt_str()?;
+                let module = r.source()?;
+                SgxWasmAction::LoadModule { name, module }
+            }
+            3 => SgxWasmAction::TryLoad { module: r.source()? },
+            4 => {
+                let name = r.opt_str()?;
+                let as_name = r.str()?;
+                SgxWasmAction::Register { name, as_name }
+            }
+            _ => return Err(DecodeError),
+        };
+        r.finish(action)
+    }
+}
+
+impl ActionResult {
+    pub fn encode(&self, out: &mut Vec<u8>) {
+        match *self {
+            ActionResult::Done => out.push(0),
+            ActionResult::Value(ref v) => {
+                out.push(1);
+                put_value(out, v);
+            }
+            ActionResult::Loaded(ref hash) => {
+                out.push(2);
+                out.extend_from_slice(hash);
+            }
+            ActionResult::Error(ref e) => {
+                let (kind, trap) = match e.kind {
+                    ErrorKind::Validation => (0, 0),
+                    ErrorKind::Instantiation => (1, 0),
+                    ErrorKind::Function => (2, 0),
+                    ErrorKind::Table => (3, 0),
+                    ErrorKind::Memory => (4, 0),
+                    ErrorKind::Global => (5, 0),
+                    ErrorKind::Value => (6, 0),
+                    ErrorKind::Trap(code) => (7, TRAP_CODES.iter().position(|c| *c == code).unwrap() as u8),
+                    ErrorKind::NotCached => (8, 0),
+                };
+                out.push(3);
+                out.push(kind);
+                out.push(trap);
+                put_binary(out, e.message.as_bytes());
+            }
+        }
+    }
+
+    pub fn decode(buf: &[u8]) -> Result<ActionResult, DecodeError> {
+        let mut r = Reader { buf: buf };
+        let result = match r.u8()? {
+            0 => ActionResult::Done,
+            1 => ActionResult::Value(r.value()?),
+            2 => ActionResult::Loaded(r.array()?),
+            3 => {
+                let kind = r.u8()?;
+                let trap = r.u8()? as usize;
+                let kind = match kind {
+                    0 => ErrorKind::Validation,
+                    1 => ErrorKind::Instantiation,
+                    2 => ErrorKind::Function,
+                    3 => ErrorKind::Table,
+                    4 => ErrorKind::Memory,
+                    5 => ErrorKind::Global,
+                    6 => ErrorKind::Value,
+                    7 if trap < TRAP_CODES.len() => ErrorKind::Trap(TRAP_CODES[trap]),
+                    8 => ErrorKind::NotCached,
+                    _ => return Err(DecodeError),
+                };
+                let message = String::from(r.str()?);
+                ActionResult::Error(BoundaryError { kind, message })
+            }
+            _ => return Err(DecodeError),
+        };
+        r.finish(result)
+    }
+}
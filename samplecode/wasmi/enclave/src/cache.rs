@@ -0,0 +1,103 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Validated modules, keyed by the SHA-256 of their binary.
+//!
+//! Parsing and validating a module costs far more than instantiating it,
+//! so the enclave keeps the modules it has loaded across ECALLs and the app
+//! can ask for them again by hash alone. The cache is bounded by the bytes
+//! of the binaries it holds, an eighth of the enclave heap by default, and
+//! evicts the least recently used module first.
+
+use sgxwasm::ModuleHash;
+use std::collections::HashMap;
+use std::enclave;
+use std::sync::Arc;
+use wasmi::Module;
+
+// A module in memory is several times the size of its binary: the parsed
+// sections and the compiled code.
+const SIZE_FACTOR: usize = 4;
+
+struct Cached {
+    module: Arc<Module>,
+    size: usize,
+    last_use: u64,
+}
+
+pub struct ModuleCache {
+    modules: HashMap<ModuleHash, Cached>,
+    bytes: usize,
+    budget: usize,
+    clock: u64,
+}
+
+impl ModuleCache {
+    pub fn new(budget: usize) -> ModuleCache {
+        ModuleCache {
+            modules: HashMap::new(),
+            bytes: 0,
+            budget,
+            clock: 0,
+        }
+    }
+
+    pub fn with_default_budget() -> ModuleCache {
+        ModuleCache::new(enclave::get_heap_size() / 8)
+    }
+
+    /// Returns the module, shared, so that it can be used once the cache
+    /// is unlocked.
+    pub fn get(&mut self, hash: &ModuleHash) -> Option<Arc<Module>> {
+        self.clock += 1;
+        let clock = self.clock;
+        self.modules.get_mut(hash).map(|cached| {
+            cached.last_use = clock;
+            cached.module.clone()
+        })
+    }
+
+    /// Adds `module`, validated from a binary of `len` bytes, evicting
+    /// other modules to make room. A module larger than the whole budget
+    /// stays until the next insert.
+    pub fn insert(&mut self, hash: ModuleHash, module: Module, len: usize) -> Arc<Module> {
+        let size = len.saturating_mul(SIZE_FACTOR);
+        if let Some(old) = self.modules.remove(&hash) {
+            self.bytes -= old.size;
+        }
+        while self.bytes + size > self.budget && !self.modules.is_empty() {
+            self.evict();
+        }
+        self.clock += 1;
+        self.bytes += size;
+        let module = Arc::new(module);
+        let cached = Cached { module: module.clone(), size: size, last_use: self.clock };
+        self.modules.insert(hash, cached);
+        module
+    }
+
+    fn evict(&mut self) {
+        let oldest = self.modules
+                         .iter()
+                         .min_by_key(|&(_, cached)| cached.last_use)
+                         .map(|(hash, _)| *hash);
+        if let Some(hash) = oldest {
+            let cached = self.modules.remove(&hash).unwrap();
+            self.bytes -= cached.size;
+        }
+    }
+}
@@ -22,6 +22,7 @@
 #![cfg_attr(target_env = "sgx", feature(rustc_private))]
 
 extern crate sgx_types;
+extern crate sgx_tcrypto;
 #[cfg(not(target_env = "sgx"))]
 #[macro_use]
 extern crate sgx_tstd as std;
@@ -30,24 +31,31 @@ extern crate sgx_tstd as std;
 extern crate lazy_static;
 
 use std::prelude::v1::*;
-use std::sync::SgxMutex;
+use std::sync::{Arc, SgxMutex};
 use std::ptr;
 
 extern crate wasmi;
 extern crate sgxwasm;
 
-use sgxwasm::{SpecDriver, boundary_value_to_runtime_value, result_covert};
+mod cache;
+
+use cache::ModuleCache;
+use sgxwasm::{SpecDriver, SpecExternals, ActionResult, BoundaryError, ErrorKind, ModuleHash,
+              ModuleSource, SgxWasmAction, boundary_value_to_runtime_value,
+              interpreter_error_to_boundary_error, runtime_value_to_boundary_value};
 
 use sgx_types::*;
 use std::slice;
 
 use wasmi::{ModuleInstance, ImportsBuilder, RuntimeValue, Error as InterpreterError, Module};
 
-extern crate serde;
-extern crate serde_json;
-
 lazy_static!{
+    // Named instances. Only held to look them up or to add to them, never
+    // while running wasm code, so that calls into independent instances
+    // run concurrently.
     static ref SPECDRIVER: SgxMutex<SpecDriver> = SgxMutex::new(SpecDriver::new());
+    // Survives sgxwasm_init, which only forgets the instances.
+    static ref MODULES: SgxMutex<ModuleCache> = SgxMutex::new(ModuleCache::with_default_budget());
 }
 
 #[no_mangle]
@@ -58,172 +66,171 @@ fn sgxwasm_init() -> sgx_status_t {
     sgx_status_t::SGX_SUCCESS
 }
 
-fn wasm_invoke(module : Option<String>, field : String, args : Vec<RuntimeValue>)
+fn wasm_invoke(module : Option<&str>, field : &str, args : Vec<RuntimeValue>)
               -> Result<Option<RuntimeValue>, InterpreterError> {
-    let mut program = SPECDRIVER.lock().unwrap();
-    let module = program.module_or_last(module.as_ref().map(|x| x.as_ref()))
-                        .expect(&format!("Expected program to have loaded module {:?}", module));
-    module.invoke_export(&field, &args, program.spec_module())
+    let module = SPECDRIVER.lock().unwrap().module_or_last(module)?;
+    module.run(|instance| instance.invoke_export(field, &args, &mut SpecExternals))
 }
 
-fn wasm_get(module : Option<String>, field : String)
+fn wasm_get(module : Option<&str>, field : &str)
             -> Result<Option<RuntimeValue>, InterpreterError> {
-    let program = SPECDRIVER.lock().unwrap();
-    let module = match module {
-        None => {
-                 program
-                 .module_or_last(None)
-                 .expect(&format!("Expected program to have loaded module {:?}",
-                        "None"
-                 ))
-        },
-        Some(str) => {
-                 program
-                 .module_or_last(Some(&str))
-                 .expect(&format!("Expected program to have loaded module {:?}",
-                         str
-                 ))
-        }
-    };
-
-    let global = module.export_by_name(&field)
-                       .ok_or_else(|| {
-                           InterpreterError::Global(format!("Expected to have export with name {}", field))
-                       })?
-                       .as_global()
-                       .cloned()
-                       .ok_or_else(|| {
-                           InterpreterError::Global(format!("Expected export {} to be a global", field))
-                       })?;
-     Ok(Some(global.get()))
+    let module = SPECDRIVER.lock().unwrap().module_or_last(module)?;
+    module.run(|instance| {
+        let global = instance.export_by_name(field)
+                             .ok_or_else(|| {
+                                 InterpreterError::Global(format!("Expected to have export with name {}", field))
+                             })?
+                             .as_global()
+                             .cloned()
+                             .ok_or_else(|| {
+                                 InterpreterError::Global(format!("Expected export {} to be a global", field))
+                             })?;
+        Ok(Some(global.get()))
+    })
 }
 
 fn try_load_module(wasm: &[u8]) -> Result<Module, InterpreterError> {
     wasmi::Module::from_buffer(wasm).map_err(|e| InterpreterError::Instantiation(format!("Module::from_buffer error {:?}", e)))
 }
 
-fn wasm_try_load(wasm: Vec<u8>) -> Result<(), InterpreterError> {
-    let ref mut spec_driver = SPECDRIVER.lock().unwrap();
-    let module = try_load_module(&wasm[..])?;
-    let instance = ModuleInstance::new(&module, &ImportsBuilder::default())?;
+// Returns the validated module `source` names, validating and caching it
+// first if it comes as a binary. The cache is unlocked again on return.
+fn get_module(source: ModuleSource) -> Result<(Arc<Module>, ModuleHash), BoundaryError> {
+    match source {
+        ModuleSource::Cached(hash) => {
+            let cached = MODULES.lock().unwrap().get(&hash);
+            match cached {
+                Some(module) => Ok((module, hash)),
+                None => Err(BoundaryError {
+                    kind: ErrorKind::NotCached,
+                    message: "module is not cached".into(),
+                }),
+            }
+        }
+        ModuleSource::Binary(wasm) => {
+            let hash = sgx_tcrypto::rsgx_sha256_slice(wasm).map_err(|e| BoundaryError {
+                kind: ErrorKind::Instantiation,
+                message: format!("sha256 error {}", e.as_str()),
+            })?;
+            let cached = MODULES.lock().unwrap().get(&hash);
+            if let Some(module) = cached {
+                return Ok((module, hash));
+            }
+            // Validated without the lock. Threads racing on the same binary
+            // each validate it, and the last insert wins.
+            let module = try_load_module(wasm).map_err(interpreter_error_to_boundary_error)?;
+            let module = MODULES.lock().unwrap().insert(hash, module, wasm.len());
+            Ok((module, hash))
+        }
+    }
+}
+
+fn wasm_try_load(wasm: ModuleSource) -> Result<(), BoundaryError> {
+    let (module, _) = get_module(wasm)?;
+    let instance = ModuleInstance::new(&module, &ImportsBuilder::default())
+        .map_err(interpreter_error_to_boundary_error)?;
     instance
-        .run_start(spec_driver.spec_module())
-        .map_err(|trap| InterpreterError::Instantiation(format!("ModuleInstance::run_start error on {:?}", trap)))?;
+        .run_start(&mut SpecExternals)
+        .map_err(|trap| {
+            let e = InterpreterError::Instantiation(format!("ModuleInstance::run_start error on {:?}", trap));
+            interpreter_error_to_boundary_error(e)
+        })?;
     Ok(())
 }
 
-fn wasm_load_module(name: Option<String>, module: Vec<u8>)
-                    -> Result<(), InterpreterError> {
-    let ref mut spec_driver = SPECDRIVER.lock().unwrap();
-    let module = try_load_module(&module[..])?;
-    let instance = ModuleInstance::new(&module, &**spec_driver)
-        .map_err(|e| InterpreterError::Instantiation(format!("ModuleInstance::new error on {:?}", e)))?
-        .run_start(spec_driver.spec_module())
-        .map_err(|trap| InterpreterError::Instantiation(format!("ModuleInstance::run_start error on {:?}", trap)))?;
+fn wasm_load_module(name: Option<&str>, module: ModuleSource)
+                    -> Result<ModuleHash, BoundaryError> {
+    let (module, hash) = get_module(module)?;
+    // Instantiating runs the start function, which may take long, so it
+    // runs against a snapshot of the driver's imports and the driver is
+    // only locked again to register the instance.
+    let imports = SPECDRIVER.lock().unwrap().imports();
+    let instance = imports.instantiate(&module).map_err(interpreter_error_to_boundary_error)?;
 
-    spec_driver.add_module(name, instance.clone());
+    SPECDRIVER.lock().unwrap().add_module(name.map(String::from), instance);
 
-    Ok(())
+    Ok(hash)
 }
 
-fn wasm_register(name: &Option<String>, as_name: String)
+fn wasm_register(name: Option<&str>, as_name: &str)
                     -> Result<(), InterpreterError> {
     let ref mut spec_driver = SPECDRIVER.lock().unwrap();
-    spec_driver.register(name, as_name)
+    spec_driver.register(name, as_name.to_string())
+}
+
+fn value_result(r: Result<Option<RuntimeValue>, InterpreterError>) -> ActionResult {
+    match r {
+        Ok(None) => ActionResult::Done,
+        Ok(Some(v)) => ActionResult::Value(runtime_value_to_boundary_value(v)),
+        Err(e) => ActionResult::Error(interpreter_error_to_boundary_error(e)),
+    }
+}
+
+fn unit_result(r: Result<(), BoundaryError>) -> ActionResult {
+    match r {
+        Ok(()) => ActionResult::Done,
+        Err(e) => ActionResult::Error(e),
+    }
 }
 
 #[no_mangle]
 pub extern "C"
 fn sgxwasm_run_action(req_bin : *const u8, req_length: usize,
-                      result_bin : *mut u8, result_max_len: usize) -> sgx_status_t {
+                      result_bin : *mut u8, result_max_len: usize,
+                      result_len : *mut usize) -> sgx_status_t {
 
     let req_slice = unsafe { slice::from_raw_parts(req_bin, req_length) };
-    let action_req: sgxwasm::SgxWasmAction = serde_json::from_slice(req_slice).unwrap();
-
-    let response;
-    let return_status;
+    let action_req = match SgxWasmAction::decode(req_slice) {
+        Ok(action_req) => action_req,
+        Err(_) => return sgx_status_t::SGX_ERROR_INVALID_PARAMETER,
+    };
 
-    match action_req {
-        sgxwasm::SgxWasmAction::Invoke{module,field,args}=> {
+    let (result, error_status) = match action_req {
+        SgxWasmAction::Invoke{module,field,args}=> {
             let args = args.into_iter()
                            .map(|x| boundary_value_to_runtime_value(x))
                            .collect::<Vec<RuntimeValue>>();
-            let r = wasm_invoke(module, field, args);
-            let r = result_covert(r);
-            response = serde_json::to_string(&r).unwrap();
-            match r {
-                Ok(_) => {
-                    return_status = sgx_status_t::SGX_SUCCESS;
-                },
-                Err(_) => {
-                    return_status = sgx_status_t::SGX_ERROR_WASM_INTERPRETER_ERROR;
-               }
-            }
+            (value_result(wasm_invoke(module, field, args)),
+             sgx_status_t::SGX_ERROR_WASM_INTERPRETER_ERROR)
         },
-        sgxwasm::SgxWasmAction::Get{module,field} => {
-            let r = wasm_get(module, field);
-            let r = result_covert(r);
-            response = serde_json::to_string(&r).unwrap();
-            match r {
-                Ok(_v) => {
-                    return_status = sgx_status_t::SGX_SUCCESS;
-                },
-                Err(_x) => {
-                    return_status = sgx_status_t::SGX_ERROR_WASM_INTERPRETER_ERROR;
-                }
-            }
+        SgxWasmAction::Get{module,field} => {
+            (value_result(wasm_get(module, field)),
+             sgx_status_t::SGX_ERROR_WASM_INTERPRETER_ERROR)
         },
-        sgxwasm::SgxWasmAction::LoadModule{name,module} => {
-            let r = wasm_load_module(name.clone(), module);
-            response = serde_json::to_string(&r).unwrap();
-            match r {
-                Ok(_) => {
-                    return_status = sgx_status_t::SGX_SUCCESS;
-                },
-                Err(_x) => {
-                    return_status = sgx_status_t::SGX_ERROR_WASM_LOAD_MODULE_ERROR;
-                }
-            }
+        SgxWasmAction::LoadModule{name,module} => {
+            let result = match wasm_load_module(name, module) {
+                Ok(hash) => ActionResult::Loaded(hash),
+                Err(e) => ActionResult::Error(e),
+            };
+            (result, sgx_status_t::SGX_ERROR_WASM_LOAD_MODULE_ERROR)
         },
-        sgxwasm::SgxWasmAction::TryLoad{module} => {
-            let r = wasm_try_load(module);
-            response = serde_json::to_string(&r).unwrap();
-            match r {
-                Ok(()) => {
-                    return_status = sgx_status_t::SGX_SUCCESS;
-                },
-                Err(_x) => {
-                    return_status = sgx_status_t::SGX_ERROR_WASM_TRY_LOAD_ERROR;
-                }
-            }
+        SgxWasmAction::TryLoad{module} => {
+            (unit_result(wasm_try_load(module)),
+             sgx_status_t::SGX_ERROR_WASM_TRY_LOAD_ERROR)
         },
-        sgxwasm::SgxWasmAction::Register{name, as_name} => {
-            let r = wasm_register(&name, as_name.clone());
-            response = serde_json::to_string(&r).unwrap();
-            match r {
-                Ok(()) => {
-                    return_status = sgx_status_t::SGX_SUCCESS;
-                },
-                Err(_x) => {
-                    return_status = sgx_status_t::SGX_ERROR_WASM_REGISTER_ERROR;
-                }
-            }
+        SgxWasmAction::Register{name, as_name} => {
+            let r = wasm_register(name, as_name).map_err(interpreter_error_to_boundary_error);
+            (unit_result(r), sgx_status_t::SGX_ERROR_WASM_REGISTER_ERROR)
         }
-    }
+    };
 
-    //println!("len = {}, Response = {:?}", response.len(), response);
+    let return_status = match result {
+        ActionResult::Error(_) => error_status,
+        _ => sgx_status_t::SGX_SUCCESS,
+    };
+    let mut response = Vec::new();
+    result.encode(&mut response);
 
-    if response.len() < result_max_len {
+    if response.len() <= result_max_len {
         unsafe {
             ptr::copy_nonoverlapping(response.as_ptr(),
                                      result_bin,
                                      response.len());
+            *result_len = response.len();
         }
         return return_status;
     }
     else{
-        //println!("Result len = {} > buf size = {}", response.len(), result_max_len);
         return sgx_status_t::SGX_ERROR_WASM_BUFFER_TOO_SHORT;
     }
 }
-
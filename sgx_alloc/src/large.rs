@@ -0,0 +1,253 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Large allocations served from the reserved memory area.
+//!
+//! Allocations of at least the configured threshold bypass the trusted heap
+//! and take whole pages from the reserved memory area instead. With EDMM the
+//! pages of a run are only committed when the run is allocated, and freeing
+//! it trims them again, so a big working set no longer requires an equally
+//! big `HeapMaxSize`.
+//!
+//! Run lengths are rounded up to size classes with four steps per power of
+//! two, and a small cache keeps freed runs for reuse, since committing and
+//! trimming pages both cost enclave transitions. A run is recognised on
+//! free by its address, so changing the threshold at runtime is safe.
+
+use core::cell::UnsafeCell;
+use core::cmp;
+use core::ffi::c_void;
+use core::ptr::{self, NonNull};
+use core::sync::atomic::{spin_loop_hint, AtomicBool, AtomicUsize, Ordering};
+use crate::rsrvmem::RsrvMemAlloc;
+
+const SE_PAGE_SIZE: usize = 0x1000;
+
+// Slots in the cache of freed runs.
+const CACHE_SLOTS: usize = 32;
+const DEFAULT_CACHE_LIMIT: usize = 64 * 1024 * 1024;
+
+extern "C" {
+    fn get_rsrv_base() -> *const c_void;
+    fn get_rsrv_size() -> usize;
+}
+
+// usize::MAX disables the large path.
+static THRESHOLD: AtomicUsize = AtomicUsize::new(usize::MAX);
+static CACHE_LIMIT: AtomicUsize = AtomicUsize::new(DEFAULT_CACHE_LIMIT);
+// Set once the first run has been handed out; until then no pointer can be
+// a run and frees skip the range check.
+static IN_USE: AtomicBool = AtomicBool::new(false);
+static RSRV_BASE: AtomicUsize = AtomicUsize::new(0);
+static RSRV_END: AtomicUsize = AtomicUsize::new(0);
+
+#[derive(Clone, Copy)]
+struct Run {
+    addr: usize,
+    pages: usize,
+}
+
+struct RunCache {
+    runs: [Run; CACHE_SLOTS],
+    len: usize,
+    pages: usize,
+}
+
+struct Locked {
+    lock: AtomicBool,
+    cache: UnsafeCell<RunCache>,
+}
+
+unsafe impl Sync for Locked {}
+
+static CACHE: Locked = Locked {
+    lock: AtomicBool::new(false),
+    cache: UnsafeCell::new(RunCache {
+        runs: [Run { addr: 0, pages: 0 }; CACHE_SLOTS],
+        len: 0,
+        pages: 0,
+    }),
+};
+
+impl Locked {
+    // The allocator cannot use the SDK mutexes, which may allocate; the
+    // critical sections are a few dozen instructions.
+    fn with<R, F: FnOnce(&mut RunCache) -> R>(&self, f: F) -> R {
+        while self
+            .lock
+            .compare_exchange_weak(false, true, Ordering::Acquire, Ordering::Relaxed)
+            .is_err()
+        {
+            while self.lock.load(Ordering::Relaxed) {
+                spin_loop_hint();
+            }
+        }
+        let r = f(unsafe { &mut *self.cache.get() });
+        self.lock.store(false, Ordering::Release);
+        r
+    }
+}
+
+impl RunCache {
+    fn take(&mut self, pages: usize) -> Option<usize> {
+        let pos = self.runs[..self.len].iter().position(|run| run.pages == pages)?;
+        let run = self.runs[pos];
+        self.len -= 1;
+        self.runs[pos] = self.runs[self.len];
+        self.pages -= run.pages;
+        Some(run.addr)
+    }
+
+    fn put(&mut self, addr: usize, pages: usize) -> bool {
+        let limit = CACHE_LIMIT.load(Ordering::Relaxed) / SE_PAGE_SIZE;
+        if self.len == CACHE_SLOTS || self.pages + pages > limit {
+            return false;
+        }
+        self.runs[self.len] = Run { addr, pages };
+        self.len += 1;
+        self.pages += pages;
+        true
+    }
+
+    fn pop(&mut self) -> Option<Run> {
+        if self.len == 0 {
+            return None;
+        }
+        self.len -= 1;
+        self.pages -= self.runs[self.len].pages;
+        Some(self.runs[self.len])
+    }
+}
+
+pub fn threshold() -> usize {
+    THRESHOLD.load(Ordering::Relaxed)
+}
+
+pub fn set_threshold(bytes: usize) {
+    if bytes != usize::MAX {
+        init_range();
+    }
+    THRESHOLD.store(cmp::max(bytes, SE_PAGE_SIZE), Ordering::Relaxed);
+}
+
+pub fn set_cache_limit(bytes: usize) {
+    CACHE_LIMIT.store(bytes, Ordering::Relaxed);
+    trim_cache(bytes);
+}
+
+fn init_range() {
+    if RSRV_END.load(Ordering::Relaxed) != 0 {
+        return;
+    }
+    let (base, size) = unsafe { (get_rsrv_base() as usize, get_rsrv_size()) };
+    RSRV_BASE.store(base, Ordering::Relaxed);
+    RSRV_END.store(base + size, Ordering::Relaxed);
+}
+
+/// Whether `layout` should be served from the reserved memory area.
+#[inline]
+pub fn wants(size: usize, align: usize) -> bool {
+    size >= THRESHOLD.load(Ordering::Relaxed) && align <= SE_PAGE_SIZE
+}
+
+/// Whether `ptr` is a run handed out by this module.
+#[inline]
+pub fn owns(ptr: *mut u8) -> bool {
+    if !IN_USE.load(Ordering::Relaxed) {
+        return false;
+    }
+    let addr = ptr as usize;
+    addr >= RSRV_BASE.load(Ordering::Relaxed) && addr < RSRV_END.load(Ordering::Relaxed)
+}
+
+// Rounds `size` up to whole pages and then to its size class.
+#[inline]
+fn class_pages(size: usize) -> usize {
+    let pages = (size + SE_PAGE_SIZE - 1) / SE_PAGE_SIZE;
+    if pages <= 4 {
+        return pages;
+    }
+    let log2 = usize::MAX.count_ones() - 1 - pages.leading_zeros();
+    let step = 1 << (log2 - 2);
+    (pages + step - 1) & !(step - 1)
+}
+
+/// Whether a run holding `old_size` bytes can also hold `new_size` bytes.
+#[inline]
+pub fn same_class(old_size: usize, new_size: usize) -> bool {
+    class_pages(old_size) == class_pages(new_size)
+}
+
+/// Allocates a run for `size` bytes, or returns null if the reserved memory
+/// area cannot provide one and the caller should use the heap instead.
+pub unsafe fn alloc(size: usize, zeroed: bool) -> *mut u8 {
+    let pages = class_pages(size);
+    if let Some(addr) = CACHE.with(|cache| cache.take(pages)) {
+        let ptr = addr as *mut u8;
+        if zeroed {
+            ptr::write_bytes(ptr, 0, pages * SE_PAGE_SIZE);
+        }
+        return ptr;
+    }
+    if pages > u32::MAX as usize {
+        return ptr::null_mut();
+    }
+
+    let mut ptr = RsrvMemAlloc.alloc(pages as u32);
+    if ptr.is_err() && CACHE.with(|cache| cache.len) != 0 {
+        // The cached runs may be what is in the way.
+        trim_cache(0);
+        ptr = RsrvMemAlloc.alloc(pages as u32);
+    }
+    match ptr {
+        Ok(ptr) => {
+            IN_USE.store(true, Ordering::Relaxed);
+            // Fresh pages are zero with EDMM, but without it the area is
+            // committed up front and may hold data from an earlier run.
+            if zeroed {
+                ptr::write_bytes(ptr.as_ptr(), 0, pages * SE_PAGE_SIZE);
+            }
+            ptr.as_ptr()
+        }
+        Err(_) => ptr::null_mut(),
+    }
+}
+
+pub unsafe fn dealloc(ptr: *mut u8, size: usize) {
+    let pages = class_pages(size);
+    if !CACHE.with(|cache| cache.put(ptr as usize, pages)) {
+        let _ = RsrvMemAlloc.dealloc(NonNull::new_unchecked(ptr), pages as u32);
+    }
+}
+
+fn trim_cache(limit: usize) {
+    loop {
+        let run = CACHE.with(|cache| {
+            if cache.pages * SE_PAGE_SIZE > limit {
+                cache.pop()
+            } else {
+                None
+            }
+        });
+        match run {
+            Some(run) => unsafe {
+                let _ = RsrvMemAlloc.dealloc(NonNull::new_unchecked(run.addr as *mut u8), run.pages as u32);
+            },
+            None => break,
+        }
+    }
+}
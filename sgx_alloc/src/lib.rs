@@ -35,6 +35,7 @@
 
 extern crate alloc;
 
+mod large;
 mod system;
 pub use system::System;
 
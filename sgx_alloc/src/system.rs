@@ -27,6 +27,7 @@ use core::alloc::{
 };
 use core::intrinsics;
 use core::ptr::{self, NonNull};
+use crate::large;
 
 // The minimum alignment guaranteed by the architecture. This value is used to
 // add fast paths for low alignment values. In practice, the alignment is a
@@ -42,6 +43,29 @@ const MIN_ALIGN: usize = 16;
 pub struct System;
 
 impl System {
+    /// Serves allocations of at least `bytes` bytes from the reserved memory
+    /// area instead of the trusted heap, or stops doing so for `None`.
+    ///
+    /// The reserved memory area is sized by `ReservedMemMaxSize` in the
+    /// enclave configuration. Allocations fall back to the heap once it is
+    /// exhausted. Thresholds below one page are rounded up to a page.
+    pub fn set_rsrv_threshold(bytes: Option<usize>) {
+        large::set_threshold(bytes.unwrap_or(usize::MAX))
+    }
+
+    pub fn rsrv_threshold() -> Option<usize> {
+        match large::threshold() {
+            usize::MAX => None,
+            bytes => Some(bytes),
+        }
+    }
+
+    /// Sets how many bytes of freed reserved memory runs are kept for reuse
+    /// rather than returned to the reserved memory area. Defaults to 64 MiB.
+    pub fn set_rsrv_cache_limit(bytes: usize) {
+        large::set_cache_limit(bytes)
+    }
+
     #[inline]
     fn alloc_impl(&self, layout: Layout, zeroed: bool) -> Result<NonNull<[u8]>, AllocError> {
         match layout.size() {
@@ -221,6 +245,12 @@ mod platform {
     unsafe impl GlobalAlloc for System {
         #[inline]
         unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+            if large::wants(layout.size(), layout.align()) {
+                let ptr = large::alloc(layout.size(), false);
+                if !ptr.is_null() {
+                    return ptr;
+                }
+            }
             if layout.align() <= MIN_ALIGN && layout.align() <= layout.size() {
                 libc::malloc(layout.size()) as *mut u8
             } else {
@@ -230,6 +260,12 @@ mod platform {
 
         #[inline]
         unsafe fn alloc_zeroed(&self, layout: Layout) -> *mut u8 {
+            if large::wants(layout.size(), layout.align()) {
+                let ptr = large::alloc(layout.size(), true);
+                if !ptr.is_null() {
+                    return ptr;
+                }
+            }
             if layout.align() <= MIN_ALIGN && layout.align() <= layout.size() {
                 libc::calloc(layout.size(), 1) as *mut u8
             } else {
@@ -242,12 +278,25 @@ mod platform {
         }
 
         #[inline]
-        unsafe fn dealloc(&self, ptr: *mut u8, _layout: Layout) {
-            libc::free(ptr as *mut c_void)
+        unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+            if large::owns(ptr) {
+                large::dealloc(ptr, layout.size())
+            } else {
+                libc::free(ptr as *mut c_void)
+            }
         }
 
         #[inline]
         unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+            if large::owns(ptr) {
+                if large::same_class(layout.size(), new_size) {
+                    return ptr;
+                }
+                return self.realloc_fallback(ptr, layout, new_size);
+            }
+            if large::wants(new_size, layout.align()) {
+                return self.realloc_fallback(ptr, layout, new_size);
+            }
             if layout.align() <= MIN_ALIGN && layout.align() <= new_size {
                 libc::realloc(ptr as *mut c_void, new_size) as *mut u8
             } else {
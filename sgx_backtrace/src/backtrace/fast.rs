@@ -0,0 +1,182 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Stack walks over the cached unwind index.
+//!
+//! The index of the enclave image is built once, by `init_unwind_index` or
+//! on the first walk, and shared by all threads from then on. A walk only
+//! reads the stack of the current thread and the index, takes no lock and
+//! allocates nothing.
+
+use super::index::{Cfa, UnwindIndex};
+use alloc::boxed::Box;
+use core::ffi::c_void;
+use core::ptr;
+use core::sync::atomic::{AtomicPtr, AtomicBool, Ordering};
+use sgx_trts::enclave::{rsgx_get_enclave_base, SgxThreadData};
+
+static INDEX: AtomicPtr<UnwindIndex> = AtomicPtr::new(ptr::null_mut());
+static NO_INDEX: AtomicBool = AtomicBool::new(false);
+
+/// Builds the unwind index of the enclave image, unless that has been done
+/// already, and returns whether it is available.
+///
+/// Building the index parses the call frame information of every function
+/// in the enclave, which takes a while for large enclaves. Call this during
+/// enclave initialization to keep that out of the first `trace_fast`.
+pub fn init_unwind_index() -> bool {
+    unwind_index().is_some()
+}
+
+pub(crate) fn unwind_index() -> Option<&'static UnwindIndex> {
+    let index = INDEX.load(Ordering::Acquire);
+    if !index.is_null() {
+        return Some(unsafe { &*index });
+    }
+    if NO_INDEX.load(Ordering::Relaxed) {
+        return None;
+    }
+
+    let base = rsgx_get_enclave_base() as usize;
+    let index = match unsafe { UnwindIndex::from_image(base) } {
+        Some(index) => Box::into_raw(Box::new(index)),
+        None => {
+            NO_INDEX.store(true, Ordering::Relaxed);
+            return None;
+        }
+    };
+    // The index lives as long as the enclave. Threads that raced to build
+    // it keep the first one.
+    match INDEX.compare_exchange(ptr::null_mut(), index, Ordering::AcqRel, Ordering::Acquire) {
+        Ok(_) => Some(unsafe { &*index }),
+        Err(current) => {
+            drop(unsafe { Box::from_raw(index) });
+            Some(unsafe { &*current })
+        }
+    }
+}
+
+/// Captures the return addresses of the current call stack into `ips`,
+/// starting with the caller of `trace_fast`, and returns how many were
+/// stored.
+///
+/// Unlike `trace`, this walks the stack with the unwind index of the enclave
+/// image, and falls back to the frame pointer for code the index does not
+/// describe. It takes no lock and does not allocate, so it is cheap enough
+/// to call on hot paths. The walk stops at the first frame it cannot unwind,
+/// which may come earlier than with `trace`.
+///
+/// Returns 0 if the enclave image has no usable `.eh_frame_hdr`. The
+/// addresses can be resolved like the `ip` of a `Frame`.
+#[inline(never)]
+pub fn trace_fast(ips: &mut [*mut c_void]) -> usize {
+    let index = match unwind_index() {
+        Some(index) => index,
+        None => return 0,
+    };
+    let thread = SgxThreadData::current();
+    let stack = Stack {
+        lo: thread.stack_limit(),
+        hi: thread.stack_base(),
+    };
+
+    let (mut ip, mut sp, mut bp): (usize, usize, usize);
+    unsafe {
+        asm!(
+            "lea {ip}, [rip]",
+            "mov {sp}, rsp",
+            "mov {bp}, rbp",
+            ip = out(reg) ip,
+            sp = out(reg) sp,
+            bp = out(reg) bp,
+            options(nomem, nostack, preserves_flags)
+        );
+    }
+
+    // The first `ip` is the instruction itself, later ones are return
+    // addresses, which may be past the end of the calling function.
+    let mut pc = ip;
+    let mut count = 0;
+    while count < ips.len() {
+        let (cfa, next_bp) = match index.lookup(pc) {
+            Some((_, row)) if row.cfa != Cfa::Unknown => {
+                let cfa = match row.cfa {
+                    Cfa::Rsp => sp,
+                    _ => bp,
+                }
+                .wrapping_add(row.cfa_off as usize);
+                let next_bp = if row.rbp_slot == 0 {
+                    bp
+                } else {
+                    match stack.read(cfa.wrapping_sub(8 * row.rbp_slot as usize)) {
+                        Some(bp) => bp,
+                        None => break,
+                    }
+                };
+                (cfa, next_bp)
+            }
+            _ => {
+                // Assume a frame pointer chain: the caller's `rbp` at `rbp`
+                // and the return address above it.
+                match stack.read(bp) {
+                    Some(next_bp) => (bp.wrapping_add(16), next_bp),
+                    None => break,
+                }
+            }
+        };
+        let ret = match stack.read(cfa.wrapping_sub(8)) {
+            Some(ret) => ret,
+            None => break,
+        };
+        // Every frame has to move up the stack, or the walk could loop.
+        if cfa <= sp || !index.contains(ret) {
+            break;
+        }
+
+        ips[count] = ret as *mut c_void;
+        count += 1;
+        sp = cfa;
+        bp = next_bp;
+        ip = ret;
+        pc = ip - 1;
+    }
+    count
+}
+
+/// Returns the start of the function holding the return address `ip`, or
+/// `ip` itself if the unwind index does not know the function.
+pub fn symbol_address_fast(ip: *mut c_void) -> *mut c_void {
+    let ip = ip as usize;
+    unwind_index()
+        .and_then(|index| index.lookup(ip.wrapping_sub(1)))
+        .map_or(ip, |(start, _)| start) as *mut c_void
+}
+
+// The stack of the current thread. Reads outside of it fail.
+struct Stack {
+    lo: usize,
+    hi: usize,
+}
+
+impl Stack {
+    fn read(&self, addr: usize) -> Option<usize> {
+        if addr < self.lo || addr > self.hi.wrapping_sub(8) || addr % 8 != 0 {
+            return None;
+        }
+        Some(unsafe { ptr::read(addr as *const usize) })
+    }
+}
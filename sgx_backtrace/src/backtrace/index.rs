@@ -0,0 +1,865 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! A compact unwind table for the enclave image.
+//!
+//! libunwind looks up the FDE of every frame and runs its DWARF call frame
+//! program on each walk. The index runs all of these programs once, for the
+//! FDEs listed in the image's `.eh_frame_hdr`, and keeps their outcome as
+//! sorted rows: from a given address on, the CFA is `rsp` or `rbp` plus an
+//! offset, the return address sits right below the CFA, and `rbp` is either
+//! left alone or saved at a fixed slot below the CFA. That covers the code
+//! compilers generate for x86_64. Anything else, such as DWARF expressions,
+//! turns the affected rows into unknown ones, where a walk has to fall back
+//! to the frame pointer. An FDE whose program cannot be run at all, such as
+//! one with an opcode the index does not know, gets a single unknown row.
+
+#![allow(non_upper_case_globals)]
+
+use alloc::vec::Vec;
+use core::mem;
+use core::ptr;
+
+const PT_LOAD: u32 = 1;
+const PT_GNU_EH_FRAME: u32 = 0x6474_e550;
+const PF_X: u32 = 1;
+
+const DW_EH_PE_absptr: u8 = 0x00;
+const DW_EH_PE_uleb128: u8 = 0x01;
+const DW_EH_PE_udata2: u8 = 0x02;
+const DW_EH_PE_udata4: u8 = 0x03;
+const DW_EH_PE_udata8: u8 = 0x04;
+const DW_EH_PE_sleb128: u8 = 0x09;
+const DW_EH_PE_sdata2: u8 = 0x0a;
+const DW_EH_PE_sdata4: u8 = 0x0b;
+const DW_EH_PE_sdata8: u8 = 0x0c;
+const DW_EH_PE_pcrel: u8 = 0x10;
+const DW_EH_PE_datarel: u8 = 0x30;
+const DW_EH_PE_omit: u8 = 0xff;
+
+const DW_CFA_advance_loc: u8 = 0x40;
+const DW_CFA_offset: u8 = 0x80;
+const DW_CFA_restore: u8 = 0xc0;
+const DW_CFA_nop: u8 = 0x00;
+const DW_CFA_set_loc: u8 = 0x01;
+const DW_CFA_advance_loc1: u8 = 0x02;
+const DW_CFA_advance_loc2: u8 = 0x03;
+const DW_CFA_advance_loc4: u8 = 0x04;
+const DW_CFA_offset_extended: u8 = 0x05;
+const DW_CFA_restore_extended: u8 = 0x06;
+const DW_CFA_undefined: u8 = 0x07;
+const DW_CFA_same_value: u8 = 0x08;
+const DW_CFA_register: u8 = 0x09;
+const DW_CFA_remember_state: u8 = 0x0a;
+const DW_CFA_restore_state: u8 = 0x0b;
+const DW_CFA_def_cfa: u8 = 0x0c;
+const DW_CFA_def_cfa_register: u8 = 0x0d;
+const DW_CFA_def_cfa_offset: u8 = 0x0e;
+const DW_CFA_def_cfa_expression: u8 = 0x0f;
+const DW_CFA_expression: u8 = 0x10;
+const DW_CFA_offset_extended_sf: u8 = 0x11;
+const DW_CFA_def_cfa_sf: u8 = 0x12;
+const DW_CFA_def_cfa_offset_sf: u8 = 0x13;
+const DW_CFA_val_offset: u8 = 0x14;
+const DW_CFA_val_offset_sf: u8 = 0x15;
+const DW_CFA_val_expression: u8 = 0x16;
+const DW_CFA_GNU_args_size: u8 = 0x2e;
+const DW_CFA_GNU_negative_offset_extended: u8 = 0x2f;
+
+// DWARF register numbers on x86_64.
+const DWARF_RBP: u64 = 6;
+const DWARF_RSP: u64 = 7;
+const DWARF_RA: u64 = 16;
+
+/// Where the CFA of a row is computed from.
+#[derive(Clone, Copy, PartialEq, Eq, Debug)]
+pub enum Cfa {
+    Rsp,
+    Rbp,
+    Unknown,
+}
+
+/// The unwind rule from `pc` on, up to the next row.
+#[derive(Clone, Copy, PartialEq, Eq, Debug)]
+pub struct Row {
+    /// Offset from the image base.
+    pub pc: u32,
+    pub cfa_off: u32,
+    pub cfa: Cfa,
+    /// The caller's `rbp` is at `CFA - 8 * rbp_slot`, or still in `rbp` if 0.
+    pub rbp_slot: u8,
+}
+
+#[derive(Clone, Copy)]
+struct Fde {
+    start: u32,
+    end: u32,
+    // The first row of this FDE; the rows run up to the first of the next.
+    row: u32,
+}
+
+/// The unwind rows of all FDEs of an image, sorted by address.
+pub struct UnwindIndex {
+    base: usize,
+    text: (usize, usize),
+    fdes: Vec<Fde>,
+    rows: Vec<Row>,
+}
+
+impl UnwindIndex {
+    /// Builds the index of the ELF image loaded at `base`. Returns `None` if
+    /// it has no `.eh_frame_hdr` with a search table.
+    ///
+    /// # Safety
+    ///
+    /// `base` must point to the ELF header of an image mapped as its program
+    /// headers say.
+    pub unsafe fn from_image(base: usize) -> Option<UnwindIndex> {
+        let ehdr = &*(base as *const Elf64Ehdr);
+        if ehdr.e_ident[..4] != *b"\x7fELF" || ehdr.e_phentsize as usize != mem::size_of::<Elf64Phdr>() {
+            return None;
+        }
+
+        let mut image_end = base;
+        let mut text = (usize::max_value(), 0);
+        let mut eh_frame_hdr = None;
+        for i in 0..ehdr.e_phnum as usize {
+            let phdr = &*((base + ehdr.e_phoff as usize) as *const Elf64Phdr).add(i);
+            let start = base.checked_add(phdr.p_vaddr as usize)?;
+            let end = start.checked_add(phdr.p_memsz as usize)?;
+            match phdr.p_type {
+                PT_LOAD => {
+                    image_end = image_end.max(end);
+                    if phdr.p_flags & PF_X != 0 {
+                        text = (text.0.min(start), text.1.max(end));
+                    }
+                }
+                PT_GNU_EH_FRAME => eh_frame_hdr = Some((start, end)),
+                _ => {}
+            }
+        }
+        let (hdr, hdr_end) = eh_frame_hdr?;
+        if text.0 >= text.1 || text.1 - base > u32::max_value() as usize {
+            return None;
+        }
+
+        let mut index = UnwindIndex {
+            base,
+            text,
+            fdes: Vec::new(),
+            rows: Vec::new(),
+        };
+        index.parse(hdr, hdr_end, image_end)?;
+        index.fdes.shrink_to_fit();
+        index.rows.shrink_to_fit();
+        Some(index)
+    }
+
+    /// Whether `ip` lies in the executable part of the image.
+    pub fn contains(&self, ip: usize) -> bool {
+        ip >= self.text.0 && ip < self.text.1
+    }
+
+    /// Returns the start of the function holding `ip` and the row in force
+    /// at `ip`.
+    pub fn lookup(&self, ip: usize) -> Option<(usize, Row)> {
+        if !self.contains(ip) {
+            return None;
+        }
+        let off = (ip - self.base) as u32;
+        let i = upper_bound(&self.fdes, |fde| fde.start <= off).checked_sub(1)?;
+        let fde = self.fdes[i];
+        if off >= fde.end {
+            return None;
+        }
+        let rows_end = self.fdes.get(i + 1).map_or(self.rows.len(), |next| next.row as usize);
+        let rows = &self.rows[fde.row as usize..rows_end];
+        let j = upper_bound(rows, |row| row.pc <= off).checked_sub(1)?;
+        Some((self.base + fde.start as usize, rows[j]))
+    }
+
+    pub fn len(&self) -> usize {
+        self.fdes.len()
+    }
+
+    /// Memory taken by the tables.
+    pub fn size(&self) -> usize {
+        self.fdes.capacity() * mem::size_of::<Fde>() + self.rows.capacity() * mem::size_of::<Row>()
+    }
+
+    unsafe fn parse(&mut self, hdr: usize, hdr_end: usize, image_end: usize) -> Option<()> {
+        let mut r = Reader::new(hdr, hdr_end);
+        let version = r.u8()?;
+        let eh_frame_ptr_enc = r.u8()?;
+        let fde_count_enc = r.u8()?;
+        let table_enc = r.u8()?;
+        if version != 1 || fde_count_enc == DW_EH_PE_omit || table_enc != (DW_EH_PE_datarel | DW_EH_PE_sdata4) {
+            return None;
+        }
+        r.pointer(eh_frame_ptr_enc, hdr)?;
+        let count = r.pointer(fde_count_enc, hdr)?;
+        if count > (hdr_end - r.pos) / 8 {
+            return None;
+        }
+        self.fdes.reserve(count);
+        self.rows.reserve(count * 4);
+
+        let mut cie_cache = None;
+        for _ in 0..count {
+            r.pointer(table_enc, hdr)?;
+            let fde = r.pointer(table_enc, hdr)?;
+            if fde < self.base || fde >= image_end {
+                return None;
+            }
+            self.add_fde(fde, image_end, &mut cie_cache)?;
+        }
+        Some(())
+    }
+
+    unsafe fn add_fde(&mut self, fde: usize, image_end: usize, cie_cache: &mut Option<Cie>) -> Option<()> {
+        let mut r = Reader::new(fde, image_end);
+        let end = r.entry_end()?;
+        let cie_ptr = r.pos;
+        let cie_off = r.u32()? as usize;
+        if cie_off == 0 {
+            return None;
+        }
+        let cie_addr = cie_ptr.checked_sub(cie_off)?;
+        let cie = match *cie_cache {
+            Some(ref cie) if cie.addr == cie_addr => cie.clone(),
+            _ => {
+                let cie = Cie::parse(cie_addr, image_end)?;
+                *cie_cache = Some(cie.clone());
+                cie
+            }
+        };
+
+        let start = r.pointer(cie.fde_enc, 0)?;
+        let len = r.pointer(cie.fde_enc & 0x0f, 0)?;
+        if cie.augmented {
+            let aug_len = r.uleb()? as usize;
+            r.skip(aug_len)?;
+        }
+        if !self.contains(start) || len > self.text.1 - start {
+            // FDEs of code outside the image text, if any, do not matter.
+            return Some(());
+        }
+
+        let first_row = self.rows.len() as u32;
+        let mut run = Run {
+            base: self.base,
+            cie: &cie,
+            loc: start,
+            state: State::default(),
+            initial: State::default(),
+            stack: Vec::new(),
+            rows: &mut self.rows,
+            first_row: first_row as usize,
+        };
+        let ran = run.exec(cie.insns, cie.insns_end, false).is_some() && {
+            run.initial = run.state.clone();
+            run.exec(r.pos, end, true).is_some()
+        };
+        if ran {
+            run.emit();
+        } else {
+            self.rows.truncate(first_row as usize);
+            self.rows.push(Row {
+                pc: (start - self.base) as u32,
+                cfa_off: 0,
+                cfa: Cfa::Unknown,
+                rbp_slot: 0,
+            });
+        }
+
+        self.fdes.push(Fde {
+            start: (start - self.base) as u32,
+            end: (start + len - self.base) as u32,
+            row: first_row,
+        });
+        Some(())
+    }
+}
+
+#[derive(Clone)]
+struct Cie {
+    addr: usize,
+    code_align: u64,
+    data_align: i64,
+    fde_enc: u8,
+    augmented: bool,
+    insns: usize,
+    insns_end: usize,
+}
+
+impl Cie {
+    unsafe fn parse(addr: usize, image_end: usize) -> Option<Cie> {
+        let mut r = Reader::new(addr, image_end);
+        let end = r.entry_end()?;
+        if r.u32()? != 0 {
+            return None;
+        }
+        let version = r.u8()?;
+        let aug = r.pos;
+        while r.u8()? != 0 {}
+        let aug = Reader::new(aug, r.pos - 1);
+        let code_align = r.uleb()?;
+        let data_align = r.sleb()?;
+        let ra = if version == 1 { r.u8()? as u64 } else { r.uleb()? };
+        if ra != DWARF_RA {
+            return None;
+        }
+
+        let mut cie = Cie {
+            addr,
+            code_align,
+            data_align,
+            fde_enc: DW_EH_PE_absptr,
+            augmented: false,
+            insns: 0,
+            insns_end: end,
+        };
+        let mut aug = aug;
+        if aug.pos < aug.end {
+            if aug.u8()? != b'z' {
+                return None;
+            }
+            cie.augmented = true;
+            let aug_len = r.uleb()? as usize;
+            let aug_data_end = r.pos.checked_add(aug_len)?;
+            while aug.pos < aug.end {
+                match aug.u8()? {
+                    b'R' => cie.fde_enc = r.u8()?,
+                    b'P' => {
+                        let enc = r.u8()?;
+                        r.pointer(enc, 0)?;
+                    }
+                    b'L' => {
+                        r.u8()?;
+                    }
+                    b'S' => {}
+                    // The rest of the data is skipped as a whole below.
+                    _ => break,
+                }
+            }
+            r.pos = aug_data_end;
+        }
+        if r.pos > end {
+            return None;
+        }
+        cie.insns = r.pos;
+        Some(cie)
+    }
+}
+
+#[derive(Clone, Copy, PartialEq, Eq)]
+enum Rule {
+    Same,
+    Offset(i64),
+    Unknown,
+}
+
+#[derive(Clone, PartialEq, Eq)]
+struct State {
+    cfa_reg: Option<u64>,
+    cfa_off: i64,
+    rbp: Rule,
+    ra: Rule,
+}
+
+impl Default for State {
+    fn default() -> State {
+        State {
+            cfa_reg: None,
+            cfa_off: 0,
+            rbp: Rule::Same,
+            ra: Rule::Unknown,
+        }
+    }
+}
+
+struct Run<'a> {
+    base: usize,
+    cie: &'a Cie,
+    loc: usize,
+    state: State,
+    initial: State,
+    stack: Vec<State>,
+    rows: &'a mut Vec<Row>,
+    first_row: usize,
+}
+
+impl<'a> Run<'a> {
+    unsafe fn exec(&mut self, start: usize, end: usize, fde: bool) -> Option<()> {
+        let mut r = Reader::new(start, end);
+        let data_align = self.cie.data_align;
+        while r.pos < end {
+            let op = r.u8()?;
+            match op & 0xc0 {
+                DW_CFA_advance_loc => {
+                    self.advance((op & 0x3f) as u64)?;
+                    continue;
+                }
+                DW_CFA_offset => {
+                    let off = (r.uleb()? as i64).wrapping_mul(data_align);
+                    self.set_rule((op & 0x3f) as u64, Rule::Offset(off));
+                    continue;
+                }
+                DW_CFA_restore => {
+                    self.restore((op & 0x3f) as u64);
+                    continue;
+                }
+                _ => {}
+            }
+            match op {
+                DW_CFA_nop => {}
+                DW_CFA_set_loc => {
+                    let loc = r.pointer(self.cie.fde_enc, 0)?;
+                    if !fde || loc < self.loc {
+                        return None;
+                    }
+                    self.emit();
+                    self.loc = loc;
+                }
+                DW_CFA_advance_loc1 => self.advance(r.u8()? as u64)?,
+                DW_CFA_advance_loc2 => self.advance(r.u16()? as u64)?,
+                DW_CFA_advance_loc4 => self.advance(r.u32()? as u64)?,
+                DW_CFA_offset_extended => {
+                    let reg = r.uleb()?;
+                    let off = (r.uleb()? as i64).wrapping_mul(data_align);
+                    self.set_rule(reg, Rule::Offset(off));
+                }
+                DW_CFA_offset_extended_sf => {
+                    let reg = r.uleb()?;
+                    let off = r.sleb()?.wrapping_mul(data_align);
+                    self.set_rule(reg, Rule::Offset(off));
+                }
+                DW_CFA_GNU_negative_offset_extended => {
+                    let reg = r.uleb()?;
+                    let off = (r.uleb()? as i64).wrapping_mul(data_align).wrapping_neg();
+                    self.set_rule(reg, Rule::Offset(off));
+                }
+                DW_CFA_restore_extended => {
+                    let reg = r.uleb()?;
+                    self.restore(reg);
+                }
+                DW_CFA_undefined | DW_CFA_register => {
+                    let reg = r.uleb()?;
+                    if op == DW_CFA_register {
+                        r.uleb()?;
+                    }
+                    self.set_rule(reg, Rule::Unknown);
+                }
+                DW_CFA_same_value => {
+                    let reg = r.uleb()?;
+                    self.set_rule(reg, Rule::Same);
+                }
+                DW_CFA_val_offset | DW_CFA_val_offset_sf => {
+                    let reg = r.uleb()?;
+                    if op == DW_CFA_val_offset {
+                        r.uleb()?;
+                    } else {
+                        r.sleb()?;
+                    }
+                    self.set_rule(reg, Rule::Unknown);
+                }
+                DW_CFA_expression | DW_CFA_val_expression => {
+                    let reg = r.uleb()?;
+                    let len = r.uleb()? as usize;
+                    r.skip(len)?;
+                    self.set_rule(reg, Rule::Unknown);
+                }
+                DW_CFA_remember_state => self.stack.push(self.state.clone()),
+                DW_CFA_restore_state => self.state = self.stack.pop()?,
+                DW_CFA_def_cfa => {
+                    self.state.cfa_reg = Some(r.uleb()?);
+                    self.state.cfa_off = r.uleb()? as i64;
+                }
+                DW_CFA_def_cfa_sf => {
+                    self.state.cfa_reg = Some(r.uleb()?);
+                    self.state.cfa_off = r.sleb()?.wrapping_mul(data_align);
+                }
+                DW_CFA_def_cfa_register => {
+                    let reg = r.uleb()?;
+                    if self.state.cfa_reg.is_some() {
+                        self.state.cfa_reg = Some(reg);
+                    }
+                }
+                DW_CFA_def_cfa_offset => self.state.cfa_off = r.uleb()? as i64,
+                DW_CFA_def_cfa_offset_sf => self.state.cfa_off = r.sleb()?.wrapping_mul(data_align),
+                DW_CFA_def_cfa_expression => {
+                    let len = r.uleb()? as usize;
+                    r.skip(len)?;
+                    self.state.cfa_reg = None;
+                }
+                DW_CFA_GNU_args_size => {
+                    r.uleb()?;
+                }
+                _ => return None,
+            }
+        }
+        Some(())
+    }
+
+    fn advance(&mut self, delta: u64) -> Option<()> {
+        self.emit();
+        self.loc = self.loc.checked_add(delta.checked_mul(self.cie.code_align)? as usize)?;
+        Some(())
+    }
+
+    fn set_rule(&mut self, reg: u64, rule: Rule) {
+        match reg {
+            DWARF_RBP => self.state.rbp = rule,
+            DWARF_RA => self.state.ra = rule,
+            _ => {}
+        }
+    }
+
+    fn restore(&mut self, reg: u64) {
+        match reg {
+            DWARF_RBP => self.state.rbp = self.initial.rbp,
+            DWARF_RA => self.state.ra = self.initial.ra,
+            _ => {}
+        }
+    }
+
+    // Records the state in force from the current location on. A later row
+    // for the same location replaces it, and an unchanged one is left out.
+    fn emit(&mut self) {
+        let row = self.row();
+        let rows = &self.rows[self.first_row..];
+        match rows.last() {
+            Some(last) if last.pc == row.pc => {
+                let i = self.rows.len() - 1;
+                if i > self.first_row && same_rule(&self.rows[i - 1], &row) {
+                    self.rows.pop();
+                } else {
+                    self.rows[i] = row;
+                }
+            }
+            Some(last) if same_rule(last, &row) => {}
+            _ => self.rows.push(row),
+        }
+    }
+
+    fn row(&self) -> Row {
+        let pc = (self.loc - self.base) as u32;
+        let unknown = Row {
+            pc,
+            cfa_off: 0,
+            cfa: Cfa::Unknown,
+            rbp_slot: 0,
+        };
+        let state = &self.state;
+        let cfa = match state.cfa_reg {
+            Some(DWARF_RSP) => Cfa::Rsp,
+            Some(DWARF_RBP) => Cfa::Rbp,
+            _ => return unknown,
+        };
+        if state.ra != Rule::Offset(-8) || state.cfa_off < 8 || state.cfa_off > u32::max_value() as i64 {
+            return unknown;
+        }
+        let rbp_slot = match state.rbp {
+            Rule::Same => 0,
+            Rule::Offset(off) if off < 0 && off % 8 == 0 && -off / 8 <= 255 => (-off / 8) as u8,
+            _ => return unknown,
+        };
+        Row {
+            pc,
+            cfa_off: state.cfa_off as u32,
+            cfa,
+            rbp_slot,
+        }
+    }
+}
+
+fn same_rule(a: &Row, b: &Row) -> bool {
+    a.cfa == b.cfa && a.cfa_off == b.cfa_off && a.rbp_slot == b.rbp_slot
+}
+
+// The number of leading elements of `items` for which `pred` holds, given
+// that it holds for a prefix.
+fn upper_bound<T, F: Fn(&T) -> bool>(items: &[T], pred: F) -> usize {
+    let (mut lo, mut hi) = (0, items.len());
+    while lo < hi {
+        let mid = lo + (hi - lo) / 2;
+        if pred(&items[mid]) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    lo
+}
+
+// Reads the image in place. Every read is checked against `end`.
+struct Reader {
+    pos: usize,
+    end: usize,
+}
+
+impl Reader {
+    fn new(pos: usize, end: usize) -> Reader {
+        Reader { pos, end }
+    }
+
+    unsafe fn read<T: Copy>(&mut self) -> Option<T> {
+        let next = self.pos.checked_add(mem::size_of::<T>())?;
+        if next > self.end {
+            return None;
+        }
+        let value = ptr::read_unaligned(self.pos as *const T);
+        self.pos = next;
+        Some(value)
+    }
+
+    fn skip(&mut self, len: usize) -> Option<()> {
+        let next = self.pos.checked_add(len)?;
+        if next > self.end {
+            return None;
+        }
+        self.pos = next;
+        Some(())
+    }
+
+    unsafe fn u8(&mut self) -> Option<u8> {
+        self.read()
+    }
+
+    unsafe fn u16(&mut self) -> Option<u16> {
+        self.read()
+    }
+
+    unsafe fn u32(&mut self) -> Option<u32> {
+        self.read()
+    }
+
+    unsafe fn u64(&mut self) -> Option<u64> {
+        self.read()
+    }
+
+    unsafe fn uleb(&mut self) -> Option<u64> {
+        let mut result = 0_u64;
+        let mut shift = 0;
+        loop {
+            let byte = self.u8()?;
+            if shift < 64 {
+                result |= ((byte & 0x7f) as u64) << shift;
+            }
+            shift += 7;
+            if byte & 0x80 == 0 {
+                return Some(result);
+            }
+        }
+    }
+
+    unsafe fn sleb(&mut self) -> Option<i64> {
+        let mut result = 0_i64;
+        let mut shift = 0;
+        loop {
+            let byte = self.u8()?;
+            if shift < 64 {
+                result |= ((byte & 0x7f) as i64) << shift;
+            }
+            shift += 7;
+            if byte & 0x80 == 0 {
+                if shift < 64 && byte & 0x40 != 0 {
+                    result |= -1 << shift;
+                }
+                return Some(result);
+            }
+        }
+    }
+
+    // Reads a pointer encoded as `enc`. Data-relative pointers are relative
+    // to `data_base`.
+    unsafe fn pointer(&mut self, enc: u8, data_base: usize) -> Option<usize> {
+        let start = self.pos;
+        let value = match enc & 0x0f {
+            DW_EH_PE_absptr | DW_EH_PE_udata8 => self.u64()?,
+            DW_EH_PE_uleb128 => self.uleb()?,
+            DW_EH_PE_udata2 => self.u16()? as u64,
+            DW_EH_PE_udata4 => self.u32()? as u64,
+            DW_EH_PE_sleb128 => self.sleb()? as u64,
+            DW_EH_PE_sdata2 => self.u16()? as i16 as i64 as u64,
+            DW_EH_PE_sdata4 => self.u32()? as i32 as i64 as u64,
+            DW_EH_PE_sdata8 => self.u64()?,
+            _ => return None,
+        };
+        let base = match enc & 0x70 {
+            0 => 0,
+            DW_EH_PE_pcrel => start,
+            DW_EH_PE_datarel => data_base,
+            _ => return None,
+        };
+        // Indirect pointers are not followed. They only show up for
+        // personality routines, which are skipped.
+        Some(base.wrapping_add(value as usize))
+    }
+
+    // Reads the length of a CIE or FDE and returns where it ends.
+    unsafe fn entry_end(&mut self) -> Option<usize> {
+        let len = match self.u32()? {
+            0 => return None,
+            0xffff_ffff => self.u64()? as usize,
+            len => len as usize,
+        };
+        let end = self.pos.checked_add(len)?;
+        if end > self.end {
+            return None;
+        }
+        Some(end)
+    }
+}
+
+#[repr(C)]
+struct Elf64Ehdr {
+    e_ident: [u8; 16],
+    e_type: u16,
+    e_machine: u16,
+    e_version: u32,
+    e_entry: u64,
+    e_phoff: u64,
+    e_shoff: u64,
+    e_flags: u32,
+    e_ehsize: u16,
+    e_phentsize: u16,
+    e_phnum: u16,
+    e_shentsize: u16,
+    e_shnum: u16,
+    e_shstrndx: u16,
+}
+
+#[repr(C)]
+struct Elf64Phdr {
+    p_type: u32,
+    p_flags: u32,
+    p_offset: u64,
+    p_vaddr: u64,
+    p_paddr: u64,
+    p_filesz: u64,
+    p_memsz: u64,
+    p_align: u64,
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use alloc::vec;
+
+    const SIZE: usize = 0x400;
+    const TEXT: usize = 0x100;
+    const HDR: usize = 0x200;
+    const EH_FRAME: usize = 0x240;
+
+    fn put(image: &mut [u8], pos: usize, bytes: &[u8]) {
+        image[pos..pos + bytes.len()].copy_from_slice(bytes);
+    }
+
+    // Writes a CIE or FDE with `body` at `pos`, padded with DW_CFA_nop, and
+    // returns where it ends.
+    fn entry(image: &mut [u8], pos: usize, body: &[u8]) -> usize {
+        let len = (4 + body.len() + 7) / 8 * 8 - 4;
+        put(image, pos, &(len as u32).to_le_bytes());
+        put(image, pos + 4, body);
+        pos + 4 + len
+    }
+
+    fn fde(image: &mut [u8], pos: usize, cie: usize, func: usize, len: usize, insns: &[u8]) -> usize {
+        let mut body = Vec::new();
+        body.extend_from_slice(&((pos + 4 - cie) as u32).to_le_bytes());
+        body.extend_from_slice(&((func as i64 - (pos + 8) as i64) as i32).to_le_bytes());
+        body.extend_from_slice(&(len as u32).to_le_bytes());
+        body.push(0);
+        body.extend_from_slice(insns);
+        entry(image, pos, &body)
+    }
+
+    // An ELF image with one executable segment and an `.eh_frame_hdr`
+    // listing an FDE for each of `funcs`, given as (offset, length, program).
+    fn image(funcs: &[(usize, usize, &[u8])]) -> Vec<u64> {
+        let mut image = vec![0_u8; SIZE];
+        put(&mut image, 0, b"\x7fELF\x02\x01\x01");
+        put(&mut image, 32, &64_u64.to_le_bytes());
+        put(&mut image, 54, &(mem::size_of::<Elf64Phdr>() as u16).to_le_bytes());
+        put(&mut image, 56, &2_u16.to_le_bytes());
+        let phdrs = [(PT_LOAD, PF_X, 0, SIZE), (PT_GNU_EH_FRAME, 0, HDR, 12 + funcs.len() * 8)];
+        for (i, &(p_type, p_flags, vaddr, memsz)) in phdrs.iter().enumerate() {
+            let pos = 64 + i * mem::size_of::<Elf64Phdr>();
+            put(&mut image, pos, &p_type.to_le_bytes());
+            put(&mut image, pos + 4, &p_flags.to_le_bytes());
+            put(&mut image, pos + 16, &(vaddr as u64).to_le_bytes());
+            put(&mut image, pos + 40, &(memsz as u64).to_le_bytes());
+        }
+
+        // "zR" with pcrel sdata4 pointers, a code alignment of 1, a data
+        // alignment of -8, and the return address at CFA - 8 with CFA = rsp + 8.
+        let cie = EH_FRAME;
+        let mut pos = entry(&mut image, cie, &[
+            0, 0, 0, 0, 1, b'z', b'R', 0, 1, 0x78, DWARF_RA as u8, 1,
+            DW_EH_PE_pcrel | DW_EH_PE_sdata4,
+            DW_CFA_def_cfa, DWARF_RSP as u8, 8,
+            DW_CFA_offset | DWARF_RA as u8, 1,
+        ]);
+
+        put(&mut image, HDR, &[1, DW_EH_PE_pcrel | DW_EH_PE_sdata4, DW_EH_PE_udata4, DW_EH_PE_datarel | DW_EH_PE_sdata4]);
+        put(&mut image, HDR + 4, &((EH_FRAME - (HDR + 4)) as u32).to_le_bytes());
+        put(&mut image, HDR + 8, &(funcs.len() as u32).to_le_bytes());
+        for (i, &(func, len, insns)) in funcs.iter().enumerate() {
+            put(&mut image, HDR + 12 + i * 8, &((func as i64 - HDR as i64) as i32).to_le_bytes());
+            put(&mut image, HDR + 16 + i * 8, &((pos - HDR) as i32).to_le_bytes());
+            pos = fde(&mut image, pos, cie, func, len, insns);
+        }
+
+        let mut words = vec![0_u64; SIZE / 8];
+        unsafe { ptr::copy_nonoverlapping(image.as_ptr(), words.as_mut_ptr() as *mut u8, SIZE) };
+        words
+    }
+
+    fn row(pc: usize, cfa: Cfa, cfa_off: u32, rbp_slot: u8) -> Row {
+        Row { pc: pc as u32, cfa_off, cfa, rbp_slot }
+    }
+
+    #[test]
+    fn unknown_opcode_only_affects_its_fde() {
+        // push rbp; mov rbp, rsp
+        let prologue: &[u8] = &[
+            DW_CFA_advance_loc | 1, DW_CFA_def_cfa_offset, 16, DW_CFA_offset | DWARF_RBP as u8, 2,
+            DW_CFA_advance_loc | 3, DW_CFA_def_cfa_register, DWARF_RBP as u8,
+        ];
+        // The same with DW_CFA_hi_user, which no compiler emits, in the middle.
+        let unknown: &[u8] = &[
+            DW_CFA_advance_loc | 1, DW_CFA_def_cfa_offset, 16, 0x3f,
+            DW_CFA_advance_loc | 3, DW_CFA_def_cfa_register, DWARF_RBP as u8,
+        ];
+        let (f, g, h) = (TEXT, TEXT + 0x40, TEXT + 0x80);
+        let image = image(&[(f, 0x40, prologue), (g, 0x40, unknown), (h, 0x40, prologue)]);
+        let base = image.as_ptr() as usize;
+
+        let index = unsafe { UnwindIndex::from_image(base) }.unwrap();
+        assert_eq!(index.len(), 3);
+        for &func in &[f, h] {
+            assert_eq!(index.lookup(base + func), Some((base + func, row(func, Cfa::Rsp, 8, 0))));
+            assert_eq!(index.lookup(base + func + 1), Some((base + func, row(func + 1, Cfa::Rsp, 16, 2))));
+            assert_eq!(index.lookup(base + func + 0x3f), Some((base + func, row(func + 4, Cfa::Rbp, 16, 2))));
+        }
+        for &ip in &[g, g + 1, g + 0x3f] {
+            assert_eq!(index.lookup(base + ip), Some((base + g, row(g, Cfa::Unknown, 0, 0))));
+        }
+        assert_eq!(index.lookup(base + h + 0x40), None);
+    }
+}
@@ -132,3 +132,7 @@ impl fmt::Debug for Frame {
 mod libunwind;
 use self::libunwind::trace as trace_imp;
 pub(crate) use self::libunwind::Frame as FrameImp;
+
+mod index;
+mod fast;
+pub use self::fast::{init_unwind_index, symbol_address_fast, trace_fast};
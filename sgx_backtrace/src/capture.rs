@@ -16,11 +16,21 @@
 // under the License..
 
 use crate::PrintFmt;
-use crate::{resolve, resolve_frame, trace, BacktraceFmt, Symbol, SymbolName};
+use crate::{resolve_frame_unsynchronized, resolve_unsynchronized, trace, BacktraceFmt, Symbol, SymbolName};
+use std::collections::HashMap;
 use std::path::{Path, PathBuf};
 use std::prelude::v1::*;
 use core::ffi::c_void;
 use core::fmt;
+use core::mem;
+use core::ptr;
+use core::slice;
+
+/// Frames `Backtrace::new_fast` captures at most.
+const MAX_FAST_FRAMES: usize = 128;
+
+/// Addresses whose symbols are kept by default.
+const DEFAULT_SYMBOL_CACHE_CAPACITY: usize = 4096;
 
 /// Representation of an owned and self-contained backtrace.
 ///
@@ -67,6 +77,7 @@ pub struct BacktraceFrame {
 #[derive(Clone)]
 enum Frame {
     Raw(crate::Frame),
+    // Also used for frames captured by `Backtrace::new_fast`.
     #[allow(dead_code)]
     Deserialized {
         ip: usize,
@@ -170,6 +181,59 @@ impl Backtrace {
         Self::create(Self::new_unresolved as usize)
     }
 
+    /// Captures a backtrace through the unwind index of the enclave image,
+    /// without resolving any symbols.
+    ///
+    /// This is much cheaper than `new_unresolved`: the walk takes no lock,
+    /// interprets no DWARF and only allocates the returned frames. See
+    /// `trace_fast` for how it differs from a walk with libunwind. Symbols
+    /// can be resolved later with `resolve` or, for many backtraces at once,
+    /// with `resolve_all`.
+    ///
+    /// At most 128 frames are captured. If the enclave image has no usable
+    /// unwind information, this falls back to `new_unresolved`.
+    ///
+    /// # Examples
+    ///
+    /// ```
+    /// use sgx_backtrace::Backtrace;
+    ///
+    /// // Preferably during enclave initialization.
+    /// sgx_backtrace::init_unwind_index();
+    ///
+    /// let mut current_backtrace = Backtrace::new_fast();
+    /// current_backtrace.resolve();
+    /// println!("{:?}", current_backtrace);
+    /// ```
+    ///
+    /// # Required features
+    ///
+    /// This function requires the `std` feature of the `backtrace` crate to be
+    /// enabled, and the `std` feature is enabled by default.
+    #[inline(never)]
+    pub fn new_fast() -> Backtrace {
+        let mut ips = [ptr::null_mut(); MAX_FAST_FRAMES];
+        let count = crate::trace_fast(&mut ips);
+        if count == 0 {
+            return Self::create(Self::new_fast as usize);
+        }
+
+        let frames = ips[..count]
+            .iter()
+            .map(|&ip| BacktraceFrame {
+                frame: Frame::Deserialized {
+                    ip: ip as usize,
+                    symbol_address: crate::symbol_address_fast(ip) as usize,
+                },
+                symbols: None,
+            })
+            .collect();
+        Backtrace {
+            frames,
+            actual_start_index: 0,
+        }
+    }
+
     fn create(ip: usize) -> Backtrace {
         let mut frames = Vec::new();
         let mut actual_start_index = None;
@@ -216,7 +280,34 @@ impl Backtrace {
     /// This function requires the `std` feature of the `backtrace` crate to be
     /// enabled, and the `std` feature is enabled by default.
     pub fn resolve(&mut self) {
-        for frame in self.frames.iter_mut().filter(|f| f.symbols.is_none()) {
+        Self::resolve_all(slice::from_mut(self))
+    }
+
+    /// Resolves the symbols of all `backtraces` in one go.
+    ///
+    /// Resolved addresses are kept in a cache shared by all backtraces, so
+    /// frames that show up again, in these backtraces or later ones, are not
+    /// looked up again. The cache holds the most recently used addresses;
+    /// see `set_symbol_cache_capacity`.
+    ///
+    /// # Required features
+    ///
+    /// This function requires the `std` feature of the `backtrace` crate to be
+    /// enabled, and the `std` feature is enabled by default.
+    pub fn resolve_all(backtraces: &mut [Backtrace]) {
+        let _guard = crate::lock::lock();
+        let cache = unsafe { symbol_cache() };
+        let frames = backtraces
+            .iter_mut()
+            .flat_map(|bt| bt.frames.iter_mut())
+            .filter(|f| f.symbols.is_none());
+        for frame in frames {
+            let ip = frame.ip() as usize;
+            if let Some(symbols) = cache.get(ip) {
+                frame.symbols = Some(symbols.clone());
+                continue;
+            }
+
             let mut symbols = Vec::new();
             {
                 let sym = |symbol: &Symbol| {
@@ -227,18 +318,36 @@ impl Backtrace {
                         lineno: symbol.lineno(),
                     });
                 };
-                match frame.frame {
-                    Frame::Raw(ref f) => resolve_frame(f, sym),
-                    Frame::Deserialized { ip, .. } => {
-                        resolve(ip as *mut c_void, sym);
+                unsafe {
+                    match frame.frame {
+                        Frame::Raw(ref f) => resolve_frame_unsynchronized(f, sym),
+                        Frame::Deserialized { ip, .. } => resolve_unsynchronized(ip as *mut c_void, sym),
                     }
                 }
             }
+            // Nothing may be found before `set_enclave_path` is called, so
+            // misses are not cached.
+            if !symbols.is_empty() {
+                cache.insert(ip, symbols.clone());
+            }
             frame.symbols = Some(symbols);
         }
     }
 }
 
+/// Sets how many resolved addresses `Backtrace::resolve` keeps, and drops
+/// the least recently used ones beyond that. The default is 4096; 0 turns
+/// the cache off.
+///
+/// # Required features
+///
+/// This function requires the `std` feature of the `backtrace` crate to be
+/// enabled, and the `std` feature is enabled by default.
+pub fn set_symbol_cache_capacity(capacity: usize) {
+    let _guard = crate::lock::lock();
+    unsafe { symbol_cache().set_capacity(capacity) }
+}
+
 impl From<Vec<BacktraceFrame>> for Backtrace {
     fn from(frames: Vec<BacktraceFrame>) -> Self {
         Backtrace {
@@ -398,6 +507,140 @@ impl fmt::Debug for BacktraceSymbol {
     }
 }
 
+pub(crate) fn clear_resolved_symbols() {
+    let _guard = crate::lock::lock();
+    unsafe { symbol_cache().clear() }
+}
+
+// Only touched while holding `crate::lock`.
+static mut SYMBOL_CACHE: Option<SymbolCache> = None;
+
+unsafe fn symbol_cache() -> &'static mut SymbolCache {
+    if SYMBOL_CACHE.is_none() {
+        SYMBOL_CACHE = Some(SymbolCache::new(DEFAULT_SYMBOL_CACHE_CAPACITY));
+    }
+    SYMBOL_CACHE.as_mut().unwrap()
+}
+
+const NIL: usize = usize::max_value();
+
+struct CacheEntry {
+    ip: usize,
+    symbols: Vec<BacktraceSymbol>,
+    prev: usize,
+    next: usize,
+}
+
+// A least-recently-used map from addresses to their symbols. Entries live in
+// a slab and are linked from the most (`head`) to the least recently used
+// (`tail`).
+struct SymbolCache {
+    map: HashMap<usize, usize>,
+    entries: Vec<CacheEntry>,
+    head: usize,
+    tail: usize,
+    capacity: usize,
+}
+
+impl SymbolCache {
+    fn new(capacity: usize) -> SymbolCache {
+        SymbolCache {
+            map: HashMap::new(),
+            entries: Vec::new(),
+            head: NIL,
+            tail: NIL,
+            capacity,
+        }
+    }
+
+    fn get(&mut self, ip: usize) -> Option<&Vec<BacktraceSymbol>> {
+        let i = *self.map.get(&ip)?;
+        self.unlink(i);
+        self.push_front(i);
+        Some(&self.entries[i].symbols)
+    }
+
+    fn insert(&mut self, ip: usize, symbols: Vec<BacktraceSymbol>) {
+        if self.capacity == 0 {
+            return;
+        }
+        if let Some(&i) = self.map.get(&ip) {
+            self.entries[i].symbols = symbols;
+            self.unlink(i);
+            self.push_front(i);
+            return;
+        }
+
+        let i = if self.entries.len() < self.capacity {
+            self.entries.push(CacheEntry {
+                ip,
+                symbols,
+                prev: NIL,
+                next: NIL,
+            });
+            self.entries.len() - 1
+        } else {
+            // Reuse the least recently used entry.
+            let i = self.tail;
+            self.unlink(i);
+            self.map.remove(&self.entries[i].ip);
+            self.entries[i].ip = ip;
+            self.entries[i].symbols = symbols;
+            i
+        };
+        self.map.insert(ip, i);
+        self.push_front(i);
+    }
+
+    fn set_capacity(&mut self, capacity: usize) {
+        self.capacity = capacity;
+        if self.entries.len() <= capacity {
+            return;
+        }
+        // Keep the most recently used entries, in order.
+        let mut keep = Vec::with_capacity(capacity);
+        let mut i = self.head;
+        while i != NIL && keep.len() < capacity {
+            let entry = &mut self.entries[i];
+            keep.push((entry.ip, mem::replace(&mut entry.symbols, Vec::new())));
+            i = entry.next;
+        }
+        self.clear();
+        for (ip, symbols) in keep.into_iter().rev() {
+            self.insert(ip, symbols);
+        }
+    }
+
+    fn clear(&mut self) {
+        self.map = HashMap::new();
+        self.entries = Vec::new();
+        self.head = NIL;
+        self.tail = NIL;
+    }
+
+    fn unlink(&mut self, i: usize) {
+        let (prev, next) = (self.entries[i].prev, self.entries[i].next);
+        match prev {
+            NIL => self.head = next,
+            prev => self.entries[prev].next = next,
+        }
+        match next {
+            NIL => self.tail = prev,
+            next => self.entries[next].prev = prev,
+        }
+    }
+
+    fn push_front(&mut self, i: usize) {
+        self.entries[i].prev = NIL;
+        self.entries[i].next = self.head;
+        match self.head {
+            NIL => self.tail = i,
+            head => self.entries[head].prev = i,
+        }
+        self.head = i;
+    }
+}
+
 #[cfg(feature = "serialize")]
 mod sgx_serialize_impls {
     use super::*;
@@ -83,6 +83,7 @@
 
 #![cfg_attr(all(target_env = "sgx", target_vendor = "mesalock", feature = "std"), feature(rustc_private))]
 #![cfg_attr(feature = "nostd", feature(panic_unwind))]
+#![feature(asm)]
 
 #[cfg(all(not(target_env = "sgx"), feature = "std"))]
 #[macro_use]
@@ -111,6 +112,7 @@ extern crate sgx_serialize;
 extern crate sgx_serialize_derive;
 
 pub use crate::backtrace::{trace_unsynchronized, Frame};
+pub use crate::backtrace::{init_unwind_index, symbol_address_fast, trace_fast};
 mod backtrace;
 
 pub use crate::symbolize::resolve_frame_unsynchronized;
@@ -131,6 +133,7 @@ cfg_if! {
         pub use crate::backtrace::trace;
         pub use crate::symbolize::{resolve, resolve_frame};
         pub use crate::capture::{Backtrace, BacktraceFrame, BacktraceSymbol};
+        pub use crate::capture::set_symbol_cache_capacity;
         mod capture;
     }
 }
@@ -382,17 +382,15 @@ impl<'a> fmt::Debug for SymbolName<'a> {
 ///
 /// # Caveats
 ///
-/// While this function is always available it doesn't actually do anything on
-/// most implementations. Libraries like dbghelp or libbacktrace do not provide
-/// facilities to deallocate state and manage the allocated memory. For now the
-/// `gimli-symbolize` feature of this crate is the only feature where this
-/// function has any effect.
+/// libbacktrace does not provide facilities to deallocate its state, so this
+/// only empties the cache of symbols resolved by `Backtrace::resolve`.
 #[cfg(feature = "std")]
 pub fn clear_symbol_cache() {
     let _guard = crate::lock::lock();
     unsafe {
         clear_symbol_cache_imp();
     }
+    crate::capture::clear_resolved_symbols();
 }
 
 mod libbacktrace;
@@ -0,0 +1,238 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Block-wise RSA-OAEP shared by the RSA 2048 and RSA 3072 helpers.
+//!
+//! Buffers are cut into independent blocks. With the `parallel` feature and
+//! a caller running inside `ThreadPool::install`, ranges of blocks are
+//! handed to the pool workers with `join`; otherwise they run one after
+//! another on the calling thread.
+
+use crypto::{SgxRsaPrivKey, SgxRsaPubKey};
+use sgx_types::sgx_status_t;
+use sgx_types::{SgxError, SgxResult};
+use std::prelude::v1::*;
+
+#[cfg(any(feature = "mesalock_sgx", target_env = "sgx"))]
+use std::sync::SgxMutex as Mutex;
+#[cfg(not(any(feature = "mesalock_sgx", target_env = "sgx")))]
+use std::sync::Mutex;
+
+#[cfg(feature = "parallel")]
+use std::thread::pool::join;
+
+#[cfg(not(feature = "parallel"))]
+fn join<A, B, RA, RB>(a: A, b: B) -> (RA, RB)
+where
+    A: FnOnce() -> RA,
+    B: FnOnce() -> RB,
+{
+    (a(), b())
+}
+
+// Blocks handled by one task. A private key operation takes milliseconds,
+// so even a couple of blocks are worth a task of their own.
+const BLOCKS_PER_TASK: usize = 2;
+const MAX_BLOCK_SIZE: usize = 384;
+
+/// Plaintext bytes per block: RSA-OAEP with SHA-256 leaves
+/// `bs - 2 * 256 / 8 - 2` bytes of the modulus for the message.
+pub(crate) fn plain_block_size(bs: usize) -> usize {
+    bs - 2 * 256 / 8 - 2
+}
+
+// An IPP key context is plain memory owned by its handle. It may move to
+// another thread as long as a single thread uses it at a time, which the
+// cache guarantees by handing every key to one caller only.
+struct CachedKey<K>(K);
+
+unsafe impl<K> Send for CachedKey<K> {}
+
+/// Key contexts created on demand and kept for later calls.
+///
+/// Every thread working on a buffer at the same time takes a context of its
+/// own, so the cache ends up holding one per concurrent user.
+pub(crate) struct KeyCache<K> {
+    make: Box<dyn Fn() -> SgxResult<K> + Send + Sync>,
+    keys: Mutex<Vec<CachedKey<K>>>,
+}
+
+impl<K> KeyCache<K> {
+    pub(crate) fn new<M>(make: M) -> KeyCache<K>
+    where
+        M: Fn() -> SgxResult<K> + Send + Sync + 'static,
+    {
+        KeyCache {
+            make: Box::new(make),
+            keys: Mutex::new(Vec::new()),
+        }
+    }
+
+    /// Creates the first context, so a bad key is reported up front.
+    pub(crate) fn warm_up(&self) -> SgxError {
+        self.with_key(|_| Ok(()))
+    }
+
+    fn with_key<F, R>(&self, f: F) -> SgxResult<R>
+    where
+        F: FnOnce(&K) -> SgxResult<R>,
+    {
+        let cached = self.keys.lock().unwrap().pop();
+        let key = match cached {
+            Some(CachedKey(key)) => key,
+            None => (self.make)()?,
+        };
+        let result = f(&key);
+        self.keys.lock().unwrap().push(CachedKey(key));
+        result
+    }
+}
+
+/// Encrypts `plaintext` into `bs` byte blocks. `ciphertext` is sized once
+/// for all blocks.
+pub(crate) fn encrypt_buffer(
+    keys: &KeyCache<SgxRsaPubKey>,
+    bs: usize,
+    plaintext: &[u8],
+    ciphertext: &mut Vec<u8>,
+) -> SgxResult<usize> {
+    let bs_plain = plain_block_size(bs);
+    let count = (plaintext.len() + bs_plain - 1) / bs_plain;
+    ciphertext.clear();
+    ciphertext.resize(bs * count, 0);
+
+    encrypt_range(keys, bs, plaintext, ciphertext)?;
+    Ok(ciphertext.len())
+}
+
+fn encrypt_range(
+    keys: &KeyCache<SgxRsaPubKey>,
+    bs: usize,
+    plaintext: &[u8],
+    ciphertext: &mut [u8],
+) -> SgxError {
+    let bs_plain = plain_block_size(bs);
+    let count = ciphertext.len() / bs;
+    if count <= BLOCKS_PER_TASK {
+        return keys.with_key(|pubkey| {
+            for (cipher_slice, plain_slice) in ciphertext.chunks_mut(bs).zip(plaintext.chunks(bs_plain)) {
+                let mut out_len = bs;
+                pubkey.encrypt_sha256(cipher_slice, &mut out_len, plain_slice)?;
+            }
+            Ok(())
+        });
+    }
+
+    let mid = count / 2;
+    let (plain_left, plain_right) = plaintext.split_at(mid * bs_plain);
+    let (cipher_left, cipher_right) = ciphertext.split_at_mut(mid * bs);
+    let (left, right) = join(
+        || encrypt_range(keys, bs, plain_left, cipher_left),
+        || encrypt_range(keys, bs, plain_right, cipher_right),
+    );
+    left.and(right)
+}
+
+/// Decrypts `bs` byte blocks into `plaintext`.
+///
+/// Every block gets a slot of the largest plaintext block size, so blocks
+/// can be decrypted independently. Blocks produced by `encrypt_buffer` fill
+/// their slots except for the last one, which leaves nothing to move
+/// before the buffer is cut to length. On error `plaintext` is emptied.
+pub(crate) fn decrypt_buffer(
+    keys: &KeyCache<SgxRsaPrivKey>,
+    bs: usize,
+    ciphertext: &[u8],
+    plaintext: &mut Vec<u8>,
+) -> SgxResult<usize> {
+    if ciphertext.len() % bs != 0 {
+        return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+    }
+
+    let bs_plain = plain_block_size(bs);
+    let count = ciphertext.len() / bs;
+    let mut lens = vec![0_usize; count];
+    plaintext.clear();
+    plaintext.resize(bs_plain * count, 0);
+
+    if let Err(e) = decrypt_range(keys, bs, ciphertext, plaintext, &mut lens) {
+        clear(plaintext);
+        plaintext.clear();
+        return Err(e);
+    }
+
+    let mut len = 0;
+    for (i, block_len) in lens.iter().enumerate() {
+        if len != i * bs_plain {
+            plaintext.copy_within(i * bs_plain..i * bs_plain + block_len, len);
+        }
+        len += block_len;
+    }
+    clear(&mut plaintext[len..]);
+    plaintext.truncate(len);
+    Ok(len)
+}
+
+fn decrypt_range(
+    keys: &KeyCache<SgxRsaPrivKey>,
+    bs: usize,
+    ciphertext: &[u8],
+    plaintext: &mut [u8],
+    lens: &mut [usize],
+) -> SgxError {
+    let bs_plain = plain_block_size(bs);
+    let count = lens.len();
+    if count <= BLOCKS_PER_TASK {
+        return keys.with_key(|privkey| {
+            // IPP wants room for a whole modulus, which is more than the
+            // slot of a block.
+            let mut buf = [0_u8; MAX_BLOCK_SIZE];
+            let result = ciphertext
+                .chunks(bs)
+                .zip(plaintext.chunks_mut(bs_plain))
+                .zip(lens.iter_mut())
+                .try_for_each(|((cipher_slice, plain_slot), block_len)| {
+                    let mut plain_len = bs;
+                    privkey.decrypt_sha256(&mut buf[..bs], &mut plain_len, cipher_slice)?;
+                    if plain_len > bs_plain {
+                        return Err(sgx_status_t::SGX_ERROR_UNEXPECTED);
+                    }
+                    plain_slot[..plain_len].copy_from_slice(&buf[..plain_len]);
+                    *block_len = plain_len;
+                    Ok(())
+                });
+            clear(&mut buf);
+            result
+        });
+    }
+
+    let mid = count / 2;
+    let (cipher_left, cipher_right) = ciphertext.split_at(mid * bs);
+    let (plain_left, plain_right) = plaintext.split_at_mut(mid * bs_plain);
+    let (lens_left, lens_right) = lens.split_at_mut(mid);
+    let (left, right) = join(
+        || decrypt_range(keys, bs, cipher_left, plain_left, lens_left),
+        || decrypt_range(keys, bs, cipher_right, plain_right, lens_right),
+    );
+    left.and(right)
+}
+
+fn clear(buf: &mut [u8]) {
+    for b in buf.iter_mut() {
+        unsafe { std::ptr::write_volatile(b, 0) };
+    }
+}
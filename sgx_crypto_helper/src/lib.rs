@@ -84,5 +84,6 @@ extern crate serde_big_array_sgx as serde_big_array;
 #[macro_use]
 extern crate serde_big_array;
 
+mod block;
 pub mod rsa2048;
 pub mod rsa3072;
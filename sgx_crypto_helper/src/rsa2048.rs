@@ -1,15 +1,17 @@
 use crypto::rsgx_create_rsa_key_pair;
 use crypto::{SgxRsaPrivKey, SgxRsaPubKey};
 use itertools::Itertools;
-use sgx_types::{sgx_status_t, size_t, SgxResult};
+use sgx_types::{size_t, SgxResult};
 pub const SGX_RSA2048_KEY_SIZE: size_t     = 256;
 pub const SGX_RSA2048_PRI_EXP_SIZE: size_t = 256;
 pub const SGX_RSA2048_PUB_EXP_SIZE: size_t = 4;
 pub const SGX_RSA2048_DEFAULT_E: [u8;SGX_RSA2048_PUB_EXP_SIZE]    = [0x01, 0x00, 0x00, 0x01]; // 65537
+const BLOCK_SIZE: usize = SGX_RSA2048_KEY_SIZE;
 use std::fmt;
 
 use std::prelude::v1::*;
 use crate::RsaKeyPair;
+use crate::block::{self, KeyCache};
 use serde_derive::*;
 
 big_array! { BigArray; }
@@ -159,59 +161,14 @@ impl RsaKeyPair for Rsa2048KeyPair {
     }
 
     fn encrypt_buffer(self, plaintext: &[u8], ciphertext: &mut Vec<u8>) -> SgxResult<usize> {
-        let pubkey = self.to_pubkey()?;
-        let bs = 256;
-
-        // The magic number 190 comes from RSA-OAEP:
-        // #define RSA_2048_KEY_BYTE    256
-        // #define SHA_SIZE_BIT         256
-        // #define RSAOAEP_ENCRYPT_MAXLEN RSA_2048_KEY_BYTE - 2*SHA_SIZE_BIT/8 - 2 /* 190 */
-        // RSA_2048_KEY_BYTE - 2*SHA_SIZE_BIT/8 - 2
-        let bs_plain = bs - 2 * 256 / 8 - 2;
-        let count = (plaintext.len() + bs_plain - 1) / bs_plain;
-        ciphertext.resize(bs * count, 0);
-
-        for i in 0..count {
-            let cipher_slice = &mut ciphertext[i * bs..i * bs + bs];
-            let mut out_len = bs;
-            let plain_slice =
-                &plaintext[i * bs_plain..std::cmp::min(i * bs_plain + bs_plain, plaintext.len())];
-
-            pubkey.encrypt_sha256(cipher_slice, &mut out_len, plain_slice)?;
-        }
-
-        Ok(ciphertext.len())
+        let pubkeys = KeyCache::new(move || self.to_pubkey());
+        block::encrypt_buffer(&pubkeys, BLOCK_SIZE, plaintext, ciphertext)
     }
 
     fn decrypt_buffer(self, ciphertext: &[u8], plaintext: &mut Vec<u8>) -> SgxResult<usize> {
-        let privkey = self.to_privkey()?;
-        let bs = 256;
-        if ciphertext.len() % bs != 0 {
-            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
-        }
-        // The magic number 190 comes from RSA-OAEP:
-        // #define RSA_2048_KEY_BYTE    256
-        // #define SHA_SIZE_BIT         256
-        // #define RSAOAEP_ENCRYPT_MAXLEN RSA_2048_KEY_BYTE - 2*SHA_SIZE_BIT/8 - 2 /* 190 */
-        // RSA_2048_KEY_BYTE - 2*SHA_SIZE_BIT/8 - 2
-        //let bs_plain = 256 - 2 * 256 / 8 - 2;
-        let bs_plain = bs;
-        let count = ciphertext.len() / bs;
-        plaintext.clear();
-
-        for i in 0..count {
-            let cipher_slice = &ciphertext[i * bs..i * bs + bs];
-            let plain_slice = &mut vec![0;bs_plain];
-            let mut plain_len = bs_plain;
-
-            privkey.decrypt_sha256(plain_slice, &mut plain_len, cipher_slice)?;
-            let mut decoded_vec = plain_slice[..plain_len].to_vec();
-            plaintext.append(&mut decoded_vec);
-        }
-
-        Ok(plaintext.len())
+        let privkeys = KeyCache::new(move || self.to_privkey());
+        block::decrypt_buffer(&privkeys, BLOCK_SIZE, ciphertext, plaintext)
     }
-
 }
 
 impl Rsa2048KeyPair {
@@ -221,6 +178,19 @@ impl Rsa2048KeyPair {
             e: self.e,
         })
     }
+
+    /// Sets up key contexts to be reused by every call on the returned
+    /// handle, instead of once per call as `encrypt_buffer` and
+    /// `decrypt_buffer` do.
+    pub fn to_handle(self) -> SgxResult<Rsa2048KeyHandle> {
+        let handle = Rsa2048KeyHandle {
+            pubkeys: KeyCache::new(move || self.to_pubkey()),
+            privkeys: KeyCache::new(move || self.to_privkey()),
+        };
+        handle.pubkeys.warm_up()?;
+        handle.privkeys.warm_up()?;
+        Ok(handle)
+    }
 }
 
 #[cfg(any(feature = "mesalock_sgx", target_env = "sgx"))]
@@ -263,28 +233,18 @@ impl Rsa2048PubKey {
     }
 
     pub fn encrypt_buffer(self, plaintext: &[u8], ciphertext: &mut Vec<u8>) -> SgxResult<usize> {
-        let pubkey = self.to_pubkey()?;
-        let bs = 256;
-
-        // The magic number 190 comes from RSA-OAEP:
-        // #define RSA_2048_KEY_BYTE    256
-        // #define SHA_SIZE_BIT         256
-        // #define RSAOAEP_ENCRYPT_MAXLEN RSA_2048_KEY_BYTE - 2*SHA_SIZE_BIT/8 - 2 /* 190 */
-        // RSA_2048_KEY_BYTE - 2*SHA_SIZE_BIT/8 - 2
-        let bs_plain = bs - 2 * 256 / 8 - 2;
-        let count = (plaintext.len() + bs_plain - 1) / bs_plain;
-        ciphertext.resize(bs * count, 0);
-
-        for i in 0..count {
-            let cipher_slice = &mut ciphertext[i * bs..i * bs + bs];
-            let mut out_len = bs;
-            let plain_slice =
-                &plaintext[i * bs_plain..std::cmp::min(i * bs_plain + bs_plain, plaintext.len())];
-
-            pubkey.encrypt_sha256(cipher_slice, &mut out_len, plain_slice)?;
-        }
+        let pubkeys = KeyCache::new(move || self.to_pubkey());
+        block::encrypt_buffer(&pubkeys, BLOCK_SIZE, plaintext, ciphertext)
+    }
 
-        Ok(ciphertext.len())
+    /// Sets up a key context to be reused by every call on the returned
+    /// handle.
+    pub fn to_handle(self) -> SgxResult<Rsa2048PubKeyHandle> {
+        let handle = Rsa2048PubKeyHandle {
+            pubkeys: KeyCache::new(move || self.to_pubkey()),
+        };
+        handle.pubkeys.warm_up()?;
+        Ok(handle)
     }
 }
 
@@ -297,6 +257,56 @@ impl fmt::Debug for Rsa2048PubKey {
 }
 
 
+/// RSA 2048 key pair with its key contexts set up once.
+///
+/// Created by `Rsa2048KeyPair::to_handle`. The contexts are kept across
+/// calls, one for every thread that has used the handle at the same time.
+/// The output buffer is sized once per call. With the `parallel` feature,
+/// a call made inside `ThreadPool::install` spreads the blocks of the buffer
+/// over the pool workers.
+pub struct Rsa2048KeyHandle {
+    pubkeys: KeyCache<SgxRsaPubKey>,
+    privkeys: KeyCache<SgxRsaPrivKey>,
+}
+
+impl Rsa2048KeyHandle {
+    /// Encrypt a u8 slice to a Vec<u8>. Returns the length of ciphertext if OK.
+    pub fn encrypt_buffer(&self, plaintext: &[u8], ciphertext: &mut Vec<u8>) -> SgxResult<usize> {
+        block::encrypt_buffer(&self.pubkeys, BLOCK_SIZE, plaintext, ciphertext)
+    }
+
+    /// Decrypt a u8 slice to a Vec<u8>. Returns the length of plaintext if OK.
+    pub fn decrypt_buffer(&self, ciphertext: &[u8], plaintext: &mut Vec<u8>) -> SgxResult<usize> {
+        block::decrypt_buffer(&self.privkeys, BLOCK_SIZE, ciphertext, plaintext)
+    }
+}
+
+impl fmt::Debug for Rsa2048KeyHandle {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str("Rsa2048KeyHandle")
+    }
+}
+
+/// RSA 2048 public key with its key context set up once.
+///
+/// Created by `Rsa2048PubKey::to_handle`; see `Rsa2048KeyHandle`.
+pub struct Rsa2048PubKeyHandle {
+    pubkeys: KeyCache<SgxRsaPubKey>,
+}
+
+impl Rsa2048PubKeyHandle {
+    /// Encrypt a u8 slice to a Vec<u8>. Returns the length of ciphertext if OK.
+    pub fn encrypt_buffer(&self, plaintext: &[u8], ciphertext: &mut Vec<u8>) -> SgxResult<usize> {
+        block::encrypt_buffer(&self.pubkeys, BLOCK_SIZE, plaintext, ciphertext)
+    }
+}
+
+impl fmt::Debug for Rsa2048PubKeyHandle {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str("Rsa2048PubKeyHandle")
+    }
+}
+
 #[cfg(test)]
 mod tests {
     extern crate rdrand;
@@ -435,6 +445,24 @@ mod tests {
         assert_eq!("A".repeat(1000), String::from_utf8(decrypted).unwrap());
     }
 
+    #[test]
+    fn handle_enc_dec() {
+        let plaintext: Vec<u8> = "H".repeat(1000).into_bytes();
+        let kp = Rsa2048KeyPair::new().unwrap();
+        let handle = kp.to_handle().unwrap();
+        let pub_handle = kp.export_pubkey().unwrap().to_handle().unwrap();
+        for _ in 0..2 {
+            let mut ciphertext: Vec<u8> = Vec::new();
+            assert!(pub_handle.encrypt_buffer(&plaintext, &mut ciphertext).is_ok());
+            let mut decrypted: Vec<u8> = Vec::new();
+            assert!(handle.decrypt_buffer(&ciphertext, &mut decrypted).is_ok());
+            assert_eq!("H".repeat(1000), String::from_utf8(decrypted).unwrap());
+        }
+        let mut decrypted: Vec<u8> = Vec::new();
+        assert!(handle.decrypt_buffer(&[0; 100], &mut decrypted).is_err());
+        assert!(Rsa2048KeyPair::default().to_handle().is_err());
+    }
+
     #[test]
     fn export_test() {
         let plaintext: Vec<u8> = "T".repeat(1000).into_bytes();
@@ -474,4 +502,17 @@ mod tests {
         let mut decrypted: Vec<u8> = Vec::new();
         b.iter(|| kp.decrypt_buffer(&ciphertext, &mut decrypted));
     }
+
+    #[bench]
+    fn handle_decrypt_speed_bench(b: &mut Bencher) {
+        let mut rng = RdRand::new().unwrap();
+        let mut buffer = vec![0;1*1024*1024];
+        let kp = Rsa2048KeyPair::new().unwrap();
+        let handle = kp.to_handle().unwrap();
+        let mut ciphertext: Vec<u8> = Vec::new();
+        rng.fill_bytes(&mut buffer);
+        handle.encrypt_buffer(&buffer, &mut ciphertext).unwrap();
+        let mut decrypted: Vec<u8> = Vec::new();
+        b.iter(|| handle.decrypt_buffer(&ciphertext, &mut decrypted));
+    }
 }
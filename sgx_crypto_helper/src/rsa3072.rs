@@ -1,14 +1,15 @@
 use crypto::rsgx_create_rsa_key_pair;
 use crypto::{SgxRsaPrivKey, SgxRsaPubKey};
 use itertools::Itertools;
-use sgx_types::sgx_status_t;
 use sgx_types::SgxResult;
 use sgx_types::{SGX_RSA3072_KEY_SIZE, SGX_RSA3072_PRI_EXP_SIZE, SGX_RSA3072_PUB_EXP_SIZE};
 pub const SGX_RSA3072_DEFAULT_E: [u8;SGX_RSA3072_PUB_EXP_SIZE]    = [0x01, 0x00, 0x00, 0x01]; // 65537
+const BLOCK_SIZE: usize = SGX_RSA3072_KEY_SIZE;
 use std::fmt;
 
 use std::prelude::v1::*;
 use crate::RsaKeyPair;
+use crate::block::{self, KeyCache};
 use serde_derive::*;
 
 big_array! { BigArray; }
@@ -159,53 +160,13 @@ impl RsaKeyPair for Rsa3072KeyPair {
     }
 
     fn encrypt_buffer(self, plaintext: &[u8], ciphertext: &mut Vec<u8>) -> SgxResult<usize> {
-        let pubkey = self.to_pubkey()?;
-        let bs = 384;
-
-        let bs_plain = bs - 2 * 256 / 8 - 2;
-        let count = (plaintext.len() + bs_plain - 1) / bs_plain;
-        ciphertext.resize(bs * count, 0);
-
-        for i in 0..count {
-            let cipher_slice = &mut ciphertext[i * bs..i * bs + bs];
-            let mut out_len = bs;
-            let plain_slice =
-                &plaintext[i * bs_plain..std::cmp::min(i * bs_plain + bs_plain, plaintext.len())];
-
-            pubkey.encrypt_sha256(cipher_slice, &mut out_len, plain_slice)?;
-        }
-
-        Ok(ciphertext.len())
+        let pubkeys = KeyCache::new(move || self.to_pubkey());
+        block::encrypt_buffer(&pubkeys, BLOCK_SIZE, plaintext, ciphertext)
     }
 
     fn decrypt_buffer(self, ciphertext: &[u8], plaintext: &mut Vec<u8>) -> SgxResult<usize> {
-        let privkey = self.to_privkey()?;
-        let bs = 384;
-
-        if ciphertext.len() % bs != 0 {
-            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
-        }
-
-        // Additional one byte is required in 1.0.9
-        // let bs_plain = bs - 2 * 256 / 8 - 2;
-        // In 2.6, we need a longer buf to put the decrypted data.
-        // The output length is exactly bs_plain above, but it results in
-        // SGX_ERROR_INVALID_PARAMETER.
-        let bs_plain = bs;
-        let count = ciphertext.len() / bs;
-        plaintext.clear();
-
-        for i in 0..count {
-            let cipher_slice = &ciphertext[i * bs..i * bs + bs];
-            let plain_slice = &mut vec![0;bs_plain];
-            let mut plain_len = bs_plain;
-
-            privkey.decrypt_sha256(plain_slice, &mut plain_len, cipher_slice)?;
-            let mut decoded_vec = plain_slice[..plain_len].to_vec();
-            plaintext.append(&mut decoded_vec);
-        }
-
-        Ok(plaintext.len())
+        let privkeys = KeyCache::new(move || self.to_privkey());
+        block::decrypt_buffer(&privkeys, BLOCK_SIZE, ciphertext, plaintext)
     }
 }
 
@@ -216,6 +177,19 @@ impl Rsa3072KeyPair {
             e: self.e,
         })
     }
+
+    /// Sets up key contexts to be reused by every call on the returned
+    /// handle, instead of once per call as `encrypt_buffer` and
+    /// `decrypt_buffer` do.
+    pub fn to_handle(self) -> SgxResult<Rsa3072KeyHandle> {
+        let handle = Rsa3072KeyHandle {
+            pubkeys: KeyCache::new(move || self.to_pubkey()),
+            privkeys: KeyCache::new(move || self.to_privkey()),
+        };
+        handle.pubkeys.warm_up()?;
+        handle.privkeys.warm_up()?;
+        Ok(handle)
+    }
 }
 
 #[cfg(any(feature = "mesalock_sgx", target_env = "sgx"))]
@@ -258,23 +232,18 @@ impl Rsa3072PubKey {
     }
 
     pub fn encrypt_buffer(self, plaintext: &[u8], ciphertext: &mut Vec<u8>) -> SgxResult<usize> {
-        let pubkey = self.to_pubkey()?;
-        let bs = 384;
-
-        let bs_plain = bs - 2 * 256 / 8 - 2;
-        let count = (plaintext.len() + bs_plain - 1) / bs_plain;
-        ciphertext.resize(bs * count, 0);
-
-        for i in 0..count {
-            let cipher_slice = &mut ciphertext[i * bs..i * bs + bs];
-            let mut out_len = bs;
-            let plain_slice =
-                &plaintext[i * bs_plain..std::cmp::min(i * bs_plain + bs_plain, plaintext.len())];
-
-            pubkey.encrypt_sha256(cipher_slice, &mut out_len, plain_slice)?;
-        }
+        let pubkeys = KeyCache::new(move || self.to_pubkey());
+        block::encrypt_buffer(&pubkeys, BLOCK_SIZE, plaintext, ciphertext)
+    }
 
-        Ok(ciphertext.len())
+    /// Sets up a key context to be reused by every call on the returned
+    /// handle.
+    pub fn to_handle(self) -> SgxResult<Rsa3072PubKeyHandle> {
+        let handle = Rsa3072PubKeyHandle {
+            pubkeys: KeyCache::new(move || self.to_pubkey()),
+        };
+        handle.pubkeys.warm_up()?;
+        Ok(handle)
     }
 }
 
@@ -286,6 +255,56 @@ impl fmt::Debug for Rsa3072PubKey {
     }
 }
 
+/// RSA 3072 key pair with its key contexts set up once.
+///
+/// Created by `Rsa3072KeyPair::to_handle`. The contexts are kept across
+/// calls, one for every thread that has used the handle at the same time.
+/// The output buffer is sized once per call. With the `parallel` feature,
+/// a call made inside `ThreadPool::install` spreads the blocks of the buffer
+/// over the pool workers.
+pub struct Rsa3072KeyHandle {
+    pubkeys: KeyCache<SgxRsaPubKey>,
+    privkeys: KeyCache<SgxRsaPrivKey>,
+}
+
+impl Rsa3072KeyHandle {
+    /// Encrypt a u8 slice to a Vec<u8>. Returns the length of ciphertext if OK.
+    pub fn encrypt_buffer(&self, plaintext: &[u8], ciphertext: &mut Vec<u8>) -> SgxResult<usize> {
+        block::encrypt_buffer(&self.pubkeys, BLOCK_SIZE, plaintext, ciphertext)
+    }
+
+    /// Decrypt a u8 slice to a Vec<u8>. Returns the length of plaintext if OK.
+    pub fn decrypt_buffer(&self, ciphertext: &[u8], plaintext: &mut Vec<u8>) -> SgxResult<usize> {
+        block::decrypt_buffer(&self.privkeys, BLOCK_SIZE, ciphertext, plaintext)
+    }
+}
+
+impl fmt::Debug for Rsa3072KeyHandle {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str("Rsa3072KeyHandle")
+    }
+}
+
+/// RSA 3072 public key with its key context set up once.
+///
+/// Created by `Rsa3072PubKey::to_handle`; see `Rsa3072KeyHandle`.
+pub struct Rsa3072PubKeyHandle {
+    pubkeys: KeyCache<SgxRsaPubKey>,
+}
+
+impl Rsa3072PubKeyHandle {
+    /// Encrypt a u8 slice to a Vec<u8>. Returns the length of ciphertext if OK.
+    pub fn encrypt_buffer(&self, plaintext: &[u8], ciphertext: &mut Vec<u8>) -> SgxResult<usize> {
+        block::encrypt_buffer(&self.pubkeys, BLOCK_SIZE, plaintext, ciphertext)
+    }
+}
+
+impl fmt::Debug for Rsa3072PubKeyHandle {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str("Rsa3072PubKeyHandle")
+    }
+}
+
 #[cfg(test)]
 mod tests {
     extern crate rdrand;
@@ -425,6 +444,24 @@ mod tests {
         assert_eq!("A".repeat(1000), String::from_utf8(decrypted).unwrap());
     }
 
+    #[test]
+    fn handle_enc_dec() {
+        let plaintext: Vec<u8> = "H".repeat(1000).into_bytes();
+        let kp = Rsa3072KeyPair::new().unwrap();
+        let handle = kp.to_handle().unwrap();
+        let pub_handle = kp.export_pubkey().unwrap().to_handle().unwrap();
+        for _ in 0..2 {
+            let mut ciphertext: Vec<u8> = Vec::new();
+            assert!(pub_handle.encrypt_buffer(&plaintext, &mut ciphertext).is_ok());
+            let mut decrypted: Vec<u8> = Vec::new();
+            assert!(handle.decrypt_buffer(&ciphertext, &mut decrypted).is_ok());
+            assert_eq!("H".repeat(1000), String::from_utf8(decrypted).unwrap());
+        }
+        let mut decrypted: Vec<u8> = Vec::new();
+        assert!(handle.decrypt_buffer(&[0; 100], &mut decrypted).is_err());
+        assert!(Rsa3072KeyPair::default().to_handle().is_err());
+    }
+
     #[test]
     fn export_test() {
         let plaintext: Vec<u8> = "T".repeat(1000).into_bytes();
@@ -464,4 +501,17 @@ mod tests {
         let mut decrypted: Vec<u8> = Vec::new();
         b.iter(|| kp.decrypt_buffer(&ciphertext, &mut decrypted));
     }
+
+    #[bench]
+    fn handle_decrypt_speed_bench(b: &mut Bencher) {
+        let mut rng = RdRand::new().unwrap();
+        let mut buffer = vec![0;1*1024*1024];
+        let kp = Rsa3072KeyPair::new().unwrap();
+        let handle = kp.to_handle().unwrap();
+        let mut ciphertext: Vec<u8> = Vec::new();
+        rng.fill_bytes(&mut buffer);
+        handle.encrypt_buffer(&buffer, &mut ciphertext).unwrap();
+        let mut decrypted: Vec<u8> = Vec::new();
+        b.iter(|| handle.decrypt_buffer(&ciphertext, &mut decrypted));
+    }
 }
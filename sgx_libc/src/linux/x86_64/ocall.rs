@@ -23,6 +23,49 @@ use alloc::boxed::Box;
 use core::ptr;
 use core::mem;
 
+/// Makes an OCALL through its generated `u_*_ocall` bridge and, with the
+/// `ocall_profile` feature, records it in the transition profile under the
+/// name of the bridge. The optional first argument is the size of the data
+/// buffers the call copies across the boundary; fixed-size arguments are
+/// not counted.
+///
+/// ```ignore
+/// let status = ocall_profiled!(len, u_send_ocall(&mut result, &mut error, fd, buf, len, flags));
+/// ```
+#[cfg(feature = "ocall_profile")]
+#[macro_export]
+macro_rules! ocall_profiled {
+    ($bytes:expr, $ocall:ident $args:tt) => {{
+        static SITE: $crate::ocall::ProfileSite = $crate::ocall::ProfileSite::ocall(stringify!($ocall));
+        let _profile = SITE.enter($bytes as usize);
+        $ocall $args
+    }};
+    ($ocall:ident $args:tt) => {{
+        static SITE: $crate::ocall::ProfileSite = $crate::ocall::ProfileSite::ocall(stringify!($ocall));
+        let _profile = SITE.enter(0);
+        $ocall $args
+    }};
+}
+
+#[cfg(not(feature = "ocall_profile"))]
+#[macro_export]
+macro_rules! ocall_profiled {
+    ($bytes:expr, $ocall:ident $args:tt) => { $ocall $args };
+    ($ocall:ident $args:tt) => { $ocall $args };
+}
+
+mod staging;
+use self::staging::OcallBuf;
+pub use self::staging::{staging_stats, staging_cap, set_staging_cap, staging_trim, StagingStats};
+mod batch;
+pub use self::batch::*;
+mod log;
+pub use self::log::*;
+#[cfg(feature = "ocall_profile")]
+mod profile;
+#[cfg(feature = "ocall_profile")]
+pub use self::profile::*;
+
 const MAX_OCALL_ALLOC_SIZE: size_t = 0x4000; //16K
 extern "C" {
     // memory
@@ -464,9 +507,9 @@ extern "C" {
 pub unsafe fn malloc(size: size_t) -> *mut c_void {
     let mut result: *mut c_void = ptr::null_mut();
     let mut error: c_int = 0;
-    let status = u_malloc_ocall(&mut result as *mut *mut c_void,
-                                &mut error as *mut c_int,
-                                size);
+    let status = ocall_profiled!(u_malloc_ocall(&mut result as *mut *mut c_void,
+                                                &mut error as *mut c_int,
+                                                size));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result.is_null() {
@@ -486,7 +529,7 @@ pub unsafe fn malloc(size: size_t) -> *mut c_void {
 }
 
 pub unsafe fn free(p: *mut c_void) {
-    let _ = u_free_ocall(p);
+    let _ = ocall_profiled!(u_free_ocall(p));
 }
 
 pub unsafe fn mmap(start: *mut c_void,
@@ -497,14 +540,14 @@ pub unsafe fn mmap(start: *mut c_void,
                    offset: off_t) -> *mut c_void {
     let mut result: *mut c_void = ptr::null_mut();
     let mut error: c_int = 0;
-    let status = u_mmap_ocall(&mut result as *mut *mut c_void,
-                              &mut error as *mut c_int,
-                              start,
-                              length,
-                              prot,
-                              flags,
-                              fd,
-                              offset);
+    let status = ocall_profiled!(u_mmap_ocall(&mut result as *mut *mut c_void,
+                                              &mut error as *mut c_int,
+                                              start,
+                                              length,
+                                              prot,
+                                              flags,
+                                              fd,
+                                              offset));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result as isize == -1 {
@@ -526,10 +569,10 @@ pub unsafe fn mmap(start: *mut c_void,
 pub unsafe fn munmap(start: *mut c_void, length: size_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_munmap_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                start,
-                                length);
+    let status = ocall_profiled!(u_munmap_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                start,
+                                                length));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -545,11 +588,11 @@ pub unsafe fn munmap(start: *mut c_void, length: size_t) -> c_int {
 pub unsafe fn msync(addr: *mut c_void, length: size_t, flags: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_msync_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               addr,
-                               length,
-                               flags);
+    let status = ocall_profiled!(u_msync_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               addr,
+                                               length,
+                                               flags));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -565,11 +608,11 @@ pub unsafe fn msync(addr: *mut c_void, length: size_t, flags: c_int) -> c_int {
 pub unsafe fn mprotect(addr: *mut c_void, length: size_t, prot: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_mprotect_ocall(&mut result as *mut c_int,
-                                  &mut error as *mut c_int,
-                                  addr,
-                                  length,
-                                  prot);
+    let status = ocall_profiled!(u_mprotect_ocall(&mut result as *mut c_int,
+                                                  &mut error as *mut c_int,
+                                                  addr,
+                                                  length,
+                                                  prot));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -584,7 +627,7 @@ pub unsafe fn mprotect(addr: *mut c_void, length: size_t, prot: c_int) -> c_int
 
 pub unsafe fn getuid() -> uid_t {
     let mut result: uid_t = 0;
-    let status = u_getuid_ocall(&mut result as *mut uid_t);
+    let status = ocall_profiled!(u_getuid_ocall(&mut result as *mut uid_t));
     if status != sgx_status_t::SGX_SUCCESS {
          set_errno(ESGX);
          result = 0;
@@ -594,7 +637,7 @@ pub unsafe fn getuid() -> uid_t {
 
 pub unsafe fn environ() -> *const *const c_char {
     let mut result: *const *const c_char = ptr::null();
-    let status = u_environ_ocall(&mut result as *mut *const *const c_char);
+    let status = ocall_profiled!(u_environ_ocall(&mut result as *mut *const *const c_char));
 
     if status != sgx_status_t::SGX_SUCCESS {
         result = ptr::null();
@@ -604,7 +647,7 @@ pub unsafe fn environ() -> *const *const c_char {
 
 pub unsafe fn getenv(name: *const c_char) -> *const c_char {
     let mut result: *const c_char = ptr::null();
-    let status = u_getenv_ocall(&mut result as *mut *const c_char, name);
+    let status = ocall_profiled!(u_getenv_ocall(&mut result as *mut *const c_char, name));
 
     if status != sgx_status_t::SGX_SUCCESS {
         result = ptr::null();
@@ -615,11 +658,11 @@ pub unsafe fn getenv(name: *const c_char) -> *const c_char {
 pub unsafe fn setenv(name: *const c_char, value: *const c_char, overwrite: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_setenv_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                name,
-                                value,
-                                overwrite);
+    let status = ocall_profiled!(u_setenv_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                name,
+                                                value,
+                                                overwrite));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -635,9 +678,9 @@ pub unsafe fn setenv(name: *const c_char, value: *const c_char, overwrite: c_int
 pub unsafe fn unsetenv(name: *const c_char) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_unsetenv_ocall(&mut result as *mut c_int,
-                                  &mut error as *mut c_int,
-                                  name);
+    let status = ocall_profiled!(u_unsetenv_ocall(&mut result as *mut c_int,
+                                                  &mut error as *mut c_int,
+                                                  name));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -653,7 +696,7 @@ pub unsafe fn unsetenv(name: *const c_char) -> c_int {
 pub unsafe fn getcwd(buf: *mut c_char, size: size_t) -> *mut c_char {
     let mut result: *mut c_char = ptr::null_mut();
     let mut error: c_int = 0;
-    let status = u_getcwd_ocall(&mut result as *mut *mut c_char, &mut error as *mut c_int, buf, size);
+    let status = ocall_profiled!(size, u_getcwd_ocall(&mut result as *mut *mut c_char, &mut error as *mut c_int, buf, size));
     if status == sgx_status_t::SGX_SUCCESS {
         if result.is_null() {
             set_errno(error);
@@ -670,7 +713,7 @@ pub unsafe fn getcwd(buf: *mut c_char, size: size_t) -> *mut c_char {
 pub unsafe fn chdir(dir: *const c_char) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_chdir_ocall(&mut result as *mut c_int, &mut error as *mut c_int, dir);
+    let status = ocall_profiled!(u_chdir_ocall(&mut result as *mut c_int, &mut error as *mut c_int, dir));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -688,12 +731,12 @@ pub unsafe fn getpwuid_r(uid: uid_t,
                          buflen: size_t,
                          passwd_result:  *mut *mut passwd) -> c_int {
     let mut result: c_int = 0;
-    let status = u_getpwuid_r_ocall(&mut result as *mut c_int,
-                                    uid,
-                                    pwd,
-                                    buf,
-                                    buflen,
-                                    passwd_result);
+    let status = ocall_profiled!(buflen, u_getpwuid_r_ocall(&mut result as *mut c_int,
+                                                            uid,
+                                                            pwd,
+                                                            buf,
+                                                            buflen,
+                                                            passwd_result));
     if status == sgx_status_t::SGX_SUCCESS && result == 0 {
         let pwd_ret = *passwd_result;
         if !pwd_ret.is_null() {
@@ -742,10 +785,10 @@ pub unsafe fn getpwuid_r(uid: uid_t,
 pub unsafe fn open(path: *const c_char, flags: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_open_ocall(&mut result as *mut c_int,
-                              &mut error as *mut c_int,
-                              path,
-                              flags);
+    let status = ocall_profiled!(u_open_ocall(&mut result as *mut c_int,
+                                              &mut error as *mut c_int,
+                                              path,
+                                              flags));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -761,11 +804,11 @@ pub unsafe fn open(path: *const c_char, flags: c_int) -> c_int {
 pub unsafe fn open64(path: *const c_char, oflag: c_int, mode: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_open64_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                path,
-                                oflag,
-                                mode);
+    let status = ocall_profiled!(u_open64_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                path,
+                                                oflag,
+                                                mode));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -781,10 +824,10 @@ pub unsafe fn open64(path: *const c_char, oflag: c_int, mode: c_int) -> c_int {
 pub unsafe fn fstat(fd: c_int, buf: *mut stat) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_fstat_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               fd,
-                               buf);
+    let status = ocall_profiled!(u_fstat_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               fd,
+                                               buf));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -800,10 +843,10 @@ pub unsafe fn fstat(fd: c_int, buf: *mut stat) -> c_int {
 pub unsafe fn fstat64(fd: c_int, buf: *mut stat64) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_fstat64_ocall(&mut result as *mut c_int,
-                                 &mut error as *mut c_int,
-                                 fd,
-                                 buf);
+    let status = ocall_profiled!(u_fstat64_ocall(&mut result as *mut c_int,
+                                                 &mut error as *mut c_int,
+                                                 fd,
+                                                 buf));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -819,10 +862,10 @@ pub unsafe fn fstat64(fd: c_int, buf: *mut stat64) -> c_int {
 pub unsafe fn stat(path: *const c_char, buf: *mut stat) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_stat_ocall(&mut result as *mut c_int,
-                              &mut error as *mut c_int,
-                              path,
-                              buf);
+    let status = ocall_profiled!(u_stat_ocall(&mut result as *mut c_int,
+                                              &mut error as *mut c_int,
+                                              path,
+                                              buf));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -838,10 +881,10 @@ pub unsafe fn stat(path: *const c_char, buf: *mut stat) -> c_int {
 pub unsafe fn stat64(path: *const c_char, buf: *mut stat64) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_stat64_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                path,
-                                buf);
+    let status = ocall_profiled!(u_stat64_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                path,
+                                                buf));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -857,10 +900,10 @@ pub unsafe fn stat64(path: *const c_char, buf: *mut stat64) -> c_int {
 pub unsafe fn lstat(path: *const c_char, buf: *mut stat) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_lstat_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               path,
-                               buf);
+    let status = ocall_profiled!(u_lstat_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               path,
+                                               buf));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -876,10 +919,10 @@ pub unsafe fn lstat(path: *const c_char, buf: *mut stat) -> c_int {
 pub unsafe fn lstat64(path: *const c_char, buf: *mut stat64) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_lstat64_ocall(&mut result as *mut c_int,
-                                 &mut error as *mut c_int,
-                                 path,
-                                 buf);
+    let status = ocall_profiled!(u_lstat64_ocall(&mut result as *mut c_int,
+                                                 &mut error as *mut c_int,
+                                                 path,
+                                                 buf));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -895,11 +938,11 @@ pub unsafe fn lstat64(path: *const c_char, buf: *mut stat64) -> c_int {
 pub unsafe fn lseek(fd: c_int, offset: off_t, whence: c_int) -> off_t {
     let mut result: off_t = 0;
     let mut error: c_int = 0;
-    let status = u_lseek_ocall(&mut result as *mut off_t,
-                               &mut error as *mut c_int,
-                               fd,
-                               offset,
-                               whence);
+    let status = ocall_profiled!(u_lseek_ocall(&mut result as *mut off_t,
+                                               &mut error as *mut c_int,
+                                               fd,
+                                               offset,
+                                               whence));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -915,11 +958,11 @@ pub unsafe fn lseek(fd: c_int, offset: off_t, whence: c_int) -> off_t {
 pub unsafe fn lseek64(fd: c_int, offset: off64_t, whence: c_int) -> off64_t {
     let mut result: off64_t = 0;
     let mut error: c_int = 0;
-    let status = u_lseek64_ocall(&mut result as *mut off64_t,
-                                 &mut error as *mut c_int,
-                                 fd,
-                                 offset,
-                                 whence);
+    let status = ocall_profiled!(u_lseek64_ocall(&mut result as *mut off64_t,
+                                                 &mut error as *mut c_int,
+                                                 fd,
+                                                 offset,
+                                                 whence));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -935,10 +978,10 @@ pub unsafe fn lseek64(fd: c_int, offset: off64_t, whence: c_int) -> off64_t {
 pub unsafe fn ftruncate(fd: c_int, length: off_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_ftruncate_ocall(&mut result as *mut c_int,
-                                   &mut error as *mut c_int,
-                                   fd,
-                                   length);
+    let status = ocall_profiled!(u_ftruncate_ocall(&mut result as *mut c_int,
+                                                   &mut error as *mut c_int,
+                                                   fd,
+                                                   length));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -954,10 +997,10 @@ pub unsafe fn ftruncate(fd: c_int, length: off_t) -> c_int {
 pub unsafe fn ftruncate64(fd: c_int, length: off64_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_ftruncate64_ocall(&mut result as *mut c_int,
-                                     &mut error as *mut c_int,
-                                     fd,
-                                     length);
+    let status = ocall_profiled!(u_ftruncate64_ocall(&mut result as *mut c_int,
+                                                     &mut error as *mut c_int,
+                                                     fd,
+                                                     length));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -973,10 +1016,10 @@ pub unsafe fn ftruncate64(fd: c_int, length: off64_t) -> c_int {
 pub unsafe fn truncate(path: *const c_char, length: off_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_truncate_ocall(&mut result as *mut c_int,
-                                  &mut error as *mut c_int,
-                                  path,
-                                  length);
+    let status = ocall_profiled!(u_truncate_ocall(&mut result as *mut c_int,
+                                                  &mut error as *mut c_int,
+                                                  path,
+                                                  length));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -992,10 +1035,10 @@ pub unsafe fn truncate(path: *const c_char, length: off_t) -> c_int {
 pub unsafe fn truncate64(path: *const c_char, length: off64_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_truncate64_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    path,
-                                    length);
+    let status = ocall_profiled!(u_truncate64_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    path,
+                                                    length));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1011,9 +1054,9 @@ pub unsafe fn truncate64(path: *const c_char, length: off64_t) -> c_int {
 pub unsafe fn fsync(fd: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_fsync_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               fd);
+    let status = ocall_profiled!(u_fsync_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               fd));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1029,9 +1072,9 @@ pub unsafe fn fsync(fd: c_int) -> c_int {
 pub unsafe fn fdatasync(fd: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_fdatasync_ocall(&mut result as *mut c_int,
-                                   &mut error as *mut c_int,
-                                   fd);
+    let status = ocall_profiled!(u_fdatasync_ocall(&mut result as *mut c_int,
+                                                   &mut error as *mut c_int,
+                                                   fd));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1047,10 +1090,10 @@ pub unsafe fn fdatasync(fd: c_int) -> c_int {
 pub unsafe fn fchmod(fd: c_int, mode: mode_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_fchmod_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                fd,
-                                mode);
+    let status = ocall_profiled!(u_fchmod_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                fd,
+                                                mode));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1066,9 +1109,9 @@ pub unsafe fn fchmod(fd: c_int, mode: mode_t) -> c_int {
 pub unsafe fn unlink(pathname: *const c_char) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_unlink_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                pathname);
+    let status = ocall_profiled!(u_unlink_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                pathname));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1084,10 +1127,10 @@ pub unsafe fn unlink(pathname: *const c_char) -> c_int {
 pub unsafe fn link(oldpath: *const c_char, newpath: *const c_char) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_link_ocall(&mut result as *mut c_int,
-                              &mut error as *mut c_int,
-                              oldpath,
-                              newpath);
+    let status = ocall_profiled!(u_link_ocall(&mut result as *mut c_int,
+                                              &mut error as *mut c_int,
+                                              oldpath,
+                                              newpath));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1103,10 +1146,10 @@ pub unsafe fn link(oldpath: *const c_char, newpath: *const c_char) -> c_int {
 pub unsafe fn rename(oldpath: *const c_char, newpath: *const c_char) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_rename_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                oldpath,
-                                newpath);
+    let status = ocall_profiled!(u_rename_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                oldpath,
+                                                newpath));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1122,10 +1165,10 @@ pub unsafe fn rename(oldpath: *const c_char, newpath: *const c_char) -> c_int {
 pub unsafe fn chmod(path: *const c_char, mode: mode_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_chmod_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               path,
-                               mode);
+    let status = ocall_profiled!(u_chmod_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               path,
+                                               mode));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1141,11 +1184,11 @@ pub unsafe fn chmod(path: *const c_char, mode: mode_t) -> c_int {
 pub unsafe fn readlink(path: *const c_char, buf: *mut c_char, bufsz: size_t) -> ssize_t {
     let mut result: ssize_t = 0;
     let mut error: c_int = 0;
-    let status = u_readlink_ocall(&mut result as *mut ssize_t,
-                                  &mut error as *mut c_int,
-                                  path,
-                                  buf,
-                                  bufsz);
+    let status = ocall_profiled!(bufsz, u_readlink_ocall(&mut result as *mut ssize_t,
+                                                         &mut error as *mut c_int,
+                                                         path,
+                                                         buf,
+                                                         bufsz));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1161,10 +1204,10 @@ pub unsafe fn readlink(path: *const c_char, buf: *mut c_char, bufsz: size_t) ->
 pub unsafe fn symlink(path1: *const c_char, path2: *const c_char) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_symlink_ocall(&mut result as *mut c_int,
-                                 &mut error as *mut c_int,
-                                 path1,
-                                 path2);
+    let status = ocall_profiled!(u_symlink_ocall(&mut result as *mut c_int,
+                                                 &mut error as *mut c_int,
+                                                 path1,
+                                                 path2));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1180,9 +1223,9 @@ pub unsafe fn symlink(path1: *const c_char, path2: *const c_char) -> c_int {
 pub unsafe fn realpath(pathname: *const c_char) -> *mut c_char {
     let mut result: *mut c_char = ptr::null_mut();
     let mut error: c_int = 0;
-    let status = u_realpath_ocall(&mut result as *mut *mut c_char,
-                                  &mut error as *mut c_int,
-                                  pathname);
+    let status = ocall_profiled!(u_realpath_ocall(&mut result as *mut *mut c_char,
+                                                  &mut error as *mut c_int,
+                                                  pathname));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result.is_null() {
@@ -1198,10 +1241,10 @@ pub unsafe fn realpath(pathname: *const c_char) -> *mut c_char {
 pub unsafe fn mkdir(pathname: *const c_char, mode: mode_t) -> c_int {
     let mut error: c_int = 0;
     let mut result: c_int = 0;
-    let status = u_mkdir_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               pathname,
-                               mode);
+    let status = ocall_profiled!(u_mkdir_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               pathname,
+                                               mode));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1217,9 +1260,9 @@ pub unsafe fn mkdir(pathname: *const c_char, mode: mode_t) -> c_int {
 pub unsafe fn rmdir(pathname: *const c_char) -> c_int {
     let mut error: c_int = 0;
     let mut result: c_int = 0;
-    let status = u_rmdir_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               pathname);
+    let status = ocall_profiled!(u_rmdir_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               pathname));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1235,9 +1278,9 @@ pub unsafe fn rmdir(pathname: *const c_char) -> c_int {
 pub unsafe fn opendir(pathname: *const c_char) -> *mut DIR {
     let mut result: *mut DIR = ptr::null_mut();
     let mut error: c_int = 0;
-    let status = u_opendir_ocall(&mut result as *mut *mut DIR,
-                                 &mut error as *mut c_int,
-                                 pathname);
+    let status = ocall_profiled!(u_opendir_ocall(&mut result as *mut *mut DIR,
+                                                 &mut error as *mut c_int,
+                                                 pathname));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result.is_null() {
@@ -1254,10 +1297,10 @@ pub unsafe fn readdir64_r(dirp: *mut DIR,
                           entry: *mut dirent64,
                           dirresult: *mut *mut dirent64) -> c_int {
     let mut result: c_int = 0;
-    let status = u_readdir64_r_ocall(&mut result as *mut c_int,
-                                     dirp,
-                                     entry,
-                                     dirresult);
+    let status = ocall_profiled!(u_readdir64_r_ocall(&mut result as *mut c_int,
+                                                     dirp,
+                                                     entry,
+                                                     dirresult));
     if status == sgx_status_t::SGX_SUCCESS && result == 0 {
         let dir_ret = *dirresult;
         if !dir_ret.is_null() {
@@ -1275,9 +1318,9 @@ pub unsafe fn readdir64_r(dirp: *mut DIR,
 pub unsafe fn closedir(dirp: *mut DIR) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_closedir_ocall(&mut result as *mut c_int,
-                                  &mut error as *mut c_int,
-                                  dirp);
+    let status = ocall_profiled!(u_closedir_ocall(&mut result as *mut c_int,
+                                                  &mut error as *mut c_int,
+                                                  dirp));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1293,9 +1336,9 @@ pub unsafe fn closedir(dirp: *mut DIR) -> c_int {
 pub unsafe fn dirfd(dirp: *mut DIR) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_dirfd_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               dirp);
+    let status = ocall_profiled!(u_dirfd_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               dirp));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1314,12 +1357,12 @@ pub unsafe fn fstatat64(dirfd: c_int,
                         flags: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_fstatat64_ocall(&mut result as *mut c_int,
-                                   &mut error as *mut c_int,
-                                   dirfd,
-                                   pathname,
-                                   buf,
-                                   flags);
+    let status = ocall_profiled!(u_fstatat64_ocall(&mut result as *mut c_int,
+                                                   &mut error as *mut c_int,
+                                                   dirfd,
+                                                   pathname,
+                                                   buf,
+                                                   flags));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1345,22 +1388,19 @@ pub unsafe fn read(fd: c_int, buf: *mut c_void, count: size_t) -> ssize_t {
         return -1;
     }
 
-    let tmp_buf = if count <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocalloc(count)
-    } else {
-        malloc(count)
+    let mut tmp_buf = match OcallBuf::alloc(count) {
+        Some(tmp_buf) => tmp_buf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
     };
-    if tmp_buf.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
-    tmp_buf.write_bytes(0_u8, count);
 
-    let status = u_read_ocall(&mut result as *mut ssize_t,
-                              &mut error as *mut c_int,
-                              fd,
-                              tmp_buf,
-                              count);
+    let status = ocall_profiled!(count, u_read_ocall(&mut result as *mut ssize_t,
+                                                     &mut error as *mut c_int,
+                                                     fd,
+                                                     tmp_buf.as_mut_ptr(),
+                                                     count));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1371,13 +1411,45 @@ pub unsafe fn read(fd: c_int, buf: *mut c_void, count: size_t) -> ssize_t {
         result = -1;
     }
 
-    if result != -1 {
-        ptr::copy_nonoverlapping(tmp_buf as *const u8, buf as *mut u8, count);
+    if result > count as ssize_t {
+        set_errno(ESGX);
+        result = -1;
+    } else if result > 0 {
+        ptr::copy_nonoverlapping(tmp_buf.as_ptr() as *const u8, buf as *mut u8, result as usize);
+    }
+    result
+}
+
+/// Like [`read`], but the data is read into `buf` in untrusted memory
+/// directly, without a bounce buffer and copy inside the enclave. Meant for
+/// payloads that are encrypted or otherwise need no confidentiality.
+pub unsafe fn read_untrusted(fd: c_int, buf: *mut c_void, count: size_t) -> ssize_t {
+    let mut result: ssize_t = 0;
+    let mut error: c_int = 0;
+
+    if buf.is_null() || sgx_is_outside_enclave(buf, count) == 0 {
+        set_errno(EINVAL);
+        return -1;
     }
-    if count <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocfree();
+
+    let status = ocall_profiled!(u_read_ocall(&mut result as *mut ssize_t,
+                                              &mut error as *mut c_int,
+                                              fd,
+                                              buf,
+                                              count));
+
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
     } else {
-        free(tmp_buf);
+        set_errno(ESGX);
+        result = -1;
+    }
+
+    if result > count as ssize_t {
+        set_errno(ESGX);
+        result = -1;
     }
     result
 }
@@ -1395,23 +1467,20 @@ pub unsafe fn pread64(fd: c_int, buf: *mut c_void, count: size_t, offset: off64_
         return -1;
     }
 
-    let tmp_buf = if count <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocalloc(count)
-    } else {
-        malloc(count)
+    let mut tmp_buf = match OcallBuf::alloc(count) {
+        Some(tmp_buf) => tmp_buf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
     };
-    if tmp_buf.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
-    tmp_buf.write_bytes(0_u8, count);
 
-    let status = u_pread64_ocall(&mut result as *mut ssize_t,
-                                 &mut error as *mut c_int,
-                                 fd,
-                                 tmp_buf,
-                                 count,
-                                 offset);
+    let status = ocall_profiled!(count, u_pread64_ocall(&mut result as *mut ssize_t,
+                                                        &mut error as *mut c_int,
+                                                        fd,
+                                                        tmp_buf.as_mut_ptr(),
+                                                        count,
+                                                        offset));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1422,13 +1491,46 @@ pub unsafe fn pread64(fd: c_int, buf: *mut c_void, count: size_t, offset: off64_
         result = -1;
     }
 
-    if result != -1 {
-        ptr::copy_nonoverlapping(tmp_buf as *const u8, buf as *mut u8, count);
+    if result > count as ssize_t {
+        set_errno(ESGX);
+        result = -1;
+    } else if result > 0 {
+        ptr::copy_nonoverlapping(tmp_buf.as_ptr() as *const u8, buf as *mut u8, result as usize);
     }
-    if count <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocfree();
+    result
+}
+
+/// Like [`pread64`], but the data is read into `buf` in untrusted memory
+/// directly, without a bounce buffer and copy inside the enclave. Meant for
+/// payloads that are encrypted or otherwise need no confidentiality.
+pub unsafe fn pread64_untrusted(fd: c_int, buf: *mut c_void, count: size_t, offset: off64_t) -> ssize_t {
+    let mut result: ssize_t = 0;
+    let mut error: c_int = 0;
+
+    if buf.is_null() || sgx_is_outside_enclave(buf, count) == 0 {
+        set_errno(EINVAL);
+        return -1;
+    }
+
+    let status = ocall_profiled!(u_pread64_ocall(&mut result as *mut ssize_t,
+                                                 &mut error as *mut c_int,
+                                                 fd,
+                                                 buf,
+                                                 count,
+                                                 offset));
+
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
     } else {
-        free(tmp_buf);
+        set_errno(ESGX);
+        result = -1;
+    }
+
+    if result > count as ssize_t {
+        set_errno(ESGX);
+        result = -1;
     }
     result
 }
@@ -1456,11 +1558,14 @@ pub unsafe fn readv(fd: c_int, iov: *const iovec, iovcnt: c_int) -> ssize_t {
         }
     }
 
-    let iobase = malloc(iosize) as *mut u8;
-    if iobase.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
+    let mut iobuf = match OcallBuf::alloc(iosize) {
+        Some(iobuf) => iobuf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
+    };
+    let iobase = iobuf.as_mut_ptr() as *mut u8;
     iobase.write_bytes(0_u8, iosize);
 
     let mut tmpiovec: Vec<iovec> = Vec::with_capacity(iovcnt as usize);
@@ -1472,11 +1577,11 @@ pub unsafe fn readv(fd: c_int, iov: *const iovec, iovcnt: c_int) -> ssize_t {
         ptr = ptr.add(io.iov_len as usize);
     }
 
-    let status = u_readv_ocall(&mut result as *mut ssize_t,
-                               &mut error as *mut c_int,
-                               fd,
-                               tmpiovec.as_slice().as_ptr(),
-                               iovcnt);
+    let status = ocall_profiled!(iosize, u_readv_ocall(&mut result as *mut ssize_t,
+                                                       &mut error as *mut c_int,
+                                                       fd,
+                                                       tmpiovec.as_slice().as_ptr(),
+                                                       iovcnt));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1493,7 +1598,6 @@ pub unsafe fn readv(fd: c_int, iov: *const iovec, iovcnt: c_int) -> ssize_t {
         }
     }
 
-    free(iobase as *mut c_void);
     result
 }
 
@@ -1520,11 +1624,14 @@ pub unsafe fn preadv64(fd: c_int, iov: *const iovec, iovcnt: c_int, offset: off6
         }
     }
 
-    let iobase = malloc(iosize) as *mut u8;
-    if iobase.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
+    let mut iobuf = match OcallBuf::alloc(iosize) {
+        Some(iobuf) => iobuf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
+    };
+    let iobase = iobuf.as_mut_ptr() as *mut u8;
     iobase.write_bytes(0_u8, iosize);
 
     let mut tmpiovec: Vec<iovec> = Vec::with_capacity(iovcnt as usize);
@@ -1536,12 +1643,12 @@ pub unsafe fn preadv64(fd: c_int, iov: *const iovec, iovcnt: c_int, offset: off6
         ptr = ptr.add(io.iov_len as usize);
     }
 
-    let status = u_preadv64_ocall(&mut result as *mut ssize_t,
-                               &mut error as *mut c_int,
-                               fd,
-                               tmpiovec.as_slice().as_ptr(),
-                               iovcnt,
-                               offset);
+    let status = ocall_profiled!(iosize, u_preadv64_ocall(&mut result as *mut ssize_t,
+                                                       &mut error as *mut c_int,
+                                                       fd,
+                                                       tmpiovec.as_slice().as_ptr(),
+                                                       iovcnt,
+                                                       offset));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1558,7 +1665,6 @@ pub unsafe fn preadv64(fd: c_int, iov: *const iovec, iovcnt: c_int, offset: off6
         }
     }
 
-    free(iobase as *mut c_void);
     result
 }
 
@@ -1575,22 +1681,54 @@ pub unsafe fn write(fd: c_int, buf: *const c_void, count: size_t) -> ssize_t {
         return -1;
     }
 
-    let tmp_buf = if count <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocalloc(count)
-    } else {
-        malloc(count)
+    let mut tmp_buf = match OcallBuf::alloc(count) {
+        Some(tmp_buf) => tmp_buf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
     };
-    if tmp_buf.is_null() {
-        set_errno(ENOMEM );
+    ptr::copy_nonoverlapping(buf as *const u8, tmp_buf.as_mut_ptr() as *mut u8, count);
+
+    let status = ocall_profiled!(count, u_write_ocall(&mut result as *mut ssize_t,
+                                                      &mut error as *mut c_int,
+                                                      fd,
+                                                      tmp_buf.as_ptr(),
+                                                      count));
+
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+
+    if result > count as ssize_t {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
+
+/// Like [`write`], but the data is written from `buf` in untrusted memory
+/// directly, without a bounce buffer and copy inside the enclave. Meant for
+/// payloads that are encrypted or otherwise need no confidentiality.
+pub unsafe fn write_untrusted(fd: c_int, buf: *const c_void, count: size_t) -> ssize_t {
+    let mut result: ssize_t = 0;
+    let mut error: c_int = 0;
+
+    if buf.is_null() || sgx_is_outside_enclave(buf, count) == 0 {
+        set_errno(EINVAL);
         return -1;
     }
-    ptr::copy_nonoverlapping(buf as *const u8, tmp_buf as *mut u8, count);
 
-    let status = u_write_ocall(&mut result as *mut ssize_t,
-                               &mut error as *mut c_int,
-                               fd,
-                               tmp_buf,
-                               count);
+    let status = ocall_profiled!(u_write_ocall(&mut result as *mut ssize_t,
+                                               &mut error as *mut c_int,
+                                               fd,
+                                               buf,
+                                               count));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1601,10 +1739,9 @@ pub unsafe fn write(fd: c_int, buf: *const c_void, count: size_t) -> ssize_t {
         result = -1;
     }
 
-    if count <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocfree();
-    } else {
-        free(tmp_buf);
+    if result > count as ssize_t {
+        set_errno(ESGX);
+        result = -1;
     }
     result
 }
@@ -1622,23 +1759,56 @@ pub unsafe fn pwrite64(fd: c_int, buf: *const c_void, count: size_t, offset: off
         return -1;
     }
 
-    let tmp_buf = if count <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocalloc(count)
-    } else {
-        malloc(count)
+    let mut tmp_buf = match OcallBuf::alloc(count) {
+        Some(tmp_buf) => tmp_buf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
     };
-    if tmp_buf.is_null() {
-        set_errno(ENOMEM );
+    ptr::copy_nonoverlapping(buf as *const u8, tmp_buf.as_mut_ptr() as *mut u8, count);
+
+    let status = ocall_profiled!(count, u_pwrite64_ocall(&mut result as *mut ssize_t,
+                                                         &mut error as *mut c_int,
+                                                         fd,
+                                                         tmp_buf.as_ptr(),
+                                                         count,
+                                                         offset));
+
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+
+    if result > count as ssize_t {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
+
+/// Like [`pwrite64`], but the data is written from `buf` in untrusted memory
+/// directly, without a bounce buffer and copy inside the enclave. Meant for
+/// payloads that are encrypted or otherwise need no confidentiality.
+pub unsafe fn pwrite64_untrusted(fd: c_int, buf: *const c_void, count: size_t, offset: off64_t) -> ssize_t {
+    let mut result: ssize_t = 0;
+    let mut error: c_int = 0;
+
+    if buf.is_null() || sgx_is_outside_enclave(buf, count) == 0 {
+        set_errno(EINVAL);
         return -1;
     }
-    ptr::copy_nonoverlapping(buf as *const u8, tmp_buf as *mut u8, count);
 
-    let status = u_pwrite64_ocall(&mut result as *mut ssize_t,
-                                  &mut error as *mut c_int,
-                                  fd,
-                                  tmp_buf,
-                                  count,
-                                  offset);
+    let status = ocall_profiled!(u_pwrite64_ocall(&mut result as *mut ssize_t,
+                                                  &mut error as *mut c_int,
+                                                  fd,
+                                                  buf,
+                                                  count,
+                                                  offset));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1649,10 +1819,9 @@ pub unsafe fn pwrite64(fd: c_int, buf: *const c_void, count: size_t, offset: off
         result = -1;
     }
 
-    if count <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocfree();
-    } else {
-        free(tmp_buf);
+    if result > count as ssize_t {
+        set_errno(ESGX);
+        result = -1;
     }
     result
 }
@@ -1680,11 +1849,14 @@ pub unsafe fn writev(fd: c_int, iov: *const iovec, iovcnt: c_int) -> ssize_t {
         }
     }
 
-    let iobase = malloc(iosize) as *mut u8;
-    if iobase.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
+    let mut iobuf = match OcallBuf::alloc(iosize) {
+        Some(iobuf) => iobuf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
+    };
+    let iobase = iobuf.as_mut_ptr() as *mut u8;
     iobase.write_bytes(0_u8, iosize);
 
     let mut tmpiovec: Vec<iovec> = Vec::with_capacity(iovcnt as usize);
@@ -1697,11 +1869,11 @@ pub unsafe fn writev(fd: c_int, iov: *const iovec, iovcnt: c_int) -> ssize_t {
         ptr = ptr.add(io.iov_len as usize);
     }
 
-    let status = u_writev_ocall(&mut result as *mut ssize_t,
-                                &mut error as *mut c_int,
-                                fd,
-                                tmpiovec.as_slice().as_ptr(),
-                                iovcnt);
+    let status = ocall_profiled!(iosize, u_writev_ocall(&mut result as *mut ssize_t,
+                                                        &mut error as *mut c_int,
+                                                        fd,
+                                                        tmpiovec.as_slice().as_ptr(),
+                                                        iovcnt));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1712,7 +1884,6 @@ pub unsafe fn writev(fd: c_int, iov: *const iovec, iovcnt: c_int) -> ssize_t {
         result = -1;
     }
 
-    free(iobase as *mut c_void);
     result
 }
 
@@ -1739,11 +1910,14 @@ pub unsafe fn pwritev64(fd: c_int, iov: *const iovec, iovcnt: c_int, offset: off
         }
     }
 
-    let iobase = malloc(iosize) as *mut u8;
-    if iobase.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
+    let mut iobuf = match OcallBuf::alloc(iosize) {
+        Some(iobuf) => iobuf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
+    };
+    let iobase = iobuf.as_mut_ptr() as *mut u8;
     iobase.write_bytes(0_u8, iosize);
 
     let mut tmpiovec: Vec<iovec> = Vec::with_capacity(iovcnt as usize);
@@ -1756,12 +1930,12 @@ pub unsafe fn pwritev64(fd: c_int, iov: *const iovec, iovcnt: c_int, offset: off
         ptr = ptr.add(io.iov_len as usize);
     }
 
-    let status = u_pwritev64_ocall(&mut result as *mut ssize_t,
-                                   &mut error as *mut c_int,
-                                   fd,
-                                   tmpiovec.as_slice().as_ptr(),
-                                   iovcnt,
-                                   offset);
+    let status = ocall_profiled!(iosize, u_pwritev64_ocall(&mut result as *mut ssize_t,
+                                                           &mut error as *mut c_int,
+                                                           fd,
+                                                           tmpiovec.as_slice().as_ptr(),
+                                                           iovcnt,
+                                                           offset));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1772,17 +1946,16 @@ pub unsafe fn pwritev64(fd: c_int, iov: *const iovec, iovcnt: c_int, offset: off
         result = -1;
     }
 
-    free(iobase as *mut c_void);
     result
 }
 
 pub unsafe fn fcntl_arg0(fd: c_int, cmd: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_fcntl_arg0_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    fd,
-                                    cmd);
+    let status = ocall_profiled!(u_fcntl_arg0_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    fd,
+                                                    cmd));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1798,11 +1971,11 @@ pub unsafe fn fcntl_arg0(fd: c_int, cmd: c_int) -> c_int {
 pub unsafe fn fcntl_arg1(fd: c_int, cmd: c_int, arg: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_fcntl_arg1_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    fd,
-                                    cmd,
-                                    arg);
+    let status = ocall_profiled!(u_fcntl_arg1_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    fd,
+                                                    cmd,
+                                                    arg));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1818,10 +1991,10 @@ pub unsafe fn fcntl_arg1(fd: c_int, cmd: c_int, arg: c_int) -> c_int {
 pub unsafe fn ioctl_arg0(fd: c_int, request: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_ioctl_arg0_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    fd,
-                                    request);
+    let status = ocall_profiled!(u_ioctl_arg0_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    fd,
+                                                    request));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1837,11 +2010,11 @@ pub unsafe fn ioctl_arg0(fd: c_int, request: c_int) -> c_int {
 pub unsafe fn ioctl_arg1(fd: c_int, request: c_int, arg: *mut c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_ioctl_arg1_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    fd,
-                                    request,
-                                    arg);
+    let status = ocall_profiled!(u_ioctl_arg1_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    fd,
+                                                    request,
+                                                    arg));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1857,9 +2030,9 @@ pub unsafe fn ioctl_arg1(fd: c_int, request: c_int, arg: *mut c_int) -> c_int {
 pub unsafe fn close(fd: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_close_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               fd);
+    let status = ocall_profiled!(u_close_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               fd));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1875,10 +2048,10 @@ pub unsafe fn close(fd: c_int) -> c_int {
 pub unsafe fn clock_gettime(clk_id: clockid_t, tp: *mut timespec) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_clock_gettime_ocall(&mut result as *mut c_int,
-                                       &mut error as *mut c_int,
-                                       clk_id,
-                                       tp);
+    let status = ocall_profiled!(u_clock_gettime_ocall(&mut result as *mut c_int,
+                                                       &mut error as *mut c_int,
+                                                       clk_id,
+                                                       tp));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1894,11 +2067,11 @@ pub unsafe fn clock_gettime(clk_id: clockid_t, tp: *mut timespec) -> c_int {
 pub unsafe fn socket(domain: c_int, ty: c_int, protocol: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_socket_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                domain,
-                                ty,
-                                protocol);
+    let status = ocall_profiled!(u_socket_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                domain,
+                                                ty,
+                                                protocol));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1914,12 +2087,12 @@ pub unsafe fn socket(domain: c_int, ty: c_int, protocol: c_int) -> c_int {
 pub unsafe fn socketpair(domain: c_int, ty: c_int, protocol: c_int, sv: *mut c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_socketpair_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    domain,
-                                    ty,
-                                    protocol,
-                                    sv);
+    let status = ocall_profiled!(u_socketpair_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    domain,
+                                                    ty,
+                                                    protocol,
+                                                    sv));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1935,11 +2108,11 @@ pub unsafe fn socketpair(domain: c_int, ty: c_int, protocol: c_int, sv: *mut c_i
 pub unsafe fn bind(sockfd: c_int, address: *const sockaddr, addrlen: socklen_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_bind_ocall(&mut result as *mut c_int,
-                              &mut error as *mut c_int,
-                              sockfd,
-                              address,
-                              addrlen);
+    let status = ocall_profiled!(u_bind_ocall(&mut result as *mut c_int,
+                                              &mut error as *mut c_int,
+                                              sockfd,
+                                              address,
+                                              addrlen));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1955,10 +2128,10 @@ pub unsafe fn bind(sockfd: c_int, address: *const sockaddr, addrlen: socklen_t)
 pub unsafe fn listen(sockfd: c_int, backlog: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_listen_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                sockfd,
-                                backlog);
+    let status = ocall_profiled!(u_listen_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                sockfd,
+                                                backlog));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -1976,12 +2149,12 @@ pub unsafe fn accept(sockfd: c_int, addr: *mut sockaddr, addrlen: *mut socklen_t
     let mut error: c_int = 0;
     let len_in: socklen_t = if !addrlen.is_null() { *addrlen } else { 0 };
     let mut len_out: socklen_t = 0 as socklen_t;
-    let status = u_accept_ocall(&mut result as *mut c_int,
-                                &mut error as *mut c_int,
-                                sockfd,
-                                addr,
-                                len_in, // This additional arg is just for EDL
-                                &mut len_out as *mut socklen_t);
+    let status = ocall_profiled!(u_accept_ocall(&mut result as *mut c_int,
+                                                &mut error as *mut c_int,
+                                                sockfd,
+                                                addr,
+                                                len_in, // This additional arg is just for EDL
+                                                &mut len_out as *mut socklen_t));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2003,13 +2176,13 @@ pub unsafe fn accept4(sockfd: c_int, addr: *mut sockaddr, addrlen: *mut socklen_
     let mut error: c_int = 0;
     let len_in: socklen_t = if !addrlen.is_null() { *addrlen } else { 0 };
     let mut len_out: socklen_t = 0 as socklen_t;
-    let status = u_accept4_ocall(&mut result as *mut c_int,
-                                 &mut error as *mut c_int,
-                                 sockfd,
-                                 addr,
-                                 len_in, // This additional arg is just for EDL
-                                 &mut len_out as *mut socklen_t,
-                                 flags);
+    let status = ocall_profiled!(u_accept4_ocall(&mut result as *mut c_int,
+                                                 &mut error as *mut c_int,
+                                                 sockfd,
+                                                 addr,
+                                                 len_in, // This additional arg is just for EDL
+                                                 &mut len_out as *mut socklen_t,
+                                                 flags));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2029,11 +2202,11 @@ pub unsafe fn accept4(sockfd: c_int, addr: *mut sockaddr, addrlen: *mut socklen_
 pub unsafe fn connect(sockfd: c_int, address: *const sockaddr, addrlen: socklen_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_connect_ocall(&mut result as *mut c_int,
-                                 &mut error as *mut c_int,
-                                 sockfd,
-                                 address,
-                                 addrlen);
+    let status = ocall_profiled!(u_connect_ocall(&mut result as *mut c_int,
+                                                 &mut error as *mut c_int,
+                                                 sockfd,
+                                                 address,
+                                                 addrlen));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2059,23 +2232,56 @@ pub unsafe fn send(sockfd: c_int, buf: *const c_void, len: size_t, flags: c_int)
         return -1;
     }
 
-    let tmp_buf = if len <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocalloc(len)
-    } else {
-        malloc(len)
+    let mut tmp_buf = match OcallBuf::alloc(len) {
+        Some(tmp_buf) => tmp_buf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
     };
-    if tmp_buf.is_null() {
-        set_errno(ENOMEM );
+    ptr::copy_nonoverlapping(buf as *const u8, tmp_buf.as_mut_ptr() as *mut u8, len);
+
+    let status = ocall_profiled!(len, u_send_ocall(&mut result as *mut ssize_t,
+                                                   &mut error as *mut c_int,
+                                                   sockfd,
+                                                   tmp_buf.as_ptr(),
+                                                   len,
+                                                   flags));
+
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+
+    if result > len as ssize_t {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
+
+/// Like [`send`], but the data is written from `buf` in untrusted memory
+/// directly, without a bounce buffer and copy inside the enclave. Meant for
+/// payloads that are encrypted or otherwise need no confidentiality.
+pub unsafe fn send_untrusted(sockfd: c_int, buf: *const c_void, len: size_t, flags: c_int) -> ssize_t {
+    let mut result: ssize_t = 0;
+    let mut error: c_int = 0;
+
+    if buf.is_null() || sgx_is_outside_enclave(buf, len) == 0 {
+        set_errno(EINVAL);
         return -1;
     }
-    ptr::copy_nonoverlapping(buf as *const u8, tmp_buf as *mut u8, len);
 
-    let status = u_send_ocall(&mut result as *mut ssize_t,
-                              &mut error as *mut c_int,
-                              sockfd,
-                              tmp_buf,
-                              len,
-                              flags);
+    let status = ocall_profiled!(u_send_ocall(&mut result as *mut ssize_t,
+                                              &mut error as *mut c_int,
+                                              sockfd,
+                                              buf,
+                                              len,
+                                              flags));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2086,10 +2292,9 @@ pub unsafe fn send(sockfd: c_int, buf: *const c_void, len: size_t, flags: c_int)
         result = -1;
     }
 
-    if len <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocfree();
-    } else {
-        free(tmp_buf);
+    if result > len as ssize_t {
+        set_errno(ESGX);
+        result = -1;
     }
     result
 }
@@ -2112,25 +2317,23 @@ pub unsafe fn sendto(sockfd: c_int,
         return -1;
     }
 
-    let tmp_buf = if len <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocalloc(len)
-    } else {
-        malloc(len)
+    let mut tmp_buf = match OcallBuf::alloc(len) {
+        Some(tmp_buf) => tmp_buf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
     };
-    if tmp_buf.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
-    ptr::copy_nonoverlapping(buf as *const u8, tmp_buf as *mut u8, len);
+    ptr::copy_nonoverlapping(buf as *const u8, tmp_buf.as_mut_ptr() as *mut u8, len);
 
-    let status = u_sendto_ocall(&mut result as *mut ssize_t,
-                                &mut error as *mut c_int,
-                                sockfd,
-                                tmp_buf,
-                                len,
-                                flags,
-                                addr,
-                                addrlen);
+    let status = ocall_profiled!(len, u_sendto_ocall(&mut result as *mut ssize_t,
+                                                     &mut error as *mut c_int,
+                                                     sockfd,
+                                                     tmp_buf.as_ptr(),
+                                                     len,
+                                                     flags,
+                                                     addr,
+                                                     addrlen));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2141,10 +2344,9 @@ pub unsafe fn sendto(sockfd: c_int,
         result = -1;
     }
 
-    if len <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocfree();
-    } else {
-        free(tmp_buf);
+    if result > len as ssize_t {
+        set_errno(ESGX);
+        result = -1;
     }
     result
 }
@@ -2187,11 +2389,14 @@ pub unsafe fn sendmsg(sockfd: c_int, msg: *const msghdr, flags: c_int) -> ssize_
         hdrsize += mhdr.msg_controllen as usize;
     }
 
-    let hdrbase = malloc(hdrsize) as *mut u8;
-    if hdrbase.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
+    let mut hdrbuf = match OcallBuf::alloc(hdrsize) {
+        Some(hdrbuf) => hdrbuf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
+    };
+    let hdrbase = hdrbuf.as_mut_ptr() as *mut u8;
     hdrbase.write_bytes(0_u8, hdrsize);
 
     let mut tmpmsg: msghdr = mem::zeroed();
@@ -2222,11 +2427,11 @@ pub unsafe fn sendmsg(sockfd: c_int, msg: *const msghdr, flags: c_int) -> ssize_
         ptr::copy_nonoverlapping(mhdr.msg_control as *const u8, tmpmsg.msg_control as *mut u8, mhdr.msg_controllen as usize);
     }
 
-    let status = u_sendmsg_ocall(&mut result as *mut ssize_t,
-                                 &mut error as *mut c_int,
-                                 sockfd,
-                                 &tmpmsg as *const msghdr,
-                                 flags);
+    let status = ocall_profiled!(hdrsize, u_sendmsg_ocall(&mut result as *mut ssize_t,
+                                                          &mut error as *mut c_int,
+                                                          sockfd,
+                                                          &tmpmsg as *const msghdr,
+                                                          flags));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2237,7 +2442,6 @@ pub unsafe fn sendmsg(sockfd: c_int, msg: *const msghdr, flags: c_int) -> ssize_
         result = -1;
     }
 
-    free(hdrbase as *mut c_void);
     result
 }
 
@@ -2254,23 +2458,20 @@ pub unsafe fn recv(sockfd: c_int, buf: *mut c_void, len: size_t, flags: c_int) -
         return -1;
     }
 
-    let tmp_buf = if len <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocalloc(len)
-    } else {
-        malloc(len)
+    let mut tmp_buf = match OcallBuf::alloc(len) {
+        Some(tmp_buf) => tmp_buf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
     };
-    if tmp_buf.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
-    tmp_buf.write_bytes(0_u8, len);
 
-    let status = u_recv_ocall(&mut result as *mut ssize_t,
-                              &mut error as *mut c_int,
-                              sockfd,
-                              tmp_buf,
-                              len,
-                              flags);
+    let status = ocall_profiled!(len, u_recv_ocall(&mut result as *mut ssize_t,
+                                                   &mut error as *mut c_int,
+                                                   sockfd,
+                                                   tmp_buf.as_mut_ptr(),
+                                                   len,
+                                                   flags));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2281,13 +2482,46 @@ pub unsafe fn recv(sockfd: c_int, buf: *mut c_void, len: size_t, flags: c_int) -
         result = -1;
     }
 
-    if result != -1 {
-        ptr::copy_nonoverlapping(tmp_buf as *const u8, buf as *mut u8, len);
+    if result > len as ssize_t {
+        set_errno(ESGX);
+        result = -1;
+    } else if result > 0 {
+        ptr::copy_nonoverlapping(tmp_buf.as_ptr() as *const u8, buf as *mut u8, result as usize);
+    }
+    result
+}
+
+/// Like [`recv`], but the data is read into `buf` in untrusted memory
+/// directly, without a bounce buffer and copy inside the enclave. Meant for
+/// payloads that are encrypted or otherwise need no confidentiality.
+pub unsafe fn recv_untrusted(sockfd: c_int, buf: *mut c_void, len: size_t, flags: c_int) -> ssize_t {
+    let mut result: ssize_t = 0;
+    let mut error: c_int = 0;
+
+    if buf.is_null() || sgx_is_outside_enclave(buf, len) == 0 {
+        set_errno(EINVAL);
+        return -1;
     }
-    if len <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocfree();
+
+    let status = ocall_profiled!(u_recv_ocall(&mut result as *mut ssize_t,
+                                              &mut error as *mut c_int,
+                                              sockfd,
+                                              buf,
+                                              len,
+                                              flags));
+
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
     } else {
-        free(tmp_buf);
+        set_errno(ESGX);
+        result = -1;
+    }
+
+    if result > len as ssize_t {
+        set_errno(ESGX);
+        result = -1;
     }
     result
 }
@@ -2312,26 +2546,23 @@ pub unsafe fn recvfrom(sockfd: c_int,
         return -1;
     }
 
-    let tmp_buf = if len <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocalloc(len)
-    } else {
-        malloc(len)
+    let mut tmp_buf = match OcallBuf::alloc(len) {
+        Some(tmp_buf) => tmp_buf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
     };
-    if tmp_buf.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
-    tmp_buf.write_bytes(0_u8, len);
 
-    let status = u_recvfrom_ocall(&mut result as *mut ssize_t,
-                                  &mut error as *mut c_int,
-                                  sockfd,
-                                  tmp_buf,
-                                  len,
-                                  flags,
-                                  addr,
-                                  len_in, // This additional arg is just for EDL
-                                  &mut len_out as *mut socklen_t);
+    let status = ocall_profiled!(len, u_recvfrom_ocall(&mut result as *mut ssize_t,
+                                                       &mut error as *mut c_int,
+                                                       sockfd,
+                                                       tmp_buf.as_mut_ptr(),
+                                                       len,
+                                                       flags,
+                                                       addr,
+                                                       len_in, // This additional arg is just for EDL
+                                                       &mut len_out as *mut socklen_t));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2342,13 +2573,11 @@ pub unsafe fn recvfrom(sockfd: c_int,
         result = -1;
     }
 
-    if result != -1 {
-        ptr::copy_nonoverlapping(tmp_buf as *const u8, buf as *mut u8, len);
-    }
-    if len <= MAX_OCALL_ALLOC_SIZE {
-        sgx_ocfree();
-    } else {
-        free(tmp_buf);
+    if result > len as ssize_t {
+        set_errno(ESGX);
+        result = -1;
+    } else if result > 0 {
+        ptr::copy_nonoverlapping(tmp_buf.as_ptr() as *const u8, buf as *mut u8, result as usize);
     }
 
     if !addrlen.is_null() {
@@ -2395,11 +2624,14 @@ pub unsafe fn recvmsg(sockfd: c_int, msg: *mut msghdr, flags: c_int) -> ssize_t
         hdrsize += mhdr.msg_controllen as usize;
     }
 
-    let hdrbase = malloc(hdrsize) as *mut u8;
-    if hdrbase.is_null() {
-        set_errno(ENOMEM );
-        return -1;
-    }
+    let mut hdrbuf = match OcallBuf::alloc(hdrsize) {
+        Some(hdrbuf) => hdrbuf,
+        None => {
+            set_errno(ENOMEM);
+            return -1;
+        }
+    };
+    let hdrbase = hdrbuf.as_mut_ptr() as *mut u8;
     hdrbase.write_bytes(0_u8, hdrsize);
 
     let mut tmpmsg: msghdr = mem::zeroed();
@@ -2429,11 +2661,11 @@ pub unsafe fn recvmsg(sockfd: c_int, msg: *mut msghdr, flags: c_int) -> ssize_t
         ptr::copy_nonoverlapping(mhdr.msg_control as *const u8, tmpmsg.msg_control as *mut u8, mhdr.msg_controllen as usize);
     }
 
-    let status = u_recvmsg_ocall(&mut result as *mut ssize_t,
-                                 &mut error as *mut c_int,
-                                 sockfd,
-                                 &mut tmpmsg as *mut msghdr,
-                                 flags);
+    let status = ocall_profiled!(hdrsize, u_recvmsg_ocall(&mut result as *mut ssize_t,
+                                                          &mut error as *mut c_int,
+                                                          sockfd,
+                                                          &mut tmpmsg as *mut msghdr,
+                                                          flags));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2464,7 +2696,6 @@ pub unsafe fn recvmsg(sockfd: c_int, msg: *mut msghdr, flags: c_int) -> ssize_t
         ptr::copy_nonoverlapping(tmpmsg.msg_control as *const u8, mhdr.msg_control as *mut u8, mhdr.msg_controllen as usize);
     }
 
-    free(hdrbase as *mut c_void);
     result
 }
 
@@ -2475,13 +2706,13 @@ pub unsafe fn setsockopt(sockfd: c_int,
                          optlen: socklen_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_setsockopt_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    sockfd,
-                                    level,
-                                    optname,
-                                    optval,
-                                    optlen);
+    let status = ocall_profiled!(u_setsockopt_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    sockfd,
+                                                    level,
+                                                    optname,
+                                                    optval,
+                                                    optlen));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2504,14 +2735,14 @@ pub unsafe fn getsockopt(sockfd: c_int,
     let len_in: socklen_t = if !optlen.is_null() { *optlen } else { 0 };
     let mut len_out: socklen_t = 0 as socklen_t;
 
-    let status = u_getsockopt_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    sockfd,
-                                    level,
-                                    optname,
-                                    optval,
-                                    len_in,
-                                    &mut len_out as *mut socklen_t);
+    let status = ocall_profiled!(u_getsockopt_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    sockfd,
+                                                    level,
+                                                    optname,
+                                                    optval,
+                                                    len_in,
+                                                    &mut len_out as *mut socklen_t));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2533,12 +2764,12 @@ pub unsafe fn getpeername(sockfd: c_int, address: *mut sockaddr, addrlen: *mut s
     let mut error: c_int = 0;
     let len_in: socklen_t = if !addrlen.is_null() { *addrlen } else { 0 };
     let mut len_out: socklen_t = 0 as socklen_t;
-    let status = u_getpeername_ocall(&mut result as *mut c_int,
-                                     &mut error as *mut c_int,
-                                     sockfd,
-                                     address,
-                                     len_in,
-                                     &mut len_out as *mut socklen_t);
+    let status = ocall_profiled!(u_getpeername_ocall(&mut result as *mut c_int,
+                                                     &mut error as *mut c_int,
+                                                     sockfd,
+                                                     address,
+                                                     len_in,
+                                                     &mut len_out as *mut socklen_t));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2560,12 +2791,12 @@ pub unsafe fn getsockname(sockfd: c_int, address: *mut sockaddr, addrlen: *mut s
     let mut error: c_int = 0;
     let len_in: socklen_t = if !addrlen.is_null() { *addrlen } else { 0 };
     let mut len_out: socklen_t = 0 as socklen_t;
-    let status = u_getsockname_ocall(&mut result as *mut c_int,
-                                     &mut error as *mut c_int,
-                                     sockfd,
-                                     address,
-                                     len_in,
-                                     &mut len_out as *mut socklen_t);
+    let status = ocall_profiled!(u_getsockname_ocall(&mut result as *mut c_int,
+                                                     &mut error as *mut c_int,
+                                                     sockfd,
+                                                     address,
+                                                     len_in,
+                                                     &mut len_out as *mut socklen_t));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2585,10 +2816,10 @@ pub unsafe fn getsockname(sockfd: c_int, address: *mut sockaddr, addrlen: *mut s
 pub unsafe fn shutdown(sockfd: c_int, how: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_shutdown_ocall(&mut result as *mut c_int,
-                                  &mut error as *mut c_int,
-                                  sockfd,
-                                  how);
+    let status = ocall_profiled!(u_shutdown_ocall(&mut result as *mut c_int,
+                                                  &mut error as *mut c_int,
+                                                  sockfd,
+                                                  how));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2632,12 +2863,12 @@ pub unsafe fn getaddrinfo(node: *const c_char,
         }
     };
 
-    let status = u_getaddrinfo_ocall(&mut result as *mut c_int,
-                                     &mut error as *mut c_int,
-                                     node,
-                                     service,
-                                     &hint as *const addrinfo,
-                                     &mut ret_res as *mut *mut addrinfo);
+    let status = ocall_profiled!(u_getaddrinfo_ocall(&mut result as *mut c_int,
+                                                     &mut error as *mut c_int,
+                                                     node,
+                                                     service,
+                                                     &hint as *const addrinfo,
+                                                     &mut ret_res as *mut *mut addrinfo));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == 0 {
             *res = ptr::null_mut();
@@ -2691,7 +2922,7 @@ pub unsafe fn getaddrinfo(node: *const c_char,
                 }
                 *res = res_ptr;
             }
-            let _ = u_freeaddrinfo_ocall(ret_res);
+            let _ = ocall_profiled!(u_freeaddrinfo_ocall(ret_res));
 
         } else if result == EAI_SYSTEM {
             set_errno(error);
@@ -2725,7 +2956,7 @@ pub unsafe fn freeaddrinfo(res: *mut addrinfo ) {
 
 pub unsafe fn gai_strerror(errcode: c_int) -> *const c_char {
     let mut result: *const c_char = ptr::null();
-    let status = u_gai_strerror_ocall(&mut result as *mut *const c_char, errcode);
+    let status = ocall_profiled!(u_gai_strerror_ocall(&mut result as *mut *const c_char, errcode));
     if status != sgx_status_t::SGX_SUCCESS {
         set_errno(ESGX);
     }
@@ -2735,11 +2966,11 @@ pub unsafe fn gai_strerror(errcode: c_int) -> *const c_char {
 pub unsafe fn poll(fds: *mut pollfd, nfds: nfds_t, timeout: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_poll_ocall(&mut result as *mut c_int,
-                              &mut error as *mut c_int,
-                              fds,
-                              nfds,
-                              timeout);
+    let status = ocall_profiled!(nfds as usize * mem::size_of::<pollfd>(), u_poll_ocall(&mut result as *mut c_int,
+                                                                                        &mut error as *mut c_int,
+                                                                                        fds,
+                                                                                        nfds,
+                                                                                        timeout));
 
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -2755,9 +2986,9 @@ pub unsafe fn poll(fds: *mut pollfd, nfds: nfds_t, timeout: c_int) -> c_int {
 pub unsafe fn epoll_create1(flags: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_epoll_create1_ocall(&mut result as *mut c_int,
-                                       &mut error as *mut c_int,
-                                       flags);
+    let status = ocall_profiled!(u_epoll_create1_ocall(&mut result as *mut c_int,
+                                                       &mut error as *mut c_int,
+                                                       flags));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2775,12 +3006,12 @@ pub unsafe fn epoll_ctl(epfd: c_int,
                         event: *mut epoll_event) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_epoll_ctl_ocall(&mut result as *mut c_int,
-                                   &mut error as *mut c_int,
-                                   epfd,
-                                   op,
-                                   fd,
-                                   event);
+    let status = ocall_profiled!(u_epoll_ctl_ocall(&mut result as *mut c_int,
+                                                   &mut error as *mut c_int,
+                                                   epfd,
+                                                   op,
+                                                   fd,
+                                                   event));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2798,12 +3029,12 @@ pub unsafe fn epoll_wait(epfd: c_int,
                          timeout: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_epoll_wait_ocall(&mut result as *mut c_int,
-                                    &mut error as *mut c_int,
-                                    epfd,
-                                    events,
-                                    maxevents,
-                                    timeout);
+    let status = ocall_profiled!(maxevents as usize * mem::size_of::<epoll_event>(), u_epoll_wait_ocall(&mut result as *mut c_int,
+                                                                                                        &mut error as *mut c_int,
+                                                                                                        epfd,
+                                                                                                        events,
+                                                                                                        maxevents,
+                                                                                                        timeout));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2818,9 +3049,9 @@ pub unsafe fn epoll_wait(epfd: c_int,
 pub unsafe fn sysconf(name: c_int) -> c_long {
     let mut result: c_long = 0;
     let mut error: c_int = 0;
-    let status = u_sysconf_ocall(&mut result as *mut c_long,
-                                 &mut error as *mut c_int,
-                                 name);
+    let status = ocall_profiled!(u_sysconf_ocall(&mut result as *mut c_long,
+                                                 &mut error as *mut c_int,
+                                                 name));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2839,13 +3070,13 @@ pub unsafe fn prctl(option: c_int,
                     arg5: c_ulong) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_prctl_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               option,
-                               arg2,
-                               arg3,
-                               arg4,
-                               arg5);
+    let status = ocall_profiled!(u_prctl_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               option,
+                                               arg2,
+                                               arg3,
+                                               arg4,
+                                               arg5));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2860,11 +3091,11 @@ pub unsafe fn prctl(option: c_int,
 pub unsafe fn sched_setaffinity(pid: pid_t, cpusetsize: size_t, mask: *const cpu_set_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_sched_setaffinity_ocall(&mut result as *mut c_int,
-                                           &mut error as *mut c_int,
-                                           pid,
-                                           cpusetsize,
-                                           mask);
+    let status = ocall_profiled!(u_sched_setaffinity_ocall(&mut result as *mut c_int,
+                                                           &mut error as *mut c_int,
+                                                           pid,
+                                                           cpusetsize,
+                                                           mask));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2879,11 +3110,11 @@ pub unsafe fn sched_setaffinity(pid: pid_t, cpusetsize: size_t, mask: *const cpu
 pub unsafe fn sched_getaffinity(pid: pid_t, cpusetsize: size_t, mask: *mut cpu_set_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_sched_getaffinity_ocall(&mut result as *mut c_int,
-                                           &mut error as *mut c_int,
-                                           pid,
-                                           cpusetsize,
-                                           mask);
+    let status = ocall_profiled!(u_sched_getaffinity_ocall(&mut result as *mut c_int,
+                                                           &mut error as *mut c_int,
+                                                           pid,
+                                                           cpusetsize,
+                                                           mask));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2898,9 +3129,9 @@ pub unsafe fn sched_getaffinity(pid: pid_t, cpusetsize: size_t, mask: *mut cpu_s
 pub unsafe fn pipe(fds: *mut c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_pipe_ocall(&mut result as *mut c_int,
-                              &mut error as *mut c_int,
-                              fds);
+    let status = ocall_profiled!(u_pipe_ocall(&mut result as *mut c_int,
+                                              &mut error as *mut c_int,
+                                              fds));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2915,10 +3146,10 @@ pub unsafe fn pipe(fds: *mut c_int) -> c_int {
 pub unsafe fn pipe2(fds: *mut c_int, flags: c_int) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_pipe2_ocall(&mut result as *mut c_int,
-                               &mut error as *mut c_int,
-                               fds,
-                               flags);
+    let status = ocall_profiled!(u_pipe2_ocall(&mut result as *mut c_int,
+                                               &mut error as *mut c_int,
+                                               fds,
+                                               flags));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2933,8 +3164,8 @@ pub unsafe fn pipe2(fds: *mut c_int, flags: c_int) -> c_int {
 pub unsafe fn sched_yield() -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_sched_yield_ocall(&mut result as *mut c_int,
-                                     &mut error as *mut c_int);
+    let status = ocall_profiled!(u_sched_yield_ocall(&mut result as *mut c_int,
+                                                     &mut error as *mut c_int));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2949,10 +3180,10 @@ pub unsafe fn sched_yield() -> c_int {
 pub unsafe fn nanosleep(rqtp: *const timespec, rmtp: *mut timespec) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_nanosleep_ocall(&mut result as *mut c_int,
-                                   &mut error as *mut c_int,
-                                   rqtp,
-                                   rmtp);
+    let status = ocall_profiled!(u_nanosleep_ocall(&mut result as *mut c_int,
+                                                   &mut error as *mut c_int,
+                                                   rqtp,
+                                                   rmtp));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2970,12 +3201,12 @@ pub unsafe fn sigaction(signum: c_int,
                         enclave_id: uint64_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_sigaction_ocall(&mut result as *mut c_int,
-                                   &mut error as *mut c_int,
-                                   signum,
-                                   act,
-                                   oldact,
-                                   enclave_id);
+    let status = ocall_profiled!(u_sigaction_ocall(&mut result as *mut c_int,
+                                                   &mut error as *mut c_int,
+                                                   signum,
+                                                   act,
+                                                   oldact,
+                                                   enclave_id));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -2992,11 +3223,11 @@ pub unsafe fn sigprocmask(signum: c_int,
                           oldset: *mut sigset_t) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status =  u_sigprocmask_ocall(&mut result as *mut c_int,
-                                      &mut error as *mut c_int,
-                                      signum,
-                                      set,
-                                      oldset);
+    let status =  ocall_profiled!(u_sigprocmask_ocall(&mut result as *mut c_int,
+                                                      &mut error as *mut c_int,
+                                                      signum,
+                                                      set,
+                                                      oldset));
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
             set_errno(error);
@@ -3010,7 +3241,7 @@ pub unsafe fn sigprocmask(signum: c_int,
 
 pub unsafe fn raise(signum: c_int) -> c_int {
     let mut result: c_int = -1;
-    let status = u_raise_ocall(&mut result as *mut c_int, signum);
+    let status = ocall_profiled!(u_raise_ocall(&mut result as *mut c_int, signum));
     if status != sgx_status_t::SGX_SUCCESS {
        result = -1;
     }
@@ -3023,7 +3254,7 @@ pub unsafe fn pthread_sigmask(signum: c_int, set: &sigset_t, oldset: &mut sigset
 
 pub unsafe fn getpid() -> pid_t {
     let mut result = -1;
-    let status = u_getpid_ocall(&mut result as *mut pid_t);
+    let status = ocall_profiled!(u_getpid_ocall(&mut result as *mut pid_t));
     if status != sgx_status_t::SGX_SUCCESS {
         result = -1;
     }
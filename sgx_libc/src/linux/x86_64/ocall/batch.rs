@@ -0,0 +1,209 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Shared-memory OCALL submission ring.
+//!
+//! A ring is a single block of untrusted memory holding a header, an array
+//! of submission entries and an array of completion entries. The enclave
+//! fills submission entries and advances `sq_tail`; an untrusted worker
+//! thread started by `batch_start` executes them and publishes completions
+//! by advancing `cq_tail`. Neither side leaves its own world while the
+//! worker is busy, so a batch of syscalls costs no EEXIT at all, and at most
+//! one `batch_enter` when the worker has gone to sleep or the enclave wants
+//! to block for completions.
+//!
+//! Everything in the ring is untrusted. Callers must keep their own record
+//! of what they submitted and validate every completion against it.
+//!
+//! The layout here must match `sgx_urts/src/batch.rs` and
+//! `sgx_ustdc/batch.c`.
+
+use sgx_types::*;
+use super::*;
+use core::mem;
+
+pub const BATCH_RING_MAGIC: uint32_t = 0x4252_4e47;
+pub const BATCH_RING_MAX_ENTRIES: uint32_t = 4096;
+
+/* flags: set by the worker while it sleeps on sq_tail */
+pub const BATCH_RING_NEED_WAKEUP: uint32_t = 0x1;
+/* flags: set by the untrusted side while a caller sleeps on cq_tail */
+pub const BATCH_RING_CQ_WAIT: uint32_t = 0x2;
+/* flags: set by batch_stop to make the worker exit */
+pub const BATCH_RING_STOP: uint32_t = 0x4;
+
+pub const BATCH_OP_NOP: uint8_t = 0;
+pub const BATCH_OP_READ: uint8_t = 1;
+pub const BATCH_OP_WRITE: uint8_t = 2;
+pub const BATCH_OP_PREAD64: uint8_t = 3;
+pub const BATCH_OP_PWRITE64: uint8_t = 4;
+pub const BATCH_OP_SEND: uint8_t = 5;
+pub const BATCH_OP_RECV: uint8_t = 6;
+pub const BATCH_OP_FSYNC: uint8_t = 7;
+pub const BATCH_OP_FDATASYNC: uint8_t = 8;
+pub const BATCH_OP_CLOSE: uint8_t = 9;
+pub const BATCH_OP_CLOCK_GETTIME: uint8_t = 10;
+pub const BATCH_OP_EPOLL_WAIT: uint8_t = 11;
+
+/// One queued syscall. `addr` and `len` describe an untrusted buffer;
+/// `off` is the file offset for the positional ops and `arg` carries
+/// the socket flags, the clock id or the epoll timeout.
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct batch_sqe {
+    pub opcode: uint8_t,
+    pub __pad: [uint8_t; 3],
+    pub fd: c_int,
+    pub addr: uint64_t,
+    pub len: uint64_t,
+    pub off: int64_t,
+    pub arg: uint64_t,
+    pub user_data: uint64_t,
+}
+
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct batch_cqe {
+    pub user_data: uint64_t,
+    pub result: int64_t,
+    pub error: c_int,
+    pub __pad: uint32_t,
+}
+
+/// Ring header. Each index the two sides write sits on its own cache
+/// line. `worker` is private to the untrusted side.
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct batch_ring {
+    pub magic: uint32_t,
+    pub entries: uint32_t,
+    pub sqe_off: uint32_t,
+    pub cqe_off: uint32_t,
+    pub worker: uint64_t,
+    pub __pad0: [uint8_t; 40],
+    pub sq_tail: uint32_t,
+    pub __pad1: [uint8_t; 60],
+    pub sq_head: uint32_t,
+    pub __pad2: [uint8_t; 60],
+    pub cq_tail: uint32_t,
+    pub __pad3: [uint8_t; 60],
+    pub cq_head: uint32_t,
+    pub __pad4: [uint8_t; 60],
+    pub flags: uint32_t,
+    pub __pad5: [uint8_t; 60],
+}
+
+extern "C" {
+    pub fn u_batch_start_ocall(result: *mut c_int,
+                               error: *mut c_int,
+                               ring: *mut c_void) -> sgx_status_t;
+    pub fn u_batch_enter_ocall(result: *mut c_int,
+                               error: *mut c_int,
+                               ring: *mut c_void,
+                               min_complete: uint32_t) -> sgx_status_t;
+    pub fn u_batch_stop_ocall(result: *mut c_int,
+                              error: *mut c_int,
+                              ring: *mut c_void) -> sgx_status_t;
+}
+
+/// Byte size of a ring with `entries` slots, excluding any data area the
+/// caller places behind it.
+pub fn batch_ring_size(entries: uint32_t) -> size_t {
+    mem::size_of::<batch_ring>()
+        + entries as size_t * (mem::size_of::<batch_sqe>() + mem::size_of::<batch_cqe>())
+}
+
+unsafe fn check_ring(ring: *mut batch_ring) -> bool {
+    !ring.is_null() && sgx_is_outside_enclave(ring as * const c_void, mem::size_of::<batch_ring>()) != 0
+}
+
+/// Starts the untrusted worker that serves `ring`. The header must already
+/// be initialized.
+pub unsafe fn batch_start(ring: *mut batch_ring) -> c_int {
+    let mut result: c_int = 0;
+    let mut error: c_int = 0;
+
+    if !check_ring(ring) {
+        set_errno(EINVAL);
+        return -1;
+    }
+
+    let status = ocall_profiled!(u_batch_start_ocall(&mut result as *mut c_int,
+                                                     &mut error as *mut c_int,
+                                                     ring as *mut c_void));
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
+
+/// Wakes the worker if it sleeps and, if `min_complete` is not zero, blocks
+/// until at least that many completions are waiting to be reaped. The
+/// return value is only a hint; callers must read `cq_tail` themselves.
+pub unsafe fn batch_enter(ring: *mut batch_ring, min_complete: uint32_t) -> c_int {
+    let mut result: c_int = 0;
+    let mut error: c_int = 0;
+
+    if !check_ring(ring) {
+        set_errno(EINVAL);
+        return -1;
+    }
+
+    let status = ocall_profiled!(u_batch_enter_ocall(&mut result as *mut c_int,
+                                                     &mut error as *mut c_int,
+                                                     ring as *mut c_void,
+                                                     min_complete));
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
+
+/// Stops the worker and waits for it to exit. The ring memory may be freed
+/// once this returns 0.
+pub unsafe fn batch_stop(ring: *mut batch_ring) -> c_int {
+    let mut result: c_int = 0;
+    let mut error: c_int = 0;
+
+    if !check_ring(ring) {
+        set_errno(EINVAL);
+        return -1;
+    }
+
+    let status = ocall_profiled!(u_batch_stop_ocall(&mut result as *mut c_int,
+                                                    &mut error as *mut c_int,
+                                                    ring as *mut c_void));
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
@@ -0,0 +1,196 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Shared-memory log ring.
+//!
+//! A ring is a single block of untrusted memory holding a header and a data
+//! area. Enclave threads reserve space in the data area, write a record and
+//! commit it by setting `LOG_RECORD_COMMIT` in its length word. A drainer
+//! thread started by `log_start` writes committed records out in ring order,
+//! zeroes the space they took and advances `head`. Appending a record never
+//! leaves the enclave; `log_wait` is only needed to wake an idle drainer or
+//! to wait for it to make room.
+//!
+//! The layout here must match `sgx_urts/src/log.rs` and `sgx_ustdc/log.c`.
+
+use sgx_types::*;
+use super::*;
+use core::mem;
+
+pub const LOG_RING_MAGIC: uint32_t = 0x4c4f_4752;
+pub const LOG_RING_MIN_SIZE: uint32_t = 0x1000;
+pub const LOG_RING_MAX_SIZE: uint32_t = 0x4000_0000;
+
+/* flags: set by the drainer while it sleeps */
+pub const LOG_RING_NEED_WAKEUP: uint32_t = 0x1;
+/* flags: set by log_stop to make the drainer exit once the ring is empty */
+pub const LOG_RING_STOP: uint32_t = 0x2;
+
+/* len: the record is complete */
+pub const LOG_RECORD_COMMIT: uint32_t = 0x8000_0000;
+pub const LOG_RECORD_ALIGN: uint32_t = 8;
+
+pub const LOG_LEVEL_PLAIN: uint8_t = 0;
+pub const LOG_LEVEL_ERROR: uint8_t = 1;
+pub const LOG_LEVEL_WARN: uint8_t = 2;
+pub const LOG_LEVEL_INFO: uint8_t = 3;
+pub const LOG_LEVEL_DEBUG: uint8_t = 4;
+pub const LOG_LEVEL_TRACE: uint8_t = 5;
+/* level: filler up to the end of the data area */
+pub const LOG_LEVEL_PAD: uint8_t = 0xff;
+
+/* stream: the fd the ring was started with */
+pub const LOG_STREAM_DEFAULT: uint8_t = 0;
+pub const LOG_STREAM_STDOUT: uint8_t = 1;
+pub const LOG_STREAM_STDERR: uint8_t = 2;
+
+/* flags: the record continues the previous one */
+pub const LOG_RECORD_CONT: uint8_t = 0x1;
+/* flags: the next record continues this one */
+pub const LOG_RECORD_MORE: uint8_t = 0x2;
+
+/// Record header, followed by `len` payload bytes and padding up to
+/// `LOG_RECORD_ALIGN`.
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct log_record {
+    pub len: uint32_t,
+    pub level: uint8_t,
+    pub stream: uint8_t,
+    pub flags: uint8_t,
+    pub __pad: uint8_t,
+}
+
+/// Ring header. `head` and `flags` sit on cache lines of their own.
+/// `dropped` is published by the enclave for the drainer to report, and
+/// `drainer` is private to the untrusted side.
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct log_ring {
+    pub magic: uint32_t,
+    pub size: uint32_t,
+    pub data_off: uint32_t,
+    pub __pad0: uint32_t,
+    pub drainer: uint64_t,
+    pub dropped: uint64_t,
+    pub __pad1: [uint8_t; 32],
+    pub head: uint64_t,
+    pub __pad2: [uint8_t; 56],
+    pub flags: uint32_t,
+    pub __pad3: [uint8_t; 60],
+}
+
+extern "C" {
+    pub fn u_log_start_ocall(result: *mut c_int,
+                             error: *mut c_int,
+                             ring: *mut c_void,
+                             fd: c_int) -> sgx_status_t;
+    pub fn u_log_wait_ocall(result: *mut c_int,
+                            error: *mut c_int,
+                            ring: *mut c_void,
+                            head: uint64_t) -> sgx_status_t;
+    pub fn u_log_stop_ocall(result: *mut c_int,
+                            error: *mut c_int,
+                            ring: *mut c_void) -> sgx_status_t;
+}
+
+/// Byte size of a ring with a data area of `size` bytes.
+pub fn log_ring_size(size: uint32_t) -> size_t {
+    mem::size_of::<log_ring>() + size as size_t
+}
+
+unsafe fn check_ring(ring: *mut log_ring) -> bool {
+    !ring.is_null() && sgx_is_outside_enclave(ring as * const c_void, mem::size_of::<log_ring>()) != 0
+}
+
+/// Starts the drainer that writes the records of `ring` to `fd`. The header
+/// must already be initialized and the data area zeroed.
+pub unsafe fn log_start(ring: *mut log_ring, fd: c_int) -> c_int {
+    let mut result: c_int = 0;
+    let mut error: c_int = 0;
+
+    if !check_ring(ring) {
+        set_errno(EINVAL);
+        return -1;
+    }
+
+    let status = ocall_profiled!(u_log_start_ocall(&mut result as *mut c_int,
+                                                   &mut error as *mut c_int,
+                                                   ring as *mut c_void,
+                                                   fd));
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
+
+/// Wakes the drainer if it sleeps and, unless `head` is `u64::MAX`, blocks
+/// until the drainer has moved `head` past the given position or a timeout
+/// expires. Callers must read `head` again themselves.
+pub unsafe fn log_wait(ring: *mut log_ring, head: uint64_t) -> c_int {
+    let mut result: c_int = 0;
+    let mut error: c_int = 0;
+
+    if !check_ring(ring) {
+        set_errno(EINVAL);
+        return -1;
+    }
+
+    let status = ocall_profiled!(u_log_wait_ocall(&mut result as *mut c_int,
+                                                  &mut error as *mut c_int,
+                                                  ring as *mut c_void,
+                                                  head));
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
+
+/// Stops the drainer once it has written every committed record, and waits
+/// for it to exit. The ring memory may be freed once this returns 0.
+pub unsafe fn log_stop(ring: *mut log_ring) -> c_int {
+    let mut result: c_int = 0;
+    let mut error: c_int = 0;
+
+    if !check_ring(ring) {
+        set_errno(EINVAL);
+        return -1;
+    }
+
+    let status = ocall_profiled!(u_log_stop_ocall(&mut result as *mut c_int,
+                                                  &mut error as *mut c_int,
+                                                  ring as *mut c_void));
+    if status == sgx_status_t::SGX_SUCCESS {
+        if result == -1 {
+            set_errno(error);
+        }
+    } else {
+        set_errno(ESGX);
+        result = -1;
+    }
+    result
+}
@@ -0,0 +1,560 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Per-call-site profile of enclave transitions.
+//!
+//! Every OCALL wrapper, and every ECALL that opts in with a guard, is a
+//! `ProfileSite`. While profiling is enabled each call adds one to the call
+//! count of its site, adds the bytes it marshalled across the boundary and,
+//! if latency is measured, puts its duration in TSC ticks into a log-linear
+//! histogram with eight sub-buckets per power of two, so every bucket is
+//! within 12.5% of the values it holds.
+//!
+//! The counters live in per-TCS shards keyed by the thread data address,
+//! like the staging-buffer pool. A shard is only written by the thread that
+//! runs on its TCS, so recording a call is a few plain loads and stores with
+//! no locked instruction and no cache line shared with other threads. TCSs
+//! beyond the shard table share one overflow shard updated with atomic adds.
+//! The counters of a site are allocated the first time a TCS records it.
+//!
+//! RDTSC is only legal inside an enclave on SGX2 hardware, so latency is
+//! measured only when the caller asks for it and has checked for SGX2.
+//! Without it, calls and bytes are still counted.
+
+use sgx_types::*;
+use alloc::alloc::{alloc_zeroed, dealloc, Layout};
+use alloc::boxed::Box;
+use alloc::vec::Vec;
+use core::arch::x86_64::_rdtsc;
+use core::cmp;
+use core::ptr;
+use core::sync::atomic::{AtomicBool, AtomicPtr, AtomicU64, AtomicUsize, Ordering};
+
+#[link(name = "sgx_trts")]
+extern "C" {
+    fn get_thread_data() -> *const c_void;
+}
+
+/// Most call sites the profile can tell apart. Sites registered after the
+/// table is full are not recorded.
+pub const PROFILE_MAX_SITES: usize = 256;
+const PROFILE_SHARDS: usize = 64;
+
+// Values below 2^SUB_BITS get a bucket each; above, every power of two is
+// split into 2^SUB_BITS buckets. Durations are clamped to 2^MAX_SHIFT - 1
+// ticks, several minutes on current hardware.
+const SUB_BITS: u32 = 3;
+const SUB_COUNT: u64 = 1 << SUB_BITS;
+const MAX_SHIFT: u32 = 40;
+/// Buckets of a latency histogram.
+pub const PROFILE_HIST_BUCKETS: usize = ((MAX_SHIFT - SUB_BITS + 1) << SUB_BITS) as usize;
+
+static ENABLED: AtomicBool = AtomicBool::new(false);
+static LATENCY: AtomicBool = AtomicBool::new(false);
+static NEXT_SITE: AtomicUsize = AtomicUsize::new(0);
+
+// Registered sites by id. Entries are written once, when a site gets its id.
+static mut SITES: [*const ProfileSite; PROFILE_MAX_SITES] = [ptr::null(); PROFILE_MAX_SITES];
+
+#[derive(Clone, Copy)]
+struct ShardSlot {
+    td: usize,
+    stats: *mut ShardStats,
+}
+
+// Slot PROFILE_SHARDS is the overflow shard. No thread claims it, as the
+// search for a free slot stops short of it.
+static mut SHARD_TABLE: [ShardSlot; PROFILE_SHARDS + 1] =
+    [ShardSlot { td: 0, stats: ptr::null_mut() }; PROFILE_SHARDS + 1];
+
+struct ShardStats {
+    sites: [*mut SiteStats; PROFILE_MAX_SITES],
+}
+
+struct SiteStats {
+    calls: AtomicU64,
+    bytes: AtomicU64,
+    timed: AtomicU64,
+    ticks: AtomicU64,
+    max: AtomicU64,
+    hist: [AtomicU64; PROFILE_HIST_BUCKETS],
+}
+
+/// Which side of the boundary a site calls into.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum ProfileKind {
+    /// A call out of the enclave. Its latency covers the whole round trip.
+    Ocall,
+    /// A call into the enclave. Its latency covers the time spent inside
+    /// only, not the enclave entry and exit around it.
+    Ecall,
+}
+
+/// A profiled call site, declared as a `static`.
+///
+/// ```ignore
+/// static SITE: ProfileSite = ProfileSite::ecall("ecall_process");
+///
+/// #[no_mangle]
+/// pub extern "C" fn ecall_process(buf: *const u8, len: usize) -> sgx_status_t {
+///     let _profile = SITE.enter(len);
+///     ...
+/// }
+/// ```
+pub struct ProfileSite {
+    name: &'static str,
+    kind: ProfileKind,
+    // Index into SITES plus one; zero until the first recorded call.
+    id: AtomicUsize,
+}
+
+impl ProfileSite {
+    pub const fn ocall(name: &'static str) -> ProfileSite {
+        ProfileSite { name, kind: ProfileKind::Ocall, id: AtomicUsize::new(0) }
+    }
+
+    pub const fn ecall(name: &'static str) -> ProfileSite {
+        ProfileSite { name, kind: ProfileKind::Ecall, id: AtomicUsize::new(0) }
+    }
+
+    pub fn name(&self) -> &'static str {
+        self.name
+    }
+
+    pub fn kind(&self) -> ProfileKind {
+        self.kind
+    }
+
+    /// Starts a call that marshals `bytes` across the boundary. The call is
+    /// recorded when the guard is dropped, and not at all if profiling is
+    /// disabled at this point.
+    #[inline]
+    pub fn enter(&'static self, bytes: usize) -> ProfileGuard {
+        if !ENABLED.load(Ordering::Relaxed) {
+            return ProfileGuard { site: None, bytes: 0, start: 0 };
+        }
+        let start = if LATENCY.load(Ordering::Relaxed) {
+            unsafe { _rdtsc() }
+        } else {
+            0
+        };
+        ProfileGuard { site: Some(self), bytes, start }
+    }
+
+    fn id(&'static self) -> Option<usize> {
+        let id = self.id.load(Ordering::Acquire);
+        if id != 0 && id != usize::max_value() {
+            return Some(id - 1);
+        }
+        self.register()
+    }
+
+    #[cold]
+    fn register(&'static self) -> Option<usize> {
+        // Reserve the slot first, so two threads racing for the same site
+        // can tell which of them publishes it.
+        match self.id.compare_exchange(0, usize::max_value(), Ordering::AcqRel, Ordering::Acquire) {
+            Ok(_) => {}
+            Err(id) if id == usize::max_value() => return None,
+            Err(id) => return Some(id - 1),
+        }
+        let index = NEXT_SITE.fetch_add(1, Ordering::Relaxed);
+        if index >= PROFILE_MAX_SITES {
+            NEXT_SITE.store(PROFILE_MAX_SITES, Ordering::Relaxed);
+            return None;
+        }
+        unsafe {
+            site_entry(index).store(self as *const ProfileSite as *mut ProfileSite, Ordering::Release);
+        }
+        self.id.store(index + 1, Ordering::Release);
+        Some(index)
+    }
+}
+
+/// Records one call of a `ProfileSite` when dropped.
+pub struct ProfileGuard {
+    site: Option<&'static ProfileSite>,
+    bytes: usize,
+    start: u64,
+}
+
+impl ProfileGuard {
+    /// Adds to the bytes the call marshalled, for calls that only know how
+    /// much came back once they have returned.
+    #[inline]
+    pub fn add_bytes(&mut self, bytes: usize) {
+        self.bytes += bytes;
+    }
+}
+
+impl Drop for ProfileGuard {
+    #[inline]
+    fn drop(&mut self) {
+        if let Some(site) = self.site {
+            let ticks = if self.start != 0 {
+                Some(unsafe { _rdtsc() }.saturating_sub(self.start))
+            } else {
+                None
+            };
+            record(site, self.bytes as u64, ticks);
+        }
+    }
+}
+
+/// Starts counting calls and marshalled bytes, and measuring latency if
+/// `latency` is set.
+///
+/// # Safety
+///
+/// Latency is measured with RDTSC, which faults inside an enclave unless
+/// the processor supports SGX2. The caller has to check that first.
+pub unsafe fn profile_enable(latency: bool) {
+    LATENCY.store(latency, Ordering::Relaxed);
+    ENABLED.store(true, Ordering::Relaxed);
+}
+
+/// Stops recording calls. What was recorded so far is kept.
+pub fn profile_disable() {
+    ENABLED.store(false, Ordering::Relaxed);
+}
+
+pub fn profile_enabled() -> bool {
+    ENABLED.load(Ordering::Relaxed)
+}
+
+/// Whether latency is measured while profiling is enabled.
+pub fn profile_latency() -> bool {
+    LATENCY.load(Ordering::Relaxed)
+}
+
+/// Reads the tick counter latencies are measured in.
+///
+/// # Safety
+///
+/// Faults inside an enclave unless the processor supports SGX2.
+pub unsafe fn profile_ticks() -> u64 {
+    _rdtsc()
+}
+
+/// Clears every counter. Calls recorded while the reset runs may survive
+/// it, as the shards are cleared without stopping the threads that own
+/// them.
+pub fn profile_reset() {
+    for_each_stats(|_, stats| {
+        stats.calls.store(0, Ordering::Relaxed);
+        stats.bytes.store(0, Ordering::Relaxed);
+        stats.timed.store(0, Ordering::Relaxed);
+        stats.ticks.store(0, Ordering::Relaxed);
+        stats.max.store(0, Ordering::Relaxed);
+        for bucket in stats.hist.iter() {
+            bucket.store(0, Ordering::Relaxed);
+        }
+    });
+}
+
+/// Totals of one call site, or of all sites of the same kind and name.
+#[derive(Clone, Debug)]
+pub struct SiteProfile {
+    pub name: &'static str,
+    pub kind: ProfileKind,
+    pub calls: u64,
+    /// Bytes copied across the boundary by all calls.
+    pub bytes: u64,
+    /// Durations of the calls that were timed, in TSC ticks.
+    pub latency: LatencyHistogram,
+}
+
+/// Sums the shards into one profile per kind and name, ordered by name with
+/// the ECALLs first. Sites that have not recorded a call are left out.
+pub fn profile_snapshot() -> Vec<SiteProfile> {
+    let sites = cmp::min(NEXT_SITE.load(Ordering::Relaxed), PROFILE_MAX_SITES);
+    let mut by_id: Vec<Option<SiteProfile>> = Vec::with_capacity(sites);
+    by_id.resize_with(sites, || None);
+
+    for_each_stats(|id, stats| {
+        let calls = stats.calls.load(Ordering::Relaxed);
+        if calls == 0 || id >= sites {
+            return;
+        }
+        if by_id[id].is_none() {
+            let site = unsafe { &*site_entry(id).load(Ordering::Acquire) };
+            by_id[id] = Some(SiteProfile {
+                name: site.name,
+                kind: site.kind,
+                calls: 0,
+                bytes: 0,
+                latency: LatencyHistogram::new(),
+            });
+        }
+        let profile = by_id[id].as_mut().unwrap();
+        profile.calls += calls;
+        profile.bytes += stats.bytes.load(Ordering::Relaxed);
+        profile.latency.add_stats(stats);
+    });
+
+    let mut profiles: Vec<SiteProfile> = by_id.into_iter().filter_map(|p| p).collect();
+    profiles.sort_by(|a, b| {
+        let kind = |p: &SiteProfile| if p.kind == ProfileKind::Ecall { 0 } else { 1 };
+        kind(a).cmp(&kind(b)).then(a.name.cmp(b.name))
+    });
+    // Wrappers such as read and read_untrusted share an OCALL and are
+    // reported as one.
+    let mut merged: Vec<SiteProfile> = Vec::with_capacity(profiles.len());
+    for profile in profiles {
+        match merged.last_mut() {
+            Some(last) if last.kind == profile.kind && last.name == profile.name => {
+                last.calls += profile.calls;
+                last.bytes += profile.bytes;
+                last.latency.merge(&profile.latency);
+            }
+            _ => merged.push(profile),
+        }
+    }
+    merged
+}
+
+/// A log-linear histogram of call durations in TSC ticks.
+#[derive(Clone, Debug)]
+pub struct LatencyHistogram {
+    counts: Box<[u64]>,
+    count: u64,
+    sum: u64,
+    max: u64,
+}
+
+impl Default for LatencyHistogram {
+    fn default() -> LatencyHistogram {
+        LatencyHistogram::new()
+    }
+}
+
+impl LatencyHistogram {
+    pub fn new() -> LatencyHistogram {
+        let mut counts = Vec::with_capacity(PROFILE_HIST_BUCKETS);
+        counts.resize(PROFILE_HIST_BUCKETS, 0_u64);
+        LatencyHistogram {
+            counts: counts.into_boxed_slice(),
+            count: 0,
+            sum: 0,
+            max: 0,
+        }
+    }
+
+    /// Adds one duration.
+    pub fn record(&mut self, ticks: u64) {
+        self.counts[bucket_index(ticks)] += 1;
+        self.count += 1;
+        self.sum = self.sum.saturating_add(ticks);
+        self.max = cmp::max(self.max, ticks);
+    }
+
+    pub fn merge(&mut self, other: &LatencyHistogram) {
+        for (count, other) in self.counts.iter_mut().zip(other.counts.iter()) {
+            *count += *other;
+        }
+        self.count += other.count;
+        self.sum = self.sum.saturating_add(other.sum);
+        self.max = cmp::max(self.max, other.max);
+    }
+
+    /// Number of durations recorded.
+    pub fn count(&self) -> u64 {
+        self.count
+    }
+
+    pub fn max(&self) -> u64 {
+        self.max
+    }
+
+    pub fn mean(&self) -> u64 {
+        if self.count == 0 { 0 } else { self.sum / self.count }
+    }
+
+    /// Returns the largest duration the bucket holding the `q`-quantile can
+    /// hold, but never more than the largest duration recorded. `q` is
+    /// clamped to `0.0..=1.0`.
+    pub fn quantile(&self, q: f64) -> u64 {
+        if self.count == 0 {
+            return 0;
+        }
+        let q = if q > 1.0 { 1.0 } else if q > 0.0 { q } else { 0.0 };
+        let exact = q * self.count as f64;
+        let mut rank = exact as u64;
+        if (rank as f64) < exact {
+            rank += 1;
+        }
+        let rank = cmp::max(rank, 1);
+
+        let mut seen = 0;
+        for (index, count) in self.counts.iter().enumerate() {
+            seen += *count;
+            // The last bucket also holds the clamped durations.
+            if seen >= rank && index + 1 < PROFILE_HIST_BUCKETS {
+                return cmp::min(bucket_high(index), self.max);
+            }
+        }
+        self.max
+    }
+
+    fn add_stats(&mut self, stats: &SiteStats) {
+        for (count, bucket) in self.counts.iter_mut().zip(stats.hist.iter()) {
+            *count += bucket.load(Ordering::Relaxed);
+        }
+        self.count += stats.timed.load(Ordering::Relaxed);
+        self.sum = self.sum.saturating_add(stats.ticks.load(Ordering::Relaxed));
+        self.max = cmp::max(self.max, stats.max.load(Ordering::Relaxed));
+    }
+}
+
+#[inline]
+fn bucket_index(ticks: u64) -> usize {
+    let ticks = cmp::min(ticks, (1 << MAX_SHIFT) - 1);
+    if ticks < SUB_COUNT {
+        return ticks as usize;
+    }
+    let shift = 63 - ticks.leading_zeros() - SUB_BITS;
+    (((shift as u64 + 1) << SUB_BITS) + (ticks >> shift) - SUB_COUNT) as usize
+}
+
+fn bucket_high(index: usize) -> u64 {
+    let index = index as u64;
+    if index < SUB_COUNT {
+        return index;
+    }
+    let shift = (index >> SUB_BITS) - 1;
+    let low = (SUB_COUNT + (index & (SUB_COUNT - 1))) << shift;
+    low + (1 << shift) - 1
+}
+
+#[inline]
+unsafe fn site_entry(index: usize) -> &'static AtomicPtr<ProfileSite> {
+    &*(&SITES[index] as *const *const ProfileSite as *const AtomicPtr<ProfileSite>)
+}
+
+#[inline]
+unsafe fn slot_td(slot: &ShardSlot) -> &AtomicUsize {
+    &*(&slot.td as *const usize as *const AtomicUsize)
+}
+
+#[inline]
+unsafe fn slot_stats(slot: &ShardSlot) -> &AtomicPtr<ShardStats> {
+    &*(&slot.stats as *const *mut ShardStats as *const AtomicPtr<ShardStats>)
+}
+
+// Returns the shard of the calling TCS, and whether other threads write
+// to it as well.
+unsafe fn current_shard() -> Option<(&'static ShardStats, bool)> {
+    let td = get_thread_data() as usize;
+    let mut index = PROFILE_SHARDS;
+    if td != 0 {
+        let start = ((td >> 12).wrapping_mul(0x9E37_79B9_7F4A_7C15) >> 58) as usize % PROFILE_SHARDS;
+        for i in 0..PROFILE_SHARDS {
+            let slot = (start + i) % PROFILE_SHARDS;
+            let key = slot_td(&SHARD_TABLE[slot]);
+            match key.compare_exchange(0, td, Ordering::AcqRel, Ordering::Acquire) {
+                Ok(_) => {}
+                Err(cur) if cur == td => {}
+                Err(_) => continue,
+            }
+            index = slot;
+            break;
+        }
+    }
+    let shared = index == PROFILE_SHARDS;
+    let stats = install(slot_stats(&SHARD_TABLE[index]))?;
+    Some((&*stats, shared))
+}
+
+// Returns the object behind `entry`, allocating it zeroed first if there is
+// none. Two threads may race to allocate the overflow shard's objects; the
+// loser frees its copy. Installed objects live as long as the enclave.
+#[inline]
+unsafe fn install<T>(entry: &AtomicPtr<T>) -> Option<*mut T> {
+    let cur = entry.load(Ordering::Acquire);
+    if !cur.is_null() {
+        return Some(cur);
+    }
+    let layout = Layout::new::<T>();
+    let new = alloc_zeroed(layout) as *mut T;
+    if new.is_null() {
+        return None;
+    }
+    match entry.compare_exchange(ptr::null_mut(), new, Ordering::AcqRel, Ordering::Acquire) {
+        Ok(_) => Some(new),
+        Err(cur) => {
+            dealloc(new as *mut u8, layout);
+            Some(cur)
+        }
+    }
+}
+
+#[inline]
+fn bump(counter: &AtomicU64, value: u64, shared: bool) {
+    if shared {
+        counter.fetch_add(value, Ordering::Relaxed);
+    } else {
+        counter.store(counter.load(Ordering::Relaxed).wrapping_add(value), Ordering::Relaxed);
+    }
+}
+
+fn record(site: &'static ProfileSite, bytes: u64, ticks: Option<u64>) {
+    let id = match site.id() {
+        Some(id) => id,
+        None => return,
+    };
+    unsafe {
+        let (shard, shared) = match current_shard() {
+            Some(shard) => shard,
+            None => return,
+        };
+        let entry = &*(&shard.sites[id] as *const *mut SiteStats as *const AtomicPtr<SiteStats>);
+        let stats = match install(entry) {
+            Some(stats) => &*stats,
+            None => return,
+        };
+        bump(&stats.calls, 1, shared);
+        bump(&stats.bytes, bytes, shared);
+        if let Some(ticks) = ticks {
+            bump(&stats.timed, 1, shared);
+            bump(&stats.ticks, ticks, shared);
+            bump(&stats.hist[bucket_index(ticks)], 1, shared);
+            if shared {
+                stats.max.fetch_max(ticks, Ordering::Relaxed);
+            } else if ticks > stats.max.load(Ordering::Relaxed) {
+                stats.max.store(ticks, Ordering::Relaxed);
+            }
+        }
+    }
+}
+
+fn for_each_stats<F: FnMut(usize, &SiteStats)>(mut f: F) {
+    unsafe {
+        for slot in SHARD_TABLE.iter() {
+            let shard = slot_stats(slot).load(Ordering::Acquire);
+            if shard.is_null() {
+                continue;
+            }
+            for (id, entry) in (*shard).sites.iter().enumerate() {
+                let entry = &*(entry as *const *mut SiteStats as *const AtomicPtr<SiteStats>);
+                let stats = entry.load(Ordering::Acquire);
+                if !stats.is_null() {
+                    f(id, &*stats);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,236 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Untrusted bounce buffers for OCALL payloads.
+//!
+//! Payloads up to `MAX_OCALL_ALLOC_SIZE` are carved from the untrusted stack
+//! with `sgx_ocalloc`. Larger ones come from a pool of untrusted staging
+//! buffers that each enclave thread keeps across calls, so a big read or
+//! write does not pay a `u_malloc_ocall`/`u_free_ocall` round trip every
+//! time. The pool has one buffer per power-of-two size class, from 32K up to
+//! `MAX_STAGING_SIZE`, and never caches more than the configured cap per
+//! thread. It is keyed by the thread data address rather than kept in TLS,
+//! because TLS is re-initialized on every root ECALL under the unbound TCS
+//! policy and the buffers would leak.
+
+use sgx_types::*;
+use super::{malloc, free, MAX_OCALL_ALLOC_SIZE};
+use core::ptr;
+use core::sync::atomic::{AtomicUsize, AtomicU64, Ordering};
+
+#[link(name = "sgx_trts")]
+extern "C" {
+    fn get_thread_data() -> *const c_void;
+}
+
+const STAGING_MIN_SHIFT: u32 = 15; //32K
+const STAGING_CLASSES: usize = 8;
+// Requests above this size bypass the pool.
+const MAX_STAGING_SIZE: size_t = 1 << (STAGING_MIN_SHIFT as usize + STAGING_CLASSES - 1); //4M
+const DEFAULT_STAGING_CAP: size_t = 0x80_0000; //8M
+const STAGING_SLOTS: usize = 256;
+
+static STAGING_CAP: AtomicUsize = AtomicUsize::new(DEFAULT_STAGING_CAP);
+static STAGING_HITS: AtomicU64 = AtomicU64::new(0);
+static STAGING_MISSES: AtomicU64 = AtomicU64::new(0);
+
+/// Counters of the untrusted staging-buffer pool shared by all enclave threads.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct StagingStats {
+    /// Large payloads served from a cached buffer.
+    pub hits: u64,
+    /// Large payloads that needed a `u_malloc_ocall`.
+    pub misses: u64,
+}
+
+/// Returns the hit/miss counters of the staging-buffer pool.
+pub fn staging_stats() -> StagingStats {
+    StagingStats {
+        hits: STAGING_HITS.load(Ordering::Relaxed),
+        misses: STAGING_MISSES.load(Ordering::Relaxed),
+    }
+}
+
+/// Sets how many bytes of staging buffers each enclave thread may keep
+/// cached between OCALLs. Zero disables caching.
+pub fn set_staging_cap(cap: size_t) {
+    STAGING_CAP.store(cap, Ordering::Relaxed);
+}
+
+/// Returns the per-thread cap on cached staging buffers, in bytes.
+pub fn staging_cap() -> size_t {
+    STAGING_CAP.load(Ordering::Relaxed)
+}
+
+/// Frees the staging buffers cached by the calling enclave thread.
+pub unsafe fn staging_trim() {
+    if let Some(slot) = current_slot() {
+        for class in 0..STAGING_CLASSES {
+            let entry = &mut slot.classes[class];
+            if !entry.base.is_null() && !entry.busy {
+                free(entry.base as *mut c_void);
+                entry.base = ptr::null_mut();
+                slot.cached -= class_size(class);
+            }
+        }
+    }
+}
+
+#[derive(Clone, Copy)]
+struct StagingEntry {
+    base: *mut u8,
+    busy: bool,
+}
+
+#[derive(Clone, Copy)]
+struct StagingSlot {
+    td: usize,
+    cached: size_t,
+    classes: [StagingEntry; STAGING_CLASSES],
+}
+
+const STAGING_SLOT_INIT: StagingSlot = StagingSlot {
+    td: 0,
+    cached: 0,
+    classes: [StagingEntry { base: ptr::null_mut(), busy: false }; STAGING_CLASSES],
+};
+
+// A slot is claimed once by an enclave thread and afterwards only touched
+// by that thread, so only the claim needs to be atomic.
+static mut STAGING_TABLE: [StagingSlot; STAGING_SLOTS] = [STAGING_SLOT_INIT; STAGING_SLOTS];
+
+unsafe fn current_slot() -> Option<&'static mut StagingSlot> {
+    let td = get_thread_data() as usize;
+    if td == 0 {
+        return None;
+    }
+
+    let start = ((td >> 12).wrapping_mul(0x9E37_79B9_7F4A_7C15) >> 56) % STAGING_SLOTS;
+    for i in 0..STAGING_SLOTS {
+        let slot = &mut STAGING_TABLE[(start + i) % STAGING_SLOTS];
+        let key = &*(&slot.td as *const usize as *const AtomicUsize);
+        match key.compare_exchange(0, td, Ordering::AcqRel, Ordering::Acquire) {
+            Ok(_) => return Some(slot),
+            Err(cur) if cur == td => return Some(slot),
+            Err(_) => {}
+        }
+    }
+    None
+}
+
+#[inline]
+fn size_class(size: size_t) -> usize {
+    let shift = size.next_power_of_two().trailing_zeros();
+    if shift <= STAGING_MIN_SHIFT {
+        0
+    } else {
+        (shift - STAGING_MIN_SHIFT) as usize
+    }
+}
+
+#[inline]
+fn class_size(class: usize) -> size_t {
+    1 << (STAGING_MIN_SHIFT as usize + class)
+}
+
+enum Backing {
+    Stack,
+    Staging(&'static mut StagingSlot, usize),
+    Heap,
+}
+
+/// An untrusted buffer that is released when dropped, after the OCALL
+/// that used it has returned.
+pub struct OcallBuf {
+    base: *mut u8,
+    backing: Backing,
+}
+
+impl OcallBuf {
+    pub unsafe fn alloc(size: size_t) -> Option<OcallBuf> {
+        if size <= MAX_OCALL_ALLOC_SIZE {
+            let base = sgx_ocalloc(size) as *mut u8;
+            return if base.is_null() {
+                None
+            } else {
+                Some(OcallBuf { base, backing: Backing::Stack })
+            };
+        }
+
+        if size <= MAX_STAGING_SIZE {
+            if let Some(slot) = current_slot() {
+                let class = size_class(size);
+                let entry = &mut slot.classes[class];
+                if !entry.busy {
+                    if entry.base.is_null() {
+                        STAGING_MISSES.fetch_add(1, Ordering::Relaxed);
+                        let base = malloc(class_size(class)) as *mut u8;
+                        if base.is_null() {
+                            return None;
+                        }
+                        entry.base = base;
+                        slot.cached += class_size(class);
+                    } else {
+                        STAGING_HITS.fetch_add(1, Ordering::Relaxed);
+                    }
+                    entry.busy = true;
+                    let base = entry.base;
+                    return Some(OcallBuf { base, backing: Backing::Staging(slot, class) });
+                }
+            }
+        }
+
+        STAGING_MISSES.fetch_add(1, Ordering::Relaxed);
+        let base = malloc(size) as *mut u8;
+        if base.is_null() {
+            None
+        } else {
+            Some(OcallBuf { base, backing: Backing::Heap })
+        }
+    }
+
+    #[inline]
+    pub fn as_ptr(&self) -> *const c_void {
+        self.base as *const c_void
+    }
+
+    #[inline]
+    pub fn as_mut_ptr(&mut self) -> *mut c_void {
+        self.base as *mut c_void
+    }
+}
+
+impl Drop for OcallBuf {
+    fn drop(&mut self) {
+        unsafe {
+            match self.backing {
+                Backing::Stack => sgx_ocfree(),
+                Backing::Staging(ref mut slot, class) => {
+                    let entry = &mut slot.classes[class];
+                    entry.busy = false;
+                    // Keep the buffer unless the thread is over its cap.
+                    if slot.cached > STAGING_CAP.load(Ordering::Relaxed) {
+                        free(entry.base as *mut c_void);
+                        entry.base = ptr::null_mut();
+                        slot.cached -= class_size(class);
+                    }
+                }
+                Backing::Heap => free(self.base as *mut c_void),
+            }
+        }
+    }
+}
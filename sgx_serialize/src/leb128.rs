@@ -15,134 +15,176 @@
 // specific language governing permissions and limitations
 // under the License..
 
+//! LEB128 encoding and decoding.
+//!
+//! Values of up to 56 bits, which is most lengths and integers seen in
+//! practice, are encoded and decoded a whole 64-bit word at a time: the
+//! 7-bit groups are spread over the bytes of the word (or gathered back)
+//! with three shift-and-mask steps, and the length comes from a count of
+//! leading or trailing zeros. Wider values take the byte loop.
+
+use std::ptr;
 use std::vec::Vec;
 
+const CONT_BITS: u64 = 0x8080_8080_8080_8080;
+const DATA_BITS: u64 = 0x7f7f_7f7f_7f7f_7f7f;
+
+/// The longest encoding of a 128-bit value.
+const MAX_LEN: usize = 19;
+
+/// Moves the low 56 bits of `x` into the low 7 bits of each byte.
 #[inline]
-fn write_to_vec(vec: &mut Vec<u8>, position: usize, byte: u8) {
-    if position == vec.len() {
-        vec.push(byte);
-    } else {
-        vec[position] = byte;
-    }
+fn spread(x: u64) -> u64 {
+    let x = (x & 0x0000_0000_0fff_ffff) | ((x & 0x00ff_ffff_f000_0000) << 4);
+    let x = (x & 0x0000_3fff_0000_3fff) | ((x & 0x0fff_c000_0fff_c000) << 2);
+    (x & 0x007f_007f_007f_007f) | ((x & 0x3f80_3f80_3f80_3f80) << 1)
 }
 
-/// Encodes an integer using unsigned leb128 encoding and stores
-/// the result using a callback function.
-///
-/// The callback function `write` is called once on writing one byte out.
+/// The inverse of `spread`, for a word whose top bits are clear.
 #[inline]
-pub fn write_unsigned_leb128_to<W>(mut value: u128, mut write: W) -> usize
-where
-    W: FnMut(usize, u8),
-{
-    let mut position = 0;
-    loop {
-        let mut byte = (value & 0x7F) as u8;
-        value >>= 7;
-        if value != 0 {
-            byte |= 0x80;
-        }
-
-        write(position, byte);
-        position += 1;
+fn gather(x: u64) -> u64 {
+    let x = (x & 0x007f_007f_007f_007f) | ((x & 0x7f00_7f00_7f00_7f00) >> 1);
+    let x = (x & 0x0000_3fff_0000_3fff) | ((x & 0x3fff_0000_3fff_0000) >> 2);
+    (x & 0x0000_0000_0fff_ffff) | ((x & 0x0fff_ffff_0000_0000) >> 4)
+}
 
-        if value == 0 {
-            break;
+/// Appends the low `len` bytes of `word`, `len` being 1 to 8.
+#[inline]
+fn push_word(out: &mut Vec<u8>, word: u64, len: usize) {
+    let bytes = word.to_le_bytes();
+    if out.capacity() - out.len() >= 8 {
+        // Store the whole word and keep `len` bytes of it.
+        unsafe {
+            let end = out.len();
+            ptr::write_unaligned(out.as_mut_ptr().add(end) as *mut [u8; 8], bytes);
+            out.set_len(end + len);
         }
+    } else {
+        out.extend_from_slice(&bytes[..len]);
     }
-
-    position
 }
 
-/// A wrapper function of `write_unsigned_leb128_to`.
-/// `write_unsigned_leb128` uses a private function `write_to_vec` for emitting
-/// bytes to given `Vec<u8>`.
-pub fn write_unsigned_leb128(out: &mut Vec<u8>, start_position: usize, value: u128) -> usize {
-    write_unsigned_leb128_to(value, |i, v| write_to_vec(out, start_position+i, v))
+/// Encodes `low`, the low `7 * len` bits of a value, as `len` bytes.
+#[inline]
+fn push_groups(out: &mut Vec<u8>, low: u64, len: usize) {
+    let cont = CONT_BITS & ((1_u64 << (8 * (len - 1))) - 1);
+    push_word(out, spread(low) | cont, len);
 }
 
-/// `read_unsigned_leb128` reads data from arg `data` at offset `start_position`
-/// Returns the decoded `u128` value along with read size
+/// Returns the number of bytes `value` takes in unsigned LEB128.
 #[inline]
-pub fn read_unsigned_leb128(data: &[u8], start_position: usize) -> (u128, usize) {
-    let mut result = 0;
-    let mut shift = 0;
-    let mut position = start_position;
-    loop {
-        let byte = data[position];
-        position += 1;
-        result |= ((byte & 0x7F) as u128) << shift;
-        if (byte & 0x80) == 0 {
-            break;
-        }
-        shift += 7;
-    }
+pub fn unsigned_leb128_size(value: u128) -> usize {
+    let bits = 128 - (value | 1).leading_zeros() as usize;
+    (bits + 6) / 7
+}
 
-    (result, position - start_position)
+/// Returns the number of bytes `value` takes in signed LEB128.
+#[inline]
+pub fn signed_leb128_size(value: i128) -> usize {
+    // The magnitude bits plus a sign bit.
+    let bits = 129 - ((value ^ (value >> 127)) as u128).leading_zeros() as usize;
+    (bits + 6) / 7
 }
 
-/// Encodes an integer using signed leb128 encoding and stores
-/// the result using a callback function.
-///
-/// The callback function `write` is called once on writing one byte out.
+/// Appends `value` to `out` in unsigned LEB128. Returns the bytes written.
 #[inline]
-pub fn write_signed_leb128_to<W>(mut value: i128, mut write: W) -> usize
-where
-    W: FnMut(usize, u8),
-{
-    let mut position = 0;
-
-    loop {
-        let mut byte = (value as u8) & 0x7f;
-        value >>= 7;
-        let more = !((((value == 0) && ((byte & 0x40) == 0)) ||
-                      ((value == -1) && ((byte & 0x40) != 0))));
+pub fn write_unsigned_leb128(out: &mut Vec<u8>, value: u128) -> usize {
+    let len = unsigned_leb128_size(value);
+    if len <= 8 {
+        push_groups(out, value as u64, len);
+        return len;
+    }
 
-        if more {
-            byte |= 0x80; // Mark this byte to show that more bytes will follow.
-        }
+    let mut buf = [0_u8; MAX_LEN];
+    let mut value = value;
+    for byte in buf[..len - 1].iter_mut() {
+        *byte = (value as u8) | 0x80;
+        value >>= 7;
+    }
+    buf[len - 1] = value as u8;
+    out.extend_from_slice(&buf[..len]);
+    len
+}
 
-        write(position, byte);
-        position += 1;
+/// Appends `value` to `out` in signed LEB128. Returns the bytes written.
+#[inline]
+pub fn write_signed_leb128(out: &mut Vec<u8>, value: i128) -> usize {
+    let len = signed_leb128_size(value);
+    if len <= 8 {
+        let low = (value as u64) & ((1_u64 << (7 * len)) - 1);
+        push_groups(out, low, len);
+        return len;
+    }
 
-        if !more {
-            break;
-        }
+    let mut buf = [0_u8; MAX_LEN];
+    let mut value = value;
+    for byte in buf[..len - 1].iter_mut() {
+        *byte = (value as u8) | 0x80;
+        value >>= 7;
     }
-    position
+    buf[len - 1] = (value as u8) & 0x7f;
+    out.extend_from_slice(&buf[..len]);
+    len
 }
 
-/// A wrapper function of `write_signed_leb128_to`.
-/// `write_unsigned_leb128` uses a private function `write_to_vec` for emitting
-/// bytes to given `Vec<u8>`.
-pub fn write_signed_leb128(out: &mut Vec<u8>, start_position: usize, value: i128) -> usize {
-    write_signed_leb128_to(value, |i, v| write_to_vec(out, start_position+i, v))
+/// Decodes up to 8 bytes from the word at `data[start..start + 8]`.
+/// Returns the low bits of the value and its length, or `None` if the
+/// value runs past the word or there is no whole word left.
+#[inline]
+fn read_word(data: &[u8], start: usize) -> Option<(u64, usize)> {
+    let bytes = data.get(start..start.checked_add(8)?)?;
+    let mut word = [0_u8; 8];
+    word.copy_from_slice(bytes);
+    let word = u64::from_le_bytes(word);
+
+    let stop = !word & CONT_BITS;
+    if stop == 0 {
+        return None;
+    }
+    let len = stop.trailing_zeros() as usize / 8 + 1;
+    let keep = if len == 8 { !0 } else { (1_u64 << (8 * len)) - 1 };
+    Some((gather(word & keep & DATA_BITS), len))
 }
 
-/// `read_signed_leb128` reads data from arg `data` at offset `start_position`
-/// Returns the decoded `u128` value along with read size
-#[inline]
-pub fn read_signed_leb128(data: &[u8], start_position: usize) -> (i128, usize) {
+/// Decodes byte by byte. Returns the low 128 bits of the value, the bits
+/// read and the length.
+fn read_bytes(data: &[u8], start: usize) -> Option<(u128, usize, usize)> {
     let mut result = 0;
     let mut shift = 0;
-    let mut position = start_position;
-    let mut byte;
-
-    loop {
-        byte = data[position];
-        position += 1;
-        result |= ((byte & 0x7F) as i128) << shift;
+    for (i, &byte) in data.get(start..)?.iter().take(MAX_LEN).enumerate() {
+        result |= ((byte & 0x7f) as u128) << shift;
         shift += 7;
-
-        if (byte & 0x80) == 0 {
-            break;
+        if byte & 0x80 == 0 {
+            return Some((result, shift, i + 1));
         }
     }
+    None
+}
 
-    if (shift < 64) && ((byte & 0x40) != 0) {
-        // sign extend
-        result |= -(1 << shift);
+/// Reads an unsigned LEB128 value from `data` at `start_position`.
+/// Returns the value and the bytes read, or `None` if `data` ends first.
+#[inline]
+pub fn read_unsigned_leb128(data: &[u8], start_position: usize) -> Option<(u128, usize)> {
+    if let Some((value, len)) = read_word(data, start_position) {
+        return Some((value as u128, len));
     }
+    let (value, _, len) = read_bytes(data, start_position)?;
+    Some((value, len))
+}
 
-    (result, position - start_position)
+/// Reads a signed LEB128 value from `data` at `start_position`.
+/// Returns the value and the bytes read, or `None` if `data` ends first.
+#[inline]
+pub fn read_signed_leb128(data: &[u8], start_position: usize) -> Option<(i128, usize)> {
+    let (value, bits, len) = match read_word(data, start_position) {
+        Some((value, len)) => (value as u128, 7 * len, len),
+        None => read_bytes(data, start_position)?,
+    };
+    // Sign extend from the top bit read.
+    let value = if bits < 128 && (value >> (bits - 1)) & 1 != 0 {
+        (value as i128) | (-1_i128 << bits)
+    } else {
+        value as i128
+    };
+    Some((value, len))
 }
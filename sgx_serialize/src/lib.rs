@@ -29,6 +29,7 @@ extern crate sgx_tstd as std;
 
 mod serialize;
 pub use self::serialize::{Decoder, Encoder, DeSerializable, Serializable, SerializeHelper, DeSerializeHelper};
+pub use self::serialize::{BorrowDecoder, DeSerializableBorrowed, BorrowDeSerializeHelper};
 
 mod opaque;
 mod leb128;
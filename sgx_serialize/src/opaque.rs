@@ -19,38 +19,35 @@
 //! The mod opaque Encoder and Decoder container to save buffer of target types
 //!
 
-use crate::leb128::{read_signed_leb128, read_unsigned_leb128, write_signed_leb128, write_unsigned_leb128};
+use crate::leb128::{self, read_signed_leb128, read_unsigned_leb128, write_signed_leb128, write_unsigned_leb128};
 use std::vec::Vec;
 use std::string::String;
 use std::string::ToString;
 use std::borrow::Cow;
-use std::io::{self, Write};
+use std::str;
 use crate::serialize;
 
+/// Appends the encoding to a `Vec<u8>`.
 pub struct Encoder<'a> {
-    pub cursor: &'a mut io::Cursor<Vec<u8>>,
+    pub data: &'a mut Vec<u8>,
 }
 
 impl<'a> Encoder<'a> {
-    pub fn new(cursor: &'a mut io::Cursor<Vec<u8>>) -> Encoder<'a> {
-        Encoder { cursor: cursor }
+    pub fn new(data: &'a mut Vec<u8>) -> Encoder<'a> {
+        Encoder { data: data }
     }
 }
 
 macro_rules! write_uleb128 {
     ($enc:expr, $value:expr) => {{
-        let pos = $enc.cursor.position() as usize;
-        let bytes_written = write_unsigned_leb128($enc.cursor.get_mut(), pos, $value as u128);
-        $enc.cursor.set_position((pos + bytes_written) as u64);
+        write_unsigned_leb128($enc.data, $value as u128);
         Ok(())
     }}
 }
 
 macro_rules! write_sleb128 {
     ($enc:expr, $value:expr) => {{
-        let pos = $enc.cursor.position() as usize;
-        let bytes_written = write_signed_leb128($enc.cursor.get_mut(), pos, $value as i128);
-        $enc.cursor.set_position((pos + bytes_written) as u64);
+        write_signed_leb128($enc.data, $value as i128);
         Ok(())
     }}
 }
@@ -83,7 +80,7 @@ impl<'a> serialize::Encoder for Encoder<'a> {
     }
 
     fn emit_u8(&mut self, v: u8) -> Result<(), Self::Error> {
-        let _ = self.cursor.write_all(&[v]);
+        self.data.push(v);
         Ok(())
     }
 
@@ -108,8 +105,7 @@ impl<'a> serialize::Encoder for Encoder<'a> {
     }
 
     fn emit_i8(&mut self, v: i8) -> Result<(), Self::Error> {
-        let as_u8: u8 = unsafe { ::std::mem::transmute(v) };
-        let _ = self.cursor.write_all(&[as_u8]);
+        self.data.push(v as u8);
         Ok(())
     }
 
@@ -122,13 +118,11 @@ impl<'a> serialize::Encoder for Encoder<'a> {
     }
 
     fn emit_f64(&mut self, v: f64) -> Result<(), Self::Error> {
-        let as_u64: u64 = unsafe { ::std::mem::transmute(v) };
-        self.emit_u64(as_u64)
+        self.emit_u64(v.to_bits())
     }
 
     fn emit_f32(&mut self, v: f32) -> Result<(), Self::Error> {
-        let as_u32: u32 = unsafe { ::std::mem::transmute(v) };
-        self.emit_u32(as_u32)
+        self.emit_u32(v.to_bits())
     }
 
     fn emit_char(&mut self, v: char) -> Result<(), Self::Error> {
@@ -136,17 +130,141 @@ impl<'a> serialize::Encoder for Encoder<'a> {
     }
 
     fn emit_str(&mut self, v: &str) -> Result<(), Self::Error> {
+        self.emit_bytes(v.as_bytes())
+    }
+
+    fn emit_bytes(&mut self, v: &[u8]) -> Result<(), Self::Error> {
         self.emit_usize(v.len())?;
-        let _ = self.cursor.write_all(v.as_bytes());
+        self.data.extend_from_slice(v);
         Ok(())
     }
 }
 
+// -----------------------------------------------------------------------------
+// SizeEncoder
+// -----------------------------------------------------------------------------
+
+/// Counts the bytes `Encoder` would write, so the output can be allocated
+/// once up front.
+pub struct SizeEncoder {
+    size: usize,
+}
+
+impl SizeEncoder {
+    pub fn new() -> SizeEncoder {
+        SizeEncoder { size: 0 }
+    }
+
+    pub fn size(&self) -> usize {
+        self.size
+    }
+}
+
+macro_rules! size_uleb128 {
+    ($enc:expr, $value:expr) => {{
+        $enc.size += leb128::unsigned_leb128_size($value as u128);
+        Ok(())
+    }}
+}
+
+macro_rules! size_sleb128 {
+    ($enc:expr, $value:expr) => {{
+        $enc.size += leb128::signed_leb128_size($value as i128);
+        Ok(())
+    }}
+}
+
+impl serialize::Encoder for SizeEncoder {
+    type Error = ();
+
+    fn emit_nil(&mut self) -> Result<(), Self::Error> {
+        Ok(())
+    }
+
+    fn emit_usize(&mut self, v: usize) -> Result<(), Self::Error> {
+        size_uleb128!(self, v)
+    }
+
+    fn emit_u128(&mut self, v: u128) -> Result<(), Self::Error> {
+        size_uleb128!(self, v)
+    }
+
+    fn emit_u64(&mut self, v: u64) -> Result<(), Self::Error> {
+        size_uleb128!(self, v)
+    }
+
+    fn emit_u32(&mut self, v: u32) -> Result<(), Self::Error> {
+        size_uleb128!(self, v)
+    }
+
+    fn emit_u16(&mut self, v: u16) -> Result<(), Self::Error> {
+        size_uleb128!(self, v)
+    }
+
+    fn emit_u8(&mut self, _v: u8) -> Result<(), Self::Error> {
+        self.size += 1;
+        Ok(())
+    }
+
+    fn emit_isize(&mut self, v: isize) -> Result<(), Self::Error> {
+        size_sleb128!(self, v)
+    }
+
+    fn emit_i128(&mut self, v: i128) -> Result<(), Self::Error> {
+        size_sleb128!(self, v)
+    }
+
+    fn emit_i64(&mut self, v: i64) -> Result<(), Self::Error> {
+        size_sleb128!(self, v)
+    }
+
+    fn emit_i32(&mut self, v: i32) -> Result<(), Self::Error> {
+        size_sleb128!(self, v)
+    }
+
+    fn emit_i16(&mut self, v: i16) -> Result<(), Self::Error> {
+        size_sleb128!(self, v)
+    }
+
+    fn emit_i8(&mut self, _v: i8) -> Result<(), Self::Error> {
+        self.size += 1;
+        Ok(())
+    }
+
+    fn emit_bool(&mut self, _v: bool) -> Result<(), Self::Error> {
+        self.size += 1;
+        Ok(())
+    }
+
+    fn emit_f64(&mut self, v: f64) -> Result<(), Self::Error> {
+        self.emit_u64(v.to_bits())
+    }
+
+    fn emit_f32(&mut self, v: f32) -> Result<(), Self::Error> {
+        self.emit_u32(v.to_bits())
+    }
+
+    fn emit_char(&mut self, v: char) -> Result<(), Self::Error> {
+        self.emit_u32(v as u32)
+    }
+
+    fn emit_str(&mut self, v: &str) -> Result<(), Self::Error> {
+        self.emit_bytes(v.as_bytes())
+    }
+
+    fn emit_bytes(&mut self, v: &[u8]) -> Result<(), Self::Error> {
+        self.emit_usize(v.len())?;
+        self.size += v.len();
+        Ok(())
+    }
+}
 
 // -----------------------------------------------------------------------------
 // Decoder
 // -----------------------------------------------------------------------------
 
+/// Decodes from a byte slice. Strings and byte slices can be borrowed from
+/// it through `serialize::BorrowDecoder`.
 pub struct Decoder<'a> {
     pub data: &'a [u8],
     position: usize,
@@ -167,21 +285,53 @@ impl<'a> Decoder<'a> {
     // pub fn advance(&mut self, bytes: usize) {
     //     self.position += bytes;
     // }
+
+    #[inline]
+    fn read_raw_byte(&mut self) -> Result<u8, String> {
+        match self.data.get(self.position) {
+            Some(&value) => {
+                self.position += 1;
+                Ok(value)
+            }
+            None => Err("unexpected end of data".to_string()),
+        }
+    }
+
+    #[inline]
+    fn read_raw_bytes(&mut self, len: usize) -> Result<&'a [u8], String> {
+        let data: &'a [u8] = self.data;
+        let end = self.position.checked_add(len);
+        match end.and_then(|end| data.get(self.position..end)) {
+            Some(bytes) => {
+                self.position += len;
+                Ok(bytes)
+            }
+            None => Err("unexpected end of data".to_string()),
+        }
+    }
 }
 
 macro_rules! read_uleb128 {
     ($dec:expr, $t:ty) => ({
-        let (value, bytes_read) = read_unsigned_leb128($dec.data, $dec.position);
-        $dec.position += bytes_read;
-        Ok(value as $t)
+        match read_unsigned_leb128($dec.data, $dec.position) {
+            Some((value, bytes_read)) => {
+                $dec.position += bytes_read;
+                Ok(value as $t)
+            }
+            None => Err("unexpected end of data".to_string()),
+        }
     })
 }
 
 macro_rules! read_sleb128 {
     ($dec:expr, $t:ty) => ({
-        let (value, bytes_read) = read_signed_leb128($dec.data, $dec.position);
-        $dec.position += bytes_read;
-        Ok(value as $t)
+        match read_signed_leb128($dec.data, $dec.position) {
+            Some((value, bytes_read)) => {
+                $dec.position += bytes_read;
+                Ok(value as $t)
+            }
+            None => Err("unexpected end of data".to_string()),
+        }
     })
 }
 
@@ -215,9 +365,7 @@ impl<'a> serialize::Decoder for Decoder<'a> {
 
     #[inline]
     fn read_u8(&mut self) -> Result<u8, Self::Error> {
-        let value = self.data[self.position];
-        self.position += 1;
-        Ok(value)
+        self.read_raw_byte()
     }
 
     #[inline]
@@ -247,9 +395,7 @@ impl<'a> serialize::Decoder for Decoder<'a> {
 
     #[inline]
     fn read_i8(&mut self) -> Result<i8, Self::Error> {
-        let as_u8 = self.data[self.position];
-        self.position += 1;
-        unsafe { Ok(::std::mem::transmute(as_u8)) }
+        Ok(self.read_raw_byte()? as i8)
     }
 
     #[inline]
@@ -266,30 +412,41 @@ impl<'a> serialize::Decoder for Decoder<'a> {
     #[inline]
     fn read_f64(&mut self) -> Result<f64, Self::Error> {
         let bits = self.read_u64()?;
-        Ok(unsafe { ::std::mem::transmute(bits) })
+        Ok(f64::from_bits(bits))
     }
 
     #[inline]
     fn read_f32(&mut self) -> Result<f32, Self::Error> {
         let bits = self.read_u32()?;
-        Ok(unsafe { ::std::mem::transmute(bits) })
+        Ok(f32::from_bits(bits))
     }
 
     #[inline]
     fn read_char(&mut self) -> Result<char, Self::Error> {
         let bits = self.read_u32()?;
-        Ok(::std::char::from_u32(bits).unwrap())
+        ::std::char::from_u32(bits).ok_or_else(|| "invalid char".to_string())
     }
 
     #[inline]
     fn read_str(&mut self) -> Result<Cow<str>, Self::Error> {
-        let len = self.read_usize()?;
-        let s = ::std::str::from_utf8(&self.data[self.position..self.position + len]).unwrap();
-        self.position += len;
-        Ok(Cow::Borrowed(s))
+        serialize::BorrowDecoder::read_borrowed_str(self).map(Cow::Borrowed)
     }
 
     fn error(&mut self, err: &str) -> Self::Error {
         err.to_string()
     }
 }
+
+impl<'a> serialize::BorrowDecoder<'a> for Decoder<'a> {
+    #[inline]
+    fn read_borrowed_str(&mut self) -> Result<&'a str, Self::Error> {
+        let bytes = self.read_borrowed_bytes()?;
+        str::from_utf8(bytes).map_err(|_| "invalid utf-8 string".to_string())
+    }
+
+    #[inline]
+    fn read_borrowed_bytes(&mut self) -> Result<&'a [u8], Self::Error> {
+        let len = serialize::Decoder::read_usize(self)?;
+        self.read_raw_bytes(len)
+    }
+}
@@ -205,6 +205,17 @@ pub trait Encoder {
         f(self)
     }
 
+    /// Emits a byte slice the way `[u8]` is encoded: the length, then the
+    /// bytes. Encoders writing to a buffer copy the bytes at once.
+    fn emit_bytes(&mut self, v: &[u8]) -> Result<(), Self::Error> {
+        self.emit_seq(v.len(), |s| {
+            for (i, b) in v.iter().enumerate() {
+                s.emit_seq_elt(i, |s| s.emit_u8(*b))?
+            }
+            Ok(())
+        })
+    }
+
     fn emit_map<F>(&mut self, len: usize, f: F) -> Result<(), Self::Error>
     where F: FnOnce(&mut Self) -> Result<(), Self::Error>,
     {
@@ -433,6 +444,21 @@ pub trait DeSerializable: Sized {
     fn decode<D: Decoder>(d: &mut D) -> Result<Self, D::Error>;
 }
 
+/// A decoder over a buffer living for `'de`, which can hand out strings and
+/// byte slices pointing into that buffer instead of copies.
+pub trait BorrowDecoder<'de>: Decoder {
+    fn read_borrowed_str(&mut self) -> Result<&'de str, Self::Error>;
+    fn read_borrowed_bytes(&mut self) -> Result<&'de [u8], Self::Error>;
+}
+
+/// Types decoded from a `BorrowDecoder`, which may borrow from its buffer.
+///
+/// The encoding is the one of the owned types: `&str` reads what `String`
+/// writes and `&[u8]` what `Vec<u8>` writes.
+pub trait DeSerializableBorrowed<'de>: Sized {
+    fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<Self, D::Error>;
+}
+
 pub trait Serializable {
     fn encode<S: Encoder>(&self, s: &mut S) -> Result<(), S::Error>;
 }
@@ -784,6 +810,65 @@ impl<T:DeSerializable> DeSerializable for Option<T> {
     }
 }
 
+macro_rules! owned_borrowed {
+    ($($t:ty),*) => ($(
+        impl<'de> DeSerializableBorrowed<'de> for $t {
+            #[inline]
+            fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<$t, D::Error> {
+                DeSerializable::decode(d)
+            }
+        }
+    )*)
+}
+
+owned_borrowed! {
+    (), bool, char, f32, f64, String,
+    u8, u16, u32, u64, u128, usize,
+    i8, i16, i32, i64, i128, isize
+}
+
+impl<'de> DeSerializableBorrowed<'de> for &'de str {
+    fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<&'de str, D::Error> {
+        d.read_borrowed_str()
+    }
+}
+
+impl<'de> DeSerializableBorrowed<'de> for &'de [u8] {
+    fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<&'de [u8], D::Error> {
+        d.read_borrowed_bytes()
+    }
+}
+
+impl<'de> DeSerializableBorrowed<'de> for Cow<'de, str> {
+    fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<Cow<'de, str>, D::Error> {
+        Ok(Cow::Borrowed(d.read_borrowed_str()?))
+    }
+}
+
+impl<'de, T: DeSerializableBorrowed<'de>> DeSerializableBorrowed<'de> for Option<T> {
+    fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<Option<T>, D::Error> {
+        d.read_option(|d, b| {
+            if b {
+                Ok(Some(DeSerializableBorrowed::decode_borrowed(d)?))
+            } else {
+                Ok(None)
+            }
+        })
+    }
+}
+
+impl<'de, T: DeSerializableBorrowed<'de>> DeSerializableBorrowed<'de> for Vec<T> {
+    fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<Vec<T>, D::Error> {
+        d.read_seq(|d, len| {
+            let mut v = Vec::with_capacity(len);
+            for i in 0..len {
+                v.push(d.read_seq_elt(i, |d| DeSerializableBorrowed::decode_borrowed(d))?);
+            }
+            Ok(v)
+        })
+    }
+}
+
 macro_rules! peel {
     ($name:ident, $($other:ident,)*) => (tuple! { $($other,)* })
 }
@@ -1103,14 +1188,14 @@ where
     }
 }
 
-use std::io::Cursor;
 use std::marker::PhantomData;
 use crate::opaque::Encoder as DataEncoder;
 use crate::opaque::Decoder as DataDecoder;
+use crate::opaque::SizeEncoder as DataSizeEncoder;
 
 ///  SerializeHelper make it easy to obtain serialize function.
 pub struct SerializeHelper {
-    cursor: RefCell<Cursor<Vec<u8>>>,
+    size: Cell<usize>,
 }
 
 impl SerializeHelper {
@@ -1122,13 +1207,13 @@ impl SerializeHelper {
     ///
     pub fn new() -> SerializeHelper {
         SerializeHelper {
-            cursor: RefCell::new(Cursor::new(Vec::new())),
+            size: Cell::new(0),
         }
     }
 
-    /// Get the size of the serialized buffer of the target.
+    /// Get the size of the serialized buffer of the last encoded target.
     pub fn get_size(&self) -> usize {
-        self.cursor.borrow().get_ref().len()
+        self.size.get()
     }
 }
 
@@ -1136,6 +1221,8 @@ impl SerializeHelper {
     /// Use encode to serialize a target type. The target must impl the tarit Serializable.
     /// The function return a Option::Some of `Vec<u8>`, if something error, return Option::None.
     ///
+    /// The size of the encoding is computed first, so the buffer is allocated once.
+    ///
     /// ```
     /// #[derive(Serializable, DeSerializable)]
     /// struct TestSturct {
@@ -1148,19 +1235,38 @@ impl SerializeHelper {
     /// ```
     ///
     pub fn encode< E: Serializable >(&self, target: E) -> Option<Vec<u8>> {
-        {
-            let mut cursor = self.cursor.borrow_mut();
-            let mut encoder = DataEncoder::new(&mut cursor);
-            match target.encode(&mut encoder) {
-                Result::Err(_) => return Option::None,
-                _ => {},
-            }
-        }
-        let data = self.cursor.borrow().clone().into_inner();
+        let mut data = Vec::new();
+        self.encode_into(target, &mut data)?;
         Option::Some(data)
     }
-}
 
+    /// Appends the encoding of target to `data`, growing it once, and returns the
+    /// number of bytes appended.
+    pub fn encode_into< E: Serializable >(&self, target: E, data: &mut Vec<u8>) -> Option<usize> {
+        let size = self.encoded_size(&target)?;
+        data.reserve_exact(size);
+        let start = data.len();
+        let mut encoder = DataEncoder::new(data);
+        match target.encode(&mut encoder) {
+            Result::Err(_) => {
+                data.truncate(start);
+                return Option::None;
+            },
+            _ => {},
+        }
+        self.size.set(size);
+        Option::Some(size)
+    }
+
+    /// Computes the size of the encoding of target without encoding it.
+    pub fn encoded_size< E: Serializable >(&self, target: &E) -> Option<usize> {
+        let mut encoder = DataSizeEncoder::new();
+        match target.encode(&mut encoder) {
+            Result::Err(_) => Option::None,
+            _ => Option::Some(encoder.size()),
+        }
+    }
+}
 ///  DeSerializeHelper make it easy to obtain deserialize function.
 pub struct DeSerializeHelper<'a, T:'a + ?Sized> {
     data: Vec<u8>,
@@ -1213,3 +1319,48 @@ impl<'a, T: 'a + ?Sized + DeSerializable> DeSerializeHelper<'a, T> {
         }
     }
 }
+
+///  BorrowDeSerializeHelper decodes types implementing DeSerializableBorrowed, whose
+///  strings and byte slices point into the encoded buffer instead of being copied.
+pub struct BorrowDeSerializeHelper<'de, T> {
+    data: &'de [u8],
+    marker: PhantomData<T>,
+}
+
+impl<'de, T: DeSerializableBorrowed<'de>> BorrowDeSerializeHelper<'de, T> {
+    /// Create a new instance of BorrowDeSerializeHelper over data returned by
+    /// SerializeHelper::encode.
+    ///
+    /// ```
+    /// struct Request<'a> {
+    ///     name: &'a str,
+    ///     body: &'a [u8],
+    /// }
+    /// impl<'de> DeSerializableBorrowed<'de> for Request<'de> {
+    ///     fn decode_borrowed<D: BorrowDecoder<'de>>(d: &mut D) -> Result<Request<'de>, D::Error> {
+    ///         Ok(Request {
+    ///             name: d.read_borrowed_str()?,
+    ///             body: d.read_borrowed_bytes()?,
+    ///         })
+    ///     }
+    /// }
+    /// let helper = BorrowDeSerializeHelper::<Request>::new(&data);
+    /// let request = helper.decode().unwrap();
+    /// ```
+    ///
+    pub fn new(data: &'de [u8]) -> BorrowDeSerializeHelper<'de, T> {
+        BorrowDeSerializeHelper {
+            data: data,
+            marker: PhantomData,
+        }
+    }
+
+    /// Use decode to deserialize self data. The result may borrow from the data.
+    pub fn decode(&self) -> Option<T> {
+        let mut decoder = DataDecoder::new(self.data, 0);
+        match DeSerializableBorrowed::decode_borrowed(&mut decoder) {
+            Result::Err(_) => Option::None,
+            Result::Ok(d) => Option::Some(d),
+        }
+    }
+}
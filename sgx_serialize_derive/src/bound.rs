@@ -43,3 +43,18 @@ pub fn without_defaults(generics: &syn::Generics) -> syn::Generics {
         ..generics.clone()
     }
 }
+
+// The generics of a `DeSerializableBorrowed` impl, with the lifetime of the
+// decoder's buffer first. A type with one lifetime borrows for that one, and
+// a type without gets a fresh one, as none of its fields borrow.
+pub fn with_borrow_lifetime(generics: &syn::Generics) -> Result<syn::Generics, String> {
+    match generics.lifetimes.len() {
+        0 => {
+            let mut generics = generics.clone();
+            generics.lifetimes.insert(0, syn::LifetimeDef::new("'__de"));
+            Ok(generics)
+        }
+        1 => Ok(generics.clone()),
+        _ => Err("DeSerializableBorrowed cannot be derived for types with more than one lifetime".to_string()),
+    }
+}
@@ -26,6 +26,7 @@ use quote::Tokens;
 use crate::internals::ast::{Body, Container, Field, Style, Variant};
 use crate::internals::{Ctxt};
 use crate::param::Parameters;
+use crate::bound;
 use crate::fragment::{Fragment, Stmts};
 
 pub fn expand_derive_deserialize(input: &syn::DeriveInput) -> Result<Tokens, String> {
@@ -37,7 +38,8 @@ pub fn expand_derive_deserialize(input: &syn::DeriveInput) -> Result<Tokens, Str
     let params = Parameters::new(&cont);
     let (impl_generics, ty_generics, where_clause) = params.generics.split_for_impl();
 
-    let body = Stmts(deserialize_body(&cont));
+    let decode = quote!(::sgx_serialize::DeSerializable::decode);
+    let body = Stmts(deserialize_body(&cont, &decode));
 
     let impl_block = quote! {
             impl #impl_generics ::sgx_serialize::DeSerializable for #ident #ty_generics #where_clause {
@@ -51,29 +53,58 @@ pub fn expand_derive_deserialize(input: &syn::DeriveInput) -> Result<Tokens, Str
     Ok(impl_block)
 }
 
-fn deserialize_body(cont: &Container) -> Fragment {
+pub fn expand_derive_deserialize_borrowed(input: &syn::DeriveInput) -> Result<Tokens, String> {
+    let ctxt = Ctxt::new();
+    let cont = Container::from_ast(&ctxt, input);
+    ctxt.check()?;
+
+    let ident = &cont.ident;
+    let params = Parameters::new(&cont);
+    let (_, ty_generics, where_clause) = params.generics.split_for_impl();
+    // Fields borrow from the decoder's buffer for the type's own lifetime.
+    let borrow_generics = bound::with_borrow_lifetime(&params.generics)?;
+    let de = &borrow_generics.lifetimes[0].lifetime;
+    let (impl_generics, _, _) = borrow_generics.split_for_impl();
+
+    let decode = quote!(::sgx_serialize::DeSerializableBorrowed::decode_borrowed);
+    let body = Stmts(deserialize_body(&cont, &decode));
+
+    let impl_block = quote! {
+            impl #impl_generics ::sgx_serialize::DeSerializableBorrowed<#de> for #ident #ty_generics #where_clause {
+                fn decode_borrowed<__D: ::sgx_serialize::BorrowDecoder<#de>>(__arg_0: &mut __D)
+                -> ::std::result::Result<#ident #ty_generics , __D::Error> {
+                    #body
+                }
+            }
+        };
+
+    Ok(impl_block)
+}
+
+// `decode` is the path of the function decoding each field.
+fn deserialize_body(cont: &Container, decode: &Tokens) -> Fragment {
 
     match cont.body {
             Body::Enum(ref variants) => {
-                deserialize_enum(cont, variants)
+                deserialize_enum(cont, variants, decode)
             }
             Body::Struct(Style::Struct, ref fields) => {
                 if fields.iter().any(|field| field.ident.is_none()) {
                     panic!("struct has unnamed fields");
                 }
-                deserialize_struct(cont, fields)
+                deserialize_struct(cont, fields, decode)
             }
             Body::Struct(Style::Tuple, ref fields) => {
                 if fields.iter().any(|field| field.ident.is_some()) {
                     panic!("tuple struct has named fields");
                 }
-                deserialize_tuple_struct(cont, fields)
+                deserialize_tuple_struct(cont, fields, decode)
             }
             Body::Struct(Style::Newtype, ref fields) => {
                 if fields.iter().any(|field| field.ident.is_some()) {
                     panic!("newtype struct has named fields");
                 }
-                deserialize_newtype_struct(cont)
+                deserialize_newtype_struct(cont, decode)
             }
             Body::Struct(Style::Unit, _) => {
                 deserialize_unit_struct(cont)
@@ -90,7 +121,8 @@ fn fromat_ident(name: &syn::Ident) -> syn::Ident {
 
 fn deserialize_enum(
     cont: &Container,
-    variants: &[Variant]
+    variants: &[Variant],
+    decode: &Tokens,
 ) -> Fragment {
     assert!(variants.len() as u64 <= u32::MAX as u64);
 
@@ -102,7 +134,7 @@ fn deserialize_enum(
         .enumerate()
         .map(
             |(variant_index, variant)| {
-                deserialize_variant(cont, variant, variant_index)
+                deserialize_variant(cont, variant, variant_index, decode)
             },
         )
         .collect();
@@ -132,7 +164,8 @@ fn deserialize_enum(
 fn deserialize_variant(
     cont: &Container,
     variant: &Variant,
-    variant_index: usize
+    variant_index: usize,
+    decode: &Tokens,
 ) -> Tokens {
     let this: syn::Ident = cont.ident.clone().into();
     let variant_ident = variant.ident.clone();
@@ -148,7 +181,7 @@ fn deserialize_variant(
         Style::Newtype => {
             quote! {
                 #variant_index => {
-                    #this::#variant_ident(match _d.read_enum_variant_arg(0usize, ::sgx_serialize::DeSerializable::decode) {
+                    #this::#variant_ident(match _d.read_enum_variant_arg(0usize, #decode) {
                             ::std::result::Result::Ok(__try_var) => __try_var,
                             ::std::result::Result::Err(__try_var) => {
                                 return ::std::result::Result::Err(__try_var)
@@ -164,7 +197,7 @@ fn deserialize_variant(
                 .map(
                     |(i, _)| -> _ {
                         quote! {
-                            match _d.read_enum_variant_arg(#i, ::sgx_serialize::DeSerializable::decode) {
+                            match _d.read_enum_variant_arg(#i, #decode) {
                                 ::std::result::Result::Ok(__try_var) => __try_var,
                                 ::std::result::Result::Err(__try_var) =>
                                 return ::std::result::Result::Err(__try_var),
@@ -199,7 +232,7 @@ fn deserialize_variant(
                 .map(
                     |(i, _)| -> _ {
                         quote! {
-                            match _d.read_enum_variant_arg(#i, ::sgx_serialize::DeSerializable::decode) {
+                            match _d.read_enum_variant_arg(#i, #decode) {
                                 ::std::result::Result::Ok(__try_var) => __try_var,
                                 ::std::result::Result::Err(__try_var) =>
                                 return ::std::result::Result::Err(__try_var),
@@ -226,7 +259,8 @@ fn deserialize_variant(
 
 fn deserialize_struct(
     cont: &Container,
-    fields: &[Field]
+    fields: &[Field],
+    decode: &Tokens,
 )  -> Fragment {
     let name: syn::Ident = cont.ident.clone().into();
     let name_arg = fromat_ident(&name);
@@ -235,7 +269,8 @@ fn deserialize_struct(
 
     let serialize_stmts = deserialize_tuple_struct_visitor(
         fields,
-        true
+        true,
+        decode,
     );
 
     quote_block! {
@@ -253,6 +288,7 @@ fn deserialize_struct(
 fn deserialize_tuple_struct(
     cont: &Container,
     fields: &[Field],
+    decode: &Tokens,
 ) -> Fragment {
     let name: syn::Ident = cont.ident.clone().into();
     let name_arg = fromat_ident(&name);
@@ -261,7 +297,8 @@ fn deserialize_tuple_struct(
 
     let deserialize_stmts = deserialize_tuple_struct_visitor(
         fields,
-        false
+        false,
+        decode,
     );
 
     quote_block! {
@@ -280,6 +317,7 @@ fn deserialize_tuple_struct(
 fn deserialize_tuple_struct_visitor(
     fields: &[Field],
     is_struct: bool,
+    decode: &Tokens,
 ) -> Vec<Tokens> {
     fields
         .iter()
@@ -306,7 +344,7 @@ fn deserialize_tuple_struct_visitor(
                         #name:
                             match _d.read_struct_field(#field_expr,
                                 #i,
-                                ::sgx_serialize::DeSerializable::decode) {
+                                #decode) {
                             ::std::result::Result::Ok(__try_var) => __try_var,
                             ::std::result::Result::Err(__try_var) => return ::std::result::Result::Err(__try_var),
                         }
@@ -316,7 +354,7 @@ fn deserialize_tuple_struct_visitor(
                     quote! {
                         match _d.read_struct_field(#field_expr,
                                 #i,
-                                ::sgx_serialize::DeSerializable::decode) {
+                                #decode) {
                             ::std::result::Result::Ok(__try_var) => __try_var,
                             ::std::result::Result::Err(__try_var) => return ::std::result::Result::Err(__try_var),
                         }
@@ -328,7 +366,8 @@ fn deserialize_tuple_struct_visitor(
 }
 
 fn deserialize_newtype_struct(
-    cont: &Container
+    cont: &Container,
+    decode: &Tokens,
 ) -> Fragment {
     let name: syn::Ident = cont.ident.clone().into();
     let name_arg = fromat_ident(&name);
@@ -340,7 +379,7 @@ fn deserialize_newtype_struct(
                                         match _d.read_struct_field(
                                                 "_field0",
                                                 0usize,
-                                                ::sgx_serialize::DeSerializable::decode){
+                                                #decode){
                                             ::std::result::Result::Ok(__try_var) => __try_var,
                                             ::std::result::Result::Err(__try_var) => {
                                                 return ::std::result::Result::Err(__try_var)
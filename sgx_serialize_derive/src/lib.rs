@@ -15,11 +15,11 @@
 // specific language governing permissions and limitations
 // under the License..
 
-//! This crate provides sgx_serialize's two derive macros.
+//! This crate provides sgx_serialize's derive macros.
 //!
 //! ```rust,ignore
 //! extern crate sgx_tstd as std; // Must do that!
-//! #[derive(Serializable, DeSerializable)]
+//! #[derive(Serializable, DeSerializable, DeSerializableBorrowed)]
 //! ```
 //!
 
@@ -75,3 +75,18 @@ pub fn derive_deserialize(input: TokenStream) -> TokenStream {
         Err(msg) => panic!(msg),
     }
 }
+
+/// `derive_deserialize_borrowed` provides the `DeSerializableBorrowed` macro
+/// for `sgx_serialize`.
+///
+/// The decoded value borrows its `&str` and `&[u8]` fields from the buffer
+/// being decoded, for the lifetime of the type, which may have at most one.
+#[proc_macro_derive(DeSerializableBorrowed, attributes(sgx_serialize))]
+pub fn derive_deserialize_borrowed(input: TokenStream) -> TokenStream {
+
+    let input = syn::parse_derive_input(&input.to_string()).unwrap();
+    match decode::expand_derive_deserialize_borrowed(&input) {
+        Ok(expanded) => expanded.parse().unwrap(),
+        Err(msg) => panic!(msg),
+    }
+}
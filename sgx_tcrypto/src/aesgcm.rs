@@ -0,0 +1,616 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Multi-buffer AES-GCM.
+//!
+//! Every `rsgx_rijndael128GCM_encrypt` call sets up a fresh IPP context,
+//! which costs more than encrypting a small message. The batch functions
+//! here run many messages through one AES-NI/PCLMULQDQ kernel instead. Up
+//! to `LANES` messages are in flight at once, and the counter blocks of all
+//! of them go through the AES rounds together, so independent `aesenc`
+//! instructions fill the pipeline even when every message is only a few
+//! blocks long. Messages in one batch that borrow the same key share its
+//! key schedule. Keys are matched by address and never by value, so the
+//! timing does not show whether two different key buffers hold equal keys.
+//!
+//! Without AES-NI and PCLMULQDQ the batch functions fall back to one call
+//! into the C library per message.
+
+use core::arch::x86_64::*;
+use core::marker::PhantomData;
+use core::mem;
+use core::ptr;
+use core::slice;
+use core::sync::atomic::{compiler_fence, Ordering};
+use sgx_types::cpu_feature::*;
+use sgx_types::*;
+
+// Messages processed side by side.
+const LANES: usize = 4;
+// Counter blocks encrypted together.
+const PAR_BLOCKS: usize = 8;
+const BLOCK: usize = 16;
+const ROUND_KEYS: usize = 11;
+
+const REQUIRED_FEATURES: u64 =
+    CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE4_1 | CPU_FEATURE_AES | CPU_FEATURE_PCLMULQDQ;
+
+extern "C" {
+    static g_cpu_feature_indicator: uint64_t;
+}
+
+fn has_aesni() -> bool {
+    unsafe { g_cpu_feature_indicator & REQUIRED_FEATURES == REQUIRED_FEATURES }
+}
+
+enum Mac<'a> {
+    Out(&'a mut sgx_aes_gcm_128bit_tag_t),
+    In(&'a sgx_aes_gcm_128bit_tag_t),
+}
+
+///
+/// One message of an AES-GCM batch.
+///
+/// A job encrypts or decrypts `src` into `dst`, or a single buffer in
+/// place. Run jobs with `rsgx_rijndael128GCM_batch`, then check the
+/// outcome of each with `status`.
+///
+pub struct SgxAesGcmJob<'a> {
+    key: &'a sgx_aes_gcm_128bit_key_t,
+    iv: &'a [u8],
+    aad: &'a [u8],
+    src: *const u8,
+    dst: *mut u8,
+    len: usize,
+    mac: Mac<'a>,
+    status: sgx_status_t,
+    marker: PhantomData<&'a mut [u8]>,
+}
+
+impl<'a> SgxAesGcmJob<'a> {
+    ///
+    /// Encrypts `src` into `dst` and writes the tag into `mac`.
+    ///
+    /// The parameters are those of `rsgx_rijndael128GCM_encrypt`.
+    ///
+    /// # Errors
+    ///
+    /// **SGX_ERROR_INVALID_PARAMETER**
+    ///
+    /// If both source buffer and AAD buffer content are empty, if IV length
+    /// is not equal to 12 (bytes), or if `dst` is shorter than `src`.
+    ///
+    pub fn encrypt(
+        key: &'a sgx_aes_gcm_128bit_key_t,
+        src: &'a [u8],
+        iv: &'a [u8],
+        aad: &'a [u8],
+        dst: &'a mut [u8],
+        mac: &'a mut sgx_aes_gcm_128bit_tag_t,
+    ) -> SgxResult<Self> {
+        if dst.len() < src.len() {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        Self::new(key, iv, aad, src.as_ptr(), dst.as_mut_ptr(), src.len(), Mac::Out(mac))
+    }
+
+    ///
+    /// Encrypts `buf` in place and writes the tag into `mac`.
+    ///
+    pub fn encrypt_in_place(
+        key: &'a sgx_aes_gcm_128bit_key_t,
+        buf: &'a mut [u8],
+        iv: &'a [u8],
+        aad: &'a [u8],
+        mac: &'a mut sgx_aes_gcm_128bit_tag_t,
+    ) -> SgxResult<Self> {
+        Self::new(key, iv, aad, buf.as_ptr(), buf.as_mut_ptr(), buf.len(), Mac::Out(mac))
+    }
+
+    ///
+    /// Decrypts `src` into `dst` and checks it against `mac`.
+    ///
+    /// The parameters are those of `rsgx_rijndael128GCM_decrypt`.
+    ///
+    pub fn decrypt(
+        key: &'a sgx_aes_gcm_128bit_key_t,
+        src: &'a [u8],
+        iv: &'a [u8],
+        aad: &'a [u8],
+        mac: &'a sgx_aes_gcm_128bit_tag_t,
+        dst: &'a mut [u8],
+    ) -> SgxResult<Self> {
+        if dst.len() < src.len() {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        Self::new(key, iv, aad, src.as_ptr(), dst.as_mut_ptr(), src.len(), Mac::In(mac))
+    }
+
+    ///
+    /// Decrypts `buf` in place and checks it against `mac`.
+    ///
+    pub fn decrypt_in_place(
+        key: &'a sgx_aes_gcm_128bit_key_t,
+        buf: &'a mut [u8],
+        iv: &'a [u8],
+        aad: &'a [u8],
+        mac: &'a sgx_aes_gcm_128bit_tag_t,
+    ) -> SgxResult<Self> {
+        Self::new(key, iv, aad, buf.as_ptr(), buf.as_mut_ptr(), buf.len(), Mac::In(mac))
+    }
+
+    fn new(
+        key: &'a sgx_aes_gcm_128bit_key_t,
+        iv: &'a [u8],
+        aad: &'a [u8],
+        src: *const u8,
+        dst: *mut u8,
+        len: usize,
+        mac: Mac<'a>,
+    ) -> SgxResult<Self> {
+        if len > u32::MAX as usize || aad.len() > u32::MAX as usize {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if iv.len() != SGX_AESGCM_IV_SIZE {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if len == 0 && aad.is_empty() {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        Ok(SgxAesGcmJob {
+            key,
+            iv,
+            aad,
+            src,
+            dst,
+            len,
+            mac,
+            status: sgx_status_t::SGX_ERROR_UNEXPECTED,
+            marker: PhantomData,
+        })
+    }
+
+    ///
+    /// Returns the outcome of the job: `SGX_SUCCESS`, or the error the
+    /// single-message function would have returned.
+    ///
+    pub fn status(&self) -> sgx_status_t {
+        self.status
+    }
+
+    fn is_decrypt(&self) -> bool {
+        match self.mac {
+            Mac::In(_) => true,
+            Mac::Out(_) => false,
+        }
+    }
+
+    fn src(&self) -> &[u8] {
+        unsafe { slice::from_raw_parts(self.src, self.len) }
+    }
+
+    fn dst(&mut self) -> &mut [u8] {
+        unsafe { slice::from_raw_parts_mut(self.dst, self.len) }
+    }
+}
+
+///
+/// Runs a batch of AES-GCM jobs.
+///
+/// Each job gives the same result as the corresponding call to
+/// `rsgx_rijndael128GCM_encrypt` or `rsgx_rijndael128GCM_decrypt`; the
+/// result is available from `SgxAesGcmJob::status`. A job that fails to
+/// decrypt has its output cleared.
+///
+/// # Errors
+///
+/// The first error of any job, after all jobs have run.
+///
+pub fn rsgx_rijndael128GCM_batch(jobs: &mut [SgxAesGcmJob]) -> SgxError {
+    if has_aesni() {
+        for group in jobs.chunks_mut(LANES) {
+            unsafe { kernel::run(group) };
+        }
+    } else {
+        for job in jobs.iter_mut() {
+            run_c(job);
+        }
+    }
+    match jobs.iter().find(|job| job.status != sgx_status_t::SGX_SUCCESS) {
+        Some(job) => Err(job.status),
+        None => Ok(()),
+    }
+}
+
+///
+/// Encrypts `buf` in place, as `rsgx_rijndael128GCM_encrypt` would encrypt
+/// it into a separate buffer.
+///
+pub fn rsgx_rijndael128GCM_encrypt_in_place(
+    key: &sgx_aes_gcm_128bit_key_t,
+    buf: &mut [u8],
+    iv: &[u8],
+    aad: &[u8],
+    mac: &mut sgx_aes_gcm_128bit_tag_t,
+) -> SgxError {
+    let mut jobs = [SgxAesGcmJob::encrypt_in_place(key, buf, iv, aad, mac)?];
+    rsgx_rijndael128GCM_batch(&mut jobs)
+}
+
+///
+/// Decrypts `buf` in place, as `rsgx_rijndael128GCM_decrypt` would decrypt
+/// it into a separate buffer. On error `buf` is cleared.
+///
+pub fn rsgx_rijndael128GCM_decrypt_in_place(
+    key: &sgx_aes_gcm_128bit_key_t,
+    buf: &mut [u8],
+    iv: &[u8],
+    aad: &[u8],
+    mac: &sgx_aes_gcm_128bit_tag_t,
+) -> SgxError {
+    let mut jobs = [SgxAesGcmJob::decrypt_in_place(key, buf, iv, aad, mac)?];
+    rsgx_rijndael128GCM_batch(&mut jobs)
+}
+
+fn clear(buf: &mut [u8]) {
+    for b in buf.iter_mut() {
+        unsafe { ptr::write_volatile(b, 0) };
+    }
+    compiler_fence(Ordering::SeqCst);
+}
+
+// The C library works in place as well, so both kinds of job go through
+// the raw functions.
+fn run_c(job: &mut SgxAesGcmJob) {
+    let len = job.len as u32;
+    let (p_src, p_dst) = if len != 0 {
+        (job.src, job.dst)
+    } else {
+        (ptr::null(), ptr::null_mut())
+    };
+    let p_aad = if !job.aad.is_empty() {
+        job.aad.as_ptr()
+    } else {
+        ptr::null()
+    };
+    let aad_len = job.aad.len() as u32;
+    let ret = unsafe {
+        match job.mac {
+            Mac::Out(ref mut mac) => sgx_rijndael128GCM_encrypt(
+                job.key as *const sgx_aes_gcm_128bit_key_t,
+                p_src,
+                len,
+                p_dst,
+                job.iv.as_ptr(),
+                SGX_AESGCM_IV_SIZE as u32,
+                p_aad,
+                aad_len,
+                &mut **mac as *mut sgx_aes_gcm_128bit_tag_t,
+            ),
+            Mac::In(mac) => sgx_rijndael128GCM_decrypt(
+                job.key as *const sgx_aes_gcm_128bit_key_t,
+                p_src,
+                len,
+                p_dst,
+                job.iv.as_ptr(),
+                SGX_AESGCM_IV_SIZE as u32,
+                p_aad,
+                aad_len,
+                mac as *const sgx_aes_gcm_128bit_tag_t,
+            ),
+        }
+    };
+    if ret != sgx_status_t::SGX_SUCCESS && job.is_decrypt() {
+        clear(job.dst());
+    }
+    job.status = ret;
+}
+
+mod kernel {
+    use super::*;
+
+    // Per-message state. Blocks are kept byte-reversed, the order GHASH
+    // multiplies in.
+    struct Lane {
+        keys: usize,
+        h: __m128i,
+        counter: __m128i,
+        next: u32,
+        tag_mask: __m128i,
+        ghash: __m128i,
+        blocks: usize,
+    }
+
+    #[inline(always)]
+    unsafe fn bswap_mask() -> __m128i {
+        _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+    }
+
+    macro_rules! expand_round {
+        ($keys:expr, $i:expr, $rcon:expr) => {{
+            let prev = $keys[$i - 1];
+            let mut t = _mm_aeskeygenassist_si128(prev, $rcon);
+            t = _mm_shuffle_epi32(t, 0xff);
+            let mut k = prev;
+            k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+            k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+            k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+            $keys[$i] = _mm_xor_si128(k, t);
+        }};
+    }
+
+    #[target_feature(enable = "aes,sse2")]
+    unsafe fn expand_key(key: &sgx_aes_gcm_128bit_key_t, keys: &mut [__m128i; ROUND_KEYS]) {
+        keys[0] = _mm_loadu_si128(key.as_ptr() as *const __m128i);
+        expand_round!(keys, 1, 0x01);
+        expand_round!(keys, 2, 0x02);
+        expand_round!(keys, 3, 0x04);
+        expand_round!(keys, 4, 0x08);
+        expand_round!(keys, 5, 0x10);
+        expand_round!(keys, 6, 0x20);
+        expand_round!(keys, 7, 0x40);
+        expand_round!(keys, 8, 0x80);
+        expand_round!(keys, 9, 0x1b);
+        expand_round!(keys, 10, 0x36);
+    }
+
+    // Encrypts `n` blocks, each with its own key schedule, round by round so
+    // that the rounds of different blocks overlap in the pipeline.
+    #[target_feature(enable = "aes,sse2")]
+    unsafe fn encrypt_blocks(
+        schedules: &[[__m128i; ROUND_KEYS]],
+        keys: &[usize; PAR_BLOCKS],
+        blocks: &mut [__m128i; PAR_BLOCKS],
+        n: usize,
+    ) {
+        for j in 0..n {
+            blocks[j] = _mm_xor_si128(blocks[j], schedules[keys[j]][0]);
+        }
+        for round in 1..ROUND_KEYS - 1 {
+            for j in 0..n {
+                blocks[j] = _mm_aesenc_si128(blocks[j], schedules[keys[j]][round]);
+            }
+        }
+        for j in 0..n {
+            blocks[j] = _mm_aesenclast_si128(blocks[j], schedules[keys[j]][ROUND_KEYS - 1]);
+        }
+    }
+
+    // Multiplication in GF(2^128) of byte-reversed operands, after Gueron
+    // and Kounavis, "Intel Carry-Less Multiplication Instruction and its
+    // Usage for Computing the GCM Mode".
+    #[target_feature(enable = "pclmulqdq,sse2")]
+    unsafe fn gfmul(a: __m128i, b: __m128i) -> __m128i {
+        let mut lo = _mm_clmulepi64_si128(a, b, 0x00);
+        let mut mid = _mm_clmulepi64_si128(a, b, 0x10);
+        let mid2 = _mm_clmulepi64_si128(a, b, 0x01);
+        let mut hi = _mm_clmulepi64_si128(a, b, 0x11);
+        mid = _mm_xor_si128(mid, mid2);
+        lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+        hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+        // Shift the 256-bit product left by one bit.
+        let lo_carry = _mm_srli_epi32(lo, 31);
+        let hi_carry = _mm_srli_epi32(hi, 31);
+        lo = _mm_slli_epi32(lo, 1);
+        hi = _mm_slli_epi32(hi, 1);
+        let cross = _mm_srli_si128(lo_carry, 12);
+        lo = _mm_or_si128(lo, _mm_slli_si128(lo_carry, 4));
+        hi = _mm_or_si128(hi, _mm_slli_si128(hi_carry, 4));
+        hi = _mm_or_si128(hi, cross);
+
+        // Reduce modulo x^128 + x^7 + x^2 + x + 1.
+        let mut t = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+        t = _mm_xor_si128(t, _mm_slli_epi32(lo, 25));
+        let t_hi = _mm_srli_si128(t, 4);
+        lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+        let mut r = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+        r = _mm_xor_si128(r, _mm_srli_epi32(lo, 7));
+        r = _mm_xor_si128(r, t_hi);
+        lo = _mm_xor_si128(lo, r);
+        _mm_xor_si128(hi, lo)
+    }
+
+    #[target_feature(enable = "ssse3,sse4.1")]
+    unsafe fn counter_block(counter: __m128i, n: u32) -> __m128i {
+        _mm_insert_epi32(counter, n.swap_bytes() as i32, 3)
+    }
+
+    // Loads up to 16 bytes, padding with zeros.
+    #[target_feature(enable = "sse2")]
+    unsafe fn load_partial(p: *const u8, len: usize) -> __m128i {
+        if len == BLOCK {
+            _mm_loadu_si128(p as *const __m128i)
+        } else {
+            let mut buf = [0_u8; BLOCK];
+            ptr::copy_nonoverlapping(p, buf.as_mut_ptr(), len);
+            _mm_loadu_si128(buf.as_ptr() as *const __m128i)
+        }
+    }
+
+    #[target_feature(enable = "sse2")]
+    unsafe fn store_partial(p: *mut u8, len: usize, v: __m128i) {
+        if len == BLOCK {
+            _mm_storeu_si128(p as *mut __m128i, v);
+        } else {
+            let mut buf = [0_u8; BLOCK];
+            _mm_storeu_si128(buf.as_mut_ptr() as *mut __m128i, v);
+            ptr::copy_nonoverlapping(buf.as_ptr(), p, len);
+        }
+    }
+
+    #[target_feature(enable = "pclmulqdq,ssse3")]
+    unsafe fn ghash(lane: &mut Lane, block: __m128i) {
+        let x = _mm_shuffle_epi8(block, bswap_mask());
+        lane.ghash = gfmul(_mm_xor_si128(lane.ghash, x), lane.h);
+    }
+
+    #[target_feature(enable = "aes,pclmulqdq,sse2,ssse3,sse4.1")]
+    pub unsafe fn run(jobs: &mut [SgxAesGcmJob]) {
+        let n = jobs.len();
+        debug_assert!(n <= LANES);
+        let mut schedules = [[_mm_setzero_si128(); ROUND_KEYS]; LANES];
+        let mut lanes: [Lane; LANES] = mem::zeroed();
+
+        // Key schedules, H = E(K, 0) and E(K, J0) for every lane.
+        let mut used = 0;
+        let mut keys = [0_usize; PAR_BLOCKS];
+        let mut blocks = [_mm_setzero_si128(); PAR_BLOCKS];
+        for (i, job) in jobs.iter().enumerate() {
+            // Compare addresses: comparing the key bytes with `==` would
+            // return early on the first difference and leak through timing
+            // whether two keys are equal.
+            let reuse = (0..i).find(|&k| ptr::eq(jobs[k].key, job.key));
+            let slot = match reuse {
+                Some(k) => lanes[k].keys,
+                None => {
+                    expand_key(job.key, &mut schedules[used]);
+                    used += 1;
+                    used - 1
+                }
+            };
+            let mut iv = [0_u8; BLOCK];
+            iv[..SGX_AESGCM_IV_SIZE].copy_from_slice(job.iv);
+            let counter = _mm_loadu_si128(iv.as_ptr() as *const __m128i);
+            lanes[i] = Lane {
+                keys: slot,
+                h: _mm_setzero_si128(),
+                counter,
+                next: 2,
+                tag_mask: _mm_setzero_si128(),
+                ghash: _mm_setzero_si128(),
+                blocks: (job.len + BLOCK - 1) / BLOCK,
+            };
+            keys[2 * i] = slot;
+            keys[2 * i + 1] = slot;
+            blocks[2 * i] = _mm_setzero_si128();
+            blocks[2 * i + 1] = counter_block(counter, 1);
+        }
+        encrypt_blocks(&schedules, &keys, &mut blocks, 2 * n);
+        for i in 0..n {
+            lanes[i].h = _mm_shuffle_epi8(blocks[2 * i], bswap_mask());
+            lanes[i].tag_mask = blocks[2 * i + 1];
+        }
+
+        // Additional data, one block per lane in turn.
+        let aad_blocks = jobs.iter().map(|j| (j.aad.len() + BLOCK - 1) / BLOCK).max().unwrap_or(0);
+        for b in 0..aad_blocks {
+            for i in 0..n {
+                let aad = jobs[i].aad;
+                let off = b * BLOCK;
+                if off < aad.len() {
+                    let len = core::cmp::min(BLOCK, aad.len() - off);
+                    ghash(&mut lanes[i], load_partial(aad.as_ptr().add(off), len));
+                }
+            }
+        }
+
+        // Payload: gather up to PAR_BLOCKS counter blocks round-robin over
+        // the lanes, encrypt them together, then apply them in order.
+        let mut done = [0_usize; LANES];
+        let mut owner = [0_usize; PAR_BLOCKS];
+        let mut index = [0_usize; PAR_BLOCKS];
+        loop {
+            let mut count = 0;
+            let mut progress = true;
+            while count < PAR_BLOCKS && progress {
+                progress = false;
+                for i in 0..n {
+                    if count < PAR_BLOCKS && done[i] < lanes[i].blocks {
+                        owner[count] = i;
+                        index[count] = done[i];
+                        keys[count] = lanes[i].keys;
+                        blocks[count] = counter_block(lanes[i].counter, lanes[i].next);
+                        lanes[i].next = lanes[i].next.wrapping_add(1);
+                        done[i] += 1;
+                        count += 1;
+                        progress = true;
+                    }
+                }
+            }
+            if count == 0 {
+                break;
+            }
+            encrypt_blocks(&schedules, &keys, &mut blocks, count);
+            for j in 0..count {
+                let i = owner[j];
+                let job = &jobs[i];
+                let off = index[j] * BLOCK;
+                let len = core::cmp::min(BLOCK, job.len - off);
+                let input = load_partial(job.src.add(off), len);
+                let output = _mm_xor_si128(input, blocks[j]);
+                let cipher = if job.is_decrypt() { input } else { output };
+                // Bytes past the end of a partial block are not part of
+                // the ciphertext.
+                let cipher = if len == BLOCK {
+                    cipher
+                } else {
+                    let mut buf = [0_u8; BLOCK];
+                    _mm_storeu_si128(buf.as_mut_ptr() as *mut __m128i, cipher);
+                    for b in buf[len..].iter_mut() {
+                        *b = 0;
+                    }
+                    _mm_loadu_si128(buf.as_ptr() as *const __m128i)
+                };
+                ghash(&mut lanes[i], cipher);
+                store_partial(job.dst.add(off), len, output);
+            }
+        }
+
+        // Lengths block and tag.
+        for i in 0..n {
+            let job = &mut jobs[i];
+            let lengths = _mm_set_epi64x((job.aad.len() as i64) * 8, (job.len as i64) * 8);
+            let lane = &mut lanes[i];
+            lane.ghash = gfmul(_mm_xor_si128(lane.ghash, lengths), lane.h);
+            let tag = _mm_xor_si128(_mm_shuffle_epi8(lane.ghash, bswap_mask()), lane.tag_mask);
+            let mut computed = [0_u8; SGX_AESGCM_MAC_SIZE];
+            _mm_storeu_si128(computed.as_mut_ptr() as *mut __m128i, tag);
+
+            let status = match job.mac {
+                Mac::Out(ref mut mac) => {
+                    **mac = computed;
+                    sgx_status_t::SGX_SUCCESS
+                }
+                Mac::In(mac) => {
+                    let diff = mac.iter().zip(computed.iter()).fold(0_u8, |d, (a, b)| d | (a ^ b));
+                    if diff == 0 {
+                        sgx_status_t::SGX_SUCCESS
+                    } else {
+                        sgx_status_t::SGX_ERROR_MAC_MISMATCH
+                    }
+                }
+            };
+            if status != sgx_status_t::SGX_SUCCESS {
+                clear(job.dst());
+            }
+            job.status = status;
+        }
+
+        // Round keys and hash keys must not outlive the call.
+        for schedule in schedules.iter_mut() {
+            for k in schedule.iter_mut() {
+                ptr::write_volatile(k, _mm_setzero_si128());
+            }
+        }
+        for lane in lanes.iter_mut() {
+            ptr::write_volatile(&mut lane.h, _mm_setzero_si128());
+            ptr::write_volatile(&mut lane.tag_mask, _mm_setzero_si128());
+        }
+        compiler_fence(Ordering::SeqCst);
+    }
+}
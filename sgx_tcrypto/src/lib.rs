@@ -31,3 +31,6 @@ extern crate sgx_types;
 
 mod crypto;
 pub use self::crypto::*;
+
+mod aesgcm;
+pub use self::aesgcm::*;
@@ -0,0 +1,483 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Sealing many records with one seal key.
+//!
+//! `SgxSealedData::seal_data` derives a fresh seal key (EGETKEY) for every
+//! blob and seals it with an all-zero IV, which is only safe because the key
+//! is never used twice. A context derives the key once and gives every record
+//! its own IV instead: a record counter, stored in the `aes_data.reserved`
+//! field of the record header. After 2^32 records the context moves on to a
+//! new key ID, so a key never sees more IVs than AES-GCM allows.
+//!
+//! Records keep the `sgx_sealed_data_t` layout (header, encrypted text,
+//! additional text), so a record can be located and inspected like any other
+//! sealed blob. Because of the IV they can only be unsealed by a context.
+//! A context unseals plain `sgx_seal_data` blobs as well, whose IV is zero.
+
+use alloc::boxed::Box;
+use alloc::vec::Vec;
+use core::mem;
+use core::ptr;
+use sgx_tcrypto::*;
+use sgx_trts::trts::*;
+use sgx_types::*;
+
+use crate::internal::*;
+
+const UNSEAL_KEY_SLOTS: usize = 4;
+const MAX_RECORDS_PER_KEY: u64 = 1 << 32;
+
+struct RecordInfo {
+    header: sgx_sealed_data_t,
+    encrypt_len: usize,
+    additional_len: usize,
+    size: usize,
+}
+
+fn parse_record(sealed: &[u8]) -> SgxResult<RecordInfo> {
+    let header_size = mem::size_of::<sgx_sealed_data_t>();
+    if sealed.len() < header_size {
+        return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+    }
+    let header = unsafe { ptr::read_unaligned(sealed.as_ptr() as *const sgx_sealed_data_t) };
+
+    let payload_size = header.aes_data.payload_size;
+    let encrypt_len = header.plain_text_offset;
+    if encrypt_len > payload_size {
+        return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+    }
+    let additional_len = payload_size - encrypt_len;
+    let size = SgxInternalSealedData::calc_raw_sealed_data_size(additional_len, encrypt_len);
+    if size == u32::MAX || sealed.len() < size as usize {
+        return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+    }
+
+    Ok(RecordInfo {
+        header,
+        encrypt_len: encrypt_len as usize,
+        additional_len: additional_len as usize,
+        size: size as usize,
+    })
+}
+
+///
+/// A sealing context that derives each seal key once and reuses it.
+///
+/// The keys live in enclave memory owned by the context and are cleared when
+/// it is dropped. Output buffers are provided by the caller, so sealing and
+/// unsealing a record does not allocate.
+///
+pub struct SgxSealContext {
+    key_policy: u16,
+    attribute_mask: sgx_attributes_t,
+    misc_mask: sgx_misc_select_t,
+    seal_key: Option<Box<SgxSealKey>>,
+    counter: u64,
+    unseal_keys: Vec<Box<SgxSealKey>>,
+    next_victim: usize,
+}
+
+impl SgxSealContext {
+    ///
+    /// Creates a context with the key policy of `SgxSealedData::seal_data`.
+    ///
+    pub fn new() -> Self {
+        let (key_policy, attribute_mask) = default_key_policy();
+        SgxSealContext {
+            key_policy,
+            attribute_mask,
+            misc_mask: TSEAL_DEFAULT_MISCMASK,
+            seal_key: None,
+            counter: 0,
+            unseal_keys: Vec::with_capacity(UNSEAL_KEY_SLOTS),
+            next_victim: 0,
+        }
+    }
+
+    ///
+    /// Creates a context with the key policy of `SgxSealedData::seal_data_ex`.
+    ///
+    /// # Errors
+    ///
+    /// **SGX_ERROR_INVALID_PARAMETER**
+    ///
+    /// The key policy or the attribute mask is invalid, see `seal_data_ex`.
+    ///
+    pub fn new_ex(
+        key_policy: u16,
+        attribute_mask: sgx_attributes_t,
+        misc_mask: sgx_misc_select_t,
+    ) -> SgxResult<Self> {
+        check_key_policy(key_policy, attribute_mask)?;
+        let mut ctx = Self::new();
+        ctx.key_policy = key_policy;
+        ctx.attribute_mask = attribute_mask;
+        ctx.misc_mask = misc_mask;
+        Ok(ctx)
+    }
+
+    ///
+    /// Returns the key request of the current seal key, if one has been
+    /// derived yet.
+    ///
+    pub fn key_request(&self) -> Option<&sgx_key_request_t> {
+        self.seal_key.as_ref().map(|k| &k.key_request)
+    }
+
+    ///
+    /// Returns the size of the record sealing `encrypt_text_size` bytes with
+    /// `additional_text_size` bytes of additional text, or `u32::MAX` if it
+    /// would overflow.
+    ///
+    pub fn calc_sealed_size(additional_text_size: u32, encrypt_text_size: u32) -> u32 {
+        SgxInternalSealedData::calc_raw_sealed_data_size(additional_text_size, encrypt_text_size)
+    }
+
+    ///
+    /// Returns the additional text of the record at the start of `sealed`.
+    ///
+    pub fn get_additional_txt(sealed: &[u8]) -> Option<&[u8]> {
+        let info = parse_record(sealed).ok()?;
+        let start = mem::size_of::<sgx_sealed_data_t>() + info.encrypt_len;
+        Some(&sealed[start..start + info.additional_len])
+    }
+
+    ///
+    /// Returns the size of the record at the start of `sealed`.
+    ///
+    pub fn get_sealed_size(sealed: &[u8]) -> Option<usize> {
+        parse_record(sealed).ok().map(|info| info.size)
+    }
+
+    ///
+    /// Seals one record into `out`.
+    ///
+    /// # Parameters
+    ///
+    /// **additional_text**
+    ///
+    /// Additional text to authenticate but not encrypt. It may be inside or
+    /// outside the enclave.
+    ///
+    /// **encrypt_text**
+    ///
+    /// Text to encrypt. It must be within the enclave.
+    ///
+    /// **out**
+    ///
+    /// Receives the record. It may be inside or outside the enclave.
+    ///
+    /// # Return value
+    ///
+    /// The size of the record.
+    ///
+    /// # Errors
+    ///
+    /// **SGX_ERROR_INVALID_PARAMETER**
+    ///
+    /// A buffer is in the wrong place or `out` is too small.
+    ///
+    /// **SGX_ERROR_OUT_OF_MEMORY**
+    ///
+    /// The enclave is out of memory.
+    ///
+    /// **SGX_ERROR_UNEXPECTED**
+    ///
+    /// Deriving the seal key or encrypting failed.
+    ///
+    pub fn seal(&mut self, additional_text: &[u8], encrypt_text: &[u8], out: &mut [u8]) -> SgxResult<usize> {
+        let size = Self::check_seal_args(additional_text, encrypt_text)?;
+        if out.len() < size {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if !rsgx_slice_is_within_enclave(out) && !rsgx_slice_is_outside_enclave(out) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        self.seal_record(additional_text, encrypt_text, &mut out[..size])?;
+        Ok(size)
+    }
+
+    ///
+    /// Seals `(additional_text, encrypt_text)` records back to back into
+    /// `out`.
+    ///
+    /// All records are checked before any is sealed. If sealing fails part
+    /// way, the records already written stay valid but the call returns the
+    /// error.
+    ///
+    /// # Return value
+    ///
+    /// The number of bytes written.
+    ///
+    /// # Errors
+    ///
+    /// The same as `seal`.
+    ///
+    pub fn seal_many(&mut self, records: &[(&[u8], &[u8])], out: &mut [u8]) -> SgxResult<usize> {
+        let mut total: usize = 0;
+        for &(additional_text, encrypt_text) in records {
+            let size = Self::check_seal_args(additional_text, encrypt_text)?;
+            total = total
+                .checked_add(size)
+                .ok_or(sgx_status_t::SGX_ERROR_INVALID_PARAMETER)?;
+        }
+        if out.len() < total {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if !rsgx_slice_is_within_enclave(out) && !rsgx_slice_is_outside_enclave(out) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+
+        let mut offset = 0;
+        for &(additional_text, encrypt_text) in records {
+            let size = Self::calc_sealed_size(additional_text.len() as u32, encrypt_text.len() as u32) as usize;
+            self.seal_record(additional_text, encrypt_text, &mut out[offset..offset + size])?;
+            offset += size;
+        }
+        Ok(offset)
+    }
+
+    ///
+    /// Unseals the record at the start of `sealed` into `out`.
+    ///
+    /// # Parameters
+    ///
+    /// **sealed**
+    ///
+    /// The record. It must be within the enclave.
+    ///
+    /// **out**
+    ///
+    /// Receives the decrypted text. It must be within the enclave.
+    ///
+    /// # Return value
+    ///
+    /// The length of the decrypted text.
+    ///
+    /// # Errors
+    ///
+    /// **SGX_ERROR_INVALID_PARAMETER**
+    ///
+    /// A buffer is in the wrong place, the record is malformed or `out` is
+    /// too small.
+    ///
+    /// **SGX_ERROR_INVALID_CPUSVN**
+    ///
+    /// The CPUSVN in the record is beyond the platform CPUSVN value.
+    ///
+    /// **SGX_ERROR_INVALID_ISVSVN**
+    ///
+    /// The ISVSVN in the record is greater than the enclave ISVSVN.
+    ///
+    /// **SGX_ERROR_MAC_MISMATCH**
+    ///
+    /// The record cannot be authenticated.
+    ///
+    /// **SGX_ERROR_OUT_OF_MEMORY**
+    ///
+    /// The enclave is out of memory.
+    ///
+    pub fn unseal(&mut self, sealed: &[u8], out: &mut [u8]) -> SgxResult<usize> {
+        if !rsgx_slice_is_within_enclave(sealed) || !rsgx_slice_is_within_enclave(out) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let info = parse_record(sealed)?;
+        self.unseal_record(sealed, &info, out)?;
+        Ok(info.encrypt_len)
+    }
+
+    ///
+    /// Unseals the records stored back to back in `sealed`, writing their
+    /// decrypted texts back to back into `out` and their lengths into
+    /// `lens`.
+    ///
+    /// On error, the part of `out` written so far is cleared.
+    ///
+    /// # Return value
+    ///
+    /// The number of records.
+    ///
+    /// # Errors
+    ///
+    /// The same as `unseal`. `sealed` holding more records than `lens` has
+    /// room for is an **SGX_ERROR_INVALID_PARAMETER**.
+    ///
+    pub fn unseal_many(&mut self, sealed: &[u8], out: &mut [u8], lens: &mut [usize]) -> SgxResult<usize> {
+        if !rsgx_slice_is_within_enclave(sealed) || !rsgx_slice_is_within_enclave(out) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+
+        let mut offset = 0;
+        let mut written = 0;
+        let mut count = 0;
+        while offset < sealed.len() {
+            let result = if count < lens.len() {
+                parse_record(&sealed[offset..]).and_then(|info| {
+                    self.unseal_record(&sealed[offset..], &info, &mut out[written..])
+                        .map(|_| info)
+                })
+            } else {
+                Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER)
+            };
+            match result {
+                Ok(info) => {
+                    lens[count] = info.encrypt_len;
+                    offset += info.size;
+                    written += info.encrypt_len;
+                    count += 1;
+                }
+                Err(e) => {
+                    clear_bytes(&mut out[..written]);
+                    return Err(e);
+                }
+            }
+        }
+        Ok(count)
+    }
+
+    fn check_seal_args(additional_text: &[u8], encrypt_text: &[u8]) -> SgxResult<usize> {
+        let additional_len = additional_text.len();
+        let encrypt_len = encrypt_text.len();
+        if additional_len >= u32::MAX as usize || encrypt_len >= u32::MAX as usize {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let size = Self::calc_sealed_size(additional_len as u32, encrypt_len as u32);
+        if size == u32::MAX {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if encrypt_len == 0 && additional_len == 0 {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if !rsgx_slice_is_within_enclave(encrypt_text) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if additional_len > 0
+            && !rsgx_slice_is_within_enclave(additional_text)
+            && !rsgx_slice_is_outside_enclave(additional_text)
+        {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        Ok(size as usize)
+    }
+
+    // `out` is exactly the size of the record.
+    fn seal_record(&mut self, additional_text: &[u8], encrypt_text: &[u8], out: &mut [u8]) -> SgxError {
+        if self.seal_key.is_none() || self.counter >= MAX_RECORDS_PER_KEY {
+            self.rotate_seal_key()?;
+        }
+        let key = self.seal_key.as_ref().unwrap();
+
+        let mut payload_iv = [0_u8; SGX_SEAL_IV_SIZE];
+        payload_iv[..8].copy_from_slice(&self.counter.to_le_bytes());
+        self.counter += 1;
+
+        let header_size = mem::size_of::<sgx_sealed_data_t>();
+        let encrypt_len = encrypt_text.len();
+        let (header, payload) = out.split_at_mut(header_size);
+        let (encrypt, additional) = payload.split_at_mut(encrypt_len);
+
+        let mut payload_tag = [0_u8; SGX_SEAL_TAG_SIZE];
+        rsgx_rijndael128GCM_encrypt(
+            &key.key.key,
+            encrypt_text,
+            &payload_iv,
+            additional_text,
+            encrypt,
+            &mut payload_tag,
+        )?;
+        additional.copy_from_slice(additional_text);
+
+        let mut raw_header = sgx_sealed_data_t::default();
+        raw_header.key_request = key.key_request;
+        raw_header.plain_text_offset = encrypt_len as u32;
+        raw_header.aes_data.payload_size = (encrypt_len + additional_text.len()) as u32;
+        raw_header.aes_data.reserved = payload_iv;
+        raw_header.aes_data.payload_tag = payload_tag;
+        unsafe { ptr::write_unaligned(header.as_mut_ptr() as *mut sgx_sealed_data_t, raw_header) };
+
+        Ok(())
+    }
+
+    fn rotate_seal_key(&mut self) -> SgxError {
+        let key_request = new_key_request(self.key_policy, self.attribute_mask, self.misc_mask)?;
+        // The old key drops, and is cleared, here.
+        self.seal_key = Some(SgxSealKey::for_seal(&key_request)?);
+        self.counter = 0;
+        Ok(())
+    }
+
+    fn unseal_record(&mut self, sealed: &[u8], info: &RecordInfo, out: &mut [u8]) -> SgxError {
+        if out.len() < info.encrypt_len {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let key = self.unseal_key(&info.header.key_request)?;
+
+        //
+        // The record was only checked against lengths from its own header.
+        // Fence so a mispredicted check cannot have the crypto code read
+        // beyond it.
+        //
+        rsgx_lfence();
+
+        let header_size = mem::size_of::<sgx_sealed_data_t>();
+        let encrypt = &sealed[header_size..header_size + info.encrypt_len];
+        let additional = &sealed[header_size + info.encrypt_len..info.size];
+        let out = &mut out[..info.encrypt_len];
+
+        let result = rsgx_rijndael128GCM_decrypt(
+            &key.key.key,
+            encrypt,
+            &info.header.aes_data.reserved,
+            additional,
+            &info.header.aes_data.payload_tag,
+            out,
+        );
+        if result.is_err() {
+            clear_bytes(out);
+        }
+        result
+    }
+
+    fn unseal_key(&mut self, key_request: &sgx_key_request_t) -> SgxResult<&SgxSealKey> {
+        if self.seal_key.as_ref().map_or(false, |k| k.matches(key_request)) {
+            return Ok(self.seal_key.as_ref().unwrap());
+        }
+        let slot = match self.unseal_keys.iter().position(|k| k.matches(key_request)) {
+            Some(slot) => slot,
+            None => {
+                let cached = SgxSealKey::for_unseal(key_request)?;
+                if self.unseal_keys.len() < UNSEAL_KEY_SLOTS {
+                    self.unseal_keys.push(cached);
+                    self.unseal_keys.len() - 1
+                } else {
+                    let slot = self.next_victim;
+                    self.unseal_keys[slot] = cached;
+                    self.next_victim = (slot + 1) % UNSEAL_KEY_SLOTS;
+                    slot
+                }
+            }
+        };
+        Ok(&self.unseal_keys[slot])
+    }
+}
+
+impl Default for SgxSealContext {
+    fn default() -> Self {
+        Self::new()
+    }
+}
@@ -19,6 +19,8 @@ use alloc::boxed::Box;
 use alloc::vec::Vec;
 use core::mem;
 use core::ptr;
+use core::slice;
+use core::sync::atomic::{compiler_fence, Ordering};
 use sgx_tcrypto::*;
 use sgx_trts::trts::*;
 use sgx_tse::*;
@@ -266,19 +268,7 @@ impl SgxInternalSealedData {
     }
 
     pub fn seal_data(additional_text: &[u8], encrypt_text: &[u8]) -> SgxResult<Self> {
-        //let attribute_mask = sgx_attributes_t{flags: SGX_FLAGS_RESERVED | SGX_FLAGS_INITTED | SGX_FLAGS_DEBUG, xfrm: 0};
-        /* intel sgx sdk 1.8 */
-        let attribute_mask = sgx_attributes_t {
-            flags: TSEAL_DEFAULT_FLAGSMASK,
-            xfrm: 0,
-        };
-        /* intel sgx sdk 2.4 */
-        let mut key_policy = SGX_KEYPOLICY_MRSIGNER;
-        let report = rsgx_self_report();
-        if (report.body.attributes.flags & SGX_FLAGS_KSS) != 0 {
-            key_policy = SGX_KEYPOLICY_MRSIGNER | KEY_POLICY_KSS;
-        }
-
+        let (key_policy, attribute_mask) = default_key_policy();
         Self::seal_data_ex(
             key_policy,
             attribute_mask,
@@ -312,21 +302,7 @@ impl SgxInternalSealedData {
             return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
         }
 
-        if (key_policy
-            & (!(SGX_KEYPOLICY_MRENCLAVE
-                | SGX_KEYPOLICY_MRSIGNER
-                | KEY_POLICY_KSS
-                | SGX_KEYPOLICY_NOISVPRODID))
-            != 0)
-            || ((key_policy & (SGX_KEYPOLICY_MRENCLAVE | SGX_KEYPOLICY_MRSIGNER)) == 0)
-        {
-            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
-        }
-        if ((attribute_mask.flags & SGX_FLAGS_INITTED) == 0)
-            || ((attribute_mask.flags & SGX_FLAGS_DEBUG) == 0)
-        {
-            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
-        }
+        check_key_policy(key_policy, attribute_mask)?;
 
         if !rsgx_slice_is_within_enclave(encrypt_text) {
             return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
@@ -339,32 +315,7 @@ impl SgxInternalSealedData {
             return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
         }
 
-        //let target_info = sgx_target_info_t::default();
-        //let report_data = sgx_report_data_t::default();
-        let mut key_id = sgx_key_id_t::default();
-
-        /* intel sgx sdk 2.4 */
-        let mut report = rsgx_self_report();
-
-        let error = rsgx_read_rand(&mut key_id.id);
-        if error.is_err() {
-            report = sgx_report_t::default();
-            key_id = sgx_key_id_t::default();
-            return Err(error.unwrap_err());
-        }
-
-        let key_request = sgx_key_request_t {
-            key_name: SGX_KEYSELECT_SEAL,
-            key_policy,
-            isv_svn: report.body.isv_svn,
-            reserved1: 0_u16,
-            cpu_svn: report.body.cpu_svn,
-            attribute_mask,
-            key_id,
-            misc_mask,
-            config_svn: report.body.config_svn,
-            reserved2: [0_u8; SGX_KEY_REQUEST_RESERVED2_BYTES],
-        };
+        let key_request = new_key_request(key_policy, attribute_mask, misc_mask)?;
 
         let payload_iv = [0_u8; SGX_SEAL_IV_SIZE];
         let mut result =
@@ -374,9 +325,6 @@ impl SgxInternalSealedData {
             sealed_data.key_request = key_request
         };
 
-        report = sgx_report_t::default();
-        key_id = sgx_key_id_t::default();
-
         result
     }
 
@@ -410,17 +358,7 @@ impl SgxInternalSealedData {
     }
 
     pub fn mac_aadata(additional_text: &[u8]) -> SgxResult<Self> {
-        let attribute_mask = sgx_attributes_t {
-            flags: TSEAL_DEFAULT_FLAGSMASK,
-            xfrm: 0,
-        };
-        let mut key_policy: u16 = SGX_KEYPOLICY_MRSIGNER;
-        let report = rsgx_self_report();
-
-        if (report.body.attributes.flags & SGX_FLAGS_KSS) != 0 {
-            key_policy = SGX_KEYPOLICY_MRSIGNER | KEY_POLICY_KSS;
-        }
-
+        let (key_policy, attribute_mask) = default_key_policy();
         Self::mac_aadata_ex(
             key_policy,
             attribute_mask,
@@ -446,21 +384,7 @@ impl SgxInternalSealedData {
             return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
         }
 
-        if (key_policy
-            & (!(SGX_KEYPOLICY_MRENCLAVE
-                | SGX_KEYPOLICY_MRSIGNER
-                | KEY_POLICY_KSS
-                | SGX_KEYPOLICY_NOISVPRODID))
-            != 0)
-            || ((key_policy & (SGX_KEYPOLICY_MRENCLAVE | SGX_KEYPOLICY_MRSIGNER)) == 0)
-        {
-            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
-        }
-        if ((attribute_mask.flags & SGX_FLAGS_INITTED) == 0)
-            || ((attribute_mask.flags & SGX_FLAGS_DEBUG) == 0)
-        {
-            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
-        }
+        check_key_policy(key_policy, attribute_mask)?;
 
         if !rsgx_slice_is_within_enclave(additional_text)
             && !rsgx_slice_is_outside_enclave(additional_text)
@@ -468,32 +392,7 @@ impl SgxInternalSealedData {
             return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
         }
 
-        //let target_info = sgx_target_info_t::default();
-        //let report_data = sgx_report_data_t::default();
-        let mut key_id = sgx_key_id_t::default();
-
-        /* intel sgx sdk 2.4 */
-        let mut report = rsgx_self_report();
-
-        let error = rsgx_read_rand(&mut key_id.id);
-        if error.is_err() {
-            report = sgx_report_t::default();
-            key_id = sgx_key_id_t::default();
-            return Err(error.unwrap_err());
-        }
-
-        let key_request = sgx_key_request_t {
-            key_name: SGX_KEYSELECT_SEAL,
-            key_policy,
-            isv_svn: report.body.isv_svn,
-            reserved1: 0_u16,
-            cpu_svn: report.body.cpu_svn,
-            attribute_mask,
-            key_id,
-            misc_mask,
-            config_svn: report.body.config_svn,
-            reserved2: [0_u8; SGX_KEY_REQUEST_RESERVED2_BYTES],
-        };
+        let key_request = new_key_request(key_policy, attribute_mask, misc_mask)?;
 
         let payload_iv = [0_u8; SGX_SEAL_IV_SIZE];
         let mut result = Self::seal_data_iv(additional_text, &[0_u8; 0], &payload_iv, &key_request);
@@ -501,9 +400,6 @@ impl SgxInternalSealedData {
             sealed_data.key_request = key_request
         };
 
-        report = sgx_report_t::default();
-        key_id = sgx_key_id_t::default();
-
         result
     }
 
@@ -624,3 +520,153 @@ impl SgxInternalSealedData {
         Ok(unsealed_data)
     }
 }
+
+/// The key policy and attribute mask used by `seal_data` and `mac_aadata`.
+pub fn default_key_policy() -> (u16, sgx_attributes_t) {
+    //let attribute_mask = sgx_attributes_t{flags: SGX_FLAGS_RESERVED | SGX_FLAGS_INITTED | SGX_FLAGS_DEBUG, xfrm: 0};
+    /* intel sgx sdk 1.8 */
+    let attribute_mask = sgx_attributes_t {
+        flags: TSEAL_DEFAULT_FLAGSMASK,
+        xfrm: 0,
+    };
+    /* intel sgx sdk 2.4 */
+    let mut key_policy = SGX_KEYPOLICY_MRSIGNER;
+    let report = rsgx_self_report();
+    if (report.body.attributes.flags & SGX_FLAGS_KSS) != 0 {
+        key_policy = SGX_KEYPOLICY_MRSIGNER | KEY_POLICY_KSS;
+    }
+    (key_policy, attribute_mask)
+}
+
+pub fn check_key_policy(key_policy: u16, attribute_mask: sgx_attributes_t) -> SgxError {
+    if (key_policy
+        & (!(SGX_KEYPOLICY_MRENCLAVE
+            | SGX_KEYPOLICY_MRSIGNER
+            | KEY_POLICY_KSS
+            | SGX_KEYPOLICY_NOISVPRODID))
+        != 0)
+        || ((key_policy & (SGX_KEYPOLICY_MRENCLAVE | SGX_KEYPOLICY_MRSIGNER)) == 0)
+    {
+        return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+    }
+    if ((attribute_mask.flags & SGX_FLAGS_INITTED) == 0)
+        || ((attribute_mask.flags & SGX_FLAGS_DEBUG) == 0)
+    {
+        return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+    }
+    Ok(())
+}
+
+/// Builds a seal key request with a fresh random key ID.
+pub fn new_key_request(
+    key_policy: u16,
+    attribute_mask: sgx_attributes_t,
+    misc_mask: sgx_misc_select_t,
+) -> SgxResult<sgx_key_request_t> {
+    //let target_info = sgx_target_info_t::default();
+    //let report_data = sgx_report_data_t::default();
+    let mut key_id = sgx_key_id_t::default();
+
+    /* intel sgx sdk 2.4 */
+    let mut report = rsgx_self_report();
+
+    let error = rsgx_read_rand(&mut key_id.id);
+    if error.is_err() {
+        report = sgx_report_t::default();
+        key_id = sgx_key_id_t::default();
+        return Err(error.unwrap_err());
+    }
+
+    let key_request = sgx_key_request_t {
+        key_name: SGX_KEYSELECT_SEAL,
+        key_policy,
+        isv_svn: report.body.isv_svn,
+        reserved1: 0_u16,
+        cpu_svn: report.body.cpu_svn,
+        attribute_mask,
+        key_id,
+        misc_mask,
+        config_svn: report.body.config_svn,
+        reserved2: [0_u8; SGX_KEY_REQUEST_RESERVED2_BYTES],
+    };
+
+    report = sgx_report_t::default();
+    key_id = sgx_key_id_t::default();
+
+    Ok(key_request)
+}
+
+/// A derived seal key together with the request it was derived from. The
+/// key is cleared when dropped.
+pub struct SgxSealKey {
+    pub key_request: sgx_key_request_t,
+    pub key: sgx_align_key_128bit_t,
+}
+
+impl SgxSealKey {
+    /// Derives a key to seal with, failing as `seal_data` does.
+    pub fn for_seal(key_request: &sgx_key_request_t) -> SgxResult<Box<Self>> {
+        let key = rsgx_get_align_key(key_request).map_err(|ret| {
+            if ret != sgx_status_t::SGX_ERROR_OUT_OF_MEMORY {
+                sgx_status_t::SGX_ERROR_UNEXPECTED
+            } else {
+                ret
+            }
+        })?;
+        Ok(Box::new(SgxSealKey {
+            key_request: *key_request,
+            key,
+        }))
+    }
+
+    /// Derives a key to unseal with, failing as `unseal_data` does.
+    pub fn for_unseal(key_request: &sgx_key_request_t) -> SgxResult<Box<Self>> {
+        let key = rsgx_get_align_key(key_request).map_err(|ret| {
+            if (ret == sgx_status_t::SGX_ERROR_INVALID_CPUSVN)
+                || (ret == sgx_status_t::SGX_ERROR_INVALID_ISVSVN)
+                || (ret == sgx_status_t::SGX_ERROR_OUT_OF_MEMORY)
+            {
+                ret
+            } else {
+                sgx_status_t::SGX_ERROR_MAC_MISMATCH
+            }
+        })?;
+        Ok(Box::new(SgxSealKey {
+            key_request: *key_request,
+            key,
+        }))
+    }
+
+    pub fn matches(&self, key_request: &sgx_key_request_t) -> bool {
+        key_request_bytes(&self.key_request) == key_request_bytes(key_request)
+    }
+}
+
+impl Drop for SgxSealKey {
+    fn drop(&mut self) {
+        // Volatile writes, so the compiler cannot drop the clearing as a
+        // store to memory that is about to be freed.
+        let p = &mut self.key as *mut sgx_align_key_128bit_t as *mut u8;
+        for i in 0..mem::size_of::<sgx_align_key_128bit_t>() {
+            unsafe { ptr::write_volatile(p.add(i), 0) };
+        }
+        compiler_fence(Ordering::SeqCst);
+    }
+}
+
+pub fn key_request_bytes(key_request: &sgx_key_request_t) -> &[u8] {
+    unsafe {
+        slice::from_raw_parts(
+            key_request as *const sgx_key_request_t as *const u8,
+            mem::size_of::<sgx_key_request_t>(),
+        )
+    }
+}
+
+/// Clears a buffer that held plaintext.
+pub fn clear_bytes(buf: &mut [u8]) {
+    for b in buf.iter_mut() {
+        unsafe { ptr::write_volatile(b, 0) };
+    }
+    compiler_fence(Ordering::SeqCst);
+}
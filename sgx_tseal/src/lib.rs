@@ -90,4 +90,10 @@ pub use self::seal::{SgxSealedData, SgxUnsealedData};
 mod aad;
 pub use self::aad::SgxMacAadata;
 
+mod context;
+pub use self::context::SgxSealContext;
+
+mod stream;
+pub use self::stream::{SgxStreamSealer, SgxStreamUnsealer};
+
 mod internal;
@@ -0,0 +1,475 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Sealing a stream in fixed-size chunks.
+//!
+//! `SgxSealedData` needs the whole plaintext and ciphertext in enclave
+//! memory. A sealed stream is cut into chunks that are sealed and unsealed
+//! one at a time, so payloads of any size can be sealed with one chunk of
+//! memory, and any chunk can be unsealed on its own.
+//!
+//! The stream starts with a header, followed by the chunks:
+//!
+//! ```text
+//! header:  magic "SGXSEALS" | version: u32 | chunk_size: u32 |
+//!          key_request: sgx_key_request_t | tag: [u8; 16]
+//! chunk i: ciphertext: [u8; chunk_size] | tag: [u8; 16]
+//! ```
+//!
+//! Integers are little-endian. All chunks but the last hold exactly
+//! `chunk_size` bytes of plaintext; the last holds 0 to `chunk_size` bytes,
+//! and is always present. The header tag is a GMAC over the rest of the
+//! header.
+//!
+//! The stream has its own seal key (a fresh key ID), and the IV of chunk
+//! `i` is `i` as a u64 followed by a u32 that is 1 for the last chunk and 0
+//! otherwise. The last chunk also authenticates the total plaintext length
+//! and the number of chunks as additional text, so truncating, extending or
+//! reordering the stream is detected.
+
+use alloc::boxed::Box;
+use core::cmp;
+use core::convert::TryInto;
+use core::mem;
+use core::ptr;
+use sgx_tcrypto::*;
+use sgx_trts::trts::*;
+use sgx_types::*;
+
+use crate::internal::*;
+
+const MAGIC: [u8; 8] = *b"SGXSEALS";
+const VERSION: u32 = 1;
+const KEY_REQUEST_OFFSET: usize = 16;
+const TAG_OFFSET: usize = KEY_REQUEST_OFFSET + mem::size_of::<sgx_key_request_t>();
+const HEADER_SIZE: usize = TAG_OFFSET + SGX_SEAL_TAG_SIZE;
+// Never the IV of a chunk, whose last four bytes are 0 or 1.
+const HEADER_IV: [u8; SGX_SEAL_IV_SIZE] = [0xff; SGX_SEAL_IV_SIZE];
+const MAX_CHUNK_SIZE: usize = 0x0100_0000;
+
+fn chunk_iv(index: u64, last: bool) -> [u8; SGX_SEAL_IV_SIZE] {
+    let mut iv = [0_u8; SGX_SEAL_IV_SIZE];
+    iv[..8].copy_from_slice(&index.to_le_bytes());
+    iv[8..].copy_from_slice(&(last as u32).to_le_bytes());
+    iv
+}
+
+fn last_chunk_aad(total_len: u64, chunk_count: u64) -> [u8; 16] {
+    let mut aad = [0_u8; 16];
+    aad[..8].copy_from_slice(&total_len.to_le_bytes());
+    aad[8..].copy_from_slice(&chunk_count.to_le_bytes());
+    aad
+}
+
+///
+/// Seals a stream chunk by chunk.
+///
+/// Write `header` first, then the output of `seal_chunk` for every full
+/// chunk, and finally the output of `seal_final` for the rest.
+///
+pub struct SgxStreamSealer {
+    key: Box<SgxSealKey>,
+    header: [u8; HEADER_SIZE],
+    chunk_size: usize,
+    next_chunk: u64,
+    total_len: u64,
+    finished: bool,
+}
+
+impl SgxStreamSealer {
+    /// The size of the stream header.
+    pub const HEADER_SIZE: usize = HEADER_SIZE;
+    /// The bytes a sealed chunk adds to its plaintext.
+    pub const CHUNK_OVERHEAD: usize = SGX_SEAL_TAG_SIZE;
+    /// The largest chunk size.
+    pub const MAX_CHUNK_SIZE: usize = MAX_CHUNK_SIZE;
+
+    ///
+    /// Starts a stream of `chunk_size` byte chunks, sealed with the key
+    /// policy of `SgxSealedData::seal_data`.
+    ///
+    /// # Errors
+    ///
+    /// **SGX_ERROR_INVALID_PARAMETER**
+    ///
+    /// `chunk_size` is 0 or greater than `MAX_CHUNK_SIZE`.
+    ///
+    /// **SGX_ERROR_OUT_OF_MEMORY**
+    ///
+    /// The enclave is out of memory.
+    ///
+    /// **SGX_ERROR_UNEXPECTED**
+    ///
+    /// Deriving the seal key failed.
+    ///
+    pub fn new(chunk_size: usize) -> SgxResult<Self> {
+        let (key_policy, attribute_mask) = default_key_policy();
+        Self::new_ex(chunk_size, key_policy, attribute_mask, TSEAL_DEFAULT_MISCMASK)
+    }
+
+    ///
+    /// Starts a stream with the key policy of `SgxSealedData::seal_data_ex`.
+    ///
+    pub fn new_ex(
+        chunk_size: usize,
+        key_policy: u16,
+        attribute_mask: sgx_attributes_t,
+        misc_mask: sgx_misc_select_t,
+    ) -> SgxResult<Self> {
+        if chunk_size == 0 || chunk_size > MAX_CHUNK_SIZE {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        check_key_policy(key_policy, attribute_mask)?;
+        let key_request = new_key_request(key_policy, attribute_mask, misc_mask)?;
+        let key = SgxSealKey::for_seal(&key_request)?;
+
+        let mut header = [0_u8; HEADER_SIZE];
+        header[..8].copy_from_slice(&MAGIC);
+        header[8..12].copy_from_slice(&VERSION.to_le_bytes());
+        header[12..16].copy_from_slice(&(chunk_size as u32).to_le_bytes());
+        header[KEY_REQUEST_OFFSET..TAG_OFFSET].copy_from_slice(key_request_bytes(&key_request));
+        let mut tag = [0_u8; SGX_SEAL_TAG_SIZE];
+        rsgx_rijndael128GCM_encrypt(
+            &key.key.key,
+            &[0_u8; 0],
+            &HEADER_IV,
+            &header[..TAG_OFFSET],
+            &mut [0_u8; 0],
+            &mut tag,
+        )?;
+        header[TAG_OFFSET..].copy_from_slice(&tag);
+
+        Ok(SgxStreamSealer {
+            key,
+            header,
+            chunk_size,
+            next_chunk: 0,
+            total_len: 0,
+            finished: false,
+        })
+    }
+
+    /// Returns the stream header.
+    pub fn header(&self) -> &[u8] {
+        &self.header
+    }
+
+    pub fn chunk_size(&self) -> usize {
+        self.chunk_size
+    }
+
+    /// Returns the number of plaintext bytes sealed so far.
+    pub fn total_len(&self) -> u64 {
+        self.total_len
+    }
+
+    ///
+    /// Seals a chunk that is not the last one.
+    ///
+    /// # Parameters
+    ///
+    /// **encrypt_text**
+    ///
+    /// Exactly `chunk_size` bytes of plaintext. It must be within the
+    /// enclave.
+    ///
+    /// **out**
+    ///
+    /// Receives `chunk_size + CHUNK_OVERHEAD` bytes. It may be inside or
+    /// outside the enclave.
+    ///
+    /// # Return value
+    ///
+    /// The size of the sealed chunk.
+    ///
+    /// # Errors
+    ///
+    /// **SGX_ERROR_INVALID_PARAMETER**
+    ///
+    /// A buffer has the wrong size or is in the wrong place, or the stream
+    /// is already finished.
+    ///
+    pub fn seal_chunk(&mut self, encrypt_text: &[u8], out: &mut [u8]) -> SgxResult<usize> {
+        if encrypt_text.len() != self.chunk_size {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        self.seal(encrypt_text, out, false)
+    }
+
+    ///
+    /// Seals the last chunk, of up to `chunk_size` bytes, and finishes the
+    /// stream.
+    ///
+    /// # Return value
+    ///
+    /// The size of the sealed chunk.
+    ///
+    /// # Errors
+    ///
+    /// The same as `seal_chunk`.
+    ///
+    pub fn seal_final(&mut self, encrypt_text: &[u8], out: &mut [u8]) -> SgxResult<usize> {
+        if encrypt_text.len() > self.chunk_size {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        self.seal(encrypt_text, out, true)
+    }
+
+    fn seal(&mut self, encrypt_text: &[u8], out: &mut [u8], last: bool) -> SgxResult<usize> {
+        if self.finished {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let len = encrypt_text.len();
+        let size = len + SGX_SEAL_TAG_SIZE;
+        if out.len() < size {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if len > 0 && !rsgx_slice_is_within_enclave(encrypt_text) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let out = &mut out[..size];
+        if !rsgx_slice_is_within_enclave(out) && !rsgx_slice_is_outside_enclave(out) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let total_len = self
+            .total_len
+            .checked_add(len as u64)
+            .ok_or(sgx_status_t::SGX_ERROR_INVALID_PARAMETER)?;
+
+        let index = self.next_chunk;
+        let aad = last_chunk_aad(total_len, index + 1);
+        let aad = if last { &aad[..] } else { &aad[..0] };
+        let (encrypt, tag) = out.split_at_mut(len);
+        let mut payload_tag = [0_u8; SGX_SEAL_TAG_SIZE];
+        rsgx_rijndael128GCM_encrypt(
+            &self.key.key.key,
+            encrypt_text,
+            &chunk_iv(index, last),
+            aad,
+            encrypt,
+            &mut payload_tag,
+        )?;
+        tag.copy_from_slice(&payload_tag);
+
+        self.next_chunk += 1;
+        self.total_len = total_len;
+        self.finished = last;
+        Ok(size)
+    }
+}
+
+///
+/// Unseals the chunks of a sealed stream, in any order.
+///
+pub struct SgxStreamUnsealer {
+    key: Box<SgxSealKey>,
+    chunk_size: usize,
+    chunk_count: u64,
+    last_len: usize,
+}
+
+impl SgxStreamUnsealer {
+    pub const HEADER_SIZE: usize = HEADER_SIZE;
+    pub const CHUNK_OVERHEAD: usize = SGX_SEAL_TAG_SIZE;
+
+    ///
+    /// Checks the header of a sealed stream of `sealed_len` bytes, header
+    /// included.
+    ///
+    /// The chunk count and the plaintext length follow from `sealed_len`,
+    /// which comes from untrusted storage. They are authenticated by the
+    /// last chunk: unseal it before relying on them.
+    ///
+    /// # Parameters
+    ///
+    /// **header**
+    ///
+    /// The first `HEADER_SIZE` bytes of the stream. It must be within the
+    /// enclave.
+    ///
+    /// # Errors
+    ///
+    /// **SGX_ERROR_INVALID_PARAMETER**
+    ///
+    /// The header is malformed or `sealed_len` is not a possible size of the
+    /// stream.
+    ///
+    /// **SGX_ERROR_INVALID_CPUSVN**
+    ///
+    /// The CPUSVN in the header is beyond the platform CPUSVN value.
+    ///
+    /// **SGX_ERROR_INVALID_ISVSVN**
+    ///
+    /// The ISVSVN in the header is greater than the enclave ISVSVN.
+    ///
+    /// **SGX_ERROR_MAC_MISMATCH**
+    ///
+    /// The header cannot be authenticated.
+    ///
+    pub fn new(header: &[u8], sealed_len: u64) -> SgxResult<Self> {
+        if header.len() < HEADER_SIZE || !rsgx_slice_is_within_enclave(header) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let header = &header[..HEADER_SIZE];
+        if header[..8] != MAGIC || u32::from_le_bytes(header[8..12].try_into().unwrap()) != VERSION {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let chunk_size = u32::from_le_bytes(header[12..16].try_into().unwrap()) as usize;
+        if chunk_size == 0 || chunk_size > MAX_CHUNK_SIZE {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+
+        let key_request = unsafe {
+            ptr::read_unaligned(header[KEY_REQUEST_OFFSET..].as_ptr() as *const sgx_key_request_t)
+        };
+        let key = SgxSealKey::for_unseal(&key_request)?;
+        rsgx_lfence();
+        let mut tag = [0_u8; SGX_SEAL_TAG_SIZE];
+        tag.copy_from_slice(&header[TAG_OFFSET..]);
+        rsgx_rijndael128GCM_decrypt(
+            &key.key.key,
+            &[0_u8; 0],
+            &HEADER_IV,
+            &header[..TAG_OFFSET],
+            &tag,
+            &mut [0_u8; 0],
+        )?;
+
+        let body_len = sealed_len
+            .checked_sub(HEADER_SIZE as u64)
+            .ok_or(sgx_status_t::SGX_ERROR_INVALID_PARAMETER)?;
+        if body_len < SGX_SEAL_TAG_SIZE as u64 {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let stride = (chunk_size + SGX_SEAL_TAG_SIZE) as u64;
+        let chunk_count = (body_len + stride - 1) / stride;
+        let last_sealed = body_len - (chunk_count - 1) * stride;
+        if last_sealed < SGX_SEAL_TAG_SIZE as u64 {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+
+        Ok(SgxStreamUnsealer {
+            key,
+            chunk_size,
+            chunk_count,
+            last_len: last_sealed as usize - SGX_SEAL_TAG_SIZE,
+        })
+    }
+
+    pub fn chunk_size(&self) -> usize {
+        self.chunk_size
+    }
+
+    pub fn chunk_count(&self) -> u64 {
+        self.chunk_count
+    }
+
+    /// Returns the plaintext length of the whole stream.
+    pub fn total_len(&self) -> u64 {
+        (self.chunk_count - 1) * self.chunk_size as u64 + self.last_len as u64
+    }
+
+    /// Returns the plaintext length of chunk `index`.
+    pub fn chunk_len(&self, index: u64) -> usize {
+        if index + 1 == self.chunk_count {
+            self.last_len
+        } else {
+            self.chunk_size
+        }
+    }
+
+    /// Returns the offset of chunk `index` in the stream.
+    pub fn sealed_chunk_offset(&self, index: u64) -> u64 {
+        HEADER_SIZE as u64 + index * (self.chunk_size + SGX_SEAL_TAG_SIZE) as u64
+    }
+
+    /// Returns the sealed size of chunk `index`.
+    pub fn sealed_chunk_len(&self, index: u64) -> usize {
+        self.chunk_len(index) + SGX_SEAL_TAG_SIZE
+    }
+
+    /// Returns the index of the chunk holding plaintext offset `pos`.
+    pub fn chunk_index(&self, pos: u64) -> u64 {
+        cmp::min(pos / self.chunk_size as u64, self.chunk_count - 1)
+    }
+
+    ///
+    /// Unseals chunk `index`.
+    ///
+    /// # Parameters
+    ///
+    /// **sealed**
+    ///
+    /// The `sealed_chunk_len(index)` bytes of the chunk. It must be within
+    /// the enclave.
+    ///
+    /// **out**
+    ///
+    /// Receives the plaintext. It must be within the enclave.
+    ///
+    /// # Return value
+    ///
+    /// The length of the plaintext.
+    ///
+    /// # Errors
+    ///
+    /// **SGX_ERROR_INVALID_PARAMETER**
+    ///
+    /// `index` is out of range, or a buffer has the wrong size or is in the
+    /// wrong place.
+    ///
+    /// **SGX_ERROR_MAC_MISMATCH**
+    ///
+    /// The chunk cannot be authenticated. On the last chunk, this includes a
+    /// stream that was truncated or extended.
+    ///
+    pub fn unseal_chunk(&self, index: u64, sealed: &[u8], out: &mut [u8]) -> SgxResult<usize> {
+        if index >= self.chunk_count {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        let len = self.chunk_len(index);
+        if sealed.len() != len + SGX_SEAL_TAG_SIZE || out.len() < len {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+        if !rsgx_slice_is_within_enclave(sealed) || !rsgx_slice_is_within_enclave(out) {
+            return Err(sgx_status_t::SGX_ERROR_INVALID_PARAMETER);
+        }
+
+        let last = index + 1 == self.chunk_count;
+        let aad = last_chunk_aad(self.total_len(), self.chunk_count);
+        let aad = if last { &aad[..] } else { &aad[..0] };
+        let mut tag = [0_u8; SGX_SEAL_TAG_SIZE];
+        tag.copy_from_slice(&sealed[len..]);
+
+        rsgx_lfence();
+
+        let out = &mut out[..len];
+        let result = rsgx_rijndael128GCM_decrypt(
+            &self.key.key.key,
+            &sealed[..len],
+            &chunk_iv(index, last),
+            aad,
+            &tag,
+            out,
+        );
+        if let Err(e) = result {
+            clear_bytes(out);
+            return Err(e);
+        }
+        Ok(len)
+    }
+}
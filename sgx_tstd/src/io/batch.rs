@@ -0,0 +1,213 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+use crate::io;
+use crate::os::unix::io::AsRawFd;
+use crate::sys::batch as imp;
+use core::fmt;
+use alloc_crate::vec::Vec;
+
+/// A queue of file and socket operations carried out by an untrusted
+/// worker thread.
+///
+/// Every plain `read` or `send` leaves the enclave and comes back. An
+/// `IoBatch` instead writes requests to a ring in untrusted memory, where a
+/// worker thread started by the untrusted runtime picks them up. While the
+/// worker is busy or polling, queuing, submitting and reaping requests never
+/// leaves the enclave; one OCALL is made only to wake the worker after it
+/// has gone idle, or to block until results arrive.
+///
+/// Requests are identified by the [`BatchToken`] returned when they are
+/// queued. Completions are returned by [`wait`] and [`poll`] in the order
+/// the worker finished them. Payloads are copied through an untrusted data
+/// area, so neither the data written nor the data read is kept secret from
+/// the host.
+///
+/// The worker runs requests one after another. A request that blocks, such
+/// as a `recv` on a socket with no data, holds up every request behind it.
+///
+/// The enclave must import `sgx_batch.edl` to use this type.
+///
+/// [`wait`]: IoBatch::wait
+/// [`poll`]: IoBatch::poll
+///
+/// # Examples
+///
+/// ```no_run
+/// use std::io::IoBatch;
+/// use std::untrusted::fs::File;
+///
+/// fn main() -> std::io::Result<()> {
+///     let file = File::open("foo.txt")?;
+///     let mut batch = IoBatch::new()?;
+///     let head = batch.read_at(&file, 512, 0)?;
+///     let tail = batch.read_at(&file, 512, 4096)?;
+///     for completion in batch.wait(2)? {
+///         let len = completion.result()?;
+///         assert!(completion.token() == head || completion.token() == tail);
+///         assert_eq!(completion.data().len(), len);
+///     }
+///     Ok(())
+/// }
+/// ```
+pub struct IoBatch {
+    inner: imp::Ring,
+}
+
+/// Identifies a request queued on an [`IoBatch`].
+#[derive(Copy, Clone, Debug, PartialEq, Eq, Hash)]
+pub struct BatchToken(u64);
+
+/// The outcome of a request queued on an [`IoBatch`].
+pub struct BatchCompletion {
+    inner: imp::Completion,
+}
+
+impl IoBatch {
+    /// Creates a batch with room for 256 requests in flight and 256K of
+    /// payload, and starts its untrusted worker.
+    pub fn new() -> io::Result<IoBatch> {
+        IoBatch::with_capacity(imp::DEFAULT_ENTRIES, imp::DEFAULT_DATA_LEN)
+    }
+
+    /// Creates a batch with room for `entries` requests in flight, rounded
+    /// up to a power of two, and `data_len` bytes of payload.
+    ///
+    /// When either runs out, queuing another request first waits for all
+    /// requests in flight; their completions are kept for the next `wait`
+    /// or `poll`.
+    pub fn with_capacity(entries: usize, data_len: usize) -> io::Result<IoBatch> {
+        imp::Ring::new(entries, data_len).map(|inner| IoBatch { inner })
+    }
+
+    /// Queues a request doing nothing, which completes with `Ok(0)`.
+    pub fn nop(&mut self) -> io::Result<BatchToken> {
+        self.inner.nop().map(BatchToken)
+    }
+
+    /// Queues a read of up to `len` bytes at the current position of `fd`.
+    pub fn read<F: AsRawFd>(&mut self, fd: &F, len: usize) -> io::Result<BatchToken> {
+        self.inner.read(fd.as_raw_fd(), len).map(BatchToken)
+    }
+
+    /// Queues a read of up to `len` bytes at `offset`, leaving the file
+    /// position alone.
+    pub fn read_at<F: AsRawFd>(&mut self, fd: &F, len: usize, offset: u64) -> io::Result<BatchToken> {
+        self.inner.pread(fd.as_raw_fd(), len, offset as i64).map(BatchToken)
+    }
+
+    /// Queues a write of `buf` at the current position of `fd`. `buf` is
+    /// copied out before this returns.
+    pub fn write<F: AsRawFd>(&mut self, fd: &F, buf: &[u8]) -> io::Result<BatchToken> {
+        self.inner.write(fd.as_raw_fd(), buf).map(BatchToken)
+    }
+
+    /// Queues a write of `buf` at `offset`, leaving the file position alone.
+    pub fn write_at<F: AsRawFd>(&mut self, fd: &F, buf: &[u8], offset: u64) -> io::Result<BatchToken> {
+        self.inner.pwrite(fd.as_raw_fd(), buf, offset as i64).map(BatchToken)
+    }
+
+    /// Queues a `send` of `buf` on the socket `fd`.
+    pub fn send<F: AsRawFd>(&mut self, fd: &F, buf: &[u8]) -> io::Result<BatchToken> {
+        self.inner.send(fd.as_raw_fd(), buf, 0).map(BatchToken)
+    }
+
+    /// Queues a `recv` of up to `len` bytes on the socket `fd`.
+    pub fn recv<F: AsRawFd>(&mut self, fd: &F, len: usize) -> io::Result<BatchToken> {
+        self.inner.recv(fd.as_raw_fd(), len, 0).map(BatchToken)
+    }
+
+    /// Queues an `fsync` of `fd`.
+    pub fn sync_all<F: AsRawFd>(&mut self, fd: &F) -> io::Result<BatchToken> {
+        self.inner.fsync(fd.as_raw_fd()).map(BatchToken)
+    }
+
+    /// Queues an `fdatasync` of `fd`.
+    pub fn sync_data<F: AsRawFd>(&mut self, fd: &F) -> io::Result<BatchToken> {
+        self.inner.fdatasync(fd.as_raw_fd()).map(BatchToken)
+    }
+
+    /// Hands every queued request to the worker without waiting for any of
+    /// them.
+    pub fn submit(&mut self) -> io::Result<()> {
+        self.inner.submit()
+    }
+
+    /// Submits queued requests and returns the completions available,
+    /// blocking until there are at least `min_complete` of them or nothing
+    /// is left pending.
+    pub fn wait(&mut self, min_complete: usize) -> io::Result<Vec<BatchCompletion>> {
+        self.inner.wait(min_complete)?;
+        let mut completions = Vec::new();
+        while let Some(inner) = self.inner.take() {
+            completions.push(BatchCompletion { inner });
+        }
+        Ok(completions)
+    }
+
+    /// Submits queued requests and returns whatever has completed, without
+    /// blocking.
+    pub fn poll(&mut self) -> io::Result<Vec<BatchCompletion>> {
+        self.wait(0)
+    }
+
+    /// Returns the number of requests queued or running, plus completions
+    /// not yet returned.
+    pub fn pending(&self) -> usize {
+        self.inner.pending()
+    }
+}
+
+impl fmt::Debug for IoBatch {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("IoBatch").field("pending", &self.pending()).finish()
+    }
+}
+
+impl BatchCompletion {
+    /// Returns the token of the request this completes.
+    pub fn token(&self) -> BatchToken {
+        BatchToken(self.inner.token)
+    }
+
+    /// Returns the number of bytes transferred, or the error the request
+    /// failed with.
+    pub fn result(&self) -> io::Result<usize> {
+        self.inner.result.map_err(io::Error::from_raw_os_error)
+    }
+
+    /// Returns the bytes read by a `read`, `read_at` or `recv` request, and
+    /// an empty slice for anything else.
+    pub fn data(&self) -> &[u8] {
+        &self.inner.data
+    }
+
+    /// Consumes the completion, returning the bytes read.
+    pub fn into_data(self) -> Vec<u8> {
+        self.inner.data
+    }
+}
+
+impl fmt::Debug for BatchCompletion {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("BatchCompletion")
+            .field("token", &self.token())
+            .field("result", &self.result())
+            .field("len", &self.inner.data.len())
+            .finish()
+    }
+}
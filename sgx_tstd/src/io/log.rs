@@ -0,0 +1,242 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+use crate::io;
+use crate::os::unix::io::RawFd;
+use crate::sys::log as imp;
+use core::fmt;
+use core::ptr;
+use core::sync::atomic::{AtomicPtr, Ordering};
+use alloc_crate::string::String;
+use alloc_crate::sync::Arc;
+use sgx_trts::libc::ocall::{LOG_LEVEL_DEBUG, LOG_LEVEL_ERROR, LOG_LEVEL_INFO, LOG_LEVEL_PLAIN,
+                            LOG_LEVEL_TRACE, LOG_LEVEL_WARN, LOG_STREAM_DEFAULT};
+
+/// The severity of a record written to an [`AsyncLog`].
+#[derive(Copy, Clone, Debug, PartialEq, Eq, PartialOrd, Ord, Hash)]
+pub enum LogLevel {
+    Error,
+    Warn,
+    Info,
+    Debug,
+    Trace,
+}
+
+impl LogLevel {
+    fn raw(self) -> u8 {
+        match self {
+            LogLevel::Error => LOG_LEVEL_ERROR,
+            LogLevel::Warn => LOG_LEVEL_WARN,
+            LogLevel::Info => LOG_LEVEL_INFO,
+            LogLevel::Debug => LOG_LEVEL_DEBUG,
+            LogLevel::Trace => LOG_LEVEL_TRACE,
+        }
+    }
+}
+
+/// What an [`AsyncLog`] does with a record when its ring is full.
+#[derive(Copy, Clone, Debug, PartialEq, Eq)]
+pub enum LogOverflow {
+    /// Leave the record out and count it in [`LogStats::dropped`]. The
+    /// drainer reports the number of records dropped in the output.
+    Drop,
+    /// Wait until the drainer has made room.
+    Block,
+}
+
+/// Counters of an [`AsyncLog`].
+#[derive(Copy, Clone, Debug, Default, PartialEq, Eq)]
+pub struct LogStats {
+    /// Records queued for the drainer.
+    pub records: u64,
+    /// Payload bytes queued for the drainer.
+    pub bytes: u64,
+    /// Records left out because the ring was full.
+    pub dropped: u64,
+}
+
+/// A log whose records are written out by an untrusted drainer thread.
+///
+/// Every `println!` or write to `stdout()` is an OCALL of its own, made
+/// while holding the stdout lock. An `AsyncLog` instead appends records to
+/// a ring in untrusted memory, which any number of enclave threads can do
+/// at once without a lock and without leaving the enclave. A drainer thread
+/// started by the untrusted runtime writes the records to a host fd, with a
+/// level prefix and a line break for records written with [`log`]. The
+/// drainer is only woken by an OCALL once the ring is half full.
+///
+/// Records are visible to the host, like everything written to stdout.
+///
+/// The enclave must import `sgx_log.edl` to use this type.
+///
+/// [`log`]: AsyncLog::log
+///
+/// # Examples
+///
+/// ```no_run
+/// use std::io::{AsyncLog, LogLevel};
+/// use std::sync::Arc;
+///
+/// fn main() -> std::io::Result<()> {
+///     let log = Arc::new(AsyncLog::new()?);
+///     log.log(LogLevel::Info, format_args!("starting with {} workers", 4))?;
+///     // From now on `println!` and `eprintln!` go through the ring too.
+///     log.clone().capture_stdio();
+///     println!("hello");
+///     log.flush()
+/// }
+/// ```
+pub struct AsyncLog {
+    inner: imp::Ring,
+}
+
+/// Configures and creates an [`AsyncLog`].
+#[derive(Debug)]
+pub struct AsyncLogBuilder {
+    size: usize,
+    fd: RawFd,
+    overflow: LogOverflow,
+}
+
+impl Default for AsyncLogBuilder {
+    fn default() -> AsyncLogBuilder {
+        AsyncLogBuilder::new()
+    }
+}
+
+impl AsyncLogBuilder {
+    /// A 1M ring drained to the host's stdout, dropping records when full.
+    pub fn new() -> AsyncLogBuilder {
+        AsyncLogBuilder {
+            size: imp::DEFAULT_SIZE,
+            fd: 1,
+            overflow: LogOverflow::Drop,
+        }
+    }
+
+    /// Sets the size of the ring, rounded up to a power of two of at least
+    /// 4K. Records longer than half of it are cut into several.
+    pub fn size(mut self, size: usize) -> AsyncLogBuilder {
+        self.size = size;
+        self
+    }
+
+    /// Sets the host fd records are written to. Records captured from
+    /// `stdout()` and `stderr()` still go to the host's stdout and stderr.
+    pub fn fd(mut self, fd: RawFd) -> AsyncLogBuilder {
+        self.fd = fd;
+        self
+    }
+
+    /// Sets what happens to records when the ring is full.
+    pub fn overflow(mut self, overflow: LogOverflow) -> AsyncLogBuilder {
+        self.overflow = overflow;
+        self
+    }
+
+    /// Allocates the ring and starts the drainer.
+    pub fn build(self) -> io::Result<AsyncLog> {
+        let overflow = match self.overflow {
+            LogOverflow::Drop => imp::Overflow::Drop,
+            LogOverflow::Block => imp::Overflow::Block,
+        };
+        imp::Ring::new(self.size, self.fd, overflow).map(|inner| AsyncLog { inner })
+    }
+}
+
+static CAPTURED: AtomicPtr<AsyncLog> = AtomicPtr::new(ptr::null_mut());
+
+impl AsyncLog {
+    /// Creates a log with the defaults of [`AsyncLogBuilder::new`].
+    pub fn new() -> io::Result<AsyncLog> {
+        AsyncLogBuilder::new().build()
+    }
+
+    /// Formats `args` and queues them as one record at `level`.
+    pub fn log(&self, level: LogLevel, args: fmt::Arguments<'_>) -> io::Result<()> {
+        let mut msg = String::new();
+        fmt::write(&mut msg, args).map_err(|_| io::Error::new(io::ErrorKind::Other, "formatter error"))?;
+        self.log_str(level, &msg)
+    }
+
+    /// Queues `msg` as one record at `level`.
+    pub fn log_str(&self, level: LogLevel, msg: &str) -> io::Result<()> {
+        self.inner.append(LOG_STREAM_DEFAULT, level.raw(), msg.as_bytes()).map(drop)
+    }
+
+    /// Waits until the drainer has written out every record queued so far.
+    pub fn flush(&self) -> io::Result<()> {
+        self.inner.flush()
+    }
+
+    /// Returns the counters of this log.
+    pub fn stats(&self) -> LogStats {
+        let stats = self.inner.stats();
+        LogStats {
+            records: stats.records,
+            bytes: stats.bytes,
+            dropped: stats.dropped,
+        }
+    }
+
+    /// Sends everything written to `stdout()` and `stderr()`, including
+    /// `print!` and `eprint!`, through this log from now on. The log then
+    /// stays alive for the rest of the enclave's life. Returns `false` if
+    /// another log has already taken over.
+    pub fn capture_stdio(self: Arc<AsyncLog>) -> bool {
+        let raw = Arc::into_raw(self) as *mut AsyncLog;
+        match CAPTURED.compare_exchange(ptr::null_mut(), raw, Ordering::AcqRel, Ordering::Acquire) {
+            Ok(_) => true,
+            Err(_) => {
+                drop(unsafe { Arc::from_raw(raw) });
+                false
+            }
+        }
+    }
+
+    pub(crate) fn write_stream(&self, stream: u8, buf: &[u8]) -> io::Result<usize> {
+        self.inner.append(stream, LOG_LEVEL_PLAIN, buf)?;
+        Ok(buf.len())
+    }
+}
+
+/// Returns the log that took over stdio, if any.
+pub(crate) fn captured() -> Option<&'static AsyncLog> {
+    let log = CAPTURED.load(Ordering::Acquire);
+    if log.is_null() {
+        None
+    } else {
+        Some(unsafe { &*log })
+    }
+}
+
+/// Writes go out unprefixed as they are, like writes to stdout.
+impl io::Write for &AsyncLog {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        self.write_stream(LOG_STREAM_DEFAULT, buf)
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+impl fmt::Debug for AsyncLog {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("AsyncLog").field("stats", &self.stats()).finish()
+    }
+}
@@ -40,13 +40,21 @@ pub use self::stdio::{StderrLock, StdinLock, StdoutLock};
 #[cfg(feature = "stdio")]
 pub use self::stdio::{_eprint, _print};
 pub use self::util::{copy, empty, repeat, sink, Empty, Repeat, Sink};
+#[cfg(feature = "io_batch")]
+pub use self::batch::{BatchCompletion, BatchToken, IoBatch};
+#[cfg(feature = "async_log")]
+pub use self::log::{AsyncLog, AsyncLogBuilder, LogLevel, LogOverflow, LogStats};
 
 pub mod prelude;
+#[cfg(feature = "io_batch")]
+mod batch;
 mod buffered;
 mod cursor;
 mod error;
 mod impls;
 mod lazy;
+#[cfg(feature = "async_log")]
+pub(crate) mod log;
 #[cfg(feature = "stdio")]
 mod stdio;
 mod util;
@@ -136,6 +136,8 @@ pub use sgx_trts::{
 };
 
 extern crate sgx_tprotected_fs;
+#[cfg(feature = "seal")]
+extern crate sgx_tseal;
 extern crate sgx_libc;
 
 // The standard macros that are not built-in to the compiler.
@@ -199,6 +201,8 @@ pub mod env;
 pub mod error;
 pub mod ffi;
 pub mod sgxfs;
+#[cfg(feature = "seal")]
+pub mod sgxseal;
 #[cfg(feature = "untrusted_fs")]
 pub mod fs;
 pub mod io;
@@ -212,11 +216,7 @@ pub mod time;
 pub mod enclave;
 pub mod untrusted;
 
-pub mod task {
-    //! Types and Traits for working with asynchronous tasks.
-    #[doc(inline)]
-    pub use core::task::*;
-}
+pub mod task;
 
 pub mod future;
 
@@ -241,6 +241,9 @@ pub mod rt;
 #[cfg(feature = "backtrace")]
 pub mod backtrace;
 
+#[cfg(feature = "ocall_profile")]
+pub mod profile;
+
 pub use cpuid::*;
 pub use self::thread::{
     rsgx_thread_self,
@@ -0,0 +1,306 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+use sgx_trts::libc;
+use core::fmt;
+use core::future::Future;
+use core::mem;
+use core::pin::Pin;
+use core::task::{Context, Poll};
+use crate::io::{self, Read, Write};
+use crate::net::{Shutdown, SocketAddr, TcpListener, TcpStream, ToSocketAddrs};
+use crate::sys::net::Socket;
+use crate::sys_common::net as net_imp;
+use crate::sys_common::net::sockaddr_to_addr;
+use crate::sys_common::{AsInner, FromInner};
+use crate::task::executor::current_reactor;
+use crate::task::reactor::{Direction, Registration};
+
+/// A TCP socket server driven by the current thread's [`Executor`].
+///
+/// Must be created inside [`Executor::block_on`]; it stays registered with
+/// that executor's reactor for its whole lifetime.
+///
+/// [`Executor`]: ../task/struct.Executor.html
+/// [`Executor::block_on`]: ../task/struct.Executor.html#method.block_on
+pub struct AsyncTcpListener {
+    registration: Registration,
+    inner: TcpListener,
+}
+
+impl AsyncTcpListener {
+    /// Creates a new listener bound to the specified address.
+    pub fn bind<A: ToSocketAddrs>(addr: A) -> io::Result<AsyncTcpListener> {
+        AsyncTcpListener::from_std(TcpListener::bind(addr)?)
+    }
+
+    /// Converts a blocking listener, switching it to non-blocking mode.
+    pub fn from_std(listener: TcpListener) -> io::Result<AsyncTcpListener> {
+        listener.set_nonblocking(true)?;
+        let registration = Registration::new(current_reactor()?, listener.as_inner().raw())?;
+        Ok(AsyncTcpListener { registration, inner: listener })
+    }
+
+    /// Accepts a new incoming connection.
+    ///
+    /// The returned stream is non-blocking and registered with the same
+    /// reactor as the listener.
+    pub fn accept(&self) -> Accept<'_> {
+        Accept { listener: self }
+    }
+
+    pub fn poll_accept(&self, cx: &mut Context<'_>) -> Poll<io::Result<(AsyncTcpStream, SocketAddr)>> {
+        let socket = self.inner.as_inner().socket();
+        let (sock, addr) = match self.registration.poll_io(cx, Direction::Read, || accept(socket)) {
+            Poll::Ready(Ok(res)) => res,
+            Poll::Ready(Err(e)) => return Poll::Ready(Err(e)),
+            Poll::Pending => return Poll::Pending,
+        };
+        let stream = TcpStream::from_inner(net_imp::TcpStream::from_inner(sock));
+        Poll::Ready(AsyncTcpStream::register(stream).map(|s| (s, addr)))
+    }
+
+    pub fn local_addr(&self) -> io::Result<SocketAddr> {
+        self.inner.local_addr()
+    }
+
+    /// Returns the underlying blocking listener.
+    pub fn get_ref(&self) -> &TcpListener {
+        &self.inner
+    }
+}
+
+fn accept(socket: &Socket) -> io::Result<(Socket, SocketAddr)> {
+    let mut storage: libc::sockaddr_storage = unsafe { mem::zeroed() };
+    let mut len = mem::size_of_val(&storage) as libc::socklen_t;
+    let sock = socket.accept_nonblocking(&mut storage as *mut _ as *mut _, &mut len)?;
+    let addr = sockaddr_to_addr(&storage, len as usize)?;
+    Ok((sock, addr))
+}
+
+impl fmt::Debug for AsyncTcpListener {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        self.inner.fmt(f)
+    }
+}
+
+/// A TCP stream driven by the current thread's [`Executor`].
+///
+/// Reads and writes are attempted directly and only park the task on the
+/// reactor when the socket reports `EWOULDBLOCK`.
+///
+/// [`Executor`]: ../task/struct.Executor.html
+pub struct AsyncTcpStream {
+    registration: Registration,
+    inner: TcpStream,
+}
+
+impl AsyncTcpStream {
+    /// Opens a TCP connection to a remote host without blocking the
+    /// executor.
+    pub fn connect(addr: &SocketAddr) -> Connect {
+        Connect { addr: *addr, stream: None }
+    }
+
+    /// Converts a blocking stream, switching it to non-blocking mode.
+    pub fn from_std(stream: TcpStream) -> io::Result<AsyncTcpStream> {
+        stream.set_nonblocking(true)?;
+        AsyncTcpStream::register(stream)
+    }
+
+    fn register(stream: TcpStream) -> io::Result<AsyncTcpStream> {
+        let registration = Registration::new(current_reactor()?, stream.as_inner().raw())?;
+        Ok(AsyncTcpStream { registration, inner: stream })
+    }
+
+    /// Reads some bytes into `buf`, returning how many were read.
+    pub fn read<'a>(&'a self, buf: &'a mut [u8]) -> ReadFuture<'a> {
+        ReadFuture { stream: self, buf }
+    }
+
+    /// Writes some bytes from `buf`, returning how many were written.
+    pub fn write<'a>(&'a self, buf: &'a [u8]) -> WriteFuture<'a> {
+        WriteFuture { stream: self, buf }
+    }
+
+    /// Writes all of `buf`.
+    pub fn write_all<'a>(&'a self, buf: &'a [u8]) -> WriteAll<'a> {
+        WriteAll { stream: self, buf }
+    }
+
+    pub fn poll_read(&self, cx: &mut Context<'_>, buf: &mut [u8]) -> Poll<io::Result<usize>> {
+        let mut inner = &self.inner;
+        self.registration.poll_io(cx, Direction::Read, || inner.read(buf))
+    }
+
+    pub fn poll_write(&self, cx: &mut Context<'_>, buf: &[u8]) -> Poll<io::Result<usize>> {
+        let mut inner = &self.inner;
+        self.registration.poll_io(cx, Direction::Write, || inner.write(buf))
+    }
+
+    pub fn peer_addr(&self) -> io::Result<SocketAddr> {
+        self.inner.peer_addr()
+    }
+
+    pub fn local_addr(&self) -> io::Result<SocketAddr> {
+        self.inner.local_addr()
+    }
+
+    pub fn shutdown(&self, how: Shutdown) -> io::Result<()> {
+        self.inner.shutdown(how)
+    }
+
+    pub fn set_nodelay(&self, nodelay: bool) -> io::Result<()> {
+        self.inner.set_nodelay(nodelay)
+    }
+
+    /// Returns the underlying blocking stream.
+    pub fn get_ref(&self) -> &TcpStream {
+        &self.inner
+    }
+}
+
+impl fmt::Debug for AsyncTcpStream {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        self.inner.fmt(f)
+    }
+}
+
+/// Future returned by [`AsyncTcpListener::accept`].
+///
+/// [`AsyncTcpListener::accept`]: struct.AsyncTcpListener.html#method.accept
+#[derive(Debug)]
+pub struct Accept<'a> {
+    listener: &'a AsyncTcpListener,
+}
+
+impl Future for Accept<'_> {
+    type Output = io::Result<(AsyncTcpStream, SocketAddr)>;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        self.listener.poll_accept(cx)
+    }
+}
+
+/// Future returned by [`AsyncTcpStream::connect`].
+///
+/// [`AsyncTcpStream::connect`]: struct.AsyncTcpStream.html#method.connect
+#[derive(Debug)]
+pub struct Connect {
+    addr: SocketAddr,
+    stream: Option<AsyncTcpStream>,
+}
+
+impl Future for Connect {
+    type Output = io::Result<AsyncTcpStream>;
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        if self.stream.is_none() {
+            // Non-blocking from the start, which saves the ioctl OCALL that
+            // `from_std` would need.
+            let socket = Socket::new_socket_addr_type(&self.addr, libc::SOCK_STREAM | libc::SOCK_NONBLOCK)?;
+            let stream = TcpStream::from_inner(net_imp::TcpStream::from_inner(socket));
+            match stream.connect_socket(self.addr) {
+                Ok(()) => return Poll::Ready(AsyncTcpStream::register(stream)),
+                Err(ref e) if e.raw_os_error() == Some(libc::EINPROGRESS) => {}
+                Err(e) => return Poll::Ready(Err(e)),
+            }
+            // Registered only now, since epoll reports a socket that has not
+            // started connecting as writable. From here writability means the
+            // handshake finished, so drop the optimistic initial readiness.
+            let stream = AsyncTcpStream::register(stream)?;
+            stream.registration.reset(Direction::Write);
+            self.stream = Some(stream);
+        }
+
+        match self.stream.as_ref().unwrap().registration.poll_ready(cx, Direction::Write) {
+            Poll::Ready(()) => {}
+            Poll::Pending => return Poll::Pending,
+        }
+        let stream = self.stream.take().unwrap();
+        match stream.inner.take_error()? {
+            Some(e) => Poll::Ready(Err(e)),
+            None => Poll::Ready(Ok(stream)),
+        }
+    }
+}
+
+/// Future returned by [`AsyncTcpStream::read`].
+///
+/// [`AsyncTcpStream::read`]: struct.AsyncTcpStream.html#method.read
+#[derive(Debug)]
+pub struct ReadFuture<'a> {
+    stream: &'a AsyncTcpStream,
+    buf: &'a mut [u8],
+}
+
+impl Future for ReadFuture<'_> {
+    type Output = io::Result<usize>;
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        let this = &mut *self;
+        this.stream.poll_read(cx, this.buf)
+    }
+}
+
+/// Future returned by [`AsyncTcpStream::write`].
+///
+/// [`AsyncTcpStream::write`]: struct.AsyncTcpStream.html#method.write
+#[derive(Debug)]
+pub struct WriteFuture<'a> {
+    stream: &'a AsyncTcpStream,
+    buf: &'a [u8],
+}
+
+impl Future for WriteFuture<'_> {
+    type Output = io::Result<usize>;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        self.stream.poll_write(cx, self.buf)
+    }
+}
+
+/// Future returned by [`AsyncTcpStream::write_all`].
+///
+/// [`AsyncTcpStream::write_all`]: struct.AsyncTcpStream.html#method.write_all
+#[derive(Debug)]
+pub struct WriteAll<'a> {
+    stream: &'a AsyncTcpStream,
+    buf: &'a [u8],
+}
+
+impl Future for WriteAll<'_> {
+    type Output = io::Result<()>;
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        while !self.buf.is_empty() {
+            let n = match self.stream.poll_write(cx, self.buf) {
+                Poll::Ready(Ok(n)) => n,
+                Poll::Ready(Err(ref e)) if e.kind() == io::ErrorKind::Interrupted => continue,
+                Poll::Ready(Err(e)) => return Poll::Ready(Err(e)),
+                Poll::Pending => return Poll::Pending,
+            };
+            if n == 0 {
+                return Poll::Ready(Err(io::Error::new(io::ErrorKind::WriteZero,
+                                                      "failed to write whole buffer")));
+            }
+            let buf = self.buf;
+            self.buf = &buf[n..];
+        }
+        Poll::Ready(Ok(()))
+    }
+}
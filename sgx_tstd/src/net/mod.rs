@@ -31,6 +31,8 @@ pub use self::tcp::TcpStream;
 pub use self::tcp::TcpListener;
 #[cfg(feature = "net")]
 pub use self::udp::UdpSocket;
+#[cfg(feature = "net")]
+pub use self::async_tcp::{Accept, AsyncTcpListener, AsyncTcpStream, Connect, ReadFuture, WriteAll, WriteFuture};
 pub use self::parser::AddrParseError;
 
 mod ip;
@@ -40,6 +42,8 @@ mod parser;
 mod tcp;
 #[cfg(feature = "net")]
 mod udp;
+#[cfg(feature = "net")]
+mod async_tcp;
 
 /// Possible values which can be passed to the [`shutdown`] method of
 #[derive(Copy, Clone, PartialEq, Eq, Debug)]
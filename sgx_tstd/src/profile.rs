@@ -0,0 +1,181 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Profile of the transitions between the enclave and the host.
+//!
+//! With the `ocall_profile` feature every OCALL made through `sgx_libc`
+//! counts its calls and the bytes of data it copies across the boundary,
+//! and ECALLs are counted by declaring a [`ProfileSite`] and holding the
+//! guard of [`ProfileSite::enter`] while they run. Recording is off until
+//! [`enable`] is called.
+//!
+//! Latency is measured with RDTSC and kept in a histogram per site, which
+//! needs SGX2. It is reported in nanoseconds, using the tick rate measured
+//! between [`enable`] and the report with two `clock_gettime` OCALLs.
+//!
+//! ```ignore
+//! static ECALL_WORK: ProfileSite = ProfileSite::ecall("ecall_work");
+//!
+//! #[no_mangle]
+//! pub extern "C" fn ecall_work(input: *const u8, len: usize) -> sgx_status_t {
+//!     let _profile = ECALL_WORK.enter(len);
+//!     ...
+//! }
+//!
+//! profile::enable(true)?;
+//! ...
+//! profile::write_report("transitions.txt")?;
+//! ```
+
+use crate::fmt::Write as FmtWrite;
+use crate::io::{self, Write};
+use crate::path::Path;
+use crate::sys::time::tsc;
+use crate::untrusted::fs::File;
+use alloc_crate::string::String;
+use alloc_crate::vec::Vec;
+use core::sync::atomic::{AtomicU64, Ordering};
+use sgx_trts::libc;
+
+pub use sgx_libc::ocall_profiled;
+pub use sgx_trts::libc::ocall::{LatencyHistogram, ProfileGuard, ProfileKind, ProfileSite, SiteProfile};
+
+// Ticks are only converted to nanoseconds once the rate has been measured
+// over at least this long.
+const MIN_CALIBRATION_NS: u64 = 1_000_000;
+
+static START_TICKS: AtomicU64 = AtomicU64::new(0);
+static START_NS: AtomicU64 = AtomicU64::new(0);
+
+/// Starts recording transitions, with their latency if `latency` is set.
+///
+/// Measuring latency fails without SGX2, as RDTSC faults inside an enclave
+/// then. The host answers the CPUID query for SGX2, so a trial RDTSC is
+/// also run under an exception handler before trusting it. Calling
+/// `enable` again keeps what was recorded so far.
+pub fn enable(latency: bool) -> io::Result<()> {
+    if latency {
+        if !tsc::rdtsc_supported() {
+            return Err(io::Error::new(
+                io::ErrorKind::Other,
+                "measuring transition latency needs SGX2 to read the TSC inside an enclave",
+            ));
+        }
+        if START_NS.load(Ordering::Relaxed) == 0 {
+            if let Some(ns) = host_ns() {
+                START_TICKS.store(unsafe { libc::ocall::profile_ticks() }, Ordering::Relaxed);
+                START_NS.store(ns, Ordering::Relaxed);
+            }
+        }
+    }
+    unsafe { libc::ocall::profile_enable(latency) };
+    Ok(())
+}
+
+/// Stops recording transitions. What was recorded so far is kept.
+pub fn disable() {
+    libc::ocall::profile_disable();
+}
+
+pub fn is_enabled() -> bool {
+    libc::ocall::profile_enabled()
+}
+
+/// Clears everything recorded so far.
+pub fn reset() {
+    libc::ocall::profile_reset();
+}
+
+/// Returns the totals of every OCALL and ECALL recorded so far, ECALLs
+/// first and then by name. Latencies are in TSC ticks.
+pub fn snapshot() -> Vec<SiteProfile> {
+    libc::ocall::profile_snapshot()
+}
+
+/// Formats the profile as a table with one row per OCALL and ECALL.
+pub fn report() -> String {
+    let profiles = snapshot();
+    let scale = ns_per_tick();
+    let mut out = String::new();
+
+    let _ = writeln!(
+        out,
+        "# enclave transitions, latency in {}",
+        if scale.is_some() { "ns" } else { "TSC ticks" }
+    );
+    let _ = writeln!(
+        out,
+        "{:<6} {:<28} {:>12} {:>14} {:>10} {:>10} {:>10} {:>10} {:>12}",
+        "kind", "name", "calls", "bytes", "mean", "p50", "p90", "p99", "max"
+    );
+    for p in profiles.iter() {
+        let kind = match p.kind {
+            ProfileKind::Ecall => "ecall",
+            ProfileKind::Ocall => "ocall",
+        };
+        let _ = write!(out, "{:<6} {:<28} {:>12} {:>14}", kind, p.name, p.calls, p.bytes);
+        let h = &p.latency;
+        if h.count() == 0 {
+            let _ = writeln!(out, " {:>10} {:>10} {:>10} {:>10} {:>12}", "-", "-", "-", "-", "-");
+            continue;
+        }
+        let conv = |ticks: u64| match scale {
+            Some(scale) => (ticks as f64 * scale) as u64,
+            None => ticks,
+        };
+        let _ = writeln!(
+            out,
+            " {:>10} {:>10} {:>10} {:>10} {:>12}",
+            conv(h.mean()),
+            conv(h.quantile(0.5)),
+            conv(h.quantile(0.9)),
+            conv(h.quantile(0.99)),
+            conv(h.max())
+        );
+    }
+    out
+}
+
+/// Writes [`report`] to `path` on the host, replacing the file if it
+/// exists.
+pub fn write_report<P: AsRef<Path>>(path: P) -> io::Result<()> {
+    let report = report();
+    File::create(path)?.write_all(report.as_bytes())
+}
+
+fn ns_per_tick() -> Option<f64> {
+    let start_ns = START_NS.load(Ordering::Relaxed);
+    if start_ns == 0 || !libc::ocall::profile_latency() {
+        return None;
+    }
+    let now_ns = host_ns()?;
+    let now_ticks = unsafe { libc::ocall::profile_ticks() };
+    let ns = now_ns.saturating_sub(start_ns);
+    let ticks = now_ticks.saturating_sub(START_TICKS.load(Ordering::Relaxed));
+    if ns < MIN_CALIBRATION_NS || ticks == 0 {
+        return None;
+    }
+    Some(ns as f64 / ticks as f64)
+}
+
+fn host_ns() -> Option<u64> {
+    let mut t = libc::timespec { tv_sec: 0, tv_nsec: 0 };
+    if unsafe { libc::ocall::clock_gettime(libc::CLOCK_MONOTONIC, &mut t) } != 0 || t.tv_sec < 0 {
+        return None;
+    }
+    Some(t.tv_sec as u64 * 1_000_000_000 + t.tv_nsec as u64)
+}
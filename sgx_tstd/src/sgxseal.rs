@@ -0,0 +1,314 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Sealing to and unsealing from byte streams.
+//!
+//! [`SgxSealWriter`] seals everything written to it into a sealed stream
+//! (see `sgx_tseal::SgxStreamSealer`) and [`SgxUnsealReader`] reads one
+//! back, with random access through [`Seek`]. Both hold a single chunk in
+//! enclave memory, so the stream can be far larger than the enclave heap
+//! and go straight to an untrusted file.
+//!
+//! The module is only built with the `seal` feature, which links
+//! `sgx_tseal` into `sgx_tstd`.
+//!
+//! [`SgxSealWriter`]: struct.SgxSealWriter.html
+//! [`SgxUnsealReader`]: struct.SgxUnsealReader.html
+//! [`Seek`]: ../io/trait.Seek.html
+
+use sgx_tseal::{SgxStreamSealer, SgxStreamUnsealer};
+use core::cmp;
+use core::fmt;
+use core::ptr;
+use crate::io::{self, Read, Seek, SeekFrom, Write};
+
+/// The chunk size used by [`SgxSealWriter::new`].
+///
+/// [`SgxSealWriter::new`]: struct.SgxSealWriter.html#method.new
+pub const DEFAULT_CHUNK_SIZE: usize = 64 * 1024;
+
+fn clear(buf: &mut [u8]) {
+    for b in buf.iter_mut() {
+        unsafe { ptr::write_volatile(b, 0) };
+    }
+}
+
+/// Seals the bytes written to it into a sealed stream on `W`.
+///
+/// Data is sealed a chunk at a time. The stream is complete only once
+/// [`finish`] has sealed the last chunk; dropping the writer finishes it
+/// too but ignores any error.
+///
+/// [`finish`]: #method.finish
+pub struct SgxSealWriter<W: Write> {
+    inner: Option<W>,
+    sealer: SgxStreamSealer,
+    buf: Vec<u8>,
+    sealed: Vec<u8>,
+    panicked: bool,
+}
+
+impl<W: Write> SgxSealWriter<W> {
+    /// Starts a sealed stream with [`DEFAULT_CHUNK_SIZE`] chunks on `inner`.
+    ///
+    /// [`DEFAULT_CHUNK_SIZE`]: constant.DEFAULT_CHUNK_SIZE.html
+    pub fn new(inner: W) -> io::Result<SgxSealWriter<W>> {
+        SgxSealWriter::with_chunk_size(DEFAULT_CHUNK_SIZE, inner)
+    }
+
+    /// Starts a sealed stream with `chunk_size` byte chunks on `inner`.
+    pub fn with_chunk_size(chunk_size: usize, inner: W) -> io::Result<SgxSealWriter<W>> {
+        let sealer = SgxStreamSealer::new(chunk_size).map_err(io::Error::from_sgx_error)?;
+        SgxSealWriter::with_sealer(sealer, inner)
+    }
+
+    /// Starts a sealed stream on `inner` with a sealer set up by the
+    /// caller, e.g. with another key policy.
+    pub fn with_sealer(sealer: SgxStreamSealer, mut inner: W) -> io::Result<SgxSealWriter<W>> {
+        inner.write_all(sealer.header())?;
+        let chunk_size = sealer.chunk_size();
+        Ok(SgxSealWriter {
+            inner: Some(inner),
+            sealer,
+            buf: Vec::with_capacity(chunk_size),
+            sealed: vec![0_u8; chunk_size + SgxStreamSealer::CHUNK_OVERHEAD],
+            panicked: false,
+        })
+    }
+
+    pub fn get_ref(&self) -> &W {
+        self.inner.as_ref().unwrap()
+    }
+
+    /// Seals the last chunk and returns the underlying writer.
+    pub fn finish(mut self) -> io::Result<W> {
+        self.finish_stream()?;
+        Ok(self.inner.take().unwrap())
+    }
+
+    fn seal_chunk(&mut self) -> io::Result<()> {
+        let n = self
+            .sealer
+            .seal_chunk(&self.buf, &mut self.sealed)
+            .map_err(io::Error::from_sgx_error)?;
+        clear(&mut self.buf);
+        self.buf.clear();
+        self.write_sealed(n)
+    }
+
+    fn finish_stream(&mut self) -> io::Result<()> {
+        let n = self
+            .sealer
+            .seal_final(&self.buf, &mut self.sealed)
+            .map_err(io::Error::from_sgx_error)?;
+        clear(&mut self.buf);
+        self.buf.clear();
+        self.write_sealed(n)?;
+        self.inner.as_mut().unwrap().flush()
+    }
+
+    fn write_sealed(&mut self, n: usize) -> io::Result<()> {
+        self.panicked = true;
+        let r = self.inner.as_mut().unwrap().write_all(&self.sealed[..n]);
+        self.panicked = false;
+        r
+    }
+}
+
+impl<W: Write> Write for SgxSealWriter<W> {
+    fn write(&mut self, data: &[u8]) -> io::Result<usize> {
+        if data.is_empty() {
+            return Ok(0);
+        }
+        // A full chunk is only sealed once more data arrives, as the last
+        // chunk is sealed differently.
+        if self.buf.len() == self.sealer.chunk_size() {
+            self.seal_chunk()?;
+        }
+        let n = cmp::min(self.sealer.chunk_size() - self.buf.len(), data.len());
+        self.buf.extend_from_slice(&data[..n]);
+        Ok(n)
+    }
+
+    /// Flushes the underlying writer. The chunk being filled is not
+    /// written until it is full or the stream is finished.
+    fn flush(&mut self) -> io::Result<()> {
+        self.inner.as_mut().unwrap().flush()
+    }
+}
+
+impl<W: Write> Drop for SgxSealWriter<W> {
+    fn drop(&mut self) {
+        if self.inner.is_some() && !self.panicked {
+            // dtors should not panic, so we ignore a failed flush
+            let _r = self.finish_stream();
+        }
+        clear(&mut self.buf);
+    }
+}
+
+impl<W: Write + fmt::Debug> fmt::Debug for SgxSealWriter<W> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("SgxSealWriter")
+            .field("inner", self.inner.as_ref().unwrap())
+            .field("chunk_size", &self.sealer.chunk_size())
+            .finish()
+    }
+}
+
+/// Reads a sealed stream from `R`.
+///
+/// Creating the reader authenticates the header and the last chunk, which
+/// commits to the length of the stream. Every other chunk is authenticated
+/// when it is read. Seeking only moves the position; the chunk holding it is
+/// read on the next call to `read`.
+pub struct SgxUnsealReader<R> {
+    inner: R,
+    unsealer: SgxStreamUnsealer,
+    sealed: Vec<u8>,
+    buf: Vec<u8>,
+    chunk: Option<u64>,
+    pos: u64,
+}
+
+impl<R: Read + Seek> SgxUnsealReader<R> {
+    pub fn new(mut inner: R) -> io::Result<SgxUnsealReader<R>> {
+        let sealed_len = inner.seek(SeekFrom::End(0))?;
+        inner.seek(SeekFrom::Start(0))?;
+        let mut header = vec![0_u8; SgxStreamUnsealer::HEADER_SIZE];
+        inner.read_exact(&mut header)?;
+        let unsealer = SgxStreamUnsealer::new(&header, sealed_len).map_err(io::Error::from_sgx_error)?;
+
+        let chunk_size = unsealer.chunk_size();
+        let last = unsealer.chunk_count() - 1;
+        let mut reader = SgxUnsealReader {
+            inner,
+            unsealer,
+            sealed: vec![0_u8; chunk_size + SgxStreamUnsealer::CHUNK_OVERHEAD],
+            buf: vec![0_u8; chunk_size],
+            chunk: None,
+            pos: 0,
+        };
+        reader.load_chunk(last)?;
+        Ok(reader)
+    }
+
+    /// Returns the plaintext length of the stream.
+    pub fn len(&self) -> u64 {
+        self.unsealer.total_len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    pub fn chunk_size(&self) -> usize {
+        self.unsealer.chunk_size()
+    }
+
+    pub fn chunk_count(&self) -> u64 {
+        self.unsealer.chunk_count()
+    }
+
+    /// Unseals chunk `index` and returns its plaintext.
+    pub fn read_chunk(&mut self, index: u64) -> io::Result<&[u8]> {
+        if index >= self.unsealer.chunk_count() {
+            return Err(io::Error::new(io::ErrorKind::InvalidInput, "chunk index out of range"));
+        }
+        self.load_chunk(index)?;
+        Ok(&self.buf[..self.unsealer.chunk_len(index)])
+    }
+
+    pub fn get_ref(&self) -> &R {
+        &self.inner
+    }
+
+    fn load_chunk(&mut self, index: u64) -> io::Result<()> {
+        if self.chunk == Some(index) {
+            return Ok(());
+        }
+        self.chunk = None;
+        let sealed_len = self.unsealer.sealed_chunk_len(index);
+        self.inner.seek(SeekFrom::Start(self.unsealer.sealed_chunk_offset(index)))?;
+        self.inner.read_exact(&mut self.sealed[..sealed_len])?;
+        self.unsealer
+            .unseal_chunk(index, &self.sealed[..sealed_len], &mut self.buf)
+            .map_err(io::Error::from_sgx_error)?;
+        self.chunk = Some(index);
+        Ok(())
+    }
+}
+
+impl<R: Read + Seek> Read for SgxUnsealReader<R> {
+    fn read(&mut self, out: &mut [u8]) -> io::Result<usize> {
+        if self.pos >= self.len() || out.is_empty() {
+            return Ok(0);
+        }
+        let index = self.unsealer.chunk_index(self.pos);
+        self.load_chunk(index)?;
+        let offset = (self.pos - index * self.chunk_size() as u64) as usize;
+        let available = &self.buf[offset..self.unsealer.chunk_len(index)];
+        let n = cmp::min(available.len(), out.len());
+        out[..n].copy_from_slice(&available[..n]);
+        self.pos += n as u64;
+        Ok(n)
+    }
+}
+
+impl<R: Read + Seek> Seek for SgxUnsealReader<R> {
+    fn seek(&mut self, style: SeekFrom) -> io::Result<u64> {
+        let (base, offset) = match style {
+            SeekFrom::Start(n) => {
+                self.pos = n;
+                return Ok(n);
+            }
+            SeekFrom::End(n) => (self.len(), n),
+            SeekFrom::Current(n) => (self.pos, n),
+        };
+        let new_pos = if offset >= 0 {
+            base.checked_add(offset as u64)
+        } else {
+            base.checked_sub(offset.wrapping_neg() as u64)
+        };
+        match new_pos {
+            Some(n) => {
+                self.pos = n;
+                Ok(self.pos)
+            }
+            None => Err(io::Error::new(
+                io::ErrorKind::InvalidInput,
+                "invalid seek to a negative or overflowing position",
+            )),
+        }
+    }
+}
+
+impl<R> Drop for SgxUnsealReader<R> {
+    fn drop(&mut self) {
+        clear(&mut self.buf);
+    }
+}
+
+impl<R: fmt::Debug> fmt::Debug for SgxUnsealReader<R> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("SgxUnsealReader")
+            .field("inner", &self.inner)
+            .field("chunk_size", &self.unsealer.chunk_size())
+            .field("pos", &self.pos)
+            .finish()
+    }
+}
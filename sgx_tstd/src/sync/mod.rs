@@ -32,7 +32,7 @@ pub use core::sync::atomic;
 
 pub use self::barrier::{Barrier, BarrierWaitResult};
 pub use self::condvar::{SgxCondvar, SgxThreadCondvar, WaitTimeoutResult};
-pub use self::mutex::{SgxMutex, SgxMutexGuard, SgxThreadMutex};
+pub use self::mutex::{SgxMutex, SgxMutexGuard, SgxMutexPolicy, SgxThreadMutex};
 pub use self::remutex::{SgxReentrantMutex, SgxReentrantMutexGuard, SgxReentrantThreadMutex};
 pub use self::once::{Once, OnceState, ONCE_INIT};
 pub use self::rwlock::{SgxRwLock, SgxRwLockReadGuard, SgxRwLockWriteGuard, SgxThreadRwLock};
@@ -36,6 +36,8 @@ use alloc_crate::boxed::Box;
 use crate::sys_common::poison::{self, LockResult, TryLockError, TryLockResult};
 use crate::sys::mutex as imp;
 
+pub use crate::sys::mutex::SgxMutexPolicy;
+
 /// The structure of sgx mutex.
 pub struct SgxThreadMutex(imp::SgxThreadMutex);
 
@@ -89,6 +91,11 @@ impl SgxThreadMutex {
     /// Note that threads release the spin lock after acquiring the mutex or before
     /// leaving the enclave.
     ///
+    /// Under the `SgxMutexPolicy::Adaptive` policy, a thread that finds the mutex
+    /// held first retries with bounded exponential backoff inside the enclave, and
+    /// joins the queue only if the mutex is still unavailable. The queue entry lives
+    /// on the stack of the waiting thread, so waiting never allocates.
+    ///
     /// **Note**
     ///
     /// A thread should not exit an enclave returning from a root ECALL after acquiring
@@ -211,6 +218,46 @@ impl SgxThreadMutex {
     pub unsafe fn destroy(&self) -> SysError {
         self.0.destroy()
     }
+
+    ///
+    /// Returns the contention policy in effect for this mutex.
+    ///
+    #[inline]
+    pub fn policy(&self) -> SgxMutexPolicy {
+        self.0.policy()
+    }
+
+    ///
+    /// Sets how a thread waits when this mutex is contended, overriding the
+    /// global default set by [`set_default_policy`].
+    ///
+    /// [`set_default_policy`]: #method.set_default_policy
+    ///
+    #[inline]
+    pub fn set_policy(&self, policy: SgxMutexPolicy) {
+        self.0.set_policy(policy)
+    }
+
+    ///
+    /// Returns the contention policy used by mutexes that have none of their own.
+    ///
+    #[inline]
+    pub fn default_policy() -> SgxMutexPolicy {
+        imp::SgxThreadMutex::default_policy()
+    }
+
+    ///
+    /// Sets the contention policy used by mutexes that have none of their own.
+    ///
+    /// With `SgxMutexPolicy::Adaptive`, a contended lock first spins inside the
+    /// enclave with bounded exponential backoff, and only leaves the enclave to
+    /// park when the mutex is still held afterwards. `SgxMutexPolicy::Park`
+    /// leaves the enclave right away.
+    ///
+    #[inline]
+    pub fn set_default_policy(policy: SgxMutexPolicy) {
+        imp::SgxThreadMutex::set_default_policy(policy)
+    }
 }
 
 pub fn raw(mutex: &SgxThreadMutex) -> &imp::SgxThreadMutex { &mutex.0 }
@@ -364,6 +411,22 @@ impl<T: ?Sized> SgxMutex<T> {
         self.poison.get()
     }
 
+    /// Returns the contention policy in effect for this mutex.
+    #[inline]
+    pub fn policy(&self) -> SgxMutexPolicy {
+        self.inner.policy()
+    }
+
+    /// Sets how a thread waits when this mutex is contended.
+    ///
+    /// See [`SgxThreadMutex::set_default_policy`] for the global default.
+    ///
+    /// [`SgxThreadMutex::set_default_policy`]: struct.SgxThreadMutex.html#method.set_default_policy
+    #[inline]
+    pub fn set_policy(&self, policy: SgxMutexPolicy) {
+        self.inner.set_policy(policy)
+    }
+
     /// Consumes this mutex, returning the underlying data.
     ///
     /// # Errors
@@ -0,0 +1,409 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Enclave side of the batched OCALL ring.
+//!
+//! Requests are written to a ring in untrusted memory and carried out by an
+//! untrusted worker thread, so a batch of syscalls costs no enclave exit
+//! while the worker is awake. Payloads travel through a data area that sits
+//! right behind the ring and is handed out bump-style; it is rewound once
+//! every request has been reaped.
+//!
+//! Nothing read back from the ring is trusted. Each request keeps a slot in
+//! enclave memory recording what was asked for, completions are matched to
+//! their slot by index and generation, and results that could not have come
+//! from the request are reported as `ESGX`.
+
+use crate::io;
+use core::cmp;
+use core::mem;
+use core::ptr;
+use core::sync::atomic::{spin_loop_hint, AtomicU32, Ordering};
+use alloc_crate::boxed::Box;
+use alloc_crate::collections::VecDeque;
+use alloc_crate::vec::Vec;
+
+pub const DEFAULT_ENTRIES: usize = 256;
+pub const DEFAULT_DATA_LEN: usize = 0x4_0000; //256K
+
+// Polls of the completion queue before blocking in `batch_enter`.
+const WAIT_SPIN_ROUNDS: u32 = 2048;
+const DATA_ALIGN: usize = 16;
+const RING_ALIGN: usize = 64;
+
+#[derive(Copy, Clone, PartialEq, Eq)]
+enum Output {
+    // `result` is a byte count no larger than the request.
+    None,
+    // `result` bytes were written to the data area.
+    Bytes,
+    // `result` must be 0.
+    Status,
+}
+
+#[derive(Copy, Clone)]
+struct Slot {
+    gen: u32,
+    busy: bool,
+    output: Output,
+    off: usize,
+    len: usize,
+}
+
+pub struct Completion {
+    pub token: u64,
+    /// Byte count or errno.
+    pub result: Result<usize, i32>,
+    pub data: Vec<u8>,
+}
+
+pub struct Ring {
+    mem: *mut libc::c_void,
+    hdr: *mut libc::batch_ring,
+    sqes: *mut libc::batch_sqe,
+    cqes: *const libc::batch_cqe,
+    data: *mut u8,
+    data_len: usize,
+    data_used: usize,
+    mask: u32,
+    sq_tail: u32,
+    published: u32,
+    cq_head: u32,
+    slots: Box<[Slot]>,
+    free: Vec<u32>,
+    inflight: usize,
+    done: VecDeque<Completion>,
+}
+
+unsafe impl Send for Ring {}
+
+fn align_up(n: usize, align: usize) -> usize {
+    (n + align - 1) & !(align - 1)
+}
+
+fn corrupted() -> io::Error {
+    io::Error::from_raw_os_error(libc::ESGX)
+}
+
+impl Ring {
+    pub fn new(entries: usize, data_len: usize) -> io::Result<Ring> {
+        let entries = cmp::max(entries, 1).next_power_of_two();
+        if entries > libc::BATCH_RING_MAX_ENTRIES as usize {
+            return Err(io::Error::from_raw_os_error(libc::EINVAL));
+        }
+        let data_off = align_up(libc::batch_ring_size(entries as u32), RING_ALIGN);
+        let total = data_off
+            .checked_add(data_len)
+            .and_then(|n| n.checked_add(RING_ALIGN))
+            .ok_or_else(|| io::Error::from_raw_os_error(libc::EINVAL))?;
+
+        let mem = unsafe { libc::malloc(total) };
+        if mem.is_null() {
+            return Err(io::Error::last_os_error());
+        }
+        let base = align_up(mem as usize, RING_ALIGN) as *mut u8;
+        let hdr = base as *mut libc::batch_ring;
+        let sqe_off = mem::size_of::<libc::batch_ring>();
+        let cqe_off = sqe_off + entries * mem::size_of::<libc::batch_sqe>();
+        unsafe {
+            let mut init: libc::batch_ring = mem::zeroed();
+            init.magic = libc::BATCH_RING_MAGIC;
+            init.entries = entries as u32;
+            init.sqe_off = sqe_off as u32;
+            init.cqe_off = cqe_off as u32;
+            ptr::write_volatile(hdr, init);
+        }
+
+        let mut ring = Ring {
+            mem,
+            hdr,
+            sqes: unsafe { base.add(sqe_off) as *mut libc::batch_sqe },
+            cqes: unsafe { base.add(cqe_off) as *const libc::batch_cqe },
+            data: unsafe { base.add(data_off) },
+            data_len,
+            data_used: 0,
+            mask: entries as u32 - 1,
+            sq_tail: 0,
+            published: 0,
+            cq_head: 0,
+            slots: vec![Slot { gen: 0, busy: false, output: Output::None, off: 0, len: 0 }; entries]
+                .into_boxed_slice(),
+            free: (0..entries as u32).rev().collect(),
+            inflight: 0,
+            done: VecDeque::new(),
+        };
+        if unsafe { libc::batch_start(ring.hdr) } == -1 {
+            let err = io::Error::last_os_error();
+            unsafe { libc::free(ring.mem) };
+            ring.mem = ptr::null_mut();
+            return Err(err);
+        }
+        Ok(ring)
+    }
+
+    fn index(&self, field: &u32) -> &AtomicU32 {
+        unsafe { &*(field as *const u32 as *const AtomicU32) }
+    }
+
+    fn hdr(&self) -> &libc::batch_ring {
+        unsafe { &*self.hdr }
+    }
+
+    /// Requests queued or running, including completions not yet returned.
+    pub fn pending(&self) -> usize {
+        self.inflight + self.done.len()
+    }
+
+    fn has_room(&self, len: usize) -> bool {
+        !self.free.is_empty() && align_up(self.data_used, DATA_ALIGN) + len <= self.data_len
+    }
+
+    fn push(
+        &mut self,
+        opcode: u8,
+        fd: libc::c_int,
+        off: i64,
+        arg: u64,
+        input: &[u8],
+        output: Output,
+        len: usize,
+    ) -> io::Result<u64> {
+        if len > self.data_len {
+            return Err(io::Error::from_raw_os_error(libc::EINVAL));
+        }
+        if !self.has_room(len) {
+            // Make room by draining what is already queued. The results are
+            // kept for the next call to `reap`.
+            self.submit()?;
+            self.drain(0)?;
+            if !self.has_room(len) {
+                return Err(io::Error::from_raw_os_error(libc::EAGAIN));
+            }
+        }
+
+        let data_off = align_up(self.data_used, DATA_ALIGN);
+        self.data_used = data_off + len;
+        let index = self.free.pop().unwrap();
+        let slot = &mut self.slots[index as usize];
+        slot.gen = slot.gen.wrapping_add(1);
+        slot.busy = true;
+        slot.output = output;
+        slot.off = data_off;
+        slot.len = len;
+        let token = (slot.gen as u64) << 32 | index as u64;
+
+        unsafe {
+            let buf = self.data.add(data_off);
+            if !input.is_empty() {
+                ptr::copy_nonoverlapping(input.as_ptr(), buf, input.len());
+            }
+            ptr::write_volatile(
+                self.sqes.add((self.sq_tail & self.mask) as usize),
+                libc::batch_sqe {
+                    opcode,
+                    __pad: [0; 3],
+                    fd,
+                    addr: buf as u64,
+                    len: len as u64,
+                    off,
+                    arg,
+                    user_data: token,
+                },
+            );
+        }
+        self.sq_tail = self.sq_tail.wrapping_add(1);
+        self.inflight += 1;
+        Ok(token)
+    }
+
+    pub fn nop(&mut self) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_NOP, -1, 0, 0, &[], Output::Status, 0)
+    }
+
+    pub fn read(&mut self, fd: libc::c_int, len: usize) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_READ, fd, 0, 0, &[], Output::Bytes, len)
+    }
+
+    pub fn pread(&mut self, fd: libc::c_int, len: usize, offset: i64) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_PREAD64, fd, offset, 0, &[], Output::Bytes, len)
+    }
+
+    pub fn recv(&mut self, fd: libc::c_int, len: usize, flags: libc::c_int) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_RECV, fd, 0, flags as u64, &[], Output::Bytes, len)
+    }
+
+    pub fn write(&mut self, fd: libc::c_int, buf: &[u8]) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_WRITE, fd, 0, 0, buf, Output::None, buf.len())
+    }
+
+    pub fn pwrite(&mut self, fd: libc::c_int, buf: &[u8], offset: i64) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_PWRITE64, fd, offset, 0, buf, Output::None, buf.len())
+    }
+
+    pub fn send(&mut self, fd: libc::c_int, buf: &[u8], flags: libc::c_int) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_SEND, fd, 0, flags as u64, buf, Output::None, buf.len())
+    }
+
+    pub fn fsync(&mut self, fd: libc::c_int) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_FSYNC, fd, 0, 0, &[], Output::Status, 0)
+    }
+
+    pub fn fdatasync(&mut self, fd: libc::c_int) -> io::Result<u64> {
+        self.push(libc::BATCH_OP_FDATASYNC, fd, 0, 0, &[], Output::Status, 0)
+    }
+
+    /// Makes queued requests visible to the worker, waking it only if it
+    /// has gone to sleep.
+    pub fn submit(&mut self) -> io::Result<()> {
+        if self.published == self.sq_tail {
+            return Ok(());
+        }
+        self.published = self.sq_tail;
+        self.index(&self.hdr().sq_tail).store(self.published, Ordering::SeqCst);
+        let flags = self.index(&self.hdr().flags).load(Ordering::SeqCst);
+        if flags & libc::BATCH_RING_NEED_WAKEUP != 0 {
+            if unsafe { libc::batch_enter(self.hdr, 0) } == -1 {
+                return Err(io::Error::last_os_error());
+            }
+        }
+        Ok(())
+    }
+
+    // Moves every completion posted so far into `done`.
+    fn reap_ready(&mut self) -> io::Result<()> {
+        let tail = self.index(&self.hdr().cq_tail).load(Ordering::Acquire);
+        let ready = tail.wrapping_sub(self.cq_head);
+        if ready > self.published.wrapping_sub(self.cq_head) {
+            return Err(corrupted());
+        }
+
+        for _ in 0..ready {
+            let cqe = unsafe {
+                ptr::read_volatile(self.cqes.add((self.cq_head & self.mask) as usize))
+            };
+            self.cq_head = self.cq_head.wrapping_add(1);
+            let completion = self.complete(&cqe)?;
+            self.done.push_back(completion);
+        }
+        self.index(&self.hdr().cq_head).store(self.cq_head, Ordering::SeqCst);
+        if self.inflight == 0 {
+            self.data_used = 0;
+        }
+        Ok(())
+    }
+
+    fn complete(&mut self, cqe: &libc::batch_cqe) -> io::Result<Completion> {
+        let index = cqe.user_data as u32;
+        let gen = (cqe.user_data >> 32) as u32;
+        let slot = match self.slots.get_mut(index as usize) {
+            Some(slot) if slot.busy && slot.gen == gen => slot,
+            _ => return Err(corrupted()),
+        };
+        slot.busy = false;
+        let slot = *slot;
+        self.free.push(index);
+        self.inflight -= 1;
+
+        let mut data = Vec::new();
+        let result = if cqe.result < 0 {
+            Err(cqe.error)
+        } else {
+            let n = cqe.result as u64;
+            let valid = match slot.output {
+                Output::None | Output::Bytes => n <= slot.len as u64,
+                Output::Status => n == 0,
+            };
+            if !valid {
+                Err(libc::ESGX)
+            } else {
+                let copy = if slot.output == Output::Bytes { n as usize } else { 0 };
+                if copy > 0 {
+                    data.reserve_exact(copy);
+                    unsafe {
+                        ptr::copy_nonoverlapping(self.data.add(slot.off), data.as_mut_ptr(), copy);
+                        data.set_len(copy);
+                    }
+                }
+                Ok(n as usize)
+            }
+        };
+        Ok(Completion { token: cqe.user_data, result, data })
+    }
+
+    /// Submits queued requests and collects completions until at least
+    /// `min_complete` of them are waiting in `take`. The minimum is capped
+    /// at the number of requests pending.
+    pub fn wait(&mut self, min_complete: usize) -> io::Result<()> {
+        self.submit()?;
+        let want = cmp::min(min_complete, self.pending());
+        if want > self.done.len() {
+            let target = self.inflight - (want - self.done.len());
+            self.drain(target)?;
+        } else {
+            self.reap_ready()?;
+        }
+        Ok(())
+    }
+
+    // Reaps until no more than `max_inflight` requests are outstanding.
+    // Everything above that has already been submitted.
+    fn drain(&mut self, max_inflight: usize) -> io::Result<()> {
+        let mut spins = 0;
+        loop {
+            self.reap_ready()?;
+            if self.inflight <= max_inflight {
+                return Ok(());
+            }
+            if spins < WAIT_SPIN_ROUNDS {
+                spins += 1;
+                spin_loop_hint();
+                continue;
+            }
+            let missing = (self.inflight - max_inflight) as u32;
+            if unsafe { libc::batch_enter(self.hdr, missing) } == -1 {
+                return Err(io::Error::last_os_error());
+            }
+        }
+    }
+
+    pub fn take(&mut self) -> Option<Completion> {
+        self.done.pop_front()
+    }
+}
+
+impl Drop for Ring {
+    fn drop(&mut self) {
+        if self.mem.is_null() {
+            return;
+        }
+        // Only hand the memory back once the worker has stopped touching it.
+        if unsafe { libc::batch_stop(self.hdr) } == 0 {
+            unsafe { libc::free(self.mem) };
+        }
+    }
+}
+
+mod libc {
+    pub use sgx_trts::libc::*;
+    pub use sgx_trts::libc::ocall::{malloc, free, batch_start, batch_enter, batch_stop,
+                                    batch_ring_size, batch_ring, batch_sqe, batch_cqe,
+                                    BATCH_RING_MAGIC, BATCH_RING_MAX_ENTRIES,
+                                    BATCH_RING_NEED_WAKEUP, BATCH_OP_NOP, BATCH_OP_READ,
+                                    BATCH_OP_WRITE, BATCH_OP_PREAD64, BATCH_OP_PWRITE64,
+                                    BATCH_OP_SEND, BATCH_OP_RECV, BATCH_OP_FSYNC,
+                                    BATCH_OP_FDATASYNC};
+}
@@ -0,0 +1,305 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Enclave side of the asynchronous log ring.
+//!
+//! Records are appended to a ring in untrusted memory and written out by an
+//! untrusted drainer thread. Any number of threads append at once: space is
+//! reserved by advancing `tail`, which lives in enclave memory, with a
+//! compare-and-swap, and a record becomes visible to the drainer once its
+//! length word is stored with `LOG_RECORD_COMMIT` set. The drainer stops at
+//! the first record not yet committed, so records come out in the order
+//! their space was reserved.
+//!
+//! Only `head` and the record contents are shared with the host. Offsets are
+//! masked with the size kept in the enclave, so a host lying about `head`
+//! can garble or stall the log, but never make the enclave write outside
+//! the ring.
+
+use crate::io;
+use core::cmp;
+use core::mem;
+use core::ptr;
+use core::sync::atomic::{spin_loop_hint, AtomicU32, AtomicU64, Ordering};
+
+pub const DEFAULT_SIZE: usize = 0x10_0000; //1M
+
+// Retries of a full ring before a blocking writer waits for the drainer.
+const WAIT_SPIN_ROUNDS: u32 = 1024;
+const RING_ALIGN: usize = 64;
+const HDR_LEN: usize = mem::size_of::<libc::log_record>();
+
+#[derive(Copy, Clone, PartialEq, Eq)]
+pub enum Overflow {
+    Drop,
+    Block,
+}
+
+#[derive(Copy, Clone, Default)]
+pub struct Stats {
+    pub records: u64,
+    pub bytes: u64,
+    pub dropped: u64,
+}
+
+pub struct Ring {
+    mem: *mut libc::c_void,
+    hdr: *mut libc::log_ring,
+    data: *mut u8,
+    size: u64,
+    max_payload: usize,
+    overflow: Overflow,
+    tail: AtomicU64,
+    records: AtomicU64,
+    bytes: AtomicU64,
+    dropped: AtomicU64,
+}
+
+unsafe impl Send for Ring {}
+unsafe impl Sync for Ring {}
+
+fn align_up(n: usize, align: usize) -> usize {
+    (n + align - 1) & !(align - 1)
+}
+
+impl Ring {
+    pub fn new(size: usize, fd: libc::c_int, overflow: Overflow) -> io::Result<Ring> {
+        let size = cmp::max(size, libc::LOG_RING_MIN_SIZE as usize)
+            .checked_next_power_of_two()
+            .filter(|&size| size <= libc::LOG_RING_MAX_SIZE as usize)
+            .ok_or_else(|| io::Error::from_raw_os_error(libc::EINVAL))?;
+
+        let mem = unsafe { libc::malloc(libc::log_ring_size(size as u32) + RING_ALIGN) };
+        if mem.is_null() {
+            return Err(io::Error::last_os_error());
+        }
+        let base = align_up(mem as usize, RING_ALIGN) as *mut u8;
+        let hdr = base as *mut libc::log_ring;
+        let data_off = mem::size_of::<libc::log_ring>();
+        unsafe {
+            let mut init: libc::log_ring = mem::zeroed();
+            init.magic = libc::LOG_RING_MAGIC;
+            init.size = size as u32;
+            init.data_off = data_off as u32;
+            ptr::write_volatile(hdr, init);
+            ptr::write_bytes(base.add(data_off), 0, size);
+        }
+
+        let mut ring = Ring {
+            mem,
+            hdr,
+            data: unsafe { base.add(data_off) },
+            size: size as u64,
+            max_payload: size / 2 - HDR_LEN,
+            overflow,
+            tail: AtomicU64::new(0),
+            records: AtomicU64::new(0),
+            bytes: AtomicU64::new(0),
+            dropped: AtomicU64::new(0),
+        };
+        if unsafe { libc::log_start(ring.hdr, fd) } == -1 {
+            let err = io::Error::last_os_error();
+            unsafe { libc::free(ring.mem) };
+            ring.mem = ptr::null_mut();
+            return Err(err);
+        }
+        Ok(ring)
+    }
+
+    fn hdr(&self) -> &libc::log_ring {
+        unsafe { &*self.hdr }
+    }
+
+    fn head(&self) -> &AtomicU64 {
+        unsafe { &*(&self.hdr().head as *const u64 as *const AtomicU64) }
+    }
+
+    fn flags(&self) -> &AtomicU32 {
+        unsafe { &*(&self.hdr().flags as *const u32 as *const AtomicU32) }
+    }
+
+    fn published_dropped(&self) -> &AtomicU64 {
+        unsafe { &*(&self.hdr().dropped as *const u64 as *const AtomicU64) }
+    }
+
+    pub fn stats(&self) -> Stats {
+        Stats {
+            records: self.records.load(Ordering::Relaxed),
+            bytes: self.bytes.load(Ordering::Relaxed),
+            dropped: self.dropped.load(Ordering::Relaxed),
+        }
+    }
+
+    /// Appends `buf` as one or more records, cut at half the ring size.
+    /// Records of other threads may come between the pieces. Returns
+    /// whether the whole of it was queued; with `Overflow::Drop` records
+    /// that do not fit are counted and left out.
+    pub fn append(&self, stream: u8, level: u8, buf: &[u8]) -> io::Result<bool> {
+        if buf.len() <= self.max_payload {
+            return self.put(stream, level, 0, buf);
+        }
+        let count = (buf.len() + self.max_payload - 1) / self.max_payload;
+        for (i, chunk) in buf.chunks(self.max_payload).enumerate() {
+            let mut flags = 0;
+            if i > 0 {
+                flags |= libc::LOG_RECORD_CONT;
+            }
+            if i + 1 < count {
+                flags |= libc::LOG_RECORD_MORE;
+            }
+            if !self.put(stream, level, flags, chunk)? {
+                return Ok(false);
+            }
+        }
+        Ok(true)
+    }
+
+    fn put(&self, stream: u8, level: u8, flags: u8, payload: &[u8]) -> io::Result<bool> {
+        let need = align_up(HDR_LEN + payload.len(), libc::LOG_RECORD_ALIGN as usize) as u64;
+        let (start, pad) = match self.reserve(need)? {
+            Some(space) => space,
+            None => {
+                let dropped = self.dropped.fetch_add(1, Ordering::Relaxed) + 1;
+                self.published_dropped().fetch_max(dropped, Ordering::Relaxed);
+                self.wake();
+                return Ok(false);
+            }
+        };
+
+        let mask = self.size - 1;
+        if pad > 0 {
+            self.write(start & mask, libc::LOG_LEVEL_PAD, 0, 0, &[], pad as u32 - HDR_LEN as u32);
+        }
+        let off = (start + pad) & mask;
+        self.write(off, level, stream, flags, payload, payload.len() as u32);
+
+        self.records.fetch_add(1, Ordering::Relaxed);
+        self.bytes.fetch_add(payload.len() as u64, Ordering::Relaxed);
+        self.wake_if_filling(start + pad + need);
+        Ok(true)
+    }
+
+    // Writes a record at `off` and commits it.
+    fn write(&self, off: u64, level: u8, stream: u8, flags: u8, payload: &[u8], len: u32) {
+        unsafe {
+            let rec = self.data.add(off as usize);
+            ptr::copy_nonoverlapping(payload.as_ptr(), rec.add(HDR_LEN), payload.len());
+            ptr::write_volatile(rec.add(4), level);
+            ptr::write_volatile(rec.add(5), stream);
+            ptr::write_volatile(rec.add(6), flags);
+            (*(rec as *const AtomicU32)).store(len | libc::LOG_RECORD_COMMIT, Ordering::Release);
+        }
+    }
+
+    // Reserves `need` bytes, plus padding up to the end of the data area
+    // when they would not fit before it. Returns where the padding starts
+    // and its length, or `None` if the ring is full and records are dropped.
+    fn reserve(&self, need: u64) -> io::Result<Option<(u64, u64)>> {
+        let mut spins = 0;
+        let mut tail = self.tail.load(Ordering::Relaxed);
+        loop {
+            let contig = self.size - (tail & (self.size - 1));
+            let pad = if need <= contig { 0 } else { contig };
+            let end = tail + pad + need;
+            let head = self.head().load(Ordering::Acquire);
+            if head > tail {
+                // The drainer may have passed a stale `tail`, but never the
+                // current one unless the host is lying.
+                let current = self.tail.load(Ordering::Relaxed);
+                if current != tail {
+                    tail = current;
+                    continue;
+                }
+                return Ok(None);
+            }
+
+            if end - head <= self.size {
+                match self.tail.compare_exchange_weak(tail, end, Ordering::Relaxed, Ordering::Relaxed) {
+                    Ok(_) => return Ok(Some((tail, pad))),
+                    Err(current) => {
+                        tail = current;
+                        continue;
+                    }
+                }
+            }
+            if self.overflow == Overflow::Drop {
+                return Ok(None);
+            }
+
+            if spins < WAIT_SPIN_ROUNDS {
+                spins += 1;
+                spin_loop_hint();
+            } else if unsafe { libc::log_wait(self.hdr, head) } == -1 {
+                return Err(io::Error::last_os_error());
+            }
+            tail = self.tail.load(Ordering::Relaxed);
+        }
+    }
+
+    // The drainer sleeps between polls. Wake it early once the ring is
+    // half full, so writers do not run into a full ring.
+    fn wake_if_filling(&self, end: u64) {
+        let head = self.head().load(Ordering::Relaxed);
+        if end.wrapping_sub(head) >= self.size / 2 {
+            self.wake();
+        }
+    }
+
+    fn wake(&self) {
+        if self.flags().load(Ordering::Relaxed) & libc::LOG_RING_NEED_WAKEUP != 0 {
+            let flags = self.flags().fetch_and(!libc::LOG_RING_NEED_WAKEUP, Ordering::SeqCst);
+            if flags & libc::LOG_RING_NEED_WAKEUP != 0 {
+                unsafe { libc::log_wait(self.hdr, u64::max_value()) };
+            }
+        }
+    }
+
+    /// Waits until the drainer has written out everything reserved so far.
+    pub fn flush(&self) -> io::Result<()> {
+        let target = self.tail.load(Ordering::Relaxed);
+        loop {
+            let head = self.head().load(Ordering::Acquire);
+            if head >= target {
+                return Ok(());
+            }
+            if unsafe { libc::log_wait(self.hdr, head) } == -1 {
+                return Err(io::Error::last_os_error());
+            }
+        }
+    }
+}
+
+impl Drop for Ring {
+    fn drop(&mut self) {
+        if self.mem.is_null() {
+            return;
+        }
+        // Only hand the memory back once the drainer has stopped touching it.
+        if unsafe { libc::log_stop(self.hdr) } == 0 {
+            unsafe { libc::free(self.mem) };
+        }
+    }
+}
+
+mod libc {
+    pub use sgx_trts::libc::*;
+    pub use sgx_trts::libc::ocall::{malloc, free, log_start, log_wait, log_stop, log_ring_size,
+                                    log_ring, log_record, LOG_RING_MAGIC, LOG_RING_MIN_SIZE,
+                                    LOG_RING_MAX_SIZE, LOG_RING_NEED_WAKEUP, LOG_RECORD_COMMIT,
+                                    LOG_RECORD_ALIGN, LOG_RECORD_CONT, LOG_RECORD_MORE,
+                                    LOG_LEVEL_PAD};
+}
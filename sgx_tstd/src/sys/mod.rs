@@ -36,6 +36,8 @@ pub mod fast_thread_local;
 pub mod thread_local;
 #[cfg(feature = "net")]
 pub mod net;
+#[cfg(feature = "net")]
+pub mod reactor;
 pub mod path;
 pub mod ext;
 pub mod rand;
@@ -50,6 +52,10 @@ pub mod cmath;
 pub mod env;
 #[cfg(feature = "pipe")]
 pub mod pipe;
+#[cfg(feature = "io_batch")]
+pub mod batch;
+#[cfg(feature = "async_log")]
+pub mod log;
 
 pub use crate::sys_common::os_str_bytes as os_str;
 
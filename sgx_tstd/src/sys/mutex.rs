@@ -15,10 +15,11 @@
 // specific language governing permissions and limitations
 // under the License..
 
-use alloc_crate::collections::LinkedList;
 use core::cell::UnsafeCell;
 use core::cmp;
+use core::mem;
 use core::ptr;
+use core::sync::atomic::{spin_loop_hint, AtomicU32, Ordering};
 use crate::sync::SgxThreadSpinlock;
 use crate::thread::rsgx_thread_self;
 use crate::time::Duration;
@@ -74,11 +75,13 @@ pub unsafe fn thread_wait_event(tcs: usize, dur: Duration) -> c_int {
         ptr::null()
     };
 
-    let status = u_thread_wait_event_ocall(
-        &mut result as *mut c_int,
-        &mut error as *mut c_int,
-        tcs as *const c_void,
-        timeout_ptr,
+    let status = sgx_libc::ocall_profiled!(
+        u_thread_wait_event_ocall(
+            &mut result as *mut c_int,
+            &mut error as *mut c_int,
+            tcs as *const c_void,
+            timeout_ptr,
+        )
     );
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -94,10 +97,12 @@ pub unsafe fn thread_wait_event(tcs: usize, dur: Duration) -> c_int {
 pub unsafe fn thread_set_event(tcs: usize) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
-    let status = u_thread_set_event_ocall(
-        &mut result as *mut c_int,
-        &mut error as *mut c_int,
-        tcs as *const c_void,
+    let status = sgx_libc::ocall_profiled!(
+        u_thread_set_event_ocall(
+            &mut result as *mut c_int,
+            &mut error as *mut c_int,
+            tcs as *const c_void,
+        )
     );
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -114,11 +119,14 @@ pub unsafe fn thread_set_multiple_events(tcss: &[usize]) -> c_int {
     let mut result: c_int = 0;
     let mut error: c_int = 0;
 
-    let status = u_thread_set_multiple_events_ocall(
-        &mut result as *mut c_int,
-        &mut error as *mut c_int,
-        tcss.as_ptr() as *const *const c_void,
-        tcss.len() as c_int,
+    let status = sgx_libc::ocall_profiled!(
+        tcss.len() * mem::size_of::<usize>(),
+        u_thread_set_multiple_events_ocall(
+            &mut result as *mut c_int,
+            &mut error as *mut c_int,
+            tcss.as_ptr() as *const *const c_void,
+            tcss.len() as c_int,
+        )
     );
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -146,12 +154,14 @@ pub unsafe fn thread_setwait_events(wait_tcs: usize, self_tcs: usize, dur: Durat
         ptr::null()
     };
 
-    let status = u_thread_setwait_events_ocall(
-        &mut result as *mut c_int,
-        &mut error as *mut c_int,
-        wait_tcs as *const c_void,
-        self_tcs as *const c_void,
-        timeout_ptr,
+    let status = sgx_libc::ocall_profiled!(
+        u_thread_setwait_events_ocall(
+            &mut result as *mut c_int,
+            &mut error as *mut c_int,
+            wait_tcs as *const c_void,
+            self_tcs as *const c_void,
+            timeout_ptr,
+        )
     );
     if status == sgx_status_t::SGX_SUCCESS {
         if result == -1 {
@@ -170,12 +180,112 @@ pub enum SgxThreadMutexControl {
     SGX_THREAD_MUTEX_RECURSIVE = 2,
 }
 
+/// How a thread behaves when the mutex it wants is held by another thread.
+#[derive(Copy, PartialEq, Eq, Clone, Debug)]
+pub enum SgxMutexPolicy {
+    /// Leave the enclave and park on the untrusted event as soon as the
+    /// mutex is contended.
+    Park,
+    /// Spin inside the enclave for up to the given number of backoff rounds,
+    /// and park only if the mutex is still held afterwards.
+    Adaptive(u32),
+}
+
+const MUTEX_POLICY_INHERIT: u32 = u32::MAX;
+const MUTEX_SPIN_BACKOFF_MAX: u32 = 64;
+const MUTEX_DEFAULT_SPIN_ROUNDS: u32 = 16;
+
+static MUTEX_DEFAULT_POLICY: AtomicU32 = AtomicU32::new(MUTEX_DEFAULT_SPIN_ROUNDS);
+
+impl SgxMutexPolicy {
+    fn encode(self) -> u32 {
+        match self {
+            SgxMutexPolicy::Park => 0,
+            SgxMutexPolicy::Adaptive(rounds) => cmp::min(rounds, MUTEX_POLICY_INHERIT - 1),
+        }
+    }
+
+    fn decode(rounds: u32) -> SgxMutexPolicy {
+        if rounds == 0 {
+            SgxMutexPolicy::Park
+        } else {
+            SgxMutexPolicy::Adaptive(rounds)
+        }
+    }
+}
+
+impl Default for SgxMutexPolicy {
+    fn default() -> SgxMutexPolicy {
+        SgxMutexPolicy::Adaptive(MUTEX_DEFAULT_SPIN_ROUNDS)
+    }
+}
+
+// A waiter lives on the stack of the thread blocked in `lock`, and is
+// unlinked by that same thread once it owns the mutex, so queueing needs
+// no allocation.
+struct SgxThreadMutexWaiter {
+    thread: sgx_thread_t,
+    next: *mut SgxThreadMutexWaiter,
+}
+
+struct SgxThreadMutexQueue {
+    head: *mut SgxThreadMutexWaiter,
+    tail: *mut SgxThreadMutexWaiter,
+}
+
+impl SgxThreadMutexQueue {
+    const fn new() -> Self {
+        SgxThreadMutexQueue {
+            head: ptr::null_mut(),
+            tail: ptr::null_mut(),
+        }
+    }
+
+    #[inline]
+    fn is_empty(&self) -> bool {
+        self.head.is_null()
+    }
+
+    #[inline]
+    unsafe fn front(&self) -> sgx_thread_t {
+        if self.head.is_null() {
+            SGX_THREAD_T_NULL
+        } else {
+            (*self.head).thread
+        }
+    }
+
+    unsafe fn push_back(&mut self, waiter: *mut SgxThreadMutexWaiter) {
+        (*waiter).next = ptr::null_mut();
+        if self.tail.is_null() {
+            self.head = waiter;
+        } else {
+            (*self.tail).next = waiter;
+        }
+        self.tail = waiter;
+    }
+
+    unsafe fn pop_front(&mut self) {
+        if self.head.is_null() {
+            return;
+        }
+        let waiter = self.head;
+        self.head = (*waiter).next;
+        if self.head.is_null() {
+            self.tail = ptr::null_mut();
+        }
+        (*waiter).next = ptr::null_mut();
+    }
+}
+
 struct SgxThreadMutexInner {
     refcount: usize,
     control: SgxThreadMutexControl,
+    policy: AtomicU32,
     lock: SgxThreadSpinlock,
     owner: sgx_thread_t,
-    queue: LinkedList<sgx_thread_t>,
+    queue: SgxThreadMutexQueue,
+    wake_pending: bool,
 }
 
 impl SgxThreadMutexInner {
@@ -183,39 +293,111 @@ impl SgxThreadMutexInner {
         SgxThreadMutexInner {
             refcount: 0,
             control: control,
+            policy: AtomicU32::new(MUTEX_POLICY_INHERIT),
             lock: SgxThreadSpinlock::new(),
             owner: SGX_THREAD_T_NULL,
-            queue: LinkedList::new(),
+            queue: SgxThreadMutexQueue::new(),
+            wake_pending: false,
+        }
+    }
+
+    #[inline]
+    fn spin_rounds(&self) -> u32 {
+        match self.policy.load(Ordering::Relaxed) {
+            MUTEX_POLICY_INHERIT => MUTEX_DEFAULT_POLICY.load(Ordering::Relaxed),
+            rounds => rounds,
         }
     }
 
+    fn policy(&self) -> SgxMutexPolicy {
+        SgxMutexPolicy::decode(self.spin_rounds())
+    }
+
+    fn set_policy(&self, policy: SgxMutexPolicy) {
+        self.policy.store(policy.encode(), Ordering::Relaxed);
+    }
+
+    // Takes the mutex as soon as nobody owns it. A spinning thread may get
+    // ahead of parked ones, which saves the release from waiting for the head
+    // of the queue to re-enter the enclave; the woken waiter just parks again.
+    unsafe fn try_acquire(&mut self, self_thread: sgx_thread_t) -> bool {
+        let owner = ptr::read_volatile(&self.owner);
+        if owner != SGX_THREAD_T_NULL && owner != self_thread {
+            return false;
+        }
+
+        self.lock.lock();
+        if self.control == SgxThreadMutexControl::SGX_THREAD_MUTEX_RECURSIVE
+            && self.owner == self_thread
+        {
+            self.refcount += 1;
+            self.lock.unlock();
+            return true;
+        }
+
+        if self.owner == SGX_THREAD_T_NULL {
+            self.owner = self_thread;
+            self.refcount += 1;
+            self.lock.unlock();
+            return true;
+        }
+        self.lock.unlock();
+        false
+    }
+
     unsafe fn lock(&mut self) -> SysError {
+        let self_thread = rsgx_thread_self();
+
+        let rounds = self.spin_rounds();
+        if rounds > 0 {
+            let mut backoff: u32 = 1;
+            for _ in 0..rounds {
+                if self.try_acquire(self_thread) {
+                    return Ok(());
+                }
+                for _ in 0..backoff {
+                    spin_loop_hint();
+                }
+                backoff = cmp::min(backoff << 1, MUTEX_SPIN_BACKOFF_MAX);
+            }
+        }
+
+        let mut waiter = SgxThreadMutexWaiter {
+            thread: self_thread,
+            next: ptr::null_mut(),
+        };
+        let mut queued = false;
         loop {
             self.lock.lock();
             if self.control == SgxThreadMutexControl::SGX_THREAD_MUTEX_RECURSIVE
-                && self.owner == rsgx_thread_self()
+                && self.owner == self_thread
             {
                 self.refcount += 1;
                 self.lock.unlock();
                 return Ok(());
             }
 
+            if queued && self.queue.front() == self_thread {
+                self.wake_pending = false;
+            }
+
             if self.owner == SGX_THREAD_T_NULL
-                && (self.queue.front() == Some(&rsgx_thread_self())
-                    || self.queue.front() == None)
+                && (self.queue.front() == self_thread || self.queue.is_empty())
             {
-                if self.queue.front() == Some(&rsgx_thread_self()) {
+                if queued {
                     self.queue.pop_front();
                 }
 
-                self.owner = rsgx_thread_self();
+                self.owner = self_thread;
                 self.refcount += 1;
                 self.lock.unlock();
                 return Ok(());
             }
 
-            if !self.queue.contains(&rsgx_thread_self()) {
-                self.queue.push_back(rsgx_thread_self());
+            // A spurious wakeup finds the thread already queued.
+            if !queued {
+                self.queue.push_back(&mut waiter as *mut SgxThreadMutexWaiter);
+                queued = true;
             }
 
             self.lock.unlock();
@@ -236,14 +418,9 @@ impl SgxThreadMutexInner {
             return Ok(());
         }
 
-        if self.owner == SGX_THREAD_T_NULL
-            && (self.queue.front() == Some(&rsgx_thread_self())
-                || self.queue.front() == None)
-        {
-            if self.queue.front() == Some(&rsgx_thread_self()) {
-                self.queue.pop_front();
-            }
-
+        // A thread calling try_lock is never queued, so it may only take
+        // the mutex when nobody is waiting for it.
+        if self.owner == SGX_THREAD_T_NULL && self.queue.is_empty() {
             self.owner = rsgx_thread_self();
             self.refcount += 1;
             self.lock.unlock();
@@ -286,11 +463,13 @@ impl SgxThreadMutexInner {
             return Ok(());
         }
         // Before releasing the mutex, get the first thread,
-        // the thread should be waked up by the caller.
-        if self.queue.is_empty() {
+        // the thread should be waked up by the caller. If it has
+        // been waked up already and not yet run, don't wake it twice.
+        if self.queue.is_empty() || self.wake_pending {
             *waiter = SGX_THREAD_T_NULL;
         } else {
-            *waiter = *self.queue.front().unwrap();
+            *waiter = self.queue.front();
+            self.wake_pending = true;
         }
 
         self.lock.unlock();
@@ -354,4 +533,26 @@ impl SgxThreadMutex {
         let mutex: &mut SgxThreadMutexInner = &mut *self.lock.get();
         mutex.destroy()
     }
+
+    #[inline]
+    pub fn policy(&self) -> SgxMutexPolicy {
+        let mutex: &SgxThreadMutexInner = unsafe { &*self.lock.get() };
+        mutex.policy()
+    }
+
+    #[inline]
+    pub fn set_policy(&self, policy: SgxMutexPolicy) {
+        let mutex: &SgxThreadMutexInner = unsafe { &*self.lock.get() };
+        mutex.set_policy(policy)
+    }
+
+    #[inline]
+    pub fn default_policy() -> SgxMutexPolicy {
+        SgxMutexPolicy::decode(MUTEX_DEFAULT_POLICY.load(Ordering::Relaxed))
+    }
+
+    #[inline]
+    pub fn set_default_policy(policy: SgxMutexPolicy) {
+        MUTEX_DEFAULT_POLICY.store(policy.encode(), Ordering::Relaxed);
+    }
 }
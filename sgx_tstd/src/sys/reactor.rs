@@ -0,0 +1,158 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Thin wrapper around an untrusted epoll instance.
+//!
+//! The poller owns an epoll descriptor plus a non-blocking socketpair that
+//! other threads use to interrupt a blocked `wait`. Every call here is an
+//! OCALL, so the callers are expected to keep registrations edge-triggered
+//! and to batch as much work as possible between two `wait`s.
+
+use sgx_trts::libc::{c_int, c_void};
+use core::cmp;
+use core::sync::atomic::{AtomicBool, Ordering};
+use alloc_crate::vec::Vec;
+use crate::io;
+use crate::sys::fd::FileDesc;
+use crate::sys::{cvt, cvt_r};
+use crate::time::Duration;
+
+/// Token reserved for the wakeup socket.
+pub const NOTIFY_TOKEN: u64 = u64::MAX;
+
+pub const READABLE: u32 = (libc::EPOLLIN | libc::EPOLLRDHUP) as u32;
+pub const WRITABLE: u32 = libc::EPOLLOUT as u32;
+pub const HUP: u32 = (libc::EPOLLHUP | libc::EPOLLERR) as u32;
+
+pub type Event = libc::epoll_event;
+
+pub struct Poller {
+    epfd: FileDesc,
+    notify_rx: FileDesc,
+    notify_tx: FileDesc,
+    notified: AtomicBool,
+}
+
+impl Poller {
+    pub fn new() -> io::Result<Poller> {
+        let epfd = FileDesc::new(cvt(unsafe { libc::epoll_create1(libc::EPOLL_CLOEXEC) })?);
+
+        let mut fds = [0, 0];
+        cvt(unsafe {
+            libc::socketpair(libc::AF_UNIX,
+                             libc::SOCK_STREAM | libc::SOCK_NONBLOCK | libc::SOCK_CLOEXEC,
+                             0,
+                             fds.as_mut_ptr())
+        })?;
+        let notify_rx = FileDesc::new(fds[0]);
+        let notify_tx = FileDesc::new(fds[1]);
+
+        let poller = Poller {
+            epfd,
+            notify_rx,
+            notify_tx,
+            notified: AtomicBool::new(false),
+        };
+        poller.ctl(libc::EPOLL_CTL_ADD, poller.notify_rx.raw(), NOTIFY_TOKEN, READABLE)?;
+        Ok(poller)
+    }
+
+    /// Registers `fd` in edge-triggered mode for both directions, so that a
+    /// descriptor needs exactly one `epoll_ctl` for its whole lifetime.
+    pub fn add(&self, fd: c_int, token: u64) -> io::Result<()> {
+        self.ctl(libc::EPOLL_CTL_ADD, fd, token, READABLE | WRITABLE | libc::EPOLLET as u32)
+    }
+
+    pub fn delete(&self, fd: c_int) -> io::Result<()> {
+        self.ctl(libc::EPOLL_CTL_DEL, fd, 0, 0)
+    }
+
+    fn ctl(&self, op: c_int, fd: c_int, token: u64, events: u32) -> io::Result<()> {
+        let mut event = libc::epoll_event { events, u64: token };
+        cvt(unsafe { libc::epoll_ctl(self.epfd.raw(), op, fd, &mut event) }).map(drop)
+    }
+
+    /// Waits for events, filling `events` up to its capacity.
+    ///
+    /// `None` blocks until an event or a `notify` arrives. Events for the
+    /// wakeup socket are consumed here and never reported to the caller.
+    pub fn wait(&self, events: &mut Vec<Event>, timeout: Option<Duration>) -> io::Result<()> {
+        let timeout = match timeout {
+            None => -1,
+            Some(dur) => {
+                let ms = dur.as_millis();
+                // Round up so a sub-millisecond timeout does not turn into a busy poll.
+                let ms = if Duration::from_millis(ms as u64) < dur { ms + 1 } else { ms };
+                cmp::min(ms, c_int::max_value() as u128) as c_int
+            }
+        };
+
+        events.clear();
+        let max = cmp::min(events.capacity(), c_int::max_value() as usize) as c_int;
+        let n = cvt_r(|| unsafe {
+            libc::epoll_wait(self.epfd.raw(), events.as_mut_ptr(), max, timeout)
+        })?;
+        if n > max {
+            return Err(io::Error::from_raw_os_error(libc::ESGX));
+        }
+        unsafe { events.set_len(n as usize) };
+
+        if let Some(pos) = events.iter().position(|e| e.u64 == NOTIFY_TOKEN) {
+            events.swap_remove(pos);
+            self.drain_notify();
+        }
+        Ok(())
+    }
+
+    /// Wakes up a thread blocked in `wait`.
+    ///
+    /// Concurrent calls are coalesced until the poller consumes the wakeup,
+    /// so a burst of cross-thread wakes costs a single OCALL.
+    pub fn notify(&self) -> io::Result<()> {
+        if self.notified.swap(true, Ordering::AcqRel) {
+            return Ok(());
+        }
+        let byte = 1u8;
+        match cvt(unsafe {
+            libc::write(self.notify_tx.raw(), &byte as *const u8 as *const c_void, 1)
+        }) {
+            Ok(_) => Ok(()),
+            // The socket buffer is full, so a wakeup is already pending.
+            Err(ref e) if e.kind() == io::ErrorKind::WouldBlock => Ok(()),
+            Err(e) => {
+                self.notified.store(false, Ordering::Release);
+                Err(e)
+            }
+        }
+    }
+
+    fn drain_notify(&self) {
+        self.notified.store(false, Ordering::Release);
+        let mut buf = [0u8; 64];
+        loop {
+            match self.notify_rx.read(&mut buf) {
+                Ok(n) if n == buf.len() => continue,
+                _ => break,
+            }
+        }
+    }
+}
+
+mod libc {
+    pub use sgx_trts::libc::*;
+    pub use sgx_trts::libc::ocall::{epoll_create1, epoll_ctl, epoll_wait, socketpair, write};
+}
@@ -15,205 +15,479 @@
 // specific language governing permissions and limitations
 // under the License..
 
-use alloc_crate::collections::LinkedList;
+//! A reader-writer lock built for read-mostly data.
+//!
+//! Readers announce themselves in one of `READER_SLOTS` counters, picked by
+//! hashing the calling thread's TCS, and each counter sits on its own cache
+//! line. An uncontended `read` is an atomic increment on that line followed
+//! by a check of the writer bit, so readers on different TCS never write to
+//! the same memory. A writer sets the writer bit and then checks that all
+//! counters are zero; readers that see the bit step back and wait.
+//!
+//! The lock is biased towards readers the same way the previous
+//! implementation was: readers only wait for a writer that holds the lock,
+//! never for one that is queued, so recursive reads cannot deadlock. Waiters
+//! are linked through nodes on their own stacks, so the lock never
+//! allocates.
+
 use core::cell::UnsafeCell;
+use core::cmp;
+use core::ptr;
+use core::sync::atomic::{spin_loop_hint, AtomicUsize, Ordering};
 use crate::sync::SgxThreadSpinlock;
 use crate::time::Duration;
 use crate::thread::rsgx_thread_self;
 use crate::sys::mutex;
+use crate::u64;
 use sgx_trts::enclave::SgxThreadData;
 use sgx_trts::libc;
 use sgx_types::{sgx_thread_t, SysError, SGX_THREAD_T_NULL};
 
+// 16 slots of a cache line each, 1 KiB of every lock.
+const READER_SLOT_BITS: u32 = 4;
+const READER_SLOTS: usize = 1 << READER_SLOT_BITS;
+
+// Readers woken per set_multiple_events OCALL.
+const WAKE_BATCH: usize = 16;
+
+// Bits of `SgxThreadRwLockInner::state`.
+const WRITER: usize = 1;
+const READERS_WAITING: usize = 1 << 1;
+const WRITERS_WAITING: usize = 1 << 2;
+// The first queued writer has been woken and has not run yet.
+const WRITER_WOKEN: usize = 1 << 3;
+
+// Backoff rounds spent inside the enclave before a waiter parks, as in
+// `SgxMutexPolicy::Adaptive`.
+const SPIN_ROUNDS: u32 = 16;
+const SPIN_BACKOFF_MAX: u32 = 64;
+
+#[repr(align(64))]
+struct ReaderSlot(AtomicUsize);
+
+const READER_SLOT_INIT: ReaderSlot = ReaderSlot(AtomicUsize::new(0));
+
+#[inline]
+fn reader_slot(thread: sgx_thread_t) -> usize {
+    // Thread data is page aligned; fold the page number with a Fibonacci
+    // hash so consecutive TCS land on different slots.
+    let page = (thread >> 12) as u64;
+    (page.wrapping_mul(0x9E37_79B9_7F4A_7C15) >> (64 - READER_SLOT_BITS)) as usize
+}
+
+// Spins with bounded exponential backoff until `ready` holds, giving up
+// after SPIN_ROUNDS rounds.
+fn spin_until<F: Fn() -> bool>(ready: F) -> bool {
+    let mut backoff: u32 = 1;
+    for _ in 0..SPIN_ROUNDS {
+        if ready() {
+            return true;
+        }
+        for _ in 0..backoff {
+            spin_loop_hint();
+        }
+        backoff = cmp::min(backoff << 1, SPIN_BACKOFF_MAX);
+    }
+    ready()
+}
+
+#[inline]
+fn wait_forever() {
+    unsafe {
+        mutex::thread_wait_event(
+            SgxThreadData::current().get_tcs(),
+            Duration::new(u64::MAX, 1_000_000_000 - 1),
+        );
+    }
+}
+
+// Lives on the stack of the thread blocked in `read` or `write`. A waker
+// either leaves it queued (writers) or unlinks it before waking its thread
+// (readers); in both cases the owner takes it off the queue under the
+// spinlock before its frame goes away.
+struct SgxThreadRwLockWaiter {
+    thread: sgx_thread_t,
+    next: *mut SgxThreadRwLockWaiter,
+    linked: bool,
+}
+
+impl SgxThreadRwLockWaiter {
+    fn new(thread: sgx_thread_t) -> Self {
+        SgxThreadRwLockWaiter {
+            thread,
+            next: ptr::null_mut(),
+            linked: false,
+        }
+    }
+}
+
+struct SgxThreadRwLockQueue {
+    head: *mut SgxThreadRwLockWaiter,
+    tail: *mut SgxThreadRwLockWaiter,
+}
+
+impl SgxThreadRwLockQueue {
+    const fn new() -> Self {
+        SgxThreadRwLockQueue {
+            head: ptr::null_mut(),
+            tail: ptr::null_mut(),
+        }
+    }
+
+    #[inline]
+    fn is_empty(&self) -> bool {
+        self.head.is_null()
+    }
+
+    #[inline]
+    unsafe fn front(&self) -> sgx_thread_t {
+        if self.head.is_null() {
+            SGX_THREAD_T_NULL
+        } else {
+            (*self.head).thread
+        }
+    }
+
+    unsafe fn push_back(&mut self, waiter: *mut SgxThreadRwLockWaiter) {
+        (*waiter).next = ptr::null_mut();
+        (*waiter).linked = true;
+        if self.tail.is_null() {
+            self.head = waiter;
+        } else {
+            (*self.tail).next = waiter;
+        }
+        self.tail = waiter;
+    }
+
+    unsafe fn pop_front(&mut self) -> sgx_thread_t {
+        let waiter = self.head;
+        if waiter.is_null() {
+            return SGX_THREAD_T_NULL;
+        }
+        self.head = (*waiter).next;
+        if self.head.is_null() {
+            self.tail = ptr::null_mut();
+        }
+        (*waiter).next = ptr::null_mut();
+        (*waiter).linked = false;
+        (*waiter).thread
+    }
+
+    unsafe fn remove(&mut self, waiter: *mut SgxThreadRwLockWaiter) {
+        if !(*waiter).linked {
+            return;
+        }
+        let mut prev: *mut SgxThreadRwLockWaiter = ptr::null_mut();
+        let mut cur = self.head;
+        while !cur.is_null() {
+            if cur == waiter {
+                let next = (*cur).next;
+                if prev.is_null() {
+                    self.head = next;
+                } else {
+                    (*prev).next = next;
+                }
+                if self.tail == cur {
+                    self.tail = prev;
+                }
+                break;
+            }
+            prev = cur;
+            cur = (*cur).next;
+        }
+        (*waiter).next = ptr::null_mut();
+        (*waiter).linked = false;
+    }
+}
+
+struct SgxThreadRwLockQueues {
+    readers: SgxThreadRwLockQueue,
+    writers: SgxThreadRwLockQueue,
+}
+
 struct SgxThreadRwLockInner {
-    reader_count: u32,
-    writer_waiting: u32,
+    readers: [ReaderSlot; READER_SLOTS],
+    state: AtomicUsize,
+    owner: AtomicUsize,
     lock: SgxThreadSpinlock,
-    owner: sgx_thread_t,
-    reader_queue: LinkedList<sgx_thread_t>,
-    writer_queue: LinkedList<sgx_thread_t>,
+    queues: UnsafeCell<SgxThreadRwLockQueues>,
 }
 
 impl SgxThreadRwLockInner {
     const fn new() -> Self {
         SgxThreadRwLockInner {
-            reader_count: 0,
-            writer_waiting: 0,
+            readers: [READER_SLOT_INIT; READER_SLOTS],
+            state: AtomicUsize::new(0),
+            owner: AtomicUsize::new(SGX_THREAD_T_NULL),
             lock: SgxThreadSpinlock::new(),
-            owner: SGX_THREAD_T_NULL,
-            reader_queue: LinkedList::new(),
-            writer_queue: LinkedList::new(),
+            queues: UnsafeCell::new(SgxThreadRwLockQueues {
+                readers: SgxThreadRwLockQueue::new(),
+                writers: SgxThreadRwLockQueue::new(),
+            }),
         }
     }
 
-    unsafe fn read(&mut self) -> SysError {
-        let current = rsgx_thread_self();
+    // Must only be called with `lock` held.
+    #[inline]
+    unsafe fn queues(&self) -> &mut SgxThreadRwLockQueues {
+        &mut *self.queues.get()
+    }
 
-        self.lock.lock();
-        if self.owner == SGX_THREAD_T_NULL {
-            self.reader_count += 1;
-        } else {
-            if self.owner == current {
-                self.lock.unlock();
-                return Err(libc::EDEADLK);
-            }
+    fn reader_count(&self) -> usize {
+        self.readers
+            .iter()
+            .fold(0, |sum, slot| sum + slot.0.load(Ordering::SeqCst))
+    }
 
-            self.reader_queue.push_back(current);
+    #[inline]
+    fn try_read_fast(&self, slot: &AtomicUsize) -> bool {
+        slot.fetch_add(1, Ordering::SeqCst);
+        if self.state.load(Ordering::SeqCst) & WRITER == 0 {
+            return true;
+        }
+        slot.fetch_sub(1, Ordering::SeqCst);
+        self.reader_left();
+        false
+    }
 
-            loop {
-                self.lock.unlock();
-                mutex::thread_wait_event(
-                    SgxThreadData::from_raw(current).get_tcs(),
-                    Duration::new(u64::MAX, 1_000_000_000 - 1),
-                );
+    // Called after a reader dropped its count. Pairs with the recheck in
+    // `write`: either the writer sees the count at zero, or the last reader
+    // out sees WRITERS_WAITING and wakes it.
+    #[inline]
+    fn reader_left(&self) {
+        let state = self.state.load(Ordering::SeqCst);
+        if state & (WRITERS_WAITING | WRITER_WOKEN) == WRITERS_WAITING && self.reader_count() == 0 {
+            self.wake_writer();
+        }
+    }
 
+    fn wake_writer(&self) {
+        unsafe {
+            self.lock.lock();
+            // The writer unlinks itself and clears WRITER_WOKEN once it runs;
+            // until then there is no point in waking it again.
+            let mut waiter = self.queues().writers.front();
+            if waiter != SGX_THREAD_T_NULL
+                && self.state.fetch_or(WRITER_WOKEN, Ordering::SeqCst) & WRITER_WOKEN != 0
+            {
+                waiter = SGX_THREAD_T_NULL;
+            }
+            self.lock.unlock();
+            if waiter != SGX_THREAD_T_NULL {
+                mutex::thread_set_event(SgxThreadData::from_raw(waiter).get_tcs());
+            }
+        }
+    }
+
+    fn wake_readers(&self) -> usize {
+        let mut tcs = [0_usize; WAKE_BATCH];
+        let mut woken = 0;
+        loop {
+            let mut n = 0;
+            let more = unsafe {
                 self.lock.lock();
-                if self.owner == SGX_THREAD_T_NULL {
-                    self.reader_count += 1;
-                    if let Some(pos) = self
-                        .reader_queue
-                        .iter()
-                        .position(|&waiter| waiter == current)
-                    {
-                        self.reader_queue.remove(pos);
-                    }
-                    break;
+                let queues = self.queues();
+                while n < WAKE_BATCH && !queues.readers.is_empty() {
+                    tcs[n] = SgxThreadData::from_raw(queues.readers.pop_front()).get_tcs();
+                    n += 1;
+                }
+                let more = !queues.readers.is_empty();
+                if !more {
+                    self.state.fetch_and(!READERS_WAITING, Ordering::SeqCst);
+                }
+                self.lock.unlock();
+                more
+            };
+
+            unsafe {
+                match n {
+                    0 => {}
+                    1 => { mutex::thread_set_event(tcs[0]); }
+                    _ => { mutex::thread_set_multiple_events(&tcs[..n]); }
                 }
             }
+            woken += n;
+            if !more {
+                return woken;
+            }
         }
-        self.lock.unlock();
-        Ok(())
     }
 
-    unsafe fn try_read(&mut self) -> SysError {
-        self.lock.lock();
-        let ret = if self.owner == SGX_THREAD_T_NULL {
-            self.reader_count += 1;
-            Ok(())
+    fn try_write_fast(&self, current: sgx_thread_t) -> bool {
+        let mut state = self.state.load(Ordering::Relaxed);
+        loop {
+            if state & WRITER != 0 {
+                return false;
+            }
+            match self.state.compare_exchange_weak(
+                state,
+                state | WRITER,
+                Ordering::SeqCst,
+                Ordering::Relaxed,
+            ) {
+                Ok(_) => break,
+                Err(s) => state = s,
+            }
+        }
+        if self.reader_count() == 0 {
+            self.owner.store(current, Ordering::Relaxed);
+            return true;
+        }
+        // Readers got in first; back off and let them finish.
+        self.release_writer();
+        false
+    }
+
+    // Clears the writer bit and wakes whoever waited for it: all queued
+    // readers if there are any, otherwise the first queued writer. Queued
+    // writers behind woken readers are woken by the last reader out.
+    fn release_writer(&self) {
+        let state = self.state.fetch_and(!WRITER, Ordering::SeqCst);
+        let woken = if state & READERS_WAITING != 0 {
+            self.wake_readers()
         } else {
-            Err(libc::EBUSY)
+            0
         };
-        self.lock.unlock();
-        ret
+        if woken == 0 && state & WRITERS_WAITING != 0 {
+            self.wake_writer();
+        }
     }
 
-    unsafe fn write(&mut self) -> SysError {
+    unsafe fn read(&self) -> SysError {
         let current = rsgx_thread_self();
+        let slot = &self.readers[reader_slot(current)].0;
+        if self.try_read_fast(slot) {
+            return Ok(());
+        }
+        if self.owner.load(Ordering::Relaxed) == current {
+            return Err(libc::EDEADLK);
+        }
 
-        self.lock.lock();
-        if self.owner == SGX_THREAD_T_NULL && self.reader_count == 0 {
-            self.owner = current;
-        } else {
-            if self.owner == current {
-                self.lock.unlock();
-                return Err(libc::EDEADLK);
+        let mut waiter = SgxThreadRwLockWaiter::new(current);
+        loop {
+            // Writers are expected to be short, so wait a little before
+            // paying for a park.
+            if spin_until(|| self.state.load(Ordering::Relaxed) & WRITER == 0)
+                && self.try_read_fast(slot)
+            {
+                return Ok(());
             }
 
-            self.writer_queue.push_back(current);
+            self.lock.lock();
+            self.queues().readers.push_back(&mut waiter);
+            self.state.fetch_or(READERS_WAITING, Ordering::SeqCst);
+            // The writer may have left between the fast path and the
+            // queueing; it checks READERS_WAITING only after clearing WRITER.
+            let blocked = self.state.load(Ordering::SeqCst) & WRITER != 0;
+            self.lock.unlock();
 
-            loop {
-                self.lock.unlock();
-                mutex::thread_wait_event(
-                    SgxThreadData::from_raw(current).get_tcs(),
-                    Duration::new(u64::MAX, 1_000_000_000 - 1),
-                );
+            if blocked {
+                wait_forever();
+            }
 
-                self.lock.lock();
-                if self.owner == SGX_THREAD_T_NULL && self.reader_count == 0 {
-                    self.owner = current;
-                    if let Some(pos) = self
-                        .writer_queue
-                        .iter()
-                        .position(|&waiter| waiter == current)
-                    {
-                        self.writer_queue.remove(pos);
-                    }
-                    break;
-                }
+            // Still queued if the writer was already gone, or if a stale
+            // event woke us early.
+            self.lock.lock();
+            let queues = self.queues();
+            queues.readers.remove(&mut waiter);
+            if queues.readers.is_empty() {
+                self.state.fetch_and(!READERS_WAITING, Ordering::SeqCst);
             }
+            self.lock.unlock();
         }
-        self.lock.unlock();
-        Ok(())
     }
 
-    unsafe fn try_write(&mut self) -> SysError {
-        let current = rsgx_thread_self();
-
-        self.lock.lock();
-        let ret = if self.owner == SGX_THREAD_T_NULL && self.reader_count == 0 {
-            self.owner = current;
+    unsafe fn try_read(&self) -> SysError {
+        let slot = &self.readers[reader_slot(rsgx_thread_self())].0;
+        if self.try_read_fast(slot) {
             Ok(())
         } else {
             Err(libc::EBUSY)
-        };
-        self.lock.unlock();
-        ret
+        }
     }
 
-    unsafe fn read_unlock(&mut self) -> SysError {
-        self.lock.lock();
-
-        if self.reader_count == 0 {
-            self.lock.unlock();
-            return Err(libc::EPERM);
+    unsafe fn write(&self) -> SysError {
+        let current = rsgx_thread_self();
+        if self.owner.load(Ordering::Relaxed) == current {
+            return Err(libc::EDEADLK);
+        }
+        if self.try_write_fast(current) {
+            return Ok(());
         }
 
-        self.reader_count -= 1;
-        if self.reader_count == 0 {
-            let waiter = self.reader_queue.front();
+        let mut waiter = SgxThreadRwLockWaiter::new(current);
+        loop {
+            if spin_until(|| self.state.load(Ordering::Relaxed) & WRITER == 0 && self.reader_count() == 0)
+                && self.try_write_fast(current)
+            {
+                return Ok(());
+            }
+
+            self.lock.lock();
+            self.queues().writers.push_back(&mut waiter);
+            self.state.fetch_or(WRITERS_WAITING, Ordering::SeqCst);
             self.lock.unlock();
-            if waiter.is_some() {
-                mutex::thread_set_event(SgxThreadData::from_raw(*waiter.unwrap()).get_tcs());
+
+            // Recheck now that leaving readers and writers can see us.
+            if self.state.load(Ordering::SeqCst) & WRITER != 0 || self.reader_count() != 0 {
+                wait_forever();
+            }
+
+            self.lock.lock();
+            let queues = self.queues();
+            queues.writers.remove(&mut waiter);
+            if queues.writers.is_empty() {
+                self.state.fetch_and(!(WRITERS_WAITING | WRITER_WOKEN), Ordering::SeqCst);
+            } else {
+                self.state.fetch_and(!WRITER_WOKEN, Ordering::SeqCst);
             }
-        } else {
             self.lock.unlock();
         }
-        Ok(())
     }
 
-    unsafe fn write_unlock(&mut self) -> SysError {
+    unsafe fn try_write(&self) -> SysError {
         let current = rsgx_thread_self();
+        if self.try_write_fast(current) {
+            Ok(())
+        } else {
+            Err(libc::EBUSY)
+        }
+    }
 
-        self.lock.lock();
-
-        if self.owner != current {
-            self.lock.unlock();
+    unsafe fn read_unlock(&self) -> SysError {
+        let slot = &self.readers[reader_slot(rsgx_thread_self())].0;
+        if slot.load(Ordering::Relaxed) == 0 {
             return Err(libc::EPERM);
         }
+        slot.fetch_sub(1, Ordering::SeqCst);
+        self.reader_left();
+        Ok(())
+    }
 
-        self.owner = SGX_THREAD_T_NULL;
-        if !self.reader_queue.is_empty() {
-            let mut tcs_vec: Vec<usize> = Vec::new();
-            for waiter in self.reader_queue.iter() {
-                tcs_vec.push(SgxThreadData::from_raw(*waiter).get_tcs())
-            }
-            self.lock.unlock();
-            mutex::thread_set_multiple_events(tcs_vec.as_slice());
-        } else {
-            let waiter = self.writer_queue.front();
-            self.lock.unlock();
-            if waiter.is_some() {
-                mutex::thread_set_event(SgxThreadData::from_raw(*waiter.unwrap()).get_tcs());
-            }
+    unsafe fn write_unlock(&self) -> SysError {
+        if self.owner.load(Ordering::Relaxed) != rsgx_thread_self() {
+            return Err(libc::EPERM);
         }
+        self.owner.store(SGX_THREAD_T_NULL, Ordering::Relaxed);
+        self.release_writer();
         Ok(())
     }
 
-    unsafe fn unlock(&mut self) -> SysError {
-        if self.owner == rsgx_thread_self() {
+    unsafe fn unlock(&self) -> SysError {
+        if self.owner.load(Ordering::Relaxed) == rsgx_thread_self() {
             self.write_unlock()
         } else {
             self.read_unlock()
         }
     }
 
-    unsafe fn destroy(&mut self) -> SysError {
+    unsafe fn destroy(&self) -> SysError {
         self.lock.lock();
-        let ret = if self.owner != SGX_THREAD_T_NULL
-            || self.reader_count != 0
-            || self.writer_waiting != 0
-            || !self.reader_queue.is_empty()
-            || !self.writer_queue.is_empty()
+        let queues = self.queues();
+        let ret = if self.state.load(Ordering::SeqCst) != 0
+            || self.reader_count() != 0
+            || !queues.readers.is_empty()
+            || !queues.writers.is_empty()
         {
             Err(libc::EBUSY)
         } else {
@@ -233,14 +507,14 @@ unsafe impl Sync for SgxThreadRwLock {}
 /// cross-platform binding of system rwlocks. It is recommended to use the
 /// safer types at the top level of this crate instead of this type.
 pub struct SgxThreadRwLock {
-    lock: UnsafeCell<SgxThreadRwLockInner>,
+    lock: SgxThreadRwLockInner,
 }
 
 impl SgxThreadRwLock {
     /// Creates a new reader-writer lock for use.
     pub const fn new() -> Self {
         SgxThreadRwLock {
-            lock: UnsafeCell::new(SgxThreadRwLockInner::new()),
+            lock: SgxThreadRwLockInner::new(),
         }
     }
 
@@ -248,8 +522,7 @@ impl SgxThreadRwLock {
     /// thread to do so.
     #[inline]
     pub unsafe fn read(&self) -> SysError {
-        let rwlock: &mut SgxThreadRwLockInner = &mut *self.lock.get();
-        rwlock.read()
+        self.lock.read()
     }
 
     /// Attempts to acquire shared access to this lock, returning whether it
@@ -258,16 +531,14 @@ impl SgxThreadRwLock {
     /// This function does not block the current thread.
     #[inline]
     pub unsafe fn try_read(&self) -> SysError {
-        let rwlock: &mut SgxThreadRwLockInner = &mut *self.lock.get();
-        rwlock.try_read()
+        self.lock.try_read()
     }
 
     /// Acquires write access to the underlying lock, blocking the current thread
     /// to do so.
     #[inline]
     pub unsafe fn write(&self) -> SysError {
-        let rwlock: &mut SgxThreadRwLockInner = &mut *self.lock.get();
-        rwlock.write()
+        self.lock.write()
     }
 
     /// Attempts to acquire exclusive access to this lock, returning whether it
@@ -276,34 +547,29 @@ impl SgxThreadRwLock {
     /// This function does not block the current thread.
     #[inline]
     pub unsafe fn try_write(&self) -> SysError {
-        let rwlock: &mut SgxThreadRwLockInner = &mut *self.lock.get();
-        rwlock.try_write()
+        self.lock.try_write()
     }
 
     /// Unlocks previously acquired shared access to this lock.
     #[inline]
     pub unsafe fn read_unlock(&self) -> SysError {
-        let rwlock: &mut SgxThreadRwLockInner = &mut *self.lock.get();
-        rwlock.read_unlock()
+        self.lock.read_unlock()
     }
 
     /// Unlocks previously acquired exclusive access to this lock.
     #[inline]
     pub unsafe fn write_unlock(&self) -> SysError {
-        let rwlock: &mut SgxThreadRwLockInner = &mut *self.lock.get();
-        rwlock.write_unlock()
+        self.lock.write_unlock()
     }
 
     #[inline]
     pub unsafe fn unlock(&self) -> SysError {
-        let rwlock: &mut SgxThreadRwLockInner = &mut *self.lock.get();
-        rwlock.unlock()
+        self.lock.unlock()
     }
 
     /// Destroys OS-related resources with this RWLock.
     #[inline]
     pub unsafe fn destroy(&self) -> SysError {
-        let rwlock: &mut SgxThreadRwLockInner = &mut *self.lock.get();
-        rwlock.destroy()
+        self.lock.destroy()
     }
 }
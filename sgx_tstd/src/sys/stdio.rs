@@ -47,10 +47,26 @@ impl Stdout {
 
 impl io::Write for Stdout {
     fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        #[cfg(feature = "async_log")]
+        {
+            if let Some(log) = crate::io::log::captured() {
+                return log.write_stream(libc::ocall::LOG_STREAM_STDOUT, buf);
+            }
+        }
         ManuallyDrop::new(FileDesc::new(libc::STDOUT_FILENO)).write(buf)
     }
 
     fn write_vectored(&mut self, bufs: &[IoSlice<'_>]) -> io::Result<usize> {
+        #[cfg(feature = "async_log")]
+        {
+            if let Some(log) = crate::io::log::captured() {
+                let mut written = 0;
+                for buf in bufs {
+                    written += log.write_stream(libc::ocall::LOG_STREAM_STDOUT, buf)?;
+                }
+                return Ok(written);
+            }
+        }
         ManuallyDrop::new(FileDesc::new(libc::STDOUT_FILENO)).write_vectored(bufs)
     }
 
@@ -67,10 +83,26 @@ impl Stderr {
 
 impl io::Write for Stderr {
     fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        #[cfg(feature = "async_log")]
+        {
+            if let Some(log) = crate::io::log::captured() {
+                return log.write_stream(libc::ocall::LOG_STREAM_STDERR, buf);
+            }
+        }
         ManuallyDrop::new(FileDesc::new(libc::STDERR_FILENO)).write(buf)
     }
 
     fn write_vectored(&mut self, bufs: &[IoSlice<'_>]) -> io::Result<usize> {
+        #[cfg(feature = "async_log")]
+        {
+            if let Some(log) = crate::io::log::captured() {
+                let mut written = 0;
+                for buf in bufs {
+                    written += log.write_stream(libc::ocall::LOG_STREAM_STDERR, buf)?;
+                }
+                return Ok(written);
+            }
+        }
         ManuallyDrop::new(FileDesc::new(libc::STDERR_FILENO)).write_vectored(bufs)
     }
 
@@ -85,6 +117,20 @@ pub fn is_ebadf(err: &io::Error) -> bool {
 
 pub const STDIN_BUF_SIZE: usize = crate::sys_common::io::DEFAULT_BUF_SIZE;
 
+// Panic messages bypass a captured stderr, as the enclave may abort before
+// the log is drained.
+struct PanicOutput;
+
+impl io::Write for PanicOutput {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        ManuallyDrop::new(FileDesc::new(libc::STDERR_FILENO)).write(buf)
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
 pub fn panic_output() -> Option<impl io::Write> {
-    Stderr::new().ok()
+    Some(PanicOutput)
 }
\ No newline at end of file
@@ -22,6 +22,8 @@ use core::convert::TryInto;
 use crate::time::Duration;
 pub use self::inner::{Instant, SystemTime, UNIX_EPOCH};
 
+pub mod tsc;
+
 const NSEC_PER_SEC: u64 = 1_000_000_000;
 
 #[derive(Copy, Clone)]
@@ -220,6 +222,9 @@ mod inner {
     }
 
     fn now(clock: libc::clockid_t) -> Timespec {
+        if let Some(t) = super::tsc::now(clock) {
+            return Timespec { t };
+        }
         let mut t = Timespec { t: libc::timespec { tv_sec: 0, tv_nsec: 0 } };
         cvt(unsafe { libc::clock_gettime(clock, &mut t.t) }).unwrap();
         t
@@ -0,0 +1,390 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! A clock interpolated from the TSC between occasional OCALLs.
+//!
+//! Each resync brackets one `clock_gettime(CLOCK_MONOTONIC)` OCALL with two
+//! RDTSC reads and records the pair as the new base. The tick rate comes from
+//! the distance between two bases, so it is measured over a whole resync
+//! interval and not just the width of one OCALL. Between resyncs a reading is
+//! `base_ns + (tsc - base_tsc) * rate`, with no enclave exit.
+//!
+//! At every resync the interpolated time is compared with the host's. If
+//! they differ by more than the allowed drift the interval is halved, and it
+//! grows back towards the configured value while the error stays small. A
+//! base that is more than two intervals old is not used at all, so a reading
+//! is never further from the last host time than that.
+//!
+//! RDTSC is only legal inside an enclave on SGX2 hardware, so the clock has
+//! to be switched on explicitly and refuses to start without SGX2. The SGX2
+//! bit comes from CPUID, which the host answers through an OCALL, so it is
+//! not taken on trust: one RDTSC is executed under an exception handler
+//! first, and a #UD from it keeps the clock off.
+
+use crate::io;
+use crate::time::Duration;
+use core::arch::x86_64::_rdtsc;
+use core::ptr;
+use core::sync::atomic::{fence, spin_loop_hint, AtomicBool, AtomicI64, AtomicU32, AtomicU64, AtomicU8, Ordering};
+use sgx_trts::cpuid::rsgx_cpuidex;
+use sgx_trts::veh::{rsgx_register_exception_handler, rsgx_unregister_exception_handler};
+use sgx_types::{sgx_exception_info_t, sgx_exception_vector_t, EXCEPTION_CONTINUE_EXECUTION, EXCEPTION_CONTINUE_SEARCH};
+
+const NSEC_PER_SEC: u64 = 1_000_000_000;
+
+// The rate is only computed from bases at least this far apart.
+const MIN_CALIBRATION_NS: u64 = 1_000_000;
+// How long `enable` waits between its two calibration samples. The doc of
+// `untrusted::time::set_clock_source` quotes this value.
+const CALIBRATION_NS: u64 = 5_000_000;
+// The adaptive interval never drops below this.
+const MIN_RESYNC_NS: u64 = 1_000_000;
+
+pub const DEFAULT_RESYNC_NS: u64 = 100_000_000;
+pub const DEFAULT_MAX_DRIFT_NS: u64 = 50_000;
+
+static ENABLED: AtomicBool = AtomicBool::new(false);
+static SYNCING: AtomicBool = AtomicBool::new(false);
+static RESYNC_NS: AtomicU64 = AtomicU64::new(DEFAULT_RESYNC_NS);
+static MAX_DRIFT_NS: AtomicU64 = AtomicU64::new(DEFAULT_MAX_DRIFT_NS);
+// Largest monotonic reading handed out, so `Instant` never goes backwards
+// when a resync pulls the clock back.
+static LAST_NS: AtomicU64 = AtomicU64::new(0);
+
+// Written by the thread holding SYNCING only.
+static CUR_RESYNC_NS: AtomicU64 = AtomicU64::new(DEFAULT_RESYNC_NS);
+static ANCHOR_TSC: AtomicU64 = AtomicU64::new(0);
+static ANCHOR_NS: AtomicU64 = AtomicU64::new(0);
+
+// The current base, published under a sequence lock.
+static SEQ: AtomicU32 = AtomicU32::new(0);
+static BASE_TSC: AtomicU64 = AtomicU64::new(0);
+static BASE_NS: AtomicU64 = AtomicU64::new(0);
+static MULT: AtomicU64 = AtomicU64::new(0);
+static RT_OFFSET: AtomicI64 = AtomicI64::new(0);
+static RESYNC_TICKS: AtomicU64 = AtomicU64::new(0);
+
+#[derive(Copy, Clone)]
+struct Calibration {
+    base_tsc: u64,
+    base_ns: u64,
+    // Nanoseconds per tick as a 32.32 fixed-point number. Zero until the
+    // rate is known.
+    mult: u64,
+    rt_offset: i64,
+    resync_ticks: u64,
+}
+
+impl Calibration {
+    fn interpolate(&self, tsc: u64) -> u64 {
+        if tsc <= self.base_tsc {
+            return self.base_ns;
+        }
+        let delta = ((tsc - self.base_tsc) as u128 * self.mult as u128) >> 32;
+        self.base_ns.saturating_add(delta as u64)
+    }
+
+    fn age(&self, tsc: u64) -> u64 {
+        tsc.saturating_sub(self.base_tsc)
+    }
+}
+
+#[inline]
+fn rdtsc() -> u64 {
+    unsafe { _rdtsc() }
+}
+
+fn load() -> Calibration {
+    loop {
+        let seq = SEQ.load(Ordering::Acquire);
+        if seq & 1 != 0 {
+            spin_loop_hint();
+            continue;
+        }
+        let cal = Calibration {
+            base_tsc: BASE_TSC.load(Ordering::Relaxed),
+            base_ns: BASE_NS.load(Ordering::Relaxed),
+            mult: MULT.load(Ordering::Relaxed),
+            rt_offset: RT_OFFSET.load(Ordering::Relaxed),
+            resync_ticks: RESYNC_TICKS.load(Ordering::Relaxed),
+        };
+        fence(Ordering::Acquire);
+        if SEQ.load(Ordering::Relaxed) == seq {
+            return cal;
+        }
+    }
+}
+
+fn store(cal: &Calibration) {
+    let seq = SEQ.load(Ordering::Relaxed);
+    SEQ.store(seq.wrapping_add(1), Ordering::Relaxed);
+    fence(Ordering::Release);
+    BASE_TSC.store(cal.base_tsc, Ordering::Relaxed);
+    BASE_NS.store(cal.base_ns, Ordering::Relaxed);
+    MULT.store(cal.mult, Ordering::Relaxed);
+    RT_OFFSET.store(cal.rt_offset, Ordering::Relaxed);
+    RESYNC_TICKS.store(cal.resync_ticks, Ordering::Relaxed);
+    SEQ.store(seq.wrapping_add(2), Ordering::Release);
+}
+
+fn host_ns(clock: libc::clockid_t) -> Option<u64> {
+    let mut t = libc::timespec { tv_sec: 0, tv_nsec: 0 };
+    if unsafe { libc::clock_gettime(clock, &mut t) } != 0 || t.tv_sec < 0 {
+        return None;
+    }
+    Some(t.tv_sec as u64 * NSEC_PER_SEC + t.tv_nsec as u64)
+}
+
+fn ns_to_ticks(ns: u64, mult: u64) -> u64 {
+    if mult == 0 {
+        return 0;
+    }
+    let ticks = ((ns as u128) << 32) / mult as u128;
+    if ticks > u64::MAX as u128 { u64::MAX } else { ticks as u64 }
+}
+
+// Takes a new base from the host and returns the host's monotonic time and
+// realtime offset. Only one thread resyncs at a time; the others keep
+// interpolating from the old base meanwhile.
+fn resync() -> Option<(u64, i64)> {
+    if SYNCING
+        .compare_exchange(false, true, Ordering::Acquire, Ordering::Relaxed)
+        .is_err()
+    {
+        return None;
+    }
+    let fresh = resync_locked();
+    SYNCING.store(false, Ordering::Release);
+    fresh
+}
+
+fn resync_locked() -> Option<(u64, i64)> {
+    let t0 = rdtsc();
+    let mono = host_ns(libc::CLOCK_MONOTONIC)?;
+    let t1 = rdtsc();
+    let real = host_ns(libc::CLOCK_REALTIME)?;
+    if t1 < t0 {
+        return None;
+    }
+    let tsc = t0 + (t1 - t0) / 2;
+
+    let old = load();
+    let mut mult = old.mult;
+    let anchor_tsc = ANCHOR_TSC.load(Ordering::Relaxed);
+    let anchor_ns = ANCHOR_NS.load(Ordering::Relaxed);
+    if anchor_tsc == 0 || tsc <= anchor_tsc || mono <= anchor_ns {
+        // First sample, or the host clock or the TSC went backwards.
+        mult = 0;
+        ANCHOR_TSC.store(tsc, Ordering::Relaxed);
+        ANCHOR_NS.store(mono, Ordering::Relaxed);
+    } else if mono - anchor_ns >= MIN_CALIBRATION_NS {
+        let rate = ((((mono - anchor_ns) as u128) << 32) / (tsc - anchor_tsc) as u128) as u64;
+        if old.mult != 0 {
+            let predicted = old.interpolate(tsc);
+            let drift = if predicted > mono { predicted - mono } else { mono - predicted };
+            let limit = MAX_DRIFT_NS.load(Ordering::Relaxed);
+            let cur = CUR_RESYNC_NS.load(Ordering::Relaxed);
+            let next = if drift > limit {
+                cur / 2
+            } else if drift < limit / 4 {
+                cur.saturating_mul(2)
+            } else {
+                cur
+            };
+            let next = next.max(MIN_RESYNC_NS).min(RESYNC_NS.load(Ordering::Relaxed));
+            CUR_RESYNC_NS.store(next, Ordering::Relaxed);
+        }
+        mult = rate;
+        ANCHOR_TSC.store(tsc, Ordering::Relaxed);
+        ANCHOR_NS.store(mono, Ordering::Relaxed);
+    }
+
+    let rt_offset = real as i64 - mono as i64;
+    store(&Calibration {
+        base_tsc: tsc,
+        base_ns: mono,
+        mult,
+        rt_offset,
+        resync_ticks: ns_to_ticks(CUR_RESYNC_NS.load(Ordering::Relaxed), mult),
+    });
+    Some((mono, rt_offset))
+}
+
+/// Returns the time for `clock` without leaving the enclave, or `None` if
+/// the clock is off, not calibrated yet, or asked for a clock it does not
+/// keep. Callers fall back to the `clock_gettime` OCALL on `None`.
+pub fn now(clock: libc::clockid_t) -> Option<libc::timespec> {
+    if !ENABLED.load(Ordering::Relaxed) {
+        return None;
+    }
+    if clock != libc::CLOCK_MONOTONIC && clock != libc::CLOCK_REALTIME {
+        return None;
+    }
+
+    let tsc = rdtsc();
+    let cal = load();
+    let fresh = if cal.mult == 0 || cal.age(tsc) >= cal.resync_ticks {
+        resync()
+    } else {
+        None
+    };
+    let (mono, rt_offset) = match fresh {
+        Some(fresh) => fresh,
+        // Someone else is resyncing or the host call failed. Keep using the
+        // old base unless it is more than two intervals old.
+        None if cal.mult != 0 && cal.age(tsc) / 2 < cal.resync_ticks => {
+            (cal.interpolate(tsc), cal.rt_offset)
+        }
+        None => return None,
+    };
+
+    let ns = if clock == libc::CLOCK_MONOTONIC {
+        let last = LAST_NS.fetch_max(mono, Ordering::Relaxed);
+        if last > mono { last } else { mono }
+    } else {
+        (mono as i64).saturating_add(rt_offset).max(0) as u64
+    };
+    Some(libc::timespec {
+        tv_sec: (ns / NSEC_PER_SEC) as libc::time_t,
+        tv_nsec: (ns % NSEC_PER_SEC) as libc::c_long,
+    })
+}
+
+fn duration_ns(d: Duration) -> u64 {
+    let ns = d.as_nanos();
+    if ns > u64::MAX as u128 { u64::MAX } else { ns as u64 }
+}
+
+// Result of the RDTSC probe: unknown, usable or faulting.
+const PROBE_UNKNOWN: u8 = 0;
+const PROBE_OK: u8 = 1;
+const PROBE_FAULT: u8 = 2;
+
+static RDTSC_PROBE: AtomicU8 = AtomicU8::new(PROBE_UNKNOWN);
+static RDTSC_FAULTED: AtomicBool = AtomicBool::new(false);
+
+fn sgx2_reported() -> bool {
+    // CPUID.(EAX=12H,ECX=0):EAX[1] reports SGX2, which is what makes RDTSC
+    // legal in enclave mode.
+    match rsgx_cpuidex(0x12, 0) {
+        Ok(info) => info[0] & 0x2 != 0,
+        Err(_) => false,
+    }
+}
+
+// Skips an RDTSC that raised #UD, leaving zero in EDX:EAX.
+extern "C" fn rdtsc_fault_handler(info: *mut sgx_exception_info_t) -> i32 {
+    let info = unsafe { &mut *info };
+    if info.exception_vector != sgx_exception_vector_t::SGX_EXCEPTION_VECTOR_UD {
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+    let rip = info.cpu_context.rip as *const [u8; 2];
+    if unsafe { *rip } != [0x0f, 0x31] {
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+    info.cpu_context.rip += 2;
+    info.cpu_context.rax = 0;
+    info.cpu_context.rdx = 0;
+    RDTSC_FAULTED.store(true, Ordering::Relaxed);
+    EXCEPTION_CONTINUE_EXECUTION
+}
+
+fn probe_rdtsc() -> bool {
+    let handle = match rsgx_register_exception_handler(1, rdtsc_fault_handler) {
+        Some(handle) => handle,
+        None => return false,
+    };
+    RDTSC_FAULTED.store(false, Ordering::Relaxed);
+    let mut sink = 0;
+    unsafe { ptr::write_volatile(&mut sink, rdtsc()) };
+    let faulted = RDTSC_FAULTED.load(Ordering::Relaxed);
+    rsgx_unregister_exception_handler(handle);
+    !faulted
+}
+
+/// Whether RDTSC can be executed in this enclave.
+///
+/// The host answers CPUID and could claim SGX2 on an SGX1 part, where
+/// RDTSC raises #UD. So the CPUID answer is only used to rule RDTSC out,
+/// and otherwise one RDTSC is run under an exception handler that skips it
+/// if it faults. The outcome is kept for the life of the enclave.
+pub(crate) fn rdtsc_supported() -> bool {
+    match RDTSC_PROBE.load(Ordering::Acquire) {
+        PROBE_OK => return true,
+        PROBE_FAULT => return false,
+        _ => {}
+    }
+    let ok = sgx2_reported() && probe_rdtsc();
+    RDTSC_PROBE.store(if ok { PROBE_OK } else { PROBE_FAULT }, Ordering::Release);
+    ok
+}
+
+pub fn enable(resync_interval: Duration, max_drift: Duration) -> io::Result<()> {
+    if !rdtsc_supported() {
+        return Err(io::Error::new(
+            io::ErrorKind::Other,
+            "the TSC clock needs SGX2 to read the TSC inside an enclave",
+        ));
+    }
+    let resync_ns = duration_ns(resync_interval).max(MIN_RESYNC_NS);
+    RESYNC_NS.store(resync_ns, Ordering::Relaxed);
+    MAX_DRIFT_NS.store(duration_ns(max_drift), Ordering::Relaxed);
+    // The first rate comes from a short baseline, so start with a short
+    // interval and let it grow as the drift proves small.
+    CUR_RESYNC_NS.store(resync_ns.min(2 * CALIBRATION_NS), Ordering::Relaxed);
+
+    // Measure the tick rate up front instead of paying two OCALLs per
+    // reading until the first interval has passed.
+    if !is_enabled() {
+        let _ = resync();
+        // Spin rather than sleep, as nanosleep lives in sgx_thread.edl and
+        // not every enclave imports it.
+        let start = host_ns(libc::CLOCK_MONOTONIC).unwrap_or(0);
+        loop {
+            for _ in 0..1000 {
+                spin_loop_hint();
+            }
+            match host_ns(libc::CLOCK_MONOTONIC) {
+                Some(ns) if ns.saturating_sub(start) < CALIBRATION_NS => {}
+                _ => break,
+            }
+        }
+        let _ = resync();
+    }
+    ENABLED.store(true, Ordering::Release);
+    Ok(())
+}
+
+pub fn disable() {
+    ENABLED.store(false, Ordering::Release);
+}
+
+pub fn is_enabled() -> bool {
+    ENABLED.load(Ordering::Acquire)
+}
+
+pub fn config() -> (Duration, Duration) {
+    (
+        Duration::from_nanos(RESYNC_NS.load(Ordering::Relaxed)),
+        Duration::from_nanos(MAX_DRIFT_NS.load(Ordering::Relaxed)),
+    )
+}
+
+mod libc {
+    pub use sgx_trts::libc::*;
+    pub use sgx_trts::libc::ocall::clock_gettime;
+}
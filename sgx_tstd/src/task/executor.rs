@@ -0,0 +1,523 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! A single-threaded task executor.
+//!
+//! Tasks run on the thread that calls `block_on`. When none of them can make
+//! progress the thread blocks in one `epoll_wait` OCALL for all sockets
+//! registered with the executor's reactor, instead of one blocking OCALL per
+//! connection. Wakers are `Send` and may be used from other enclave threads;
+//! they wake the executor through the poller's notification socket only
+//! when it is actually blocked.
+
+use core::cell::{RefCell, UnsafeCell};
+use core::fmt;
+use core::future::Future;
+use core::mem::{self, ManuallyDrop};
+use core::pin::Pin;
+use core::sync::atomic::{AtomicBool, AtomicU8, Ordering};
+use core::task::{Context, Poll, RawWaker, RawWakerVTable, Waker};
+use alloc_crate::collections::VecDeque;
+use alloc_crate::rc::{Rc, Weak};
+use alloc_crate::vec::Vec;
+use crate::io;
+use crate::sync::{Arc, SgxMutex};
+use crate::time::Duration;
+use super::reactor::Reactor;
+
+// Tasks polled before the reactor is checked for new events, so that a busy
+// run queue cannot starve I/O.
+const POLL_BUDGET: usize = 128;
+
+thread_local! {
+    static CURRENT: RefCell<Option<Rc<Local>>> = RefCell::new(None);
+}
+
+/// Returns the reactor of the executor running on this thread.
+pub(crate) fn current_reactor() -> io::Result<Arc<Reactor>> {
+    CURRENT.with(|current| match *current.borrow() {
+        Some(ref local) => Ok(local.shared.reactor.clone()),
+        None => Err(io::Error::new(io::ErrorKind::Other,
+                                   "no executor is running on this thread")),
+    })
+}
+
+trait ArcWake: Send + Sync + 'static {
+    fn wake_by_ref(this: &Arc<Self>);
+}
+
+fn waker_vtable<W: ArcWake>() -> &'static RawWakerVTable {
+    &RawWakerVTable::new(
+        clone_arc_raw::<W>,
+        wake_arc_raw::<W>,
+        wake_by_ref_arc_raw::<W>,
+        drop_arc_raw::<W>,
+    )
+}
+
+fn waker<W: ArcWake>(wake: Arc<W>) -> Waker {
+    let ptr = Arc::into_raw(wake) as *const ();
+    unsafe { Waker::from_raw(RawWaker::new(ptr, waker_vtable::<W>())) }
+}
+
+unsafe fn clone_arc_raw<W: ArcWake>(data: *const ()) -> RawWaker {
+    let arc = ManuallyDrop::new(Arc::<W>::from_raw(data as *const W));
+    mem::forget(Arc::clone(&arc));
+    RawWaker::new(data, waker_vtable::<W>())
+}
+
+unsafe fn wake_arc_raw<W: ArcWake>(data: *const ()) {
+    let arc = Arc::<W>::from_raw(data as *const W);
+    ArcWake::wake_by_ref(&arc);
+}
+
+unsafe fn wake_by_ref_arc_raw<W: ArcWake>(data: *const ()) {
+    let arc = ManuallyDrop::new(Arc::<W>::from_raw(data as *const W));
+    ArcWake::wake_by_ref(&arc);
+}
+
+unsafe fn drop_arc_raw<W: ArcWake>(data: *const ()) {
+    drop(Arc::<W>::from_raw(data as *const W));
+}
+
+// State shared with wakers, which may live on other threads.
+struct Shared {
+    reactor: Arc<Reactor>,
+    queue: SgxMutex<VecDeque<Arc<Task>>>,
+    parked: AtomicBool,
+}
+
+impl Shared {
+    fn schedule(&self, task: Arc<Task>) {
+        self.queue.lock().unwrap().push_back(task);
+        self.unpark();
+    }
+
+    fn unpark(&self) {
+        // Pairs with the store in `park`: either the executor sees the new
+        // work before blocking, or we see it parked and interrupt the wait.
+        if self.parked.load(Ordering::SeqCst) {
+            let _ = self.reactor.notify();
+        }
+    }
+
+    fn has_work(&self) -> bool {
+        !self.queue.lock().unwrap().is_empty()
+    }
+}
+
+const IDLE: u8 = 0;
+const SCHEDULED: u8 = 1;
+const RUNNING: u8 = 2;
+const NOTIFIED: u8 = 3;
+const COMPLETE: u8 = 4;
+
+type LocalFuture = Pin<Box<dyn Future<Output = ()> + 'static>>;
+
+struct Task {
+    shared: Arc<Shared>,
+    state: AtomicU8,
+    index: usize,
+    future: UnsafeCell<Option<LocalFuture>>,
+}
+
+// The future is only ever polled or dropped by the thread owning the
+// executor (see `Executor::run_task` and `Drop for Local`); other threads
+// only touch `state` and the shared queue through the waker.
+unsafe impl Send for Task {}
+unsafe impl Sync for Task {}
+
+impl ArcWake for Task {
+    fn wake_by_ref(this: &Arc<Self>) {
+        let mut state = this.state.load(Ordering::Acquire);
+        loop {
+            let next = match state {
+                IDLE => SCHEDULED,
+                RUNNING => NOTIFIED,
+                _ => return,
+            };
+            match this.state.compare_exchange_weak(state, next, Ordering::AcqRel, Ordering::Acquire) {
+                Ok(_) => break,
+                Err(actual) => state = actual,
+            }
+        }
+        if state == IDLE {
+            this.shared.schedule(this.clone());
+        }
+    }
+}
+
+struct MainWake {
+    shared: Arc<Shared>,
+    woken: AtomicBool,
+}
+
+impl ArcWake for MainWake {
+    fn wake_by_ref(this: &Arc<Self>) {
+        if !this.woken.swap(true, Ordering::SeqCst) {
+            this.shared.unpark();
+        }
+    }
+}
+
+// State only touched by the owning thread.
+struct Local {
+    shared: Arc<Shared>,
+    tasks: RefCell<Vec<Option<Arc<Task>>>>,
+    free: RefCell<Vec<usize>>,
+}
+
+impl Local {
+    fn spawn<F>(&self, future: F) -> JoinHandle<F::Output>
+    where
+        F: Future + 'static,
+    {
+        let join = Rc::new(RefCell::new(JoinState {
+            output: None,
+            waker: None,
+        }));
+        let future = Spawned { future, join: join.clone() };
+
+        let index = match self.free.borrow_mut().pop() {
+            Some(index) => index,
+            None => {
+                let mut tasks = self.tasks.borrow_mut();
+                tasks.push(None);
+                tasks.len() - 1
+            }
+        };
+        let task = Arc::new(Task {
+            shared: self.shared.clone(),
+            state: AtomicU8::new(SCHEDULED),
+            index,
+            future: UnsafeCell::new(Some(Box::pin(future))),
+        });
+        self.tasks.borrow_mut()[index] = Some(task.clone());
+        self.shared.schedule(task);
+
+        JoinHandle { join }
+    }
+
+    fn run_task(&self, task: Arc<Task>) {
+        task.state.store(RUNNING, Ordering::Release);
+
+        let waker = waker(task.clone());
+        let mut cx = Context::from_waker(&waker);
+        let done = {
+            let future = unsafe { &mut *task.future.get() };
+            match future {
+                Some(f) => f.as_mut().poll(&mut cx).is_ready(),
+                None => return,
+            }
+        };
+
+        if done {
+            task.state.store(COMPLETE, Ordering::Release);
+            // Drop the future here, on the owning thread.
+            let future = unsafe { (*task.future.get()).take() };
+            drop(future);
+            self.tasks.borrow_mut()[task.index] = None;
+            self.free.borrow_mut().push(task.index);
+            return;
+        }
+
+        if task.state.compare_exchange(RUNNING, IDLE, Ordering::AcqRel, Ordering::Acquire).is_err() {
+            // Woken while running.
+            task.state.store(SCHEDULED, Ordering::Release);
+            self.shared.queue.lock().unwrap().push_back(task);
+        }
+    }
+
+    // Polls queued tasks; returns false once the queue is empty.
+    fn run_queued(&self) -> bool {
+        for _ in 0..POLL_BUDGET {
+            let task = self.shared.queue.lock().unwrap().pop_front();
+            match task {
+                Some(task) => self.run_task(task),
+                None => return false,
+            }
+        }
+        self.shared.has_work()
+    }
+
+    fn park(&self, main: &MainWake) -> io::Result<()> {
+        let shared = &*self.shared;
+        shared.parked.store(true, Ordering::SeqCst);
+        let timeout = if shared.has_work() || main.woken.load(Ordering::SeqCst) {
+            Some(Duration::from_secs(0))
+        } else {
+            None
+        };
+        let res = shared.reactor.poll_events(timeout);
+        shared.parked.store(false, Ordering::SeqCst);
+        res?;
+        shared.reactor.dispatch();
+        Ok(())
+    }
+}
+
+impl Drop for Local {
+    fn drop(&mut self) {
+        // Break the cycles through the queue and the reactor's wakers, and
+        // drop the pending futures on this thread.
+        self.shared.queue.lock().unwrap().clear();
+        let tasks = mem::replace(&mut *self.tasks.borrow_mut(), Vec::new());
+        for task in tasks.into_iter().flatten() {
+            task.state.store(COMPLETE, Ordering::Release);
+            let future = unsafe { (*task.future.get()).take() };
+            drop(future);
+        }
+    }
+}
+
+struct EnterGuard;
+
+impl EnterGuard {
+    fn new(local: Rc<Local>) -> io::Result<EnterGuard> {
+        CURRENT.with(|current| {
+            let mut current = current.borrow_mut();
+            if current.is_some() {
+                return Err(io::Error::new(io::ErrorKind::Other,
+                                          "cannot block on a future inside an executor"));
+            }
+            *current = Some(local);
+            Ok(EnterGuard)
+        })
+    }
+}
+
+impl Drop for EnterGuard {
+    fn drop(&mut self) {
+        let _ = CURRENT.try_with(|current| current.borrow_mut().take());
+    }
+}
+
+/// A single-threaded executor for futures doing socket I/O.
+///
+/// All tasks spawned on an executor are polled by the thread calling
+/// [`block_on`]. The sockets in [`net`] that are created inside the executor
+/// register with its reactor, so a single enclave thread can multiplex
+/// thousands of connections over one `epoll_wait` OCALL.
+///
+/// The executor is not `Send`; its tasks need not be `Send` either.
+///
+/// [`block_on`]: #method.block_on
+/// [`net`]: ../net/index.html
+pub struct Executor {
+    local: Rc<Local>,
+}
+
+impl Executor {
+    /// Creates an executor with a fresh epoll reactor.
+    pub fn new() -> io::Result<Executor> {
+        let shared = Arc::new(Shared {
+            reactor: Arc::new(Reactor::new()?),
+            queue: SgxMutex::new(VecDeque::new()),
+            parked: AtomicBool::new(false),
+        });
+        Ok(Executor {
+            local: Rc::new(Local {
+                shared,
+                tasks: RefCell::new(Vec::new()),
+                free: RefCell::new(Vec::new()),
+            }),
+        })
+    }
+
+    /// Spawns a task. It starts running at the next `block_on`.
+    pub fn spawn<F>(&self, future: F) -> JoinHandle<F::Output>
+    where
+        F: Future + 'static,
+    {
+        self.local.spawn(future)
+    }
+
+    /// Returns a handle that spawns tasks onto this executor.
+    pub fn spawner(&self) -> Spawner {
+        Spawner { local: Rc::downgrade(&self.local) }
+    }
+
+    /// Returns the number of spawned tasks that have not completed yet.
+    pub fn pending(&self) -> usize {
+        self.local.tasks.borrow().iter().filter(|t| t.is_some()).count()
+    }
+
+    /// Runs `future` and all spawned tasks until `future` completes.
+    ///
+    /// Tasks that are still pending when it returns stay on the executor and
+    /// resume at the next call. An error is returned if the reactor fails or
+    /// if called from within a running executor.
+    pub fn block_on<F: Future>(&self, future: F) -> io::Result<F::Output> {
+        let _enter = EnterGuard::new(self.local.clone())?;
+
+        let main = Arc::new(MainWake {
+            shared: self.local.shared.clone(),
+            woken: AtomicBool::new(true),
+        });
+        let waker = waker(main.clone());
+        let mut cx = Context::from_waker(&waker);
+
+        let mut future = future;
+        let mut future = unsafe { Pin::new_unchecked(&mut future) };
+
+        loop {
+            if main.woken.swap(false, Ordering::SeqCst) {
+                if let Poll::Ready(output) = future.as_mut().poll(&mut cx) {
+                    return Ok(output);
+                }
+            }
+            if self.local.run_queued() {
+                // Still busy, only pick up I/O events that are already in.
+                let reactor = &self.local.shared.reactor;
+                reactor.poll_events(Some(Duration::from_secs(0)))?;
+                reactor.dispatch();
+                continue;
+            }
+            if main.woken.load(Ordering::SeqCst) {
+                continue;
+            }
+            self.local.park(&main)?;
+        }
+    }
+}
+
+impl fmt::Debug for Executor {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("Executor").field("pending", &self.pending()).finish()
+    }
+}
+
+/// A handle for spawning tasks onto an [`Executor`] from inside its tasks.
+///
+/// The handle does not keep the executor alive.
+///
+/// [`Executor`]: struct.Executor.html
+#[derive(Clone)]
+pub struct Spawner {
+    local: Weak<Local>,
+}
+
+impl Spawner {
+    /// Spawns a task onto the executor this handle was created from.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the executor has been dropped.
+    pub fn spawn<F>(&self, future: F) -> JoinHandle<F::Output>
+    where
+        F: Future + 'static,
+    {
+        match self.local.upgrade() {
+            Some(local) => local.spawn(future),
+            None => panic!("executor has been dropped"),
+        }
+    }
+}
+
+impl fmt::Debug for Spawner {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.pad("Spawner { .. }")
+    }
+}
+
+/// Spawns a task onto the executor running on the current thread.
+///
+/// # Panics
+///
+/// Panics if called outside of [`Executor::block_on`].
+///
+/// [`Executor::block_on`]: struct.Executor.html#method.block_on
+pub fn spawn<F>(future: F) -> JoinHandle<F::Output>
+where
+    F: Future + 'static,
+{
+    let local = CURRENT.with(|current| current.borrow().clone());
+    match local {
+        Some(local) => local.spawn(future),
+        None => panic!("`spawn` called outside of an executor"),
+    }
+}
+
+/// Runs a future to completion on a new [`Executor`].
+///
+/// [`Executor`]: struct.Executor.html
+pub fn block_on<F: Future>(future: F) -> io::Result<F::Output> {
+    Executor::new()?.block_on(future)
+}
+
+struct JoinState<T> {
+    output: Option<T>,
+    waker: Option<Waker>,
+}
+
+struct Spawned<F: Future> {
+    future: F,
+    join: Rc<RefCell<JoinState<F::Output>>>,
+}
+
+impl<F: Future> Future for Spawned<F> {
+    type Output = ();
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<()> {
+        let this = unsafe { self.get_unchecked_mut() };
+        let future = unsafe { Pin::new_unchecked(&mut this.future) };
+        match future.poll(cx) {
+            Poll::Ready(output) => {
+                let waker = {
+                    let mut join = this.join.borrow_mut();
+                    join.output = Some(output);
+                    join.waker.take()
+                };
+                if let Some(waker) = waker {
+                    waker.wake();
+                }
+                Poll::Ready(())
+            }
+            Poll::Pending => Poll::Pending,
+        }
+    }
+}
+
+/// An owned permission to await the output of a spawned task.
+///
+/// Dropping the handle detaches the task, which keeps running.
+pub struct JoinHandle<T> {
+    join: Rc<RefCell<JoinState<T>>>,
+}
+
+impl<T> Future for JoinHandle<T> {
+    type Output = T;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<T> {
+        let mut join = self.join.borrow_mut();
+        match join.output.take() {
+            Some(output) => Poll::Ready(output),
+            None => {
+                join.waker = Some(cx.waker().clone());
+                Poll::Pending
+            }
+        }
+    }
+}
+
+impl<T> Unpin for JoinHandle<T> {}
+
+impl<T> fmt::Debug for JoinHandle<T> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.pad("JoinHandle { .. }")
+    }
+}
@@ -0,0 +1,33 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Types and Traits for working with asynchronous tasks.
+//!
+//! With the `net` feature this module also provides a single-threaded
+//! executor driven by an epoll reactor, so that one enclave thread can serve
+//! many sockets without one blocking OCALL per connection. See [`Executor`].
+
+#[doc(inline)]
+pub use core::task::*;
+
+#[cfg(feature = "net")]
+pub(crate) mod executor;
+#[cfg(feature = "net")]
+pub(crate) mod reactor;
+
+#[cfg(feature = "net")]
+pub use self::executor::{block_on, spawn, Executor, JoinHandle, Spawner};
@@ -0,0 +1,306 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Readiness tracking on top of the epoll poller.
+//!
+//! Every registered descriptor gets a `ScheduledIo` holding its last known
+//! readiness and the wakers of the tasks waiting on it. Readiness is only
+//! cleared by the I/O operation that observed `EWOULDBLOCK`, and each update
+//! from epoll bumps a tick so that a clear never discards an event that
+//! arrived after the failed attempt.
+
+use sgx_trts::libc::c_int;
+use core::sync::atomic::{AtomicUsize, Ordering};
+use core::task::{Context, Poll, Waker};
+use alloc_crate::vec::Vec;
+use crate::io;
+use crate::sync::{Arc, SgxMutex};
+use crate::sys::reactor::{self as imp, Event, Poller};
+use crate::time::Duration;
+
+const EVENTS_CAPACITY: usize = 1024;
+
+const READ: usize = 0b01;
+const WRITE: usize = 0b10;
+const READY_MASK: usize = READ | WRITE;
+const TICK_SHIFT: usize = 16;
+
+#[derive(Copy, Clone, PartialEq, Eq, Debug)]
+pub enum Direction {
+    Read,
+    Write,
+}
+
+impl Direction {
+    fn mask(self) -> usize {
+        match self {
+            Direction::Read => READ,
+            Direction::Write => WRITE,
+        }
+    }
+}
+
+#[derive(Default)]
+struct Waiters {
+    reader: Option<Waker>,
+    writer: Option<Waker>,
+}
+
+pub struct ScheduledIo {
+    token: u64,
+    readiness: AtomicUsize,
+    waiters: SgxMutex<Waiters>,
+}
+
+impl ScheduledIo {
+    fn set_readiness(&self, ready: usize) {
+        let mut cur = self.readiness.load(Ordering::Acquire);
+        loop {
+            let tick = (cur >> TICK_SHIFT).wrapping_add(1);
+            let new = (tick << TICK_SHIFT) | (cur & READY_MASK) | ready;
+            match self.readiness.compare_exchange_weak(cur, new, Ordering::AcqRel, Ordering::Acquire) {
+                Ok(_) => return,
+                Err(actual) => cur = actual,
+            }
+        }
+    }
+
+    fn clear_readiness(&self, snapshot: usize, dir: Direction) {
+        let mut cur = self.readiness.load(Ordering::Acquire);
+        // A newer tick means epoll reported the descriptor again after the
+        // attempt that failed; keep that readiness.
+        while cur >> TICK_SHIFT == snapshot >> TICK_SHIFT {
+            let new = cur & !dir.mask();
+            match self.readiness.compare_exchange_weak(cur, new, Ordering::AcqRel, Ordering::Acquire) {
+                Ok(_) => return,
+                Err(actual) => cur = actual,
+            }
+        }
+    }
+
+    fn poll_ready(&self, cx: &mut Context<'_>, dir: Direction) -> Poll<usize> {
+        let cur = self.readiness.load(Ordering::Acquire);
+        if cur & dir.mask() != 0 {
+            return Poll::Ready(cur);
+        }
+
+        {
+            let mut waiters = self.waiters.lock().unwrap();
+            let slot = match dir {
+                Direction::Read => &mut waiters.reader,
+                Direction::Write => &mut waiters.writer,
+            };
+            match slot {
+                Some(ref w) if w.will_wake(cx.waker()) => {}
+                _ => *slot = Some(cx.waker().clone()),
+            }
+        }
+
+        // Readiness may have been set between the first check and storing
+        // the waker; the dispatcher takes the waiters lock after updating it.
+        let cur = self.readiness.load(Ordering::Acquire);
+        if cur & dir.mask() != 0 {
+            Poll::Ready(cur)
+        } else {
+            Poll::Pending
+        }
+    }
+
+    fn take_wakers(&self, ready: usize, wakers: &mut Vec<Waker>) {
+        let mut waiters = self.waiters.lock().unwrap();
+        if ready & READ != 0 {
+            wakers.extend(waiters.reader.take());
+        }
+        if ready & WRITE != 0 {
+            wakers.extend(waiters.writer.take());
+        }
+    }
+}
+
+struct Sources {
+    entries: Vec<Option<Arc<ScheduledIo>>>,
+    free: Vec<u32>,
+    generation: u32,
+}
+
+struct Dispatch {
+    events: Vec<Event>,
+    wakers: Vec<Waker>,
+}
+
+pub struct Reactor {
+    poller: Poller,
+    sources: SgxMutex<Sources>,
+    dispatch: SgxMutex<Dispatch>,
+}
+
+impl Reactor {
+    pub fn new() -> io::Result<Reactor> {
+        Ok(Reactor {
+            poller: Poller::new()?,
+            sources: SgxMutex::new(Sources {
+                entries: Vec::new(),
+                free: Vec::new(),
+                generation: 0,
+            }),
+            dispatch: SgxMutex::new(Dispatch {
+                events: Vec::with_capacity(EVENTS_CAPACITY),
+                wakers: Vec::new(),
+            }),
+        })
+    }
+
+    fn register(&self, fd: c_int) -> io::Result<Arc<ScheduledIo>> {
+        let io = {
+            let mut sources = self.sources.lock().unwrap();
+            // Tokens carry a generation next to the slot index so that an
+            // event still queued for a closed descriptor cannot be delivered
+            // to whatever reuses the slot.
+            sources.generation = sources.generation.wrapping_add(1);
+            let index = match sources.free.pop() {
+                Some(index) => index,
+                None => {
+                    sources.entries.push(None);
+                    (sources.entries.len() - 1) as u32
+                }
+            };
+            let io = Arc::new(ScheduledIo {
+                token: (sources.generation as u64) << 32 | index as u64,
+                // Optimistically ready: the first operation is attempted
+                // right away instead of waiting a reactor turn for the
+                // initial edge.
+                readiness: AtomicUsize::new(READY_MASK),
+                waiters: SgxMutex::new(Waiters::default()),
+            });
+            sources.entries[index as usize] = Some(io.clone());
+            io
+        };
+
+        if let Err(e) = self.poller.add(fd, io.token) {
+            self.remove(&io);
+            return Err(e);
+        }
+        Ok(io)
+    }
+
+    fn remove(&self, io: &ScheduledIo) {
+        let index = io.token as u32;
+        let mut sources = self.sources.lock().unwrap();
+        sources.entries[index as usize] = None;
+        sources.free.push(index);
+    }
+
+    /// Waits for I/O events without dispatching them.
+    pub fn poll_events(&self, timeout: Option<Duration>) -> io::Result<()> {
+        let mut dispatch = self.dispatch.lock().unwrap();
+        self.poller.wait(&mut dispatch.events, timeout)
+    }
+
+    /// Updates readiness from the last `poll_events` and wakes the tasks
+    /// waiting on it. Returns the number of events handled.
+    pub fn dispatch(&self) -> usize {
+        let mut dispatch = self.dispatch.lock().unwrap();
+        let Dispatch { ref mut events, ref mut wakers } = *dispatch;
+        let n = events.len();
+        {
+            let sources = self.sources.lock().unwrap();
+            for event in events.drain(..) {
+                // `epoll_event` is packed, copy the fields out.
+                let token = event.u64;
+                let flags = event.events;
+                let io = match sources.entries.get(token as u32 as usize) {
+                    Some(Some(io)) if io.token == token => io,
+                    _ => continue,
+                };
+                let mut ready = 0;
+                if flags & (imp::READABLE | imp::HUP) != 0 {
+                    ready |= READ;
+                }
+                if flags & (imp::WRITABLE | imp::HUP) != 0 {
+                    ready |= WRITE;
+                }
+                io.set_readiness(ready);
+                io.take_wakers(ready, wakers);
+            }
+        }
+        // Wake outside the locks, a waker may schedule straight back into
+        // this reactor.
+        for waker in wakers.drain(..) {
+            waker.wake();
+        }
+        n
+    }
+
+    /// Interrupts a thread blocked in `poll_events`.
+    pub fn notify(&self) -> io::Result<()> {
+        self.poller.notify()
+    }
+}
+
+/// A descriptor registered with a reactor.
+///
+/// Dropping the registration frees its slot without an `EPOLL_CTL_DEL`;
+/// the kernel drops the epoll entry when the descriptor is closed, and any
+/// event still in flight fails the token check.
+pub struct Registration {
+    reactor: Arc<Reactor>,
+    io: Arc<ScheduledIo>,
+}
+
+impl Registration {
+    pub fn new(reactor: Arc<Reactor>, fd: c_int) -> io::Result<Registration> {
+        let io = reactor.register(fd)?;
+        Ok(Registration { reactor, io })
+    }
+
+    /// Runs `f` once the descriptor is ready in direction `dir`, retrying
+    /// after every `EWOULDBLOCK` until it is parked on the reactor.
+    pub fn poll_io<R, F>(&self, cx: &mut Context<'_>, dir: Direction, mut f: F) -> Poll<io::Result<R>>
+    where
+        F: FnMut() -> io::Result<R>,
+    {
+        loop {
+            let snapshot = match self.io.poll_ready(cx, dir) {
+                Poll::Ready(snapshot) => snapshot,
+                Poll::Pending => return Poll::Pending,
+            };
+            match f() {
+                Err(ref e) if e.kind() == io::ErrorKind::WouldBlock => {
+                    self.io.clear_readiness(snapshot, dir);
+                }
+                res => return Poll::Ready(res),
+            }
+        }
+    }
+
+    /// Resolves once the descriptor has been reported ready in `dir`.
+    pub fn poll_ready(&self, cx: &mut Context<'_>, dir: Direction) -> Poll<()> {
+        self.io.poll_ready(cx, dir).map(drop)
+    }
+
+    /// Drops the optimistic initial readiness in `dir`, for operations such
+    /// as a non-blocking connect that must wait for the first real edge.
+    pub fn reset(&self, dir: Direction) {
+        self.io.readiness.fetch_and(!dir.mask(), Ordering::AcqRel);
+    }
+}
+
+impl Drop for Registration {
+    fn drop(&mut self) {
+        self.reactor.remove(&self.io);
+    }
+}
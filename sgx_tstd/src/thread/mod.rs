@@ -44,6 +44,8 @@ use crate::ffi::{CStr, CString};
 use crate::sys_common::{AsInner, IntoInner};
 
 #[macro_use] mod local;
+#[cfg(feature = "thread")]
+pub mod pool;
 pub use self::local::{LocalKey, AccessError};
 pub use self::local::statik::Key as __StaticLocalKeyInner;
 #[cfg(feature = "thread")]
@@ -0,0 +1,254 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Slice operations split recursively with `join`, so idle workers steal
+//! the larger halves first and the load balances itself.
+
+use core::fmt;
+use core::mem::MaybeUninit;
+use core::slice;
+use alloc_crate::vec::Vec;
+use super::{join, ThreadPool};
+
+/// Parallel operations over the chunks of a slice.
+///
+/// Created by [`ThreadPool::par_chunks`].
+///
+/// [`ThreadPool::par_chunks`]: struct.ThreadPool.html#method.par_chunks
+pub struct ParChunks<'a, T> {
+    pool: &'a ThreadPool,
+    slice: &'a [T],
+    chunk_size: usize,
+}
+
+impl<'a, T: Sync> ParChunks<'a, T> {
+    pub(super) fn new(pool: &'a ThreadPool, slice: &'a [T], chunk_size: usize) -> ParChunks<'a, T> {
+        assert!(chunk_size != 0, "chunk size must be non-zero");
+        ParChunks { pool, slice, chunk_size }
+    }
+
+    /// Returns the number of chunks.
+    pub fn len(&self) -> usize {
+        (self.slice.len() + self.chunk_size - 1) / self.chunk_size
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.slice.is_empty()
+    }
+
+    /// Calls `f` with the index and contents of every chunk.
+    pub fn for_each<F>(self, f: F)
+    where
+        F: Fn(usize, &[T]) + Sync,
+    {
+        let ParChunks { pool, slice, chunk_size } = self;
+        pool.install(|| for_each(slice, chunk_size, 0, &f));
+    }
+
+    /// Maps every chunk, returning the results in chunk order.
+    pub fn map<R, F>(self, f: F) -> Vec<R>
+    where
+        R: Send,
+        F: Fn(&[T]) -> R + Sync,
+    {
+        let chunks: Vec<&[T]> = self.slice.chunks(self.chunk_size).collect();
+        map_in(self.pool, &chunks, 1, &|chunk: &&[T]| f(chunk))
+    }
+
+    /// Maps every chunk and folds the results with `reduce`, which must be
+    /// associative. Returns `None` for an empty slice.
+    pub fn map_reduce<R, M, RD>(self, map: M, reduce: RD) -> Option<R>
+    where
+        R: Send,
+        M: Fn(&[T]) -> R + Sync,
+        RD: Fn(R, R) -> R + Sync,
+    {
+        let ParChunks { pool, slice, chunk_size } = self;
+        pool.install(|| map_reduce(slice, chunk_size, &map, &reduce))
+    }
+}
+
+impl<T> fmt::Debug for ParChunks<'_, T> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("ParChunks")
+            .field("len", &self.slice.len())
+            .field("chunk_size", &self.chunk_size)
+            .finish()
+    }
+}
+
+/// Parallel operations over the mutable chunks of a slice.
+///
+/// Created by [`ThreadPool::par_chunks_mut`].
+///
+/// [`ThreadPool::par_chunks_mut`]: struct.ThreadPool.html#method.par_chunks_mut
+pub struct ParChunksMut<'a, T> {
+    pool: &'a ThreadPool,
+    slice: &'a mut [T],
+    chunk_size: usize,
+}
+
+impl<'a, T: Send> ParChunksMut<'a, T> {
+    pub(super) fn new(pool: &'a ThreadPool, slice: &'a mut [T], chunk_size: usize) -> ParChunksMut<'a, T> {
+        assert!(chunk_size != 0, "chunk size must be non-zero");
+        ParChunksMut { pool, slice, chunk_size }
+    }
+
+    /// Returns the number of chunks.
+    pub fn len(&self) -> usize {
+        (self.slice.len() + self.chunk_size - 1) / self.chunk_size
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.slice.is_empty()
+    }
+
+    /// Calls `f` with the index and contents of every chunk.
+    pub fn for_each<F>(self, f: F)
+    where
+        F: Fn(usize, &mut [T]) + Sync,
+    {
+        let ParChunksMut { pool, slice, chunk_size } = self;
+        pool.install(|| for_each_mut(slice, chunk_size, 0, &f));
+    }
+}
+
+impl<T> fmt::Debug for ParChunksMut<'_, T> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("ParChunksMut")
+            .field("len", &self.slice.len())
+            .field("chunk_size", &self.chunk_size)
+            .finish()
+    }
+}
+
+// Splits at a chunk boundary close to the middle.
+fn split_point(len: usize, chunk_size: usize) -> usize {
+    let chunks = (len + chunk_size - 1) / chunk_size;
+    (chunks / 2) * chunk_size
+}
+
+fn for_each<T, F>(slice: &[T], chunk_size: usize, first: usize, f: &F)
+where
+    T: Sync,
+    F: Fn(usize, &[T]) + Sync,
+{
+    if slice.len() <= chunk_size {
+        if !slice.is_empty() {
+            f(first, slice);
+        }
+        return;
+    }
+    let mid = split_point(slice.len(), chunk_size);
+    let (left, right) = slice.split_at(mid);
+    join(
+        || for_each(left, chunk_size, first, f),
+        || for_each(right, chunk_size, first + mid / chunk_size, f),
+    );
+}
+
+fn for_each_mut<T, F>(slice: &mut [T], chunk_size: usize, first: usize, f: &F)
+where
+    T: Send,
+    F: Fn(usize, &mut [T]) + Sync,
+{
+    if slice.len() <= chunk_size {
+        if !slice.is_empty() {
+            f(first, slice);
+        }
+        return;
+    }
+    let mid = split_point(slice.len(), chunk_size);
+    let (left, right) = slice.split_at_mut(mid);
+    join(
+        || for_each_mut(left, chunk_size, first, f),
+        || for_each_mut(right, chunk_size, first + mid / chunk_size, f),
+    );
+}
+
+fn map_reduce<T, R, M, RD>(slice: &[T], chunk_size: usize, map: &M, reduce: &RD) -> Option<R>
+where
+    T: Sync,
+    R: Send,
+    M: Fn(&[T]) -> R + Sync,
+    RD: Fn(R, R) -> R + Sync,
+{
+    if slice.len() <= chunk_size {
+        return if slice.is_empty() { None } else { Some(map(slice)) };
+    }
+    let mid = split_point(slice.len(), chunk_size);
+    let (left, right) = slice.split_at(mid);
+    match join(
+        || map_reduce(left, chunk_size, map, reduce),
+        || map_reduce(right, chunk_size, map, reduce),
+    ) {
+        (Some(l), Some(r)) => Some(reduce(l, r)),
+        (l, r) => l.or(r),
+    }
+}
+
+pub(super) fn map<T, R, F>(pool: &ThreadPool, slice: &[T], f: F) -> Vec<R>
+where
+    T: Sync,
+    R: Send,
+    F: Fn(&T) -> R + Sync,
+{
+    let chunk_size = pool.default_chunk_size(slice.len());
+    map_in(pool, slice, chunk_size, &f)
+}
+
+// Maps `slice` straight into the spare capacity of the output vector. On a
+// panic the length is never set, so the results written so far are leaked
+// rather than dropped twice.
+fn map_in<T, R, F>(pool: &ThreadPool, slice: &[T], chunk_size: usize, f: &F) -> Vec<R>
+where
+    T: Sync,
+    R: Send,
+    F: Fn(&T) -> R + Sync,
+{
+    let len = slice.len();
+    let mut out: Vec<R> = Vec::with_capacity(len);
+    {
+        let spare = unsafe {
+            slice::from_raw_parts_mut(out.as_mut_ptr() as *mut MaybeUninit<R>, len)
+        };
+        pool.install(|| map_into(slice, spare, chunk_size, f));
+    }
+    unsafe { out.set_len(len) };
+    out
+}
+
+fn map_into<T, R, F>(slice: &[T], out: &mut [MaybeUninit<R>], chunk_size: usize, f: &F)
+where
+    T: Sync,
+    R: Send,
+    F: Fn(&T) -> R + Sync,
+{
+    if slice.len() <= chunk_size {
+        for (src, dst) in slice.iter().zip(out.iter_mut()) {
+            *dst = MaybeUninit::new(f(src));
+        }
+        return;
+    }
+    let mid = split_point(slice.len(), chunk_size);
+    let (left, right) = slice.split_at(mid);
+    let (out_left, out_right) = out.split_at_mut(mid);
+    join(
+        || map_into(left, out_left, chunk_size, f),
+        || map_into(right, out_right, chunk_size, f),
+    );
+}
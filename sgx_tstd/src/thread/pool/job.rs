@@ -0,0 +1,146 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+use core::any::Any;
+use core::cell::UnsafeCell;
+use core::mem;
+use alloc_crate::boxed::Box;
+use crate::panic::{self, AssertUnwindSafe};
+use super::latch::Latch;
+
+pub enum JobResult<T> {
+    None,
+    Ok(T),
+    Panic(Box<dyn Any + Send>),
+}
+
+pub trait Job {
+    unsafe fn execute(this: *const Self);
+}
+
+/// A type-erased pointer to a job. The job must stay alive until it has
+/// been executed.
+#[derive(Copy, Clone)]
+pub struct JobRef {
+    pointer: *const (),
+    execute_fn: unsafe fn(*const ()),
+}
+
+unsafe impl Send for JobRef {}
+
+impl JobRef {
+    pub unsafe fn new<T: Job>(data: *const T) -> JobRef {
+        let execute_fn: unsafe fn(*const T) = <T as Job>::execute;
+        JobRef {
+            pointer: data as *const (),
+            execute_fn: mem::transmute(execute_fn),
+        }
+    }
+
+    pub fn id(&self) -> *const () {
+        self.pointer
+    }
+
+    pub unsafe fn execute(self) {
+        (self.execute_fn)(self.pointer)
+    }
+}
+
+/// A job living on the stack of the thread that waits for it.
+pub struct StackJob<L, F, R> {
+    pub latch: L,
+    func: UnsafeCell<Option<F>>,
+    result: UnsafeCell<JobResult<R>>,
+}
+
+impl<L, F, R> StackJob<L, F, R>
+where
+    L: Latch,
+    F: FnOnce() -> R + Send,
+    R: Send,
+{
+    pub fn new(func: F, latch: L) -> StackJob<L, F, R> {
+        StackJob {
+            latch,
+            func: UnsafeCell::new(Some(func)),
+            result: UnsafeCell::new(JobResult::None),
+        }
+    }
+
+    pub unsafe fn as_job_ref(&self) -> JobRef {
+        JobRef::new(self)
+    }
+
+    /// Runs the job on the current thread after it was taken back from the
+    /// deque before anybody stole it.
+    pub fn run_inline(self) -> R {
+        (self.func.into_inner().unwrap())()
+    }
+
+    pub fn into_result(self) -> R {
+        match self.result.into_inner() {
+            JobResult::None => unreachable!(),
+            JobResult::Ok(x) => x,
+            JobResult::Panic(p) => panic::resume_unwind(p),
+        }
+    }
+}
+
+impl<L, F, R> Job for StackJob<L, F, R>
+where
+    L: Latch,
+    F: FnOnce() -> R + Send,
+    R: Send,
+{
+    unsafe fn execute(this: *const Self) {
+        let this = &*this;
+        let func = (*this.func.get()).take().unwrap();
+        *this.result.get() = match panic::catch_unwind(AssertUnwindSafe(func)) {
+            Ok(x) => JobResult::Ok(x),
+            Err(p) => JobResult::Panic(p),
+        };
+        this.latch.set();
+    }
+}
+
+/// A boxed job for fire-and-forget work; it frees itself once executed.
+pub struct HeapJob<F> {
+    func: F,
+}
+
+impl<F> HeapJob<F>
+where
+    F: FnOnce() + Send,
+{
+    pub fn new(func: F) -> Box<HeapJob<F>> {
+        Box::new(HeapJob { func })
+    }
+
+    pub unsafe fn into_job_ref(self: Box<Self>) -> JobRef {
+        JobRef::new(Box::into_raw(self))
+    }
+}
+
+impl<F> Job for HeapJob<F>
+where
+    F: FnOnce() + Send,
+{
+    unsafe fn execute(this: *const Self) {
+        let this = Box::from_raw(this as *mut Self);
+        (this.func)();
+    }
+}
@@ -0,0 +1,138 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+use core::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
+use alloc_crate::sync::Arc;
+use crate::sync::{SgxCondvar, SgxMutex};
+use super::registry::{Registry, WorkerThread};
+
+/// Signals that a job has finished.
+///
+/// Once `set` has made the latch visible the waiter may return and free
+/// it, so implementations must not touch `self` afterwards.
+pub trait Latch {
+    fn set(&self);
+}
+
+pub trait Probe {
+    fn probe(&self) -> bool;
+}
+
+/// A latch waited on by a pool worker, which keeps executing other jobs
+/// until it is set and may have to be woken from its sleep.
+pub struct SpinLatch {
+    set: AtomicBool,
+    registry: *const Registry,
+    owner: usize,
+}
+
+// `registry` is only dereferenced by pool workers, which keep it alive.
+unsafe impl Send for SpinLatch {}
+unsafe impl Sync for SpinLatch {}
+
+impl SpinLatch {
+    pub fn new(owner: &WorkerThread) -> SpinLatch {
+        SpinLatch {
+            set: AtomicBool::new(false),
+            registry: &**owner.registry(),
+            owner: owner.index(),
+        }
+    }
+}
+
+impl Probe for SpinLatch {
+    #[inline]
+    fn probe(&self) -> bool {
+        self.set.load(Ordering::SeqCst)
+    }
+}
+
+impl Latch for SpinLatch {
+    fn set(&self) {
+        let registry = self.registry;
+        let owner = self.owner;
+        self.set.store(true, Ordering::SeqCst);
+        unsafe { (*registry).wake_worker(owner) };
+    }
+}
+
+/// A latch for threads outside the pool, which block on a condvar.
+pub struct LockLatch {
+    inner: Arc<(SgxMutex<bool>, SgxCondvar)>,
+}
+
+impl LockLatch {
+    pub fn new() -> LockLatch {
+        LockLatch {
+            inner: Arc::new((SgxMutex::new(false), SgxCondvar::new())),
+        }
+    }
+
+    pub fn wait(&self) {
+        let (ref lock, ref cond) = *self.inner;
+        let mut guard = lock.lock().unwrap();
+        while !*guard {
+            guard = cond.wait(guard).unwrap();
+        }
+    }
+}
+
+impl Latch for LockLatch {
+    fn set(&self) {
+        // Own a reference so the condvar outlives the waiter's stack frame.
+        let inner = self.inner.clone();
+        let (ref lock, ref cond) = *inner;
+        let mut guard = lock.lock().unwrap();
+        *guard = true;
+        cond.notify_all();
+    }
+}
+
+/// A latch that is set once the count of outstanding jobs reaches zero.
+pub struct CountLatch {
+    counter: AtomicUsize,
+    latch: SpinLatch,
+}
+
+impl CountLatch {
+    pub fn new(owner: &WorkerThread) -> CountLatch {
+        CountLatch {
+            counter: AtomicUsize::new(1),
+            latch: SpinLatch::new(owner),
+        }
+    }
+
+    pub fn increment(&self) {
+        debug_assert!(!self.latch.probe());
+        self.counter.fetch_add(1, Ordering::Relaxed);
+    }
+}
+
+impl Probe for CountLatch {
+    #[inline]
+    fn probe(&self) -> bool {
+        self.latch.probe()
+    }
+}
+
+impl Latch for CountLatch {
+    fn set(&self) {
+        if self.counter.fetch_sub(1, Ordering::SeqCst) == 1 {
+            self.latch.set();
+        }
+    }
+}
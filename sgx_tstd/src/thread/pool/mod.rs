@@ -0,0 +1,352 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! A work-stealing thread pool for compute inside the enclave.
+//!
+//! Every [`thread::spawn`] costs an OCALL to create the untrusted thread and
+//! an ECALL for it to enter the enclave, and takes a TCS for as long as it
+//! runs. A [`ThreadPool`] pays that once per worker: its threads stay in the
+//! enclave and take jobs from per-worker deques, stealing from each other
+//! when they run dry, so short tasks no longer cost any enclave transition.
+//! Idle workers spin for a while before they sleep, which is the only point
+//! where they leave the enclave.
+//!
+//! [`join`] and [`Scope`] split work into jobs that may borrow from the
+//! caller's stack, and [`ThreadPool::par_chunks`] and friends build on them
+//! to process slices in parallel.
+//!
+//! The pool needs `pool_size + 1` TCS: one per worker plus the thread that
+//! submits work to it.
+//!
+//! [`thread::spawn`]: ../fn.spawn.html
+//! [`ThreadPool`]: struct.ThreadPool.html
+//! [`join`]: fn.join.html
+//! [`Scope`]: struct.Scope.html
+//! [`ThreadPool::par_chunks`]: struct.ThreadPool.html#method.par_chunks
+
+use sgx_trts::enclave::SgxGlobalData;
+use sgx_trts::libc;
+use core::cmp;
+use core::fmt;
+use alloc_crate::format;
+use alloc_crate::string::String;
+use alloc_crate::sync::Arc;
+use alloc_crate::vec::Vec;
+use crate::io;
+use crate::panic::{self, AssertUnwindSafe};
+use crate::thread::{Builder, JoinHandle};
+
+mod iter;
+mod job;
+mod latch;
+mod registry;
+mod scope;
+
+pub use self::iter::{ParChunks, ParChunksMut};
+pub use self::scope::Scope;
+
+use self::job::{HeapJob, StackJob};
+use self::latch::{Probe, SpinLatch};
+use self::registry::{Registry, WorkerThread};
+
+const DEFAULT_SPIN_ROUNDS: u32 = 256;
+const MAX_DEFAULT_THREADS: usize = 64;
+
+/// Configures a [`ThreadPool`].
+///
+/// [`ThreadPool`]: struct.ThreadPool.html
+#[derive(Debug, Default)]
+pub struct ThreadPoolBuilder {
+    num_threads: usize,
+    thread_name: Option<String>,
+    spin_rounds: Option<u32>,
+}
+
+impl ThreadPoolBuilder {
+    pub fn new() -> ThreadPoolBuilder {
+        ThreadPoolBuilder::default()
+    }
+
+    /// Sets the number of workers.
+    ///
+    /// Defaults to the number of online CPUs, capped by the number of TCS
+    /// the enclave has left for the workers.
+    pub fn num_threads(mut self, num_threads: usize) -> ThreadPoolBuilder {
+        self.num_threads = num_threads;
+        self
+    }
+
+    /// Sets the name prefix of the workers; worker `i` is named
+    /// `"{prefix}-{i}"`.
+    pub fn thread_name(mut self, prefix: String) -> ThreadPoolBuilder {
+        self.thread_name = Some(prefix);
+        self
+    }
+
+    /// Sets how many idle rounds a worker spins before it sleeps. Higher
+    /// values trade CPU time for fewer OCALLs on bursty workloads.
+    pub fn spin_rounds(mut self, rounds: u32) -> ThreadPoolBuilder {
+        self.spin_rounds = Some(rounds);
+        self
+    }
+
+    /// Starts the workers.
+    ///
+    /// Fails with `SGX_ERROR_OUT_OF_TCS` if the enclave cannot host that many
+    /// threads; the workers already started are shut down again.
+    pub fn build(self) -> io::Result<ThreadPool> {
+        let num_threads = if self.num_threads == 0 {
+            default_num_threads()
+        } else {
+            self.num_threads
+        };
+        let registry = Arc::new(Registry::new(
+            num_threads,
+            self.spin_rounds.unwrap_or(DEFAULT_SPIN_ROUNDS),
+        ));
+        let prefix = self.thread_name.unwrap_or_else(|| String::from("sgx-pool"));
+
+        let mut pool = ThreadPool {
+            registry: registry.clone(),
+            threads: Vec::with_capacity(num_threads),
+        };
+        for index in 0..num_threads {
+            let registry = registry.clone();
+            // On error, dropping `pool` stops the workers started so far.
+            let handle = Builder::new()
+                .name(format!("{}-{}", prefix, index))
+                .spawn(move || registry::main_loop(registry, index))?;
+            pool.threads.push(handle);
+        }
+        Ok(pool)
+    }
+}
+
+fn default_num_threads() -> usize {
+    let cpus = unsafe { libc::ocall::sysconf(libc::_SC_NPROCESSORS_ONLN) };
+    // Only a sizing hint, so an untrusted answer cannot do much harm.
+    let cpus = cmp::min(cmp::max(cpus, 1) as usize, MAX_DEFAULT_THREADS);
+    let tcs = SgxGlobalData::new().get_tcs_max_num() as usize;
+    cmp::max(cmp::min(cpus, tcs.saturating_sub(1)), 1)
+}
+
+/// A fixed set of enclave threads executing jobs with work stealing.
+///
+/// Dropping the pool lets the workers finish the jobs already queued and
+/// then joins them. It must not be dropped from one of its own jobs.
+pub struct ThreadPool {
+    registry: Arc<Registry>,
+    threads: Vec<JoinHandle<()>>,
+}
+
+impl ThreadPool {
+    /// Creates a pool with `num_threads` workers.
+    pub fn new(num_threads: usize) -> io::Result<ThreadPool> {
+        ThreadPoolBuilder::new().num_threads(num_threads).build()
+    }
+
+    pub fn current_num_threads(&self) -> usize {
+        self.registry.num_threads()
+    }
+
+    /// Runs `op` on a worker and waits for it. Calls to [`join`] and
+    /// [`scope`] inside `op` use this pool.
+    ///
+    /// [`join`]: fn.join.html
+    /// [`scope`]: fn.scope.html
+    pub fn install<OP, R>(&self, op: OP) -> R
+    where
+        OP: FnOnce() -> R + Send,
+        R: Send,
+    {
+        self.registry.in_worker(|_| op())
+    }
+
+    /// Runs `a` and `b`, potentially in parallel, and returns both results.
+    pub fn join<A, B, RA, RB>(&self, a: A, b: B) -> (RA, RB)
+    where
+        A: FnOnce() -> RA + Send,
+        B: FnOnce() -> RB + Send,
+        RA: Send,
+        RB: Send,
+    {
+        self.registry.in_worker(|worker| join_context(worker, a, b))
+    }
+
+    /// Creates a [`Scope`] on this pool and waits for every job spawned in
+    /// it.
+    ///
+    /// [`Scope`]: struct.Scope.html
+    pub fn scope<'scope, OP, R>(&self, op: OP) -> R
+    where
+        OP: FnOnce(&Scope<'scope>) -> R + Send,
+        R: Send,
+    {
+        self.registry.in_worker(|worker| scope::scope_in(worker, op))
+    }
+
+    /// Queues a job and returns immediately.
+    ///
+    /// A panic in `op` is reported by the panic hook and otherwise ignored.
+    pub fn spawn<OP>(&self, op: OP)
+    where
+        OP: FnOnce() + Send + 'static,
+    {
+        let job = HeapJob::new(move || {
+            let _ = panic::catch_unwind(AssertUnwindSafe(op));
+        });
+        self.registry.inject(unsafe { job.into_job_ref() });
+    }
+
+    /// Splits `slice` into chunks of `chunk_size` elements to be processed
+    /// in parallel.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `chunk_size` is 0.
+    pub fn par_chunks<'a, T: Sync>(&'a self, slice: &'a [T], chunk_size: usize) -> ParChunks<'a, T> {
+        ParChunks::new(self, slice, chunk_size)
+    }
+
+    /// Mutable version of [`par_chunks`].
+    ///
+    /// [`par_chunks`]: #method.par_chunks
+    pub fn par_chunks_mut<'a, T: Send>(&'a self, slice: &'a mut [T], chunk_size: usize) -> ParChunksMut<'a, T> {
+        ParChunksMut::new(self, slice, chunk_size)
+    }
+
+    /// Maps every element of `slice` in parallel, keeping the order.
+    pub fn par_map<T, R, F>(&self, slice: &[T], f: F) -> Vec<R>
+    where
+        T: Sync,
+        R: Send,
+        F: Fn(&T) -> R + Sync,
+    {
+        iter::map(self, slice, f)
+    }
+
+    // A chunk size giving each worker a few chunks to balance with.
+    fn default_chunk_size(&self, len: usize) -> usize {
+        cmp::max(1, len / (self.current_num_threads() * 4))
+    }
+}
+
+impl Drop for ThreadPool {
+    fn drop(&mut self) {
+        self.registry.terminate();
+        for thread in self.threads.drain(..) {
+            let _ = thread.join();
+        }
+    }
+}
+
+impl fmt::Debug for ThreadPool {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("ThreadPool")
+            .field("num_threads", &self.current_num_threads())
+            .finish()
+    }
+}
+
+/// Runs `a` and `b`, potentially in parallel, and returns both results.
+///
+/// On a pool worker `b` is made available for stealing while the current
+/// thread runs `a`. Anywhere else both closures simply run in sequence on
+/// the calling thread. If either closure panics, the panic is resumed once
+/// both have finished.
+pub fn join<A, B, RA, RB>(a: A, b: B) -> (RA, RB)
+where
+    A: FnOnce() -> RA + Send,
+    B: FnOnce() -> RB + Send,
+    RA: Send,
+    RB: Send,
+{
+    let worker = WorkerThread::current();
+    if worker.is_null() {
+        (a(), b())
+    } else {
+        join_context(unsafe { &*worker }, a, b)
+    }
+}
+
+/// Creates a [`Scope`] on the pool of the current worker.
+///
+/// # Panics
+///
+/// Panics if the current thread is not a pool worker; use
+/// [`ThreadPool::scope`] from other threads.
+///
+/// [`Scope`]: struct.Scope.html
+/// [`ThreadPool::scope`]: struct.ThreadPool.html#method.scope
+pub fn scope<'scope, OP, R>(op: OP) -> R
+where
+    OP: FnOnce(&Scope<'scope>) -> R + Send,
+    R: Send,
+{
+    let worker = WorkerThread::current();
+    assert!(!worker.is_null(), "`scope` called outside of a thread pool");
+    scope::scope_in(unsafe { &*worker }, op)
+}
+
+/// Returns the index of the current worker in its pool, if any.
+pub fn current_thread_index() -> Option<usize> {
+    let worker = WorkerThread::current();
+    if worker.is_null() {
+        None
+    } else {
+        Some(unsafe { (*worker).index() })
+    }
+}
+
+fn join_context<A, B, RA, RB>(worker: &WorkerThread, a: A, b: B) -> (RA, RB)
+where
+    A: FnOnce() -> RA + Send,
+    B: FnOnce() -> RB + Send,
+    RA: Send,
+    RB: Send,
+{
+    let job_b = StackJob::new(b, SpinLatch::new(worker));
+    let job_b_ref = unsafe { job_b.as_job_ref() };
+    let job_b_id = job_b_ref.id();
+    worker.push(job_b_ref);
+
+    let result_a = match panic::catch_unwind(AssertUnwindSafe(a)) {
+        Ok(r) => r,
+        Err(err) => {
+            // `b` may still be running elsewhere and borrows our frame.
+            worker.wait_until(&job_b.latch);
+            panic::resume_unwind(err)
+        }
+    };
+
+    while !job_b.latch.probe() {
+        match worker.take_local() {
+            Some(job) if job.id() == job_b_id => {
+                // Nobody stole `b`, run it here without the indirection.
+                let result_b = job_b.run_inline();
+                return (result_a, result_b);
+            }
+            Some(job) => unsafe { job.execute() },
+            None => {
+                // `b` was stolen, help with other work until it is done.
+                worker.wait_until(&job_b.latch);
+                break;
+            }
+        }
+    }
+    (result_a, job_b.into_result())
+}
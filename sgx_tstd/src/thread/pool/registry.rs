@@ -0,0 +1,287 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Worker state and the sleep protocol.
+//!
+//! Each worker owns a deque: it pushes and pops at the back, thieves take
+//! from the front. Jobs from outside the pool go through a shared injector
+//! queue. An idle worker spins for a while and then sleeps on its own
+//! condvar, which costs an OCALL to enter and another to be woken, so
+//! pushes only take a wake-up path when somebody is actually asleep.
+
+use core::cell::Cell;
+use core::ptr;
+use core::sync::atomic::{self, spin_loop_hint, AtomicBool, AtomicUsize, Ordering};
+use alloc_crate::collections::VecDeque;
+use alloc_crate::sync::Arc;
+use alloc_crate::vec::Vec;
+use crate::sync::{SgxCondvar, SgxMutex};
+use super::job::{JobRef, StackJob};
+use super::latch::{LockLatch, Probe};
+
+// Pause instructions per idle round.
+const SPIN_PAUSES: u32 = 64;
+
+thread_local! {
+    static WORKER: Cell<*const WorkerThread> = Cell::new(ptr::null());
+}
+
+struct WorkerInfo {
+    deque: SgxMutex<VecDeque<JobRef>>,
+    sleeping: SgxMutex<bool>,
+    cond: SgxCondvar,
+}
+
+pub struct Registry {
+    workers: Vec<WorkerInfo>,
+    injector: SgxMutex<VecDeque<JobRef>>,
+    sleepers: AtomicUsize,
+    terminate: AtomicBool,
+    spin_rounds: u32,
+}
+
+impl Registry {
+    pub fn new(num_threads: usize, spin_rounds: u32) -> Registry {
+        Registry {
+            workers: (0..num_threads).map(|_| WorkerInfo {
+                deque: SgxMutex::new(VecDeque::new()),
+                sleeping: SgxMutex::new(false),
+                cond: SgxCondvar::new(),
+            }).collect(),
+            injector: SgxMutex::new(VecDeque::new()),
+            sleepers: AtomicUsize::new(0),
+            terminate: AtomicBool::new(false),
+            spin_rounds,
+        }
+    }
+
+    pub fn num_threads(&self) -> usize {
+        self.workers.len()
+    }
+
+    /// Queues a job from outside the pool.
+    pub fn inject(&self, job: JobRef) {
+        self.injector.lock().unwrap().push_back(job);
+        self.notify_new_work();
+    }
+
+    fn notify_new_work(&self) {
+        // Pairs with the fence in `WorkerThread::sleep`: either the sleeper
+        // finds the job in its last scan or we see it counted here.
+        atomic::fence(Ordering::SeqCst);
+        if self.sleepers.load(Ordering::SeqCst) == 0 {
+            return;
+        }
+        for (index, _) in self.workers.iter().enumerate() {
+            if self.wake(index) {
+                return;
+            }
+        }
+    }
+
+    /// Wakes the worker waiting on a latch that was just set.
+    pub fn wake_worker(&self, index: usize) {
+        if self.sleepers.load(Ordering::SeqCst) != 0 {
+            self.wake(index);
+        }
+    }
+
+    fn wake(&self, index: usize) -> bool {
+        let info = &self.workers[index];
+        let mut sleeping = info.sleeping.lock().unwrap();
+        if *sleeping {
+            *sleeping = false;
+            self.sleepers.fetch_sub(1, Ordering::SeqCst);
+            info.cond.notify_one();
+            true
+        } else {
+            false
+        }
+    }
+
+    pub fn terminate(&self) {
+        self.terminate.store(true, Ordering::SeqCst);
+        for index in 0..self.workers.len() {
+            self.wake(index);
+        }
+    }
+
+    /// Runs `op` on a worker of this pool, blocking the caller if it is
+    /// not one already.
+    pub fn in_worker<OP, R>(&self, op: OP) -> R
+    where
+        OP: FnOnce(&WorkerThread) -> R + Send,
+        R: Send,
+    {
+        let worker = WorkerThread::current();
+        unsafe {
+            if !worker.is_null() && ptr::eq(&*(*worker).registry, self) {
+                op(&*worker)
+            } else {
+                self.in_worker_cold(op)
+            }
+        }
+    }
+
+    fn in_worker_cold<OP, R>(&self, op: OP) -> R
+    where
+        OP: FnOnce(&WorkerThread) -> R + Send,
+        R: Send,
+    {
+        let job = StackJob::new(
+            || {
+                let worker = WorkerThread::current();
+                debug_assert!(!worker.is_null());
+                op(unsafe { &*worker })
+            },
+            LockLatch::new(),
+        );
+        self.inject(unsafe { job.as_job_ref() });
+        job.latch.wait();
+        job.into_result()
+    }
+}
+
+pub struct WorkerThread {
+    registry: Arc<Registry>,
+    index: usize,
+    rng: Cell<u64>,
+}
+
+impl WorkerThread {
+    /// Returns the worker running on this thread, or null.
+    pub fn current() -> *const WorkerThread {
+        WORKER.with(|w| w.get())
+    }
+
+    pub fn registry(&self) -> &Arc<Registry> {
+        &self.registry
+    }
+
+    pub fn index(&self) -> usize {
+        self.index
+    }
+
+    fn info(&self) -> &WorkerInfo {
+        &self.registry.workers[self.index]
+    }
+
+    pub fn push(&self, job: JobRef) {
+        self.info().deque.lock().unwrap().push_back(job);
+        self.registry.notify_new_work();
+    }
+
+    /// Pops the most recently pushed job of this worker.
+    pub fn take_local(&self) -> Option<JobRef> {
+        self.info().deque.lock().unwrap().pop_back()
+    }
+
+    fn steal(&self) -> Option<JobRef> {
+        let workers = &self.registry.workers;
+        let n = workers.len();
+        // xorshift, only used to spread thieves over the victims.
+        let mut x = self.rng.get();
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        self.rng.set(x);
+
+        let start = (x % n as u64) as usize;
+        for i in 0..n {
+            let victim = (start + i) % n;
+            if victim == self.index {
+                continue;
+            }
+            if let Some(job) = workers[victim].deque.lock().unwrap().pop_front() {
+                return Some(job);
+            }
+        }
+        self.registry.injector.lock().unwrap().pop_front()
+    }
+
+    fn find_work(&self) -> Option<JobRef> {
+        self.take_local().or_else(|| self.steal())
+    }
+
+    /// Executes other jobs until `latch` is set.
+    pub fn wait_until<L: Probe>(&self, latch: &L) {
+        if !latch.probe() {
+            self.wait_until_cold(&|| latch.probe());
+        }
+    }
+
+    fn wait_until_cold(&self, done: &dyn Fn() -> bool) {
+        let mut idle_rounds = 0;
+        while !done() {
+            if let Some(job) = self.find_work() {
+                unsafe { job.execute() };
+                idle_rounds = 0;
+            } else if idle_rounds < self.registry.spin_rounds {
+                idle_rounds += 1;
+                for _ in 0..SPIN_PAUSES {
+                    spin_loop_hint();
+                }
+            } else {
+                self.sleep(done);
+                idle_rounds = 0;
+            }
+        }
+    }
+
+    fn sleep(&self, done: &dyn Fn() -> bool) {
+        let info = self.info();
+        let registry = &*self.registry;
+        let mut sleeping = info.sleeping.lock().unwrap();
+        *sleeping = true;
+        registry.sleepers.fetch_add(1, Ordering::SeqCst);
+        atomic::fence(Ordering::SeqCst);
+
+        // Last look, now that pushers and latch setters can see us asleep.
+        let job = if done() { None } else { self.find_work() };
+        if done() || job.is_some() {
+            *sleeping = false;
+            registry.sleepers.fetch_sub(1, Ordering::SeqCst);
+            drop(sleeping);
+            if let Some(job) = job {
+                unsafe { job.execute() };
+            }
+            return;
+        }
+
+        while *sleeping {
+            sleeping = info.cond.wait(sleeping).unwrap();
+        }
+    }
+}
+
+pub fn main_loop(registry: Arc<Registry>, index: usize) {
+    let worker = WorkerThread {
+        registry,
+        index,
+        rng: Cell::new(0x9E37_79B9_7F4A_7C15 ^ (index as u64 + 1).wrapping_mul(0xBF58_476D_1CE4_E5B9)),
+    };
+    WORKER.with(|w| w.set(&worker));
+
+    let registry = worker.registry.clone();
+    worker.wait_until_cold(&|| registry.terminate.load(Ordering::SeqCst));
+    // Run whatever was spawned before the pool was dropped.
+    while let Some(job) = worker.find_work() {
+        unsafe { job.execute() };
+    }
+
+    WORKER.with(|w| w.set(ptr::null()));
+}
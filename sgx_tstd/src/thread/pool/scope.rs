@@ -0,0 +1,127 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+use core::any::Any;
+use core::fmt;
+use core::marker::PhantomData;
+use core::ptr;
+use core::sync::atomic::{AtomicPtr, Ordering};
+use alloc_crate::boxed::Box;
+use alloc_crate::sync::Arc;
+use crate::panic::{self, AssertUnwindSafe};
+use super::job::HeapJob;
+use super::latch::{CountLatch, Latch};
+use super::registry::{Registry, WorkerThread};
+
+/// A scope in which jobs borrowing from the enclosing stack frame can be
+/// spawned. Created by [`ThreadPool::scope`] or [`scope`].
+///
+/// All jobs spawned in the scope have finished when the scope returns. If
+/// any of them panicked, the panic is resumed on the thread that created
+/// the scope once they are all done.
+///
+/// [`ThreadPool::scope`]: struct.ThreadPool.html#method.scope
+/// [`scope`]: fn.scope.html
+pub struct Scope<'scope> {
+    registry: Arc<Registry>,
+    latch: CountLatch,
+    panic: AtomicPtr<Box<dyn Any + Send>>,
+    marker: PhantomData<Box<dyn FnOnce(&Scope<'scope>) + Send + Sync + 'scope>>,
+}
+
+struct ScopePtr<'scope>(*const Scope<'scope>);
+
+// The scope outlives every job holding a pointer to it.
+unsafe impl Send for ScopePtr<'_> {}
+
+impl<'scope> Scope<'scope> {
+    /// Spawns a job into the scope. It may run on any worker of the pool,
+    /// and may itself spawn more jobs through the scope it is given.
+    pub fn spawn<BODY>(&self, body: BODY)
+    where
+        BODY: FnOnce(&Scope<'scope>) + Send + 'scope,
+    {
+        self.latch.increment();
+        let scope_ptr = ScopePtr(self);
+        let job = HeapJob::new(move || {
+            let scope_ptr = scope_ptr;
+            let scope = unsafe { &*scope_ptr.0 };
+            scope.execute_job(move || body(scope));
+            scope.latch.set();
+        });
+        let job_ref = unsafe { job.into_job_ref() };
+
+        let worker = WorkerThread::current();
+        unsafe {
+            if !worker.is_null() && ptr::eq(&**(*worker).registry(), &*self.registry) {
+                (*worker).push(job_ref);
+            } else {
+                self.registry.inject(job_ref);
+            }
+        }
+    }
+
+    fn execute_job<F, R>(&self, func: F) -> Option<R>
+    where
+        F: FnOnce() -> R,
+    {
+        match panic::catch_unwind(AssertUnwindSafe(func)) {
+            Ok(r) => Some(r),
+            Err(err) => {
+                // Keep the first panic, drop the rest.
+                let err = Box::into_raw(Box::new(err));
+                if self.panic
+                    .compare_exchange(ptr::null_mut(), err, Ordering::Release, Ordering::Relaxed)
+                    .is_err()
+                {
+                    drop(unsafe { Box::from_raw(err) });
+                }
+                None
+            }
+        }
+    }
+}
+
+impl fmt::Debug for Scope<'_> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.pad("Scope { .. }")
+    }
+}
+
+pub fn scope_in<'scope, OP, R>(worker: &WorkerThread, op: OP) -> R
+where
+    OP: FnOnce(&Scope<'scope>) -> R,
+{
+    let scope = Scope {
+        registry: worker.registry().clone(),
+        latch: CountLatch::new(worker),
+        panic: AtomicPtr::new(ptr::null_mut()),
+        marker: PhantomData,
+    };
+    let result = scope.execute_job(|| op(&scope));
+    // Drop the count held by the scope body itself, then help out until
+    // all spawned jobs are done.
+    scope.latch.set();
+    worker.wait_until(&scope.latch);
+
+    let err = scope.panic.swap(ptr::null_mut(), Ordering::Acquire);
+    if !err.is_null() {
+        let err = unsafe { Box::from_raw(err) };
+        panic::resume_unwind(*err);
+    }
+    result.unwrap()
+}
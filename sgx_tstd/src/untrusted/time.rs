@@ -15,6 +15,8 @@
 // specific language governing permissions and limitations
 // under the License..
 
+use crate::io;
+use crate::sys::time::tsc;
 use crate::time::{Instant, SystemTime, SystemTimeError, Duration};
 
 pub trait InstantEx {
@@ -69,3 +71,102 @@ impl SystemTimeEx for SystemTime {
         SystemTime::_now().duration_since(*self)
     }
 }
+
+/// Where `Instant` and `SystemTime` readings come from.
+///
+/// Every reading is host time either way: the host answers the OCALLs, and
+/// the TSC clock is only calibrated against those answers.
+#[derive(Copy, Clone, Debug, PartialEq, Eq)]
+pub enum ClockSource {
+    /// One `clock_gettime` OCALL per reading. This is the default.
+    Ocall,
+    /// Readings are interpolated from the TSC inside the enclave and only
+    /// resynced with the host by an occasional OCALL. Needs SGX2.
+    Tsc(TscClockConfig),
+}
+
+/// Settings for [`ClockSource::Tsc`].
+#[derive(Copy, Clone, Debug, PartialEq, Eq)]
+pub struct TscClockConfig {
+    /// Longest time between two resyncs with the host.
+    pub resync_interval: Duration,
+    /// Largest error between the interpolated time and the host's that is
+    /// tolerated at a resync. A larger error shortens the interval until it
+    /// is back under this bound.
+    pub max_drift: Duration,
+}
+
+impl Default for TscClockConfig {
+    fn default() -> TscClockConfig {
+        TscClockConfig {
+            resync_interval: Duration::from_nanos(tsc::DEFAULT_RESYNC_NS),
+            max_drift: Duration::from_nanos(tsc::DEFAULT_MAX_DRIFT_NS),
+        }
+    }
+}
+
+/// Selects the clock behind `Instant::now` and `SystemTime::now`.
+///
+/// Switching to [`ClockSource::Tsc`] fails if the processor does not
+/// report SGX2, as RDTSC faults inside an enclave without it. The report
+/// comes from the host, so a trial RDTSC is also run under an exception
+/// handler and a fault from it fails the switch as well. The switch then
+/// measures the TSC rate, spinning on the host clock for `CALIBRATION_NS`
+/// (5 ms, in `sys/time/tsc.rs`) before it returns.
+pub fn set_clock_source(source: ClockSource) -> io::Result<()> {
+    match source {
+        ClockSource::Ocall => {
+            tsc::disable();
+            Ok(())
+        }
+        ClockSource::Tsc(config) => tsc::enable(config.resync_interval, config.max_drift),
+    }
+}
+
+/// Returns the clock behind `Instant::now` and `SystemTime::now`.
+pub fn clock_source() -> ClockSource {
+    if tsc::is_enabled() {
+        let (resync_interval, max_drift) = tsc::config();
+        ClockSource::Tsc(TscClockConfig { resync_interval, max_drift })
+    } else {
+        ClockSource::Ocall
+    }
+}
+
+/// A time reading that came from the host.
+///
+/// The host controls the clock an enclave sees: it can stop it, slow it
+/// down or jump it. Wrapping a reading in `UntrustedTime` keeps that visible
+/// in the types; getting the value out takes an explicit
+/// [`assume_trusted`], which marks the place where the code decides the
+/// host's word is good enough.
+///
+/// [`assume_trusted`]: UntrustedTime::assume_trusted
+#[derive(Copy, Clone, Debug, PartialEq, Eq, PartialOrd, Ord, Hash)]
+pub struct UntrustedTime<T>(T);
+
+impl<T> UntrustedTime<T> {
+    /// Returns the reading, accepting that the host may have chosen it.
+    pub fn assume_trusted(self) -> T {
+        self.0
+    }
+}
+
+impl UntrustedTime<Instant> {
+    /// Returns the host's idea of "now" as an `Instant`.
+    pub fn now() -> UntrustedTime<Instant> {
+        UntrustedTime(Instant::_now())
+    }
+
+    /// Returns the time elapsed since this reading, by the host's clock.
+    pub fn elapsed(&self) -> UntrustedTime<Duration> {
+        UntrustedTime(Instant::_now() - self.0)
+    }
+}
+
+impl UntrustedTime<SystemTime> {
+    /// Returns the host's idea of "now" as a `SystemTime`.
+    pub fn now() -> UntrustedTime<SystemTime> {
+        UntrustedTime(SystemTime::_now())
+    }
+}
@@ -0,0 +1,357 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Untrusted worker for the enclave's OCALL submission ring.
+//!
+//! `u_batch_start_ocall` spawns one thread per ring. The thread polls the
+//! submission queue, runs each entry as a plain syscall and posts the result
+//! to the completion queue. When it has found nothing to do for a while it
+//! sets `BATCH_RING_NEED_WAKEUP` and sleeps on the flags word until the
+//! enclave calls `u_batch_enter_ocall`.
+//!
+//! The layout here must match `sgx_libc/src/linux/x86_64/ocall/batch.rs`.
+
+use libc::{self, c_int, c_void, clockid_t, epoll_event, timespec};
+use std::io::Error;
+use std::mem;
+use std::ptr;
+use std::sync::atomic::{spin_loop_hint, AtomicU32, Ordering};
+use std::thread::{self, JoinHandle};
+
+const BATCH_RING_MAGIC: u32 = 0x4252_4e47;
+const BATCH_RING_MAX_ENTRIES: u32 = 4096;
+
+const BATCH_RING_NEED_WAKEUP: u32 = 0x1;
+const BATCH_RING_CQ_WAIT: u32 = 0x2;
+const BATCH_RING_STOP: u32 = 0x4;
+
+const BATCH_OP_NOP: u8 = 0;
+const BATCH_OP_READ: u8 = 1;
+const BATCH_OP_WRITE: u8 = 2;
+const BATCH_OP_PREAD64: u8 = 3;
+const BATCH_OP_PWRITE64: u8 = 4;
+const BATCH_OP_SEND: u8 = 5;
+const BATCH_OP_RECV: u8 = 6;
+const BATCH_OP_FSYNC: u8 = 7;
+const BATCH_OP_FDATASYNC: u8 = 8;
+const BATCH_OP_CLOSE: u8 = 9;
+const BATCH_OP_CLOCK_GETTIME: u8 = 10;
+const BATCH_OP_EPOLL_WAIT: u8 = 11;
+
+// Empty polls of the submission queue before the worker goes to sleep.
+const BATCH_SPIN_ROUNDS: u32 = 4096;
+
+const FUTEX_WAIT: c_int = 0;
+const FUTEX_WAKE: c_int = 1;
+
+#[repr(C)]
+#[derive(Copy, Clone)]
+struct BatchSqe {
+    opcode: u8,
+    _pad: [u8; 3],
+    fd: c_int,
+    addr: u64,
+    len: u64,
+    off: i64,
+    arg: u64,
+    user_data: u64,
+}
+
+#[repr(C)]
+#[derive(Copy, Clone)]
+struct BatchCqe {
+    user_data: u64,
+    result: i64,
+    error: c_int,
+    _pad: u32,
+}
+
+#[repr(C)]
+struct BatchRing {
+    magic: u32,
+    entries: u32,
+    sqe_off: u32,
+    cqe_off: u32,
+    worker: u64,
+    _pad0: [u8; 40],
+    sq_tail: u32,
+    _pad1: [u8; 60],
+    sq_head: u32,
+    _pad2: [u8; 60],
+    cq_tail: u32,
+    _pad3: [u8; 60],
+    cq_head: u32,
+    _pad4: [u8; 60],
+    flags: u32,
+    _pad5: [u8; 60],
+}
+
+#[derive(Copy, Clone)]
+struct Ring(*mut BatchRing);
+
+unsafe impl Send for Ring {}
+
+impl Ring {
+    fn atomic(&self, field: &u32) -> &AtomicU32 {
+        unsafe { &*(field as *const u32 as *const AtomicU32) }
+    }
+
+    fn hdr(&self) -> &BatchRing {
+        unsafe { &*self.0 }
+    }
+
+    fn sq_tail(&self) -> &AtomicU32 {
+        self.atomic(&self.hdr().sq_tail)
+    }
+
+    fn sq_head(&self) -> &AtomicU32 {
+        self.atomic(&self.hdr().sq_head)
+    }
+
+    fn cq_tail(&self) -> &AtomicU32 {
+        self.atomic(&self.hdr().cq_tail)
+    }
+
+    fn cq_head(&self) -> &AtomicU32 {
+        self.atomic(&self.hdr().cq_head)
+    }
+
+    fn flags(&self) -> &AtomicU32 {
+        self.atomic(&self.hdr().flags)
+    }
+
+    fn is_valid(&self) -> bool {
+        let hdr = self.hdr();
+        let sqe_off = mem::size_of::<BatchRing>();
+        let cqe_off = sqe_off + hdr.entries as usize * mem::size_of::<BatchSqe>();
+        hdr.magic == BATCH_RING_MAGIC
+            && hdr.entries.is_power_of_two()
+            && hdr.entries <= BATCH_RING_MAX_ENTRIES
+            && hdr.sqe_off as usize == sqe_off
+            && hdr.cqe_off as usize == cqe_off
+    }
+
+    fn run(self) {
+        let base = self.0 as *mut u8;
+        let mask = self.hdr().entries - 1;
+        let entries = self.hdr().entries;
+        let sqes = unsafe { base.add(self.hdr().sqe_off as usize) as *const BatchSqe };
+        let cqes = unsafe { base.add(self.hdr().cqe_off as usize) as *mut BatchCqe };
+        let mut idle = 0;
+
+        loop {
+            let flags = self.flags().load(Ordering::Acquire);
+            if flags & BATCH_RING_STOP != 0 {
+                break;
+            }
+
+            let head = self.sq_head().load(Ordering::Relaxed);
+            if self.sq_tail().load(Ordering::Acquire) == head {
+                idle += 1;
+                if idle < BATCH_SPIN_ROUNDS {
+                    spin_loop_hint();
+                    continue;
+                }
+                let flags = self.flags().fetch_or(BATCH_RING_NEED_WAKEUP, Ordering::SeqCst)
+                    | BATCH_RING_NEED_WAKEUP;
+                if flags & BATCH_RING_STOP == 0 && self.sq_tail().load(Ordering::SeqCst) == head {
+                    futex_wait(self.flags(), flags);
+                }
+                self.flags().fetch_and(!BATCH_RING_NEED_WAKEUP, Ordering::SeqCst);
+                idle = 0;
+                continue;
+            }
+            idle = 0;
+
+            // The enclave never has more than `entries` requests in flight,
+            // so there is always room for the result. Do not overwrite an
+            // unreaped completion if it gets that wrong.
+            let cq_tail = self.cq_tail().load(Ordering::Relaxed);
+            if cq_tail.wrapping_sub(self.cq_head().load(Ordering::Acquire)) >= entries {
+                thread::yield_now();
+                continue;
+            }
+
+            let sqe = unsafe { ptr::read_volatile(sqes.add((head & mask) as usize)) };
+            let (result, error) = execute(&sqe);
+            unsafe {
+                ptr::write_volatile(
+                    cqes.add((cq_tail & mask) as usize),
+                    BatchCqe {
+                        user_data: sqe.user_data,
+                        result,
+                        error,
+                        _pad: 0,
+                    },
+                );
+            }
+            self.cq_tail().store(cq_tail.wrapping_add(1), Ordering::SeqCst);
+            self.sq_head().store(head.wrapping_add(1), Ordering::Release);
+            if self.flags().load(Ordering::SeqCst) & BATCH_RING_CQ_WAIT != 0 {
+                futex_wake(self.cq_tail());
+            }
+        }
+    }
+}
+
+fn futex_wait(word: &AtomicU32, val: u32) {
+    unsafe {
+        libc::syscall(libc::SYS_futex, word, FUTEX_WAIT, val, 0, 0, 0);
+    }
+}
+
+fn futex_wake(word: &AtomicU32) {
+    unsafe {
+        libc::syscall(libc::SYS_futex, word, FUTEX_WAKE, c_int::MAX, 0, 0, 0);
+    }
+}
+
+fn execute(sqe: &BatchSqe) -> (i64, c_int) {
+    let fd = sqe.fd;
+    let buf = sqe.addr as *mut c_void;
+    let len = sqe.len as usize;
+    let ret = unsafe {
+        match sqe.opcode {
+            BATCH_OP_NOP => 0,
+            BATCH_OP_READ => libc::read(fd, buf, len) as i64,
+            BATCH_OP_WRITE => libc::write(fd, buf, len) as i64,
+            BATCH_OP_PREAD64 => libc::pread64(fd, buf, len, sqe.off) as i64,
+            BATCH_OP_PWRITE64 => libc::pwrite64(fd, buf, len, sqe.off) as i64,
+            BATCH_OP_SEND => libc::send(fd, buf, len, sqe.arg as c_int) as i64,
+            BATCH_OP_RECV => libc::recv(fd, buf, len, sqe.arg as c_int) as i64,
+            BATCH_OP_FSYNC => libc::fsync(fd) as i64,
+            BATCH_OP_FDATASYNC => libc::fdatasync(fd) as i64,
+            BATCH_OP_CLOSE => libc::close(fd) as i64,
+            BATCH_OP_CLOCK_GETTIME if len >= mem::size_of::<timespec>() => {
+                libc::clock_gettime(sqe.arg as clockid_t, buf as *mut timespec) as i64
+            }
+            BATCH_OP_EPOLL_WAIT => {
+                libc::epoll_wait(fd, buf as *mut epoll_event, len as c_int, sqe.arg as c_int) as i64
+            }
+            _ => return (-1, libc::EINVAL),
+        }
+    };
+    if ret < 0 {
+        (-1, Error::last_os_error().raw_os_error().unwrap_or(0))
+    } else {
+        (ret, 0)
+    }
+}
+
+fn set_error(error: *mut c_int, errno: c_int) {
+    if !error.is_null() {
+        unsafe {
+            *error = errno;
+        }
+    }
+}
+
+#[no_mangle]
+pub extern "C" fn u_batch_start_ocall(error: *mut c_int, ring: *mut c_void) -> c_int {
+    if ring.is_null() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+    let ring = Ring(ring as *mut BatchRing);
+    if !ring.is_valid() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+    if ring.hdr().worker != 0 {
+        set_error(error, libc::EBUSY);
+        return -1;
+    }
+
+    let handle = match thread::Builder::new()
+        .name("sgx-batch".to_string())
+        .spawn(move || ring.run())
+    {
+        Ok(handle) => handle,
+        Err(e) => {
+            set_error(error, e.raw_os_error().unwrap_or(libc::EAGAIN));
+            return -1;
+        }
+    };
+    unsafe {
+        (*ring.0).worker = Box::into_raw(Box::new(handle)) as u64;
+    }
+    set_error(error, 0);
+    0
+}
+
+#[no_mangle]
+pub extern "C" fn u_batch_enter_ocall(
+    error: *mut c_int,
+    ring: *mut c_void,
+    min_complete: u32,
+) -> c_int {
+    if ring.is_null() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+    let ring = Ring(ring as *mut BatchRing);
+    if ring.hdr().worker == 0 {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+
+    if ring.flags().load(Ordering::SeqCst) & BATCH_RING_NEED_WAKEUP != 0 {
+        ring.flags().fetch_and(!BATCH_RING_NEED_WAKEUP, Ordering::SeqCst);
+        futex_wake(ring.flags());
+    }
+
+    let mut ready = ring.cq_tail().load(Ordering::SeqCst)
+        .wrapping_sub(ring.cq_head().load(Ordering::SeqCst));
+    if ready < min_complete {
+        ring.flags().fetch_or(BATCH_RING_CQ_WAIT, Ordering::SeqCst);
+        loop {
+            let tail = ring.cq_tail().load(Ordering::SeqCst);
+            ready = tail.wrapping_sub(ring.cq_head().load(Ordering::SeqCst));
+            if ready >= min_complete {
+                break;
+            }
+            futex_wait(ring.cq_tail(), tail);
+        }
+        ring.flags().fetch_and(!BATCH_RING_CQ_WAIT, Ordering::SeqCst);
+    }
+    set_error(error, 0);
+    ready as c_int
+}
+
+#[no_mangle]
+pub extern "C" fn u_batch_stop_ocall(error: *mut c_int, ring: *mut c_void) -> c_int {
+    if ring.is_null() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+    let ring = Ring(ring as *mut BatchRing);
+    let worker = ring.hdr().worker as *mut JoinHandle<()>;
+    if worker.is_null() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+
+    ring.flags().fetch_or(BATCH_RING_STOP, Ordering::SeqCst);
+    futex_wake(ring.flags());
+    let handle = unsafe { Box::from_raw(worker) };
+    let _ = handle.join();
+    unsafe {
+        (*ring.0).worker = 0;
+    }
+    set_error(error, 0);
+    0
+}
@@ -2,10 +2,11 @@ use libc::timespec;
 use libc::{self, c_int, c_void};
 use std::io::Error;
 use std::slice;
-use std::sync::atomic::{AtomicI32, Ordering};
+use std::sync::atomic::{AtomicI32, AtomicUsize, Ordering};
 use std::sync::Mutex;
 use std::sync::Once;
 
+static mut GLOBAL_TCS_TABLE: Option<TcsEventTable> = None;
 static mut GLOBAL_TCS_CACHE: Option<SgxTcsInfoCache> = None;
 static INIT: Once = Once::new();
 
@@ -99,11 +100,80 @@ impl<'a> SgxTcsInfoCache<'a> {
     }
 }
 
+// The lock-free TCS event table of sgx_ustdc/event.c, which explains it.
+const TCS_EVENT_TABLE_BITS: u32 = 11;
+const TCS_EVENT_TABLE_SIZE: usize = 1 << TCS_EVENT_TABLE_BITS;
+const TCS_EVENT_TABLE_MASK: usize = TCS_EVENT_TABLE_SIZE - 1;
+const TCS_EVENT_MAX_PROBE: usize = 32;
+
+#[repr(C, align(64))]
+struct TcsEventSlot {
+    tcs: AtomicUsize,
+    se_event: SeEvent,
+}
+
+struct TcsEventTable {
+    slots: Box<[TcsEventSlot]>,
+}
+
+impl TcsEventTable {
+    fn new() -> TcsEventTable {
+        let mut slots = Vec::with_capacity(TCS_EVENT_TABLE_SIZE);
+        for _ in 0..TCS_EVENT_TABLE_SIZE {
+            slots.push(TcsEventSlot {
+                tcs: AtomicUsize::new(0),
+                se_event: SeEvent::new(),
+            });
+        }
+        TcsEventTable {
+            slots: slots.into_boxed_slice(),
+        }
+    }
+
+    #[inline]
+    fn hash(tcs: usize) -> usize {
+        // TCS pages are page aligned, drop the offset bits before mixing.
+        let key = (tcs as u64) >> 12;
+        (key.wrapping_mul(0x9E37_79B9_7F4A_7C15) >> (64 - TCS_EVENT_TABLE_BITS)) as usize
+    }
+
+    fn get_event(&self, tcs: usize) -> Option<&SeEvent> {
+        let index = Self::hash(tcs);
+        for i in 0..TCS_EVENT_MAX_PROBE {
+            let slot = &self.slots[(index + i) & TCS_EVENT_TABLE_MASK];
+            let cur = slot.tcs.load(Ordering::Acquire);
+            if cur == tcs {
+                return Some(&slot.se_event);
+            }
+            if cur == 0 {
+                match slot
+                    .tcs
+                    .compare_exchange(0, tcs, Ordering::AcqRel, Ordering::Acquire)
+                {
+                    Ok(_) => return Some(&slot.se_event),
+                    Err(other) if other == tcs => return Some(&slot.se_event),
+                    Err(_) => {}
+                }
+            }
+        }
+        None
+    }
+}
+
 pub fn get_tcs_event(_tcs: usize) -> &'static SeEvent {
     unsafe {
         INIT.call_once(|| {
+            GLOBAL_TCS_TABLE = Some(TcsEventTable::new());
             GLOBAL_TCS_CACHE = Some(SgxTcsInfoCache::new());
         });
+        let table = GLOBAL_TCS_TABLE
+            .as_ref()
+            .expect("GLOBAL_TCS_TABLE is not initialized.");
+        if let Some(event) = table.get_event(_tcs) {
+            return event;
+        }
+        // The table is exhausted or the probe sequence is too crowded,
+        // fall back to the list cache.
         GLOBAL_TCS_CACHE
             .as_ref()
             .expect("GLOBAL_TCS_CACHE is not initialized.")
@@ -22,10 +22,12 @@ extern crate libc;
 extern crate sgx_types;
 
 pub mod asyncio;
+pub mod batch;
 pub mod env;
 pub mod event;
 pub mod fd;
 pub mod file;
+pub mod log;
 pub mod mem;
 pub mod net;
 pub mod pipe;
@@ -0,0 +1,413 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+//! Untrusted drainer for the enclave's log ring.
+//!
+//! `u_log_start_ocall` spawns one thread per ring. The thread writes the
+//! committed records out in ring order, batching consecutive records for
+//! the same fd into one write, then zeroes the space they took and
+//! advances `head`. When the ring is empty it sets `LOG_RING_NEED_WAKEUP`
+//! and sleeps on the flags word for up to `LOG_DRAIN_INTERVAL_MS`, so
+//! enclave threads only have to wake it when the ring fills up.
+//!
+//! The layout here must match `sgx_libc/src/linux/x86_64/ocall/log.rs`.
+
+use libc::{self, c_int, c_void, timespec};
+use std::io::Error;
+use std::mem;
+use std::ptr;
+use std::slice;
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
+use std::thread::{self, JoinHandle};
+
+const LOG_RING_MAGIC: u32 = 0x4c4f_4752;
+const LOG_RING_MIN_SIZE: u32 = 0x1000;
+const LOG_RING_MAX_SIZE: u32 = 0x4000_0000;
+
+const LOG_RING_NEED_WAKEUP: u32 = 0x1;
+const LOG_RING_STOP: u32 = 0x2;
+
+const LOG_RECORD_COMMIT: u32 = 0x8000_0000;
+const LOG_RECORD_ALIGN: usize = 8;
+
+const LOG_LEVEL_PLAIN: u8 = 0;
+const LOG_LEVEL_PAD: u8 = 0xff;
+
+const LOG_STREAM_STDOUT: u8 = 1;
+const LOG_STREAM_STDERR: u8 = 2;
+
+const LOG_RECORD_CONT: u8 = 0x1;
+const LOG_RECORD_MORE: u8 = 0x2;
+
+// How long an idle drainer sleeps before it looks at the ring again.
+const LOG_DRAIN_INTERVAL_MS: i64 = 5;
+// How long `u_log_wait_ocall` sleeps between checks of `head`.
+const LOG_WAIT_INTERVAL_MS: i64 = 100;
+// Output gathered before it is written.
+const LOG_OUT_BUF_SIZE: usize = 0x1_0000;
+
+const FUTEX_WAIT: c_int = 0;
+const FUTEX_WAKE: c_int = 1;
+
+#[repr(C)]
+#[derive(Copy, Clone)]
+struct LogRecord {
+    len: u32,
+    level: u8,
+    stream: u8,
+    flags: u8,
+    _pad: u8,
+}
+
+#[repr(C)]
+struct LogRingHdr {
+    magic: u32,
+    size: u32,
+    data_off: u32,
+    _pad0: u32,
+    drainer: u64,
+    dropped: u64,
+    _pad1: [u8; 32],
+    head: u64,
+    _pad2: [u8; 56],
+    flags: u32,
+    _pad3: [u8; 60],
+}
+
+#[derive(Copy, Clone)]
+struct Ring(*mut LogRingHdr);
+
+unsafe impl Send for Ring {}
+
+impl Ring {
+    fn hdr(&self) -> &LogRingHdr {
+        unsafe { &*self.0 }
+    }
+
+    fn head(&self) -> &AtomicU64 {
+        unsafe { &*(&self.hdr().head as *const u64 as *const AtomicU64) }
+    }
+
+    // The low half of `head`, which is what futex waiters sleep on.
+    fn head_word(&self) -> &AtomicU32 {
+        unsafe { &*(&self.hdr().head as *const u64 as *const AtomicU32) }
+    }
+
+    fn dropped(&self) -> &AtomicU64 {
+        unsafe { &*(&self.hdr().dropped as *const u64 as *const AtomicU64) }
+    }
+
+    fn flags(&self) -> &AtomicU32 {
+        unsafe { &*(&self.hdr().flags as *const u32 as *const AtomicU32) }
+    }
+
+    fn data(&self) -> *mut u8 {
+        unsafe { (self.0 as *mut u8).add(self.hdr().data_off as usize) }
+    }
+
+    fn is_valid(&self) -> bool {
+        let hdr = self.hdr();
+        hdr.magic == LOG_RING_MAGIC
+            && hdr.size.is_power_of_two()
+            && hdr.size >= LOG_RING_MIN_SIZE
+            && hdr.size <= LOG_RING_MAX_SIZE
+            && hdr.data_off as usize == mem::size_of::<LogRingHdr>()
+    }
+
+    fn len_word(&self, off: usize) -> &AtomicU32 {
+        unsafe { &*(self.data().add(off) as *const AtomicU32) }
+    }
+
+    fn wake_drainer(&self) {
+        if self.flags().load(Ordering::SeqCst) & LOG_RING_NEED_WAKEUP != 0 {
+            self.flags().fetch_and(!LOG_RING_NEED_WAKEUP, Ordering::SeqCst);
+            futex_wake(self.flags());
+        }
+    }
+}
+
+struct Drainer {
+    ring: Ring,
+    fd: c_int,
+    out: Vec<u8>,
+    out_fd: c_int,
+    // The fd of a leveled record whose last piece has not come yet.
+    open: Option<c_int>,
+    dropped: u64,
+}
+
+impl Drainer {
+    fn run(mut self) {
+        loop {
+            if self.drain() {
+                continue;
+            }
+            if self.ring.flags().load(Ordering::SeqCst) & LOG_RING_STOP != 0 {
+                break;
+            }
+
+            let flags = self.ring.flags().fetch_or(LOG_RING_NEED_WAKEUP, Ordering::SeqCst)
+                | LOG_RING_NEED_WAKEUP;
+            let head = self.ring.head().load(Ordering::Relaxed);
+            let off = (head & (self.ring.hdr().size as u64 - 1)) as usize;
+            if flags & LOG_RING_STOP == 0
+                && self.ring.len_word(off).load(Ordering::SeqCst) & LOG_RECORD_COMMIT == 0
+            {
+                futex_wait(self.ring.flags(), flags, LOG_DRAIN_INTERVAL_MS);
+            }
+            self.ring.flags().fetch_and(!LOG_RING_NEED_WAKEUP, Ordering::SeqCst);
+        }
+    }
+
+    // Writes out every committed record. Returns whether there was any.
+    fn drain(&mut self) -> bool {
+        let size = self.ring.hdr().size as usize;
+        let mask = size as u64 - 1;
+        let data = self.ring.data();
+        let head = self.ring.head().load(Ordering::Relaxed);
+        let mut pos = head;
+
+        while ((pos - head) as usize) < size {
+            let off = (pos & mask) as usize;
+            let word = self.ring.len_word(off).load(Ordering::Acquire);
+            if word & LOG_RECORD_COMMIT == 0 {
+                break;
+            }
+            let len = (word & !LOG_RECORD_COMMIT) as usize;
+            let rec_len = align_up(mem::size_of::<LogRecord>() + len, LOG_RECORD_ALIGN);
+            if rec_len > size - off {
+                // Not something the enclave writes. Leave the ring stuck
+                // rather than read past its end.
+                break;
+            }
+            let rec = unsafe { ptr::read_volatile(data.add(off) as *const LogRecord) };
+            if rec.level != LOG_LEVEL_PAD {
+                let payload = unsafe {
+                    slice::from_raw_parts(data.add(off + mem::size_of::<LogRecord>()), len)
+                };
+                self.emit(&rec, payload);
+            }
+            pos += rec_len as u64;
+        }
+
+        let dropped = self.ring.dropped().load(Ordering::Relaxed);
+        if dropped > self.dropped {
+            let line = format!("[WARN] sgx log: {} records dropped\n", dropped - self.dropped);
+            self.select(self.fd);
+            self.out.extend_from_slice(line.as_bytes());
+            self.dropped = dropped;
+        }
+        self.flush();
+
+        if pos == head {
+            return false;
+        }
+        let used = (pos - head) as usize;
+        let off = (head & mask) as usize;
+        let first = used.min(size - off);
+        unsafe {
+            ptr::write_bytes(data.add(off), 0, first);
+            ptr::write_bytes(data, 0, used - first);
+        }
+        self.ring.head().store(pos, Ordering::SeqCst);
+        futex_wake(self.ring.head_word());
+        true
+    }
+
+    fn emit(&mut self, rec: &LogRecord, payload: &[u8]) {
+        let fd = match rec.stream {
+            LOG_STREAM_STDOUT => libc::STDOUT_FILENO,
+            LOG_STREAM_STDERR => libc::STDERR_FILENO,
+            _ => self.fd,
+        };
+        // Another thread's record may come between the pieces of a long
+        // one. End the broken line, and start a new one for the rest.
+        let cont = self.open == Some(fd) && rec.level != LOG_LEVEL_PLAIN && rec.flags & LOG_RECORD_CONT != 0;
+        if let (Some(open), false) = (self.open, cont) {
+            self.select(open);
+            self.out.push(b'\n');
+        }
+        self.open = None;
+
+        self.select(fd);
+        if rec.level != LOG_LEVEL_PLAIN && !cont {
+            self.out.extend_from_slice(level_prefix(rec.level));
+        }
+        self.out.extend_from_slice(payload);
+        if rec.level != LOG_LEVEL_PLAIN {
+            if rec.flags & LOG_RECORD_MORE == 0 {
+                self.out.push(b'\n');
+            } else {
+                self.open = Some(fd);
+            }
+        }
+        if self.out.len() >= LOG_OUT_BUF_SIZE {
+            self.flush();
+        }
+    }
+
+    fn select(&mut self, fd: c_int) {
+        if fd != self.out_fd {
+            self.flush();
+            self.out_fd = fd;
+        }
+    }
+
+    fn flush(&mut self) {
+        let mut buf = &self.out[..];
+        while !buf.is_empty() {
+            let n = unsafe { libc::write(self.out_fd, buf.as_ptr() as *const c_void, buf.len()) };
+            if n < 0 {
+                if Error::last_os_error().raw_os_error() == Some(libc::EINTR) {
+                    continue;
+                }
+                break;
+            }
+            buf = &buf[n as usize..];
+        }
+        self.out.clear();
+    }
+}
+
+fn level_prefix(level: u8) -> &'static [u8] {
+    match level {
+        1 => b"[ERROR] ",
+        2 => b"[WARN] ",
+        3 => b"[INFO] ",
+        4 => b"[DEBUG] ",
+        5 => b"[TRACE] ",
+        _ => b"",
+    }
+}
+
+fn align_up(n: usize, align: usize) -> usize {
+    (n + align - 1) & !(align - 1)
+}
+
+fn futex_wait(word: &AtomicU32, val: u32, timeout_ms: i64) {
+    let timeout = timespec {
+        tv_sec: timeout_ms / 1000,
+        tv_nsec: (timeout_ms % 1000) * 1_000_000,
+    };
+    unsafe {
+        libc::syscall(libc::SYS_futex, word, FUTEX_WAIT, val, &timeout as *const timespec, 0, 0);
+    }
+}
+
+fn futex_wake(word: &AtomicU32) {
+    unsafe {
+        libc::syscall(libc::SYS_futex, word, FUTEX_WAKE, c_int::MAX, 0, 0, 0);
+    }
+}
+
+fn set_error(error: *mut c_int, errno: c_int) {
+    if !error.is_null() {
+        unsafe {
+            *error = errno;
+        }
+    }
+}
+
+#[no_mangle]
+pub extern "C" fn u_log_start_ocall(error: *mut c_int, ring: *mut c_void, fd: c_int) -> c_int {
+    if ring.is_null() || fd < 0 {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+    let ring = Ring(ring as *mut LogRingHdr);
+    if !ring.is_valid() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+    if ring.hdr().drainer != 0 {
+        set_error(error, libc::EBUSY);
+        return -1;
+    }
+
+    let drainer = Drainer {
+        ring,
+        fd,
+        out: Vec::with_capacity(LOG_OUT_BUF_SIZE),
+        out_fd: fd,
+        open: None,
+        dropped: 0,
+    };
+    let handle = match thread::Builder::new()
+        .name("sgx-log".to_string())
+        .spawn(move || drainer.run())
+    {
+        Ok(handle) => handle,
+        Err(e) => {
+            set_error(error, e.raw_os_error().unwrap_or(libc::EAGAIN));
+            return -1;
+        }
+    };
+    unsafe {
+        (*ring.0).drainer = Box::into_raw(Box::new(handle)) as u64;
+    }
+    set_error(error, 0);
+    0
+}
+
+#[no_mangle]
+pub extern "C" fn u_log_wait_ocall(error: *mut c_int, ring: *mut c_void, head: u64) -> c_int {
+    if ring.is_null() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+    let ring = Ring(ring as *mut LogRingHdr);
+    if ring.hdr().drainer == 0 {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+
+    ring.wake_drainer();
+    if head != u64::MAX {
+        while ring.head().load(Ordering::SeqCst) == head
+            && ring.flags().load(Ordering::SeqCst) & LOG_RING_STOP == 0
+        {
+            futex_wait(ring.head_word(), head as u32, LOG_WAIT_INTERVAL_MS);
+            ring.wake_drainer();
+        }
+    }
+    set_error(error, 0);
+    0
+}
+
+#[no_mangle]
+pub extern "C" fn u_log_stop_ocall(error: *mut c_int, ring: *mut c_void) -> c_int {
+    if ring.is_null() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+    let ring = Ring(ring as *mut LogRingHdr);
+    let drainer = ring.hdr().drainer as *mut JoinHandle<()>;
+    if drainer.is_null() {
+        set_error(error, libc::EINVAL);
+        return -1;
+    }
+
+    ring.flags().fetch_or(LOG_RING_STOP, Ordering::SeqCst);
+    futex_wake(ring.flags());
+    let handle = unsafe { Box::from_raw(drainer) };
+    let _ = handle.join();
+    unsafe {
+        (*ring.0).drainer = 0;
+    }
+    set_error(error, 0);
+    0
+}
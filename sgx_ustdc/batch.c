@@ -0,0 +1,329 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Untrusted worker for the enclave's OCALL submission ring. The layout
+// must match sgx_libc/src/linux/x86_64/ocall/batch.rs.
+
+#define BATCH_RING_MAGIC        0x42524e47
+#define BATCH_RING_MAX_ENTRIES  4096
+
+#define BATCH_RING_NEED_WAKEUP  0x1
+#define BATCH_RING_CQ_WAIT      0x2
+#define BATCH_RING_STOP         0x4
+
+#define BATCH_OP_NOP            0
+#define BATCH_OP_READ           1
+#define BATCH_OP_WRITE          2
+#define BATCH_OP_PREAD64        3
+#define BATCH_OP_PWRITE64       4
+#define BATCH_OP_SEND           5
+#define BATCH_OP_RECV           6
+#define BATCH_OP_FSYNC          7
+#define BATCH_OP_FDATASYNC      8
+#define BATCH_OP_CLOSE          9
+#define BATCH_OP_CLOCK_GETTIME  10
+#define BATCH_OP_EPOLL_WAIT     11
+
+// Empty polls of the submission queue before the worker goes to sleep.
+#define BATCH_SPIN_ROUNDS       4096
+
+typedef struct batch_sqe {
+    uint8_t opcode;
+    uint8_t __pad[3];
+    int fd;
+    uint64_t addr;
+    uint64_t len;
+    int64_t off;
+    uint64_t arg;
+    uint64_t user_data;
+} batch_sqe_t;
+
+typedef struct batch_cqe {
+    uint64_t user_data;
+    int64_t result;
+    int error;
+    uint32_t __pad;
+} batch_cqe_t;
+
+typedef struct batch_ring {
+    uint32_t magic;
+    uint32_t entries;
+    uint32_t sqe_off;
+    uint32_t cqe_off;
+    uint64_t worker;
+    uint8_t __pad0[40];
+    uint32_t sq_tail;
+    uint8_t __pad1[60];
+    uint32_t sq_head;
+    uint8_t __pad2[60];
+    uint32_t cq_tail;
+    uint8_t __pad3[60];
+    uint32_t cq_head;
+    uint8_t __pad4[60];
+    uint32_t flags;
+    uint8_t __pad5[60];
+} batch_ring_t;
+
+#define LOAD(p)         __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define STORE(p, v)     __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define OR(p, v)        __atomic_or_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define AND(p, v)       __atomic_and_fetch((p), (v), __ATOMIC_SEQ_CST)
+
+static void futex_wait(uint32_t *word, uint32_t val)
+{
+    syscall(__NR_futex, word, FUTEX_WAIT, val, NULL, NULL, 0);
+}
+
+static void futex_wake(uint32_t *word)
+{
+    syscall(__NR_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static int batch_ring_valid(const batch_ring_t *ring)
+{
+    size_t sqe_off = sizeof(batch_ring_t);
+    size_t cqe_off = sqe_off + (size_t)ring->entries * sizeof(batch_sqe_t);
+
+    return ring->magic == BATCH_RING_MAGIC &&
+           ring->entries != 0 &&
+           (ring->entries & (ring->entries - 1)) == 0 &&
+           ring->entries <= BATCH_RING_MAX_ENTRIES &&
+           ring->sqe_off == sqe_off &&
+           ring->cqe_off == cqe_off;
+}
+
+static int64_t batch_execute(const batch_sqe_t *sqe, int *error)
+{
+    void *buf = (void *)(uintptr_t)sqe->addr;
+    size_t len = (size_t)sqe->len;
+    int64_t ret;
+
+    switch (sqe->opcode) {
+    case BATCH_OP_NOP:
+        ret = 0;
+        break;
+    case BATCH_OP_READ:
+        ret = read(sqe->fd, buf, len);
+        break;
+    case BATCH_OP_WRITE:
+        ret = write(sqe->fd, buf, len);
+        break;
+    case BATCH_OP_PREAD64:
+        ret = pread64(sqe->fd, buf, len, sqe->off);
+        break;
+    case BATCH_OP_PWRITE64:
+        ret = pwrite64(sqe->fd, buf, len, sqe->off);
+        break;
+    case BATCH_OP_SEND:
+        ret = send(sqe->fd, buf, len, (int)sqe->arg);
+        break;
+    case BATCH_OP_RECV:
+        ret = recv(sqe->fd, buf, len, (int)sqe->arg);
+        break;
+    case BATCH_OP_FSYNC:
+        ret = fsync(sqe->fd);
+        break;
+    case BATCH_OP_FDATASYNC:
+        ret = fdatasync(sqe->fd);
+        break;
+    case BATCH_OP_CLOSE:
+        ret = close(sqe->fd);
+        break;
+    case BATCH_OP_CLOCK_GETTIME:
+        if (len < sizeof(struct timespec)) {
+            *error = EINVAL;
+            return -1;
+        }
+        ret = clock_gettime((clockid_t)sqe->arg, (struct timespec *)buf);
+        break;
+    case BATCH_OP_EPOLL_WAIT:
+        ret = epoll_wait(sqe->fd, (struct epoll_event *)buf, (int)len, (int)sqe->arg);
+        break;
+    default:
+        *error = EINVAL;
+        return -1;
+    }
+
+    if (ret < 0) {
+        *error = errno;
+        return -1;
+    }
+    *error = 0;
+    return ret;
+}
+
+static void *batch_worker_run(void *arg)
+{
+    batch_ring_t *ring = (batch_ring_t *)arg;
+    uint32_t entries = ring->entries;
+    uint32_t mask = entries - 1;
+    batch_sqe_t *sqes = (batch_sqe_t *)((uint8_t *)ring + ring->sqe_off);
+    batch_cqe_t *cqes = (batch_cqe_t *)((uint8_t *)ring + ring->cqe_off);
+    uint32_t idle = 0;
+
+    while (!(LOAD(&ring->flags) & BATCH_RING_STOP)) {
+        uint32_t head = __atomic_load_n(&ring->sq_head, __ATOMIC_RELAXED);
+        uint32_t cq_tail;
+        batch_sqe_t sqe;
+        batch_cqe_t cqe;
+
+        if (__atomic_load_n(&ring->sq_tail, __ATOMIC_ACQUIRE) == head) {
+            if (++idle < BATCH_SPIN_ROUNDS) {
+                __builtin_ia32_pause();
+                continue;
+            }
+            uint32_t flags = OR(&ring->flags, BATCH_RING_NEED_WAKEUP);
+            if (!(flags & BATCH_RING_STOP) && LOAD(&ring->sq_tail) == head) {
+                futex_wait(&ring->flags, flags);
+            }
+            AND(&ring->flags, ~BATCH_RING_NEED_WAKEUP);
+            idle = 0;
+            continue;
+        }
+        idle = 0;
+
+        // The enclave never has more than `entries` requests in flight, so
+        // there is always room for the result. Do not overwrite an unreaped
+        // completion if it gets that wrong.
+        cq_tail = __atomic_load_n(&ring->cq_tail, __ATOMIC_RELAXED);
+        if (cq_tail - __atomic_load_n(&ring->cq_head, __ATOMIC_ACQUIRE) >= entries) {
+            sched_yield();
+            continue;
+        }
+
+        sqe = *(volatile batch_sqe_t *)&sqes[head & mask];
+        cqe.user_data = sqe.user_data;
+        cqe.result = batch_execute(&sqe, &cqe.error);
+        cqe.__pad = 0;
+        *(volatile batch_cqe_t *)&cqes[cq_tail & mask] = cqe;
+
+        STORE(&ring->cq_tail, cq_tail + 1);
+        __atomic_store_n(&ring->sq_head, head + 1, __ATOMIC_RELEASE);
+        if (LOAD(&ring->flags) & BATCH_RING_CQ_WAIT) {
+            futex_wake(&ring->cq_tail);
+        }
+    }
+    return NULL;
+}
+
+int u_batch_start_ocall(int *error, void *ring_ptr)
+{
+    batch_ring_t *ring = (batch_ring_t *)ring_ptr;
+    pthread_t thread;
+    int ret;
+
+    if (ring == NULL || !batch_ring_valid(ring)) {
+        if (error) {
+            *error = EINVAL;
+        }
+        return -1;
+    }
+    if (ring->worker != 0) {
+        if (error) {
+            *error = EBUSY;
+        }
+        return -1;
+    }
+
+    ret = pthread_create(&thread, NULL, batch_worker_run, ring);
+    if (ret != 0) {
+        if (error) {
+            *error = ret;
+        }
+        return -1;
+    }
+    ring->worker = (uint64_t)thread;
+    if (error) {
+        *error = 0;
+    }
+    return 0;
+}
+
+int u_batch_enter_ocall(int *error, void *ring_ptr, uint32_t min_complete)
+{
+    batch_ring_t *ring = (batch_ring_t *)ring_ptr;
+    uint32_t ready;
+
+    if (ring == NULL || ring->worker == 0) {
+        if (error) {
+            *error = EINVAL;
+        }
+        return -1;
+    }
+
+    if (LOAD(&ring->flags) & BATCH_RING_NEED_WAKEUP) {
+        AND(&ring->flags, ~BATCH_RING_NEED_WAKEUP);
+        futex_wake(&ring->flags);
+    }
+
+    ready = LOAD(&ring->cq_tail) - LOAD(&ring->cq_head);
+    if (ready < min_complete) {
+        OR(&ring->flags, BATCH_RING_CQ_WAIT);
+        for (;;) {
+            uint32_t tail = LOAD(&ring->cq_tail);
+            ready = tail - LOAD(&ring->cq_head);
+            if (ready >= min_complete) {
+                break;
+            }
+            futex_wait(&ring->cq_tail, tail);
+        }
+        AND(&ring->flags, ~BATCH_RING_CQ_WAIT);
+    }
+    if (error) {
+        *error = 0;
+    }
+    return (int)ready;
+}
+
+int u_batch_stop_ocall(int *error, void *ring_ptr)
+{
+    batch_ring_t *ring = (batch_ring_t *)ring_ptr;
+
+    if (ring == NULL || ring->worker == 0) {
+        if (error) {
+            *error = EINVAL;
+        }
+        return -1;
+    }
+
+    OR(&ring->flags, BATCH_RING_STOP);
+    futex_wake(&ring->flags);
+    pthread_join((pthread_t)ring->worker, NULL);
+    ring->worker = 0;
+    if (error) {
+        *error = 0;
+    }
+    return 0;
+}
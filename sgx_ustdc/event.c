@@ -8,6 +8,7 @@
 #include <pthread.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
 #include "spinlock.h"
 typedef void *se_handle_t;
 typedef void *tcs_handle_t;
@@ -105,6 +106,23 @@ typedef struct _sgx_tcs_info_t {
     tcs_handle_t tcs;
 } sgx_tcs_info_t;
 
+// Fixed-size, open-addressing table mapping a TCS address to its event.
+// A slot is claimed once with a CAS on `tcs` and never released, so the
+// lookup on the wake/wait path needs no lock. The futex word lives in the
+// slot itself and each slot owns a cache line to keep wakers of different
+// TCS from bouncing the same line.
+#define SGX_TCS_EVENT_TABLE_BITS    11
+#define SGX_TCS_EVENT_TABLE_SIZE    (1UL << SGX_TCS_EVENT_TABLE_BITS)
+#define SGX_TCS_EVENT_TABLE_MASK    (SGX_TCS_EVENT_TABLE_SIZE - 1)
+#define SGX_TCS_EVENT_MAX_PROBE     32
+
+typedef struct _sgx_tcs_event_slot_t {
+    tcs_handle_t volatile tcs;
+    int event;
+} __attribute__((aligned(64))) sgx_tcs_event_slot_t;
+
+static sgx_tcs_event_slot_t g_tcs_event_table[SGX_TCS_EVENT_TABLE_SIZE];
+
 sgx_tcs_info_cache_t *SgxTcsInfoCache = NULL;
 static sgx_spinlock_t g_spin_lock;
 
@@ -237,10 +255,49 @@ se_handle_t sgx_tcs_event_get(sgx_tcs_info_cache_t *cache, const tcs_handle_t tc
     return se_event;
 }
 
+static inline size_t tcs_event_hash(const tcs_handle_t tcs)
+{
+    // TCS pages are page aligned, drop the offset bits before mixing.
+    uint64_t key = (uint64_t)(uintptr_t)tcs >> 12;
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> (64 - SGX_TCS_EVENT_TABLE_BITS));
+}
+
+static se_handle_t tcs_event_table_get(const tcs_handle_t tcs)
+{
+    size_t index = tcs_event_hash(tcs);
+    size_t i = 0;
+
+    for (i = 0; i < SGX_TCS_EVENT_MAX_PROBE; i++) {
+        sgx_tcs_event_slot_t *slot = &g_tcs_event_table[(index + i) & SGX_TCS_EVENT_TABLE_MASK];
+        tcs_handle_t cur = __atomic_load_n(&slot->tcs, __ATOMIC_ACQUIRE);
+
+        if (cur == tcs) {
+            return &slot->event;
+        }
+        if (cur == NULL) {
+            if (__sync_bool_compare_and_swap(&slot->tcs, NULL, tcs)) {
+                return &slot->event;
+            }
+            // Lost the race for this slot, it may have been taken by the same TCS.
+            if (__atomic_load_n(&slot->tcs, __ATOMIC_ACQUIRE) == tcs) {
+                return &slot->event;
+            }
+        }
+    }
+    return NULL;
+}
+
 se_handle_t get_tcs_event(const tcs_handle_t tcs)
 {   
     se_handle_t se_handle;
 
+    se_handle = tcs_event_table_get(tcs);
+    if (se_handle != NULL) {
+        return se_handle;
+    }
+
+    // The table is exhausted or the probe sequence is too crowded,
+    // fall back to the list cache.
     sgx_spin_lock(&g_spin_lock);
     if (SgxTcsInfoCache == NULL) {
 
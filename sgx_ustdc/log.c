@@ -0,0 +1,416 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License..
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Untrusted drainer for the enclave's log ring. The layout must match
+// sgx_libc/src/linux/x86_64/ocall/log.rs.
+
+#define LOG_RING_MAGIC          0x4c4f4752
+#define LOG_RING_MIN_SIZE       0x1000
+#define LOG_RING_MAX_SIZE       0x40000000
+
+#define LOG_RING_NEED_WAKEUP    0x1
+#define LOG_RING_STOP           0x2
+
+#define LOG_RECORD_COMMIT       0x80000000u
+#define LOG_RECORD_ALIGN        8
+
+#define LOG_LEVEL_PLAIN         0
+#define LOG_LEVEL_PAD           0xff
+
+#define LOG_STREAM_STDOUT       1
+#define LOG_STREAM_STDERR       2
+
+#define LOG_RECORD_CONT         0x1
+#define LOG_RECORD_MORE         0x2
+
+// How long an idle drainer sleeps before it looks at the ring again.
+#define LOG_DRAIN_INTERVAL_MS   5
+// How long u_log_wait_ocall sleeps between checks of head.
+#define LOG_WAIT_INTERVAL_MS    100
+// Output gathered before it is written.
+#define LOG_OUT_BUF_SIZE        0x10000
+
+typedef struct log_record {
+    uint32_t len;
+    uint8_t level;
+    uint8_t stream;
+    uint8_t flags;
+    uint8_t __pad;
+} log_record_t;
+
+typedef struct log_ring {
+    uint32_t magic;
+    uint32_t size;
+    uint32_t data_off;
+    uint32_t __pad0;
+    uint64_t drainer;
+    uint64_t dropped;
+    uint8_t __pad1[32];
+    uint64_t head;
+    uint8_t __pad2[56];
+    uint32_t flags;
+    uint8_t __pad3[60];
+} log_ring_t;
+
+typedef struct log_drainer {
+    log_ring_t *ring;
+    pthread_t thread;
+    int fd;
+    int out_fd;
+    /* fd of a leveled record whose last piece has not come yet, or -1 */
+    int open_fd;
+    size_t out_len;
+    uint64_t dropped;
+    uint8_t out[LOG_OUT_BUF_SIZE];
+} log_drainer_t;
+
+#define LOAD(p)         __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define STORE(p, v)     __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define OR(p, v)        __atomic_or_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define AND(p, v)       __atomic_and_fetch((p), (v), __ATOMIC_SEQ_CST)
+
+static void futex_wait(uint32_t *word, uint32_t val, long timeout_ms)
+{
+    struct timespec timeout;
+
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
+    syscall(__NR_futex, word, FUTEX_WAIT, val, &timeout, NULL, 0);
+}
+
+static void futex_wake(uint32_t *word)
+{
+    syscall(__NR_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+// The low half of head, which is what futex waiters sleep on.
+static uint32_t *log_head_word(log_ring_t *ring)
+{
+    return (uint32_t *)&ring->head;
+}
+
+static uint8_t *log_data(log_ring_t *ring)
+{
+    return (uint8_t *)ring + ring->data_off;
+}
+
+static int log_ring_valid(const log_ring_t *ring)
+{
+    return ring->magic == LOG_RING_MAGIC &&
+           (ring->size & (ring->size - 1)) == 0 &&
+           ring->size >= LOG_RING_MIN_SIZE &&
+           ring->size <= LOG_RING_MAX_SIZE &&
+           ring->data_off == sizeof(log_ring_t);
+}
+
+static void log_wake_drainer(log_ring_t *ring)
+{
+    if (LOAD(&ring->flags) & LOG_RING_NEED_WAKEUP) {
+        AND(&ring->flags, ~LOG_RING_NEED_WAKEUP);
+        futex_wake(&ring->flags);
+    }
+}
+
+static const char *log_level_prefix(uint8_t level)
+{
+    switch (level) {
+    case 1: return "[ERROR] ";
+    case 2: return "[WARN] ";
+    case 3: return "[INFO] ";
+    case 4: return "[DEBUG] ";
+    case 5: return "[TRACE] ";
+    default: return "";
+    }
+}
+
+static void log_flush(log_drainer_t *d)
+{
+    const uint8_t *buf = d->out;
+    size_t len = d->out_len;
+
+    while (len > 0) {
+        ssize_t n = write(d->out_fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    d->out_len = 0;
+}
+
+static void log_select(log_drainer_t *d, int fd)
+{
+    if (fd != d->out_fd) {
+        log_flush(d);
+        d->out_fd = fd;
+    }
+}
+
+static void log_put(log_drainer_t *d, const void *buf, size_t len)
+{
+    while (len > 0) {
+        size_t n = LOG_OUT_BUF_SIZE - d->out_len;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(d->out + d->out_len, buf, n);
+        d->out_len += n;
+        buf = (const uint8_t *)buf + n;
+        len -= n;
+        if (d->out_len == LOG_OUT_BUF_SIZE) {
+            log_flush(d);
+        }
+    }
+}
+
+static void log_emit(log_drainer_t *d, const log_record_t *rec, const uint8_t *payload)
+{
+    int fd = d->fd;
+    int cont;
+
+    if (rec->stream == LOG_STREAM_STDOUT) {
+        fd = STDOUT_FILENO;
+    } else if (rec->stream == LOG_STREAM_STDERR) {
+        fd = STDERR_FILENO;
+    }
+    /* Another thread's record may come between the pieces of a long one.
+     * End the broken line, and start a new one for the rest. */
+    cont = d->open_fd == fd && rec->level != LOG_LEVEL_PLAIN && (rec->flags & LOG_RECORD_CONT);
+    if (d->open_fd != -1 && !cont) {
+        log_select(d, d->open_fd);
+        log_put(d, "\n", 1);
+    }
+    d->open_fd = -1;
+
+    log_select(d, fd);
+    if (rec->level != LOG_LEVEL_PLAIN && !cont) {
+        const char *prefix = log_level_prefix(rec->level);
+        log_put(d, prefix, strlen(prefix));
+    }
+    log_put(d, payload, rec->len & ~LOG_RECORD_COMMIT);
+    if (rec->level != LOG_LEVEL_PLAIN) {
+        if (rec->flags & LOG_RECORD_MORE) {
+            d->open_fd = fd;
+        } else {
+            log_put(d, "\n", 1);
+        }
+    }
+}
+
+// Writes out every committed record. Returns whether there was any.
+static int log_drain(log_drainer_t *d)
+{
+    log_ring_t *ring = d->ring;
+    size_t size = ring->size;
+    uint64_t mask = size - 1;
+    uint8_t *data = log_data(ring);
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint64_t pos = head;
+    uint64_t dropped;
+
+    while (pos - head < size) {
+        size_t off = (size_t)(pos & mask);
+        uint32_t word = __atomic_load_n((uint32_t *)(data + off), __ATOMIC_ACQUIRE);
+        size_t len, rec_len;
+        log_record_t rec;
+
+        if (!(word & LOG_RECORD_COMMIT)) {
+            break;
+        }
+        len = word & ~LOG_RECORD_COMMIT;
+        rec_len = (sizeof(log_record_t) + len + LOG_RECORD_ALIGN - 1) & ~(size_t)(LOG_RECORD_ALIGN - 1);
+        if (rec_len > size - off) {
+            // Not something the enclave writes. Leave the ring stuck rather
+            // than read past its end.
+            break;
+        }
+        rec = *(volatile log_record_t *)(data + off);
+        if (rec.level != LOG_LEVEL_PAD) {
+            log_emit(d, &rec, data + off + sizeof(log_record_t));
+        }
+        pos += rec_len;
+    }
+
+    dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    if (dropped > d->dropped) {
+        char line[64];
+        int n = snprintf(line, sizeof(line), "[WARN] sgx log: %llu records dropped\n",
+                         (unsigned long long)(dropped - d->dropped));
+        log_select(d, d->fd);
+        log_put(d, line, (size_t)n);
+        d->dropped = dropped;
+    }
+    log_flush(d);
+
+    if (pos == head) {
+        return 0;
+    } else {
+        size_t used = (size_t)(pos - head);
+        size_t off = (size_t)(head & mask);
+        size_t first = used < size - off ? used : size - off;
+        memset(data + off, 0, first);
+        memset(data, 0, used - first);
+    }
+    STORE(&ring->head, pos);
+    futex_wake(log_head_word(ring));
+    return 1;
+}
+
+static void *log_drainer_run(void *arg)
+{
+    log_drainer_t *d = (log_drainer_t *)arg;
+    log_ring_t *ring = d->ring;
+
+    for (;;) {
+        uint32_t flags;
+        uint64_t head;
+        uint32_t *word;
+
+        if (log_drain(d)) {
+            continue;
+        }
+        if (LOAD(&ring->flags) & LOG_RING_STOP) {
+            break;
+        }
+
+        flags = OR(&ring->flags, LOG_RING_NEED_WAKEUP);
+        head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+        word = (uint32_t *)(log_data(ring) + (head & (ring->size - 1)));
+        if (!(flags & LOG_RING_STOP) && !(LOAD(word) & LOG_RECORD_COMMIT)) {
+            futex_wait(&ring->flags, flags, LOG_DRAIN_INTERVAL_MS);
+        }
+        AND(&ring->flags, ~LOG_RING_NEED_WAKEUP);
+    }
+    return NULL;
+}
+
+int u_log_start_ocall(int *error, void *ring_ptr, int fd)
+{
+    log_ring_t *ring = (log_ring_t *)ring_ptr;
+    log_drainer_t *d;
+    int ret;
+
+    if (ring == NULL || fd < 0 || !log_ring_valid(ring)) {
+        if (error) {
+            *error = EINVAL;
+        }
+        return -1;
+    }
+    if (ring->drainer != 0) {
+        if (error) {
+            *error = EBUSY;
+        }
+        return -1;
+    }
+
+    d = (log_drainer_t *)malloc(sizeof(log_drainer_t));
+    if (d == NULL) {
+        if (error) {
+            *error = ENOMEM;
+        }
+        return -1;
+    }
+    d->ring = ring;
+    d->fd = fd;
+    d->out_fd = fd;
+    d->open_fd = -1;
+    d->out_len = 0;
+    d->dropped = 0;
+
+    ret = pthread_create(&d->thread, NULL, log_drainer_run, d);
+    if (ret != 0) {
+        free(d);
+        if (error) {
+            *error = ret;
+        }
+        return -1;
+    }
+    ring->drainer = (uint64_t)(uintptr_t)d;
+    if (error) {
+        *error = 0;
+    }
+    return 0;
+}
+
+int u_log_wait_ocall(int *error, void *ring_ptr, uint64_t head)
+{
+    log_ring_t *ring = (log_ring_t *)ring_ptr;
+
+    if (ring == NULL || ring->drainer == 0) {
+        if (error) {
+            *error = EINVAL;
+        }
+        return -1;
+    }
+
+    log_wake_drainer(ring);
+    if (head != UINT64_MAX) {
+        while (LOAD(&ring->head) == head && !(LOAD(&ring->flags) & LOG_RING_STOP)) {
+            futex_wait(log_head_word(ring), (uint32_t)head, LOG_WAIT_INTERVAL_MS);
+            log_wake_drainer(ring);
+        }
+    }
+    if (error) {
+        *error = 0;
+    }
+    return 0;
+}
+
+int u_log_stop_ocall(int *error, void *ring_ptr)
+{
+    log_ring_t *ring = (log_ring_t *)ring_ptr;
+    log_drainer_t *d;
+
+    if (ring == NULL || ring->drainer == 0) {
+        if (error) {
+            *error = EINVAL;
+        }
+        return -1;
+    }
+
+    d = (log_drainer_t *)(uintptr_t)ring->drainer;
+    OR(&ring->flags, LOG_RING_STOP);
+    futex_wake(&ring->flags);
+    pthread_join(d->thread, NULL);
+    free(d);
+    ring->drainer = 0;
+    if (error) {
+        *error = 0;
+    }
+    return 0;
+}